@@ -32,6 +32,8 @@
 """
 
 import sys
+import json
+import math
 
 # Number of parameters (ARCH, CIPHER_MODE, DIR, HASH_ALG, KEY_SIZE)
 PAR_NUM = 5
@@ -46,6 +48,7 @@ class Variant(object):
                        args['keysize'])
 
         self.avg_times = []
+        self.runs = None
         self.slope = None
         self.intercept = None
 
@@ -55,6 +58,12 @@ class Variant(object):
         """
         self.avg_times = avg_times
 
+    def set_runs(self, runs):
+        """
+        Fills list of times of all runs (one list per buffer size)
+        """
+        self.runs = runs
+
     def lin_reg(self, sizes):
         """
         Computes linear regression of set of coordinates (x,y)
@@ -142,6 +151,56 @@ class VarList(list):
             print "No differences found."
         return warning
 
+    def regression(self, list_b, sizes, tolerance, alpha):
+        """
+        Finds variants and buffer sizes for which list_b is slower than
+        self: median time increased by more than tolerance [%] and
+        the increase is statistically significant (one-sided
+        Mann-Whitney U test on times of all runs, p-value < alpha).
+        """
+
+        if tolerance is None:
+            tolerance = 5.0
+        if alpha is None:
+            alpha = 0.01
+        if tolerance < 0.0 or alpha <= 0.0 or alpha >= 1.0:
+            print "Bad argument: Tolerance must not be less than 0% and " \
+                "alpha must be in (0, 1) range"
+            exit(1)
+        print "TOLERANCE: {:.2f}%\tALPHA: {}".format(tolerance, alpha)
+
+        regressions = 0
+        print "NO\tARCH\tCIPHER\tDIR\tHASH\tKEYSZ\tSIZE\tMEDIAN A\t" \
+            "MEDIAN B\tCHANGE\tP-VALUE"
+        for i, obj_a in enumerate(self):
+            obj_b = list_b.find_obj(obj_a.params)
+            if obj_b is None:
+                continue
+            if obj_a.runs is None or obj_b.runs is None:
+                print "Error. Regression check needs times of all runs " \
+                    "(ipsec_perf --output-format json)."
+                exit(1)
+            for size, runs_a, runs_b in zip(sizes, obj_a.runs, obj_b.runs):
+                median_a = median(runs_a)
+                median_b = median(runs_b)
+                if median_a <= 0:
+                    continue
+                change = 100.0 * (median_b - median_a) / median_a
+                if change <= tolerance:
+                    continue
+                p_value = mann_whitney_greater(runs_b, runs_a)
+                if p_value >= alpha:
+                    continue
+                regressions += 1
+                print "{}\t{}\t{}\t{}\t{}\t{:+.2f}%\t{:.5f}".format(
+                    i + 1, obj_b.get_params_str(), size, median_a, median_b,
+                    change, p_value)
+        if regressions == 0:
+            print "No regressions found."
+        else:
+            print "{} regression(s) found.".format(regressions)
+        return regressions != 0
+
     def printout(self):
         """
         Prints out readable representation of the list
@@ -155,6 +214,56 @@ class VarList(list):
 
 
 
+def median(values):
+    """
+    Returns median of a list of numbers
+    """
+    ordered = sorted(values)
+    n = len(ordered)
+    if n == 0:
+        return 0
+    if n % 2:
+        return ordered[n // 2]
+    return (ordered[n // 2 - 1] + ordered[n // 2]) / 2.0
+
+def mann_whitney_greater(sample_x, sample_y):
+    """
+    One-sided Mann-Whitney U test: returns p-value of the hypothesis that
+    values of sample_x tend to be greater than values of sample_y
+    (normal approximation with tie correction)
+    """
+    n_x = len(sample_x)
+    n_y = len(sample_y)
+    if n_x == 0 or n_y == 0:
+        return 1.0
+
+    # Ranks of all values (ties get average rank)
+    values = sorted([(v, 0) for v in sample_x] + [(v, 1) for v in sample_y])
+    ranks = [0.0] * len(values)
+    tie_sum = 0.0
+    i = 0
+    while i < len(values):
+        j = i
+        while j + 1 < len(values) and values[j + 1][0] == values[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2.0 + 1
+        tie_cnt = j - i + 1
+        tie_sum += tie_cnt ** 3 - tie_cnt
+        i = j + 1
+
+    rank_sum_x = sum(r for r, (_, grp) in zip(ranks, values) if grp == 0)
+    u_x = rank_sum_x - n_x * (n_x + 1) / 2.0
+
+    n = n_x + n_y
+    mean_u = n_x * n_y / 2.0
+    var_u = n_x * n_y / 12.0 * ((n + 1) - tie_sum / float(n * (n - 1)))
+    if var_u <= 0:
+        return 1.0
+    # Continuity correction
+    z = (u_x - mean_u - 0.5) / math.sqrt(var_u)
+    return 0.5 * math.erfc(z / math.sqrt(2))
+
 class Parser(object):
     """
     Class used to parse a text file contaning performance data
@@ -174,6 +283,35 @@ class Parser(object):
         result = [int(i) for i in result]   # Converting str to int
         return result
 
+    def load_json(self, data):
+        """
+        Stores data from ipsec_perf JSON output in objects
+        """
+
+        v_list = VarList()
+        sizes = None
+        for var in data['variants']:
+            var_sizes = [res['size'] for res in var['results']]
+            if sizes is None:
+                sizes = var_sizes
+            elif sizes != var_sizes:
+                print "Error. Variants in {} use different buffer " \
+                    "sizes.".format(self.fname)
+                exit(1)
+
+            v_list.append(Variant(arch=var['arch'], cipher=var['cipher'],
+                                  dir=var['dir'], alg=var['hash'],
+                                  keysize="AES-{}".format(var['key_size'])))
+            v_list[-1].set_times([res['cycles'] for res in var['results']])
+            v_list[-1].set_runs([res['runs'] for res in var['results']])
+            v_list[-1].lin_reg(sizes)
+            if self.verbose:
+                print v_list[-1].get_params_str()
+                print v_list[-1].avg_times
+                print "({}, {})".format(v_list[-1].slope, v_list[-1].intercept)
+                print "============\n"
+        return v_list, sizes
+
     def load(self):
         """
         Reads a text file by columns, stores data in objects
@@ -190,7 +328,18 @@ class Parser(object):
             exit(1)
         else:
             with f:
-                cols = zip(*(line.strip().split('\t') for line in f))
+                if f.read(1) == '{':
+                    f.seek(0)
+                    return self.load_json(json.load(f))
+                f.seek(0)
+                # Average times come first, optional sections
+                # (e.g. latency) are separated by an empty line
+                lines = []
+                for line in f:
+                    if not line.strip():
+                        break
+                    lines.append(line)
+                cols = zip(*(line.strip().split('\t') for line in lines))
 
         # Reading first column with payload sizes, ommiting first 5 rows
         sizes = self.convert2int(cols[0][PAR_NUM:])
@@ -235,6 +384,8 @@ class DiffTool(object):
         self.tolerance = None
         self.verbose = False
         self.analyze = False
+        self.regression = False
+        self.alpha = None
 
     @staticmethod
     def usage():
@@ -243,15 +394,24 @@ class DiffTool(object):
         """
         print "This tool compares file_b against file_a printing out differences."
         print "Usage:"
-        print "\tipsec_diff_tool.py [-v] [-a] file_a file_b [tol]\n"
+        print "\tipsec_diff_tool.py [-v] [-a] file_a file_b [tol]"
+        print "\tipsec_diff_tool.py [-v] -r file_a file_b [tol] [alpha]\n"
         print "\t-v - verbose"
         print "\t-a - takes only one argument: name of the file to analyze"
-        print "\tfile_a, file_b - text files containing output from ipsec_perf tool"
-        print "\ttol - tolerance [%], must be >= 0, default 5\n"
+        print "\t-r - regression check: reports buffer sizes for which median"
+        print "\t     time of file_b is higher than file_a by more than tol"
+        print "\t     and the difference is statistically significant"
+        print "\t     (requires JSON files)"
+        print "\tfile_a, file_b - text or JSON files containing output from"
+        print "\t                 ipsec_perf tool"
+        print "\ttol - tolerance [%], must be >= 0, default 5"
+        print "\talpha - significance level, default 0.01\n"
+        print "Exit code is 2 if differences or regressions are found.\n"
         print "Examples:"
         print "\tipsec_diff_tool.py file01.txt file02.txt 10"
         print "\tipsec_diff_tool.py -a file02.txt"
         print "\tipsec_diff_tool.py -v -a file01.txt"
+        print "\tipsec_diff_tool.py -r file01.json file02.json 3 0.05"
 
 
     def parse_args(self):
@@ -261,7 +421,22 @@ class DiffTool(object):
         if len(sys.argv) < 3 or sys.argv[1] == "-h":
             self.usage()
             exit(1)
-        if sys.argv[1] == "-a":
+        args = sys.argv[1:]
+        if args[0] == "-v" and len(args) > 1 and args[1] == "-r":
+            self.verbose = True
+            args = args[1:]
+        if args[0] == "-r":
+            if len(args) < 3:
+                self.usage()
+                exit(1)
+            self.regression = True
+            self.fname_a = args[1]
+            self.fname_b = args[2]
+            if len(args) >= 4:
+                self.tolerance = float(args[3])
+            if len(args) >= 5:
+                self.alpha = float(args[4])
+        elif sys.argv[1] == "-a":
             self.analyze = True
             self.fname_a = sys.argv[2]
         elif sys.argv[2] == "-a":
@@ -298,7 +473,12 @@ class DiffTool(object):
                 print "Error. Buffer size lists in two compared " \
                         "data sets differ! Aborting.\n"
                 exit(1)
-            warning = list_a.compare(list_b, self.tolerance) # Compares list_b against list_a
+            if self.regression:
+                warning = list_a.regression(list_b, sizes_a, self.tolerance,
+                                            self.alpha)
+            else:
+                # Compares list_b against list_a
+                warning = list_a.compare(list_b, self.tolerance)
             if warning:
                 exit(2)
         else:
@@ -41,26 +41,40 @@
 #define __forceinline static __forceinline
 #else
 #include <x86intrin.h>
+#include <cpuid.h>
 #define __forceinline static inline __attribute__((always_inline))
 #include <unistd.h>
 #include <pthread.h>
 #include <sched.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
 #endif
 
 #include <intel-ipsec-mb.h>
 
 #include "msr.h"
+#include "perf_counters.h"
 
 #define BUFSIZE (512 * 1024 * 1024)
-#define JOB_SIZE_MAX (2 * 1024)
+#define JOB_SIZE_MAX (64 * 1024 - 512) /* fits 16-bit lengths of managers */
+#define JOB_SIZE_DEFAULT_MAX (2 * 1024) /* last size of default size sweep */
 #define JOB_SIZE_STEP 16
-#define REGION_SIZE (JOB_SIZE_MAX + 2048)
-#define NUM_OFFSETS (BUFSIZE / REGION_SIZE)
+#define REGION_SIZE_MIN (JOB_SIZE_DEFAULT_MAX + 2048)
+#define NUM_OFFSETS (BUFSIZE / REGION_SIZE_MIN)
+#define MAX_JOB_SIZES 4096 /* Maximum number of job sizes to test */
 #define NUM_RUNS 16
 #define KEYS_PER_JOB 15
-
-#define AAD_SIZE_MAX JOB_SIZE_MAX
-#define CCM_AAD_SIZE_MAX 46
+/* session (SA) state: expanded keys + HMAC ipad/opad (64 bytes each) */
+#define KEYS_PER_SESSION (KEYS_PER_JOB + 8)
+/* 3DES key schedule pointers are stored after the DES key schedule */
+#define DES3_KS_PTRS_IDX 8
+#define HUGEPAGE_SIZE (2 * 1024 * 1024)
+#define MAX_NUMA_NODES 64
+
+#define AAD_SIZE_MAX JOB_SIZE_DEFAULT_MAX
+#define CCM_AAD_SIZE_MAX 0xFEFF /* largest 2-byte AAD length encoding */
 #define DEFAULT_GCM_AAD_SIZE 12
 #define DEFAULT_CCM_AAD_SIZE 8
 
@@ -73,6 +87,17 @@
 
 #define MAX_NUM_THREADS 16 /* Maximum number of threads that can be created */
 
+#define MAX_PROFILE_ENTRIES 64 /* Maximum number of traffic profile entries */
+#define PROFILE_SCHED_SIZE 4096 /* Size of precomputed job schedule */
+/* Latency samples kept per profile entry (power of 2, most recent jobs) */
+#define PROFILE_LAT_SAMPLES (64 * 1024)
+#define MAX_DIST_ENTRIES 256 /* Maximum number of size distribution entries */
+#define DIST_SCHED_SIZE 4096 /* Size of precomputed job size schedule */
+#define MAX_SCALING_CORES 64 /* Maximum number of cores in scaling test */
+#define MAX_VICTIM_CORES 64 /* Maximum number of cores in victim test */
+#define WORKER_JOB_SIZE 1024 /* Default job size in scaling/victim tests */
+#define VICTIM_ITER_SCALE 100 /* Victim workload iterations per iter_scale */
+
 #define CIPHER_MODES_AES 4	/* CBC, CNTR, CNTR+8, NULL_CIPHER */
 #define CIPHER_MODES_DOCSIS 4	/* AES DOCSIS, AES DOCSIS+8, DES DOCSIS,
                                    DES DOCSIS+8 */
@@ -134,6 +159,12 @@ enum test_type_e {
         NUM_TTYPES
 };
 
+enum output_format_e {
+        OUTPUT_TEXT = 0,
+        OUTPUT_JSON,
+        OUTPUT_CSV
+};
+
 /* This enum will be mostly translated to JOB_CIPHER_MODE */
 enum test_cipher_mode_e {
         TEST_CBC = 1,
@@ -189,6 +220,7 @@ struct custom_job_params {
 
 union params {
         enum arch_type_e         arch_type;
+        enum output_format_e     output_format;
         struct custom_job_params job_params;
 };
 
@@ -411,16 +443,122 @@ struct str_value_mapping aead_algo_str_map[] = {
         }
 };
 
+/* Traffic profile entry (one kind of jobs mixed into the traffic) */
+struct profile_entry_s {
+        uint32_t                weight;
+        struct custom_job_params job_params;
+        uint32_t                size_min;
+        uint32_t                size_max;
+        char                    cipher_name[32];
+        char                    hash_name[32];
+};
+
+/* Traffic profile: weighted mix of jobs submitted to one manager */
+struct profile_s {
+        const char              *fname;
+        uint32_t                num_entries;
+        struct profile_entry_s  entries[MAX_PROFILE_ENTRIES];
+};
+
+/* Empirical job size distribution (sizes picked at random per job) */
+struct size_dist_s {
+        const char      *fname;
+        uint32_t        num_entries;
+        uint32_t        size_min[MAX_DIST_ENTRIES];
+        uint32_t        size_max[MAX_DIST_ENTRIES];
+        uint32_t        weight[MAX_DIST_ENTRIES];
+        uint32_t        mean; /* weighted mean job size */
+        uint32_t        sched[DIST_SCHED_SIZE]; /* precomputed job sizes */
+};
+
+struct str_value_mapping output_format_str_map[] = {
+        {.name = "text", .values.output_format = OUTPUT_TEXT},
+        {.name = "json", .values.output_format = OUTPUT_JSON},
+        {.name = "csv",  .values.output_format = OUTPUT_CSV}
+};
+
 struct str_value_mapping cipher_dir_str_map[] = {
         {.name = "encrypt", .values.job_params.cipher_dir = ENCRYPT},
         {.name = "decrypt", .values.job_params.cipher_dir = DECRYPT}
 };
 
+/* Latency statistics reported for each test variant */
+enum latency_stat_e {
+        LAT_P50 = 0,
+        LAT_P99,
+        LAT_P999,
+        LAT_MAX,
+        NUM_LAT_STATS
+};
+
+/* Per-job latency percentiles of a single test run (in cycles) */
+struct latency_s {
+        uint64_t p50;
+        uint64_t p99;
+        uint64_t p999;
+        uint64_t max;
+};
+
+/* Names used in the output (indexed by arch, cipher mode etc.) */
+const char *arch_names[NUM_ARCHS] = {
+        "SSE", "AVX", "AVX2", "AVX512"
+};
+const char *c_mode_names[12] = {
+        "CBC", "CNTR", "CNTR+8", "NULL_CIPHER", "DOCAES", "DOCAES+8",
+        "DOCDES", "DOCDES+4", "GCM", "CCM", "DES", "3DES"
+};
+const char *c_dir_names[2] = {
+        "ENCRYPT", "DECRYPT"
+};
+const char *h_alg_names[12] = {
+        "SHA1", "SHA_224", "SHA_256", "SHA_384", "SHA_512", "XCBC",
+        "MD5", "CMAC", "NULL_HASH", "GCM", "CUSTOM", "CCM"
+};
+
+/* Hardware performance counter values of a test run */
+struct perf_sample_s {
+        uint64_t jobs;
+        uint64_t values[NUM_PERF_COUNTERS];
+};
+
+/* Metric derived from performance counters: cnt / den * scale */
+#define PERF_PER_JOB (-1) /* denominator is number of jobs */
+struct perf_metric_s {
+        const char *name;
+        const char *key; /* name used in JSON/CSV output */
+        enum perf_counter_e cnt;
+        int den;
+        double scale;
+};
+
+const struct perf_metric_s perf_metrics[] = {
+        {"INSTRUCTIONS/JOB", "instructions_per_job",
+         PERF_CNT_INSTRUCTIONS, PERF_PER_JOB, 1.0},
+        {"IPC", "ipc", PERF_CNT_INSTRUCTIONS, PERF_CNT_CYCLES, 1.0},
+        {"L1D_MISSES/JOB", "l1d_misses_per_job",
+         PERF_CNT_L1D_MISSES, PERF_PER_JOB, 1.0},
+        {"L2_MISSES/JOB", "l2_misses_per_job",
+         PERF_CNT_L2_MISSES, PERF_PER_JOB, 1.0},
+        {"LLC_MISSES/JOB", "llc_misses_per_job",
+         PERF_CNT_LLC_MISSES, PERF_PER_JOB, 1.0},
+        {"APERF/MPERF", "aperf_mperf", PERF_CNT_APERF, PERF_CNT_MPERF, 1.0},
+        {"LICENSE1_CYCLES%", "license1_pct",
+         PERF_CNT_LICENSE1, PERF_CNT_CYCLES, 100.0},
+        {"LICENSE2_CYCLES%", "license2_pct",
+         PERF_CNT_LICENSE2, PERF_CNT_CYCLES, 100.0},
+        {"THROTTLE_CYCLES%", "throttle_pct",
+         PERF_CNT_THROTTLE, PERF_CNT_CYCLES, 100.0}
+};
+
 /* This struct stores all information about performed test case */
 struct variant_s {
         uint32_t arch;
         struct params_s params;
         uint64_t *avg_times;
+        struct latency_s *latencies; /* only allocated in latency mode */
+        struct perf_sample_s *counters; /* only in perf counters mode */
+        /* distribution and fixed mean size times (size distribution mode) */
+        uint64_t *dist_times;
 };
 
 /* Struct storing information to be passed to threads */
@@ -430,6 +568,49 @@ struct thread_info {
         MB_MGR *p_mgr;
 } t_info[MAX_NUM_THREADS];
 
+#ifdef _WIN32
+typedef HANDLE thread_t;
+typedef void (*thread_func_t)(void *);
+#else
+typedef pthread_t thread_t;
+typedef void *(*thread_func_t)(void *);
+#endif
+
+/* Struct storing information to be passed to job workers */
+/* Buffers referenced by a job template (sized for the largest hash) */
+struct job_data_s {
+        DECLARE_ALIGNED(struct gcm_key_data gdata_key, 512);
+        DECLARE_ALIGNED(uint32_t k1_expanded[11 * 4], 16);
+        DECLARE_ALIGNED(uint8_t k2[16], 16);
+        DECLARE_ALIGNED(uint8_t k3[16], 16);
+        DECLARE_ALIGNED(uint128_t iv, 16);
+        uint32_t ipad[16];
+        uint32_t opad[16];
+        uint32_t digest[16];
+};
+
+struct worker_info {
+        MB_MGR *p_mgr;
+        int core;
+        uint32_t first_index; /* range of buffers used by the worker */
+        uint32_t num_indexes;
+        uint32_t num_iter; /* 0 - run until worker_stop is set */
+        const struct params_s *params; /* worker builds own job template */
+        volatile int ready;
+        uint64_t cycles;
+        uint64_t end_time;
+        uint64_t jobs;
+};
+
+/* Struct storing information to be passed to victim test workers */
+struct victim_info {
+        int core;
+        uint64_t num_iter;
+        volatile int ready;
+        uint64_t time; /* wall-clock time of the workload in ns */
+        uint64_t result;
+};
+
 enum cache_type_e {
         WARM = 0,
         COLD = 1
@@ -445,11 +626,19 @@ uint8_t *buf = NULL;
 uint32_t index_limit;
 uint128_t *keys = NULL;
 uint64_t *offset_ptr = NULL;
+size_t buf_map_size = 0; /* buf/keys mmap'ed if not 0 */
+size_t keys_map_size = 0;
 uint32_t key_idxs[NUM_OFFSETS];
 uint32_t offsets[NUM_OFFSETS];
+struct job_data_s job_data; /* job template buffers of single thread tests */
+uint32_t num_offsets = NUM_OFFSETS;
+uint32_t region_size = REGION_SIZE_MIN; /* buffer space reserved per job */
 uint32_t sha_size_incr = 24;
 
-uint32_t job_size_start = UINT32_MAX;
+uint32_t job_sizes[MAX_JOB_SIZES]; /* buffer sizes to test */
+uint32_t num_job_sizes = 0; /* 0 - not set through command line */
+uint32_t max_job_size = JOB_SIZE_DEFAULT_MAX;
+struct size_dist_s *size_dist = NULL; /* job size distribution */
 uint32_t job_iter = 0;
 uint64_t gcm_aad_size = DEFAULT_GCM_AAD_SIZE;
 uint64_t ccm_aad_size = DEFAULT_CCM_AAD_SIZE;
@@ -466,6 +655,9 @@ uint8_t archs[NUM_ARCHS] = {1, 1, 1, 1}; /* uses all function sets */
 uint8_t test_types[NUM_TTYPES] = {1, 1, 1, 1, 1, 1, 0};
 
 int use_gcm_job_api = 0;
+int use_latency = 0; /* measure submit to completion latency of each job */
+
+enum output_format_e output_format = OUTPUT_TEXT;
 int use_unhalted_cycles = 0; /* read unhalted cycles instead of tsc */
 uint64_t rd_cycles_cost = 0; /* cost of reading unhalted cycles */
 uint64_t core_mask = 0; /* bitmap of selected cores */
@@ -474,6 +666,20 @@ uint64_t flags = 0; /* flags passed to alloc_mb_mgr() */
 
 uint32_t iter_scale = ITER_SCALE_LONG;
 
+struct profile_s *profile = NULL; /* traffic profile (mixed jobs test) */
+
+uint32_t scaling_cores = 0; /* run scaling test on 1 to N cores if not 0 */
+
+int use_perf_counters = 0; /* collect hardware performance counters */
+struct perf_counters perf_cnt; /* counters of the primary thread */
+uint64_t victim_mask = 0; /* cores running victim workload if not 0 */
+volatile int worker_start = 0; /* releases scaling/victim test workers */
+volatile int worker_stop = 0; /* stops job workers without iteration count */
+int numa_node = -1; /* NUMA node to allocate buffers and keys on if >= 0 */
+int use_hugepages = 0; /* back buffers and keys with 2MB pages */
+uint32_t num_sessions = 0; /* spread keys/SA state over N sessions if not 0 */
+int direct_api_test = 0; /* compare direct API functions with job API */
+
 /* Read unhalted cycles */
 __forceinline uint64_t read_cycles(uint32_t core)
 {
@@ -495,6 +701,55 @@ static int compare_uint64_t(const void *a, const void *b)
         return (int)(int64_t)(*(const uint64_t *)a - *(const uint64_t *)b);
 }
 
+/* Returns value at given per mille position of a sorted array */
+static uint64_t
+get_percentile(const uint64_t *sorted, const uint32_t size,
+               const uint32_t per_mille)
+{
+        return sorted[((uint64_t) (size - 1) * per_mille) / 1000];
+}
+
+/* Sorts per-job latencies and stores their percentiles */
+static void
+set_latency_stats(struct latency_s *lat, uint64_t *samples,
+                  const uint32_t size)
+{
+        memset(lat, 0, sizeof(*lat));
+        if (size == 0)
+                return;
+
+        qsort(samples, size, sizeof(uint64_t), compare_uint64_t);
+
+        lat->p50 = get_percentile(samples, size, 500);
+        lat->p99 = get_percentile(samples, size, 990);
+        lat->p999 = get_percentile(samples, size, 999);
+        lat->max = samples[size - 1];
+}
+
+/* Stores submit to completion latency of returned job */
+__forceinline void
+record_latency(const JOB_AES_HMAC *job, uint64_t *samples, uint32_t *count)
+{
+        uint32_t aux;
+
+        samples[(*count)++] =
+                __rdtscp(&aux) - (uint64_t) (uintptr_t) job->user_data;
+}
+
+/*
+ * Stores latency of returned job in a ring of PROFILE_LAT_SAMPLES entries,
+ * count keeps number of all jobs
+ */
+__forceinline void
+record_profile_latency(const JOB_AES_HMAC *job, uint64_t *samples,
+                       uint32_t *count)
+{
+        uint32_t aux;
+
+        samples[(*count)++ & (PROFILE_LAT_SAMPLES - 1)] =
+                __rdtscp(&aux) - (uint64_t) (uintptr_t) job->user_data;
+}
+
 /* Get number of bits set in value */
 static unsigned bitcount(const uint64_t val)
 {
@@ -655,14 +910,78 @@ static int set_avg_unhalted_cycle_cost(const int core, uint64_t *value)
         return 0;
 }
 
+#ifdef LINUX
+/*
+ * Maps memory, optionally backed by hugepages and bound to NUMA node
+ * (size is rounded up to the page size). Pages are faulted in before
+ * returning, so they are placed before any measurement.
+ */
+static void *alloc_mapped(size_t *size)
+{
+        const size_t page_size = use_hugepages ? HUGEPAGE_SIZE : 4096;
+        int map_flags = MAP_PRIVATE | MAP_ANONYMOUS;
+        void *ptr;
+
+        *size = ((*size + page_size - 1) / page_size) * page_size;
+        if (use_hugepages)
+                map_flags |= MAP_HUGETLB;
+
+        ptr = mmap(NULL, *size, PROT_READ | PROT_WRITE, map_flags, -1, 0);
+        if (ptr == MAP_FAILED) {
+                if (use_hugepages)
+                        fprintf(stderr, "Could not map %lu bytes of "
+                                "hugepages, check /proc/sys/vm/"
+                                "nr_hugepages\n", (unsigned long) *size);
+                return NULL;
+        }
+
+        if (numa_node >= 0) {
+                const unsigned long node_mask = 1UL << numa_node;
+
+                /* no libnuma dependency, call mbind() directly */
+                if (syscall(SYS_mbind, ptr, *size, MPOL_BIND, &node_mask,
+                            MAX_NUMA_NODES + 1, 0) != 0) {
+                        fprintf(stderr, "Could not bind memory to NUMA "
+                                "node %d\n", numa_node);
+                        munmap(ptr, *size);
+                        return NULL;
+                }
+        }
+
+        memset(ptr, 0, *size);
+
+        return ptr;
+}
+
+/* Returns NUMA node of the core or -1 if not known */
+static int get_core_numa_node(const int core)
+{
+        char path[128];
+        int node;
+
+        for (node = 0; node < MAX_NUMA_NODES; node++) {
+                snprintf(path, sizeof(path),
+                         "/sys/devices/system/cpu/cpu%d/node%d", core, node);
+                if (access(path, F_OK) == 0)
+                        return node;
+        }
+
+        return -1;
+}
+#endif
+
 /* Freeing allocated memory */
 static void free_mem(void)
 {
 #ifdef LINUX
-        if (offset_ptr != NULL)
+        if (keys_map_size != 0)
+                munmap(offset_ptr, keys_map_size);
+        else if (offset_ptr != NULL)
                 free(offset_ptr);
 
-        if (buf != NULL)
+        if (buf_map_size != 0)
+                munmap(buf, buf_map_size);
+        else if (buf != NULL)
                 free(buf);
 #else
         if (offset_ptr != NULL)
@@ -673,17 +992,69 @@ static void free_mem(void)
 #endif
 }
 
+/*
+ * 3DES jobs take an array of 3 key schedule pointers. Each key used
+ * by the tests gets its own array (all pointing to the same schedule),
+ * so that jobs in flight and worker threads don't share one.
+ */
+static void init_des3_ks_ptrs(void)
+{
+        uint32_t i;
+
+        for (i = 0; i < index_limit; i++) {
+                const void **ks_ptr =
+                        (const void **) &keys[key_idxs[i] + DES3_KS_PTRS_IDX];
+
+                ks_ptr[0] = ks_ptr[1] = ks_ptr[2] = &keys[key_idxs[i]];
+        }
+}
+
+/* Checks that every session is picked up by one of the jobs */
+static void check_sessions_used(void)
+{
+        uint8_t *used = (uint8_t *) calloc(num_sessions, sizeof(uint8_t));
+        uint32_t i, num_used = 0;
+
+        if (used == NULL) {
+                fprintf(stderr, "Could not malloc session flags\n");
+                free_mem();
+                exit(EXIT_FAILURE);
+        }
+        for (i = 0; i < index_limit; i += 2) {
+                const uint32_t session = key_idxs[i] / KEYS_PER_SESSION;
+
+                if (!used[session]) {
+                        used[session] = 1;
+                        num_used++;
+                }
+        }
+        free(used);
+        if (num_used != num_sessions) {
+                fprintf(stderr, "Only %u of %u sessions are used by "
+                        "jobs!\n", num_used, num_sessions);
+                free_mem();
+                exit(EXIT_FAILURE);
+        }
+}
+
 /* Input buffer initialization */
 static void init_buf(enum cache_type_e ctype)
 {
-        const size_t bufs_size = BUFSIZE + REGION_SIZE;
-        const size_t keys_size = NUM_OFFSETS * KEYS_PER_JOB * sizeof(uint128_t);
+        const size_t bufs_size = BUFSIZE + region_size;
+        const size_t keys_size = NUM_OFFSETS * sizeof(uint128_t) *
+                ((num_sessions != 0) ? KEYS_PER_SESSION : KEYS_PER_JOB);
         const size_t alignment = 64;
         uint32_t tmp_off;
         int i;
 
 #ifdef LINUX
-        buf = (uint8_t *) memalign(alignment, bufs_size);
+        if (numa_node >= 0 || use_hugepages) {
+                buf_map_size = bufs_size;
+                buf = (uint8_t *) alloc_mapped(&buf_map_size);
+                if (buf == NULL)
+                        buf_map_size = 0;
+        } else
+                buf = (uint8_t *) memalign(alignment, bufs_size);
 #else
         buf = (uint8_t *) _aligned_malloc(bufs_size, alignment);
 #endif
@@ -693,7 +1064,13 @@ static void init_buf(enum cache_type_e ctype)
         }
 
 #ifdef LINUX
-        offset_ptr = (uint64_t *) memalign(alignment, keys_size);
+        if (numa_node >= 0 || use_hugepages) {
+                keys_map_size = keys_size;
+                offset_ptr = (uint64_t *) alloc_mapped(&keys_map_size);
+                if (offset_ptr == NULL)
+                        keys_map_size = 0;
+        } else
+                offset_ptr = (uint64_t *) memalign(alignment, keys_size);
 #else
         offset_ptr = (uint64_t *) _aligned_malloc(keys_size, alignment);
 #endif
@@ -706,11 +1083,11 @@ static void init_buf(enum cache_type_e ctype)
         keys = (uint128_t *) offset_ptr;
 
         if (ctype == COLD) {
-                for (i = 0; i < NUM_OFFSETS; i++) {
-                        offsets[i] = i * REGION_SIZE + (rand() & 0x3C0);
+                for (i = 0; i < (int) num_offsets; i++) {
+                        offsets[i] = i * region_size + (rand() & 0x3C0);
                         key_idxs[i] = i * KEYS_PER_JOB;
                 }
-                for (i = NUM_OFFSETS - 1; i >= 0; i--) {
+                for (i = num_offsets - 1; i >= 0; i--) {
                         const uint64_t offset = (rand() * i) / RAND_MAX;
 
                         tmp_off = offsets[offset];
@@ -720,17 +1097,47 @@ static void init_buf(enum cache_type_e ctype)
                         key_idxs[offset] = key_idxs[i];
                         key_idxs[i] = tmp_off;
                 }
-                index_limit = NUM_OFFSETS;
+                index_limit = num_offsets;
         } else {/* WARM */
-                for (i = 0; i < NUM_OFFSETS; i += 2) {
-                        offsets[i]   = (2 * i + 0) * REGION_SIZE +
+                /* only a few first buffers are used */
+                for (i = 0; i < (int) num_offsets / 4; i += 2) {
+                        offsets[i]   = (2 * i + 0) * region_size +
                                 (rand() & 0x3C0);
-                        offsets[i + 1] = (2 * i + 1) * REGION_SIZE +
+                        offsets[i + 1] = (2 * i + 1) * region_size +
                                 (rand() & 0x3C0);
                         key_idxs[i]  = (2 * i + 0) * KEYS_PER_JOB;
                 }
                 index_limit = 8;
         }
+
+        if (num_sessions == 0) {
+                init_des3_ks_ptrs();
+                return;
+        }
+
+        /*
+         * Sessions: every job picks up keys and HMAC pads of one of
+         * the sessions, in random order. Tests advance the index by 2,
+         * so sessions are spread over the even slots only. With warm
+         * cache the same few packet buffers are reused, so only session
+         * state misses.
+         */
+        if (ctype == WARM && 2 * num_sessions > index_limit) {
+                for (i = index_limit; i < (int) (2 * num_sessions); i++)
+                        offsets[i] = offsets[i % index_limit];
+                index_limit = 2 * num_sessions;
+        }
+        for (i = 0; i < (int) index_limit; i++)
+                key_idxs[i] = ((i / 2) % num_sessions) * KEYS_PER_SESSION;
+        for (i = (index_limit + 1) / 2 - 1; i > 0; i--) {
+                const int idx = rand() % (i + 1);
+
+                tmp_off = key_idxs[2 * idx];
+                key_idxs[2 * idx] = key_idxs[2 * i];
+                key_idxs[2 * i] = tmp_off;
+        }
+        check_sessions_used();
+        init_des3_ks_ptrs();
 }
 
 /* This function translates enum test_ciper_mode_e to be used by ipsec_mb
@@ -777,160 +1184,212 @@ static JOB_CIPHER_MODE translate_cipher_mode(enum test_cipher_mode_e test_mode)
         return c_mode;
 }
 
-/* Performs test using AES_HMAC or DOCSIS */
-static uint64_t
-do_test(MB_MGR *mb_mgr, struct params_s *params,
-        const uint32_t num_iter)
+/* Sets message lengths and offsets of a job for given buffer size */
+static void
+set_job_size(JOB_AES_HMAC *job, const enum test_cipher_mode_e cipher_mode,
+             const uint32_t size)
 {
-        JOB_AES_HMAC *job;
-        JOB_AES_HMAC job_template;
-        uint32_t i;
-        static uint32_t index = 0;
-        static DECLARE_ALIGNED(uint128_t iv, 16);
-        static uint32_t ipad[5], opad[5], digest[3];
-        static DECLARE_ALIGNED(uint32_t k1_expanded[11 * 4], 16);
-        static DECLARE_ALIGNED(uint8_t	k2[16], 16);
-        static DECLARE_ALIGNED(uint8_t	k3[16], 16);
-        static DECLARE_ALIGNED(struct gcm_key_data gdata_key, 512);
         uint32_t size_aes;
-        uint64_t time = 0;
-        uint32_t aux;
 
-        if ((params->cipher_mode == TEST_AESDOCSIS8) ||
-            (params->cipher_mode == TEST_CNTR8))
-                size_aes = params->size_aes + 8;
-        else if (params->cipher_mode == TEST_DESDOCSIS4)
-                size_aes = params->size_aes + 4;
+        if ((cipher_mode == TEST_AESDOCSIS8) ||
+            (cipher_mode == TEST_CNTR8))
+                size_aes = size + 8;
+        else if (cipher_mode == TEST_DESDOCSIS4)
+                size_aes = size + 4;
         else
-                size_aes = params->size_aes;
+                size_aes = size;
 
-        job_template.msg_len_to_cipher_in_bytes = size_aes;
-        job_template.msg_len_to_hash_in_bytes = size_aes + sha_size_incr;
-        job_template.hash_start_src_offset_in_bytes = 0;
-        job_template.cipher_start_src_offset_in_bytes = sha_size_incr;
-        job_template.iv = (uint8_t *) &iv;
-        job_template.iv_len_in_bytes = 16;
+        job->msg_len_to_cipher_in_bytes = size_aes;
+        if (job->cipher_mode == CCM) {
+                job->msg_len_to_hash_in_bytes = size_aes;
+                job->hash_start_src_offset_in_bytes = 0;
+                job->cipher_start_src_offset_in_bytes = 0;
+        } else {
+                job->msg_len_to_hash_in_bytes = size_aes + sha_size_incr;
+                job->hash_start_src_offset_in_bytes = 0;
+                job->cipher_start_src_offset_in_bytes = sha_size_incr;
+        }
+}
+
+/*
+ * Prepares job template for given test parameters.
+ * IV, digest, HMAC pads and MAC keys of the template are kept in data.
+ */
+static void
+init_job_template(MB_MGR *mb_mgr, const struct params_s *params,
+                  JOB_AES_HMAC *job_template, struct job_data_s *data)
+{
+        uint32_t *ipad = data->ipad;
+        uint32_t *opad = data->opad;
+        uint32_t *k1_expanded = data->k1_expanded;
+        uint8_t *k2 = data->k2;
+        uint8_t *k3 = data->k3;
 
-        job_template.auth_tag_output = (uint8_t *) digest;
+        job_template->iv = (uint8_t *) &data->iv;
+        job_template->iv_len_in_bytes = 16;
+
+        job_template->auth_tag_output = (uint8_t *) data->digest;
 
         switch (params->hash_alg) {
         case TEST_XCBC:
-                job_template.u.XCBC._k1_expanded = k1_expanded;
-                job_template.u.XCBC._k2 = k2;
-                job_template.u.XCBC._k3 = k3;
-                job_template.hash_alg = AES_XCBC;
+                job_template->u.XCBC._k1_expanded = k1_expanded;
+                job_template->u.XCBC._k2 = k2;
+                job_template->u.XCBC._k3 = k3;
+                job_template->hash_alg = AES_XCBC;
                 break;
         case TEST_HASH_CCM:
-                job_template.hash_alg = AES_CCM;
+                job_template->hash_alg = AES_CCM;
                 break;
         case TEST_HASH_GCM:
-                job_template.hash_alg = AES_GMAC;
+                job_template->hash_alg = AES_GMAC;
                 break;
         case TEST_NULL_HASH:
-                job_template.hash_alg = NULL_HASH;
+                job_template->hash_alg = NULL_HASH;
                 break;
         case TEST_HASH_CMAC:
-                job_template.u.CMAC._key_expanded = k1_expanded;
-                job_template.u.CMAC._skey1 = k2;
-                job_template.u.CMAC._skey2 = k3;
-                job_template.hash_alg = AES_CMAC;
+                job_template->u.CMAC._key_expanded = k1_expanded;
+                job_template->u.CMAC._skey1 = k2;
+                job_template->u.CMAC._skey2 = k3;
+                job_template->hash_alg = AES_CMAC;
                 break;
         default:
                 /* HMAC hash alg is SHA1 or MD5 */
-                job_template.u.HMAC._hashed_auth_key_xor_ipad =
+                job_template->u.HMAC._hashed_auth_key_xor_ipad =
                         (uint8_t *) ipad;
-                job_template.u.HMAC._hashed_auth_key_xor_opad =
+                job_template->u.HMAC._hashed_auth_key_xor_opad =
                         (uint8_t *) opad;
-                job_template.hash_alg = (JOB_HASH_ALG) params->hash_alg;
+                job_template->hash_alg = (JOB_HASH_ALG) params->hash_alg;
                 break;
         }
-        job_template.auth_tag_output_len_in_bytes =
-                (uint64_t) auth_tag_length_bytes[job_template.hash_alg - 1];
+        job_template->auth_tag_output_len_in_bytes =
+                (uint64_t) auth_tag_length_bytes[job_template->hash_alg - 1];
 
-        job_template.cipher_direction = params->cipher_dir;
+        job_template->cipher_direction = params->cipher_dir;
 
         if (params->cipher_mode == TEST_NULL_CIPHER) {
-                job_template.chain_order = HASH_CIPHER;
+                job_template->chain_order = HASH_CIPHER;
         } else {
-                if (job_template.cipher_direction == ENCRYPT)
-                        job_template.chain_order = CIPHER_HASH;
+                if (job_template->cipher_direction == ENCRYPT)
+                        job_template->chain_order = CIPHER_HASH;
                 else
-                        job_template.chain_order = HASH_CIPHER;
+                        job_template->chain_order = HASH_CIPHER;
         }
 
         /* Translating enum to the API's one */
-        job_template.cipher_mode = translate_cipher_mode(params->cipher_mode);
-        job_template.aes_key_len_in_bytes = params->aes_key_size;
-        if (job_template.cipher_mode == GCM) {
+        job_template->cipher_mode = translate_cipher_mode(params->cipher_mode);
+        job_template->aes_key_len_in_bytes = params->aes_key_size;
+        if (job_template->cipher_mode == GCM) {
                 uint8_t key[32];
 
                 switch (params->aes_key_size) {
                 case AES_128_BYTES:
-                        IMB_AES128_GCM_PRE(mb_mgr, key, &gdata_key);
+                        IMB_AES128_GCM_PRE(mb_mgr, key, &data->gdata_key);
                         break;
                 case AES_192_BYTES:
-                        IMB_AES192_GCM_PRE(mb_mgr, key, &gdata_key);
+                        IMB_AES192_GCM_PRE(mb_mgr, key, &data->gdata_key);
                         break;
                 case AES_256_BYTES:
                 default:
-                        IMB_AES256_GCM_PRE(mb_mgr, key, &gdata_key);
+                        IMB_AES256_GCM_PRE(mb_mgr, key, &data->gdata_key);
                         break;
                 }
-                job_template.aes_enc_key_expanded = &gdata_key;
-                job_template.aes_dec_key_expanded = &gdata_key;
-                job_template.u.GCM.aad_len_in_bytes = params->aad_size;
-                job_template.iv_len_in_bytes = 12;
-        } else if (job_template.cipher_mode == CCM) {
-                job_template.msg_len_to_cipher_in_bytes = size_aes;
-                job_template.msg_len_to_hash_in_bytes = size_aes;
-                job_template.hash_start_src_offset_in_bytes = 0;
-                job_template.cipher_start_src_offset_in_bytes = 0;
-                job_template.u.CCM.aad_len_in_bytes = params->aad_size;
-                job_template.iv_len_in_bytes = 13;
-        } else if (job_template.cipher_mode == DES ||
-                   job_template.cipher_mode == DOCSIS_DES) {
-                job_template.aes_key_len_in_bytes = 8;
-                job_template.iv_len_in_bytes = 8;
-        } else if (job_template.cipher_mode == DES3) {
-                job_template.aes_key_len_in_bytes = 24;
-                job_template.iv_len_in_bytes = 8;
+                job_template->aes_enc_key_expanded = &data->gdata_key;
+                job_template->aes_dec_key_expanded = &data->gdata_key;
+                job_template->u.GCM.aad_len_in_bytes = params->aad_size;
+                job_template->iv_len_in_bytes = 12;
+        } else if (job_template->cipher_mode == CCM) {
+                job_template->u.CCM.aad_len_in_bytes = params->aad_size;
+                job_template->iv_len_in_bytes = 13;
+        } else if (job_template->cipher_mode == DES ||
+                   job_template->cipher_mode == DOCSIS_DES) {
+                job_template->aes_key_len_in_bytes = 8;
+                job_template->iv_len_in_bytes = 8;
+        } else if (job_template->cipher_mode == DES3) {
+                job_template->aes_key_len_in_bytes = 24;
+                job_template->iv_len_in_bytes = 8;
         }
 
-#ifndef _WIN32
-        if (use_unhalted_cycles)
-                time = read_cycles(params->core);
-        else
-#endif
-                time = __rdtscp(&aux);
+        set_job_size(job_template, params->cipher_mode, params->size_aes);
+}
+
+/* Sets buffers and keys of a job (index selects offset and key) */
+__forceinline void
+set_job_data(JOB_AES_HMAC *job, const uint32_t index)
+{
+        job->src = buf + offsets[index];
+        job->dst = buf + offsets[index] + sha_size_incr;
+        if (job->cipher_mode == GCM) {
+                job->u.GCM.aad = job->src;
+        } else if (job->cipher_mode == CCM) {
+                job->u.CCM.aad = job->src;
+                job->aes_enc_key_expanded = job->aes_dec_key_expanded =
+                        (uint32_t *) &keys[key_idxs[index]];
+        } else if (job->cipher_mode == DES3) {
+                /* pointers to the key schedule set up by init_buf() */
+                job->aes_enc_key_expanded = job->aes_dec_key_expanded =
+                        &keys[key_idxs[index] + DES3_KS_PTRS_IDX];
+        } else {
+                job->aes_enc_key_expanded = job->aes_dec_key_expanded =
+                        (uint32_t *) &keys[key_idxs[index]];
+        }
+        if (num_sessions != 0 &&
+            (job->hash_alg <= SHA_512 || job->hash_alg == MD5)) {
+                uint8_t *pads =
+                        (uint8_t *) &keys[key_idxs[index] + KEYS_PER_JOB];
+
+                job->u.HMAC._hashed_auth_key_xor_ipad = pads;
+                job->u.HMAC._hashed_auth_key_xor_opad = pads + 64;
+        }
+}
+
+/* Rounds buffer size down to the cipher block size (if required) */
+static uint32_t align_job_size(const enum test_cipher_mode_e cipher_mode,
+                               const uint32_t size)
+{
+        uint32_t block_size = 1;
+
+        if (cipher_mode == TEST_CBC)
+                block_size = 16;
+        else if (cipher_mode == TEST_DES || cipher_mode == TEST_3DES)
+                block_size = 8;
+
+        if (size < block_size)
+                return block_size;
+
+        return size - (size % block_size);
+}
+
+/*
+ * Submits num_iter jobs built from the template and flushes the manager.
+ * If sizes is not NULL then job sizes are taken from it in turn.
+ * If lat_samples is not NULL then each job is time stamped at submission
+ * and its latency is recorded when the job is returned by the manager.
+ */
+__forceinline void
+run_jobs(MB_MGR *mb_mgr, const struct params_s *params,
+         const JOB_AES_HMAC *job_template, const uint32_t num_iter,
+         const uint32_t *sizes, uint64_t *lat_samples, uint32_t *lat_count)
+{
+        JOB_AES_HMAC *job;
+        uint32_t i;
+        static uint32_t index = 0;
+        uint32_t aux;
 
         for (i = 0; i < num_iter; i++) {
                 job = IMB_GET_NEXT_JOB(mb_mgr);
-                *job = job_template;
-
-                job->src = buf + offsets[index];
-                job->dst = buf + offsets[index] + sha_size_incr;
-                if (job->cipher_mode == GCM) {
-                        job->u.GCM.aad = job->src;
-                } else if (job->cipher_mode == CCM) {
-                        job->u.CCM.aad = job->src;
-                        job->aes_enc_key_expanded = job->aes_dec_key_expanded =
-                                (uint32_t *) &keys[key_idxs[index]];
-                } else if (job->cipher_mode == DES3) {
-                        static const void *ks_ptr[3];
-
-                        ks_ptr[0] = ks_ptr[1] = ks_ptr[2] =
-                                &keys[key_idxs[index]];
-                        job->aes_enc_key_expanded =
-                                job->aes_dec_key_expanded = ks_ptr;
-                } else {
-                        job->aes_enc_key_expanded = job->aes_dec_key_expanded =
-                                (uint32_t *) &keys[key_idxs[index]];
-                }
+                *job = *job_template;
+                if (sizes != NULL)
+                        set_job_size(job, params->cipher_mode,
+                                     sizes[i % DIST_SCHED_SIZE]);
+                set_job_data(job, index);
 
                 index += 2;
                 if (index >= index_limit)
                         index = 0;
 
+                if (lat_samples != NULL)
+                        job->user_data = (void *) (uintptr_t) __rdtscp(&aux);
+
 #ifdef DEBUG
                 job = IMB_SUBMIT_JOB(mb_mgr);
 #else
@@ -942,6 +1401,8 @@ do_test(MB_MGR *mb_mgr, struct params_s *params,
                                 fprintf(stderr, "failed job, status:%d\n",
                                         job->status);
 #endif
+                        if (lat_samples != NULL)
+                                record_latency(job, lat_samples, lat_count);
                         job = IMB_GET_COMPLETED_JOB(mb_mgr);
                 }
         }
@@ -951,7 +1412,42 @@ do_test(MB_MGR *mb_mgr, struct params_s *params,
                 if (job->status != STS_COMPLETED)
                         fprintf(stderr, "failed job, status:%d\n", job->status);
 #endif
+                if (lat_samples != NULL)
+                        record_latency(job, lat_samples, lat_count);
         }
+}
+
+/*
+ * Performs test using AES_HMAC or DOCSIS
+ * If size_sched is not NULL then job sizes are taken from it
+ * (DIST_SCHED_SIZE entries, e.g. random sizes of a distribution).
+ */
+static uint64_t
+do_test(MB_MGR *mb_mgr, struct params_s *params,
+        const uint32_t num_iter, const uint32_t *size_sched)
+{
+        JOB_AES_HMAC job_template;
+        uint32_t i;
+        uint64_t time = 0;
+        uint32_t aux;
+        uint32_t sizes[DIST_SCHED_SIZE];
+
+        if (size_sched != NULL)
+                for (i = 0; i < DIST_SCHED_SIZE; i++)
+                        sizes[i] = align_job_size(params->cipher_mode,
+                                                  size_sched[i]);
+
+        init_job_template(mb_mgr, params, &job_template, &job_data);
+
+#ifndef _WIN32
+        if (use_unhalted_cycles)
+                time = read_cycles(params->core);
+        else
+#endif
+                time = __rdtscp(&aux);
+
+        run_jobs(mb_mgr, params, &job_template, num_iter,
+                 (size_sched != NULL) ? sizes : NULL, NULL, NULL);
 
 #ifndef _WIN32
         if (use_unhalted_cycles)
@@ -963,69 +1459,299 @@ do_test(MB_MGR *mb_mgr, struct params_s *params,
         return time / num_iter;
 }
 
-/* Performs test using GCM */
-static uint64_t
-do_test_gcm(struct params_s *params,
-            const uint32_t num_iter, MB_MGR *mb_mgr)
+/*
+ * Measures per-job latencies of a test in a pass of its own,
+ * so that time stamping doesn't affect throughput results of do_test()
+ */
+static void
+do_test_latency(MB_MGR *mb_mgr, struct params_s *params,
+                const uint32_t num_iter, struct latency_s *lat)
 {
-        static DECLARE_ALIGNED(struct gcm_key_data gdata_key, 512);
-        static DECLARE_ALIGNED(struct gcm_context_data gdata_ctx, 64);
-        uint8_t *key;
-        static uint32_t index = 0;
-        uint32_t size_aes = params->size_aes;
-        uint32_t i;
-        uint8_t *aad = NULL;
-        uint8_t auth_tag[12];
-        DECLARE_ALIGNED(uint8_t iv[16], 16);
-        uint64_t time = 0;
-        uint32_t aux;
+        JOB_AES_HMAC job_template;
+        uint64_t *lat_samples;
+        uint32_t lat_count = 0;
 
-        key = (uint8_t *) malloc(sizeof(uint8_t) * params->aes_key_size);
-        if (!key) {
-                fprintf(stderr, "Could not malloc key\n");
+        lat_samples = (uint64_t *) malloc(num_iter * sizeof(uint64_t));
+        if (lat_samples == NULL) {
+                fprintf(stderr, "Could not malloc latency samples\n");
                 free_mem();
                 exit(EXIT_FAILURE);
         }
 
-        aad = (uint8_t *) malloc(sizeof(uint8_t) * params->aad_size);
-        if (!aad) {
-                free(key);
-                fprintf(stderr, "Could not malloc AAD\n");
-                free_mem();
-                exit(EXIT_FAILURE);
-        }
+        init_job_template(mb_mgr, params, &job_template, &job_data);
+        run_jobs(mb_mgr, params, &job_template, num_iter, NULL,
+                 lat_samples, &lat_count);
 
-        switch (params->aes_key_size) {
-        case AES_128_BYTES:
-                IMB_AES128_GCM_PRE(mb_mgr, key, &gdata_key);
-                break;
-        case AES_192_BYTES:
-                IMB_AES192_GCM_PRE(mb_mgr, key, &gdata_key);
-                break;
-        case AES_256_BYTES:
-        default:
-                IMB_AES256_GCM_PRE(mb_mgr, key, &gdata_key);
-                break;
-        }
+        set_latency_stats(lat, lat_samples, lat_count);
+        free(lat_samples);
+}
 
-        if (params->cipher_dir == ENCRYPT) {
-#ifndef _WIN32
-                if (use_unhalted_cycles)
-                        time = read_cycles(params->core);
-                else
-#endif
-                        time = __rdtscp(&aux);
+/*
+ * Submits num_iter jobs of a traffic profile following the precomputed
+ * schedule of entries and sizes, then flushes the manager.
+ * If lat_samples is not NULL then each job is time stamped at submission
+ * and its latency is recorded for its entry when it is returned.
+ */
+static void
+run_profile_jobs(MB_MGR *mb_mgr, const JOB_AES_HMAC *templates,
+                 const uint8_t *sched_entry, const uint32_t *sched_size,
+                 const uint32_t num_iter, uint64_t **lat_samples,
+                 uint32_t *lat_count)
+{
+        JOB_AES_HMAC *job;
+        uint32_t i, e, index = 0;
+        uint32_t aux;
 
-                if (params->aes_key_size == AES_128_BYTES) {
-                        for (i = 0; i < num_iter; i++) {
-                                IMB_AES128_GCM_ENC(mb_mgr, &gdata_key,
-                                                   &gdata_ctx,
-                                                   buf + offsets[index]
-                                                   + sha_size_incr,
-                                                   buf + offsets[index]
-                                                   + sha_size_incr,
-                                                   size_aes, iv,
-                                                   aad, params->aad_size,
+        for (i = 0; i < num_iter; i++) {
+                const uint32_t slot = i % PROFILE_SCHED_SIZE;
+                const uint32_t entry = sched_entry[slot];
+
+                job = IMB_GET_NEXT_JOB(mb_mgr);
+                *job = templates[entry];
+                set_job_size(job,
+                             profile->entries[entry].job_params.cipher_mode,
+                             sched_size[slot]);
+                set_job_data(job, index);
+                job->user_data2 = (void *) (uintptr_t) entry;
+
+                index += 2;
+                if (index >= index_limit)
+                        index = 0;
+
+                if (lat_samples != NULL)
+                        job->user_data = (void *) (uintptr_t) __rdtscp(&aux);
+#ifdef DEBUG
+                job = IMB_SUBMIT_JOB(mb_mgr);
+#else
+                job = IMB_SUBMIT_JOB_NOCHECK(mb_mgr);
+#endif
+                while (job) {
+#ifdef DEBUG
+                        if (job->status != STS_COMPLETED)
+                                fprintf(stderr, "failed job, status:%d\n",
+                                        job->status);
+#endif
+                        if (lat_samples != NULL) {
+                                e = (uint32_t) (uintptr_t) job->user_data2;
+                                record_profile_latency(job, lat_samples[e],
+                                                       &lat_count[e]);
+                        }
+                        job = IMB_GET_COMPLETED_JOB(mb_mgr);
+                }
+        }
+
+        while ((job = IMB_FLUSH_JOB(mb_mgr))) {
+#ifdef DEBUG
+                if (job->status != STS_COMPLETED)
+                        fprintf(stderr, "failed job, status:%d\n", job->status);
+#endif
+                if (lat_samples != NULL) {
+                        e = (uint32_t) (uintptr_t) job->user_data2;
+                        record_profile_latency(job, lat_samples[e],
+                                               &lat_count[e]);
+                }
+        }
+}
+
+/*
+ * Performs traffic profile test: jobs of all profile entries are
+ * interleaved (following entry weights) and submitted to one manager.
+ * Reports throughput and per-entry job latencies, measured in two
+ * passes over the same schedule so that time stamping doesn't affect
+ * the throughput result.
+ */
+static void
+do_test_profile(MB_MGR *mb_mgr, const uint32_t arch, const uint32_t core,
+                const uint32_t num_iter, const int print_info)
+{
+        JOB_AES_HMAC templates[MAX_PROFILE_ENTRIES];
+        uint64_t *lat_samples[MAX_PROFILE_ENTRIES];
+        uint32_t lat_count[MAX_PROFILE_ENTRIES];
+        uint32_t entry_jobs[MAX_PROFILE_ENTRIES];
+        uint64_t entry_bytes[MAX_PROFILE_ENTRIES];
+        uint8_t sched_entry[PROFILE_SCHED_SIZE];
+        uint32_t sched_size[PROFILE_SCHED_SIZE];
+        uint32_t total_weight = 0;
+        uint64_t total_bytes = 0;
+        uint64_t time;
+        uint32_t i, n;
+        uint32_t aux;
+
+        memset(lat_count, 0, sizeof(lat_count));
+        memset(entry_jobs, 0, sizeof(entry_jobs));
+        memset(entry_bytes, 0, sizeof(entry_bytes));
+
+        for (n = 0; n < profile->num_entries; n++) {
+                const struct profile_entry_s *entry = &profile->entries[n];
+                struct params_s params;
+
+                memset(&params, 0, sizeof(params));
+                params.cipher_mode = entry->job_params.cipher_mode;
+                params.hash_alg = entry->job_params.hash_alg;
+                params.aes_key_size = entry->job_params.aes_key_size;
+                params.cipher_dir = entry->job_params.cipher_dir;
+                params.size_aes = entry->size_min;
+                params.core = core;
+                if (params.cipher_mode == TEST_GCM)
+                        params.aad_size = gcm_aad_size;
+                if (params.cipher_mode == TEST_CCM)
+                        params.aad_size = ccm_aad_size;
+
+                memset(&templates[n], 0, sizeof(templates[n]));
+                init_job_template(mb_mgr, &params, &templates[n],
+                                  &job_data);
+
+                lat_samples[n] = (uint64_t *) malloc(PROFILE_LAT_SAMPLES *
+                                                     sizeof(uint64_t));
+                if (lat_samples[n] == NULL) {
+                        fprintf(stderr, "Could not malloc latency samples\n");
+                        free_mem();
+                        exit(EXIT_FAILURE);
+                }
+                total_weight += entry->weight;
+        }
+
+        /*
+         * Precompute pseudo-random schedule of jobs
+         * so that picking entries and sizes is not timed
+         */
+        for (i = 0; i < PROFILE_SCHED_SIZE; i++) {
+                const struct profile_entry_s *entry;
+                uint32_t w = (uint32_t) rand() % total_weight;
+
+                for (n = 0; w >= profile->entries[n].weight; n++)
+                        w -= profile->entries[n].weight;
+
+                entry = &profile->entries[n];
+                sched_entry[i] = (uint8_t) n;
+                sched_size[i] = entry->size_min;
+                if (entry->size_max > entry->size_min)
+                        sched_size[i] += (uint32_t) rand() %
+                                (entry->size_max - entry->size_min + 1);
+                sched_size[i] = align_job_size(entry->job_params.cipher_mode,
+                                               sched_size[i]);
+        }
+
+        for (i = 0; i < num_iter; i++) {
+                const uint32_t slot = i % PROFILE_SCHED_SIZE;
+
+                entry_jobs[sched_entry[slot]]++;
+                entry_bytes[sched_entry[slot]] += sched_size[slot];
+        }
+
+        /* throughput pass */
+        time = __rdtscp(&aux);
+        run_profile_jobs(mb_mgr, templates, sched_entry, sched_size,
+                         num_iter, NULL, NULL);
+        time = __rdtscp(&aux) - time;
+
+        /* latency pass */
+        run_profile_jobs(mb_mgr, templates, sched_entry, sched_size,
+                         num_iter, lat_samples, lat_count);
+
+        if (print_info) {
+                printf("PROFILE\t%s\tARCH\t%s\n", profile->fname,
+                       arch_names[arch]);
+                printf("ENTRY\tWEIGHT\tCIPHER\tHASH\tDIR\tSIZE\tJOBS\t"
+                       "BYTES\tP50\tP99\tP99.9\tMAX\n");
+        }
+
+        for (n = 0; n < profile->num_entries; n++) {
+                const struct profile_entry_s *entry = &profile->entries[n];
+                struct latency_s lat;
+
+                set_latency_stats(&lat, lat_samples[n],
+                                  (lat_count[n] < PROFILE_LAT_SAMPLES) ?
+                                  lat_count[n] : PROFILE_LAT_SAMPLES);
+                total_bytes += entry_bytes[n];
+                free(lat_samples[n]);
+
+                if (!print_info)
+                        continue;
+
+                printf("%u\t%u\t%s\t%s\t%s\t%u-%u\t%u\t%llu\t%llu\t%llu\t"
+                       "%llu\t%llu\n", n + 1, entry->weight,
+                       entry->cipher_name, entry->hash_name,
+                       c_dir_names[entry->job_params.cipher_dir - ENCRYPT],
+                       entry->size_min, entry->size_max, entry_jobs[n],
+                       (unsigned long long) entry_bytes[n],
+                       (unsigned long long) lat.p50,
+                       (unsigned long long) lat.p99,
+                       (unsigned long long) lat.p999,
+                       (unsigned long long) lat.max);
+        }
+
+        if (print_info)
+                printf("TOTAL\tjobs %u\tbytes %llu\tcycles/job %.2f\t"
+                       "cycles/byte %.3f\n\n", num_iter,
+                       (unsigned long long) total_bytes,
+                       (double) time / num_iter,
+                       total_bytes ? (double) time / total_bytes : 0.0);
+}
+
+/* Performs test using GCM */
+static uint64_t
+do_test_gcm(struct params_s *params,
+            const uint32_t num_iter, MB_MGR *mb_mgr)
+{
+        static DECLARE_ALIGNED(struct gcm_key_data gdata_key, 512);
+        static DECLARE_ALIGNED(struct gcm_context_data gdata_ctx, 64);
+        uint8_t *key;
+        static uint32_t index = 0;
+        uint32_t size_aes = params->size_aes;
+        uint32_t i;
+        uint8_t *aad = NULL;
+        uint8_t auth_tag[12];
+        DECLARE_ALIGNED(uint8_t iv[16], 16);
+        uint64_t time = 0;
+        uint32_t aux;
+
+        key = (uint8_t *) malloc(sizeof(uint8_t) * params->aes_key_size);
+        if (!key) {
+                fprintf(stderr, "Could not malloc key\n");
+                free_mem();
+                exit(EXIT_FAILURE);
+        }
+
+        aad = (uint8_t *) malloc(sizeof(uint8_t) * params->aad_size);
+        if (!aad) {
+                free(key);
+                fprintf(stderr, "Could not malloc AAD\n");
+                free_mem();
+                exit(EXIT_FAILURE);
+        }
+
+        switch (params->aes_key_size) {
+        case AES_128_BYTES:
+                IMB_AES128_GCM_PRE(mb_mgr, key, &gdata_key);
+                break;
+        case AES_192_BYTES:
+                IMB_AES192_GCM_PRE(mb_mgr, key, &gdata_key);
+                break;
+        case AES_256_BYTES:
+        default:
+                IMB_AES256_GCM_PRE(mb_mgr, key, &gdata_key);
+                break;
+        }
+
+        if (params->cipher_dir == ENCRYPT) {
+#ifndef _WIN32
+                if (use_unhalted_cycles)
+                        time = read_cycles(params->core);
+                else
+#endif
+                        time = __rdtscp(&aux);
+
+                if (params->aes_key_size == AES_128_BYTES) {
+                        for (i = 0; i < num_iter; i++) {
+                                IMB_AES128_GCM_ENC(mb_mgr, &gdata_key,
+                                                   &gdata_ctx,
+                                                   buf + offsets[index]
+                                                   + sha_size_incr,
+                                                   buf + offsets[index]
+                                                   + sha_size_incr,
+                                                   size_aes, iv,
+                                                   aad, params->aad_size,
                                                    auth_tag, sizeof(auth_tag));
                                 index += 2;
                                 if (index >= index_limit)
@@ -1179,10 +1905,17 @@ process_variant(MB_MGR *mgr, const uint32_t arch, struct params_s *params,
 {
         const uint32_t sizes = params->num_sizes;
         uint64_t *times = &variant_ptr->avg_times[run];
+        struct latency_s *lat = NULL;
+        struct perf_sample_s *perf = NULL;
         uint32_t sz;
 
+        if (use_latency)
+                lat = &variant_ptr->latencies[run];
+        if (variant_ptr->counters != NULL)
+                perf = &variant_ptr->counters[run];
+
         for (sz = 0; sz < sizes; sz++) {
-                const uint32_t size_aes = job_size_start + (sz * JOB_SIZE_STEP);
+                const uint32_t size_aes = job_sizes[sz];
                 uint32_t num_iter;
 
                 params->aad_size = 0;
@@ -1207,18 +1940,52 @@ process_variant(MB_MGR *mgr, const uint32_t arch, struct params_s *params,
                         num_iter = iter_scale;
 
                 params->size_aes = size_aes;
+                if (perf != NULL)
+                        perf_counters_start(&perf_cnt);
                 if (params->cipher_mode == TEST_GCM && (!use_gcm_job_api)) {
+                        num_iter *= 2;
                         if (job_iter == 0)
-                                *times = do_test_gcm(params, 2 * num_iter, mgr);
+                                *times = do_test_gcm(params, num_iter, mgr);
                         else
                                 *times = do_test_gcm(params, job_iter, mgr);
                 } else {
                         if (job_iter == 0)
-                                *times = do_test(mgr, params, num_iter);
+                                *times = do_test(mgr, params, num_iter, NULL);
                         else
-                                *times = do_test(mgr, params, job_iter);
+                                *times = do_test(mgr, params, job_iter, NULL);
+                }
+                if (perf != NULL) {
+                        perf_counters_stop(&perf_cnt, perf->values);
+                        perf->jobs = (job_iter == 0) ? num_iter : job_iter;
+                        perf += NUM_RUNS;
                 }
                 times += NUM_RUNS;
+                if (lat != NULL) {
+                        /* latencies are taken for job API tests only */
+                        if (params->cipher_mode != TEST_GCM ||
+                            use_gcm_job_api)
+                                do_test_latency(mgr, params, (job_iter == 0) ?
+                                                num_iter : job_iter, lat);
+                        lat += NUM_RUNS;
+                }
+        }
+
+        /*
+         * Random sizes of the distribution vs fixed mean size
+         * (same amount of data, shows cost of lane imbalance)
+         */
+        if (variant_ptr->dist_times != NULL) {
+                const uint32_t mean = size_dist->mean;
+                uint32_t num_iter = (iter_scale >= mean) ?
+                        (iter_scale / mean) : 1;
+
+                if (job_iter != 0)
+                        num_iter = job_iter;
+                params->size_aes = align_job_size(params->cipher_mode, mean);
+                variant_ptr->dist_times[run] =
+                        do_test(mgr, params, num_iter, size_dist->sched);
+                variant_ptr->dist_times[NUM_RUNS + run] =
+                        do_test(mgr, params, num_iter, NULL);
         }
 
         variant_ptr->params = *params;
@@ -1289,22 +2056,9 @@ do_variants(MB_MGR *mgr, const uint32_t arch, struct params_s *params,
         }
 }
 
-/* Sets cipher direction and key size  */
-static void
-run_dir_test(MB_MGR *mgr, const uint32_t arch, struct params_s *params,
-             const uint32_t run, struct variant_s **variant_ptr,
-             uint32_t *variant)
+/* Initializes manager for selected architecture */
+static void init_mgr_arch(MB_MGR *mgr, const uint32_t arch)
 {
-        uint32_t dir;
-        uint32_t k; /* Key size */
-        uint32_t limit = AES_256_BYTES; /* Key size value limit */
-
-        if (params->test_type == TTYPE_AES_DOCSIS ||
-            params->test_type == TTYPE_AES_DES ||
-            params->test_type == TTYPE_AES_3DES ||
-            params->test_type == TTYPE_AES_CCM)
-                limit = AES_128_BYTES;
-
         switch (arch) {
         case 0:
                 init_mb_mgr_sse(mgr);
@@ -1320,6 +2074,25 @@ run_dir_test(MB_MGR *mgr, const uint32_t arch, struct params_s *params,
                 init_mb_mgr_avx512(mgr);
                 break;
         }
+}
+
+/* Sets cipher direction and key size  */
+static void
+run_dir_test(MB_MGR *mgr, const uint32_t arch, struct params_s *params,
+             const uint32_t run, struct variant_s **variant_ptr,
+             uint32_t *variant)
+{
+        uint32_t dir;
+        uint32_t k; /* Key size */
+        uint32_t limit = AES_256_BYTES; /* Key size value limit */
+
+        if (params->test_type == TTYPE_AES_DOCSIS ||
+            params->test_type == TTYPE_AES_DES ||
+            params->test_type == TTYPE_AES_3DES ||
+            params->test_type == TTYPE_AES_CCM)
+                limit = AES_128_BYTES;
+
+        init_mgr_arch(mgr, arch);
 
         if (params->test_type == TTYPE_CUSTOM) {
                 params->cipher_dir = custom_job_params.cipher_dir;
@@ -1340,36 +2113,21 @@ run_dir_test(MB_MGR *mgr, const uint32_t arch, struct params_s *params,
         }
 }
 
-/* Generates output containing averaged times for each test variant */
-static void print_times(struct variant_s *variant_list, struct params_s *params,
-                        const uint32_t total_variants)
+/* Prints rows describing test variants (one variant per column) */
+static void print_variant_header(struct variant_s *variant_list,
+                                 const uint32_t total_variants)
 {
-        const uint32_t sizes = params->num_sizes;
         uint32_t col;
-        uint32_t sz;
 
         /* Temporary variables */
         struct params_s par;
         uint8_t	c_mode;
         uint8_t c_dir;
         uint8_t h_alg;
-        const char *func_names[4] = {
-                "SSE", "AVX", "AVX2", "AVX512"
-        };
-        const char *c_mode_names[12] = {
-                "CBC", "CNTR", "CNTR+8", "NULL_CIPHER", "DOCAES", "DOCAES+8",
-                "DOCDES", "DOCDES+4", "GCM", "CCM", "DES", "3DES"
-        };
-        const char *c_dir_names[2] = {
-                "ENCRYPT", "DECRYPT"
-        };
-        const char *h_alg_names[12] = {
-                "SHA1", "SHA_224", "SHA_256", "SHA_384", "SHA_512", "XCBC",
-                "MD5", "CMAC", "NULL_HASH", "GCM", "CUSTOM", "CCM"
-        };
+
         printf("ARCH");
         for (col = 0; col < total_variants; col++)
-                printf("\t%s", func_names[variant_list[col].arch]);
+                printf("\t%s", arch_names[variant_list[col].arch]);
         printf("\n");
         printf("CIPHER");
         for (col = 0; col < total_variants; col++) {
@@ -1377,39 +2135,1699 @@ static void print_times(struct variant_s *variant_list, struct params_s *params,
                 c_mode = par.cipher_mode - CBC;
                 printf("\t%s", c_mode_names[c_mode]);
         }
-        printf("\n");
-        printf("DIR");
-        for (col = 0; col < total_variants; col++) {
-                par = variant_list[col].params;
-                c_dir = par.cipher_dir - ENCRYPT;
-                printf("\t%s", c_dir_names[c_dir]);
+        printf("\n");
+        printf("DIR");
+        for (col = 0; col < total_variants; col++) {
+                par = variant_list[col].params;
+                c_dir = par.cipher_dir - ENCRYPT;
+                printf("\t%s", c_dir_names[c_dir]);
+        }
+        printf("\n");
+        printf("HASH_ALG");
+        for (col = 0; col < total_variants; col++) {
+                par = variant_list[col].params;
+                h_alg = par.hash_alg - SHA1;
+                printf("\t%s", h_alg_names[h_alg]);
+        }
+        printf("\n");
+        printf("KEY_SIZE");
+        for (col = 0; col < total_variants; col++) {
+                par = variant_list[col].params;
+                printf("\tAES-%u", par.aes_key_size * 8);
+        }
+        printf("\n");
+}
+
+/* Generates output containing averaged times for each test variant */
+static void print_times(struct variant_s *variant_list, struct params_s *params,
+                        const uint32_t total_variants)
+{
+        const uint32_t sizes = params->num_sizes;
+        uint32_t col;
+        uint32_t sz;
+
+        print_variant_header(variant_list, total_variants);
+        for (sz = 0; sz < sizes; sz++) {
+                printf("%d", job_sizes[sz]);
+                for (col = 0; col < total_variants; col++) {
+                        uint64_t *time_ptr =
+                                &variant_list[col].avg_times[sz * NUM_RUNS];
+                        const unsigned long long val =
+                                mean_median(time_ptr, NUM_RUNS);
+
+                        printf("\t%llu", val);
+                }
+                printf("\n");
+        }
+}
+
+/* Returns selected latency percentile of a test run */
+static uint64_t get_latency_stat(const struct latency_s *lat,
+                                 const unsigned stat)
+{
+        switch (stat) {
+        case LAT_P50:
+                return lat->p50;
+        case LAT_P99:
+                return lat->p99;
+        case LAT_P999:
+                return lat->p999;
+        default:
+                return lat->max;
+        }
+}
+
+/* Returns time of a test variant for given size averaged over runs */
+static uint64_t get_avg_time(const struct variant_s *variant, const uint32_t sz)
+{
+        uint64_t vals[NUM_RUNS];
+
+        memcpy(vals, &variant->avg_times[sz * NUM_RUNS], sizeof(vals));
+        return mean_median(vals, NUM_RUNS);
+}
+
+/*
+ * Returns time of a test variant for the size distribution (fixed = 0)
+ * or for fixed mean size of the distribution (fixed = 1)
+ */
+static uint64_t get_dist_time(const struct variant_s *variant,
+                              const unsigned fixed)
+{
+        uint64_t vals[NUM_RUNS];
+
+        memcpy(vals, &variant->dist_times[fixed * NUM_RUNS], sizeof(vals));
+        return mean_median(vals, NUM_RUNS);
+}
+
+/*
+ * Returns latency percentile of a test variant for given size.
+ * Percentiles are averaged over runs as the times are,
+ * except the maximum latency which is the maximum of all runs.
+ */
+static uint64_t get_latency(const struct variant_s *variant, const uint32_t sz,
+                            const unsigned stat)
+{
+        const struct latency_s *lat = &variant->latencies[sz * NUM_RUNS];
+        uint64_t vals[NUM_RUNS];
+        uint64_t val = 0;
+        uint32_t run;
+
+        for (run = 0; run < NUM_RUNS; run++)
+                vals[run] = get_latency_stat(&lat[run], stat);
+
+        if (stat != LAT_MAX)
+                return mean_median(vals, NUM_RUNS);
+
+        for (run = 0; run < NUM_RUNS; run++)
+                if (vals[run] > val)
+                        val = vals[run];
+        return val;
+}
+
+/*
+ * Generates output containing per-job latency percentiles for each
+ * test variant
+ */
+static void print_latencies(struct variant_s *variant_list,
+                            struct params_s *params,
+                            const uint32_t total_variants)
+{
+        const uint32_t sizes = params->num_sizes;
+        const char *stat_names[NUM_LAT_STATS] = {
+                "P50", "P99", "P99.9", "MAX"
+        };
+        unsigned stat;
+        uint32_t col;
+        uint32_t sz;
+
+        for (stat = 0; stat < DIM(stat_names); stat++) {
+                printf("\nLATENCY %s (cycles)\n", stat_names[stat]);
+                print_variant_header(variant_list, total_variants);
+                for (sz = 0; sz < sizes; sz++) {
+                        printf("%d", job_sizes[sz]);
+                        for (col = 0; col < total_variants; col++) {
+                                const unsigned long long val =
+                                        get_latency(&variant_list[col], sz,
+                                                    stat);
+
+                                printf("\t%llu", val);
+                        }
+                        printf("\n");
+                }
+        }
+}
+
+/*
+ * Generates output comparing times of jobs with sizes following
+ * the distribution and jobs of fixed (mean) size. Difference comes
+ * mostly from lanes of different lengths processed in parallel.
+ */
+static void print_size_dist(struct variant_s *variant_list,
+                            const uint32_t total_variants)
+{
+        uint32_t col;
+
+        printf("\nSIZE DISTRIBUTION %s (mean size %u)\n", size_dist->fname,
+               size_dist->mean);
+        print_variant_header(variant_list, total_variants);
+        printf("DIST");
+        for (col = 0; col < total_variants; col++)
+                printf("\t%llu", (unsigned long long)
+                       get_dist_time(&variant_list[col], 0));
+        printf("\nFIXED");
+        for (col = 0; col < total_variants; col++)
+                printf("\t%llu", (unsigned long long)
+                       get_dist_time(&variant_list[col], 1));
+        printf("\nIMBALANCE");
+        for (col = 0; col < total_variants; col++) {
+                const double dist = (double)
+                        get_dist_time(&variant_list[col], 0);
+                const double fixed = (double)
+                        get_dist_time(&variant_list[col], 1);
+
+                printf("\t%+.1f%%", (fixed != 0.0) ?
+                       (100.0 * (dist - fixed) / fixed) : 0.0);
+        }
+        printf("\n");
+}
+
+/*
+ * Computes performance counter metric of a test variant for given size
+ * (counters are summed over all runs).
+ * Returns 0 if the metric is not available.
+ */
+static int get_perf_metric(const struct variant_s *variant, const uint32_t sz,
+                           const struct perf_metric_s *metric, double *value)
+{
+        const struct perf_sample_s *sample = &variant->counters[sz * NUM_RUNS];
+        uint64_t cnt = 0, den = 0;
+        uint32_t run;
+
+        if (perf_cnt.fd[metric->cnt] < 0 ||
+            (metric->den != PERF_PER_JOB && perf_cnt.fd[metric->den] < 0))
+                return 0;
+
+        for (run = 0; run < NUM_RUNS; run++) {
+                cnt += sample[run].values[metric->cnt];
+                if (metric->den == PERF_PER_JOB)
+                        den += sample[run].jobs;
+                else
+                        den += sample[run].values[metric->den];
+        }
+        *value = (den != 0) ? ((double) cnt * metric->scale / den) : 0.0;
+        return 1;
+}
+
+/*
+ * Generates output containing performance counter metrics for each
+ * test variant (one section per available metric)
+ */
+static void print_perf_counters(struct variant_s *variant_list,
+                                struct params_s *params,
+                                const uint32_t total_variants)
+{
+        const uint32_t sizes = params->num_sizes;
+        unsigned m;
+        uint32_t col;
+        uint32_t sz;
+        double val;
+
+        for (m = 0; m < DIM(perf_metrics); m++) {
+                if (!get_perf_metric(&variant_list[0], 0, &perf_metrics[m],
+                                     &val))
+                        continue;
+                printf("\nCOUNTERS %s\n", perf_metrics[m].name);
+                print_variant_header(variant_list, total_variants);
+                for (sz = 0; sz < sizes; sz++) {
+                        printf("%d", job_sizes[sz]);
+                        for (col = 0; col < total_variants; col++) {
+                                get_perf_metric(&variant_list[col], sz,
+                                                &perf_metrics[m], &val);
+                                printf("\t%.3f", val);
+                        }
+                        printf("\n");
+                }
+        }
+}
+
+/* Gets CPU brand string (e.g. for output metadata) */
+static void get_cpu_model(char *model, const size_t model_size)
+{
+        uint32_t regs[12];
+        char *p;
+        unsigned i;
+
+#ifdef _WIN32
+        int max_ext[4];
+
+        __cpuid(max_ext, 0x80000000);
+        if ((unsigned) max_ext[0] < 0x80000004) {
+                snprintf(model, model_size, "unknown");
+                return;
+        }
+        for (i = 0; i < 3; i++)
+                __cpuid((int *) &regs[i * 4], 0x80000002 + i);
+#else
+        if (__get_cpuid_max(0x80000000, NULL) < 0x80000004) {
+                snprintf(model, model_size, "unknown");
+                return;
+        }
+        for (i = 0; i < 3; i++)
+                __get_cpuid(0x80000002 + i, &regs[i * 4], &regs[i * 4 + 1],
+                            &regs[i * 4 + 2], &regs[i * 4 + 3]);
+#endif
+        p = (char *) regs;
+        p[sizeof(regs) - 1] = '\0';
+        while (*p == ' ')
+                p++;
+        snprintf(model, model_size, "%s", p);
+}
+
+/* Prints string as a quoted JSON string, escaping special characters */
+static void print_json_string(const char *str)
+{
+        const unsigned char *p = (const unsigned char *) str;
+
+        putchar('"');
+        for (; *p != '\0'; p++) {
+                switch (*p) {
+                case '"':
+                        printf("\\\"");
+                        break;
+                case '\\':
+                        printf("\\\\");
+                        break;
+                case '\n':
+                        printf("\\n");
+                        break;
+                case '\r':
+                        printf("\\r");
+                        break;
+                case '\t':
+                        printf("\\t");
+                        break;
+                default:
+                        if (*p < 0x20)
+                                printf("\\u%04x", *p);
+                        else
+                                putchar(*p);
+                        break;
+                }
+        }
+        putchar('"');
+}
+
+/* Generates JSON output with test variant metadata and all run times */
+static void print_times_json(struct variant_s *variant_list,
+                             struct params_s *params,
+                             const uint32_t total_variants)
+{
+        const uint32_t sizes = params->num_sizes;
+        const char *lat_names[NUM_LAT_STATS] = {
+                "p50", "p99", "p99_9", "max"
+        };
+        char cpu_model[64];
+        uint32_t col, sz, run;
+        unsigned stat, m;
+
+        get_cpu_model(cpu_model, sizeof(cpu_model));
+
+        printf("{\n");
+        printf("  \"library_version\": \"%s\",\n", imb_get_version_str());
+        printf("  \"cpu_model\": ");
+        print_json_string(cpu_model);
+        printf(",\n");
+        printf("  \"cache\": \"%s\",\n",
+               (cache_type == COLD) ? "cold" : "warm");
+        printf("  \"numa_node\": %d,\n", numa_node);
+        printf("  \"hugepages\": %s,\n", use_hugepages ? "true" : "false");
+        printf("  \"sessions\": %u,\n", num_sessions);
+        printf("  \"counter\": \"%s\",\n",
+               use_unhalted_cycles ? "unhalted_cycles" : "tsc");
+        printf("  \"sha_size_incr\": %u,\n", sha_size_incr);
+        printf("  \"num_runs\": %u,\n", NUM_RUNS);
+        printf("  \"variants\": [\n");
+        for (col = 0; col < total_variants; col++) {
+                const struct variant_s *v = &variant_list[col];
+                const struct params_s *par = &v->params;
+
+                printf("    {\n");
+                printf("      \"arch\": \"%s\",\n", arch_names[v->arch]);
+                printf("      \"cipher\": \"%s\",\n",
+                       c_mode_names[par->cipher_mode - CBC]);
+                printf("      \"dir\": \"%s\",\n",
+                       c_dir_names[par->cipher_dir - ENCRYPT]);
+                printf("      \"hash\": \"%s\",\n",
+                       h_alg_names[par->hash_alg - SHA1]);
+                printf("      \"key_size\": %u,\n", par->aes_key_size * 8);
+                printf("      \"aad_size\": %u,\n",
+                       (unsigned) par->aad_size);
+                if (core_mask)
+                        printf("      \"core\": %u,\n", par->core);
+                else
+                        printf("      \"core\": null,\n");
+                printf("      \"results\": [\n");
+                for (sz = 0; sz < sizes; sz++) {
+                        const uint64_t *times = &v->avg_times[sz * NUM_RUNS];
+
+                        printf("        {\"size\": %u, \"cycles\": %llu, "
+                               "\"runs\": [",
+                               job_sizes[sz],
+                               (unsigned long long) get_avg_time(v, sz));
+                        for (run = 0; run < NUM_RUNS; run++)
+                                printf("%s%llu", run ? ", " : "",
+                                       (unsigned long long) times[run]);
+                        printf("]");
+                        if (v->latencies != NULL) {
+                                printf(", \"latency\": {");
+                                for (stat = 0; stat < DIM(lat_names); stat++)
+                                        printf("%s\"%s\": %llu",
+                                               stat ? ", " : "",
+                                               lat_names[stat],
+                                               (unsigned long long)
+                                               get_latency(v, sz, stat));
+                                printf("}");
+                        }
+                        if (v->counters != NULL) {
+                                const char *sep = "";
+                                double val;
+
+                                printf(", \"counters\": {");
+                                for (m = 0; m < DIM(perf_metrics); m++) {
+                                        if (!get_perf_metric(v, sz,
+                                                             &perf_metrics[m],
+                                                             &val))
+                                                continue;
+                                        printf("%s\"%s\": %.4f", sep,
+                                               perf_metrics[m].key, val);
+                                        sep = ", ";
+                                }
+                                printf("}");
+                        }
+                        printf("}%s\n", (sz + 1 < sizes) ? "," : "");
+                }
+                printf("      ]%s\n", (v->dist_times != NULL) ? "," : "");
+                if (v->dist_times != NULL) {
+                        printf("      \"size_distribution\": {\"file\": ");
+                        print_json_string(size_dist->fname);
+                        printf(", \"mean_size\": %u, "
+                               "\"cycles\": %llu, \"fixed_cycles\": %llu}\n",
+                               size_dist->mean,
+                               (unsigned long long) get_dist_time(v, 0),
+                               (unsigned long long) get_dist_time(v, 1));
+                }
+                printf("    }%s\n", (col + 1 < total_variants) ? "," : "");
+        }
+        printf("  ]\n");
+        printf("}\n");
+}
+
+/* Generates CSV output, one line per test variant and buffer size */
+static void print_times_csv(struct variant_s *variant_list,
+                            struct params_s *params,
+                            const uint32_t total_variants)
+{
+        const uint32_t sizes = params->num_sizes;
+        char cpu_model[64];
+        uint32_t col, sz;
+        unsigned stat, m;
+        double val;
+
+        get_cpu_model(cpu_model, sizeof(cpu_model));
+
+        printf("arch,cipher,dir,hash,key_size,aad_size,cache,core,"
+               "cpu_model,library_version,size,cycles");
+        if (use_latency)
+                printf(",lat_p50,lat_p99,lat_p99_9,lat_max");
+        if (variant_list[0].counters != NULL)
+                for (m = 0; m < DIM(perf_metrics); m++)
+                        if (get_perf_metric(&variant_list[0], 0,
+                                            &perf_metrics[m], &val))
+                                printf(",%s", perf_metrics[m].key);
+        if (size_dist != NULL)
+                printf(",dist_mean_size,dist_cycles,dist_fixed_cycles");
+        printf("\n");
+
+        for (col = 0; col < total_variants; col++) {
+                const struct variant_s *v = &variant_list[col];
+                const struct params_s *par = &v->params;
+
+                for (sz = 0; sz < sizes; sz++) {
+                        printf("%s,%s,%s,%s,%u,%u,%s,",
+                               arch_names[v->arch],
+                               c_mode_names[par->cipher_mode - CBC],
+                               c_dir_names[par->cipher_dir - ENCRYPT],
+                               h_alg_names[par->hash_alg - SHA1],
+                               par->aes_key_size * 8,
+                               (unsigned) par->aad_size,
+                               (cache_type == COLD) ? "cold" : "warm");
+                        if (core_mask)
+                                printf("%u", par->core);
+                        printf(",\"%s\",%s,%u,%llu", cpu_model,
+                               imb_get_version_str(),
+                               job_sizes[sz],
+                               (unsigned long long) get_avg_time(v, sz));
+                        if (v->latencies != NULL)
+                                for (stat = 0; stat < NUM_LAT_STATS; stat++)
+                                        printf(",%llu", (unsigned long long)
+                                               get_latency(v, sz, stat));
+                        if (v->counters != NULL)
+                                for (m = 0; m < DIM(perf_metrics); m++)
+                                        if (get_perf_metric(v, sz,
+                                                            &perf_metrics[m],
+                                                            &val))
+                                                printf(",%.4f", val);
+                        if (v->dist_times != NULL)
+                                printf(",%u,%llu,%llu", size_dist->mean,
+                                       (unsigned long long)
+                                       get_dist_time(v, 0),
+                                       (unsigned long long)
+                                       get_dist_time(v, 1));
+                        printf("\n");
+                }
+        }
+}
+
+/* Returns wall-clock time in nanoseconds */
+static uint64_t get_wall_time_ns(void)
+{
+#ifdef _WIN32
+        LARGE_INTEGER count, freq;
+
+        QueryPerformanceCounter(&count);
+        QueryPerformanceFrequency(&freq);
+        return (uint64_t) ((double) count.QuadPart * 1e9 /
+                           (double) freq.QuadPart);
+#else
+        struct timespec ts;
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+#endif
+}
+
+/* Starts a worker thread (used by scaling and victim tests) */
+static int create_thread(thread_t *thread, thread_func_t func, void *arg)
+{
+#ifdef _WIN32
+        *thread = (HANDLE) _beginthread(func, 0, arg);
+        return (*thread == (HANDLE) -1L) ? -1 : 0;
+#else
+        return pthread_create(thread, NULL, func, arg);
+#endif
+}
+
+/* Waits for worker threads to finish */
+static void join_threads(thread_t *threads, const uint32_t num)
+{
+        uint32_t t;
+
+#ifdef _WIN32
+        WaitForMultipleObjects(num, threads, TRUE, INFINITE);
+#endif
+        for (t = 0; t < num; t++) {
+#ifdef _WIN32
+                CloseHandle(threads[t]);
+#else
+                pthread_join(threads[t], NULL);
+#endif
+        }
+}
+
+/*
+ * Sets parameters of the job used by scaling and victim tests
+ * (custom test algorithms) and returns the job size
+ */
+static uint32_t init_worker_params(struct params_s *params)
+{
+        uint32_t size;
+
+        memset(params, 0, sizeof(*params));
+        params->cipher_mode = custom_job_params.cipher_mode;
+        params->hash_alg = custom_job_params.hash_alg;
+        params->aes_key_size = custom_job_params.aes_key_size;
+        params->cipher_dir = custom_job_params.cipher_dir;
+        if (params->cipher_mode == TEST_GCM)
+                params->aad_size = gcm_aad_size;
+        if (params->cipher_mode == TEST_CCM)
+                params->aad_size = ccm_aad_size;
+
+        size = (num_job_sizes == 0) ? WORKER_JOB_SIZE : job_sizes[0];
+        size = align_job_size(params->cipher_mode, size);
+        params->size_aes = size;
+
+        return size;
+}
+
+/*
+ * Job worker: waits for all other workers to be ready,
+ * then submits jobs using own manager and own range of buffers.
+ * If num_iter is 0 then it submits jobs until worker_stop is set.
+ */
+#ifdef _WIN32
+static void
+#else
+static void *
+#endif
+job_worker(void *arg)
+{
+        struct worker_info *info = (struct worker_info *)arg;
+        MB_MGR *mb_mgr = info->p_mgr;
+        const uint32_t last_index = info->first_index + info->num_indexes;
+        uint32_t index = info->first_index;
+        uint64_t time, i;
+        uint32_t aux;
+        JOB_AES_HMAC *job;
+        JOB_AES_HMAC job_template;
+        struct job_data_s *data;
+
+        if (info->core >= 0 && set_affinity(info->core) != 0) {
+                fprintf(stderr, "Failed to set cpu affinity on core %d\n",
+                        info->core);
+                free_mem();
+                exit(EXIT_FAILURE);
+        }
+
+        /*
+         * Template buffers are private to the worker, so that they don't
+         * bounce between cores. They are allocated (and first touched)
+         * after pinning, i.e. on the NUMA node of the worker core.
+         */
+#ifdef LINUX
+        data = (struct job_data_s *) memalign(512, sizeof(*data));
+#else
+        data = (struct job_data_s *) _aligned_malloc(sizeof(*data), 512);
+#endif
+        if (data == NULL) {
+                fprintf(stderr, "Could not malloc job template data\n");
+                free_mem();
+                exit(EXIT_FAILURE);
+        }
+        memset(data, 0, sizeof(*data));
+        memset(&job_template, 0, sizeof(job_template));
+        init_job_template(mb_mgr, info->params, &job_template, data);
+
+        info->ready = 1;
+        while (worker_start == 0)
+                _mm_pause();
+
+        time = __rdtscp(&aux);
+
+        for (i = 0; (info->num_iter != 0) ? (i < info->num_iter) :
+                     (worker_stop == 0); i++) {
+                job = IMB_GET_NEXT_JOB(mb_mgr);
+                *job = job_template;
+                set_job_data(job, index);
+
+                index += 2;
+                if (index >= last_index)
+                        index = info->first_index;
+
+#ifdef DEBUG
+                job = IMB_SUBMIT_JOB(mb_mgr);
+#else
+                job = IMB_SUBMIT_JOB_NOCHECK(mb_mgr);
+#endif
+                while (job) {
+#ifdef DEBUG
+                        if (job->status != STS_COMPLETED)
+                                fprintf(stderr, "failed job, status:%d\n",
+                                        job->status);
+#endif
+                        job = IMB_GET_COMPLETED_JOB(mb_mgr);
+                }
+        }
+
+        while ((job = IMB_FLUSH_JOB(mb_mgr))) {
+#ifdef DEBUG
+                if (job->status != STS_COMPLETED)
+                        fprintf(stderr, "failed job, status:%d\n", job->status);
+#endif
+        }
+
+        info->cycles = __rdtscp(&aux) - time;
+        info->end_time = get_wall_time_ns();
+        info->jobs = i;
+
+#ifdef LINUX
+        free(data);
+#else
+        _aligned_free(data);
+#endif
+#ifndef _WIN32
+        return NULL;
+#endif
+}
+
+/*
+ * Runs the same job on 1 to scaling_cores cores at the same time
+ * (one manager per core) and reports aggregate throughput measured
+ * with wall-clock time, cycles per byte and scaling efficiency
+ */
+static int run_scaling(void)
+{
+        struct worker_info *info;
+        thread_t *threads;
+        struct params_s params;
+        uint32_t arch, n, t;
+        uint32_t size, num_iter;
+        int ret = 0;
+
+        info = (struct worker_info *) calloc(scaling_cores, sizeof(*info));
+        threads = (thread_t *) calloc(scaling_cores, sizeof(*threads));
+        if (info == NULL || threads == NULL) {
+                fprintf(stderr, "Cannot allocate memory\n");
+                ret = -1;
+                goto exit;
+        }
+
+        size = init_worker_params(&params);
+        if (size == 0) {
+                fprintf(stderr, "Scaling test requires non-zero job size\n");
+                ret = -1;
+                goto exit;
+        }
+        /* same amount of work as all runs of one buffer size */
+        if (job_iter != 0)
+                num_iter = job_iter;
+        else
+                num_iter = ((iter_scale >= size) ?
+                            (iter_scale / size) : 1) * NUM_RUNS;
+
+        for (t = 0; t < scaling_cores; t++) {
+                info[t].p_mgr = alloc_mb_mgr(flags);
+                if (info[t].p_mgr == NULL) {
+                        fprintf(stderr, "Failed to allocate MB_MGR "
+                                "structure for core %u!\n", (unsigned) t);
+                        ret = -1;
+                        goto exit;
+                }
+        }
+
+        if (core_mask == 0)
+                fprintf(stderr, "No core mask given, "
+                        "threads are not pinned to cores\n");
+
+        if (output_format == OUTPUT_CSV)
+                printf("arch,cipher,dir,hash,key_size,size,cache,cores,"
+                       "gbps,gbps_per_core,cycles_per_byte,efficiency\n");
+
+        for (arch = 0; arch < NUM_ARCHS; arch++) {
+                double gbps_single = 0.0;
+
+                if (archs[arch] == 0)
+                        continue;
+
+                for (t = 0; t < scaling_cores; t++)
+                        init_mgr_arch(info[t].p_mgr, arch);
+
+                if (output_format == OUTPUT_TEXT) {
+                        printf("SCALING\tARCH\t%s\tCIPHER\t%s\tDIR\t%s\t"
+                               "HASH\t%s\tKEY_SIZE\tAES-%u\tSIZE\t%u\n",
+                               arch_names[arch],
+                               c_mode_names[params.cipher_mode - CBC],
+                               c_dir_names[params.cipher_dir - ENCRYPT],
+                               h_alg_names[params.hash_alg - SHA1],
+                               params.aes_key_size * 8, size);
+                        printf("CORES\tGBPS\tGBPS/CORE\tCYCLES/BYTE\t"
+                               "EFFICIENCY\n");
+                }
+
+                for (n = 1; n <= scaling_cores; n++) {
+                        /* warm cache: few buffers per core, cold: spread */
+                        const uint32_t num_indexes = (cache_type == WARM) ?
+                                index_limit : ((index_limit / n) & ~1);
+                        uint64_t start_time, end_time = 0;
+                        uint64_t cycles = 0;
+                        int core = 0;
+                        double gbps, cycles_per_byte;
+
+                        fprintf(stderr, "Running on %u core(s)\n", n);
+                        worker_start = 0;
+                        for (t = 0; t < n; t++) {
+                                info[t].core = -1;
+                                if (core_mask) {
+                                        core = next_core(core_mask, core);
+                                        info[t].core = core++;
+                                }
+                                info[t].first_index = t * num_indexes;
+                                info[t].num_indexes = num_indexes;
+                                info[t].num_iter = num_iter;
+                                info[t].params = &params;
+                                info[t].ready = 0;
+                                if (create_thread(&threads[t], job_worker,
+                                                  (void *)&info[t]) != 0) {
+                                        fprintf(stderr, "Failed to create "
+                                                "thread!\n");
+                                        free_mem();
+                                        exit(EXIT_FAILURE);
+                                }
+                        }
+
+                        /* release all workers at once */
+                        for (t = 0; t < n; t++)
+                                while (info[t].ready == 0)
+                                        _mm_pause();
+                        start_time = get_wall_time_ns();
+                        worker_start = 1;
+
+                        join_threads(threads, n);
+                        for (t = 0; t < n; t++) {
+                                if (info[t].end_time > end_time)
+                                        end_time = info[t].end_time;
+                                cycles += info[t].cycles;
+                        }
+
+                        /* bits per nanosecond is Gbps */
+                        gbps = (double) n * num_iter * size * 8 /
+                                (double) (end_time - start_time);
+                        cycles_per_byte = (double) cycles /
+                                ((double) n * num_iter * size);
+                        if (n == 1)
+                                gbps_single = gbps;
+
+                        if (output_format == OUTPUT_CSV)
+                                printf("%s,%s,%s,%s,%u,%u,%s,%u,%.3f,%.3f,"
+                                       "%.3f,%.3f\n", arch_names[arch],
+                                       c_mode_names[params.cipher_mode - CBC],
+                                       c_dir_names[params.cipher_dir -
+                                                   ENCRYPT],
+                                       h_alg_names[params.hash_alg - SHA1],
+                                       params.aes_key_size * 8, size,
+                                       (cache_type == COLD) ? "cold" : "warm",
+                                       n, gbps, gbps / n, cycles_per_byte,
+                                       gbps / (n * gbps_single));
+                        else
+                                printf("%u\t%.3f\t%.3f\t%.3f\t%.1f%%\n",
+                                       n, gbps, gbps / n, cycles_per_byte,
+                                       100.0 * gbps / (n * gbps_single));
+                }
+                if (output_format == OUTPUT_TEXT)
+                        printf("\n");
+        }
+
+exit:
+        if (info != NULL)
+                for (t = 0; t < scaling_cores; t++)
+                        free_mb_mgr(info[t].p_mgr);
+        free(info);
+        free(threads);
+        return ret;
+}
+
+/*
+ * Fixed scalar workload of the victim test: dependent chain of
+ * integer operations, its speed only depends on core frequency
+ */
+static uint64_t victim_workload(const uint64_t num_iter)
+{
+        uint64_t x = 0x9E3779B97F4A7C15ULL;
+        uint64_t i;
+
+        for (i = 0; i < num_iter; i++) {
+                x ^= x << 13;
+                x ^= x >> 7;
+                x ^= x << 17;
+                x *= 0x2545F4914F6CDD1DULL;
+        }
+        return x;
+}
+
+/* Victim test worker: runs scalar workload once released */
+#ifdef _WIN32
+static void
+#else
+static void *
+#endif
+victim_worker(void *arg)
+{
+        struct victim_info *info = (struct victim_info *)arg;
+        uint64_t time;
+
+        if (set_affinity(info->core) != 0) {
+                fprintf(stderr, "Failed to set cpu affinity on core %d\n",
+                        info->core);
+                free_mem();
+                exit(EXIT_FAILURE);
+        }
+
+        info->ready = 1;
+        while (worker_start == 0)
+                _mm_pause();
+
+        time = get_wall_time_ns();
+        info->result = victim_workload(info->num_iter);
+        info->time = get_wall_time_ns() - time;
+#ifndef _WIN32
+        return NULL;
+#endif
+}
+
+/*
+ * Checks if two logical cores are hardware threads of the same
+ * physical core. Returns -1 if it can't be checked.
+ */
+static int is_smt_sibling(const int core_a, const int core_b)
+{
+#ifdef _WIN32
+        (void) core_a;
+        (void) core_b;
+        return -1;
+#else
+        char fname[128];
+        FILE *f;
+        int first, last, ret = 0;
+        char sep;
+
+        snprintf(fname, sizeof(fname), "/sys/devices/system/cpu/cpu%d/"
+                 "topology/thread_siblings_list", core_a);
+        f = fopen(fname, "r");
+        if (f == NULL)
+                return -1;
+
+        /* list format: 2,58 or 2-3 */
+        while (fscanf(f, "%d", &first) == 1) {
+                last = first;
+                sep = (char) fgetc(f);
+                if (sep == '-') {
+                        if (fscanf(f, "%d", &last) != 1)
+                                break;
+                        sep = (char) fgetc(f);
+                }
+                if (core_b >= first && core_b <= last)
+                        ret = 1;
+                if (sep != ',')
+                        break;
+        }
+        fclose(f);
+        return ret;
+#endif
+}
+
+/*
+ * Runs victim workload on selected cores, optionally together with
+ * crypto job worker. Returns crypto throughput in Gbps (0 if no crypto).
+ */
+static double
+run_victims(struct victim_info *victims, thread_t *threads,
+            const uint32_t num_victims, struct worker_info *crypto,
+            const uint32_t size)
+{
+        thread_t crypto_thread;
+        uint64_t start_time;
+        uint32_t v;
+
+        worker_start = 0;
+        worker_stop = 0;
+        if (crypto != NULL) {
+                crypto->ready = 0;
+                if (create_thread(&crypto_thread, job_worker,
+                                  (void *)crypto) != 0) {
+                        fprintf(stderr, "Failed to create thread!\n");
+                        free_mem();
+                        exit(EXIT_FAILURE);
+                }
+        }
+        for (v = 0; v < num_victims; v++) {
+                victims[v].ready = 0;
+                if (create_thread(&threads[v], victim_worker,
+                                  (void *)&victims[v]) != 0) {
+                        fprintf(stderr, "Failed to create thread!\n");
+                        free_mem();
+                        exit(EXIT_FAILURE);
+                }
+        }
+
+        for (v = 0; v < num_victims; v++)
+                while (victims[v].ready == 0)
+                        _mm_pause();
+        if (crypto != NULL)
+                while (crypto->ready == 0)
+                        _mm_pause();
+        start_time = get_wall_time_ns();
+        worker_start = 1;
+
+        /* crypto runs for as long as victims do */
+        join_threads(threads, num_victims);
+        if (crypto == NULL)
+                return 0.0;
+
+        worker_stop = 1;
+        join_threads(&crypto_thread, 1);
+
+        return (double) crypto->jobs * size * 8 /
+                (double) (crypto->end_time - start_time);
+}
+
+/*
+ * Measures how crypto running with each selected architecture
+ * slows down a scalar workload running on other cores
+ * (e.g. by frequency license of AVX512 instructions):
+ * crypto runs on the first core of core_mask,
+ * victim workload on each core of victim_mask.
+ */
+static int run_victim_test(void)
+{
+        struct victim_info victims[MAX_VICTIM_CORES];
+        thread_t threads[MAX_VICTIM_CORES];
+        int smt[MAX_VICTIM_CORES];
+        struct worker_info crypto;
+        struct params_s params;
+        const uint32_t num_victims = bitcount(victim_mask);
+        const int crypto_core = next_core(core_mask, 0);
+        uint32_t arch, v, size, num_iter;
+        int core = 0;
+
+        size = init_worker_params(&params);
+        if (size == 0) {
+                fprintf(stderr, "Victim test requires non-zero job size\n");
+                return -1;
+        }
+        /* same amount of work as all runs of one buffer size */
+        if (job_iter != 0)
+                num_iter = job_iter;
+        else
+                num_iter = ((iter_scale >= size) ?
+                            (iter_scale / size) : 1) * NUM_RUNS;
+
+        memset(victims, 0, sizeof(victims));
+        for (v = 0; v < num_victims; v++) {
+                core = next_core(victim_mask, core);
+                victims[v].core = core++;
+                victims[v].num_iter = (uint64_t) iter_scale *
+                        VICTIM_ITER_SCALE;
+                smt[v] = is_smt_sibling(crypto_core, victims[v].core);
+        }
+
+        memset(&crypto, 0, sizeof(crypto));
+        crypto.p_mgr = alloc_mb_mgr(flags);
+        if (crypto.p_mgr == NULL) {
+                fprintf(stderr, "Error allocating MB_MGR structure!\n");
+                return -1;
+        }
+        crypto.core = crypto_core;
+        crypto.first_index = 0;
+        crypto.num_indexes = index_limit;
+        crypto.params = &params;
+
+        if (output_format == OUTPUT_CSV) {
+                printf("arch,cipher,dir,hash,key_size,size,crypto_core,"
+                       "victim_core,smt_sibling,gbps,gbps_with_victims,"
+                       "victim_base_ms,victim_ms,victim_slowdown_pct\n");
+        } else {
+                printf("VICTIM TEST\tCIPHER\t%s\tDIR\t%s\tHASH\t%s\t"
+                       "KEY_SIZE\tAES-%u\tSIZE\t%u\tCRYPTO CORE\t%d\n",
+                       c_mode_names[params.cipher_mode - CBC],
+                       c_dir_names[params.cipher_dir - ENCRYPT],
+                       h_alg_names[params.hash_alg - SHA1],
+                       params.aes_key_size * 8, size, crypto_core);
+                printf("ARCH\tGBPS\tGBPS_WITH_VICTIMS");
+                for (v = 0; v < num_victims; v++)
+                        printf("\tSLOWDOWN_CORE_%d%s", victims[v].core,
+                               (smt[v] == 1) ? "_SMT" : "");
+                printf("\n");
+        }
+
+        for (arch = 0; arch < NUM_ARCHS; arch++) {
+                uint64_t base_time[MAX_VICTIM_CORES];
+                double gbps, gbps_shared;
+
+                if (archs[arch] == 0)
+                        continue;
+
+                init_mgr_arch(crypto.p_mgr, arch);
+
+                fprintf(stderr, "Running victim test for %s\n",
+                        arch_names[arch]);
+
+                /* victims alone (baseline) */
+                run_victims(victims, threads, num_victims, NULL, size);
+                for (v = 0; v < num_victims; v++)
+                        base_time[v] = victims[v].time;
+
+                /* crypto alone */
+                crypto.num_iter = num_iter;
+                gbps = run_victims(victims, threads, 0, &crypto, size);
+
+                /* crypto together with victims, for the time they run */
+                crypto.num_iter = 0;
+                gbps_shared = run_victims(victims, threads, num_victims,
+                                          &crypto, size);
+
+                if (output_format != OUTPUT_CSV)
+                        printf("%s\t%.3f\t%.3f", arch_names[arch], gbps,
+                               gbps_shared);
+                for (v = 0; v < num_victims; v++) {
+                        const double slowdown = 100.0 *
+                                ((double) victims[v].time -
+                                 (double) base_time[v]) /
+                                (double) base_time[v];
+
+                        if (output_format != OUTPUT_CSV) {
+                                printf("\t%+.2f%%", slowdown);
+                                continue;
+                        }
+                        printf("%s,%s,%s,%s,%u,%u,%d,%d,%s,%.3f,%.3f,%.3f,"
+                               "%.3f,%.3f\n", arch_names[arch],
+                               c_mode_names[params.cipher_mode - CBC],
+                               c_dir_names[params.cipher_dir - ENCRYPT],
+                               h_alg_names[params.hash_alg - SHA1],
+                               params.aes_key_size * 8, size, crypto_core,
+                               victims[v].core,
+                               (smt[v] < 0) ? "" : (smt[v] ? "1" : "0"),
+                               gbps, gbps_shared,
+                               (double) base_time[v] / 1e6,
+                               (double) victims[v].time / 1e6, slowdown);
+                }
+                if (output_format != OUTPUT_CSV)
+                        printf("\n");
+        }
+
+        free_mb_mgr(crypto.p_mgr);
+        return 0;
+}
+
+/* Direct API functions and their job API equivalents */
+enum direct_func_e {
+        DIRECT_KEYEXP_128 = 0,
+        DIRECT_KEYEXP_192,
+        DIRECT_KEYEXP_256,
+        DIRECT_XCBC_KEYEXP,
+        DIRECT_CMAC_SUBKEY_GEN,
+        DIRECT_DES_KEYSCHED,
+        DIRECT_GCM128_PRE,
+        DIRECT_GCM192_PRE,
+        DIRECT_GCM256_PRE,
+        DIRECT_GCM128_PRE_MB,
+        DIRECT_GCM192_PRE_MB,
+        DIRECT_GCM256_PRE_MB,
+        DIRECT_HMAC_SHA1_PADS,
+        DIRECT_HMAC_SHA256_PADS,
+        DIRECT_HMAC_SHA512_PADS,
+        DIRECT_HMAC_MD5_PADS,
+        DIRECT_HMAC_SHA1_PADS_MB,
+        DIRECT_HMAC_SHA256_PADS_MB,
+        DIRECT_HMAC_SHA512_PADS_MB,
+        DIRECT_SHA512_224_ONE_BLOCK,
+        DIRECT_SHA512_256_ONE_BLOCK,
+        DIRECT_SHA1,
+        DIRECT_SHA224,
+        DIRECT_SHA256,
+        DIRECT_SHA384,
+        DIRECT_SHA512,
+        DIRECT_SHA512_224,
+        DIRECT_SHA512_256,
+        DIRECT_CFB_ONE,
+        DIRECT_GCM128_ENC,
+        DIRECT_GCM128_SGL,
+        DIRECT_GCM192_ENC,
+        DIRECT_GCM192_SGL,
+        DIRECT_GCM256_ENC,
+        DIRECT_GCM256_SGL
+};
+
+struct direct_test_s {
+        const char *name;
+        const char *job_name;   /* job API equivalent, NULL if none */
+        enum direct_func_e func;
+        uint32_t size;          /* key or data size, 0: all job sizes */
+};
+
+static const struct direct_test_s direct_tests[] = {
+        {"aes-keyexp-128", NULL, DIRECT_KEYEXP_128, 16},
+        {"aes-keyexp-192", NULL, DIRECT_KEYEXP_192, 24},
+        {"aes-keyexp-256", NULL, DIRECT_KEYEXP_256, 32},
+        {"aes-xcbc-keyexp", NULL, DIRECT_XCBC_KEYEXP, 16},
+        {"aes-cmac-subkey-gen", NULL, DIRECT_CMAC_SUBKEY_GEN, 16},
+        {"des-key-sched", NULL, DIRECT_DES_KEYSCHED, 8},
+        {"aes-gcm-128-pre", NULL, DIRECT_GCM128_PRE, 16},
+        {"aes-gcm-192-pre", NULL, DIRECT_GCM192_PRE, 24},
+        {"aes-gcm-256-pre", NULL, DIRECT_GCM256_PRE, 32},
+        {"aes-gcm-128-pre-mb", NULL, DIRECT_GCM128_PRE_MB, 16},
+        {"aes-gcm-192-pre-mb", NULL, DIRECT_GCM192_PRE_MB, 24},
+        {"aes-gcm-256-pre-mb", NULL, DIRECT_GCM256_PRE_MB, 32},
+        {"sha1-hmac-pads", NULL, DIRECT_HMAC_SHA1_PADS, 20},
+        {"sha256-hmac-pads", NULL, DIRECT_HMAC_SHA256_PADS, 32},
+        {"sha512-hmac-pads", NULL, DIRECT_HMAC_SHA512_PADS, 64},
+        {"md5-hmac-pads", NULL, DIRECT_HMAC_MD5_PADS, 16},
+        {"sha1-hmac-pads-mb", NULL, DIRECT_HMAC_SHA1_PADS_MB, 20},
+        {"sha256-hmac-pads-mb", NULL, DIRECT_HMAC_SHA256_PADS_MB, 32},
+        {"sha512-hmac-pads-mb", NULL, DIRECT_HMAC_SHA512_PADS_MB, 64},
+        {"sha512-224-one-block", NULL, DIRECT_SHA512_224_ONE_BLOCK, 128},
+        {"sha512-256-one-block", NULL, DIRECT_SHA512_256_ONE_BLOCK, 128},
+        {"sha1", "PLAIN_SHA1", DIRECT_SHA1, 0},
+        {"sha224", "PLAIN_SHA_224", DIRECT_SHA224, 0},
+        {"sha256", "PLAIN_SHA_256", DIRECT_SHA256, 0},
+        {"sha384", "PLAIN_SHA_384", DIRECT_SHA384, 0},
+        {"sha512", "PLAIN_SHA_512", DIRECT_SHA512, 0},
+        {"sha512-224", NULL, DIRECT_SHA512_224, 0},
+        {"sha512-256", NULL, DIRECT_SHA512_256, 0},
+        {"aes128-cfb-one", "DOCSIS_SEC_BPI", DIRECT_CFB_ONE, 15},
+        {"aes-gcm-128-enc", "GCM", DIRECT_GCM128_ENC, 0},
+        {"aes-gcm-128-init-update-finalize", "GCM", DIRECT_GCM128_SGL, 0},
+        {"aes-gcm-192-enc", "GCM", DIRECT_GCM192_ENC, 0},
+        {"aes-gcm-192-init-update-finalize", "GCM", DIRECT_GCM192_SGL, 0},
+        {"aes-gcm-256-enc", "GCM", DIRECT_GCM256_ENC, 0},
+        {"aes-gcm-256-init-update-finalize", "GCM", DIRECT_GCM256_SGL, 0}
+};
+
+/* Computes hashed HMAC ipad/opad of the key (one block key) */
+static void
+compute_hmac_pads(MB_MGR *mb_mgr, const JOB_HASH_ALG hash_alg,
+                  const uint8_t *key, const uint32_t key_len,
+                  uint8_t *ipad, uint8_t *opad)
+{
+        const uint32_t block_size = (hash_alg == SHA_512) ? 128 : 64;
+        uint8_t block[128];
+        uint32_t i;
+
+        memset(block, 0x36, block_size);
+        for (i = 0; i < key_len; i++)
+                block[i] ^= key[i];
+        if (hash_alg == SHA1)
+                IMB_SHA1_ONE_BLOCK(mb_mgr, block, ipad);
+        else if (hash_alg == SHA_256)
+                IMB_SHA256_ONE_BLOCK(mb_mgr, block, ipad);
+        else if (hash_alg == SHA_512)
+                IMB_SHA512_ONE_BLOCK(mb_mgr, block, ipad);
+        else
+                IMB_MD5_ONE_BLOCK(mb_mgr, block, ipad);
+
+        memset(block, 0x5c, block_size);
+        for (i = 0; i < key_len; i++)
+                block[i] ^= key[i];
+        if (hash_alg == SHA1)
+                IMB_SHA1_ONE_BLOCK(mb_mgr, block, opad);
+        else if (hash_alg == SHA_256)
+                IMB_SHA256_ONE_BLOCK(mb_mgr, block, opad);
+        else if (hash_alg == SHA_512)
+                IMB_SHA512_ONE_BLOCK(mb_mgr, block, opad);
+        else
+                IMB_MD5_ONE_BLOCK(mb_mgr, block, opad);
+}
+
+/*
+ * Number of keys passed to one call of multi-key setup functions,
+ * their cost is reported per key
+ */
+#define DIRECT_MB_KEYS 16
+
+/* Points keys of a multi-key call to consecutive keys at src */
+static void
+set_direct_mb_keys(const void **keys, const uint8_t *src,
+                   const uint32_t key_len)
+{
+        uint32_t k;
+
+        for (k = 0; k < DIRECT_MB_KEYS; k++)
+                keys[k] = src + k * key_len;
+}
+
+/*
+ * Times num_iter calls of a direct API function, src points to the
+ * buffer (or key) of each call, buffers are used as in do_test()
+ */
+#define TIME_DIRECT_CALL(_call)                                         \
+        do {                                                            \
+                uint32_t i, aux;                                        \
+                                                                        \
+                time = __rdtscp(&aux);                                  \
+                for (i = 0; i < num_iter; i++) {                        \
+                        uint8_t *src = buf + offsets[index];            \
+                                                                        \
+                        _call;                                          \
+                        index += 2;                                     \
+                        if (index >= index_limit)                       \
+                                index = 0;                              \
+                }                                                       \
+                time = __rdtscp(&aux) - time;                           \
+        } while (0)
+
+/* Performs test of a direct API function, returns cycles per call */
+static uint64_t
+do_test_direct(MB_MGR *mb_mgr, const enum direct_func_e func,
+               const uint32_t size, const uint32_t num_iter)
+{
+        static DECLARE_ALIGNED(uint32_t enc_keys[15 * 4], 16);
+        static DECLARE_ALIGNED(uint32_t dec_keys[15 * 4], 16);
+        static DECLARE_ALIGNED(uint8_t k2[16], 16);
+        static DECLARE_ALIGNED(uint8_t k3[16], 16);
+        static DECLARE_ALIGNED(uint64_t des_ks[16], 16);
+        static DECLARE_ALIGNED(uint8_t ipad[64], 16);
+        static DECLARE_ALIGNED(uint8_t opad[64], 16);
+        static DECLARE_ALIGNED(struct gcm_key_data gdata_key, 512);
+        static DECLARE_ALIGNED(struct gcm_context_data gdata_ctx, 64);
+        static DECLARE_ALIGNED(struct gcm_key_data gdata_keys[DIRECT_MB_KEYS],
+                               64);
+        static DECLARE_ALIGNED(uint8_t ipads[DIRECT_MB_KEYS][64], 16);
+        static DECLARE_ALIGNED(uint8_t opads[DIRECT_MB_KEYS][64], 16);
+        static DECLARE_ALIGNED(uint8_t iv[16], 16);
+        static uint8_t aad[AAD_SIZE_MAX];
+        static uint8_t digest[64];
+        static uint32_t index = 0;
+        const JOB_HASH_ALG hmac_mb_alg[] = {SHA1, SHA_256, SHA_512};
+        const void *mb_keys[DIRECT_MB_KEYS];
+        uint64_t mb_key_lens[DIRECT_MB_KEYS];
+        void *mb_ipads[DIRECT_MB_KEYS];
+        void *mb_opads[DIRECT_MB_KEYS];
+        struct gcm_key_data *mb_gdata_keys[DIRECT_MB_KEYS];
+        const uint8_t key[32] = {0};
+        uint32_t num_keys = 1;
+        uint64_t time = 0;
+        uint32_t k;
+
+        for (k = 0; k < DIRECT_MB_KEYS; k++) {
+                mb_key_lens[k] = size;
+                mb_ipads[k] = ipads[k];
+                mb_opads[k] = opads[k];
+                mb_gdata_keys[k] = &gdata_keys[k];
+        }
+
+        switch (func) {
+        case DIRECT_KEYEXP_128:
+                TIME_DIRECT_CALL(IMB_AES_KEYEXP_128(mb_mgr, src, enc_keys,
+                                                    dec_keys));
+                break;
+        case DIRECT_KEYEXP_192:
+                TIME_DIRECT_CALL(IMB_AES_KEYEXP_192(mb_mgr, src, enc_keys,
+                                                    dec_keys));
+                break;
+        case DIRECT_KEYEXP_256:
+                TIME_DIRECT_CALL(IMB_AES_KEYEXP_256(mb_mgr, src, enc_keys,
+                                                    dec_keys));
+                break;
+        case DIRECT_XCBC_KEYEXP:
+                TIME_DIRECT_CALL(IMB_AES_XCBC_KEYEXP(mb_mgr, src, enc_keys,
+                                                     k2, k3));
+                break;
+        case DIRECT_CMAC_SUBKEY_GEN:
+                /*
+                 * Subkey generation only, AES key expansion is
+                 * measured by aes-keyexp-128
+                 */
+                IMB_AES_KEYEXP_128(mb_mgr, key, enc_keys, dec_keys);
+                TIME_DIRECT_CALL((void) src;
+                                 IMB_AES_CMAC_SUBKEY_GEN_128(mb_mgr, enc_keys,
+                                                             k2, k3));
+                break;
+        case DIRECT_DES_KEYSCHED:
+                TIME_DIRECT_CALL(IMB_DES_KEYSCHED(mb_mgr, des_ks, src));
+                break;
+        case DIRECT_GCM128_PRE:
+                TIME_DIRECT_CALL(IMB_AES128_GCM_PRE(mb_mgr, src,
+                                                    &gdata_key));
+                break;
+        case DIRECT_GCM192_PRE:
+                TIME_DIRECT_CALL(IMB_AES192_GCM_PRE(mb_mgr, src,
+                                                    &gdata_key));
+                break;
+        case DIRECT_GCM256_PRE:
+                TIME_DIRECT_CALL(IMB_AES256_GCM_PRE(mb_mgr, src,
+                                                    &gdata_key));
+                break;
+        case DIRECT_GCM128_PRE_MB:
+                TIME_DIRECT_CALL(set_direct_mb_keys(mb_keys, src, size);
+                                 IMB_AES128_GCM_PRE_MB(mb_mgr, mb_keys,
+                                                       mb_gdata_keys,
+                                                       DIRECT_MB_KEYS));
+                num_keys = DIRECT_MB_KEYS;
+                break;
+        case DIRECT_GCM192_PRE_MB:
+                TIME_DIRECT_CALL(set_direct_mb_keys(mb_keys, src, size);
+                                 IMB_AES192_GCM_PRE_MB(mb_mgr, mb_keys,
+                                                       mb_gdata_keys,
+                                                       DIRECT_MB_KEYS));
+                num_keys = DIRECT_MB_KEYS;
+                break;
+        case DIRECT_GCM256_PRE_MB:
+                TIME_DIRECT_CALL(set_direct_mb_keys(mb_keys, src, size);
+                                 IMB_AES256_GCM_PRE_MB(mb_mgr, mb_keys,
+                                                       mb_gdata_keys,
+                                                       DIRECT_MB_KEYS));
+                num_keys = DIRECT_MB_KEYS;
+                break;
+        case DIRECT_HMAC_SHA1_PADS:
+                TIME_DIRECT_CALL(compute_hmac_pads(mb_mgr, SHA1, src, size,
+                                                   ipad, opad));
+                break;
+        case DIRECT_HMAC_SHA256_PADS:
+                TIME_DIRECT_CALL(compute_hmac_pads(mb_mgr, SHA_256, src,
+                                                   size, ipad, opad));
+                break;
+        case DIRECT_HMAC_SHA512_PADS:
+                TIME_DIRECT_CALL(compute_hmac_pads(mb_mgr, SHA_512, src,
+                                                   size, ipad, opad));
+                break;
+        case DIRECT_HMAC_MD5_PADS:
+                TIME_DIRECT_CALL(compute_hmac_pads(mb_mgr, MD5, src, size,
+                                                   ipad, opad));
+                break;
+        case DIRECT_HMAC_SHA1_PADS_MB:
+        case DIRECT_HMAC_SHA256_PADS_MB:
+        case DIRECT_HMAC_SHA512_PADS_MB:
+                TIME_DIRECT_CALL(set_direct_mb_keys(mb_keys, src, size);
+                                 (void) IMB_HMAC_IPAD_OPAD_MB(
+                                         mb_mgr,
+                                         hmac_mb_alg[func -
+                                                     DIRECT_HMAC_SHA1_PADS_MB],
+                                         mb_keys, mb_key_lens, mb_ipads,
+                                         mb_opads, DIRECT_MB_KEYS));
+                num_keys = DIRECT_MB_KEYS;
+                break;
+        case DIRECT_SHA512_224_ONE_BLOCK:
+                TIME_DIRECT_CALL(IMB_SHA512_224_ONE_BLOCK(mb_mgr, src,
+                                                          digest));
+                break;
+        case DIRECT_SHA512_256_ONE_BLOCK:
+                TIME_DIRECT_CALL(IMB_SHA512_256_ONE_BLOCK(mb_mgr, src,
+                                                          digest));
+                break;
+        case DIRECT_SHA1:
+                TIME_DIRECT_CALL(IMB_SHA1(mb_mgr, src, size, digest));
+                break;
+        case DIRECT_SHA224:
+                TIME_DIRECT_CALL(IMB_SHA224(mb_mgr, src, size, digest));
+                break;
+        case DIRECT_SHA256:
+                TIME_DIRECT_CALL(IMB_SHA256(mb_mgr, src, size, digest));
+                break;
+        case DIRECT_SHA384:
+                TIME_DIRECT_CALL(IMB_SHA384(mb_mgr, src, size, digest));
+                break;
+        case DIRECT_SHA512:
+                TIME_DIRECT_CALL(IMB_SHA512(mb_mgr, src, size, digest));
+                break;
+        case DIRECT_SHA512_224:
+                TIME_DIRECT_CALL(IMB_SHA512_224(mb_mgr, src, size, digest));
+                break;
+        case DIRECT_SHA512_256:
+                TIME_DIRECT_CALL(IMB_SHA512_256(mb_mgr, src, size, digest));
+                break;
+        case DIRECT_CFB_ONE:
+                IMB_AES_KEYEXP_128(mb_mgr, key, enc_keys, dec_keys);
+                TIME_DIRECT_CALL(IMB_AES128_CFB_ONE(mb_mgr, src, src, iv,
+                                                    enc_keys, size));
+                break;
+        case DIRECT_GCM128_ENC:
+                IMB_AES128_GCM_PRE(mb_mgr, key, &gdata_key);
+                TIME_DIRECT_CALL(IMB_AES128_GCM_ENC(mb_mgr, &gdata_key,
+                                                    &gdata_ctx, src, src,
+                                                    size, iv, aad,
+                                                    gcm_aad_size, digest,
+                                                    16));
+                break;
+        case DIRECT_GCM128_SGL:
+                IMB_AES128_GCM_PRE(mb_mgr, key, &gdata_key);
+                TIME_DIRECT_CALL(
+                        IMB_AES128_GCM_INIT(mb_mgr, &gdata_key, &gdata_ctx,
+                                            iv, aad, gcm_aad_size);
+                        IMB_AES128_GCM_ENC_UPDATE(mb_mgr, &gdata_key,
+                                                  &gdata_ctx, src, src,
+                                                  size);
+                        IMB_AES128_GCM_ENC_FINALIZE(mb_mgr, &gdata_key,
+                                                    &gdata_ctx, digest, 16));
+                break;
+        case DIRECT_GCM192_ENC:
+                IMB_AES192_GCM_PRE(mb_mgr, key, &gdata_key);
+                TIME_DIRECT_CALL(IMB_AES192_GCM_ENC(mb_mgr, &gdata_key,
+                                                    &gdata_ctx, src, src,
+                                                    size, iv, aad,
+                                                    gcm_aad_size, digest,
+                                                    16));
+                break;
+        case DIRECT_GCM192_SGL:
+                IMB_AES192_GCM_PRE(mb_mgr, key, &gdata_key);
+                TIME_DIRECT_CALL(
+                        IMB_AES192_GCM_INIT(mb_mgr, &gdata_key, &gdata_ctx,
+                                            iv, aad, gcm_aad_size);
+                        IMB_AES192_GCM_ENC_UPDATE(mb_mgr, &gdata_key,
+                                                  &gdata_ctx, src, src,
+                                                  size);
+                        IMB_AES192_GCM_ENC_FINALIZE(mb_mgr, &gdata_key,
+                                                    &gdata_ctx, digest, 16));
+                break;
+        case DIRECT_GCM256_ENC:
+                IMB_AES256_GCM_PRE(mb_mgr, key, &gdata_key);
+                TIME_DIRECT_CALL(IMB_AES256_GCM_ENC(mb_mgr, &gdata_key,
+                                                    &gdata_ctx, src, src,
+                                                    size, iv, aad,
+                                                    gcm_aad_size, digest,
+                                                    16));
+                break;
+        case DIRECT_GCM256_SGL:
+        default:
+                IMB_AES256_GCM_PRE(mb_mgr, key, &gdata_key);
+                TIME_DIRECT_CALL(
+                        IMB_AES256_GCM_INIT(mb_mgr, &gdata_key, &gdata_ctx,
+                                            iv, aad, gcm_aad_size);
+                        IMB_AES256_GCM_ENC_UPDATE(mb_mgr, &gdata_key,
+                                                  &gdata_ctx, src, src,
+                                                  size);
+                        IMB_AES256_GCM_ENC_FINALIZE(mb_mgr, &gdata_key,
+                                                    &gdata_ctx, digest, 16));
+                break;
+        }
+
+        return time / ((uint64_t) num_iter * num_keys);
+}
+
+/*
+ * Prepares job template equivalent to direct API function.
+ * Returns 0 if there is no job API equivalent (setup functions).
+ */
+static int
+init_direct_job_template(MB_MGR *mb_mgr, const enum direct_func_e func,
+                         const uint32_t size, JOB_AES_HMAC *job_template)
+{
+        static DECLARE_ALIGNED(uint32_t enc_keys[15 * 4], 16);
+        static DECLARE_ALIGNED(uint32_t dec_keys[15 * 4], 16);
+        static DECLARE_ALIGNED(struct gcm_key_data gdata_key, 512);
+        static DECLARE_ALIGNED(uint8_t iv[16], 16);
+        static uint8_t aad[AAD_SIZE_MAX];
+        static uint8_t digest[64];
+        const uint8_t key[32] = {0};
+        const JOB_HASH_ALG plain_sha[] = {
+                PLAIN_SHA1, PLAIN_SHA_224, PLAIN_SHA_256,
+                PLAIN_SHA_384, PLAIN_SHA_512
+        };
+        const uint64_t digest_len[] = {20, 28, 32, 48, 64};
+
+        memset(job_template, 0, sizeof(*job_template));
+        job_template->cipher_direction = ENCRYPT;
+        job_template->chain_order = CIPHER_HASH;
+        job_template->cipher_mode = NULL_CIPHER;
+        job_template->hash_alg = NULL_HASH;
+        job_template->msg_len_to_cipher_in_bytes = size;
+        job_template->msg_len_to_hash_in_bytes = size;
+        job_template->auth_tag_output = digest;
+        job_template->iv = iv;
+
+        switch (func) {
+        case DIRECT_SHA1:
+        case DIRECT_SHA224:
+        case DIRECT_SHA256:
+        case DIRECT_SHA384:
+        case DIRECT_SHA512:
+                job_template->hash_alg = plain_sha[func - DIRECT_SHA1];
+                job_template->auth_tag_output_len_in_bytes =
+                        digest_len[func - DIRECT_SHA1];
+                return 1;
+        case DIRECT_CFB_ONE:
+                /* DOCSIS message shorter than a block is CFB only */
+                IMB_AES_KEYEXP_128(mb_mgr, key, enc_keys, dec_keys);
+                job_template->cipher_mode = DOCSIS_SEC_BPI;
+                job_template->aes_key_len_in_bytes = AES_128_BYTES;
+                job_template->aes_enc_key_expanded = enc_keys;
+                job_template->aes_dec_key_expanded = dec_keys;
+                job_template->iv_len_in_bytes = 16;
+                return 1;
+        case DIRECT_GCM128_ENC:
+        case DIRECT_GCM128_SGL:
+                IMB_AES128_GCM_PRE(mb_mgr, key, &gdata_key);
+                job_template->aes_key_len_in_bytes = AES_128_BYTES;
+                break;
+        case DIRECT_GCM192_ENC:
+        case DIRECT_GCM192_SGL:
+                IMB_AES192_GCM_PRE(mb_mgr, key, &gdata_key);
+                job_template->aes_key_len_in_bytes = AES_192_BYTES;
+                break;
+        case DIRECT_GCM256_ENC:
+        case DIRECT_GCM256_SGL:
+                IMB_AES256_GCM_PRE(mb_mgr, key, &gdata_key);
+                job_template->aes_key_len_in_bytes = AES_256_BYTES;
+                break;
+        default:
+                return 0;
+        }
+
+        /* GCM */
+        job_template->cipher_mode = GCM;
+        job_template->hash_alg = AES_GMAC;
+        job_template->aes_enc_key_expanded = &gdata_key;
+        job_template->aes_dec_key_expanded = &gdata_key;
+        job_template->iv_len_in_bytes = 12;
+        job_template->u.GCM.aad = aad;
+        job_template->u.GCM.aad_len_in_bytes = gcm_aad_size;
+        job_template->auth_tag_output_len_in_bytes = 16;
+        return 1;
+}
+
+/* Performs test of jobs built from template, returns cycles per job */
+static uint64_t
+do_test_direct_job(MB_MGR *mb_mgr, const JOB_AES_HMAC *job_template,
+                   const uint32_t num_iter)
+{
+        static uint32_t index = 0;
+        JOB_AES_HMAC *job;
+        uint64_t time;
+        uint32_t i, aux;
+
+        time = __rdtscp(&aux);
+        for (i = 0; i < num_iter; i++) {
+                job = IMB_GET_NEXT_JOB(mb_mgr);
+                *job = *job_template;
+                job->src = job->dst = buf + offsets[index];
+
+                index += 2;
+                if (index >= index_limit)
+                        index = 0;
+
+#ifdef DEBUG
+                job = IMB_SUBMIT_JOB(mb_mgr);
+#else
+                job = IMB_SUBMIT_JOB_NOCHECK(mb_mgr);
+#endif
+                while (job) {
+#ifdef DEBUG
+                        if (job->status != STS_COMPLETED)
+                                fprintf(stderr, "failed job, status:%d\n",
+                                        job->status);
+#endif
+                        job = IMB_GET_COMPLETED_JOB(mb_mgr);
+                }
+        }
+
+        while (IMB_FLUSH_JOB(mb_mgr) != NULL)
+                ;
+
+        time = __rdtscp(&aux) - time;
+
+        return time / num_iter;
+}
+
+/*
+ * Compares each direct API function (including setup functions
+ * with no job API equivalent) with the job API
+ */
+static int run_direct_api_test(void)
+{
+        MB_MGR *mgr;
+        uint32_t arch, t, sz;
+
+        mgr = alloc_mb_mgr(flags);
+        if (mgr == NULL) {
+                fprintf(stderr, "Error allocating MB_MGR structure!\n");
+                return -1;
         }
-        printf("\n");
-        printf("HASH_ALG");
-        for (col = 0; col < total_variants; col++) {
-                par = variant_list[col].params;
-                h_alg = par.hash_alg - SHA1;
-                printf("\t%s", h_alg_names[h_alg]);
+
+        if (core_mask != 0 && set_affinity(next_core(core_mask, 0)) != 0) {
+                fprintf(stderr, "Could not set affinity\n");
+                free_mb_mgr(mgr);
+                return -1;
         }
-        printf("\n");
-        printf("KEY_SIZE");
-        for (col = 0; col < total_variants; col++) {
-                par = variant_list[col].params;
-                printf("\tAES-%u", par.aes_key_size * 8);
+
+        /* smoke test runs each function once, without print out */
+        if (iter_scale != ITER_SCALE_SMOKE) {
+                if (output_format == OUTPUT_CSV)
+                        printf("arch,function,size,direct_cycles,"
+                               "job_cycles,job_api\n");
+                else
+                        printf("DIRECT API VS JOB API "
+                               "(cycles per call/job)\n"
+                               "ARCH\tFUNCTION\tSIZE\tDIRECT\tJOB\t"
+                               "JOB/DIRECT\tJOB API\n");
         }
-        printf("\n");
-        for (sz = 0; sz < sizes; sz++) {
-                printf("%d", job_size_start + (sz * JOB_SIZE_STEP));
-                for (col = 0; col < total_variants; col++) {
-                        uint64_t *time_ptr =
-                                &variant_list[col].avg_times[sz * NUM_RUNS];
-                        const unsigned long long val =
-                                mean_median(time_ptr, NUM_RUNS);
 
-                        printf("\t%llu", val);
+        for (arch = 0; arch < NUM_ARCHS; arch++) {
+                if (archs[arch] == 0)
+                        continue;
+
+                init_mgr_arch(mgr, arch);
+                fprintf(stderr, "Running direct API test for %s\n",
+                        arch_names[arch]);
+
+                for (t = 0; t < DIM(direct_tests); t++) {
+                        const struct direct_test_s *test = &direct_tests[t];
+                        const uint32_t num_sizes = (test->size == 0) ?
+                                num_job_sizes : 1;
+
+                        for (sz = 0; sz < num_sizes; sz++) {
+                                const uint32_t size = (test->size == 0) ?
+                                        job_sizes[sz] : test->size;
+                                const uint32_t num_iter = (job_iter != 0) ?
+                                        job_iter : iter_scale /
+                                        ((size > 64) ? size : 64);
+                                uint64_t direct[NUM_RUNS], job[NUM_RUNS];
+                                uint64_t direct_time, job_time = 0;
+                                JOB_AES_HMAC job_template;
+                                uint32_t run;
+                                int has_job;
+
+                                has_job = init_direct_job_template(
+                                        mgr, test->func, size,
+                                        &job_template);
+                                for (run = 0; run < NUM_RUNS; run++) {
+                                        direct[run] = do_test_direct(
+                                                mgr, test->func, size,
+                                                num_iter);
+                                        if (has_job)
+                                                job[run] = do_test_direct_job(
+                                                        mgr, &job_template,
+                                                        num_iter);
+                                        if (iter_scale == ITER_SCALE_SMOKE)
+                                                break;
+                                }
+                                if (iter_scale == ITER_SCALE_SMOKE)
+                                        continue;
+
+                                direct_time = mean_median(direct, NUM_RUNS);
+                                if (has_job)
+                                        job_time = mean_median(job, NUM_RUNS);
+
+                                if (output_format == OUTPUT_CSV) {
+                                        printf("%s,%s,%u,%llu,",
+                                               arch_names[arch], test->name,
+                                               size, (unsigned long long)
+                                               direct_time);
+                                        if (has_job)
+                                                printf("%llu,%s",
+                                                       (unsigned long long)
+                                                       job_time,
+                                                       test->job_name);
+                                        else
+                                                printf(",");
+                                        printf("\n");
+                                        continue;
+                                }
+
+                                printf("%s\t%s\t%u\t%llu\t", arch_names[arch],
+                                       test->name, size,
+                                       (unsigned long long) direct_time);
+                                if (has_job)
+                                        printf("%llu\t%.2f\t%s\n",
+                                               (unsigned long long) job_time,
+                                               direct_time ?
+                                               (double) job_time /
+                                               (double) direct_time : 0.0,
+                                               test->job_name);
+                                else
+                                        printf("-\t-\t-\n");
+                        }
                 }
-                printf("\n");
         }
+
+        free_mb_mgr(mgr);
+        return 0;
 }
 
 /* Prepares data structure for test variants storage, sets test configuration */
@@ -1433,14 +3851,7 @@ run_tests(void *arg)
         struct variant_s *variant_list = NULL;
 
         p_mgr = info->p_mgr;
-        if (job_size_start == UINT32_MAX) {
-                /* Unmodified through command line parameters. Use defaults. */
-                params.num_sizes = JOB_SIZE_MAX / JOB_SIZE_STEP;
-                job_size_start = JOB_SIZE_STEP;
-        } else {
-                /* Test only selected size */
-                params.num_sizes = 1;
-        }
+        params.num_sizes = num_job_sizes;
 
         params.core = (uint32_t)info->core;
 
@@ -1476,6 +3887,28 @@ run_tests(void *arg)
                                 (unsigned long)rd_cycles_cost);
         }
 
+        /* Counters are collected by the primary thread only */
+        if (use_perf_counters && info->print_info &&
+            perf_counters_open(&perf_cnt) == 0) {
+                fprintf(stderr, "No performance counters available!\n");
+                goto exit_failure;
+        }
+
+        if (profile != NULL) {
+                const uint32_t num_iter = (job_iter != 0) ? job_iter :
+                        iter_scale;
+
+                for (arch = 0; arch < NUM_ARCHS; arch++) {
+                        if (archs[arch] == 0)
+                                continue;
+                        init_mgr_arch(p_mgr, arch);
+                        do_test_profile(p_mgr, arch, params.core, num_iter,
+                                        info->print_info &&
+                                        iter_scale != ITER_SCALE_SMOKE);
+                }
+                goto exit;
+        }
+
         for (type = TTYPE_AES_HMAC; type < NUM_TTYPES; type++) {
                 if (test_types[type] == 0)
                         continue;
@@ -1538,10 +3971,39 @@ run_tests(void *arg)
              variant < total_variants;
              variant++, variant_ptr++) {
                 variant_ptr->avg_times = (uint64_t *) malloc(at_size);
+                variant_ptr->latencies = NULL;
+                variant_ptr->counters = NULL;
+                variant_ptr->dist_times = NULL;
                 if (!variant_ptr->avg_times) {
                         fprintf(stderr, "Cannot allocate memory\n");
                         goto exit_failure;
                 }
+                if (use_perf_counters && info->print_info) {
+                        variant_ptr->counters = (struct perf_sample_s *)
+                                calloc(NUM_RUNS * params.num_sizes,
+                                       sizeof(struct perf_sample_s));
+                        if (!variant_ptr->counters) {
+                                fprintf(stderr, "Cannot allocate memory\n");
+                                goto exit_failure;
+                        }
+                }
+                if (size_dist != NULL) {
+                        variant_ptr->dist_times = (uint64_t *)
+                                malloc(2 * NUM_RUNS * sizeof(uint64_t));
+                        if (!variant_ptr->dist_times) {
+                                fprintf(stderr, "Cannot allocate memory\n");
+                                goto exit_failure;
+                        }
+                }
+                if (!use_latency)
+                        continue;
+                variant_ptr->latencies = (struct latency_s *)
+                        calloc(NUM_RUNS * params.num_sizes,
+                               sizeof(struct latency_s));
+                if (!variant_ptr->latencies) {
+                        fprintf(stderr, "Cannot allocate memory\n");
+                        goto exit_failure;
+                }
         }
         for (run = 0; run < NUM_RUNS; run++) {
                 fprintf(stderr, "Starting run %d of %d\n", run+1, NUM_RUNS);
@@ -1569,16 +4031,43 @@ run_tests(void *arg)
                         }
                 } /* end for type */
         } /* end for run */
-        if (info->print_info == 1 && iter_scale != ITER_SCALE_SMOKE)
-                print_times(variant_list, &params, total_variants);
+        if (info->print_info == 1 && iter_scale != ITER_SCALE_SMOKE) {
+                switch (output_format) {
+                case OUTPUT_JSON:
+                        print_times_json(variant_list, &params,
+                                         total_variants);
+                        break;
+                case OUTPUT_CSV:
+                        print_times_csv(variant_list, &params,
+                                        total_variants);
+                        break;
+                default:
+                        print_times(variant_list, &params, total_variants);
+                        if (use_latency)
+                                print_latencies(variant_list, &params,
+                                                total_variants);
+                        if (use_perf_counters)
+                                print_perf_counters(variant_list, &params,
+                                                    total_variants);
+                        if (size_dist != NULL)
+                                print_size_dist(variant_list, total_variants);
+                        break;
+                }
+        }
 
 exit:
         if (variant_list != NULL) {
                 /* Freeing variants list */
-                for (i = 0; i < total_variants; i++)
+                for (i = 0; i < total_variants; i++) {
                         free(variant_list[i].avg_times);
+                        free(variant_list[i].latencies);
+                        free(variant_list[i].counters);
+                        free(variant_list[i].dist_times);
+                }
                 free(variant_list);
         }
+        if (use_perf_counters && info->print_info)
+                perf_counters_close(&perf_cnt);
         free_mb_mgr(p_mgr);
 #ifndef _WIN32
         return NULL;
@@ -1633,9 +4122,49 @@ static void usage(void)
                 "         (for validation only)\n"
                 "--job-size: size of the cipher & MAC job in bytes\n"
                 "            (-o still applies for MAC)\n"
+                "--job-sizes list: comma separated job sizes and ranges\n"
+                "                  <min>-<max>[:<step>] (default step 16),\n"
+                "                  e.g. 64,512-9000:512,65000\n"
+                "--job-size-dist file: also run jobs with random sizes\n"
+                "                      following distribution in <file>\n"
+                "                      and compare with fixed mean size\n"
+                "                      jobs (see README)\n"
                 "--aad-size: size of AAD for AEAD algorithms\n"
-                "--job-iter: number of tests iterations for each job size\n",
-                MAX_NUM_THREADS + 1);
+                "--job-iter: number of tests iterations for each job size\n"
+                "--profile file: run traffic profile from <file>, jobs of\n"
+                "                different algorithms and sizes are mixed\n"
+                "                in one manager (see README), text output\n"
+                "                only, latencies of last 64K jobs per entry\n"
+                "--output-format fmt: results output format\n"
+                "                     (text/json/csv) (default = text)\n"
+                "--latency: also report per-job submit to completion latency\n"
+                "           percentiles (p50/p99/p99.9/max, TSC cycles);\n"
+                "           implies --gcm-job-api\n"
+                "--scaling num: run the custom test (default aes-cbc-128 +\n"
+                "               sha1-hmac) on 1 to <num> cores at the same\n"
+                "               time and report Gbps, cycles/byte and\n"
+                "               scaling efficiency. Max: %d\n"
+                "--victim-cores mask: run scalar workload on <mask> cores\n"
+                "                     alone and while the custom test\n"
+                "                     (default aes-cbc-128 + sha1-hmac)\n"
+                "                     runs on the first core of --cores,\n"
+                "                     report workload slowdown per arch;\n"
+                "                     must not include the crypto core\n"
+                "                     (use its SMT sibling instead)\n"
+                "--perf-counters: also report hardware performance counters\n"
+                "                 (instructions, cache misses, APERF/MPERF,\n"
+                "                 AVX512 frequency license cycles),\n"
+                "                 Linux only\n"
+                "--numa-node node: allocate buffers and keys on NUMA <node>\n"
+                "                  (local or remote to the core), Linux only\n"
+                "--hugepages: back buffers and keys with 2MB hugepages,\n"
+                "             Linux only\n"
+                "--sessions num: spread keys and HMAC pads over <num>\n"
+                "                sessions used in random order\n"
+                "--direct-api: compare direct API functions (hash, key\n"
+                "              expansion, HMAC pads, CFB, GCM one-shot\n"
+                "              and init/update/finalize) with job API\n",
+                MAX_NUM_THREADS + 1, MAX_SCALING_CORES);
 }
 
 static int
@@ -1689,6 +4218,71 @@ get_next_num_arg(const char * const *argv, const int index, const int argc,
         return index + 1;
 }
 
+/*
+ * Parses list of job sizes: comma separated sizes or ranges
+ * <min>-<max>[:<step>] (default step is JOB_SIZE_STEP)
+ */
+static int
+get_job_sizes_arg(const char * const *argv, const int index, const int argc)
+{
+        const char *p;
+
+        if (index >= (argc - 1)) {
+                fprintf(stderr, "'%s' requires an argument!\n", argv[index]);
+                exit(EXIT_FAILURE);
+        }
+
+        num_job_sizes = 0;
+        p = argv[index + 1];
+        while (*p != '\0') {
+                unsigned long size_min, size_max, size;
+                unsigned long step = JOB_SIZE_STEP;
+                char *end;
+
+                size_min = strtoul(p, &end, 0);
+                if (end == p)
+                        goto error;
+                size_max = size_min;
+                p = end;
+                if (*p == '-') {
+                        size_max = strtoul(p + 1, &end, 0);
+                        if (end == p + 1)
+                                goto error;
+                        p = end;
+                        if (*p == ':') {
+                                step = strtoul(p + 1, &end, 0);
+                                if (end == p + 1 || step == 0)
+                                        goto error;
+                                p = end;
+                        }
+                }
+                if (size_min > size_max || size_max > JOB_SIZE_MAX)
+                        goto error;
+
+                for (size = size_min; size <= size_max; size += step) {
+                        if (num_job_sizes >= MAX_JOB_SIZES) {
+                                fprintf(stderr, "Too many job sizes "
+                                        "(max %u)!\n", MAX_JOB_SIZES);
+                                exit(EXIT_FAILURE);
+                        }
+                        job_sizes[num_job_sizes++] = (uint32_t) size;
+                }
+
+                if (*p == ',')
+                        p++;
+                else if (*p != '\0')
+                        goto error;
+        }
+
+        if (num_job_sizes != 0)
+                return index + 1;
+
+error:
+        fprintf(stderr, "Invalid job sizes '%s' for '%s' (max size %u)!\n",
+                argv[index + 1], argv[index], JOB_SIZE_MAX);
+        exit(EXIT_FAILURE);
+}
+
 static int
 detect_arch(unsigned int arch_support[NUM_ARCHS])
 {
@@ -1763,6 +4357,232 @@ exit:
         return NULL;
 }
 
+/* Looks up algorithm name in the mapping table (no error print out) */
+static const union params *
+find_string_arg(const char *arg, const struct str_value_mapping *map,
+                const unsigned int num_avail_opts)
+{
+        unsigned int i;
+
+        for (i = 0; i < num_avail_opts; i++)
+                if (strcmp(arg, map[i].name) == 0)
+                        return &(map[i].values);
+
+        return NULL;
+}
+
+/*
+ * Loads job size distribution file. Each non-comment line is an entry:
+ *     <size>[-<max size>] <weight>
+ * Sizes of a range entry are picked uniformly from the range. A schedule
+ * of DIST_SCHED_SIZE job sizes following the weights is precomputed,
+ * so that no random numbers are generated in the timed loop.
+ */
+static struct size_dist_s *load_size_dist(const char *fname)
+{
+        struct size_dist_s *dist;
+        char line[256];
+        unsigned line_num = 0;
+        uint64_t total_weight = 0, weighted_sum = 0;
+        uint32_t i, n;
+        FILE *f;
+
+        f = fopen(fname, "r");
+        if (f == NULL) {
+                fprintf(stderr, "Cannot open size distribution file %s\n",
+                        fname);
+                return NULL;
+        }
+
+        dist = (struct size_dist_s *) calloc(1, sizeof(*dist));
+        if (dist == NULL) {
+                fprintf(stderr, "Cannot allocate memory\n");
+                fclose(f);
+                return NULL;
+        }
+        dist->fname = fname;
+
+        while (fgets(line, sizeof(line), f) != NULL) {
+                char size[32];
+                unsigned weight, size_min, size_max;
+                int fields;
+
+                line_num++;
+                fields = sscanf(line, "%31s %u", size, &weight);
+                if (fields <= 0 || line[0] == '#')
+                        continue;
+
+                if (fields != 2 || weight == 0) {
+                        fprintf(stderr, "%s:%u: invalid distribution entry\n",
+                                fname, line_num);
+                        goto error;
+                }
+
+                if (dist->num_entries >= MAX_DIST_ENTRIES) {
+                        fprintf(stderr, "%s: too many entries (max %u)\n",
+                                fname, MAX_DIST_ENTRIES);
+                        goto error;
+                }
+
+                if (sscanf(size, "%u-%u", &size_min, &size_max) != 2)
+                        size_max = size_min = (unsigned) atoi(size);
+                if (size_min == 0 || size_min > size_max ||
+                    size_max > JOB_SIZE_MAX) {
+                        fprintf(stderr, "%s:%u: invalid size %s (max %u)\n",
+                                fname, line_num, size, JOB_SIZE_MAX);
+                        goto error;
+                }
+                n = dist->num_entries++;
+                dist->size_min[n] = size_min;
+                dist->size_max[n] = size_max;
+                dist->weight[n] = weight;
+                total_weight += weight;
+                weighted_sum += (uint64_t) weight * (size_min + size_max) / 2;
+        }
+
+        if (dist->num_entries == 0) {
+                fprintf(stderr, "%s: no distribution entries\n", fname);
+                goto error;
+        }
+        dist->mean = (uint32_t) ((weighted_sum + total_weight / 2) /
+                                 total_weight);
+
+        /* Precompute pseudo-random job sizes following the weights */
+        for (i = 0; i < DIST_SCHED_SIZE; i++) {
+                uint64_t w = (uint64_t) rand() % total_weight;
+
+                for (n = 0; w >= dist->weight[n]; n++)
+                        w -= dist->weight[n];
+
+                dist->sched[i] = dist->size_min[n];
+                if (dist->size_max[n] > dist->size_min[n])
+                        dist->sched[i] += (uint32_t) rand() %
+                                (dist->size_max[n] - dist->size_min[n] + 1);
+        }
+
+        fclose(f);
+        return dist;
+
+error:
+        fclose(f);
+        free(dist);
+        return NULL;
+}
+
+/*
+ * Loads traffic profile file. Each non-comment line describes one entry:
+ *     <weight> <cipher-algo|aead-algo> <hash-algo|-> <cipher-dir> <size>
+ * where size is either a single value or a range <min>-<max>
+ * (sizes are picked uniformly from the range).
+ */
+static struct profile_s *load_profile(const char *fname)
+{
+        struct profile_s *prof;
+        char line[256];
+        unsigned line_num = 0;
+        FILE *f;
+
+        f = fopen(fname, "r");
+        if (f == NULL) {
+                fprintf(stderr, "Cannot open profile file %s\n", fname);
+                return NULL;
+        }
+
+        prof = (struct profile_s *) calloc(1, sizeof(*prof));
+        if (prof == NULL) {
+                fprintf(stderr, "Cannot allocate memory\n");
+                fclose(f);
+                return NULL;
+        }
+        prof->fname = fname;
+
+        while (fgets(line, sizeof(line), f) != NULL) {
+                struct profile_entry_s *entry;
+                const union params *values;
+                char cipher[32], hash[32], dir[32], size[32];
+                unsigned weight, size_min, size_max;
+                int fields;
+
+                line_num++;
+                fields = sscanf(line, "%u %31s %31s %31s %31s", &weight,
+                                cipher, hash, dir, size);
+                if (fields <= 0 || line[0] == '#')
+                        continue;
+
+                if (fields != 5 || weight == 0) {
+                        fprintf(stderr, "%s:%u: invalid profile entry\n",
+                                fname, line_num);
+                        goto error;
+                }
+
+                if (prof->num_entries >= MAX_PROFILE_ENTRIES) {
+                        fprintf(stderr, "%s: too many entries (max %u)\n",
+                                fname, MAX_PROFILE_ENTRIES);
+                        goto error;
+                }
+                entry = &prof->entries[prof->num_entries];
+                entry->weight = weight;
+                strcpy(entry->cipher_name, cipher);
+                strcpy(entry->hash_name, hash);
+
+                values = find_string_arg(cipher, aead_algo_str_map,
+                                         DIM(aead_algo_str_map));
+                if (values != NULL) {
+                        entry->job_params = values->job_params;
+                } else {
+                        values = check_string_arg("profile cipher", cipher,
+                                                  cipher_algo_str_map,
+                                                  DIM(cipher_algo_str_map));
+                        if (values == NULL)
+                                goto error;
+                        entry->job_params.cipher_mode =
+                                values->job_params.cipher_mode;
+                        entry->job_params.aes_key_size =
+                                values->job_params.aes_key_size;
+
+                        values = check_string_arg("profile hash", hash,
+                                                  hash_algo_str_map,
+                                                  DIM(hash_algo_str_map));
+                        if (values == NULL)
+                                goto error;
+                        entry->job_params.hash_alg =
+                                values->job_params.hash_alg;
+                }
+
+                values = check_string_arg("profile cipher-dir", dir,
+                                          cipher_dir_str_map,
+                                          DIM(cipher_dir_str_map));
+                if (values == NULL)
+                        goto error;
+                entry->job_params.cipher_dir = values->job_params.cipher_dir;
+
+                if (sscanf(size, "%u-%u", &size_min, &size_max) != 2)
+                        size_max = size_min = (unsigned) atoi(size);
+                if (size_min == 0 || size_min > size_max ||
+                    size_max > JOB_SIZE_MAX) {
+                        fprintf(stderr, "%s:%u: invalid size %s (max %u)\n",
+                                fname, line_num, size, JOB_SIZE_MAX);
+                        goto error;
+                }
+                entry->size_min = size_min;
+                entry->size_max = size_max;
+                prof->num_entries++;
+        }
+
+        if (prof->num_entries == 0) {
+                fprintf(stderr, "%s: no profile entries\n", fname);
+                goto error;
+        }
+
+        fclose(f);
+        return prof;
+
+error:
+        fclose(f);
+        free(prof);
+        return NULL;
+}
+
 int main(int argc, char *argv[])
 {
         uint32_t num_t = 0;
@@ -1775,6 +4595,8 @@ int main(int argc, char *argv[])
         unsigned int hash_algo_set = 0;
         unsigned int aead_algo_set = 0;
         unsigned int cipher_dir_set = 0;
+        unsigned int zero_job_size = 0;
+        uint32_t sz;
 
 #ifdef _WIN32
         HANDLE threads[MAX_NUM_THREADS];
@@ -1850,6 +4672,15 @@ int main(int argc, char *argv[])
                         test_types[TTYPE_CUSTOM] = 1;
                         cipher_algo_set = 1;
                         i++;
+                } else if (strcmp(argv[i], "--output-format") == 0) {
+                        values = check_string_arg(argv[i], argv[i+1],
+                                        output_format_str_map,
+                                        DIM(output_format_str_map));
+                        if (values == NULL)
+                                return EXIT_FAILURE;
+
+                        output_format = values->output_format;
+                        i++;
                 } else if (strcmp(argv[i], "--cipher-dir") == 0) {
                         values = check_string_arg(argv[i], argv[i+1],
                                         cipher_dir_str_map,
@@ -1895,25 +4726,39 @@ int main(int argc, char *argv[])
                                              sizeof(sha_size_incr));
                 } else if (strcmp(argv[i], "--job-size") == 0) {
                         i = get_next_num_arg((const char * const *)argv, i,
-                                             argc, &job_size_start,
-                                             sizeof(job_size_start));
-                        if (job_size_start > JOB_SIZE_MAX) {
+                                             argc, &job_sizes[0],
+                                             sizeof(job_sizes[0]));
+                        num_job_sizes = 1;
+                        if (job_sizes[0] > JOB_SIZE_MAX) {
                                 fprintf(stderr,
                                         "Invalid job size %u (max %u)!\n",
-                                        (unsigned) job_size_start,
+                                        (unsigned) job_sizes[0],
                                         JOB_SIZE_MAX);
                                 return EXIT_FAILURE;
                         }
+                } else if (strcmp(argv[i], "--job-sizes") == 0) {
+                        i = get_job_sizes_arg((const char * const *)argv, i,
+                                              argc);
+                } else if (strcmp(argv[i], "--job-size-dist") == 0) {
+                        if (argv[i + 1] == NULL) {
+                                fprintf(stderr, "--job-size-dist requires "
+                                        "an argument\n");
+                                return EXIT_FAILURE;
+                        }
+                        free(size_dist);
+                        size_dist = load_size_dist(argv[++i]);
+                        if (size_dist == NULL)
+                                return EXIT_FAILURE;
                 } else if (strcmp(argv[i], "--aad-size") == 0) {
                         /* Get AAD size for both GCM and CCM */
                         i = get_next_num_arg((const char * const *)argv, i,
                                              argc, &gcm_aad_size,
                                              sizeof(gcm_aad_size));
-                        if (gcm_aad_size > AAD_SIZE_MAX) {
+                        if (gcm_aad_size > CCM_AAD_SIZE_MAX) {
                                 fprintf(stderr,
                                         "Invalid AAD size %u (max %u)!\n",
                                         (unsigned) gcm_aad_size,
-                                        AAD_SIZE_MAX);
+                                        CCM_AAD_SIZE_MAX);
                                 return EXIT_FAILURE;
                         }
                         ccm_aad_size = gcm_aad_size;
@@ -1933,6 +4778,65 @@ int main(int argc, char *argv[])
                                              sizeof(core_mask));
                 } else if (strcmp(argv[i], "--unhalted-cycles") == 0) {
                         use_unhalted_cycles = 1;
+                } else if (strcmp(argv[i], "--profile") == 0) {
+                        if (argv[i + 1] == NULL) {
+                                fprintf(stderr, "--profile requires "
+                                        "an argument\n");
+                                return EXIT_FAILURE;
+                        }
+                        free(profile);
+                        profile = load_profile(argv[++i]);
+                        if (profile == NULL)
+                                return EXIT_FAILURE;
+                } else if (strcmp(argv[i], "--scaling") == 0) {
+                        i = get_next_num_arg((const char * const *)argv, i,
+                                             argc, &scaling_cores,
+                                             sizeof(scaling_cores));
+                        if (scaling_cores == 0 ||
+                            scaling_cores > MAX_SCALING_CORES) {
+                                fprintf(stderr, "Invalid number of cores for "
+                                        "scaling test (max %u)!\n",
+                                        MAX_SCALING_CORES);
+                                return EXIT_FAILURE;
+                        }
+                } else if (strcmp(argv[i], "--victim-cores") == 0) {
+                        i = get_next_num_arg((const char * const *)argv, i,
+                                             argc, &victim_mask,
+                                             sizeof(victim_mask));
+                        if (victim_mask == 0) {
+                                fprintf(stderr, "Invalid victim core mask!\n");
+                                return EXIT_FAILURE;
+                        }
+                } else if (strcmp(argv[i], "--perf-counters") == 0) {
+                        use_perf_counters = 1;
+                } else if (strcmp(argv[i], "--numa-node") == 0) {
+                        uint32_t node = 0;
+
+                        i = get_next_num_arg((const char * const *)argv, i,
+                                             argc, &node, sizeof(node));
+                        if (node >= MAX_NUMA_NODES) {
+                                fprintf(stderr, "Invalid NUMA node "
+                                        "(max %u)!\n", MAX_NUMA_NODES - 1);
+                                return EXIT_FAILURE;
+                        }
+                        numa_node = (int) node;
+                } else if (strcmp(argv[i], "--hugepages") == 0) {
+                        use_hugepages = 1;
+                } else if (strcmp(argv[i], "--direct-api") == 0) {
+                        direct_api_test = 1;
+                } else if (strcmp(argv[i], "--sessions") == 0) {
+                        i = get_next_num_arg((const char * const *)argv, i,
+                                             argc, &num_sessions,
+                                             sizeof(num_sessions));
+                        if (num_sessions == 0) {
+                                fprintf(stderr, "Invalid number of "
+                                        "sessions!\n");
+                                return EXIT_FAILURE;
+                        }
+                } else if (strcmp(argv[i], "--latency") == 0) {
+                        use_latency = 1;
+                        /* latency is only measured for jobs */
+                        use_gcm_job_api = 1;
                 } else {
                         usage();
                         return EXIT_FAILURE;
@@ -1965,7 +4869,56 @@ int main(int argc, char *argv[])
                 }
         }
 
-        if (job_size_start == 0) {
+        if (test_types[TTYPE_AES_GCM] || direct_api_test ||
+                        custom_job_params.cipher_mode == TEST_GCM) {
+                if (gcm_aad_size > AAD_SIZE_MAX) {
+                        fprintf(stderr, "AAD cannot be higher than %u in GCM\n",
+                                AAD_SIZE_MAX);
+                        return EXIT_FAILURE;
+                }
+        }
+
+        if (num_job_sizes == 0 && scaling_cores == 0 && victim_mask == 0)
+                /* Unmodified through command line parameters. Use defaults. */
+                for (sz = JOB_SIZE_STEP; sz <= JOB_SIZE_DEFAULT_MAX;
+                     sz += JOB_SIZE_STEP)
+                        job_sizes[num_job_sizes++] = sz;
+
+        if (size_dist != NULL && (profile != NULL || scaling_cores != 0 ||
+                                  victim_mask != 0)) {
+                fprintf(stderr, "--job-size-dist cannot be used with "
+                        "--profile, --scaling or --victim-cores\n");
+                return EXIT_FAILURE;
+        }
+
+        if ((scaling_cores != 0 || victim_mask != 0) && num_job_sizes > 1) {
+                fprintf(stderr, "--scaling and --victim-cores only use "
+                        "one job size\n");
+                return EXIT_FAILURE;
+        }
+
+        /* Reserve buffer space for the largest job */
+        for (sz = 0; sz < num_job_sizes; sz++) {
+                if (job_sizes[sz] > max_job_size)
+                        max_job_size = job_sizes[sz];
+                if (job_sizes[sz] == 0)
+                        zero_job_size = 1;
+        }
+        if (size_dist != NULL)
+                for (sz = 0; sz < size_dist->num_entries; sz++)
+                        if (size_dist->size_max[sz] > max_job_size)
+                                max_job_size = size_dist->size_max[sz];
+        if (profile != NULL)
+                for (sz = 0; sz < profile->num_entries; sz++)
+                        if (profile->entries[sz].size_max > max_job_size)
+                                max_job_size = profile->entries[sz].size_max;
+        /* CCM AAD is read from the job source buffer */
+        if (max_job_size < ccm_aad_size)
+                max_job_size = (uint32_t) ccm_aad_size;
+        region_size = ((max_job_size + 2048 + 4095) / 4096) * 4096;
+        num_offsets = BUFSIZE / region_size;
+
+        if (zero_job_size) {
                 if (test_types[TTYPE_AES_HMAC] ||
                                 test_types[TTYPE_AES_DOCSIS] ||
                                 test_types[TTYPE_AES_DES] ||
@@ -1978,6 +4931,95 @@ int main(int argc, char *argv[])
                 }
         }
 
+        /* jobs use every second buffer offset */
+        if (num_sessions > num_offsets / 2) {
+                fprintf(stderr, "Invalid number of sessions %u (max %u for "
+                        "this job size)!\n", num_sessions, num_offsets / 2);
+                return EXIT_FAILURE;
+        }
+
+#ifndef LINUX
+        if (numa_node >= 0 || use_hugepages) {
+                fprintf(stderr, "--numa-node and --hugepages are only "
+                        "supported on Linux\n");
+                return EXIT_FAILURE;
+        }
+#endif
+
+        if (use_perf_counters && (profile != NULL || scaling_cores != 0 ||
+                                  victim_mask != 0)) {
+                fprintf(stderr, "--perf-counters cannot be used with "
+                        "--profile, --scaling or --victim-cores\n");
+                return EXIT_FAILURE;
+        }
+
+        if (profile != NULL &&
+            (output_format != OUTPUT_TEXT || use_unhalted_cycles)) {
+                fprintf(stderr, "--profile cannot be used with "
+                        "--unhalted-cycles or JSON/CSV output\n");
+                return EXIT_FAILURE;
+        }
+
+        if (scaling_cores != 0 && victim_mask != 0) {
+                fprintf(stderr, "--scaling cannot be used with "
+                        "--victim-cores\n");
+                return EXIT_FAILURE;
+        }
+
+        if (direct_api_test &&
+            (scaling_cores != 0 || victim_mask != 0 || num_t > 1 ||
+             profile != NULL || size_dist != NULL || use_latency ||
+             use_unhalted_cycles || use_perf_counters ||
+             output_format == OUTPUT_JSON)) {
+                fprintf(stderr, "--direct-api cannot be used with "
+                        "--scaling, --victim-cores, --threads, --profile, "
+                        "--job-size-dist, --latency, --unhalted-cycles, "
+                        "--perf-counters or JSON output\n");
+                return EXIT_FAILURE;
+        }
+
+        if (victim_mask != 0) {
+                if (core_mask == 0) {
+                        fprintf(stderr, "Must specify core mask (crypto "
+                                "core) when running victim test!\n");
+                        return EXIT_FAILURE;
+                }
+                if ((victim_mask >> next_core(core_mask, 0)) & 1) {
+                        /*
+                         * Victim and crypto threads on one logical core
+                         * would just take turns (time slices) and measure
+                         * the scheduler, not the frequency impact.
+                         */
+                        fprintf(stderr, "Victim cores must not include "
+                                "the crypto core (use its SMT sibling "
+                                "to measure same core impact)!\n");
+                        return EXIT_FAILURE;
+                }
+        }
+
+        if (scaling_cores != 0 || victim_mask != 0) {
+                if (num_t > 1 || profile != NULL || use_latency ||
+                    use_unhalted_cycles || output_format == OUTPUT_JSON) {
+                        fprintf(stderr, "--scaling and --victim-cores cannot "
+                                "be used with --threads, --profile, "
+                                "--latency, --unhalted-cycles or JSON "
+                                "output\n");
+                        return EXIT_FAILURE;
+                }
+                if (core_mask != 0 && scaling_cores > bitcount(core_mask)) {
+                        fprintf(stderr, "Insufficient number of cores in "
+                                "core mask (0x%lx) to run scaling test on "
+                                "%u cores!\n", (unsigned long) core_mask,
+                                scaling_cores);
+                        return EXIT_FAILURE;
+                }
+                if (test_types[TTYPE_CUSTOM] == 0) {
+                        custom_job_params.cipher_mode = TEST_CBC;
+                        custom_job_params.hash_alg = TEST_SHA1;
+                        custom_job_params.aes_key_size = AES_128_BYTES;
+                }
+        }
+
         /* Check num cores >= number of threads */
         if ((core_mask != 0 && num_t != 0) && (num_t > bitcount(core_mask))) {
                 fprintf(stderr, "Insufficient number of cores in "
@@ -2043,6 +5085,46 @@ int main(int argc, char *argv[])
         srand(ITER_SCALE_LONG + ITER_SCALE_SHORT + ITER_SCALE_SMOKE);
         init_buf(cache_type);
 
+#ifdef LINUX
+        if (numa_node >= 0) {
+                const int core = (core_mask != 0) ?
+                        next_core(core_mask, 0) : sched_getcpu();
+                const int core_node = get_core_numa_node(core);
+
+                if (core_node < 0)
+                        fprintf(stderr, "Buffers on NUMA node %d, "
+                                "node of core %d unknown\n",
+                                numa_node, core);
+                else
+                        fprintf(stderr, "Buffers on NUMA node %d, "
+                                "core %d on node %d (%s)%s\n", numa_node,
+                                core, core_node,
+                                (core_node == numa_node) ?
+                                "local" : "remote",
+                                (core_mask == 0) ?
+                                ", use --cores to pin the core" : "");
+        }
+#endif
+        if (num_sessions != 0)
+                fprintf(stderr, "Sessions = %u\n", num_sessions);
+
+        if (scaling_cores != 0 || victim_mask != 0) {
+                const int ret = (scaling_cores != 0) ? run_scaling() :
+                        run_victim_test();
+
+                free(profile);
+                free(size_dist);
+                free_mem();
+                return (ret == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
+        if (direct_api_test) {
+                const int ret = run_direct_api_test();
+
+                free_mem();
+                return (ret == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
         if (num_t > 1) {
                 uint32_t n;
 
@@ -2110,6 +5192,8 @@ int main(int argc, char *argv[])
         if (use_unhalted_cycles)
                 machine_fini();
 
+        free(profile);
+        free(size_dist);
         free_mem();
 
         return EXIT_SUCCESS;
@@ -0,0 +1,1212 @@
+/**********************************************************************
+  Copyright(c) 2019 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+/**
+ * @brief Replays packets of a capture (pcap) file through the job API.
+ *        ESP packets are decrypted and authenticated with the SA matching
+ *        their SPI, plaintext packets are ESP (tunnel mode) encrypted with
+ *        the SA matching their destination address.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include <malloc.h> /* memalign() or _aligned_malloc()/aligned_free() */
+
+#ifdef _WIN32
+#include <windows.h>
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#include <unistd.h>
+#include <sched.h>
+#include <time.h>
+#endif
+
+#include <intel-ipsec-mb.h>
+
+#define DIM(_x) (sizeof(_x)/sizeof(_x[0]))
+
+#define MAX_SAS 256
+#define MAX_LINE 1024
+#define DEFAULT_NUM_PASSES 10
+
+#define PCAP_MAGIC        0xa1b2c3d4
+#define PCAP_MAGIC_NSEC   0xa1b23c4d
+#define PCAPNG_MAGIC      0x0a0d0d0a
+#define PCAP_HDR_SIZE     24
+#define PCAP_REC_HDR_SIZE 16
+
+#define LINKTYPE_ETHERNET  1
+#define LINKTYPE_RAW       101
+#define LINKTYPE_LINUX_SLL 113
+#define LINKTYPE_IPV4      228
+#define LINKTYPE_IPV6      229
+
+#define ETH_HDR_SIZE      14
+#define SLL_HDR_SIZE      16
+#define VLAN_HDR_SIZE     4
+#define ETHERTYPE_IPV4    0x0800
+#define ETHERTYPE_IPV6    0x86dd
+#define ETHERTYPE_VLAN    0x8100
+#define ETHERTYPE_QINQ    0x88a8
+#define IPV6_HDR_SIZE     40
+#define UDP_HDR_SIZE      8
+#define IPPROTO_ESP_NUM   50
+#define IPPROTO_UDP_NUM   17
+#define UDP_ENCAP_PORT    4500
+#define ESP_HDR_SIZE      8
+#define ESP_TRAILER_SIZE  2
+#define IPV4_HDR_SIZE     20
+
+/* Space reserved around each packet for ESP header, IV, padding and ICV */
+#define PKT_HEADROOM      64
+#define PKT_TAILROOM      64
+#define PKT_ALIGN         64
+
+enum sa_selector_e {
+        SEL_SPI = 0,    /* ESP packets with given SPI */
+        SEL_DST,        /* plaintext IPv4 packets to given address */
+        SEL_DEFAULT     /* other plaintext packets */
+};
+
+struct cipher_map_s {
+        const char *name;
+        JOB_CIPHER_MODE cipher_mode;
+        uint32_t key_len;       /* AES key size */
+        uint32_t salt_len;      /* nonce/salt appended to the key */
+        uint32_t iv_len;        /* explicit IV in ESP payload */
+        uint32_t block_size;    /* ESP payload padding */
+};
+
+struct hash_map_s {
+        const char *name;
+        JOB_HASH_ALG hash_alg;
+        uint32_t block_size;    /* HMAC block size */
+        uint32_t icv_len;
+};
+
+static const struct cipher_map_s cipher_map[] = {
+        {"null",        NULL_CIPHER, 0,  0, 0,  4},
+        {"aes-cbc-128", CBC,         16, 0, 16, 16},
+        {"aes-cbc-192", CBC,         24, 0, 16, 16},
+        {"aes-cbc-256", CBC,         32, 0, 16, 16},
+        {"aes-ctr-128", CNTR,        16, 4, 8,  4},
+        {"aes-ctr-192", CNTR,        24, 4, 8,  4},
+        {"aes-ctr-256", CNTR,        32, 4, 8,  4},
+        {"aes-gcm-128", GCM,         16, 4, 8,  4},
+        {"aes-gcm-192", GCM,         24, 4, 8,  4},
+        {"aes-gcm-256", GCM,         32, 4, 8,  4}
+};
+
+static const struct hash_map_s hash_map[] = {
+        {"null",        NULL_HASH, 0,   0},
+        {"sha1-hmac",   SHA1,      64,  12},
+        {"sha224-hmac", SHA_224,   64,  14},
+        {"sha256-hmac", SHA_256,   64,  16},
+        {"sha384-hmac", SHA_384,   128, 24},
+        {"sha512-hmac", SHA_512,   128, 32},
+        {"md5-hmac",    MD5,       64,  12},
+        {"aes-xcbc",    AES_XCBC,  0,   12}
+};
+
+struct sa_s {
+        enum sa_selector_e selector;
+        uint32_t spi;
+        uint8_t dst[4];
+        const struct cipher_map_s *cipher;
+        const struct hash_map_s *hash;
+        uint32_t icv_len;
+        uint8_t salt[4];
+        DECLARE_ALIGNED(uint32_t enc_keys[15 * 4], 16);
+        DECLARE_ALIGNED(uint32_t dec_keys[15 * 4], 16);
+        DECLARE_ALIGNED(struct gcm_key_data gcm_key, 64);
+        DECLARE_ALIGNED(uint8_t ipad[64], 16);
+        DECLARE_ALIGNED(uint8_t opad[64], 16);
+        DECLARE_ALIGNED(uint32_t k1_expanded[11 * 4], 16);
+        DECLARE_ALIGNED(uint8_t k2[16], 16);
+        DECLARE_ALIGNED(uint8_t k3[16], 16);
+        uint8_t cipher_key[32 + 4];
+        uint8_t auth_key[128];
+        uint32_t auth_key_len;
+        uint32_t seq;           /* next sequence number (outbound) */
+        uint64_t packets;
+        uint64_t bytes;
+};
+
+/* Packet prepared for replay, offsets are relative to packet data */
+struct pkt_s {
+        uint64_t data_off;      /* offset of packet data in pkt_buf */
+        uint32_t len;           /* captured frame length */
+        uint32_t sa;
+        JOB_CIPHER_DIRECTION dir;
+        uint32_t cipher_off;
+        uint32_t cipher_len;
+        uint32_t hash_off;
+        uint32_t hash_len;
+        uint32_t aad_off;       /* ESP header (GCM AAD) */
+        uint32_t tag_off;       /* ICV output */
+        uint32_t icv_off;       /* received ICV (inbound) */
+        uint32_t iv_off;        /* IV in the packet (CBC) */
+        DECLARE_ALIGNED(uint8_t iv[16], 16); /* nonce/salt + IV (CTR/GCM) */
+};
+
+struct skip_stats_s {
+        uint64_t no_sa;
+        uint64_t truncated;
+        uint64_t malformed;
+        uint64_t unsupported;
+};
+
+static struct sa_s sas[MAX_SAS];
+static uint32_t num_sas = 0;
+
+static uint8_t *pkt_buf = NULL;
+static uint8_t *pkt_orig = NULL;        /* packets as prepared for replay */
+static uint64_t pkt_buf_size = 0;
+static uint64_t pkt_buf_used = 0;
+static struct pkt_s *pkts = NULL;
+static uint32_t num_pkts = 0;
+
+static void usage(void)
+{
+        fprintf(stderr, "Usage: ipsec_replay [args] --sa-config file "
+                "capture.pcap\n"
+                "--sa-config file: SA configuration (see README)\n"
+                "--arch: run only tests on specified architecture "
+                "(SSE/AVX/AVX2/AVX512),\n"
+                "        default: best one supported by the CPU\n"
+                "--passes num: number of times the capture is replayed\n"
+                "              for throughput and again for latency\n"
+                "              (one more warm-up pass is not measured)\n"
+                "              default: %u\n"
+                "--core num: CPU to run the replay on\n",
+                DEFAULT_NUM_PASSES);
+}
+
+/* Returns wall-clock time in nanoseconds */
+static uint64_t get_wall_time_ns(void)
+{
+#ifdef _WIN32
+        LARGE_INTEGER count, freq;
+
+        QueryPerformanceCounter(&count);
+        QueryPerformanceFrequency(&freq);
+        return (uint64_t) ((double) count.QuadPart * 1e9 /
+                           (double) freq.QuadPart);
+#else
+        struct timespec ts;
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+#endif
+}
+
+/* Pins current thread to the CPU */
+static int set_affinity(const int cpu)
+{
+#ifdef _WIN32
+        return !SetThreadAffinityMask(GetCurrentThread(), 1ULL << cpu);
+#else
+        cpu_set_t cpuset;
+
+        CPU_ZERO(&cpuset);
+        CPU_SET(cpu, &cpuset);
+
+        return sched_setaffinity(0, sizeof(cpuset), &cpuset);
+#endif
+}
+
+/* Method used by qsort to compare 2 values */
+static int compare_uint64_t(const void *a, const void *b)
+{
+        const uint64_t x = *(const uint64_t *) a;
+        const uint64_t y = *(const uint64_t *) b;
+
+        return (x > y) - (x < y);
+}
+
+static uint16_t get_be16(const uint8_t *p)
+{
+        return (uint16_t) ((p[0] << 8) | p[1]);
+}
+
+static uint32_t get_be32(const uint8_t *p)
+{
+        return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) |
+                ((uint32_t) p[2] << 8) | (uint32_t) p[3];
+}
+
+static void put_be32(uint8_t *p, const uint32_t val)
+{
+        p[0] = (uint8_t) (val >> 24);
+        p[1] = (uint8_t) (val >> 16);
+        p[2] = (uint8_t) (val >> 8);
+        p[3] = (uint8_t) val;
+}
+
+/* Reads 32-bit value of pcap header in file byte order */
+static uint32_t get_pcap32(const uint8_t *p, const int swap)
+{
+        const uint32_t val = p[0] | (p[1] << 8) | (p[2] << 16) |
+                ((uint32_t) p[3] << 24);
+
+        return swap ? get_be32(p) : val;
+}
+
+/* Parses hex string, returns number of bytes or -1 on error */
+static int parse_hex(const char *str, uint8_t *out, const size_t max_len)
+{
+        size_t len = 0;
+
+        if (strncmp(str, "0x", 2) == 0)
+                str += 2;
+
+        while (str[0] != '\0') {
+                unsigned val;
+
+                if (len >= max_len || str[1] == '\0' ||
+                    sscanf(str, "%2x", &val) != 1)
+                        return -1;
+                out[len++] = (uint8_t) val;
+                str += 2;
+        }
+
+        return (int) len;
+}
+
+/* Expands keys and precomputes HMAC pads of the SA */
+static int init_sa_keys(MB_MGR *mgr, struct sa_s *sa)
+{
+        const uint8_t *key = sa->cipher_key;
+        uint8_t buf[128];
+        uint32_t i;
+
+        memcpy(sa->salt, key + sa->cipher->key_len, sa->cipher->salt_len);
+
+        if (sa->cipher->cipher_mode == GCM) {
+                switch (sa->cipher->key_len) {
+                case AES_128_BYTES:
+                        IMB_AES128_GCM_PRE(mgr, key, &sa->gcm_key);
+                        break;
+                case AES_192_BYTES:
+                        IMB_AES192_GCM_PRE(mgr, key, &sa->gcm_key);
+                        break;
+                default:
+                        IMB_AES256_GCM_PRE(mgr, key, &sa->gcm_key);
+                        break;
+                }
+        } else if (sa->cipher->cipher_mode != NULL_CIPHER) {
+                switch (sa->cipher->key_len) {
+                case AES_128_BYTES:
+                        IMB_AES_KEYEXP_128(mgr, key, sa->enc_keys,
+                                           sa->dec_keys);
+                        break;
+                case AES_192_BYTES:
+                        IMB_AES_KEYEXP_192(mgr, key, sa->enc_keys,
+                                           sa->dec_keys);
+                        break;
+                default:
+                        IMB_AES_KEYEXP_256(mgr, key, sa->enc_keys,
+                                           sa->dec_keys);
+                        break;
+                }
+        }
+
+        if (sa->hash->hash_alg == AES_XCBC) {
+                if (sa->auth_key_len != 16) {
+                        fprintf(stderr, "AES-XCBC key must be 16 bytes\n");
+                        return -1;
+                }
+                IMB_AES_XCBC_KEYEXP(mgr, sa->auth_key, sa->k1_expanded,
+                                    sa->k2, sa->k3);
+                return 0;
+        }
+
+        if (sa->hash->block_size == 0)
+                return 0;
+
+        if (sa->auth_key_len > sa->hash->block_size) {
+                fprintf(stderr, "HMAC keys longer than hash block size "
+                        "(%u bytes) are not supported\n",
+                        sa->hash->block_size);
+                return -1;
+        }
+
+        /* hashed inner and outer pads, as expected by the job API */
+        memset(buf, 0x36, sizeof(buf));
+        for (i = 0; i < sa->auth_key_len; i++)
+                buf[i] ^= sa->auth_key[i];
+        switch (sa->hash->hash_alg) {
+        case SHA1:
+                IMB_SHA1_ONE_BLOCK(mgr, buf, sa->ipad);
+                break;
+        case SHA_224:
+                IMB_SHA224_ONE_BLOCK(mgr, buf, sa->ipad);
+                break;
+        case SHA_256:
+                IMB_SHA256_ONE_BLOCK(mgr, buf, sa->ipad);
+                break;
+        case SHA_384:
+                IMB_SHA384_ONE_BLOCK(mgr, buf, sa->ipad);
+                break;
+        case SHA_512:
+                IMB_SHA512_ONE_BLOCK(mgr, buf, sa->ipad);
+                break;
+        default:
+                IMB_MD5_ONE_BLOCK(mgr, buf, sa->ipad);
+                break;
+        }
+
+        memset(buf, 0x5c, sizeof(buf));
+        for (i = 0; i < sa->auth_key_len; i++)
+                buf[i] ^= sa->auth_key[i];
+        switch (sa->hash->hash_alg) {
+        case SHA1:
+                IMB_SHA1_ONE_BLOCK(mgr, buf, sa->opad);
+                break;
+        case SHA_224:
+                IMB_SHA224_ONE_BLOCK(mgr, buf, sa->opad);
+                break;
+        case SHA_256:
+                IMB_SHA256_ONE_BLOCK(mgr, buf, sa->opad);
+                break;
+        case SHA_384:
+                IMB_SHA384_ONE_BLOCK(mgr, buf, sa->opad);
+                break;
+        case SHA_512:
+                IMB_SHA512_ONE_BLOCK(mgr, buf, sa->opad);
+                break;
+        default:
+                IMB_MD5_ONE_BLOCK(mgr, buf, sa->opad);
+                break;
+        }
+
+        return 0;
+}
+
+/*
+ * Loads SA configuration. Each line is an SA:
+ * <selector> <cipher> <hash> <cipher key> <auth key>
+ * Selector is spi=<num>, dst=<IPv4 address> or default. Keys are hex
+ * strings or "-" (CTR and GCM keys end with 4 bytes of nonce/salt).
+ */
+static int load_sa_config(const char *file_name)
+{
+        FILE *f = fopen(file_name, "r");
+        char line[MAX_LINE];
+        unsigned line_num = 0;
+
+        if (f == NULL) {
+                fprintf(stderr, "Could not open SA config %s\n", file_name);
+                return -1;
+        }
+
+        while (fgets(line, sizeof(line), f) != NULL) {
+                char sel[64], cipher[32], hash[32];
+                char cipher_key[MAX_LINE], auth_key[MAX_LINE];
+                struct sa_s *sa = &sas[num_sas];
+                unsigned a, b, c, d;
+                char *comment = strchr(line, '#');
+                int n, key_len;
+                uint32_t i;
+
+                line_num++;
+                if (comment != NULL)
+                        *comment = '\0';
+
+                n = sscanf(line, "%63s %31s %31s %1023s %1023s", sel, cipher,
+                           hash, cipher_key, auth_key);
+                if (n <= 0)
+                        continue;
+                if (n != 5)
+                        goto error;
+
+                if (num_sas >= MAX_SAS) {
+                        fprintf(stderr, "Too many SAs (max %u)!\n", MAX_SAS);
+                        fclose(f);
+                        return -1;
+                }
+
+                memset(sa, 0, sizeof(*sa));
+                if (strncmp(sel, "spi=", 4) == 0) {
+                        char *end = NULL;
+
+                        sa->selector = SEL_SPI;
+                        sa->spi = (uint32_t) strtoul(sel + 4, &end, 0);
+                        if (end == sel + 4 || *end != '\0')
+                                goto error;
+                } else if (strncmp(sel, "dst=", 4) == 0) {
+                        sa->selector = SEL_DST;
+                        if (sscanf(sel + 4, "%u.%u.%u.%u", &a, &b, &c,
+                                   &d) != 4 || (a | b | c | d) > 255)
+                                goto error;
+                        sa->dst[0] = (uint8_t) a;
+                        sa->dst[1] = (uint8_t) b;
+                        sa->dst[2] = (uint8_t) c;
+                        sa->dst[3] = (uint8_t) d;
+                } else if (strcmp(sel, "default") == 0)
+                        sa->selector = SEL_DEFAULT;
+                else
+                        goto error;
+
+                for (i = 0; i < DIM(cipher_map); i++)
+                        if (strcmp(cipher, cipher_map[i].name) == 0)
+                                sa->cipher = &cipher_map[i];
+                for (i = 0; i < DIM(hash_map); i++)
+                        if (strcmp(hash, hash_map[i].name) == 0)
+                                sa->hash = &hash_map[i];
+                if (sa->cipher == NULL || sa->hash == NULL)
+                        goto error;
+
+                if (sa->cipher->cipher_mode == GCM) {
+                        if (sa->hash->hash_alg != NULL_HASH)
+                                goto error;
+                        sa->icv_len = 16;
+                } else
+                        sa->icv_len = sa->hash->icv_len;
+
+                key_len = (strcmp(cipher_key, "-") == 0) ? 0 :
+                        parse_hex(cipher_key, sa->cipher_key,
+                                  sizeof(sa->cipher_key));
+                if (key_len != (int) (sa->cipher->key_len +
+                                      sa->cipher->salt_len))
+                        goto error;
+
+                key_len = (strcmp(auth_key, "-") == 0) ? 0 :
+                        parse_hex(auth_key, sa->auth_key,
+                                  sizeof(sa->auth_key));
+                if (key_len < 0 || (key_len == 0) !=
+                    (sa->hash->hash_alg == NULL_HASH))
+                        goto error;
+                sa->auth_key_len = (uint32_t) key_len;
+                sa->seq = 1;
+
+                num_sas++;
+        }
+
+        fclose(f);
+
+        if (num_sas == 0) {
+                fprintf(stderr, "No SAs in %s\n", file_name);
+                return -1;
+        }
+
+        return 0;
+
+error:
+        fprintf(stderr, "Invalid SA at line %u of %s\n", line_num, file_name);
+        fclose(f);
+        return -1;
+}
+
+/* Finds SA for ESP packet (SPI) or plaintext packet (destination) */
+static int find_sa(const int esp, const uint32_t spi, const uint8_t *dst)
+{
+        uint32_t i;
+        int def = -1;
+
+        for (i = 0; i < num_sas; i++) {
+                const struct sa_s *sa = &sas[i];
+
+                if (esp) {
+                        if (sa->selector == SEL_SPI && sa->spi == spi)
+                                return (int) i;
+                        continue;
+                }
+                if (sa->selector == SEL_DST && dst != NULL &&
+                    memcmp(sa->dst, dst, sizeof(sa->dst)) == 0)
+                        return (int) i;
+                if (sa->selector == SEL_DEFAULT && def < 0)
+                        def = (int) i;
+        }
+
+        return def;
+}
+
+static void *alloc_aligned(const uint64_t size)
+{
+#ifdef _WIN32
+        return _aligned_malloc(size, PKT_ALIGN);
+#else
+        return memalign(PKT_ALIGN, size);
+#endif
+}
+
+static void free_aligned(void *ptr)
+{
+#ifdef _WIN32
+        _aligned_free(ptr);
+#else
+        free(ptr);
+#endif
+}
+
+/*
+ * Reserves space for packet data, returns its offset in pkt_buf.
+ * Each packet starts on a cache line boundary.
+ */
+static uint64_t alloc_pkt_data(const uint32_t size)
+{
+        const uint64_t offset = pkt_buf_used;
+
+        pkt_buf_used += (size + PKT_ALIGN - 1) & ~(PKT_ALIGN - 1);
+        if (pkt_buf_used > pkt_buf_size) {
+                uint64_t new_size = pkt_buf_size ? pkt_buf_size : 1 << 20;
+                uint8_t *new_buf;
+
+                while (new_size < pkt_buf_used)
+                        new_size *= 2;
+                new_buf = (uint8_t *) alloc_aligned(new_size);
+                if (new_buf == NULL) {
+                        fprintf(stderr, "Could not allocate packet data\n");
+                        exit(EXIT_FAILURE);
+                }
+                if (pkt_buf != NULL)
+                        memcpy(new_buf, pkt_buf, pkt_buf_size);
+                memset(new_buf + pkt_buf_size, 0, new_size - pkt_buf_size);
+                free_aligned(pkt_buf);
+                pkt_buf = new_buf;
+                pkt_buf_size = new_size;
+        }
+
+        return offset;
+}
+
+/*
+ * Parses captured frame and prepares it for replay.
+ * Returns 0 if the packet was added, otherwise updates skip statistics.
+ */
+static int add_packet(const uint8_t *frame, const uint32_t len,
+                      const uint32_t linktype, struct skip_stats_s *skip)
+{
+        uint32_t l3_off = 0, l3_end, l4_off, esp_off = 0;
+        uint16_t ethertype = 0;
+        const uint8_t *dst = NULL;
+        struct pkt_s *pkt;
+        struct sa_s *sa;
+        uint8_t *data;
+        uint8_t proto;
+        int sa_idx;
+
+        switch (linktype) {
+        case LINKTYPE_ETHERNET:
+                l3_off = ETH_HDR_SIZE;
+                if (len < l3_off)
+                        goto malformed;
+                ethertype = get_be16(frame + 12);
+                while ((ethertype == ETHERTYPE_VLAN ||
+                        ethertype == ETHERTYPE_QINQ) &&
+                       len >= l3_off + VLAN_HDR_SIZE) {
+                        ethertype = get_be16(frame + l3_off + 2);
+                        l3_off += VLAN_HDR_SIZE;
+                }
+                if (ethertype != ETHERTYPE_IPV4 &&
+                    ethertype != ETHERTYPE_IPV6)
+                        goto unsupported;
+                break;
+        case LINKTYPE_LINUX_SLL:
+                l3_off = SLL_HDR_SIZE;
+                break;
+        default:
+                /* raw IP */
+                break;
+        }
+
+        if (len < l3_off + IPV4_HDR_SIZE)
+                goto malformed;
+
+        if ((frame[l3_off] >> 4) == 4) {
+                const uint32_t ihl = (frame[l3_off] & 0xf) * 4;
+
+                if (ihl < IPV4_HDR_SIZE)
+                        goto malformed;
+                l3_end = l3_off + get_be16(frame + l3_off + 2);
+                l4_off = l3_off + ihl;
+                proto = frame[l3_off + 9];
+                dst = frame + l3_off + 16;
+                /* fragments are not reassembled */
+                if ((get_be16(frame + l3_off + 6) & 0x3fff) != 0)
+                        goto unsupported;
+        } else if ((frame[l3_off] >> 4) == 6) {
+                l3_end = l3_off + IPV6_HDR_SIZE +
+                        get_be16(frame + l3_off + 4);
+                l4_off = l3_off + IPV6_HDR_SIZE;
+                proto = frame[l3_off + 6];
+        } else
+                goto unsupported;
+
+        /* frame may be longer due to Ethernet padding */
+        if (l3_end > len)
+                goto malformed;
+        if (l4_off > l3_end)
+                goto malformed;
+
+        if (proto == IPPROTO_ESP_NUM)
+                esp_off = l4_off;
+        else if (proto == IPPROTO_UDP_NUM &&
+                 l4_off + UDP_HDR_SIZE + ESP_HDR_SIZE <= l3_end &&
+                 get_be16(frame + l4_off + 2) == UDP_ENCAP_PORT &&
+                 get_be32(frame + l4_off + UDP_HDR_SIZE) != 0)
+                /* UDP encapsulated ESP (non-ESP marker is zero SPI) */
+                esp_off = l4_off + UDP_HDR_SIZE;
+
+        if (esp_off != 0) {
+                if (esp_off + ESP_HDR_SIZE > l3_end)
+                        goto malformed;
+                sa_idx = find_sa(1, get_be32(frame + esp_off), NULL);
+        } else
+                sa_idx = find_sa(0, 0, dst);
+
+        if (sa_idx < 0) {
+                skip->no_sa++;
+                return -1;
+        }
+        sa = &sas[sa_idx];
+
+        pkt = &pkts[num_pkts];
+        memset(pkt, 0, sizeof(*pkt));
+        pkt->len = len;
+        pkt->sa = (uint32_t) sa_idx;
+        pkt->data_off = alloc_pkt_data(PKT_HEADROOM + len + PKT_TAILROOM);
+        data = pkt_buf + pkt->data_off;
+
+        if (esp_off != 0) {
+                /* inbound: authenticate and decrypt ESP payload */
+                const uint32_t esp_len = l3_end - esp_off;
+                const uint32_t overhead = ESP_HDR_SIZE +
+                        sa->cipher->iv_len + sa->icv_len;
+
+                if (esp_len < overhead)
+                        goto malformed;
+
+                memcpy(data, frame, len);
+                pkt->dir = DECRYPT;
+                pkt->aad_off = esp_off;
+                pkt->iv_off = esp_off + ESP_HDR_SIZE;
+                pkt->cipher_off = pkt->iv_off + sa->cipher->iv_len;
+                pkt->cipher_len = esp_len - overhead;
+                pkt->icv_off = l3_end - sa->icv_len;
+                /* ICV is computed into tailroom, compared by check_icvs */
+                pkt->tag_off = len;
+                if (sa->cipher->cipher_mode == CBC &&
+                    (pkt->cipher_len % sa->cipher->block_size) != 0)
+                        goto malformed;
+        } else {
+                /* outbound: tunnel mode, whole IP packet is encrypted */
+                const uint32_t ip_len = l3_end - l3_off;
+                const uint32_t block = sa->cipher->block_size;
+                const uint32_t payload_len =
+                        ((ip_len + ESP_TRAILER_SIZE + block - 1) / block) *
+                        block;
+                uint32_t i;
+
+                memcpy(data + PKT_HEADROOM, frame, len);
+                pkt->dir = ENCRYPT;
+                pkt->cipher_off = PKT_HEADROOM + l3_off;
+                pkt->cipher_len = payload_len;
+                pkt->iv_off = pkt->cipher_off - sa->cipher->iv_len;
+                pkt->aad_off = pkt->iv_off - ESP_HDR_SIZE;
+                pkt->tag_off = pkt->cipher_off + payload_len;
+
+                /* ESP header, IV and trailer (padding, pad length, NH) */
+                put_be32(data + pkt->aad_off, sa->spi);
+                put_be32(data + pkt->aad_off + 4, sa->seq++);
+                for (i = 0; i < sa->cipher->iv_len; i++)
+                        data[pkt->iv_off + i] = (uint8_t) (num_pkts + i);
+                for (i = ip_len; i < payload_len - ESP_TRAILER_SIZE; i++)
+                        data[pkt->cipher_off + i] =
+                                (uint8_t) (i - ip_len + 1);
+                data[pkt->tag_off - 2] =
+                        (uint8_t) (payload_len - ip_len - ESP_TRAILER_SIZE);
+                data[pkt->tag_off - 1] = ((frame[l3_off] >> 4) == 4) ?
+                        4 : 41;
+        }
+
+        if (sa->cipher->cipher_mode == GCM) {
+                pkt->hash_off = pkt->cipher_off;
+                pkt->hash_len = pkt->cipher_len;
+        } else {
+                /* ESP header, IV and ciphertext are authenticated */
+                pkt->hash_off = pkt->aad_off;
+                pkt->hash_len = pkt->cipher_off + pkt->cipher_len -
+                        pkt->aad_off;
+        }
+
+        /* RFC 3686 and RFC 4106: nonce/salt followed by explicit IV */
+        memcpy(pkt->iv, sa->salt, sa->cipher->salt_len);
+        memcpy(pkt->iv + sa->cipher->salt_len, data + pkt->iv_off,
+               sa->cipher->iv_len);
+
+        num_pkts++;
+        return 0;
+
+malformed:
+        skip->malformed++;
+        return -1;
+unsupported:
+        skip->unsupported++;
+        return -1;
+}
+
+/* Loads packets of the capture file */
+static int load_pcap(const char *file_name, struct skip_stats_s *skip)
+{
+        FILE *f = fopen(file_name, "rb");
+        uint8_t hdr[PCAP_HDR_SIZE];
+        uint8_t *frame = NULL;
+        uint32_t magic, snaplen, linktype, max_pkts = 0;
+        int swap, ret = -1;
+
+        if (f == NULL) {
+                fprintf(stderr, "Could not open capture %s\n", file_name);
+                return -1;
+        }
+
+        if (fread(hdr, 1, sizeof(hdr), f) != sizeof(hdr)) {
+                fprintf(stderr, "Capture %s is too short\n", file_name);
+                goto exit;
+        }
+
+        magic = get_pcap32(hdr, 0);
+        if (magic == PCAP_MAGIC || magic == PCAP_MAGIC_NSEC)
+                swap = 0;
+        else if (get_be32(hdr) == PCAP_MAGIC ||
+                 get_be32(hdr) == PCAP_MAGIC_NSEC)
+                swap = 1;
+        else {
+                if (magic == PCAPNG_MAGIC)
+                        fprintf(stderr, "pcapng is not supported, convert "
+                                "capture with 'editcap -F pcap'\n");
+                else
+                        fprintf(stderr, "%s is not a pcap file\n",
+                                file_name);
+                goto exit;
+        }
+
+        snaplen = get_pcap32(hdr + 16, swap);
+        linktype = get_pcap32(hdr + 20, swap);
+        if (linktype != LINKTYPE_ETHERNET && linktype != LINKTYPE_RAW &&
+            linktype != LINKTYPE_LINUX_SLL && linktype != LINKTYPE_IPV4 &&
+            linktype != LINKTYPE_IPV6) {
+                fprintf(stderr, "Unsupported link type %u\n", linktype);
+                goto exit;
+        }
+
+        frame = (uint8_t *) malloc(snaplen ? snaplen : 65535);
+        if (frame == NULL) {
+                fprintf(stderr, "Could not malloc frame buffer\n");
+                goto exit;
+        }
+
+        while (fread(hdr, 1, PCAP_REC_HDR_SIZE, f) == PCAP_REC_HDR_SIZE) {
+                const uint32_t cap_len = get_pcap32(hdr + 8, swap);
+                const uint32_t orig_len = get_pcap32(hdr + 12, swap);
+
+                if (cap_len > (snaplen ? snaplen : 65535) ||
+                    fread(frame, 1, cap_len, f) != cap_len) {
+                        fprintf(stderr, "Capture %s is corrupted\n",
+                                file_name);
+                        goto exit;
+                }
+
+                if (cap_len < orig_len) {
+                        skip->truncated++;
+                        continue;
+                }
+
+                if (num_pkts == max_pkts) {
+                        struct pkt_s *new_pkts;
+
+                        max_pkts = max_pkts ? max_pkts * 2 : 1024;
+                        new_pkts = (struct pkt_s *)
+                                realloc(pkts, max_pkts * sizeof(*pkts));
+                        if (new_pkts == NULL) {
+                                fprintf(stderr, "Could not malloc "
+                                        "packets\n");
+                                goto exit;
+                        }
+                        pkts = new_pkts;
+                }
+
+                add_packet(frame, cap_len, linktype, skip);
+        }
+
+        if (num_pkts == 0)
+                fprintf(stderr, "No packets to replay in %s\n", file_name);
+        else
+                ret = 0;
+
+exit:
+        free(frame);
+        fclose(f);
+        return ret;
+}
+
+/* Fills job from prepared packet */
+static void set_job(JOB_AES_HMAC *job, const struct pkt_s *pkt)
+{
+        const struct sa_s *sa = &sas[pkt->sa];
+        uint8_t *data = pkt_buf + pkt->data_off;
+
+        job->cipher_direction = pkt->dir;
+        job->chain_order = (pkt->dir == ENCRYPT) ? CIPHER_HASH : HASH_CIPHER;
+        job->cipher_mode = sa->cipher->cipher_mode;
+        job->aes_key_len_in_bytes = sa->cipher->key_len;
+        job->src = data;
+        job->dst = data + pkt->cipher_off;
+        job->cipher_start_src_offset_in_bytes = pkt->cipher_off;
+        job->msg_len_to_cipher_in_bytes = pkt->cipher_len;
+        job->hash_start_src_offset_in_bytes = pkt->hash_off;
+        job->msg_len_to_hash_in_bytes = pkt->hash_len;
+        job->auth_tag_output = data + pkt->tag_off;
+        job->auth_tag_output_len_in_bytes = sa->icv_len;
+
+        switch (job->cipher_mode) {
+        case GCM:
+                job->aes_enc_key_expanded = &sa->gcm_key;
+                job->aes_dec_key_expanded = &sa->gcm_key;
+                job->iv = pkt->iv;
+                job->iv_len_in_bytes = 12;
+                job->u.GCM.aad = data + pkt->aad_off;
+                job->u.GCM.aad_len_in_bytes = ESP_HDR_SIZE;
+                job->hash_alg = AES_GMAC;
+                return;
+        case CNTR:
+                job->iv = pkt->iv;
+                job->iv_len_in_bytes = 12;
+                break;
+        default:
+                job->iv = data + pkt->iv_off;
+                job->iv_len_in_bytes = sa->cipher->iv_len;
+                break;
+        }
+        job->aes_enc_key_expanded = sa->enc_keys;
+        job->aes_dec_key_expanded = sa->dec_keys;
+
+        job->hash_alg = sa->hash->hash_alg;
+        if (job->hash_alg == AES_XCBC) {
+                job->u.XCBC._k1_expanded = sa->k1_expanded;
+                job->u.XCBC._k2 = sa->k2;
+                job->u.XCBC._k3 = sa->k3;
+        } else if (job->hash_alg != NULL_HASH) {
+                job->u.HMAC._hashed_auth_key_xor_ipad = sa->ipad;
+                job->u.HMAC._hashed_auth_key_xor_opad = sa->opad;
+        }
+}
+
+/* Checks returned job and stores its submit to completion latency */
+static void complete_job(const JOB_AES_HMAC *job, uint64_t *lat_samples,
+                         uint64_t *lat_count, uint64_t *errors)
+{
+        uint32_t aux;
+
+        if (job->status != STS_COMPLETED)
+                (*errors)++;
+        if (lat_samples != NULL)
+                lat_samples[(*lat_count)++] = __rdtscp(&aux) -
+                        (uint64_t) (uintptr_t) job->user_data;
+}
+
+/*
+ * Replays all packets once, returns number of failed jobs.
+ * Jobs are time stamped only if latency samples are collected.
+ */
+static uint64_t replay(MB_MGR *mgr, uint64_t *lat_samples,
+                       uint64_t *lat_count)
+{
+        JOB_AES_HMAC *job;
+        uint64_t errors = 0;
+        uint32_t i, aux;
+
+        for (i = 0; i < num_pkts; i++) {
+                job = IMB_GET_NEXT_JOB(mgr);
+                set_job(job, &pkts[i]);
+                if (lat_samples != NULL)
+                        job->user_data = (void *) (uintptr_t) __rdtscp(&aux);
+
+                job = IMB_SUBMIT_JOB(mgr);
+                while (job) {
+                        complete_job(job, lat_samples, lat_count, &errors);
+                        job = IMB_GET_COMPLETED_JOB(mgr);
+                }
+        }
+
+        while ((job = IMB_FLUSH_JOB(mgr)) != NULL)
+                complete_job(job, lat_samples, lat_count, &errors);
+
+        return errors;
+}
+
+/*
+ * Compares ICVs computed by the last pass with ICVs of received
+ * packets, returns number of inbound packets failing authentication
+ */
+static uint64_t check_icvs(void)
+{
+        uint64_t mismatches = 0;
+        uint32_t i;
+
+        for (i = 0; i < num_pkts; i++) {
+                const struct pkt_s *pkt = &pkts[i];
+                const uint8_t *data = pkt_buf + pkt->data_off;
+
+                if (pkt->dir == DECRYPT &&
+                    memcmp(data + pkt->tag_off, data + pkt->icv_off,
+                           sas[pkt->sa].icv_len) != 0)
+                        mismatches++;
+        }
+
+        return mismatches;
+}
+
+/*
+ * Restores packets as they were prepared for replay
+ * (inbound packets are decrypted and outbound encrypted in place)
+ */
+static void restore_pkts(void)
+{
+        memcpy(pkt_buf, pkt_orig, pkt_buf_used);
+}
+
+/* Initializes manager for the architecture, NULL selects the best one */
+static MB_MGR *init_mgr(const char *arch)
+{
+        const uint64_t detect_avx =
+                IMB_FEATURE_AVX | IMB_FEATURE_CMOV | IMB_FEATURE_AESNI;
+        const uint64_t detect_avx2 = IMB_FEATURE_AVX2 | detect_avx;
+        const uint64_t detect_avx512 = IMB_FEATURE_AVX512_SKX | detect_avx2;
+        MB_MGR *mgr = alloc_mb_mgr(0);
+
+        if (mgr == NULL) {
+                fprintf(stderr, "Error allocating MB_MGR structure!\n");
+                return NULL;
+        }
+
+        if (arch == NULL) {
+                if ((mgr->features & detect_avx512) == detect_avx512)
+                        arch = "AVX512";
+                else if ((mgr->features & detect_avx2) == detect_avx2)
+                        arch = "AVX2";
+                else if ((mgr->features & detect_avx) == detect_avx)
+                        arch = "AVX";
+                else
+                        arch = "SSE";
+        }
+
+        if (strcmp(arch, "SSE") == 0)
+                init_mb_mgr_sse(mgr);
+        else if (strcmp(arch, "AVX") == 0)
+                init_mb_mgr_avx(mgr);
+        else if (strcmp(arch, "AVX2") == 0)
+                init_mb_mgr_avx2(mgr);
+        else if (strcmp(arch, "AVX512") == 0)
+                init_mb_mgr_avx512(mgr);
+        else {
+                fprintf(stderr, "Invalid architecture %s\n", arch);
+                free_mb_mgr(mgr);
+                return NULL;
+        }
+
+        fprintf(stderr, "Using %s architecture\n", arch);
+
+        return mgr;
+}
+
+int main(int argc, char *argv[])
+{
+        struct skip_stats_s skip;
+        const char *sa_file = NULL, *pcap_file = NULL, *arch = NULL;
+        uint32_t num_passes = DEFAULT_NUM_PASSES, pass, i, aux;
+        uint64_t total_bytes = 0, lat_count = 0, errors = 0;
+        uint64_t icv_mismatches;
+        uint64_t *lat_samples;
+        uint64_t cycles = 0, time_ns = 0;
+        double pkts_total, bytes_total;
+        int core = -1, ret = EXIT_FAILURE;
+        MB_MGR *mgr;
+
+        memset(&skip, 0, sizeof(skip));
+
+        for (i = 1; i < (uint32_t) argc; i++) {
+                if (strcmp(argv[i], "-h") == 0) {
+                        usage();
+                        return EXIT_SUCCESS;
+                } else if (strcmp(argv[i], "--sa-config") == 0 &&
+                           i + 1 < (uint32_t) argc) {
+                        sa_file = argv[++i];
+                } else if (strcmp(argv[i], "--arch") == 0 &&
+                           i + 1 < (uint32_t) argc) {
+                        arch = argv[++i];
+                } else if (strcmp(argv[i], "--passes") == 0 &&
+                           i + 1 < (uint32_t) argc) {
+                        num_passes = (uint32_t) strtoul(argv[++i], NULL, 0);
+                        if (num_passes == 0) {
+                                fprintf(stderr, "Invalid number of "
+                                        "passes!\n");
+                                return EXIT_FAILURE;
+                        }
+                } else if (strcmp(argv[i], "--core") == 0 &&
+                           i + 1 < (uint32_t) argc) {
+                        core = (int) strtol(argv[++i], NULL, 0);
+                } else if (argv[i][0] != '-' && pcap_file == NULL) {
+                        pcap_file = argv[i];
+                } else {
+                        usage();
+                        return EXIT_FAILURE;
+                }
+        }
+
+        if (sa_file == NULL || pcap_file == NULL) {
+                usage();
+                return EXIT_FAILURE;
+        }
+
+        if (core >= 0 && set_affinity(core) != 0) {
+                fprintf(stderr, "Could not set affinity to core %d\n", core);
+                return EXIT_FAILURE;
+        }
+
+        if (load_sa_config(sa_file) != 0)
+                return EXIT_FAILURE;
+
+        mgr = init_mgr(arch);
+        if (mgr == NULL)
+                return EXIT_FAILURE;
+
+        for (i = 0; i < num_sas; i++)
+                if (init_sa_keys(mgr, &sas[i]) != 0)
+                        goto exit;
+
+        if (load_pcap(pcap_file, &skip) != 0)
+                goto exit;
+
+        for (i = 0; i < num_pkts; i++) {
+                sas[pkts[i].sa].packets++;
+                sas[pkts[i].sa].bytes += pkts[i].len;
+                total_bytes += pkts[i].len;
+        }
+
+        pkt_orig = (uint8_t *) alloc_aligned(pkt_buf_used);
+        if (pkt_orig == NULL) {
+                fprintf(stderr, "Could not allocate packet data\n");
+                goto exit;
+        }
+        memcpy(pkt_orig, pkt_buf, pkt_buf_used);
+
+        lat_samples = (uint64_t *) malloc((uint64_t) num_pkts * num_passes *
+                                          sizeof(uint64_t));
+        if (lat_samples == NULL) {
+                fprintf(stderr, "Could not malloc latency samples\n");
+                goto exit;
+        }
+
+        /* warm-up pass, not measured, verifies ICVs of inbound packets */
+        errors = replay(mgr, NULL, NULL);
+        icv_mismatches = check_icvs();
+        if (icv_mismatches != 0)
+                fprintf(stderr, "%" PRIu64 " packets failed ICV check\n",
+                        icv_mismatches);
+
+        /*
+         * Each pass works on the original packets, restoring them
+         * is not measured. Throughput passes don't time stamp jobs,
+         * latencies are collected in the same number of separate passes.
+         */
+        for (pass = 0; pass < num_passes; pass++) {
+                uint64_t start_ns, start_cycles;
+
+                restore_pkts();
+                start_ns = get_wall_time_ns();
+                start_cycles = __rdtscp(&aux);
+                errors += replay(mgr, NULL, NULL);
+                cycles += __rdtscp(&aux) - start_cycles;
+                time_ns += get_wall_time_ns() - start_ns;
+        }
+        for (pass = 0; pass < num_passes; pass++) {
+                restore_pkts();
+                errors += replay(mgr, lat_samples, &lat_count);
+        }
+
+        if (errors != 0)
+                fprintf(stderr, "%" PRIu64 " jobs failed\n", errors);
+
+        qsort(lat_samples, lat_count, sizeof(uint64_t), compare_uint64_t);
+
+        pkts_total = (double) num_pkts * num_passes;
+        bytes_total = (double) total_bytes * num_passes;
+
+        printf("CAPTURE\t%s\n", pcap_file);
+        printf("PACKETS\t%u\n", num_pkts);
+        printf("SKIPPED\tNO_SA %" PRIu64 "\tTRUNCATED %" PRIu64
+               "\tMALFORMED %" PRIu64 "\tUNSUPPORTED %" PRIu64 "\n",
+               skip.no_sa, skip.truncated, skip.malformed, skip.unsupported);
+        printf("ICV_MISMATCH\t%" PRIu64 "\n", icv_mismatches);
+        printf("PASSES\t%u\n", num_passes);
+        printf("CYCLES/PKT\tCYCLES/BYTE\tMPPS\tGBPS\n");
+        printf("%.1f\t%.3f\t%.3f\t%.3f\n", (double) cycles / pkts_total,
+               (double) cycles / bytes_total,
+               pkts_total * 1000.0 / (double) time_ns,
+               bytes_total * 8.0 / (double) time_ns);
+        printf("LATENCY\tP50\tP99\tP99.9\tMAX (cycles)\n");
+        printf("\t%" PRIu64 "\t%" PRIu64 "\t%" PRIu64 "\t%" PRIu64 "\n",
+               lat_samples[((lat_count - 1) * 500) / 1000],
+               lat_samples[((lat_count - 1) * 990) / 1000],
+               lat_samples[((lat_count - 1) * 999) / 1000],
+               lat_samples[lat_count - 1]);
+        printf("SA\tCIPHER\tHASH\tPACKETS\tBYTES\n");
+        for (i = 0; i < num_sas; i++) {
+                const struct sa_s *sa = &sas[i];
+
+                if (sa->selector == SEL_SPI)
+                        printf("spi=0x%x", sa->spi);
+                else if (sa->selector == SEL_DST)
+                        printf("dst=%u.%u.%u.%u", sa->dst[0], sa->dst[1],
+                               sa->dst[2], sa->dst[3]);
+                else
+                        printf("default");
+                printf("\t%s\t%s\t%" PRIu64 "\t%" PRIu64 "\n",
+                       sa->cipher->name, sa->hash->name, sa->packets,
+                       sa->bytes);
+        }
+
+        free(lat_samples);
+        ret = (errors == 0 && icv_mismatches == 0) ?
+                EXIT_SUCCESS : EXIT_FAILURE;
+
+exit:
+        free(pkts);
+        free_aligned(pkt_buf);
+        free_aligned(pkt_orig);
+        free_mb_mgr(mgr);
+        return ret;
+}
@@ -0,0 +1,388 @@
+/**********************************************************************
+  Copyright(c) 2019 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+/**
+ * @brief Provides per-thread hardware performance counters
+ *        (Linux perf_event_open() interface)
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "perf_counters.h"
+
+#ifdef _WIN32
+
+unsigned
+perf_counters_open(struct perf_counters *pc)
+{
+        unsigned i;
+
+        for (i = 0; i < NUM_PERF_COUNTERS; i++) {
+                pc->fd[i] = -1;
+                pc->leader[i] = -1;
+        }
+
+        fprintf(stderr, "Performance counters are not supported on "
+                "this platform\n");
+        return 0;
+}
+
+void
+perf_counters_close(struct perf_counters *pc)
+{
+        (void) pc;
+}
+
+int
+perf_counters_start(const struct perf_counters *pc)
+{
+        (void) pc;
+        return 1;
+}
+
+int
+perf_counters_stop(const struct perf_counters *pc, uint64_t *values)
+{
+        (void) pc;
+        memset(values, 0, NUM_PERF_COUNTERS * sizeof(values[0]));
+        return 1;
+}
+
+#else /* _WIN32 */
+
+#include <unistd.h>
+#include <cpuid.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+/* Raw events of Xeon server cores: (umask << 8) | event */
+#define RAW_L2_RQSTS_MISS                  0x3F24
+#define RAW_CORE_POWER_LVL1_TURBO_LICENSE  0x1828
+#define RAW_CORE_POWER_LVL2_TURBO_LICENSE  0x2028
+#define RAW_CORE_POWER_THROTTLE            0x4028
+
+/* Event configs of the msr PMU */
+#define MSR_PMU_APERF 1
+#define MSR_PMU_MPERF 2
+#define MSR_PMU_TYPE_FILE "/sys/bus/event_source/devices/msr/type"
+
+/*
+ * Layout of read() from group leader with PERF_FORMAT_GROUP and
+ * PERF_FORMAT_TOTAL_TIME_ENABLED/RUNNING
+ */
+struct read_format {
+        uint64_t nr;
+        uint64_t time_enabled;
+        uint64_t time_running;
+        uint64_t values[NUM_PERF_COUNTERS];
+};
+
+static long
+sys_perf_event_open(struct perf_event_attr *attr, const pid_t pid,
+                    const int cpu, const int group_fd,
+                    const unsigned long flags)
+{
+        return syscall(__NR_perf_event_open, attr, pid, cpu, group_fd, flags);
+}
+
+/**
+ * @brief Checks if CPU supports raw events used by the module
+ *        (Intel family 6 server cores with AVX512 frequency licenses)
+ */
+static int
+raw_events_supported(void)
+{
+        static const unsigned models[] = { 0x55, 0x6A, 0x6C };
+        unsigned eax, ebx, ecx, edx, model, i;
+
+        if (__get_cpuid(0, &eax, &ebx, &ecx, &edx) == 0)
+                return 0;
+        /* "GenuineIntel" */
+        if (ebx != 0x756e6547 || edx != 0x49656e69 || ecx != 0x6c65746e)
+                return 0;
+
+        __get_cpuid(1, &eax, &ebx, &ecx, &edx);
+        if (((eax >> 8) & 0xF) != 6)
+                return 0;
+        model = ((eax >> 4) & 0xF) | ((eax >> 12) & 0xF0);
+
+        for (i = 0; i < sizeof(models) / sizeof(models[0]); i++)
+                if (models[i] == model)
+                        return 1;
+        return 0;
+}
+
+/**
+ * @brief Reads type of the msr PMU (APERF/MPERF counters)
+ *
+ * @return PMU type or -1 if not available
+ */
+static int
+get_msr_pmu_type(void)
+{
+        FILE *f = fopen(MSR_PMU_TYPE_FILE, "r");
+        int type = -1;
+
+        if (f == NULL)
+                return -1;
+        if (fscanf(f, "%d", &type) != 1)
+                type = -1;
+        fclose(f);
+        return type;
+}
+
+/**
+ * @brief Opens single counter for the calling thread
+ *
+ * Counter is added to the group of \a leader, so that all counters
+ * of the group are scheduled (and multiplexed) together. If there is
+ * no group yet, counter becomes its leader. If counter can't be added
+ * to the group (e.g. group doesn't fit in the PMU), it is opened
+ * as a leader of its own group.
+ * Counters have to be opened in perf_counter_e order, this is the
+ * order of values in the group read.
+ *
+ * @param pc counter set
+ * @param cnt counter to open
+ * @param type perf event type
+ * @param config perf event config
+ * @param exclude_kernel count only user space
+ * @param leader group leader counter, -1 to start new group
+ */
+static void
+open_counter(struct perf_counters *pc, const enum perf_counter_e cnt,
+             const uint32_t type, const uint64_t config,
+             const int exclude_kernel, int *leader)
+{
+        struct perf_event_attr attr;
+        long fd = -1;
+
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.exclude_kernel = exclude_kernel;
+        attr.exclude_hv = exclude_kernel;
+        attr.read_format = PERF_FORMAT_GROUP |
+                PERF_FORMAT_TOTAL_TIME_ENABLED |
+                PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        pc->fd[cnt] = -1;
+        pc->leader[cnt] = -1;
+
+        if (*leader >= 0) {
+                /* group members are enabled/disabled by the leader */
+                attr.disabled = 0;
+                fd = sys_perf_event_open(&attr, 0, -1, pc->fd[*leader], 0);
+                if (fd >= 0) {
+                        pc->fd[cnt] = (int) fd;
+                        pc->leader[cnt] = *leader;
+                        return;
+                }
+        }
+
+        attr.disabled = 1;
+        fd = sys_perf_event_open(&attr, 0, -1, -1, 0);
+        if (fd < 0)
+                return;
+        pc->fd[cnt] = (int) fd;
+        pc->leader[cnt] = cnt;
+        if (*leader < 0)
+                *leader = cnt;
+}
+
+unsigned
+perf_counters_open(struct perf_counters *pc)
+{
+        const uint64_t l1d_read_miss = PERF_COUNT_HW_CACHE_L1D |
+                (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        const int msr_pmu_type = get_msr_pmu_type();
+        const int raw = raw_events_supported();
+        int core_leader = -1, msr_leader = -1;
+        unsigned i, num = 0;
+
+        for (i = 0; i < NUM_PERF_COUNTERS; i++) {
+                pc->fd[i] = -1;
+                pc->leader[i] = -1;
+        }
+
+        /*
+         * Core PMU counters go to one group, so that ratios
+         * between them (IPC, misses per instruction) are measured
+         * over the same time window even when multiplexed.
+         */
+        open_counter(pc, PERF_CNT_INSTRUCTIONS, PERF_TYPE_HARDWARE,
+                     PERF_COUNT_HW_INSTRUCTIONS, 1, &core_leader);
+        open_counter(pc, PERF_CNT_CYCLES, PERF_TYPE_HARDWARE,
+                     PERF_COUNT_HW_CPU_CYCLES, 1, &core_leader);
+        open_counter(pc, PERF_CNT_L1D_MISSES, PERF_TYPE_HW_CACHE,
+                     l1d_read_miss, 1, &core_leader);
+        if (raw)
+                open_counter(pc, PERF_CNT_L2_MISSES, PERF_TYPE_RAW,
+                             RAW_L2_RQSTS_MISS, 1, &core_leader);
+        open_counter(pc, PERF_CNT_LLC_MISSES, PERF_TYPE_HARDWARE,
+                     PERF_COUNT_HW_CACHE_MISSES, 1, &core_leader);
+
+        /*
+         * msr PMU can't exclude kernel and can't share a group with
+         * core PMU counters. If it is not accessible then fall back
+         * to core and reference cycles, ratio of these gives the same
+         * APERF/MPERF frequency ratio.
+         */
+        if (msr_pmu_type >= 0) {
+                open_counter(pc, PERF_CNT_APERF, msr_pmu_type,
+                             MSR_PMU_APERF, 0, &msr_leader);
+                open_counter(pc, PERF_CNT_MPERF, msr_pmu_type,
+                             MSR_PMU_MPERF, 0, &msr_leader);
+        }
+        if (pc->fd[PERF_CNT_APERF] < 0 || pc->fd[PERF_CNT_MPERF] < 0) {
+                if (pc->fd[PERF_CNT_MPERF] >= 0)
+                        close(pc->fd[PERF_CNT_MPERF]);
+                if (pc->fd[PERF_CNT_APERF] >= 0)
+                        close(pc->fd[PERF_CNT_APERF]);
+                open_counter(pc, PERF_CNT_APERF, PERF_TYPE_HARDWARE,
+                             PERF_COUNT_HW_CPU_CYCLES, 1, &core_leader);
+                open_counter(pc, PERF_CNT_MPERF, PERF_TYPE_HARDWARE,
+                             PERF_COUNT_HW_REF_CPU_CYCLES, 1, &core_leader);
+        }
+
+        if (raw) {
+                open_counter(pc, PERF_CNT_LICENSE1, PERF_TYPE_RAW,
+                             RAW_CORE_POWER_LVL1_TURBO_LICENSE, 1,
+                             &core_leader);
+                open_counter(pc, PERF_CNT_LICENSE2, PERF_TYPE_RAW,
+                             RAW_CORE_POWER_LVL2_TURBO_LICENSE, 1,
+                             &core_leader);
+                open_counter(pc, PERF_CNT_THROTTLE, PERF_TYPE_RAW,
+                             RAW_CORE_POWER_THROTTLE, 1, &core_leader);
+        }
+
+        for (i = 0; i < NUM_PERF_COUNTERS; i++)
+                if (pc->fd[i] >= 0)
+                        num++;
+                else
+                        fprintf(stderr, "Performance counter %s is not "
+                                "available\n",
+                                perf_counter_name((enum perf_counter_e) i));
+        return num;
+}
+
+void
+perf_counters_close(struct perf_counters *pc)
+{
+        int i;
+
+        /* close group members before their leaders */
+        for (i = NUM_PERF_COUNTERS - 1; i >= 0; i--) {
+                if (pc->fd[i] >= 0)
+                        close(pc->fd[i]);
+                pc->fd[i] = -1;
+                pc->leader[i] = -1;
+        }
+}
+
+int
+perf_counters_start(const struct perf_counters *pc)
+{
+        unsigned i;
+        int ret = 0;
+
+        for (i = 0; i < NUM_PERF_COUNTERS; i++) {
+                if (pc->fd[i] < 0 || pc->leader[i] != (int) i)
+                        continue;
+                ret |= ioctl(pc->fd[i], PERF_EVENT_IOC_RESET,
+                             PERF_IOC_FLAG_GROUP);
+                ret |= ioctl(pc->fd[i], PERF_EVENT_IOC_ENABLE,
+                             PERF_IOC_FLAG_GROUP);
+        }
+        return ret;
+}
+
+int
+perf_counters_stop(const struct perf_counters *pc, uint64_t *values)
+{
+        unsigned i, j;
+        int ret = 0;
+
+        for (i = 0; i < NUM_PERF_COUNTERS; i++)
+                if (pc->fd[i] >= 0 && pc->leader[i] == (int) i)
+                        ret |= ioctl(pc->fd[i], PERF_EVENT_IOC_DISABLE,
+                                     PERF_IOC_FLAG_GROUP);
+
+        memset(values, 0, NUM_PERF_COUNTERS * sizeof(values[0]));
+        for (i = 0; i < NUM_PERF_COUNTERS; i++) {
+                struct read_format data;
+                uint64_t n = 0;
+                ssize_t len;
+
+                if (pc->fd[i] < 0 || pc->leader[i] != (int) i)
+                        continue;
+                len = read(pc->fd[i], &data, sizeof(data));
+                if (len < (ssize_t) (3 * sizeof(uint64_t)) ||
+                    len < (ssize_t) ((3 + data.nr) * sizeof(uint64_t))) {
+                        ret = 1;
+                        continue;
+                }
+                /* group values come in the order counters were opened */
+                for (j = i; j < NUM_PERF_COUNTERS && n < data.nr; j++) {
+                        if (pc->fd[j] < 0 || pc->leader[j] != (int) i)
+                                continue;
+                        /* scale value if group was multiplexed */
+                        if (data.time_running != 0 &&
+                            data.time_running < data.time_enabled)
+                                values[j] = (uint64_t)
+                                        ((double) data.values[n] *
+                                         data.time_enabled /
+                                         data.time_running);
+                        else
+                                values[j] = data.values[n];
+                        n++;
+                }
+        }
+        return ret;
+}
+
+#endif /* _WIN32 */
+
+const char *
+perf_counter_name(const enum perf_counter_e counter)
+{
+        static const char * const names[NUM_PERF_COUNTERS] = {
+                "instructions", "cycles", "l1d_misses", "l2_misses",
+                "llc_misses", "aperf", "mperf", "license1_cycles",
+                "license2_cycles", "throttle_cycles"
+        };
+
+        if ((unsigned) counter >= NUM_PERF_COUNTERS)
+                return "unknown";
+        return names[counter];
+}
@@ -0,0 +1,119 @@
+/**********************************************************************
+  Copyright(c) 2019 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+/**
+ * @brief Provides per-thread hardware performance counters
+ *        (Linux perf_event_open() interface)
+ */
+
+#ifndef __PERF_COUNTERS_H__
+#define __PERF_COUNTERS_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Counters collected by the module.
+ * L2 misses and AVX512 license counters are model specific
+ * raw events and are only available on Xeon server cores
+ * (Skylake-SP, Cascade Lake, Ice Lake-SP).
+ */
+enum perf_counter_e {
+        PERF_CNT_INSTRUCTIONS = 0,      /**< instructions retired */
+        PERF_CNT_CYCLES,                /**< core cycles */
+        PERF_CNT_L1D_MISSES,            /**< L1 data cache read misses */
+        PERF_CNT_L2_MISSES,             /**< L2 cache misses (all requests) */
+        PERF_CNT_LLC_MISSES,            /**< last level cache misses */
+        PERF_CNT_APERF,                 /**< actual cycles (APERF) */
+        PERF_CNT_MPERF,                 /**< reference cycles (MPERF) */
+        PERF_CNT_LICENSE1,              /**< cycles at AVX2/light AVX512
+                                           frequency license */
+        PERF_CNT_LICENSE2,              /**< cycles at heavy AVX512
+                                           frequency license */
+        PERF_CNT_THROTTLE,              /**< cycles throttled during
+                                           license transitions */
+        NUM_PERF_COUNTERS
+};
+
+/**
+ * Set of counters opened for the calling thread.
+ * Counters are opened in groups, read and scaled together.
+ */
+struct perf_counters {
+        int fd[NUM_PERF_COUNTERS];      /**< -1 if counter is not available */
+        int leader[NUM_PERF_COUNTERS];  /**< group leader of the counter */
+};
+
+/**
+ * @brief Opens counters for the calling thread (counters are stopped)
+ *
+ * @param pc counter set to initialize
+ *
+ * @return Number of available counters, 0 if none could be opened
+ */
+unsigned perf_counters_open(struct perf_counters *pc);
+
+/**
+ * @brief Closes all counters of the set
+ */
+void perf_counters_close(struct perf_counters *pc);
+
+/**
+ * @brief Resets and starts counters of the set
+ *
+ * @return 0 on success, non-zero otherwise
+ */
+int perf_counters_start(const struct perf_counters *pc);
+
+/**
+ * @brief Stops counters and reads their values
+ *
+ * Values are scaled if counters were multiplexed by the kernel.
+ * Values of counters which are not available are set to 0.
+ *
+ * @param pc counter set
+ * @param values array of NUM_PERF_COUNTERS elements
+ *
+ * @return 0 on success, non-zero otherwise
+ */
+int perf_counters_stop(const struct perf_counters *pc, uint64_t *values);
+
+/**
+ * @brief Returns name of the counter
+ */
+const char *perf_counter_name(const enum perf_counter_e counter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PERF_COUNTERS_H__ */
@@ -26,6 +26,7 @@
 #
 
 APP = ipsec_perf
+REPLAY_APP = ipsec_replay
 INSTNAME = intel-ipsec-mb
 
 !if !defined(PREFIX)
@@ -59,10 +60,10 @@ CFLAGS = /nologo $(DCFLAGS) /Y- /W3 /WX- /Gm- /fp:precise /EHsc $(EXTRA_CFLAGS)
 LNK = link
 LFLAGS = /out:$(APP).exe $(DLFLAGS)
 
-all: $(APP).exe
+all: $(APP).exe $(REPLAY_APP).exe
 
-$(APP).exe: ipsec_perf.obj msr.obj $(IPSECLIB)
-        $(LNK) $(LFLAGS) ipsec_perf.obj msr.obj $(IPSECLIB)
+$(APP).exe: ipsec_perf.obj msr.obj perf_counters.obj $(IPSECLIB)
+        $(LNK) $(LFLAGS) ipsec_perf.obj msr.obj perf_counters.obj $(IPSECLIB)
 
 ipsec_perf.obj: ipsec_perf.c
         $(CC) /c $(CFLAGS) ipsec_perf.c
@@ -70,5 +71,15 @@ ipsec_perf.obj: ipsec_perf.c
 msr.obj: msr.c
         $(CC) /c $(CFLAGS) msr.c
 
+perf_counters.obj: perf_counters.c
+        $(CC) /c $(CFLAGS) perf_counters.c
+
+$(REPLAY_APP).exe: ipsec_replay.obj $(IPSECLIB)
+        $(LNK) /out:$(REPLAY_APP).exe $(DLFLAGS) ipsec_replay.obj $(IPSECLIB)
+
+ipsec_replay.obj: ipsec_replay.c
+        $(CC) /c $(CFLAGS) ipsec_replay.c
+
 clean:
-	del /q ipsec_perf.obj msr.obj $(APP).exe $(APP).pdb $(APP).ilk
+	del /q ipsec_perf.obj msr.obj perf_counters.obj $(APP).exe $(APP).pdb $(APP).ilk
+	del /q ipsec_replay.obj $(REPLAY_APP).exe $(REPLAY_APP).pdb $(REPLAY_APP).ilk
@@ -338,6 +338,150 @@ static struct aes_vector aes_cfb_128_tab[] = {
         {CFBK6, CFBIV6, CFBP6, sizeof(CFBP6), CFBC6, sizeof(CFBK6)},
 };
 
+/*
+ * AES-CFB128 (any message length) cipher mode test vectors.
+ * Full messages are from NIST SP 800-38A F.3.13 - F.3.18 (with K1 - K3,
+ * IV1 - IV3 and P1 - P3 above) and shorter lengths use the same data,
+ * as CFB output for a message prefix is the prefix of the output.
+ * The long message was computed with OpenSSL for bytes (13 * i + 7) mod 256.
+ */
+static const uint8_t CFB_C1[] = {
+        0x3b, 0x3f, 0xd9, 0x2e, 0xb7, 0x2d, 0xad, 0x20,
+        0x33, 0x34, 0x49, 0xf8, 0xe8, 0x3c, 0xfb, 0x4a,
+        0xc8, 0xa6, 0x45, 0x37, 0xa0, 0xb3, 0xa9, 0x3f,
+        0xcd, 0xe3, 0xcd, 0xad, 0x9f, 0x1c, 0xe5, 0x8b,
+        0x26, 0x75, 0x1f, 0x67, 0xa3, 0xcb, 0xb1, 0x40,
+        0xb1, 0x80, 0x8c, 0xf1, 0x87, 0xa4, 0xf4, 0xdf,
+        0xc0, 0x4b, 0x05, 0x35, 0x7c, 0x5d, 0x1c, 0x0e,
+        0xea, 0xc4, 0xc6, 0x6f, 0x9f, 0xf7, 0xf2, 0xe6
+};
+static const uint8_t CFB_C2[] = {
+        0xcd, 0xc8, 0x0d, 0x6f, 0xdd, 0xf1, 0x8c, 0xab,
+        0x34, 0xc2, 0x59, 0x09, 0xc9, 0x9a, 0x41, 0x74,
+        0x67, 0xce, 0x7f, 0x7f, 0x81, 0x17, 0x36, 0x21,
+        0x96, 0x1a, 0x2b, 0x70, 0x17, 0x1d, 0x3d, 0x7a,
+        0x2e, 0x1e, 0x8a, 0x1d, 0xd5, 0x9b, 0x88, 0xb1,
+        0xc8, 0xe6, 0x0f, 0xed, 0x1e, 0xfa, 0xc4, 0xc9,
+        0xc0, 0x5f, 0x9f, 0x9c, 0xa9, 0x83, 0x4f, 0xa0,
+        0x42, 0xae, 0x8f, 0xba, 0x58, 0x4b, 0x09, 0xff
+};
+static const uint8_t CFB_C3[] = {
+        0xdc, 0x7e, 0x84, 0xbf, 0xda, 0x79, 0x16, 0x4b,
+        0x7e, 0xcd, 0x84, 0x86, 0x98, 0x5d, 0x38, 0x60,
+        0x39, 0xff, 0xed, 0x14, 0x3b, 0x28, 0xb1, 0xc8,
+        0x32, 0x11, 0x3c, 0x63, 0x31, 0xe5, 0x40, 0x7b,
+        0xdf, 0x10, 0x13, 0x24, 0x15, 0xe5, 0x4b, 0x92,
+        0xa1, 0x3e, 0xd0, 0xa8, 0x26, 0x7a, 0xe2, 0xf9,
+        0x75, 0xa3, 0x85, 0x74, 0x1a, 0xb9, 0xce, 0xf8,
+        0x20, 0x31, 0x62, 0x3d, 0x55, 0xb1, 0xe4, 0x71
+};
+static const uint8_t CFB_LONG_K[] = {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17
+};
+static const uint8_t CFB_LONG_IV[] = {
+        0xf0, 0xe0, 0xd0, 0xc0, 0xb0, 0xa0, 0x90, 0x80,
+        0x70, 0x60, 0x50, 0x40, 0x30, 0x20, 0x10, 0x00
+};
+static const uint8_t CFB_LONG_P[] = {
+        0x07, 0x14, 0x21, 0x2e, 0x3b, 0x48, 0x55, 0x62,
+        0x6f, 0x7c, 0x89, 0x96, 0xa3, 0xb0, 0xbd, 0xca,
+        0xd7, 0xe4, 0xf1, 0xfe, 0x0b, 0x18, 0x25, 0x32,
+        0x3f, 0x4c, 0x59, 0x66, 0x73, 0x80, 0x8d, 0x9a,
+        0xa7, 0xb4, 0xc1, 0xce, 0xdb, 0xe8, 0xf5, 0x02,
+        0x0f, 0x1c, 0x29, 0x36, 0x43, 0x50, 0x5d, 0x6a,
+        0x77, 0x84, 0x91, 0x9e, 0xab, 0xb8, 0xc5, 0xd2,
+        0xdf, 0xec, 0xf9, 0x06, 0x13, 0x20, 0x2d, 0x3a,
+        0x47, 0x54, 0x61, 0x6e, 0x7b, 0x88, 0x95, 0xa2,
+        0xaf, 0xbc, 0xc9, 0xd6, 0xe3, 0xf0, 0xfd, 0x0a,
+        0x17, 0x24, 0x31, 0x3e, 0x4b, 0x58, 0x65, 0x72,
+        0x7f, 0x8c, 0x99, 0xa6, 0xb3, 0xc0, 0xcd, 0xda,
+        0xe7, 0xf4, 0x01, 0x0e, 0x1b, 0x28, 0x35, 0x42,
+        0x4f, 0x5c, 0x69, 0x76, 0x83, 0x90, 0x9d, 0xaa,
+        0xb7, 0xc4, 0xd1, 0xde, 0xeb, 0xf8, 0x05, 0x12,
+        0x1f, 0x2c, 0x39, 0x46, 0x53, 0x60, 0x6d, 0x7a,
+        0x87, 0x94, 0xa1, 0xae, 0xbb, 0xc8, 0xd5, 0xe2,
+        0xef, 0xfc, 0x09, 0x16, 0x23, 0x30, 0x3d, 0x4a,
+        0x57, 0x64, 0x71, 0x7e, 0x8b, 0x98, 0xa5, 0xb2,
+        0xbf, 0xcc, 0xd9, 0xe6, 0xf3, 0x00, 0x0d, 0x1a,
+        0x27, 0x34, 0x41, 0x4e, 0x5b, 0x68, 0x75, 0x82,
+        0x8f, 0x9c, 0xa9, 0xb6, 0xc3, 0xd0, 0xdd, 0xea,
+        0xf7, 0x04, 0x11, 0x1e, 0x2b, 0x38, 0x45, 0x52,
+        0x5f, 0x6c, 0x79, 0x86, 0x93, 0xa0, 0xad, 0xba,
+        0xc7, 0xd4, 0xe1, 0xee, 0xfb, 0x08, 0x15, 0x22,
+        0x2f, 0x3c, 0x49, 0x56, 0x63, 0x70, 0x7d, 0x8a,
+        0x97, 0xa4, 0xb1, 0xbe, 0xcb, 0xd8, 0xe5, 0xf2,
+        0xff, 0x0c, 0x19, 0x26, 0x33, 0x40, 0x4d, 0x5a,
+        0x67, 0x74, 0x81, 0x8e, 0x9b, 0xa8, 0xb5, 0xc2,
+        0xcf, 0xdc, 0xe9, 0xf6, 0x03, 0x10, 0x1d, 0x2a,
+        0x37, 0x44, 0x51, 0x5e, 0x6b, 0x78, 0x85, 0x92,
+        0x9f, 0xac, 0xb9, 0xc6, 0xd3, 0xe0, 0xed, 0xfa,
+        0x07, 0x14, 0x21, 0x2e, 0x3b, 0x48, 0x55, 0x62,
+        0x6f, 0x7c, 0x89, 0x96, 0xa3, 0xb0, 0xbd, 0xca,
+        0xd7, 0xe4, 0xf1, 0xfe, 0x0b, 0x18, 0x25, 0x32,
+        0x3f, 0x4c, 0x59, 0x66, 0x73, 0x80, 0x8d, 0x9a,
+        0xa7, 0xb4, 0xc1, 0xce, 0xdb, 0xe8, 0xf5, 0x02,
+        0x0f, 0x1c, 0x29, 0x36
+};
+static const uint8_t CFB_LONG_C[] = {
+        0xe4, 0x26, 0x09, 0xa1, 0x9e, 0x3a, 0x3e, 0x4b,
+        0xba, 0x94, 0x30, 0x2c, 0x66, 0x0e, 0x7a, 0x49,
+        0xb3, 0xb3, 0x82, 0xd3, 0xad, 0x5d, 0xe0, 0xc7,
+        0xe4, 0x0b, 0x5b, 0x96, 0xf7, 0x84, 0x70, 0x60,
+        0x0c, 0xe0, 0x0c, 0xe1, 0x00, 0x61, 0x93, 0x6b,
+        0x80, 0xe6, 0xa9, 0x14, 0x26, 0x66, 0x89, 0x9c,
+        0x55, 0x73, 0x04, 0x4c, 0xa8, 0xae, 0x74, 0xed,
+        0x94, 0xeb, 0x4b, 0x42, 0xcf, 0x31, 0xfc, 0x94,
+        0xbb, 0x79, 0x9d, 0xd0, 0x99, 0x45, 0x71, 0xf3,
+        0x0f, 0x05, 0x2e, 0x46, 0x3c, 0xde, 0x0d, 0xc3,
+        0xd0, 0xa0, 0x13, 0x57, 0xea, 0xa7, 0xb2, 0xc5,
+        0x1c, 0xa1, 0x94, 0x89, 0x54, 0x74, 0x06, 0xd8,
+        0xc2, 0x30, 0x9c, 0xef, 0x17, 0xac, 0x77, 0xfd,
+        0x4e, 0x6c, 0x51, 0xce, 0x5b, 0x0a, 0xe4, 0xf0,
+        0x07, 0x9b, 0xa7, 0x40, 0x81, 0xdc, 0xbf, 0x48,
+        0x7c, 0x66, 0xe7, 0xcb, 0xb6, 0x51, 0x6e, 0x5c,
+        0xd8, 0xea, 0x36, 0x5b, 0x4e, 0xe5, 0xa3, 0x6f,
+        0x4a, 0x17, 0xcc, 0x1a, 0x04, 0x21, 0xe3, 0x84,
+        0x8e, 0x45, 0x36, 0x0d, 0x95, 0x3f, 0x4d, 0xd7,
+        0x8e, 0xbe, 0xc6, 0x6b, 0xc0, 0x98, 0x2a, 0x8a,
+        0x6e, 0x99, 0xcb, 0x60, 0xa2, 0xda, 0x23, 0xd1,
+        0xa6, 0xb9, 0x19, 0xed, 0x40, 0x9e, 0x25, 0xb0,
+        0x8e, 0xbe, 0xf8, 0x8b, 0xb4, 0xd7, 0x3a, 0xfd,
+        0xf2, 0x6c, 0x2f, 0xec, 0x22, 0xbb, 0xd8, 0x44,
+        0x70, 0x41, 0x3a, 0xe5, 0xe5, 0x12, 0xdd, 0x5e,
+        0x4b, 0xa8, 0x5d, 0x53, 0x69, 0x5a, 0xd7, 0x41,
+        0x82, 0x59, 0x20, 0xf3, 0x2e, 0x10, 0x8f, 0xb2,
+        0x0c, 0x93, 0x10, 0xdb, 0x26, 0xa8, 0x67, 0xf2,
+        0x19, 0x6d, 0xbe, 0x5e, 0xae, 0xd4, 0xcc, 0x23,
+        0xe7, 0x8f, 0xa9, 0x86, 0xf2, 0x52, 0x73, 0xbc,
+        0x7a, 0x74, 0xcd, 0x5c, 0x93, 0xec, 0x30, 0x3e,
+        0x12, 0xd4, 0x4f, 0xde, 0xd1, 0xfb, 0x85, 0x8d,
+        0xbb, 0x2e, 0x71, 0xd6, 0x88, 0x17, 0x31, 0x79,
+        0x63, 0x63, 0x71, 0xdb, 0x4d, 0x3f, 0x6c, 0xba,
+        0x92, 0xbd, 0xaf, 0xc7, 0x8e, 0xea, 0x54, 0x7c,
+        0x10, 0x87, 0xbd, 0xf7, 0x3d, 0xdb, 0x2b, 0x29,
+        0xb0, 0x0e, 0xe6, 0xd5, 0xe1, 0xe4, 0x58, 0x9e,
+        0x5b, 0xa8, 0x6b, 0x1b
+};
+static const struct aes_vector cfb_vectors[] = {
+        {K1, IV1, P1, sizeof(P1), CFB_C1, sizeof(K1)},
+        {K1, IV1, P1, 1, CFB_C1, sizeof(K1)},
+        {K1, IV1, P1, 17, CFB_C1, sizeof(K1)},
+        {K2, IV2, P2, sizeof(P2), CFB_C2, sizeof(K2)},
+        {K2, IV2, P2, 47, CFB_C2, sizeof(K2)},
+        {K3, IV3, P3, sizeof(P3), CFB_C3, sizeof(K3)},
+        {K3, IV3, P3, 33, CFB_C3, sizeof(K3)},
+        {CFB_LONG_K, CFB_LONG_IV, CFB_LONG_P, sizeof(CFB_LONG_P), CFB_LONG_C,
+         sizeof(CFB_LONG_K)},
+        {CFB_LONG_K, CFB_LONG_IV, CFB_LONG_P, 128, CFB_LONG_C,
+         sizeof(CFB_LONG_K)},
+        {CFB_LONG_K, CFB_LONG_IV, CFB_LONG_P, 129, CFB_LONG_C,
+         sizeof(CFB_LONG_K)},
+        {CFB_LONG_K, CFB_LONG_IV, CFB_LONG_P, 255, CFB_LONG_C,
+         sizeof(CFB_LONG_K)},
+};
+
 static int
 aes_job_ok(const struct JOB_AES_HMAC *job,
            const uint8_t *out_text,
@@ -623,6 +767,364 @@ cfb128_validate(struct MB_MGR *mb_mgr)
         return 1;
 }
 
+/* state shared by the job callbacks of test_cfb_mixed() */
+struct cfb_mixed_ctx {
+        uint32_t (*enc_keys)[15*4];
+        uint8_t *bufs;
+        JOB_CIPHER_DIRECTION dir;
+};
+
+static void
+cfb_mixed_fill_job(struct JOB_AES_HMAC *job, const int n, void *arg)
+{
+        const struct cfb_mixed_ctx *ctx = arg;
+        const unsigned v = n % DIM(cfb_vectors);
+        const struct aes_vector *vec = &cfb_vectors[v];
+
+        job->cipher_direction = ctx->dir;
+        job->chain_order = (ctx->dir == ENCRYPT) ? CIPHER_HASH : HASH_CIPHER;
+        job->cipher_mode = CFB;
+        job->hash_alg = NULL_HASH;
+        job->aes_enc_key_expanded = ctx->enc_keys[v];
+        job->aes_key_len_in_bytes = vec->Klen;
+        job->iv = vec->IV;
+        job->iv_len_in_bytes = 16;
+        job->dst = &ctx->bufs[n * sizeof(CFB_LONG_P)];
+        job->src = (ctx->dir == ENCRYPT) ? vec->P : job->dst;
+        job->cipher_start_src_offset_in_bytes = 0;
+        job->msg_len_to_cipher_in_bytes = vec->Plen;
+}
+
+static int
+cfb_mixed_check_job(const struct JOB_AES_HMAC *job, const int n, void *arg)
+{
+        const struct cfb_mixed_ctx *ctx = arg;
+        const struct aes_vector *vec = &cfb_vectors[n % DIM(cfb_vectors)];
+
+        if (!job_output_ok(n, job->dst,
+                           (ctx->dir == ENCRYPT) ? vec->C : vec->P,
+                           vec->Plen)) {
+                printf("AES-CFB key size %d, length %d mismatched (%s)\n",
+                       (int) vec->Klen * 8, (int) vec->Plen,
+                       (ctx->dir == ENCRYPT) ? "encrypt" : "decrypt");
+                return 0;
+        }
+        return 1;
+}
+
+/*
+ * Submits num_jobs AES-CFB jobs using all test vectors in turn,
+ * so that encryption lanes process messages of different lengths
+ * and key sizes. Encrypts out of place and decrypts in place.
+ */
+static int
+test_cfb_mixed(struct MB_MGR *mb_mgr, const int num_jobs)
+{
+        const unsigned num_vecs = DIM(cfb_vectors);
+        DECLARE_ALIGNED(uint32_t enc_keys[DIM(cfb_vectors)][15*4], 16);
+        DECLARE_ALIGNED(uint32_t dec_keys[15*4], 16);
+        uint8_t *bufs = malloc(num_jobs * sizeof(CFB_LONG_P));
+        struct cfb_mixed_ctx ctx;
+        unsigned i;
+        int dir, ret = 0;
+
+        assert(bufs != NULL);
+
+        for (i = 0; i < num_vecs; i++) {
+                if (cfb_vectors[i].Klen == 16)
+                        IMB_AES_KEYEXP_128(mb_mgr, cfb_vectors[i].K,
+                                           enc_keys[i], dec_keys);
+                else if (cfb_vectors[i].Klen == 24)
+                        IMB_AES_KEYEXP_192(mb_mgr, cfb_vectors[i].K,
+                                           enc_keys[i], dec_keys);
+                else
+                        IMB_AES_KEYEXP_256(mb_mgr, cfb_vectors[i].K,
+                                           enc_keys[i], dec_keys);
+        }
+
+        ctx.enc_keys = enc_keys;
+        ctx.bufs = bufs;
+        for (dir = ENCRYPT; ret == 0 && dir <= DECRYPT; dir++) {
+                ctx.dir = (JOB_CIPHER_DIRECTION) dir;
+                ret = submit_many_jobs(mb_mgr, num_jobs, cfb_mixed_fill_job,
+                                       cfb_mixed_check_job, &ctx);
+        }
+
+        free(bufs);
+        return ret;
+}
+
+static void
+cfb_job(struct JOB_AES_HMAC *job, const struct aes_vector *vec,
+        const void *enc_keys, const JOB_CIPHER_DIRECTION dir,
+        const uint8_t *src, uint8_t *dst, const uint64_t len)
+{
+        memset(job, 0, sizeof(*job));
+        job->cipher_direction = dir;
+        job->chain_order = (dir == ENCRYPT) ? CIPHER_HASH : HASH_CIPHER;
+        job->cipher_mode = CFB;
+        job->hash_alg = NULL_HASH;
+        job->aes_enc_key_expanded = enc_keys;
+        job->aes_dec_key_expanded = NULL;
+        job->aes_key_len_in_bytes = vec->Klen;
+        job->iv = vec->IV;
+        job->iv_len_in_bytes = 16;
+        job->src = src;
+        job->dst = dst;
+        job->msg_len_to_cipher_in_bytes = len;
+}
+
+/*
+ * Flips one ciphertext bit in block 2 and decrypts (with no decryption
+ * key schedule, CFB only uses the forward cipher). The same plaintext
+ * bit must flip, block 3 must be garbled and every other block must
+ * be recovered intact.
+ */
+static int
+test_cfb_bit_error(struct MB_MGR *mb_mgr)
+{
+        const struct aes_vector *vec = &cfb_vectors[7];
+        DECLARE_ALIGNED(uint32_t enc_keys[15*4], 16);
+        DECLARE_ALIGNED(uint32_t dec_keys[15*4], 16);
+        uint8_t ct[sizeof(CFB_LONG_P)];
+        uint8_t pt[sizeof(CFB_LONG_P)];
+        struct JOB_AES_HMAC tmpl;
+        const struct JOB_AES_HMAC *job;
+        const unsigned err_byte = 2 * 16 + 5;
+        const uint8_t err_mask = 0x10;
+        unsigned i;
+
+        IMB_AES_KEYEXP_192(mb_mgr, vec->K, enc_keys, dec_keys);
+
+        cfb_job(&tmpl, vec, enc_keys, ENCRYPT, vec->P, ct, vec->Plen);
+        job = submit_one_job(mb_mgr, &tmpl);
+        if (job->status != STS_COMPLETED ||
+            !job_output_ok(0, ct, vec->C, vec->Plen))
+                return 1;
+
+        ct[err_byte] ^= err_mask;
+        cfb_job(&tmpl, vec, enc_keys, DECRYPT, ct, pt, vec->Plen);
+        job = submit_one_job(mb_mgr, &tmpl);
+        if (job->status != STS_COMPLETED) {
+                printf("AES-CFB decrypt status:%d\n", job->status);
+                return 1;
+        }
+
+        if (pt[err_byte] != (vec->P[err_byte] ^ err_mask)) {
+                printf("AES-CFB bit error not propagated to plaintext\n");
+                return 1;
+        }
+        pt[err_byte] ^= err_mask;
+        if (!memcmp(&pt[3 * 16], &vec->P[3 * 16], 16)) {
+                printf("AES-CFB bit error did not garble next block\n");
+                return 1;
+        }
+        for (i = 0; i < vec->Plen; i++) {
+                if (i / 16 == 3)
+                        continue;
+                if (pt[i] != vec->P[i]) {
+                        printf("AES-CFB bit error spread to byte %u\n", i);
+                        return 1;
+                }
+        }
+        return 0;
+}
+
+/*
+ * Messages shorter than a block are a single XOR with E(IV),
+ * which must match the partial block API used by DOCSIS.
+ */
+static int
+test_cfb_partial_block(struct MB_MGR *mb_mgr)
+{
+        const struct aes_vector *vec = &cfb_vectors[0];
+        DECLARE_ALIGNED(uint32_t enc_keys[11*4], 16);
+        DECLARE_ALIGNED(uint32_t dec_keys[11*4], 16);
+        uint8_t out_job[16];
+        uint8_t out_one[16];
+        struct JOB_AES_HMAC tmpl;
+        const struct JOB_AES_HMAC *job;
+        uint64_t len;
+
+        IMB_AES_KEYEXP_128(mb_mgr, vec->K, enc_keys, dec_keys);
+
+        for (len = 1; len < 16; len++) {
+                memset(out_job, 0xa5, sizeof(out_job));
+                cfb_job(&tmpl, vec, enc_keys, ENCRYPT, vec->P, out_job, len);
+                job = submit_one_job(mb_mgr, &tmpl);
+
+                memset(out_one, 0xa5, sizeof(out_one));
+                IMB_AES128_CFB_ONE(mb_mgr, out_one, vec->P, vec->IV,
+                                   enc_keys, len);
+
+                if (job->status != STS_COMPLETED ||
+                    !job_output_ok((int) len, out_job, out_one,
+                                   sizeof(out_one))) {
+                        printf("AES-CFB partial block length %u mismatched\n",
+                               (unsigned) len);
+                        return 1;
+                }
+        }
+        return 0;
+}
+
+static int
+test_cfb_invalid(struct MB_MGR *mb_mgr)
+{
+        const struct aes_vector *vec = &cfb_vectors[0];
+        DECLARE_ALIGNED(uint32_t enc_keys[11*4], 16);
+        DECLARE_ALIGNED(uint32_t dec_keys[11*4], 16);
+        struct JOB_AES_HMAC tmpl[6];
+        uint8_t dst[64];
+        unsigned i;
+
+        IMB_AES_KEYEXP_128(mb_mgr, vec->K, enc_keys, dec_keys);
+
+        cfb_job(&tmpl[0], vec, enc_keys, ENCRYPT, vec->P, dst, vec->Plen);
+        tmpl[0].aes_key_len_in_bytes = 20;
+        cfb_job(&tmpl[1], vec, enc_keys, ENCRYPT, vec->P, dst, vec->Plen);
+        tmpl[1].iv_len_in_bytes = 12;
+        cfb_job(&tmpl[2], vec, enc_keys, ENCRYPT, vec->P, dst, 0);
+        cfb_job(&tmpl[3], vec, NULL, DECRYPT, vec->C, dst, vec->Plen);
+        cfb_job(&tmpl[4], vec, enc_keys, DECRYPT, vec->C, dst, vec->Plen);
+        tmpl[4].iv = NULL;
+        cfb_job(&tmpl[5], vec, enc_keys, ENCRYPT, vec->P, NULL, vec->Plen);
+
+        for (i = 0; i < DIM(tmpl); i++) {
+                const struct JOB_AES_HMAC *job = submit_one_job(mb_mgr,
+                                                                &tmpl[i]);
+
+                if (job->status != STS_INVALID_ARGS) {
+                        printf("AES-CFB invalid job %u: status:%d\n",
+                               i, job->status);
+                        return 1;
+                }
+        }
+        return 0;
+}
+
+typedef void (*aes_keyexp_mb_t)(const void *const *keys,
+                                void *const *enc_exp_keys,
+                                void *const *dec_exp_keys,
+                                const uint32_t num_keys);
+
+/* up to 2 full batches of 8 keys and a partial one */
+#define KEYEXP_MB_MAX_KEYS 19
+
+static int
+test_aes_keyexp_mb(struct MB_MGR *mb_mgr, const enum arch_type arch)
+{
+        static const unsigned key_lens[] = { 16, 24, 32 };
+        DECLARE_ALIGNED(uint32_t enc[KEYEXP_MB_MAX_KEYS][15*4], 16);
+        DECLARE_ALIGNED(uint32_t dec[KEYEXP_MB_MAX_KEYS][15*4], 16);
+        DECLARE_ALIGNED(uint32_t ref_enc[15*4], 16);
+        DECLARE_ALIGNED(uint32_t ref_dec[15*4], 16);
+        uint8_t keys[KEYEXP_MB_MAX_KEYS][32];
+        const void *key_ptrs[KEYEXP_MB_MAX_KEYS];
+        void *enc_ptrs[KEYEXP_MB_MAX_KEYS];
+        void *dec_ptrs[KEYEXP_MB_MAX_KEYS];
+        aes_keyexp_mb_t keyexp_mb[DIM(key_lens)];
+        unsigned i, k, num;
+        int errors = 0;
+
+        switch (arch) {
+        case ARCH_SSE:
+                keyexp_mb[0] = aes_keyexp_128_mb_sse;
+                keyexp_mb[1] = aes_keyexp_192_mb_sse;
+                keyexp_mb[2] = aes_keyexp_256_mb_sse;
+                break;
+        case ARCH_AVX:
+                keyexp_mb[0] = aes_keyexp_128_mb_avx;
+                keyexp_mb[1] = aes_keyexp_192_mb_avx;
+                keyexp_mb[2] = aes_keyexp_256_mb_avx;
+                break;
+        case ARCH_AVX2:
+                keyexp_mb[0] = aes_keyexp_128_mb_avx2;
+                keyexp_mb[1] = aes_keyexp_192_mb_avx2;
+                keyexp_mb[2] = aes_keyexp_256_mb_avx2;
+                break;
+        case ARCH_AVX512:
+                keyexp_mb[0] = aes_keyexp_128_mb_avx512;
+                keyexp_mb[1] = aes_keyexp_192_mb_avx512;
+                keyexp_mb[2] = aes_keyexp_256_mb_avx512;
+                break;
+        default:
+                /* AES-NI emulation version is not exported */
+                return 0;
+        }
+
+        printf("AES multi-key expansion:\n");
+        for (i = 0; i < KEYEXP_MB_MAX_KEYS; i++) {
+                key_ptrs[i] = keys[i];
+                enc_ptrs[i] = enc[i];
+                dec_ptrs[i] = dec[i];
+        }
+
+        for (k = 0; k < DIM(key_lens); k++) {
+                const size_t sched_len = (key_lens[k] / 4 + 7) * 16;
+
+                for (num = 1; num <= KEYEXP_MB_MAX_KEYS; num++) {
+                        for (i = 0; i < num; i++) {
+                                unsigned j;
+
+                                for (j = 0; j < sizeof(keys[i]); j++)
+                                        keys[i][j] = (uint8_t) rand();
+                        }
+                        memset(enc, 0, sizeof(enc));
+                        memset(dec, 0, sizeof(dec));
+
+                        /* encryption schedules only */
+                        keyexp_mb[k](key_ptrs, enc_ptrs, NULL, num);
+                        for (i = 0; i < num; i++) {
+                                if (key_lens[k] == 16)
+                                        IMB_AES_KEYEXP_128(mb_mgr, keys[i],
+                                                           ref_enc, ref_dec);
+                                else if (key_lens[k] == 24)
+                                        IMB_AES_KEYEXP_192(mb_mgr, keys[i],
+                                                           ref_enc, ref_dec);
+                                else
+                                        IMB_AES_KEYEXP_256(mb_mgr, keys[i],
+                                                           ref_enc, ref_dec);
+                                if (memcmp(enc[i], ref_enc, sched_len) != 0) {
+                                        printf("\nAES-%u multi-key expansion "
+                                               "(%u keys) key %u: "
+                                               "encryption schedule "
+                                               "mismatch\n",
+                                               key_lens[k] * 8, num, i);
+                                        errors++;
+                                }
+                        }
+
+                        /* both schedules */
+                        memset(enc, 0, sizeof(enc));
+                        keyexp_mb[k](key_ptrs, enc_ptrs, dec_ptrs, num);
+                        for (i = 0; i < num; i++) {
+                                if (key_lens[k] == 16)
+                                        IMB_AES_KEYEXP_128(mb_mgr, keys[i],
+                                                           ref_enc, ref_dec);
+                                else if (key_lens[k] == 24)
+                                        IMB_AES_KEYEXP_192(mb_mgr, keys[i],
+                                                           ref_enc, ref_dec);
+                                else
+                                        IMB_AES_KEYEXP_256(mb_mgr, keys[i],
+                                                           ref_enc, ref_dec);
+                                if (memcmp(enc[i], ref_enc, sched_len) != 0 ||
+                                    memcmp(dec[i], ref_dec, sched_len) != 0) {
+                                        printf("\nAES-%u multi-key expansion "
+                                               "(%u keys) key %u: "
+                                               "schedule mismatch\n",
+                                               key_lens[k] * 8, num, i);
+                                        errors++;
+                                }
+                        }
+                        printf(".");
+                }
+        }
+        printf("\n");
+
+        return errors;
+}
+
 int
 aes_test(const enum arch_type arch,
          struct MB_MGR *mb_mgr)
@@ -633,8 +1135,6 @@ aes_test(const enum arch_type arch,
         unsigned i;
         int errors = 0;
 
-        (void) arch; /* unused */
-
         for (i = 0; i < DIM(num_jobs_tab); i++)
                 errors += test_aes_vectors(mb_mgr, DIM(aes_vectors),
                                            aes_vectors,
@@ -647,6 +1147,19 @@ aes_test(const enum arch_type arch,
                                            DOCSIS_SEC_BPI, num_jobs_tab[i]);
         if (!cfb128_validate(mb_mgr))
                 errors++;
+        for (i = 0; i < DIM(num_jobs_tab); i++)
+                errors += test_aes_vectors(mb_mgr, DIM(cfb_vectors),
+                                           cfb_vectors,
+                                           "AES-CFB standard test vectors",
+                                           CFB, num_jobs_tab[i]);
+        printf("AES-CFB mixed length jobs:\n");
+        for (i = 0; i < DIM(num_jobs_tab); i++)
+                errors += test_cfb_mixed(mb_mgr, num_jobs_tab[i] * 3);
+        printf("\n");
+        errors += test_cfb_bit_error(mb_mgr);
+        errors += test_cfb_partial_block(mb_mgr);
+        errors += test_cfb_invalid(mb_mgr);
+        errors += test_aes_keyexp_mb(mb_mgr, arch);
 	if (0 == errors)
 		printf("...Pass\n");
 	else
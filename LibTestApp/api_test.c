@@ -32,6 +32,7 @@
 
 #include <intel-ipsec-mb.h>
 #include "gcm_ctr_vectors_test.h"
+#include "utils.h"
 
 int api_test(const enum arch_type arch, struct MB_MGR *mb_mgr);
 
@@ -601,6 +602,59 @@ test_job_invalid_cipher_args(struct MB_MGR *mb_mgr)
         return 0;
 }
 
+/*
+ * @brief Tests that direct API calls preserve callee-saved registers
+ *
+ * The multi-buffer SHA kernels used by hmac_ipad_opad_mb() clobber
+ * callee-saved registers of the C ABI. Values read before the call are
+ * kept live across it, so with optimization (-O2 and up) the compiler
+ * holds them in callee-saved registers and any corruption shows up.
+ */
+static int
+test_direct_api_regs(struct MB_MGR *mb_mgr)
+{
+        static const JOB_HASH_ALG algs[] = { SHA1, SHA_256, SHA_512 };
+        static volatile uint64_t seed[8] = {
+                0x0123456789abcdefULL, 0x1032547698badcfeULL,
+                0x23016745ab89efcdULL, 0x3210765498bafedcULL,
+                0x45670123cdef89abULL, 0x54761032dcfe98baULL,
+                0x67452301efcdab89ULL, 0x76543210fedcba98ULL
+        };
+        const uint8_t key[16] = { 0 };
+        const void *keys[1] = { key };
+        const uint64_t key_lens[1] = { sizeof(key) };
+        uint8_t ipad_hash[SHA512_DIGEST_SIZE_IN_BYTES];
+        uint8_t opad_hash[SHA512_DIGEST_SIZE_IN_BYTES];
+        void *ipad_ptrs[1] = { ipad_hash };
+        void *opad_ptrs[1] = { opad_hash };
+        unsigned i;
+
+        for (i = 0; i < DIM(algs); i++) {
+                const uint64_t v0 = seed[0], v1 = seed[1];
+                const uint64_t v2 = seed[2], v3 = seed[3];
+                const uint64_t v4 = seed[4], v5 = seed[5];
+                const uint64_t v6 = seed[6], v7 = seed[7];
+                const int ret = IMB_HMAC_IPAD_OPAD_MB(mb_mgr, algs[i], keys,
+                                                      key_lens, ipad_ptrs,
+                                                      opad_ptrs, 1);
+
+                if (ret != 0) {
+                        printf("%s: hash_alg %d returned %d\n",
+                               __func__, (int) algs[i], ret);
+                        return 1;
+                }
+                if (v0 != seed[0] || v1 != seed[1] ||
+                    v2 != seed[2] || v3 != seed[3] ||
+                    v4 != seed[4] || v5 != seed[5] ||
+                    v6 != seed[6] || v7 != seed[7]) {
+                        printf("%s: hash_alg %d corrupted registers\n",
+                               __func__, (int) algs[i]);
+                        return 1;
+                }
+        }
+        return 0;
+}
+
 int
 api_test(const enum arch_type arch, struct MB_MGR *mb_mgr)
 {
@@ -611,6 +665,7 @@ api_test(const enum arch_type arch, struct MB_MGR *mb_mgr)
         errors += test_job_api(mb_mgr);
         errors += test_job_invalid_mac_args(mb_mgr);
         errors += test_job_invalid_cipher_args(mb_mgr);
+        errors += test_direct_api_regs(mb_mgr);
 
 	if (0 == errors)
 		printf("...Pass\n");
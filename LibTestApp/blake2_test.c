@@ -0,0 +1,536 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include <intel-ipsec-mb.h>
+
+#include "gcm_ctr_vectors_test.h"
+#include "utils.h"
+
+int blake2_test(const enum arch_type arch, struct MB_MGR *mb_mgr);
+
+#define BLAKE2_TEST_MAX_MSG_LEN 1000
+#define BLAKE2_TEST_MAX_TAG_LEN BLAKE2B_MAX_DIGEST_SIZE
+
+struct blake2_vector {
+        JOB_HASH_ALG hash_alg;
+        uint64_t msg_len;       /* message is blake2_msg[0 ... msg_len - 1] */
+        uint64_t key_len;       /* key is blake2_key[0 ... key_len - 1] */
+        const uint8_t *tag;     /* expected digest */
+        uint64_t tag_len;
+};
+
+/*
+ * Expected values computed with an independent implementation
+ * (Python hashlib module) for message bytes (7 * i + 1) mod 256
+ * and key bytes (3 * i + 0x11) mod 256.
+ */
+static const uint8_t BLAKE2_TAG1[] = {
+        0x78, 0x6a, 0x02, 0xf7, 0x42, 0x01, 0x59, 0x03,
+        0xc6, 0xc6, 0xfd, 0x85, 0x25, 0x52, 0xd2, 0x72,
+        0x91, 0x2f, 0x47, 0x40, 0xe1, 0x58, 0x47, 0x61,
+        0x8a, 0x86, 0xe2, 0x17, 0xf7, 0x1f, 0x54, 0x19,
+        0xd2, 0x5e, 0x10, 0x31, 0xaf, 0xee, 0x58, 0x53,
+        0x13, 0x89, 0x64, 0x44, 0x93, 0x4e, 0xb0, 0x4b,
+        0x90, 0x3a, 0x68, 0x5b, 0x14, 0x48, 0xb7, 0x55,
+        0xd5, 0x6f, 0x70, 0x1a, 0xfe, 0x9b, 0xe2, 0xce
+};
+
+static const uint8_t BLAKE2_TAG2[] = {
+        0x46, 0x26, 0x59, 0x0f, 0xff, 0x3d, 0x43, 0xa3,
+        0x82, 0x76, 0xd9, 0xe6, 0xf8, 0x7b, 0x5a, 0x3c,
+        0x2f, 0x65, 0x44, 0x90, 0x36, 0x9d, 0x1e, 0x14,
+        0xa2, 0x4f, 0x90, 0x94, 0xff, 0x1e, 0x83, 0x41,
+        0x54, 0x0c, 0x7f, 0xdf, 0x1f, 0x5a, 0xa0, 0x65,
+        0x2c, 0x56, 0x5c, 0xf7, 0x6b, 0x7b, 0xba, 0x22,
+        0x79, 0x9d, 0x3b, 0x89, 0x2d, 0x4a, 0x18, 0x73,
+        0x03, 0xd9, 0xef, 0x4c, 0x41, 0x93, 0xc2, 0x4a
+};
+
+static const uint8_t BLAKE2_TAG3[] = {
+        0xd0, 0x73, 0xfb, 0x32, 0x59, 0xc7, 0x23, 0xb2,
+        0x0a, 0x64, 0xec, 0xf7, 0x70, 0x83, 0x89, 0x1a,
+        0x15, 0x7c, 0x81, 0xc1, 0x88, 0x2d, 0xa4, 0x20,
+        0x60, 0x22, 0x2d, 0xfc, 0x7e, 0xbb, 0xda, 0x6d,
+        0xa1, 0xb8, 0xed, 0x55, 0x19, 0x7a, 0xab, 0xd0,
+        0xab, 0x17, 0xcf, 0x93, 0x54, 0x99, 0xd8, 0xe4,
+        0xf6, 0xd9, 0x3a, 0x4b, 0xb8, 0x3a, 0x1a, 0xa5,
+        0x67, 0x0a, 0x16, 0x12, 0xc7, 0x0d, 0xf1, 0xbb
+};
+
+static const uint8_t BLAKE2_TAG4[] = {
+        0xc6, 0xd3, 0x75, 0xfd, 0x44, 0x21, 0x51, 0x04,
+        0x89, 0x19, 0x4b, 0x8c, 0xcd, 0x9b, 0x1f, 0xc9,
+        0xe9, 0x6d, 0xd2, 0x5e, 0xab, 0x56, 0xf3, 0x3b,
+        0xd6, 0x98, 0x26, 0x6f, 0xb3, 0x8d, 0x8f, 0xbd,
+        0xe4, 0x47, 0xb6, 0x17, 0xcd, 0xb5, 0x77, 0x9c,
+        0x5f, 0xbe, 0xaf, 0xe5, 0x3f, 0xae, 0x64, 0x0c,
+        0x85, 0xc4, 0x57, 0xf6, 0x44, 0x9c, 0xe3, 0x07,
+        0xa1, 0x1d, 0x88, 0xd1, 0x87, 0x88, 0xd7, 0xf0
+};
+
+static const uint8_t BLAKE2_TAG5[] = {
+        0x52, 0x4a, 0x9d, 0xc9, 0xd0, 0x08, 0xa9, 0xce,
+        0x1d, 0x9d, 0x2a, 0x11, 0x1b, 0xcd, 0x10, 0xd2,
+        0x46, 0x1a, 0x02, 0xda, 0xdf, 0x30, 0xec, 0x5a,
+        0x47, 0x22, 0x55, 0x01, 0x60, 0x8a, 0x87, 0xeb
+};
+
+static const uint8_t BLAKE2_TAG6[] = {
+        0x02, 0x04, 0x2f, 0x39, 0x25, 0x99, 0xf1, 0xcd,
+        0xed, 0xc7, 0xd7, 0xb8, 0xd0, 0xd3, 0xab, 0xc0,
+        0xaf, 0x1b, 0xf8, 0xeb
+};
+
+static const uint8_t BLAKE2_TAG7[] = {
+        0x4b, 0x22, 0x4d, 0xa8, 0xbd, 0x3b, 0xfe, 0xec,
+        0xa3, 0x96, 0x9a, 0x38, 0x26, 0x9e, 0xfc, 0xe8,
+        0x2e, 0xa8, 0x10, 0x0d, 0x95, 0xa2, 0xb9, 0xc4,
+        0x2e, 0x28, 0x62, 0x03, 0x25, 0x9c, 0x93, 0x4d,
+        0xd2, 0xac, 0x7e, 0xc3, 0x81, 0xaf, 0x4b, 0xc7,
+        0x10, 0x13, 0xee, 0xd1, 0x0a, 0xb5, 0x22, 0x1d,
+        0x56, 0x69, 0x17, 0x12, 0xa6, 0x6f, 0x3f, 0x1a,
+        0xd2, 0xfb, 0x30, 0xc4, 0x70, 0xb3, 0xda, 0x33
+};
+
+static const uint8_t BLAKE2_TAG8[] = {
+        0x69, 0x21, 0x7a, 0x30, 0x79, 0x90, 0x80, 0x94,
+        0xe1, 0x11, 0x21, 0xd0, 0x42, 0x35, 0x4a, 0x7c,
+        0x1f, 0x55, 0xb6, 0x48, 0x2c, 0xa1, 0xa5, 0x1e,
+        0x1b, 0x25, 0x0d, 0xfd, 0x1e, 0xd0, 0xee, 0xf9
+};
+
+static const uint8_t BLAKE2_TAG9[] = {
+        0x1e, 0xb5, 0x1f, 0x77, 0x9a, 0x72, 0x30, 0x2e,
+        0x5f, 0xef, 0xda, 0x03, 0x27, 0x0f, 0xda, 0x3d,
+        0x9b, 0xf0, 0x2c, 0xfd, 0xcd, 0x0a, 0x50, 0xd1,
+        0x0e, 0x52, 0xc6, 0xe6, 0xfa, 0xfb, 0xd4, 0xea
+};
+
+static const uint8_t BLAKE2_TAG10[] = {
+        0x1a, 0xa2, 0xab, 0xc4, 0x87, 0x84, 0xc4, 0xb7,
+        0xb5, 0x09, 0xe5, 0x65, 0x40, 0xcc, 0xde, 0x67,
+        0x29, 0x03, 0xc6, 0x13, 0xc7, 0xaa, 0x32, 0xc1,
+        0x39, 0x6e, 0x10, 0xd7, 0x16, 0x35, 0x1d, 0xfe
+};
+
+static const uint8_t BLAKE2_TAG11[] = {
+        0xf5, 0x60, 0x92, 0x65, 0xb9, 0x3d, 0xa4, 0x57,
+        0x08, 0x6e, 0x60, 0x15, 0xa3, 0x47, 0xfc, 0xc4
+};
+
+static const uint8_t BLAKE2_TAG12[] = {
+        0x62, 0xb0, 0x88, 0x5e, 0xa8, 0xf0, 0x0f, 0x68,
+        0xfd, 0xe2, 0x39, 0x2b, 0xa5, 0xb0, 0xef, 0xdb,
+        0xcd, 0x38, 0xa5, 0x23, 0xb3, 0xb2, 0x31, 0x36,
+        0x23, 0x2b, 0x99, 0x5e, 0x0d, 0x1c, 0x46, 0xc3
+};
+
+static const uint8_t BLAKE2_TAG13[] = {
+        0x03, 0xa4, 0xe7, 0x53, 0xee, 0xd5, 0x58, 0x4c,
+        0x19, 0xcd, 0x31, 0x0a, 0xd9, 0xaa, 0xc9, 0xe1,
+        0x5b, 0x57, 0x8a, 0x6b, 0x11, 0xd5, 0x4e, 0xd1,
+        0x3f, 0x08, 0xbe, 0xaf, 0x20, 0xd0, 0x63, 0xbd,
+        0x6f, 0x86, 0x3a, 0xba, 0x35, 0xdb, 0x08, 0x3f,
+        0x47, 0x6c, 0xaf, 0x47, 0x18, 0x6b, 0x96, 0xc9,
+        0x04, 0x42, 0xe2, 0xd6, 0xb8, 0x8c, 0x64, 0xb6,
+        0x90, 0x05, 0xf0, 0x1a, 0x7e, 0xd0, 0xa7, 0x24
+};
+
+static const uint8_t BLAKE2_TAG14[] = {
+        0x3b, 0xdc, 0x5b, 0x15, 0x62, 0xac, 0x5f, 0x40,
+        0xde, 0xff, 0xa7, 0x84, 0xc5, 0xd0, 0x3b, 0x57,
+        0xe2, 0x65, 0x95, 0x5f, 0x7f, 0xaf, 0xec, 0xb5,
+        0xf9, 0xfb, 0x07, 0xb3, 0x8d, 0x22, 0x6a, 0xe1,
+        0xe8, 0x04, 0x10, 0x86, 0x05, 0xee, 0x26, 0xec,
+        0x50, 0x3f, 0x53, 0xaa, 0x57, 0x03, 0x71, 0x05,
+        0x37, 0x42, 0x57, 0x7e, 0x07, 0x17, 0x66, 0x5f,
+        0xe2, 0x08, 0x4f, 0x2c, 0xe6, 0xb4, 0x94, 0xaf
+};
+
+static const uint8_t BLAKE2_TAG15[] = {
+        0xc4, 0xad, 0x5f, 0x42, 0x54, 0xbd, 0xcd, 0xa5,
+        0x8c, 0xb3, 0x0b, 0x1c, 0xf8, 0x65, 0x1c, 0xe2
+};
+
+static const uint8_t BLAKE2_TAG16[] = {
+        0x28, 0xf6, 0xe0, 0x1e, 0x46, 0x0e, 0x36, 0x24,
+        0xd4, 0xd0, 0xc6, 0x8c, 0x45, 0xf7, 0x91, 0xd9,
+        0x6e, 0xa8, 0x56, 0x17, 0x7a, 0x58, 0x6c, 0x4b,
+        0x07, 0x5b, 0x49, 0x8f, 0x79, 0xf9, 0xe7, 0xff
+};
+
+static const uint8_t BLAKE2_TAG17[] = {
+        0x05, 0x75, 0x9c, 0x06, 0x57, 0xac, 0xd8, 0xea,
+        0xb2, 0xb2, 0x57, 0xc2, 0x2d, 0xfd, 0xa9, 0x42,
+        0xc9, 0x80, 0x8e, 0x57, 0xa0, 0x16, 0x3f, 0x5c,
+        0xba, 0x04, 0xe8, 0x2f, 0x95, 0xe0, 0x51, 0x63
+};
+
+static const uint8_t BLAKE2_TAG18[] = {
+        0x00, 0x44, 0x20, 0x83, 0x97, 0x8d, 0xb8, 0x5f,
+        0x54, 0xc7, 0x09, 0x36, 0x9f, 0xbc, 0xc9, 0x4c,
+        0xf5, 0xb6, 0xdf, 0xf2, 0xed, 0xac, 0x6b, 0x6a,
+        0x96, 0xfb, 0x03, 0x64, 0x21, 0x9c, 0xc8, 0x21
+};
+
+static const uint8_t BLAKE2_TAG19[] = {
+        0xe7, 0x44, 0x0b, 0xb3, 0xd1, 0xcc, 0x0c, 0x79,
+        0x39, 0x89, 0xa3, 0xa1, 0x7b, 0xcf, 0x25, 0xc5,
+        0xc1, 0xa2, 0xbe, 0x68
+};
+
+static const struct blake2_vector blake2_vectors[] = {
+        { PLAIN_BLAKE2B, 0, 0, BLAKE2_TAG1, 64 },
+        { PLAIN_BLAKE2B, 3, 0, BLAKE2_TAG2, 64 },
+        { PLAIN_BLAKE2B, 127, 0, BLAKE2_TAG3, 64 },
+        { PLAIN_BLAKE2B, 128, 0, BLAKE2_TAG4, 64 },
+        { PLAIN_BLAKE2B, 129, 0, BLAKE2_TAG5, 32 },
+        { PLAIN_BLAKE2B, 256, 0, BLAKE2_TAG6, 20 },
+        { PLAIN_BLAKE2B, 1000, 0, BLAKE2_TAG7, 64 },
+        { PLAIN_BLAKE2S, 0, 0, BLAKE2_TAG8, 32 },
+        { PLAIN_BLAKE2S, 63, 0, BLAKE2_TAG9, 32 },
+        { PLAIN_BLAKE2S, 64, 0, BLAKE2_TAG10, 32 },
+        { PLAIN_BLAKE2S, 65, 0, BLAKE2_TAG11, 16 },
+        { PLAIN_BLAKE2S, 1000, 0, BLAKE2_TAG12, 32 },
+        { BLAKE2B_KEYED, 0, 64, BLAKE2_TAG13, 64 },
+        { BLAKE2B_KEYED, 128, 1, BLAKE2_TAG14, 64 },
+        { BLAKE2B_KEYED, 129, 32, BLAKE2_TAG15, 16 },
+        { BLAKE2B_KEYED, 700, 64, BLAKE2_TAG16, 32 },
+        { BLAKE2S_KEYED, 0, 32, BLAKE2_TAG17, 32 },
+        { BLAKE2S_KEYED, 64, 16, BLAKE2_TAG18, 32 },
+        { BLAKE2S_KEYED, 500, 7, BLAKE2_TAG19, 20 },
+};
+
+/* RFC 7693 Appendix A and B: BLAKE2b-512 and BLAKE2s-256 of "abc" */
+static const uint8_t BLAKE2B_ABC[] = {
+        0xba, 0x80, 0xa5, 0x3f, 0x98, 0x1c, 0x4d, 0x0d,
+        0x6a, 0x27, 0x97, 0xb6, 0x9f, 0x12, 0xf6, 0xe9,
+        0x4c, 0x21, 0x2f, 0x14, 0x68, 0x5a, 0xc4, 0xb7,
+        0x4b, 0x12, 0xbb, 0x6f, 0xdb, 0xff, 0xa2, 0xd1,
+        0x7d, 0x87, 0xc5, 0x39, 0x2a, 0xab, 0x79, 0x2d,
+        0xc2, 0x52, 0xd5, 0xde, 0x45, 0x33, 0xcc, 0x95,
+        0x18, 0xd3, 0x8a, 0xa8, 0xdb, 0xf1, 0x92, 0x5a,
+        0xb9, 0x23, 0x86, 0xed, 0xd4, 0x00, 0x99, 0x23
+};
+
+static const uint8_t BLAKE2S_ABC[] = {
+        0x50, 0x8c, 0x5e, 0x8c, 0x32, 0x7c, 0x14, 0xe2,
+        0xe1, 0xa7, 0x2b, 0xa3, 0x4e, 0xeb, 0x45, 0x2f,
+        0x37, 0x45, 0x8b, 0x20, 0x9e, 0xd6, 0x3a, 0x29,
+        0x4d, 0x99, 0x9b, 0x4c, 0x86, 0x67, 0x59, 0x82
+};
+
+/*
+ * Reference keyed test vectors (blake2-kat.txt): key bytes 0, 1, 2 ...
+ * of the maximum key length, message bytes 0, 1, 2 ... of 0 and 255 byte
+ * length.
+ */
+static const uint8_t BLAKE2B_KAT0[] = {
+        0x10, 0xeb, 0xb6, 0x77, 0x00, 0xb1, 0x86, 0x8e,
+        0xfb, 0x44, 0x17, 0x98, 0x7a, 0xcf, 0x46, 0x90,
+        0xae, 0x9d, 0x97, 0x2f, 0xb7, 0xa5, 0x90, 0xc2,
+        0xf0, 0x28, 0x71, 0x79, 0x9a, 0xaa, 0x47, 0x86,
+        0xb5, 0xe9, 0x96, 0xe8, 0xf0, 0xf4, 0xeb, 0x98,
+        0x1f, 0xc2, 0x14, 0xb0, 0x05, 0xf4, 0x2d, 0x2f,
+        0xf4, 0x23, 0x34, 0x99, 0x39, 0x16, 0x53, 0xdf,
+        0x7a, 0xef, 0xcb, 0xc1, 0x3f, 0xc5, 0x15, 0x68
+};
+
+static const uint8_t BLAKE2B_KAT255[] = {
+        0x14, 0x27, 0x09, 0xd6, 0x2e, 0x28, 0xfc, 0xcc,
+        0xd0, 0xaf, 0x97, 0xfa, 0xd0, 0xf8, 0x46, 0x5b,
+        0x97, 0x1e, 0x82, 0x20, 0x1d, 0xc5, 0x10, 0x70,
+        0xfa, 0xa0, 0x37, 0x2a, 0xa4, 0x3e, 0x92, 0x48,
+        0x4b, 0xe1, 0xc1, 0xe7, 0x3b, 0xa1, 0x09, 0x06,
+        0xd5, 0xd1, 0x85, 0x3d, 0xb6, 0xa4, 0x10, 0x6e,
+        0x0a, 0x7b, 0xf9, 0x80, 0x0d, 0x37, 0x3d, 0x6d,
+        0xee, 0x2d, 0x46, 0xd6, 0x2e, 0xf2, 0xa4, 0x61
+};
+
+static const uint8_t BLAKE2S_KAT0[] = {
+        0x48, 0xa8, 0x99, 0x7d, 0xa4, 0x07, 0x87, 0x6b,
+        0x3d, 0x79, 0xc0, 0xd9, 0x23, 0x25, 0xad, 0x3b,
+        0x89, 0xcb, 0xb7, 0x54, 0xd8, 0x6a, 0xb7, 0x1a,
+        0xee, 0x04, 0x7a, 0xd3, 0x45, 0xfd, 0x2c, 0x49
+};
+
+static const uint8_t BLAKE2S_KAT255[] = {
+        0x3f, 0xb7, 0x35, 0x06, 0x1a, 0xbc, 0x51, 0x9d,
+        0xfe, 0x97, 0x9e, 0x54, 0xc1, 0xee, 0x5b, 0xfa,
+        0xd0, 0xa9, 0xd8, 0x58, 0xb3, 0x31, 0x5b, 0xad,
+        0x34, 0xbd, 0xe9, 0x99, 0xef, 0xd7, 0x24, 0xdd
+};
+
+/* bytes 0, 1, 2 ... of reference messages and keys */
+static uint8_t blake2_seq[255];
+
+static const struct {
+        JOB_HASH_ALG hash_alg;
+        const uint8_t *msg;
+        uint64_t msg_len;
+        uint64_t key_len;       /* key is blake2_seq, 0 for no key */
+        const uint8_t *tag;
+        uint64_t tag_len;
+} blake2_ref_vectors[] = {
+        { PLAIN_BLAKE2B, (const uint8_t *) "abc", 3, 0,
+          BLAKE2B_ABC, sizeof(BLAKE2B_ABC) },
+        { PLAIN_BLAKE2S, (const uint8_t *) "abc", 3, 0,
+          BLAKE2S_ABC, sizeof(BLAKE2S_ABC) },
+        { BLAKE2B_KEYED, blake2_seq, 0, BLAKE2B_MAX_KEY_SIZE,
+          BLAKE2B_KAT0, sizeof(BLAKE2B_KAT0) },
+        { BLAKE2B_KEYED, blake2_seq, 255, BLAKE2B_MAX_KEY_SIZE,
+          BLAKE2B_KAT255, sizeof(BLAKE2B_KAT255) },
+        { BLAKE2S_KEYED, blake2_seq, 0, BLAKE2S_MAX_KEY_SIZE,
+          BLAKE2S_KAT0, sizeof(BLAKE2S_KAT0) },
+        { BLAKE2S_KEYED, blake2_seq, 255, BLAKE2S_MAX_KEY_SIZE,
+          BLAKE2S_KAT255, sizeof(BLAKE2S_KAT255) },
+};
+
+static uint8_t blake2_msg[BLAKE2_TEST_MAX_MSG_LEN];
+static uint8_t blake2_key[BLAKE2B_MAX_KEY_SIZE];
+
+static void
+blake2_fill_job(struct JOB_AES_HMAC *job, const int n, void *arg)
+{
+        uint8_t *tags = arg;
+        const struct blake2_vector *vec =
+                &blake2_vectors[n % DIM(blake2_vectors)];
+
+        job->cipher_direction = ENCRYPT;
+        job->chain_order = HASH_CIPHER;
+        job->cipher_mode = NULL_CIPHER;
+        job->hash_alg = vec->hash_alg;
+        job->u.BLAKE2._key = blake2_key;
+        job->u.BLAKE2._key_len_in_bytes = vec->key_len;
+        job->src = blake2_msg;
+        job->hash_start_src_offset_in_bytes = 0;
+        job->msg_len_to_hash_in_bytes = vec->msg_len;
+        job->auth_tag_output = &tags[n * (BLAKE2_TEST_MAX_TAG_LEN + 1)];
+        job->auth_tag_output_len_in_bytes = vec->tag_len;
+}
+
+static int
+blake2_check_job(const struct JOB_AES_HMAC *job, const int n, void *arg)
+{
+        const struct blake2_vector *vec =
+                &blake2_vectors[n % DIM(blake2_vectors)];
+        const uint8_t *tag = job->auth_tag_output;
+
+        (void) arg;
+        if (!job_output_ok(n, tag, vec->tag, vec->tag_len)) {
+                printf("hash_alg %d mismatched\n", (int) vec->hash_alg);
+                return 0;
+        }
+        /* nothing written past the tag */
+        if (tag[vec->tag_len] != 0xff) {
+                printf("hash_alg %d, job %d overwrite\n",
+                       (int) vec->hash_alg, n);
+                return 0;
+        }
+        return 1;
+}
+
+/*
+ * Submits num_jobs jobs using test vectors in turn, so that lanes
+ * process messages of different lengths, with and without a key.
+ */
+static int
+test_blake2_many(struct MB_MGR *mb_mgr, const int num_jobs)
+{
+        uint8_t *tags = malloc(num_jobs * (BLAKE2_TEST_MAX_TAG_LEN + 1));
+        int ret;
+
+        assert(tags != NULL);
+        memset(tags, -1, num_jobs * (BLAKE2_TEST_MAX_TAG_LEN + 1));
+
+        ret = submit_many_jobs(mb_mgr, num_jobs, blake2_fill_job,
+                               blake2_check_job, tags);
+
+        free(tags);
+        return ret;
+}
+
+/* sets up a BLAKE2 job, key_len of 0 for plain BLAKE2 */
+static void
+blake2_job(struct JOB_AES_HMAC *job, const JOB_HASH_ALG hash_alg,
+           const uint8_t *msg, const uint64_t msg_len, const uint8_t *key,
+           const uint64_t key_len, uint8_t *tag, const uint64_t tag_len)
+{
+        memset(job, 0, sizeof(*job));
+        job->cipher_direction = ENCRYPT;
+        job->chain_order = HASH_CIPHER;
+        job->cipher_mode = NULL_CIPHER;
+        job->hash_alg = hash_alg;
+        job->u.BLAKE2._key = key;
+        job->u.BLAKE2._key_len_in_bytes = key_len;
+        job->src = msg;
+        job->msg_len_to_hash_in_bytes = msg_len;
+        job->auth_tag_output = tag;
+        job->auth_tag_output_len_in_bytes = tag_len;
+}
+
+static int
+test_blake2_ref(struct MB_MGR *mb_mgr)
+{
+        struct JOB_AES_HMAC tmpl;
+        unsigned i;
+
+        for (i = 0; i < sizeof(blake2_seq); i++)
+                blake2_seq[i] = (uint8_t) i;
+
+        for (i = 0; i < DIM(blake2_ref_vectors); i++) {
+                uint8_t tag[BLAKE2B_MAX_DIGEST_SIZE];
+                const struct JOB_AES_HMAC *job;
+
+                blake2_job(&tmpl, blake2_ref_vectors[i].hash_alg,
+                           blake2_ref_vectors[i].msg,
+                           blake2_ref_vectors[i].msg_len, blake2_seq,
+                           blake2_ref_vectors[i].key_len, tag,
+                           blake2_ref_vectors[i].tag_len);
+                job = submit_one_job(mb_mgr, &tmpl);
+                if (job->status != STS_COMPLETED ||
+                    !job_output_ok((int) i, tag, blake2_ref_vectors[i].tag,
+                                   blake2_ref_vectors[i].tag_len)) {
+                        printf("BLAKE2 reference vector %u failed\n", i + 1);
+                        return 1;
+                }
+        }
+        return 0;
+}
+
+/*
+ * Digest length is a BLAKE2 parameter (it goes into the initial state),
+ * so a short digest is not a truncated full length one.
+ */
+static int
+test_blake2_digest_len(struct MB_MGR *mb_mgr)
+{
+        static const struct {
+                JOB_HASH_ALG hash_alg;
+                uint64_t max_len;
+        } algs[] = {
+                { PLAIN_BLAKE2B, BLAKE2B_MAX_DIGEST_SIZE },
+                { PLAIN_BLAKE2S, BLAKE2S_MAX_DIGEST_SIZE },
+        };
+        struct JOB_AES_HMAC tmpl;
+        unsigned i;
+
+        for (i = 0; i < DIM(algs); i++) {
+                uint8_t full[BLAKE2B_MAX_DIGEST_SIZE];
+                uint8_t half[BLAKE2B_MAX_DIGEST_SIZE];
+                const struct JOB_AES_HMAC *job;
+
+                blake2_job(&tmpl, algs[i].hash_alg, blake2_msg, 100, NULL, 0,
+                           full, algs[i].max_len);
+                job = submit_one_job(mb_mgr, &tmpl);
+                if (job->status != STS_COMPLETED)
+                        return 1;
+
+                blake2_job(&tmpl, algs[i].hash_alg, blake2_msg, 100, NULL, 0,
+                           half, algs[i].max_len / 2);
+                job = submit_one_job(mb_mgr, &tmpl);
+                if (job->status != STS_COMPLETED ||
+                    !memcmp(full, half, algs[i].max_len / 2)) {
+                        printf("hash_alg %d: short digest is truncated\n",
+                               (int) algs[i].hash_alg);
+                        return 1;
+                }
+        }
+        return 0;
+}
+
+/* digest and key lengths out of BLAKE2b/BLAKE2s limits */
+static int
+test_blake2_invalid(struct MB_MGR *mb_mgr)
+{
+        struct JOB_AES_HMAC tmpl[7];
+        uint8_t tag[BLAKE2B_MAX_DIGEST_SIZE + 1];
+        unsigned i;
+
+        blake2_job(&tmpl[0], PLAIN_BLAKE2B, blake2_msg, 3, NULL, 0, tag, 0);
+        blake2_job(&tmpl[1], PLAIN_BLAKE2B, blake2_msg, 3, NULL, 0, tag,
+                   BLAKE2B_MAX_DIGEST_SIZE + 1);
+        blake2_job(&tmpl[2], PLAIN_BLAKE2S, blake2_msg, 3, NULL, 0, tag,
+                   BLAKE2S_MAX_DIGEST_SIZE + 1);
+        blake2_job(&tmpl[3], BLAKE2B_KEYED, blake2_msg, 3, blake2_key, 0,
+                   tag, BLAKE2B_MAX_DIGEST_SIZE);
+        blake2_job(&tmpl[4], BLAKE2B_KEYED, blake2_msg, 3, blake2_key,
+                   BLAKE2B_MAX_KEY_SIZE + 1, tag, BLAKE2B_MAX_DIGEST_SIZE);
+        blake2_job(&tmpl[5], BLAKE2S_KEYED, blake2_msg, 3, blake2_key,
+                   BLAKE2S_MAX_KEY_SIZE + 1, tag, BLAKE2S_MAX_DIGEST_SIZE);
+        blake2_job(&tmpl[6], BLAKE2S_KEYED, blake2_msg, 3, NULL,
+                   BLAKE2S_MAX_KEY_SIZE, tag, BLAKE2S_MAX_DIGEST_SIZE);
+
+        for (i = 0; i < DIM(tmpl); i++) {
+                const struct JOB_AES_HMAC *job = submit_one_job(mb_mgr,
+                                                                &tmpl[i]);
+
+                if (job->status != STS_INVALID_ARGS) {
+                        printf("BLAKE2 invalid job %u: status:%d\n",
+                               i, job->status);
+                        return 1;
+                }
+        }
+        return 0;
+}
+
+int
+blake2_test(const enum arch_type arch, struct MB_MGR *mb_mgr)
+{
+        const int num_jobs_tab[] = {
+                1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 19, 33, 38, 100
+        };
+        unsigned i;
+        int errors = 0;
+
+        (void) arch; /* unused */
+
+        for (i = 0; i < sizeof(blake2_msg); i++)
+                blake2_msg[i] = (uint8_t) (i * 7 + 1);
+        for (i = 0; i < sizeof(blake2_key); i++)
+                blake2_key[i] = (uint8_t) (i * 3 + 0x11);
+
+        printf("BLAKE2 test vectors:\n");
+        for (i = 0; i < DIM(num_jobs_tab); i++)
+                errors += test_blake2_many(mb_mgr, num_jobs_tab[i]);
+        errors += test_blake2_ref(mb_mgr);
+        errors += test_blake2_digest_len(mb_mgr);
+        errors += test_blake2_invalid(mb_mgr);
+
+	if (0 == errors)
+		printf("...Pass\n");
+	else
+		printf("...Fail\n");
+
+	return errors;
+}
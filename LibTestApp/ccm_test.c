@@ -1451,6 +1451,265 @@ static const uint8_t packet_out_106[] = {
 #define clear_len_106 0
 #define auth_len_106  4
 
+/*
+ * Additional AES-CCM-128 test vectors with AAD longer than
+ * 14 bytes (doesn't fit into the 1st AAD block) and 46 bytes
+ * (3 blocks), generated with OpenSSL
+ */
+static const uint8_t keys_107[] = {
+        0x71, 0x47, 0x1D, 0x94, 0xEC, 0x89, 0x93, 0xC7,
+        0x44, 0xBC, 0xD8, 0xCF, 0xCB, 0x3C, 0xC5, 0xA6
+};
+static const uint8_t nonce_107[] = {
+        0x68, 0x19, 0xA8, 0xE6, 0xCA, 0xA4, 0xE2, 0x3B,
+        0x69, 0xBD, 0x41, 0x89, 0x41
+};
+static const uint8_t packet_in_107[] = {
+        0xDA, 0x1E, 0xDC, 0x4E, 0xD8, 0x36, 0x13, 0xC6,
+        0x82, 0x49, 0x4C, 0x19, 0xE2, 0x74, 0x0E, 0xA9,
+        0x4A, 0x4F, 0x39, 0x49, 0x20, 0xC6, 0xAE, 0x77,
+        0x6D, 0xB8, 0xBE, 0x59, 0x25, 0x51, 0x54
+};
+static const uint8_t packet_out_107[] = {
+        0xDA, 0x1E, 0xDC, 0x4E, 0xD8, 0x36, 0x13, 0xC6,
+        0x82, 0x49, 0x4C, 0x19, 0xE2, 0x74, 0x0E, 0x32,
+        0xEF, 0x4D, 0xE0, 0xFC, 0x7C, 0x21, 0xE6, 0x6E,
+        0x39, 0xB1, 0x06, 0x88, 0x1A, 0x53, 0xA9, 0x29,
+        0xE0, 0xA6, 0xD9, 0xDE, 0xF2, 0x60, 0x2E
+};
+#define clear_len_107 15
+#define auth_len_107 8
+
+static const uint8_t keys_108[] = {
+        0x7A, 0x34, 0x28, 0xE1, 0x41, 0x4D, 0x18, 0x0A,
+        0x35, 0x71, 0xDE, 0x14, 0xF2, 0x41, 0x77, 0x0B
+};
+static const uint8_t nonce_108[] = {
+        0xEA, 0x05, 0x37, 0xB5, 0xDD, 0x78, 0xA9, 0x3A,
+        0x16, 0x59, 0x2A, 0x90, 0x6B
+};
+static const uint8_t packet_in_108[] = {
+        0xB2, 0x44, 0xA8, 0xF2, 0xE6, 0xCB, 0x5A, 0x83,
+        0x7E, 0xBA, 0x11, 0xF2, 0xB0, 0xCB, 0x36, 0x09,
+        0xB3, 0xD8, 0x5E, 0x48, 0xC5, 0xF4, 0x32, 0x5C,
+        0xF8, 0x48, 0x22, 0x5F, 0xC0, 0xAF, 0xC9, 0xD5,
+        0x3E, 0x11, 0x1E, 0x62, 0x4A, 0x80, 0x60, 0x4D,
+        0x43, 0x14, 0xC0, 0xB5, 0x96, 0x87, 0xCB, 0x95,
+        0x0F, 0x8F, 0x9E, 0x79, 0xE2, 0xFF, 0xC8, 0xFD,
+        0x78, 0x9C, 0xFD, 0x0A, 0xFB, 0xC0, 0x80, 0xD0,
+        0xA0, 0xB1, 0x4E, 0x83, 0xB7, 0xBE, 0x0B, 0xD5,
+        0x74, 0x1F, 0xAE, 0x36, 0x7B, 0x8A, 0xEB, 0xCE
+};
+static const uint8_t packet_out_108[] = {
+        0xB2, 0x44, 0xA8, 0xF2, 0xE6, 0xCB, 0x5A, 0x83,
+        0x7E, 0xBA, 0x11, 0xF2, 0xB0, 0xCB, 0x36, 0x09,
+        0xB3, 0xD8, 0x5E, 0x48, 0xC5, 0xF4, 0x32, 0x5C,
+        0xF8, 0x48, 0x22, 0x5F, 0xC0, 0xAF, 0xC9, 0xD5,
+        0x3E, 0x11, 0x1E, 0x62, 0x4A, 0x80, 0x60, 0x4D,
+        0x43, 0x14, 0xC0, 0xB5, 0x96, 0x87, 0xCB, 0x27,
+        0x32, 0x9A, 0xE4, 0x1E, 0xA2, 0xB6, 0x68, 0xB3,
+        0x0C, 0xBA, 0x55, 0xDB, 0xB9, 0x74, 0x37, 0xDA,
+        0x41, 0x51, 0x7F, 0x87, 0x63, 0x5E, 0x14, 0x53,
+        0x2E, 0x8C, 0x34, 0xEE, 0x1A, 0x92, 0xD8, 0xB9,
+        0xF4, 0x92, 0x60, 0x2F, 0x0A, 0x03, 0x06, 0xC2,
+        0x7F, 0x5A
+};
+#define clear_len_108 47
+#define auth_len_108 10
+
+static const uint8_t keys_109[] = {
+        0x2D, 0x95, 0x63, 0x36, 0xB5, 0xCF, 0x8E, 0xFA,
+        0xD1, 0x9C, 0x64, 0xCF, 0x60, 0xD4, 0xCE, 0x95
+};
+static const uint8_t nonce_109[] = {
+        0xB0, 0x1B, 0xD0, 0x0B, 0x85, 0xFE, 0x73, 0x54,
+        0xE9, 0xD2, 0x73, 0x2D
+};
+static const uint8_t packet_in_109[] = {
+        0xB7, 0x4D, 0xAD, 0xEB, 0xE5, 0xE1, 0x47, 0x37,
+        0x94, 0xDC, 0x9D, 0x8A, 0xD9, 0x41, 0xEF, 0x66,
+        0x49, 0x64, 0xCB, 0x5A, 0x47, 0x47, 0x3B, 0xB3,
+        0x0D, 0xB7, 0xAF, 0x02, 0x7B, 0x26, 0xA9, 0x52,
+        0xA2, 0x47, 0x2B, 0x26, 0x10, 0x6C, 0xE0, 0x35,
+        0xD9, 0x9F, 0x0C, 0xE4, 0x6A, 0x82, 0x35, 0x87,
+        0x0D, 0xE7, 0x8F, 0x58, 0x3B, 0x2E, 0x28, 0x33,
+        0xA5, 0x62, 0xD8, 0x17, 0x01, 0x12, 0xE6, 0x5D,
+        0x95, 0xF1, 0x7A, 0xB6, 0x84, 0x2D, 0xC7, 0xE6,
+        0xDC, 0x8F, 0xF5, 0x42, 0x5B, 0x57, 0xCF, 0xEA,
+        0x04, 0xD5, 0x31, 0xC7, 0x66, 0xC7, 0x2F, 0x43,
+        0xA7, 0x76, 0x06, 0xCB, 0x53, 0x8F, 0xC3, 0x06,
+        0xE7, 0xC2, 0xB5, 0xD2, 0x1B, 0x1C, 0x94, 0x03,
+        0xF3, 0x25, 0x6E, 0xDA, 0x84, 0xB9, 0x55, 0x47
+};
+static const uint8_t packet_out_109[] = {
+        0xB7, 0x4D, 0xAD, 0xEB, 0xE5, 0xE1, 0x47, 0x37,
+        0x94, 0xDC, 0x9D, 0x8A, 0xD9, 0x41, 0xEF, 0x66,
+        0x49, 0x64, 0xCB, 0x5A, 0x47, 0x47, 0x3B, 0xB3,
+        0x0D, 0xB7, 0xAF, 0x02, 0x7B, 0x26, 0xA9, 0x52,
+        0xA2, 0x47, 0x2B, 0x26, 0x10, 0x6C, 0xE0, 0x35,
+        0xD9, 0x9F, 0x0C, 0xE4, 0x6A, 0x82, 0x35, 0x87,
+        0x0D, 0xE7, 0x8F, 0x58, 0x3B, 0x2E, 0x28, 0x33,
+        0xA5, 0x62, 0xD8, 0x17, 0x01, 0x12, 0xE6, 0x5D,
+        0xD5, 0xBC, 0xE0, 0x74, 0xF7, 0x6B, 0xFE, 0x1C,
+        0x68, 0x9C, 0x42, 0xE7, 0x92, 0xA5, 0xB4, 0x36,
+        0x6E, 0x7E, 0x49, 0x17, 0xE0, 0x37, 0x1B, 0x0A,
+        0x61, 0xBC, 0xC7, 0xB6, 0xB8, 0xD1, 0xB8, 0xB4,
+        0x33, 0x0A, 0x6D, 0xD9, 0x2C, 0x6B, 0xE7, 0xE1,
+        0xFA, 0xA6, 0xD8, 0x96, 0xAB, 0xB6, 0x04, 0x76,
+        0x37, 0x13, 0x39, 0xE3, 0xC1, 0x36, 0x05, 0xB2,
+        0x58, 0xE6, 0x3F, 0x6D, 0xCE, 0xA9, 0xC0, 0x9E
+};
+#define clear_len_109 64
+#define auth_len_109 16
+
+static const uint8_t keys_110[] = {
+        0x87, 0xA7, 0xCA, 0xDF, 0x9F, 0x0B, 0xE7, 0x9B,
+        0x6A, 0x6B, 0x50, 0x56, 0x49, 0x94, 0xD8, 0x04
+};
+static const uint8_t nonce_110[] = {
+        0xF0, 0x33, 0xF2, 0xB3, 0xAC, 0x32, 0xDE, 0x44,
+        0x77, 0xD8, 0x8F
+};
+static const uint8_t packet_in_110[] = {
+        0xE6, 0xBE, 0x9F, 0x5E, 0x56, 0xEC, 0xD4, 0x71,
+        0xD7, 0xBE, 0xF1, 0xE9, 0xF3, 0x46, 0xBA, 0xCF,
+        0xF0, 0xBC, 0x1A, 0xBC, 0x11, 0x08, 0xBB, 0x4A,
+        0x92, 0x10, 0x67, 0x3E, 0x61, 0xC1, 0x21, 0x72,
+        0x9C, 0xDF, 0x02, 0x83, 0xCE, 0x8D, 0xD5, 0x40,
+        0xE9, 0x9C, 0x72, 0xCD, 0x03, 0x93, 0xDB, 0x9A,
+        0xD1, 0x82, 0x18, 0x08, 0xE4, 0x87, 0xD2, 0xD5,
+        0xA5, 0x1D, 0xB1, 0x4B, 0x11, 0x28, 0x77, 0x2D,
+        0x35, 0xC1, 0xD9, 0x5C, 0x69, 0xC1, 0x21, 0x4C,
+        0x4C, 0x0F, 0x85, 0x2B, 0x83, 0xAA, 0x44, 0xCB,
+        0x30, 0x75, 0x86, 0x53, 0x34, 0xC6, 0xF1, 0xAA,
+        0x25, 0xAD, 0x0B, 0x9F, 0x0E, 0x04, 0x52, 0xD8,
+        0xE9, 0x3B, 0x1D, 0x81, 0xDD, 0xE0, 0x31, 0xB0,
+        0x38, 0xF1, 0x22, 0x9A, 0x2B, 0xE2, 0x70, 0x78,
+        0x47, 0x6C, 0x5D, 0x37, 0xBB, 0x1B, 0x8F, 0xE2,
+        0x4A, 0x96, 0x6A, 0xD0, 0x0F, 0xAD, 0x2B, 0x8D,
+        0xF1, 0x25, 0xC5, 0x89, 0xE4, 0x43, 0x7C, 0x82,
+        0xE4, 0x19, 0x42, 0xB3, 0xB2, 0x92, 0xD4, 0xBA,
+        0x4D, 0x3F, 0x94, 0x4A, 0x2F, 0xE0, 0x25, 0x95,
+        0x4D, 0xB2, 0xC9, 0x76, 0xCB, 0x7C, 0x7A, 0x62,
+        0x83, 0x57, 0xC9, 0x0D, 0x34, 0x40, 0x7A, 0xDB,
+        0x8A, 0x5F, 0xDD, 0x0D, 0xD2, 0x14, 0xEA, 0xA8,
+        0x79, 0xC7, 0x24, 0x24, 0x49, 0x6C, 0x2A, 0xDA,
+        0x64, 0xD9, 0x1D, 0x2B, 0xFC, 0xC7, 0xB5
+};
+static const uint8_t packet_out_110[] = {
+        0xE6, 0xBE, 0x9F, 0x5E, 0x56, 0xEC, 0xD4, 0x71,
+        0xD7, 0xBE, 0xF1, 0xE9, 0xF3, 0x46, 0xBA, 0xCF,
+        0xF0, 0xBC, 0x1A, 0xBC, 0x11, 0x08, 0xBB, 0x4A,
+        0x92, 0x10, 0x67, 0x3E, 0x61, 0xC1, 0x21, 0x72,
+        0x9C, 0xDF, 0x02, 0x83, 0xCE, 0x8D, 0xD5, 0x40,
+        0xE9, 0x9C, 0x72, 0xCD, 0x03, 0x93, 0xDB, 0x9A,
+        0xD1, 0x82, 0x18, 0x08, 0xE4, 0x87, 0xD2, 0xD5,
+        0xA5, 0x1D, 0xB1, 0x4B, 0x11, 0x28, 0x77, 0x2D,
+        0x35, 0xC1, 0xD9, 0x5C, 0x69, 0xC1, 0x21, 0x4C,
+        0x4C, 0x0F, 0x85, 0x2B, 0x83, 0xAA, 0x44, 0xCB,
+        0x30, 0x75, 0x86, 0x53, 0x34, 0xC6, 0xF1, 0xAA,
+        0x25, 0xAD, 0x0B, 0x9F, 0x0E, 0x04, 0x52, 0xD8,
+        0xE9, 0x3B, 0x1D, 0x81, 0xDD, 0xE0, 0x31, 0xB0,
+        0x38, 0xF1, 0x22, 0x9A, 0x2B, 0xE2, 0x70, 0x78,
+        0x47, 0x6C, 0x5D, 0x37, 0xBB, 0x1B, 0x8F, 0xE2,
+        0x4A, 0x96, 0x6A, 0xD0, 0x0F, 0xAD, 0x2B, 0x8D,
+        0xF1, 0x25, 0x1D, 0xA6, 0x8B, 0x1F, 0xA1, 0xEA,
+        0x49, 0x10, 0xD6, 0xE1, 0x99, 0xE7, 0x9A, 0x75,
+        0xDE, 0xD8, 0xD0, 0x5B, 0x81, 0x25, 0x06, 0xDC,
+        0xD0, 0xDE, 0x46, 0x2A, 0x51, 0xC7, 0xFA, 0xF8,
+        0x81, 0x4C, 0xE5, 0x6F, 0x81, 0x3D, 0xBC, 0x21,
+        0x62, 0x0D, 0xF1, 0xE1, 0x37, 0xEE, 0xFB, 0x42,
+        0x60, 0x0F, 0x14, 0xFF, 0xC8, 0x96, 0xEF, 0x80,
+        0x98, 0x35, 0x3F, 0x90, 0xC4, 0xEC, 0x9C, 0xF0,
+        0xBA, 0x5F, 0x76, 0x73, 0x2A, 0x4F, 0x3F, 0x51,
+        0x64, 0x03, 0x01
+};
+#define clear_len_110 130
+#define auth_len_110 12
+
+static const uint8_t keys_111[] = {
+        0x6F, 0xD8, 0xAA, 0x22, 0xA4, 0x86, 0x31, 0xA4,
+        0xD3, 0x60, 0x9B, 0xE9, 0x41, 0x41, 0xC0, 0x2A
+};
+static const uint8_t nonce_111[] = {
+        0x5B, 0x05, 0xDA, 0x04, 0x5F, 0xC2, 0x18
+};
+static const uint8_t packet_in_111[] = {
+        0x17, 0xCA, 0xC7, 0xE1, 0x60, 0x85, 0x59, 0xE8,
+        0x57, 0xCE, 0x28, 0xF4, 0xC8, 0xE7, 0x93, 0x6D,
+        0x71, 0x81, 0xA0, 0xA6, 0x61, 0xE7, 0xB9, 0xEC,
+        0x0B, 0xEB, 0x27, 0x52, 0x2D, 0x91, 0x50, 0x3A,
+        0x63, 0x7D, 0xB0, 0xA4, 0x8A, 0x1C, 0x99, 0x36,
+        0xD5, 0x95, 0xAA, 0x0F, 0xB1, 0x6E, 0x11, 0x4C,
+        0x5A, 0xFE, 0x80, 0x56, 0x3A, 0x97, 0xF0, 0xF2,
+        0x05, 0x6F, 0x18, 0x06, 0x96, 0x53, 0xAC, 0x2C,
+        0x86, 0x0A, 0x56, 0xF8, 0x91, 0x8A, 0x75, 0x09,
+        0xAA, 0xDD, 0x98, 0xD2, 0xD8, 0xD1, 0xB9, 0x26,
+        0xD7, 0x62, 0x3A, 0x85, 0x6E, 0xE8, 0xA0, 0x29,
+        0x91, 0x01, 0x11, 0xCE, 0x37, 0x3C, 0x8E, 0x45,
+        0xF9, 0x8A, 0xF1, 0xB7, 0x70, 0x65, 0xA6, 0xBA,
+        0x4B, 0xBD, 0x29, 0x15, 0x32, 0xA7, 0x43, 0x53,
+        0x5E, 0xC5, 0x04, 0x0A, 0xF5, 0x73, 0x7F, 0xE8,
+        0x26, 0xB6, 0x48, 0x83, 0x09, 0xE5, 0xAE, 0xDD,
+        0x34, 0x15, 0xB9, 0xB8, 0x1D, 0x46, 0xE2, 0x9F,
+        0x32, 0x4F, 0x95, 0xB1, 0xBA, 0x89, 0x67, 0x2C,
+        0x69, 0x3E, 0x17, 0xBD, 0xC6, 0xD0, 0x46, 0x8A,
+        0x3D, 0xA9, 0xF6, 0xFB, 0x03, 0xE6, 0xC4, 0x4C,
+        0xAE, 0xC2, 0xE5, 0xD4, 0x90, 0xC4, 0xE2, 0x12,
+        0xD7, 0xA8, 0x13, 0x7C, 0x65, 0x0F, 0xDD, 0x08,
+        0x70, 0xE6, 0xAB, 0x77, 0xD9, 0x96, 0xAD, 0x64,
+        0x4D, 0xF0, 0x53, 0x10, 0x1E, 0xD6, 0x88, 0xEA,
+        0xDF, 0xAA, 0xAF, 0xE1, 0xC1, 0x78, 0x5E, 0x6A,
+        0xB0, 0xE3, 0xDD, 0x50, 0x2D, 0xD0, 0x5D, 0x3F,
+        0xEA, 0xD4, 0xF8, 0x0E, 0x27, 0x5E, 0x6C, 0xD0,
+        0xCF, 0xA4, 0x97, 0x99, 0x51, 0x4F, 0xB2, 0x10,
+        0x40, 0xE5, 0x4D, 0xB9, 0xA9, 0xFA, 0x0E, 0xFF,
+        0x38, 0x16, 0x29, 0x04, 0x09, 0x65, 0x9F, 0x29,
+        0x4F, 0x21, 0x36, 0x5C, 0xA7, 0xC0, 0x3B, 0x24,
+        0x3A, 0xDD, 0xFA, 0x6E, 0x95, 0xE7, 0xFA, 0x15,
+        0x48, 0x8B, 0xF9, 0x33, 0x40, 0xE2, 0xAA, 0x2A,
+        0xE4, 0x5A, 0x31, 0x70, 0xF2, 0x66, 0x5A
+};
+static const uint8_t packet_out_111[] = {
+        0x17, 0xCA, 0xC7, 0xE1, 0x60, 0x85, 0x59, 0xE8,
+        0x57, 0xCE, 0x28, 0xF4, 0xC8, 0xE7, 0x93, 0x6D,
+        0x71, 0x81, 0xA0, 0xA6, 0x61, 0xE7, 0xB9, 0xEC,
+        0x0B, 0xEB, 0x27, 0x52, 0x2D, 0x91, 0x50, 0x3A,
+        0x63, 0x7D, 0xB0, 0xA4, 0x8A, 0x1C, 0x99, 0x36,
+        0xD5, 0x95, 0xAA, 0x0F, 0xB1, 0x6E, 0x11, 0x4C,
+        0x5A, 0xFE, 0x80, 0x56, 0x3A, 0x97, 0xF0, 0xF2,
+        0x05, 0x6F, 0x18, 0x06, 0x96, 0x53, 0xAC, 0x2C,
+        0x86, 0x0A, 0x56, 0xF8, 0x91, 0x8A, 0x75, 0x09,
+        0xAA, 0xDD, 0x98, 0xD2, 0xD8, 0xD1, 0xB9, 0x26,
+        0xD7, 0x62, 0x3A, 0x85, 0x6E, 0xE8, 0xA0, 0x29,
+        0x91, 0x01, 0x11, 0xCE, 0x37, 0x3C, 0x8E, 0x45,
+        0xF9, 0x8A, 0xF1, 0xB7, 0x70, 0x65, 0xA6, 0xBA,
+        0x4B, 0xBD, 0x29, 0x15, 0x32, 0xA7, 0x43, 0x53,
+        0x5E, 0xC5, 0x04, 0x0A, 0xF5, 0x73, 0x7F, 0xE8,
+        0x26, 0xB6, 0x48, 0x83, 0x09, 0xE5, 0xAE, 0xDD,
+        0x34, 0x15, 0xB9, 0xB8, 0x1D, 0x46, 0xE2, 0x9F,
+        0x32, 0x4F, 0x95, 0xB1, 0xBA, 0x89, 0x67, 0x2C,
+        0x69, 0x3E, 0x17, 0xBD, 0xC6, 0xD0, 0x46, 0x8A,
+        0x3D, 0xA9, 0xF6, 0xFB, 0x03, 0xE6, 0xC4, 0x4C,
+        0xAE, 0xC2, 0xE5, 0xD4, 0x90, 0xC4, 0xE2, 0x12,
+        0xD7, 0xA8, 0x13, 0x7C, 0x65, 0x0F, 0xDD, 0x08,
+        0x70, 0xE6, 0xAB, 0x77, 0xD9, 0x96, 0xAD, 0x64,
+        0x4D, 0xF0, 0x53, 0x10, 0x1E, 0xD6, 0x88, 0xEA,
+        0xDF, 0xAA, 0xAF, 0xE1, 0xC1, 0x78, 0x5E, 0x6A,
+        0xB0, 0xE3, 0xDD, 0x50, 0x2D, 0xD0, 0x5D, 0x3F,
+        0xEA, 0xD4, 0xF8, 0x0E, 0x27, 0x5E, 0x6C, 0xD0,
+        0xCF, 0xA4, 0x97, 0x99, 0x51, 0x4F, 0xB2, 0x10,
+        0x40, 0xE5, 0x4D, 0xB9, 0xA9, 0xFA, 0x0E, 0xFF,
+        0x38, 0x16, 0x29, 0x04, 0x09, 0x65, 0x9F, 0x29,
+        0x4F, 0x21, 0x36, 0x5C, 0xA7, 0xC0, 0x3B, 0x24,
+        0x3A, 0xDD, 0xFA, 0x6E, 0x95, 0xE7, 0xFA, 0x15,
+        0x48, 0x8B, 0xF9, 0x33, 0x40, 0xE2, 0xAA, 0x2A,
+        0xE4, 0x5A, 0x31, 0x70, 0xF2, 0x66, 0xAD, 0xB4,
+        0x8B, 0xBD, 0xF5
+};
+#define clear_len_111 270
+#define auth_len_111 4
+
 #define CCM_TEST_VEC(num)                                               \
         { keys_##num, nonce_##num, sizeof(nonce_##num),                 \
                         packet_in_##num, sizeof(packet_in_##num),       \
@@ -1508,6 +1767,11 @@ static const struct ccm_rfc3610_vector {
         CCM_TEST_VEC(104),
         CCM_TEST_VEC(105),
         CCM_TEST_VEC_2(106),
+        CCM_TEST_VEC(107),
+        CCM_TEST_VEC(108),
+        CCM_TEST_VEC(109),
+        CCM_TEST_VEC(110),
+        CCM_TEST_VEC(111),
 };
 
 static int
@@ -685,6 +685,69 @@ test_des3_vectors(struct MB_MGR *mb_mgr, const int vec_cnt,
 	return errors;
 }
 
+static int
+test_des_key_schedule_mb(void)
+{
+        const uint32_t max_keys = 41;
+        uint8_t keys[41][8];
+        uint64_t ks[41][16];
+        uint64_t ks_ref[16];
+        const void *key_ptrs[41];
+        uint64_t *ks_ptrs[41];
+        uint32_t num_keys, i;
+        int errors = 0;
+
+        printf("DES multi-key key schedule:\n");
+
+        for (i = 0; i < max_keys; i++) {
+                unsigned j;
+
+                for (j = 0; j < sizeof(keys[i]); j++)
+                        keys[i][j] = (uint8_t) ((i * 37) + (j * 101) + 5);
+
+                key_ptrs[i] = keys[i];
+                ks_ptrs[i] = ks[i];
+        }
+
+        for (num_keys = 1; num_keys <= max_keys; num_keys++) {
+                printf(".");
+                memset(ks, 0, sizeof(ks));
+
+                if (des_key_schedule_mb(ks_ptrs, key_ptrs, num_keys) != 0) {
+                        printf("error: des_key_schedule_mb() failed "
+                               "for %u keys\n", num_keys);
+                        errors++;
+                        continue;
+                }
+
+                for (i = 0; i < num_keys; i++) {
+                        des_key_schedule(ks_ref, key_ptrs[i]);
+                        if (memcmp(ks[i], ks_ref, sizeof(ks_ref)) != 0) {
+                                printf("error: key schedule mismatch "
+                                       "for key %u of %u\n", i, num_keys);
+                                errors++;
+                        }
+                }
+
+                /* key schedules past num_keys must be left untouched */
+                for (i = num_keys; i < max_keys; i++) {
+                        if (ks[i][0] != 0 || ks[i][15] != 0) {
+                                printf("error: key schedule %u overwritten "
+                                       "for %u keys\n", i, num_keys);
+                                errors++;
+                        }
+                }
+        }
+
+        if (des_key_schedule_mb(NULL, key_ptrs, 1) == 0) {
+                printf("error: des_key_schedule_mb() accepted NULL\n");
+                errors++;
+        }
+
+	printf("\n");
+	return errors;
+}
+
 int
 des_test(const enum arch_type arch,
          struct MB_MGR *mb_mgr)
@@ -707,6 +770,8 @@ des_test(const enum arch_type arch,
         errors += test_des3_vectors(mb_mgr, DIM(des3_vectors), des3_vectors,
                                     "3DES (multiple keys) test vectors");
 
+        errors += test_des_key_schedule_mb();
+
 	if (0 == errors)
 		printf("...Pass\n");
 	else
@@ -0,0 +1,509 @@
+/*****************************************************************************
+ Copyright (c) 2019, Intel Corporation
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+     * Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+     * Neither the name of Intel Corporation nor the names of its contributors
+       may be used to endorse or promote products derived from this software
+       without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include <intel-ipsec-mb.h>
+
+#include "gcm_ctr_vectors_test.h"
+#include "utils.h"
+
+/*
+ * DOCSIS frames protected with CRC32 and BPI (AES128-CBC + CFB for residual).
+ * Ethernet header (DA + SA, 12 bytes) is sent in clear,
+ * encryption starts at the length/type field and covers the CRC.
+ */
+#define DOCSIS_CRC_CIPHER_OFFSET 12
+#define DOCSIS_CRC_LEN 4
+
+int docsis_test(const enum arch_type arch, struct MB_MGR *mb_mgr);
+
+struct docsis_crc_vector {
+        const uint8_t *K;       /* key */
+        const uint8_t *IV;      /* initialization vector */
+        const uint8_t *P;       /* frame + CRC in clear */
+        const uint8_t *C;       /* frame + CRC after BPI encryption */
+        uint64_t frame_len;     /* frame length without CRC */
+};
+
+/* frame length 14 bytes + CRC */
+static const uint8_t DOCSIS_CRC_K1[] = {
+        0x3b, 0x96, 0xa1, 0xc1, 0x50, 0x59, 0xb2, 0x65,
+        0x92, 0x24, 0xca, 0x04, 0xf0, 0x17, 0x9f, 0xe3
+};
+static const uint8_t DOCSIS_CRC_IV1[] = {
+        0xa6, 0xec, 0x4a, 0x3e, 0x5b, 0xe6, 0xc6, 0x18,
+        0xfa, 0x7a, 0x28, 0xc3, 0x50, 0xba, 0x9c, 0x2f
+};
+static const uint8_t DOCSIS_CRC_P1[] = {
+        0x6a, 0x85, 0x23, 0xf2, 0xac, 0x70, 0x0e, 0x1b,
+        0xb1, 0x73, 0x3a, 0xb6, 0xe6, 0x53, 0xd4, 0x0a,
+        0x67, 0x74
+};
+static const uint8_t DOCSIS_CRC_C1[] = {
+        0x6a, 0x85, 0x23, 0xf2, 0xac, 0x70, 0x0e, 0x1b,
+        0xb1, 0x73, 0x3a, 0xb6, 0xe2, 0x05, 0x76, 0xaf,
+        0x3e, 0x2f
+};
+
+/* frame length 24 bytes + CRC */
+static const uint8_t DOCSIS_CRC_K2[] = {
+        0x09, 0x1f, 0xe6, 0xd3, 0x23, 0x07, 0x93, 0x9a,
+        0xf1, 0x48, 0xf8, 0xe3, 0xd6, 0x68, 0xe1, 0xe7
+};
+static const uint8_t DOCSIS_CRC_IV2[] = {
+        0x2b, 0xef, 0x38, 0x0a, 0x01, 0x69, 0x1e, 0xc7,
+        0x96, 0x3a, 0xcd, 0x5d, 0x93, 0x24, 0x30, 0x37
+};
+static const uint8_t DOCSIS_CRC_P2[] = {
+        0x0b, 0x99, 0x3f, 0x1c, 0x34, 0xc2, 0x1c, 0x1b,
+        0xe3, 0x4b, 0xef, 0x34, 0xc9, 0xf5, 0x82, 0xc6,
+        0x70, 0xd9, 0x9b, 0xbd, 0xf3, 0x7d, 0x1d, 0x77,
+        0x3d, 0xf0, 0x27, 0x90
+};
+static const uint8_t DOCSIS_CRC_C2[] = {
+        0x0b, 0x99, 0x3f, 0x1c, 0x34, 0xc2, 0x1c, 0x1b,
+        0xe3, 0x4b, 0xef, 0x34, 0xab, 0xeb, 0x6f, 0xf6,
+        0x89, 0x7e, 0x90, 0x23, 0x07, 0xa0, 0xf9, 0xef,
+        0x42, 0xc0, 0x00, 0xc4
+};
+
+/* frame length 60 bytes + CRC */
+static const uint8_t DOCSIS_CRC_K3[] = {
+        0x80, 0x98, 0xdd, 0x7b, 0x8f, 0xa5, 0x45, 0xd9,
+        0xdf, 0x2a, 0xab, 0x5e, 0x35, 0xc5, 0x6f, 0x80
+};
+static const uint8_t DOCSIS_CRC_IV3[] = {
+        0xd4, 0xfb, 0xd7, 0x04, 0xbb, 0xc0, 0xaa, 0x71,
+        0xa1, 0xc6, 0x8e, 0x35, 0xb1, 0x86, 0x21, 0x98
+};
+static const uint8_t DOCSIS_CRC_P3[] = {
+        0x05, 0x0f, 0xda, 0x64, 0xe4, 0x91, 0x9e, 0x51,
+        0xbc, 0xa8, 0x22, 0x33, 0xde, 0x6a, 0x03, 0xe2,
+        0xfb, 0x2f, 0xa6, 0xed, 0x62, 0x23, 0xd1, 0xfd,
+        0xf7, 0x8d, 0x06, 0x0b, 0xf3, 0xdc, 0xa3, 0x41,
+        0x5d, 0x76, 0xbb, 0xb1, 0x4c, 0x41, 0xb2, 0xb8,
+        0xd9, 0xed, 0x9b, 0x30, 0xe6, 0x08, 0x51, 0x59,
+        0x92, 0xbf, 0x57, 0x85, 0x78, 0x75, 0x70, 0x85,
+        0xaa, 0x06, 0xfd, 0xd6, 0x4e, 0xf1, 0x6d, 0xf7
+};
+static const uint8_t DOCSIS_CRC_C3[] = {
+        0x05, 0x0f, 0xda, 0x64, 0xe4, 0x91, 0x9e, 0x51,
+        0xbc, 0xa8, 0x22, 0x33, 0x1a, 0xe0, 0x11, 0x62,
+        0x72, 0x61, 0x83, 0x8b, 0x02, 0xb5, 0xda, 0x70,
+        0x35, 0x50, 0x49, 0x6b, 0x13, 0xb2, 0x26, 0x7b,
+        0x20, 0xe0, 0xa6, 0x42, 0x97, 0x16, 0x45, 0x98,
+        0x51, 0xe7, 0x1b, 0x97, 0xcb, 0x54, 0x43, 0xd0,
+        0xcc, 0x54, 0xc7, 0xec, 0x1b, 0x4f, 0xcb, 0xec,
+        0x08, 0x60, 0x2e, 0x84, 0x67, 0x69, 0x78, 0x49
+};
+
+/* frame length 81 bytes + CRC */
+static const uint8_t DOCSIS_CRC_K4[] = {
+        0x70, 0xd8, 0x1b, 0x8c, 0xc0, 0xa6, 0x79, 0xfa,
+        0x7d, 0x0b, 0xf9, 0x26, 0x70, 0xd0, 0x0e, 0xf0
+};
+static const uint8_t DOCSIS_CRC_IV4[] = {
+        0x07, 0xf7, 0xd0, 0xfc, 0xd0, 0x84, 0xdf, 0x64,
+        0xb3, 0x0e, 0xfe, 0x1f, 0xf2, 0x09, 0x6b, 0x30
+};
+static const uint8_t DOCSIS_CRC_P4[] = {
+        0xe2, 0xd0, 0x00, 0x8e, 0x66, 0x75, 0x0a, 0xd7,
+        0x30, 0x49, 0xec, 0xb3, 0xb7, 0x2a, 0x74, 0x09,
+        0xf8, 0x8f, 0xf8, 0xe4, 0xec, 0x54, 0x39, 0x24,
+        0xcc, 0x46, 0xf4, 0xe5, 0x07, 0x6e, 0x47, 0xaf,
+        0xff, 0x1e, 0xca, 0x62, 0x87, 0xbd, 0x69, 0xdf,
+        0x1e, 0x52, 0x03, 0x77, 0xe8, 0xd1, 0xc4, 0x14,
+        0x70, 0x28, 0x42, 0x29, 0x1f, 0x09, 0x5a, 0x5b,
+        0x7b, 0x76, 0xc9, 0xec, 0x21, 0x0e, 0x89, 0xec,
+        0x81, 0x19, 0xf1, 0x1e, 0x5b, 0x55, 0x8c, 0xab,
+        0xfd, 0x7e, 0xb5, 0x89, 0x39, 0x9f, 0xf7, 0xa9,
+        0x28, 0xa8, 0x84, 0x2d, 0x3b
+};
+static const uint8_t DOCSIS_CRC_C4[] = {
+        0xe2, 0xd0, 0x00, 0x8e, 0x66, 0x75, 0x0a, 0xd7,
+        0x30, 0x49, 0xec, 0xb3, 0x2b, 0xdc, 0xf2, 0xa9,
+        0x2f, 0xa3, 0x33, 0x1b, 0x11, 0xc5, 0x17, 0x67,
+        0xb3, 0xff, 0xf4, 0xcb, 0x77, 0xbc, 0x9d, 0xd8,
+        0xbb, 0x91, 0xa2, 0x48, 0xc9, 0x46, 0x42, 0x75,
+        0xa8, 0x38, 0xdd, 0x0e, 0x2f, 0x5b, 0xc7, 0x4c,
+        0x1f, 0x55, 0x85, 0x46, 0x19, 0x15, 0x4c, 0xa4,
+        0x88, 0x33, 0xad, 0x7c, 0x4e, 0x51, 0x20, 0x6c,
+        0x8e, 0x24, 0x48, 0x26, 0x43, 0xcf, 0x13, 0x63,
+        0x29, 0x1e, 0xfc, 0x31, 0x9a, 0xb2, 0xa7, 0xdb,
+        0x77, 0x89, 0x4d, 0x07, 0xe9
+};
+
+static const struct docsis_crc_vector docsis_crc_vectors[] = {
+        {DOCSIS_CRC_K1, DOCSIS_CRC_IV1, DOCSIS_CRC_P1, DOCSIS_CRC_C1,
+         sizeof(DOCSIS_CRC_P1) - DOCSIS_CRC_LEN},
+        {DOCSIS_CRC_K2, DOCSIS_CRC_IV2, DOCSIS_CRC_P2, DOCSIS_CRC_C2,
+         sizeof(DOCSIS_CRC_P2) - DOCSIS_CRC_LEN},
+        {DOCSIS_CRC_K3, DOCSIS_CRC_IV3, DOCSIS_CRC_P3, DOCSIS_CRC_C3,
+         sizeof(DOCSIS_CRC_P3) - DOCSIS_CRC_LEN},
+        {DOCSIS_CRC_K4, DOCSIS_CRC_IV4, DOCSIS_CRC_P4, DOCSIS_CRC_C4,
+         sizeof(DOCSIS_CRC_P4) - DOCSIS_CRC_LEN},
+};
+
+/*
+ * Frames with byte i set to (i * 7 + 3) and their expected CRC32.
+ * Lengths are picked around the folding thresholds of the CRC code paths.
+ */
+static const struct {
+        uint64_t len;
+        uint32_t crc;
+} docsis_crc_patterns[] = {
+        {100, 0xaa316b09},
+        {255, 0x8af1eb92},
+        {256, 0x78825239},
+        {257, 0x1476b46d},
+        {1514, 0x37d7dd96},
+        {9018, 0x79d7c210},
+};
+
+static int
+docsis_job_ok(const struct JOB_AES_HMAC *job,
+              const uint8_t *out, const uint8_t *expected, const size_t len,
+              const uint8_t *tag, const uint8_t *expected_tag)
+{
+        const int num = (const int)((uint64_t)job->user_data2);
+
+        if (job->status != STS_COMPLETED) {
+                printf("%d error status:%d, job %d\n",
+                       __LINE__, job->status, num);
+                return 0;
+        }
+        if (memcmp(out, expected, len)) {
+                printf("%d mismatched\n", num);
+                hexdump(stderr, "Received", out, len);
+                hexdump(stderr, "Expected", expected, len);
+                return 0;
+        }
+        if (tag != NULL && memcmp(tag, expected_tag, DOCSIS_CRC_LEN)) {
+                printf("%d CRC mismatched\n", num);
+                hexdump(stderr, "Received", tag, DOCSIS_CRC_LEN);
+                hexdump(stderr, "Expected", expected_tag, DOCSIS_CRC_LEN);
+                return 0;
+        }
+        return 1;
+}
+
+static void
+docsis_fill_job(struct JOB_AES_HMAC *job,
+                const void *enc_keys, const void *dec_keys, const void *iv,
+                const uint8_t *src, uint8_t *dst, uint8_t *tag,
+                const uint64_t frame_len, const JOB_CIPHER_DIRECTION dir)
+{
+        job->cipher_direction = dir;
+        job->chain_order = (dir == ENCRYPT) ? HASH_CIPHER : CIPHER_HASH;
+        job->cipher_mode = DOCSIS_SEC_BPI;
+        job->hash_alg = DOCSIS_CRC32;
+        job->aes_enc_key_expanded = enc_keys;
+        job->aes_dec_key_expanded = dec_keys;
+        job->aes_key_len_in_bytes = 16;
+        job->iv = iv;
+        job->iv_len_in_bytes = 16;
+        job->src = src;
+        job->dst = dst;
+        job->cipher_start_src_offset_in_bytes = DOCSIS_CRC_CIPHER_OFFSET;
+        job->msg_len_to_cipher_in_bytes =
+                frame_len + DOCSIS_CRC_LEN - DOCSIS_CRC_CIPHER_OFFSET;
+        job->hash_start_src_offset_in_bytes = 0;
+        job->msg_len_to_hash_in_bytes = frame_len;
+        job->auth_tag_output = tag;
+        job->auth_tag_output_len_in_bytes = DOCSIS_CRC_LEN;
+}
+
+/*
+ * Submits num_jobs copies of the vector and checks output text and CRC.
+ * Encryption computes the CRC over the clear frame into the frame itself
+ * before ciphering it. Decryption writes the CRC to a separate buffer so
+ * that it can be compared with the received one.
+ */
+static int
+test_docsis_crc_many(struct MB_MGR *mb_mgr,
+                     const void *enc_keys, const void *dec_keys,
+                     const struct docsis_crc_vector *vec,
+                     const JOB_CIPHER_DIRECTION dir,
+                     const int in_place, const int num_jobs)
+{
+        const uint64_t buf_len = vec->frame_len + DOCSIS_CRC_LEN;
+        const uint8_t *in_text = (dir == ENCRYPT) ? vec->P : vec->C;
+        const uint8_t *out_text = (dir == ENCRYPT) ? vec->C : vec->P;
+        struct JOB_AES_HMAC *job;
+        uint8_t **srcs = malloc(num_jobs * sizeof(void *));
+        uint8_t **dsts = malloc(num_jobs * sizeof(void *));
+        uint8_t *tags = malloc(num_jobs * DOCSIS_CRC_LEN);
+        int i, jobs_rx = 0, ret = -1;
+
+        assert(srcs != NULL && dsts != NULL && tags != NULL);
+
+        for (i = 0; i < num_jobs; i++) {
+                srcs[i] = malloc(buf_len);
+                assert(srcs[i] != NULL);
+                memcpy(srcs[i], in_text, buf_len);
+                if (in_place) {
+                        dsts[i] = srcs[i];
+                } else {
+                        dsts[i] = malloc(buf_len);
+                        assert(dsts[i] != NULL);
+                        memset(dsts[i], -1, buf_len);
+                }
+                /* CRC placeholder gets overwritten on encryption */
+                if (dir == ENCRYPT)
+                        memset(srcs[i] + vec->frame_len, 0, DOCSIS_CRC_LEN);
+        }
+        memset(tags, -1, num_jobs * DOCSIS_CRC_LEN);
+
+        /* flush the scheduler */
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                ;
+
+        for (i = 0; i < num_jobs; i++) {
+                uint8_t *tag = (dir == ENCRYPT) ?
+                        srcs[i] + vec->frame_len : &tags[i * DOCSIS_CRC_LEN];
+
+                job = IMB_GET_NEXT_JOB(mb_mgr);
+                docsis_fill_job(job, enc_keys, dec_keys, vec->IV, srcs[i],
+                                dsts[i] + DOCSIS_CRC_CIPHER_OFFSET, tag,
+                                vec->frame_len, dir);
+                job->user_data = dsts[i];
+                job->user_data2 = (void *)((uint64_t)i);
+
+                job = IMB_SUBMIT_JOB(mb_mgr);
+                while (job != NULL) {
+                        const int n = (const int)((uint64_t)job->user_data2);
+                        const uint8_t *out = job->user_data;
+
+                        jobs_rx++;
+                        if (!docsis_job_ok(job,
+                                           out + DOCSIS_CRC_CIPHER_OFFSET,
+                                           out_text + DOCSIS_CRC_CIPHER_OFFSET,
+                                           buf_len - DOCSIS_CRC_CIPHER_OFFSET,
+                                           (dir == DECRYPT) ?
+                                           &tags[n * DOCSIS_CRC_LEN] : NULL,
+                                           vec->P + vec->frame_len))
+                                goto end;
+                        job = IMB_GET_COMPLETED_JOB(mb_mgr);
+                }
+        }
+
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL) {
+                const int n = (const int)((uint64_t)job->user_data2);
+                const uint8_t *out = job->user_data;
+
+                jobs_rx++;
+                if (!docsis_job_ok(job, out + DOCSIS_CRC_CIPHER_OFFSET,
+                                   out_text + DOCSIS_CRC_CIPHER_OFFSET,
+                                   buf_len - DOCSIS_CRC_CIPHER_OFFSET,
+                                   (dir == DECRYPT) ?
+                                   &tags[n * DOCSIS_CRC_LEN] : NULL,
+                                   vec->P + vec->frame_len))
+                        goto end;
+        }
+
+        if (jobs_rx != num_jobs) {
+                printf("Expected %d jobs, received %d\n", num_jobs, jobs_rx);
+                goto end;
+        }
+        ret = 0;
+
+ end:
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                ;
+
+        for (i = 0; i < num_jobs; i++) {
+                if (!in_place)
+                        free(dsts[i]);
+                free(srcs[i]);
+        }
+        free(srcs);
+        free(dsts);
+        free(tags);
+        return ret;
+}
+
+static int
+test_docsis_crc_vectors(struct MB_MGR *mb_mgr, const int num_jobs)
+{
+        unsigned vect;
+        int errors = 0;
+        DECLARE_ALIGNED(uint32_t enc_keys[15*4], 16);
+        DECLARE_ALIGNED(uint32_t dec_keys[15*4], 16);
+
+        printf("DOCSIS-CRC32 test vectors (N jobs = %d):\n", num_jobs);
+        for (vect = 0; vect < DIM(docsis_crc_vectors); vect++) {
+                const struct docsis_crc_vector *vec = &docsis_crc_vectors[vect];
+#ifdef DEBUG
+                printf("[%u/%u] frame length:%u\n",
+                       vect + 1, (unsigned) DIM(docsis_crc_vectors),
+                       (unsigned) vec->frame_len);
+#else
+                printf(".");
+#endif
+                IMB_AES_KEYEXP_128(mb_mgr, vec->K, enc_keys, dec_keys);
+
+                if (test_docsis_crc_many(mb_mgr, enc_keys, dec_keys, vec,
+                                         ENCRYPT, 0, num_jobs)) {
+                        printf("error #%u encrypt\n", vect + 1);
+                        errors++;
+                }
+                if (test_docsis_crc_many(mb_mgr, enc_keys, dec_keys, vec,
+                                         DECRYPT, 0, num_jobs)) {
+                        printf("error #%u decrypt\n", vect + 1);
+                        errors++;
+                }
+                if (test_docsis_crc_many(mb_mgr, enc_keys, dec_keys, vec,
+                                         ENCRYPT, 1, num_jobs)) {
+                        printf("error #%u encrypt in-place\n", vect + 1);
+                        errors++;
+                }
+                if (test_docsis_crc_many(mb_mgr, enc_keys, dec_keys, vec,
+                                         DECRYPT, 1, num_jobs)) {
+                        printf("error #%u decrypt in-place\n", vect + 1);
+                        errors++;
+                }
+        }
+        printf("\n");
+        return errors;
+}
+
+/*
+ * Round trip of longer frames: encrypt in place, decrypt in place
+ * and check that both CRC's match the expected value.
+ */
+static int
+test_docsis_crc_patterns(struct MB_MGR *mb_mgr)
+{
+        const struct docsis_crc_vector *vec = &docsis_crc_vectors[0];
+        DECLARE_ALIGNED(uint32_t enc_keys[15*4], 16);
+        DECLARE_ALIGNED(uint32_t dec_keys[15*4], 16);
+        unsigned i;
+        int errors = 0;
+
+        IMB_AES_KEYEXP_128(mb_mgr, vec->K, enc_keys, dec_keys);
+
+        printf("DOCSIS-CRC32 frame round trip:\n");
+        for (i = 0; i < DIM(docsis_crc_patterns); i++) {
+                const uint64_t frame_len = docsis_crc_patterns[i].len;
+                const uint32_t crc = docsis_crc_patterns[i].crc;
+                uint8_t *ref = malloc(frame_len + DOCSIS_CRC_LEN);
+                uint8_t *buf = malloc(frame_len + DOCSIS_CRC_LEN);
+                uint8_t tag[DOCSIS_CRC_LEN];
+                struct JOB_AES_HMAC *job;
+                uint64_t j;
+
+                assert(ref != NULL && buf != NULL);
+#ifdef DEBUG
+                printf("[%u/%u] frame length:%u\n", i + 1,
+                       (unsigned) DIM(docsis_crc_patterns),
+                       (unsigned) frame_len);
+#else
+                printf(".");
+#endif
+                for (j = 0; j < frame_len; j++)
+                        ref[j] = (uint8_t) (j * 7 + 3);
+                ref[frame_len + 0] = (uint8_t) crc;
+                ref[frame_len + 1] = (uint8_t) (crc >> 8);
+                ref[frame_len + 2] = (uint8_t) (crc >> 16);
+                ref[frame_len + 3] = (uint8_t) (crc >> 24);
+                memcpy(buf, ref, frame_len);
+                memset(buf + frame_len, 0, DOCSIS_CRC_LEN);
+
+                while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                        ;
+
+                job = IMB_GET_NEXT_JOB(mb_mgr);
+                docsis_fill_job(job, enc_keys, dec_keys, vec->IV, buf,
+                                buf + DOCSIS_CRC_CIPHER_OFFSET,
+                                buf + frame_len, frame_len, ENCRYPT);
+                job = IMB_SUBMIT_JOB(mb_mgr);
+                if (job == NULL)
+                        job = IMB_FLUSH_JOB(mb_mgr);
+                if (job == NULL || job->status != STS_COMPLETED) {
+                        printf("error #%u encrypt status\n", i + 1);
+                        errors++;
+                        goto next;
+                }
+
+                job = IMB_GET_NEXT_JOB(mb_mgr);
+                docsis_fill_job(job, enc_keys, dec_keys, vec->IV, buf,
+                                buf + DOCSIS_CRC_CIPHER_OFFSET,
+                                tag, frame_len, DECRYPT);
+                job = IMB_SUBMIT_JOB(mb_mgr);
+                if (job == NULL)
+                        job = IMB_FLUSH_JOB(mb_mgr);
+                if (job == NULL || job->status != STS_COMPLETED) {
+                        printf("error #%u decrypt status\n", i + 1);
+                        errors++;
+                        goto next;
+                }
+
+                if (memcmp(buf, ref, frame_len + DOCSIS_CRC_LEN)) {
+                        printf("error #%u round trip mismatch\n", i + 1);
+                        errors++;
+                } else if (memcmp(tag, ref + frame_len, DOCSIS_CRC_LEN)) {
+                        printf("error #%u CRC mismatch\n", i + 1);
+                        hexdump(stderr, "Received", tag, DOCSIS_CRC_LEN);
+                        hexdump(stderr, "Expected", ref + frame_len,
+                                DOCSIS_CRC_LEN);
+                        errors++;
+                }
+ next:
+                free(ref);
+                free(buf);
+        }
+        printf("\n");
+        return errors;
+}
+
+int
+docsis_test(const enum arch_type arch, struct MB_MGR *mb_mgr)
+{
+        const int num_jobs_tab[] = {
+                1, 3, 4, 5, 7, 8, 9, 15, 16, 17
+        };
+        unsigned i;
+        int errors = 0;
+
+        (void) arch; /* unused */
+
+        for (i = 0; i < DIM(num_jobs_tab); i++)
+                errors += test_docsis_crc_vectors(mb_mgr, num_jobs_tab[i]);
+        errors += test_docsis_crc_patterns(mb_mgr);
+
+	if (0 == errors)
+		printf("...Pass\n");
+	else
+		printf("...Fail\n");
+
+	return errors;
+}
@@ -0,0 +1,1025 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include <intel-ipsec-mb.h>
+
+#include "gcm_ctr_vectors_test.h"
+#include "utils.h"
+
+int gcm_siv_test(const enum arch_type arch, struct MB_MGR *mb_mgr);
+
+#define GCM_SIV_TEST_MAX_MSG_LEN 1000
+#define GCM_SIV_TEST_MAX_AAD_LEN 100
+#define GCM_SIV_TEST_TAG_LEN     16
+/* output buffers have one extra byte to check for overwrites */
+#define GCM_SIV_TEST_BUF_SIZE    (GCM_SIV_TEST_MAX_MSG_LEN + 1)
+#define GCM_SIV_TEST_TAG_SIZE    (GCM_SIV_TEST_TAG_LEN + 1)
+
+struct gcm_siv_vector {
+        const uint8_t *key;
+        uint64_t key_len;
+        const uint8_t *nonce;
+        const uint8_t *msg;
+        uint64_t msg_len;
+        const uint8_t *aad;
+        uint64_t aad_len;
+        const uint8_t *ct;      /* expected ciphertext */
+        const uint8_t *tag;     /* expected tag */
+};
+
+static uint8_t gcm_siv_msg[GCM_SIV_TEST_MAX_MSG_LEN];
+static uint8_t gcm_siv_aad[GCM_SIV_TEST_MAX_AAD_LEN];
+
+static const uint8_t GCM_SIV_KEY128[] = {
+        0x11, 0x14, 0x17, 0x1a, 0x1d, 0x20, 0x23, 0x26,
+        0x29, 0x2c, 0x2f, 0x32, 0x35, 0x38, 0x3b, 0x3e
+};
+
+static const uint8_t GCM_SIV_KEY256[] = {
+        0x21, 0x26, 0x2b, 0x30, 0x35, 0x3a, 0x3f, 0x44,
+        0x49, 0x4e, 0x53, 0x58, 0x5d, 0x62, 0x67, 0x6c,
+        0x71, 0x76, 0x7b, 0x80, 0x85, 0x8a, 0x8f, 0x94,
+        0x99, 0x9e, 0xa3, 0xa8, 0xad, 0xb2, 0xb7, 0xbc
+};
+
+static const uint8_t GCM_SIV_NONCE[] = {
+        0x80, 0x89, 0x92, 0x9b, 0xa4, 0xad, 0xb6, 0xbf,
+        0xc8, 0xd1, 0xda, 0xe3
+};
+
+static const uint8_t GCM_SIV_TAG1[] = {
+        0x06, 0xca, 0x52, 0x7f, 0xaf, 0x94, 0x07, 0x89,
+        0x91, 0xcc, 0xe0, 0xd1, 0xe7, 0x02, 0x62, 0x1d
+};
+
+static const uint8_t GCM_SIV_CT2[] = {
+        0xa6, 0xd7, 0x88, 0xa0, 0xd8, 0x58, 0x4b, 0x72
+};
+
+static const uint8_t GCM_SIV_TAG2[] = {
+        0x3b, 0xa2, 0x88, 0x9a, 0x89, 0xac, 0x9d, 0x5a,
+        0x0a, 0x94, 0x0c, 0xc7, 0xd8, 0x79, 0x40, 0xfb
+};
+
+static const uint8_t GCM_SIV_CT3[] = {
+        0xc4, 0x25, 0x31, 0x17, 0x22, 0xba, 0xd6, 0x41,
+        0xcc, 0x04, 0xe1, 0x9f, 0x33, 0x47, 0x22, 0x94
+};
+
+static const uint8_t GCM_SIV_TAG3[] = {
+        0x2a, 0x9a, 0xac, 0x0d, 0x2e, 0x30, 0x7f, 0xf3,
+        0xf9, 0xde, 0x97, 0x87, 0xb6, 0x09, 0xf6, 0x6e
+};
+
+static const uint8_t GCM_SIV_CT4[] = {
+        0x3e, 0xa3, 0x6b, 0x9f, 0x61, 0x6c, 0xb6, 0x75,
+        0xdb, 0x4d, 0x22, 0x99, 0xcc, 0xb3, 0xa0, 0xd5,
+        0xc6
+};
+
+static const uint8_t GCM_SIV_TAG4[] = {
+        0x51, 0xa2, 0x00, 0x00, 0xc0, 0x54, 0x34, 0x7c,
+        0xc1, 0x07, 0x78, 0x2b, 0x9c, 0xf8, 0x18, 0x9e
+};
+
+static const uint8_t GCM_SIV_CT5[] = {
+        0xbd, 0xe8, 0x29, 0x25, 0x0a, 0x2f, 0xe7, 0xf5,
+        0x39, 0xa0, 0x9c, 0x49, 0x28, 0xd6, 0xa7, 0xef,
+        0xd4, 0xa4, 0x93, 0x5d, 0x36, 0x3e, 0xca, 0x5a,
+        0x12, 0x90, 0xa9, 0xf2, 0x54, 0xc9, 0x62, 0xbb,
+        0x4c, 0x92, 0x82, 0x28, 0xde, 0x24, 0xff, 0x46,
+        0x8d, 0x20, 0xca, 0x2b, 0x5d, 0x2b, 0xd0, 0xf8,
+        0x3f, 0x34, 0x9b, 0x6d, 0x71, 0x76, 0xe2, 0xa8,
+        0x7b, 0xd3, 0x26, 0xf7, 0xb1, 0xfb, 0x63, 0x2c
+};
+
+static const uint8_t GCM_SIV_TAG5[] = {
+        0x3a, 0x39, 0xe0, 0x47, 0xb6, 0x8b, 0xb1, 0x6c,
+        0xd7, 0x5b, 0x6d, 0xa9, 0x01, 0xf8, 0x17, 0x1f
+};
+
+static const uint8_t GCM_SIV_CT6[] = {
+        0xa6, 0xaf, 0x87, 0x46, 0xf3, 0x05, 0x92, 0x68,
+        0x53, 0xfe, 0x4e, 0x94, 0x8c, 0xaf, 0x95, 0xad,
+        0x70, 0x3b, 0x4a, 0xbb, 0x51, 0x1c, 0x74, 0x3e,
+        0x9f, 0xb8, 0xa1, 0x89, 0xa6, 0x2d, 0xc2, 0xaf,
+        0xb3, 0x8c, 0x2b, 0x87, 0x03, 0x44, 0x39, 0x96,
+        0xd3, 0xe1, 0x73, 0x2f, 0x0d, 0x69, 0xa7, 0xd8,
+        0x14, 0xef, 0x8f, 0x9b, 0x2d, 0x04, 0x16, 0xee,
+        0x5a, 0x38, 0x8a, 0x0a, 0x57, 0x00, 0xa7, 0x81,
+        0x14, 0xac, 0x19, 0x6f, 0xd8, 0x87, 0xe7, 0x66,
+        0x44, 0xaf, 0x96, 0x1c, 0x8d, 0x08, 0x95, 0x34,
+        0x31, 0x5f, 0x87, 0x54, 0x57, 0x22, 0x0b, 0x5e,
+        0x65, 0x2c, 0x2d, 0x09, 0xa5, 0x2d, 0x91, 0xc8,
+        0x5b, 0x38, 0x6b, 0x7a
+};
+
+static const uint8_t GCM_SIV_TAG6[] = {
+        0x4b, 0x20, 0x40, 0x80, 0xfa, 0x9b, 0x54, 0x23,
+        0x94, 0x05, 0x3b, 0xaf, 0x97, 0x6d, 0x8e, 0xf0
+};
+
+static const uint8_t GCM_SIV_CT7[] = {
+        0x59, 0x70, 0xb7, 0x20, 0x1a, 0x21, 0x3e, 0x28,
+        0x9f, 0x10, 0xae, 0xfb, 0xa4, 0x51, 0x3f, 0xe7,
+        0xb2, 0x35, 0xcb, 0xe1, 0xcf, 0x17, 0xa1, 0x31,
+        0xcc, 0x5b, 0x0e, 0x20, 0x49, 0x0f, 0xf2, 0xd0,
+        0xce, 0x14, 0xe5, 0x5d, 0x5e, 0x53, 0x66, 0x87,
+        0x1f, 0x25, 0x02, 0x76, 0xd7, 0xff, 0x9d, 0x3f,
+        0x19, 0xa3, 0xed, 0xd2, 0x6d, 0x90, 0xd5, 0xc5,
+        0x92, 0x37, 0x25, 0xc7, 0x03, 0x3a, 0x59, 0xa7,
+        0x49, 0xcf, 0xfd, 0xe5, 0x6a, 0x0b, 0x37, 0xe3,
+        0xe3, 0x8c, 0x1f, 0x3f, 0x4b, 0x79, 0x96, 0xdd,
+        0xf8, 0xdd, 0x1e, 0xc1, 0x12, 0xa1, 0x8a, 0xc1,
+        0xd8, 0x31, 0xf6, 0xe3, 0x56, 0xd9, 0x6d, 0x10,
+        0x49, 0x22, 0xa9, 0x7b, 0x6d, 0x2d, 0xb4, 0x4c,
+        0x7e, 0x59, 0x29, 0x68, 0xc7, 0xca, 0x27, 0x86,
+        0xf8, 0x5b, 0xb7, 0xc0, 0xa5, 0xb8, 0x74, 0x00,
+        0xa5, 0x9e, 0x58, 0xc5, 0x49, 0x27, 0x09, 0x90,
+        0x3a, 0xa7, 0x56, 0x67, 0x02, 0xcc, 0x54, 0x89,
+        0x6b, 0xd5, 0x12, 0xc8, 0xa7, 0xe3, 0x2f, 0x2b,
+        0x82, 0x1e, 0x7c, 0xc6, 0x49, 0x20, 0xef, 0x22,
+        0x1f, 0x78, 0xfa, 0x34, 0xd5, 0xa9, 0xeb, 0x76,
+        0x73, 0x1d, 0x48, 0x7d, 0x8b, 0xc7, 0x60, 0xdd,
+        0x1c, 0x14, 0x88, 0xd9, 0x86, 0x44, 0x70, 0xc7,
+        0xe5, 0x85, 0xec, 0xc8, 0xa2, 0x1c, 0x49, 0xe6,
+        0x1c, 0xe5, 0x1d, 0x84, 0x1d, 0xd7, 0x53, 0x9e,
+        0xaa, 0x36, 0xda, 0x7f, 0x80, 0xaa, 0xd7, 0x3c,
+        0xae, 0xac, 0x84, 0x09, 0x23, 0x8a, 0xdb, 0xd1,
+        0xf8, 0x77, 0x70, 0x15, 0x5d, 0x93, 0xf5, 0xde,
+        0x72, 0xe1, 0xc5, 0x09, 0x49, 0xce, 0x2f, 0x01,
+        0x7e, 0xee, 0x09, 0x18, 0xba, 0x70, 0x83, 0x57,
+        0x76, 0x3f, 0x8c, 0xf4, 0xe2, 0x4e, 0x55, 0x68,
+        0xf6, 0xa6, 0xfe, 0xa5, 0x34, 0xc0, 0x02, 0x15,
+        0x7d, 0x15, 0x83, 0xa5, 0x3d, 0x30, 0xd3, 0xd1,
+        0x0c
+};
+
+static const uint8_t GCM_SIV_TAG7[] = {
+        0xc7, 0x41, 0x76, 0x0b, 0x29, 0xf1, 0x55, 0xb6,
+        0x3f, 0x37, 0xa4, 0xdd, 0x2f, 0xab, 0xc8, 0xc4
+};
+
+static const uint8_t GCM_SIV_CT8[] = {
+        0x07, 0x5d, 0x2e, 0x89, 0x43, 0x74, 0xf1, 0x36,
+        0xe6, 0x35, 0x83, 0xa1, 0x6a, 0x5b, 0xb4, 0x98,
+        0x24, 0x86, 0xe1, 0x8d, 0x32, 0xb9, 0x18, 0x50,
+        0x8a, 0x00, 0xa5, 0x59, 0xbc, 0x65, 0xd7, 0xf2,
+        0x3e, 0xc7, 0xc3, 0x1c, 0xc8, 0xfc, 0x68, 0x29,
+        0x35, 0x85, 0x28, 0x21, 0x23, 0x35, 0xf3, 0xb0,
+        0xf4, 0x32, 0x97, 0x0a, 0xa8, 0xfc, 0xd5, 0xb3,
+        0x1c, 0x28, 0xc8, 0x2f, 0xe6, 0x5c, 0xca, 0x90,
+        0x09, 0x5c, 0x59, 0x52, 0xf9, 0x7e, 0xd5, 0x27,
+        0xbc, 0x47, 0xe9, 0x54, 0xc3, 0xf2, 0x3f, 0xc4,
+        0x7b, 0x8f, 0x7b, 0xd5, 0xc8, 0xc5, 0x66, 0xf3,
+        0x2b, 0x8d, 0x3a, 0x9a, 0x82, 0x46, 0x0a, 0x03,
+        0x65, 0x1b, 0x03, 0xf5, 0xbd, 0x25, 0x4d, 0x70,
+        0x4d, 0x96, 0xfc, 0x50, 0xa8, 0xcd, 0x9b, 0xa5,
+        0x50, 0xcf, 0xe4, 0x78, 0xc6, 0xc3, 0x05, 0x49,
+        0xe8, 0x38, 0x60, 0x35, 0x7c, 0x46, 0x24, 0x66,
+        0xc6, 0x04, 0x82, 0x1a, 0x76, 0xb6, 0xc9, 0xa2,
+        0xa6, 0x73, 0x9e, 0xfd, 0x00, 0x16, 0xc9, 0xa2,
+        0x8f, 0x2c, 0x05, 0x56, 0x41, 0x5f, 0x50, 0x21,
+        0x84, 0x1c, 0x6f, 0x4a, 0xce, 0x74, 0x15, 0x5a,
+        0x39, 0x79, 0x81, 0xb7, 0xa5, 0x27, 0x89, 0xa7,
+        0xc7, 0x51, 0x72, 0x65, 0x2b, 0x4f, 0xbf, 0xd5,
+        0xd2, 0x51, 0xeb, 0xed, 0xb2, 0x21, 0x28, 0xc7,
+        0x59, 0xaa, 0x0f, 0x71, 0x6c, 0x30, 0x49, 0x0d,
+        0x8a, 0x67, 0x2e, 0xe4, 0xba, 0x8f, 0x1c, 0x23,
+        0xdc, 0xad, 0x8a, 0xb6, 0x9e, 0x1b, 0xd8, 0x4c,
+        0x48, 0x80, 0x7d, 0x4f, 0x5a, 0x2b, 0x4e, 0x97,
+        0x2a, 0x11, 0x2b, 0x6f, 0x09, 0xff, 0x8c, 0x31,
+        0x21, 0xf8, 0xaa, 0xda, 0x10, 0x90, 0xe9, 0x68,
+        0x8c, 0xf5, 0xb4, 0x4f, 0xc1, 0xb1, 0xce, 0xae,
+        0xbd, 0xdc, 0x10, 0x5f, 0x7f, 0x9a, 0xcc, 0x78,
+        0x7f, 0x5a, 0x27, 0x4b, 0x98, 0xa8, 0xfa, 0x90,
+        0x17, 0xac, 0x93, 0x8c, 0x1f, 0x5d, 0xb6, 0x4a,
+        0x71, 0x4e, 0x61, 0xc4, 0x64, 0x86, 0xaf, 0xc7,
+        0x6b, 0xfe, 0x82, 0xcd, 0x5a, 0x0e, 0x8a, 0x41,
+        0xb9, 0x51, 0x58, 0x6d, 0xa9, 0xf9, 0xf6, 0x98,
+        0x25, 0x27, 0x40, 0xee, 0xc7, 0x06, 0xbc, 0x0d,
+        0xf8, 0x8a, 0x46, 0x93, 0x56, 0x6e, 0x9a, 0xc7,
+        0x72, 0xd6, 0x8a, 0xab, 0x3f, 0xcf, 0xa1, 0xde,
+        0xb5, 0x85, 0x69, 0x0c, 0x66, 0xef, 0x88, 0x48,
+        0x9f, 0x2b, 0x45, 0x79, 0xec, 0x39, 0xa5, 0x3b,
+        0x41, 0x96, 0xd5, 0x76, 0x66, 0x58, 0x42, 0xb5,
+        0xf1, 0x8c, 0xa8, 0xe5, 0x29, 0x62, 0x49, 0xc1,
+        0x0d, 0xe2, 0x27, 0x76, 0x52, 0xb3, 0x21, 0x10,
+        0x3c, 0x63, 0xf4, 0x71, 0x93, 0x11, 0x02, 0x79,
+        0x67, 0xad, 0x8a, 0xf6, 0x23, 0xc2, 0x5a, 0x15,
+        0x2d, 0x60, 0x03, 0x23, 0x31, 0x46, 0x98, 0x8d,
+        0xd7, 0xf8, 0xe9, 0xd3, 0x41, 0x12, 0x9c, 0x05,
+        0xc0, 0xc9, 0xc1, 0x81, 0x27, 0x5c, 0x26, 0x4c,
+        0xd0, 0xe4, 0x60, 0x19, 0xc3, 0x8c, 0x7f, 0xd3,
+        0xb1, 0x05, 0x28, 0xba, 0x4b, 0x92, 0x33, 0x6a,
+        0xc8, 0x8b, 0x1a, 0x6d, 0xb8, 0xf8, 0x9e, 0x3f,
+        0x7a, 0x40, 0xdc, 0x7f, 0x43, 0x8f, 0x91, 0x71,
+        0x30, 0x66, 0x0d, 0xdf, 0xf2, 0xed, 0x31, 0x78,
+        0x08, 0xe8, 0x30, 0x16, 0x12, 0xc9, 0x9a, 0x5e,
+        0x78, 0x76, 0xee, 0x57, 0xb6, 0x38, 0xcc, 0x1e,
+        0xcf, 0x13, 0x5e, 0x9a, 0x93, 0xdd, 0xdb, 0x4e,
+        0xd7, 0x9d, 0x7a, 0xf1, 0xdc, 0x68, 0x78, 0x34,
+        0x4b, 0x3c, 0xcf, 0xc3, 0x9f, 0xd8, 0x87, 0xad,
+        0x96, 0x4b, 0xe5, 0x9e, 0x06, 0xe5, 0xda, 0x7b,
+        0x78, 0x59, 0x51, 0x0b, 0xdd, 0x83, 0x78, 0xed,
+        0x6a, 0xdf, 0x42, 0xe1, 0x6c, 0xcc, 0x04, 0xab,
+        0xb1, 0x3f, 0x12, 0xa5, 0x59, 0x07, 0x83, 0xa8,
+        0x31, 0x8b, 0x9f, 0xd6, 0x8f, 0x65, 0x7b, 0x18,
+        0xec, 0x2e, 0xfb, 0xbb, 0x6f, 0xac, 0xbb, 0x61,
+        0x41, 0x2f, 0x1d, 0x5a, 0x80, 0xf2, 0xaa, 0xb6,
+        0x3a, 0x69, 0xe2, 0x7e, 0x70, 0xff, 0x55, 0x2e,
+        0x56, 0xe9, 0xce, 0xab, 0x90, 0xb7, 0x16, 0x9c,
+        0xaf, 0x47, 0x10, 0xb5, 0x2e, 0xaa, 0x2a, 0xcf,
+        0x15, 0xa8, 0x4c, 0xc8, 0x93, 0x5e, 0xa0, 0xa3,
+        0x37, 0x39, 0x76, 0x48, 0x86, 0x49, 0xcc, 0x9e,
+        0x3e, 0x09, 0xfd, 0xcb, 0xaf, 0xea, 0x4f, 0x40,
+        0x9b, 0x68, 0x2c, 0x45, 0xfe, 0x3d, 0x46, 0x15,
+        0x98, 0x98, 0x66, 0x1a, 0xff, 0x11, 0x52, 0x9b,
+        0xda, 0x4e, 0x69, 0x87, 0xbc, 0xc7, 0x76, 0x0a,
+        0x2f, 0x20, 0xbe, 0x36, 0xce, 0x4c, 0xbf, 0x12,
+        0xdf, 0xbe, 0xea, 0x28, 0xb5, 0x82, 0x6a, 0xc7,
+        0x02, 0x72, 0xc1, 0x8d, 0x42, 0x36, 0x0e, 0x5f,
+        0xd9, 0x43, 0x5a, 0xf2, 0x4b, 0x74, 0xdf, 0xca,
+        0x76, 0x1c, 0x9c, 0xb7, 0x45, 0xb1, 0x99, 0x39,
+        0xed, 0x2f, 0xa0, 0x3d, 0x60, 0x10, 0x31, 0x0f,
+        0xaa, 0xd2, 0x7f, 0x85, 0x09, 0x61, 0x76, 0x89,
+        0x53, 0xf0, 0xd1, 0x34, 0xcc, 0x52, 0x6f, 0x56,
+        0xc8, 0x3f, 0x24, 0x72, 0x27, 0xa0, 0x95, 0x47,
+        0x82, 0x6a, 0x8d, 0x0d, 0x8a, 0xc1, 0xad, 0x44,
+        0x19, 0x2d, 0x75, 0x36, 0x5b, 0x70, 0xfe, 0xc0,
+        0x26, 0xf4, 0xc8, 0x6d, 0x52, 0xaa, 0x08, 0x54,
+        0x76, 0x39, 0xcc, 0x87, 0x2b, 0xb2, 0xff, 0x60,
+        0x61, 0x58, 0xb9, 0xa0, 0x48, 0x0f, 0xcb, 0x02,
+        0x6b, 0xdb, 0xbf, 0x17, 0x1b, 0x8b, 0xdf, 0x63,
+        0xbb, 0x73, 0x30, 0xbc, 0xf7, 0x59, 0xc5, 0xc2,
+        0xb8, 0x94, 0x18, 0x52, 0x42, 0x6e, 0x65, 0x4b,
+        0x04, 0xc6, 0x31, 0x50, 0xfa, 0x93, 0xd5, 0xc4,
+        0x0d, 0x62, 0x6d, 0xdc, 0xce, 0x30, 0x0e, 0xe6,
+        0x5d, 0xf6, 0x6b, 0xfe, 0xdc, 0x2c, 0x0e, 0x38,
+        0x95, 0x0c, 0x00, 0x66, 0xbc, 0x4a, 0xf1, 0x3b,
+        0x41, 0x28, 0x42, 0x8c, 0x01, 0x14, 0x14, 0xe9,
+        0x23, 0xa7, 0x53, 0x5f, 0x91, 0x79, 0x8a, 0x74,
+        0x8e, 0x05, 0x00, 0x59, 0xf6, 0x08, 0xd0, 0x71,
+        0x43, 0xd9, 0x0e, 0xbe, 0x80, 0x94, 0x3b, 0xbf,
+        0xe8, 0x21, 0xf3, 0xaf, 0x0f, 0x17, 0x9e, 0x07,
+        0x6f, 0xf6, 0x2b, 0x2f, 0xfc, 0x07, 0xb5, 0x84,
+        0x92, 0x43, 0x33, 0x8e, 0x8a, 0x11, 0xd3, 0x70,
+        0x8d, 0x60, 0xd3, 0x7a, 0x0a, 0xa6, 0x02, 0xf2,
+        0xc7, 0x49, 0xd2, 0x0a, 0x29, 0xec, 0x99, 0xfb,
+        0xa4, 0xa7, 0x7b, 0xbb, 0x85, 0x30, 0x0c, 0xdb,
+        0x32, 0x91, 0x31, 0xd5, 0xfe, 0xfd, 0xf0, 0x21,
+        0xcf, 0xf5, 0x24, 0xcf, 0xbc, 0x52, 0x8e, 0xc2,
+        0x87, 0x67, 0x9f, 0x46, 0x35, 0x7c, 0x66, 0xdd,
+        0x1d, 0xe6, 0x50, 0x00, 0xb0, 0x1e, 0x2d, 0xa2,
+        0x7f, 0x07, 0xbf, 0x5c, 0x8c, 0x37, 0x3d, 0xcf,
+        0xe6, 0x4f, 0x34, 0xbd, 0x58, 0x05, 0x61, 0xf3,
+        0x49, 0x45, 0x8c, 0xa9, 0x60, 0x25, 0xdd, 0x41,
+        0x9d, 0xfc, 0xc4, 0x95, 0xc8, 0x66, 0x67, 0xa3,
+        0xfd, 0x92, 0xa4, 0xf0, 0xb4, 0x89, 0x43, 0x33,
+        0xd4, 0xb6, 0xfa, 0x78, 0x8f, 0xdf, 0xc2, 0x49,
+        0xc1, 0xad, 0xc9, 0x74, 0x12, 0x6d, 0x02, 0xb1,
+        0xc3, 0x33, 0xe1, 0x47, 0xc2, 0x88, 0xd5, 0xeb,
+        0xa2, 0xe7, 0xa1, 0xb2, 0x7d, 0xd2, 0x88, 0x3f,
+        0xfc, 0xe0, 0x49, 0xb8, 0x11, 0x2f, 0x85, 0xe3,
+        0x10, 0xb2, 0xb7, 0x8c, 0x45, 0x3a, 0x93, 0xa5,
+        0x44, 0x8a, 0xdf, 0x6a, 0x6f, 0x59, 0xcb, 0x5e,
+        0xb3, 0x14, 0x68, 0x07, 0x76, 0x54, 0x3b, 0xad,
+        0x89, 0x59, 0xfd, 0x55, 0x76, 0xfd, 0xd8, 0xe7,
+        0xbc, 0x9f, 0x30, 0x28, 0xcb, 0xea, 0x0b, 0xcb
+};
+
+static const uint8_t GCM_SIV_TAG8[] = {
+        0x84, 0x80, 0x94, 0xa6, 0xfd, 0x77, 0x75, 0xbe,
+        0xb6, 0x06, 0x19, 0x74, 0xea, 0x2a, 0xee, 0x14
+};
+
+static const uint8_t GCM_SIV_TAG9[] = {
+        0x08, 0x39, 0x38, 0x6b, 0xb4, 0x25, 0x25, 0x39,
+        0x4f, 0xbd, 0x6e, 0x32, 0xb0, 0xed, 0x04, 0x5a
+};
+
+static const uint8_t GCM_SIV_CT10[] = {
+        0x11, 0xaf, 0x23, 0x77, 0xe6, 0x57, 0x7b, 0xf0,
+        0x3c, 0x6e, 0x98, 0xf1
+};
+
+static const uint8_t GCM_SIV_TAG10[] = {
+        0x3e, 0x74, 0x1c, 0x31, 0xf4, 0x8b, 0x67, 0x26,
+        0x5d, 0x84, 0x18, 0x5e, 0x32, 0xae, 0x09, 0x7b
+};
+
+static const uint8_t GCM_SIV_CT11[] = {
+        0xb2, 0xce, 0xe0, 0x81, 0x04, 0x1b, 0x6a, 0x02,
+        0x6d, 0x31, 0x23, 0xbe, 0x59, 0x78, 0x42, 0xfa
+};
+
+static const uint8_t GCM_SIV_TAG11[] = {
+        0xb1, 0xf6, 0x0b, 0x08, 0x3e, 0x52, 0xb2, 0x2e,
+        0x7c, 0xb5, 0x0a, 0x55, 0x5e, 0x59, 0x03, 0x98
+};
+
+static const uint8_t GCM_SIV_CT12[] = {
+        0x70, 0xa1, 0x80, 0xe3, 0xeb, 0xea, 0xfc, 0xc9,
+        0x5d, 0x21, 0xfa, 0x31, 0x06, 0x87, 0xbe, 0x69,
+        0xb3, 0x85, 0x3b, 0xbb, 0xc6, 0xba, 0xc6, 0xba,
+        0xb2, 0x92, 0xbc, 0xe0, 0x4b, 0x4f, 0x10, 0xa4,
+        0x72, 0xbc, 0x1e, 0xc9, 0x79, 0x61, 0x5d, 0x84,
+        0x29, 0xaa, 0xf8, 0xf0, 0x36, 0x93, 0x22, 0xa8,
+        0xb7, 0x5e, 0x89, 0x09, 0xdd, 0xca, 0x96, 0x11,
+        0x7a, 0xcc, 0x50, 0xa5, 0x2a, 0x74, 0xe3
+};
+
+static const uint8_t GCM_SIV_TAG12[] = {
+        0x0c, 0x7c, 0x25, 0xbe, 0x49, 0x17, 0x31, 0x93,
+        0x91, 0x04, 0x20, 0x99, 0x75, 0x6d, 0x78, 0xf5
+};
+
+static const uint8_t GCM_SIV_CT13[] = {
+        0xc4, 0x74, 0xaf, 0x4d, 0xca, 0x7c, 0x5e, 0x1c,
+        0x41, 0x1b, 0xac, 0x62, 0x95, 0xa8, 0x9c, 0x73,
+        0x86, 0x2f, 0x10, 0x29, 0x7f, 0x4f, 0x79, 0xca,
+        0x67, 0x72, 0x91, 0x3d, 0x14, 0x6d, 0x28, 0x89,
+        0x79, 0x61, 0x19, 0x89, 0x12, 0x22, 0x6a, 0x4f,
+        0x2f, 0x59, 0xb3, 0x4f, 0xa9, 0xd1, 0x80, 0x7a,
+        0x45, 0x2e, 0x8c, 0xb3, 0x32, 0xe7, 0xe3, 0xa9,
+        0xe9, 0xe9, 0x7b, 0x79, 0x91, 0xc9, 0x6b, 0xf6,
+        0xa0, 0x97, 0xa7, 0x01, 0x54, 0xb4, 0x0b, 0xac,
+        0x81, 0xeb, 0xc7, 0xf8, 0xac, 0x49, 0x2d, 0x47,
+        0x5a, 0x5c, 0x24, 0x80, 0xc2, 0x26, 0x15, 0x48,
+        0xd9, 0xe9, 0x7b, 0x5d, 0xe8, 0x61, 0x6a, 0x49,
+        0xce, 0xea, 0xc9, 0xc9, 0xc1, 0x76, 0xe7, 0x89,
+        0xca, 0xaa, 0xe1, 0x9e, 0xaf, 0x11, 0x6c, 0x07,
+        0xcf, 0xab, 0x25, 0xf5, 0x10, 0x97, 0x99, 0x42,
+        0x94, 0x50, 0xb7, 0x65, 0xd5, 0x88, 0x14, 0xfa,
+        0x4b, 0x5d, 0x75, 0xed, 0x33, 0x0c, 0x2e, 0xa1,
+        0x6a, 0x35, 0x03, 0xac, 0x59, 0xac, 0xb6, 0x5c,
+        0xe7, 0xd8, 0xe0, 0x68, 0x27, 0xfa, 0x38, 0x45,
+        0xd2, 0x0b, 0x5f, 0x7e, 0xbd, 0x04, 0x3b, 0xc4,
+        0x43, 0x8c, 0x7b, 0x42, 0x02, 0x1a, 0x81, 0x2d,
+        0x8d, 0xa0, 0x5c, 0xbb, 0xcd, 0xeb, 0x2b, 0xf6,
+        0x17, 0x28, 0x18, 0xb8, 0xc4, 0xd1, 0x65, 0x8f,
+        0x46, 0xec, 0x6b, 0x75, 0xda, 0x84, 0xba, 0x74,
+        0xcc, 0x05, 0x31, 0xf9, 0x9b, 0xbf, 0x21, 0xa8,
+        0xfd, 0x46, 0x75, 0xd6, 0x43, 0x90, 0xbf, 0xb0,
+        0x3a, 0x2b, 0xf2, 0xd7, 0xbb, 0xcf, 0xea, 0x36,
+        0x08, 0xd9, 0x5c, 0x7e, 0xea, 0x88, 0x62, 0x67,
+        0xc6, 0x11, 0x99, 0x76, 0x06, 0x04, 0x91, 0x1c,
+        0xbe, 0x57, 0x15, 0x7d, 0x58, 0x83, 0xde, 0x8d,
+        0x4c, 0x06, 0xed, 0x2f, 0xa0, 0xd4, 0x7b, 0x05,
+        0xba, 0xae, 0x24, 0x6b, 0x92, 0x4c, 0x3d, 0x5d,
+        0x10
+};
+
+static const uint8_t GCM_SIV_TAG13[] = {
+        0x8a, 0x55, 0x7f, 0xc2, 0x85, 0xee, 0x15, 0x40,
+        0xbc, 0x7b, 0x20, 0x6a, 0xd0, 0x06, 0x8c, 0xd9
+};
+
+static const uint8_t GCM_SIV_CT14[] = {
+        0xd4, 0x38, 0xf4, 0xb7, 0xa1, 0x65, 0xe8, 0x9f,
+        0x6a, 0x1b, 0xd6, 0x79, 0xf6, 0x5d, 0x83, 0xce,
+        0xa6, 0xd2, 0x75, 0x9c, 0xd8, 0x9b, 0x08, 0x9e,
+        0x1a, 0x90, 0xca, 0x58, 0x60, 0xe7, 0x0a, 0x89,
+        0x0c, 0x75, 0x16, 0xea, 0x49, 0xb9, 0xa5, 0x6f,
+        0x6a, 0xfc, 0x2f, 0xf8, 0xad, 0xd7, 0xff, 0x32,
+        0xf1, 0xba, 0xb6, 0x40, 0x51, 0xb4, 0x27, 0xf8,
+        0x64, 0xc2, 0xf9, 0xbc, 0x2b, 0x36, 0x54, 0x61,
+        0x9c, 0xea, 0x2b, 0x1e, 0x94, 0xf8, 0x75, 0xd9,
+        0x4e, 0xf3, 0x9a, 0xba, 0xcb, 0xc1, 0x54, 0x04,
+        0x08, 0x54, 0xcc, 0x95, 0x2a, 0x09, 0x0a, 0x7e,
+        0xd8, 0x8d, 0xcb, 0x37, 0xa3, 0x28, 0x19, 0x30,
+        0x74, 0xeb, 0x46, 0xfd, 0xa7, 0x9f, 0x95, 0xe4,
+        0xfa, 0x6c, 0x20, 0x9f, 0x5f, 0x4a, 0x06, 0x7e,
+        0x17, 0x12, 0xfe, 0xba, 0x3b, 0xbd, 0xba, 0xab,
+        0x78, 0x17, 0xbe, 0xc7, 0xb3, 0xec, 0x8e, 0xbe,
+        0x9e, 0x9c, 0xdb, 0x65, 0xb6, 0x4a, 0x39, 0xbc,
+        0x9e, 0xc7, 0x31, 0xc4, 0x2f, 0xe1, 0x01, 0x90,
+        0xf2, 0x6a, 0x07, 0x8d, 0x8f, 0xfc, 0x5a, 0x5d,
+        0xe4, 0x38, 0x0f, 0xb0, 0x7c, 0x23, 0x22, 0xdf,
+        0x39, 0x56, 0xcf, 0x32, 0xdb, 0x93, 0x31, 0x9f,
+        0x76, 0xe5, 0x16, 0x96, 0x32, 0xaa, 0x19, 0x7c,
+        0x0a, 0x4a, 0x78, 0x65, 0x9b, 0x00, 0xe8, 0x25,
+        0x6c, 0x86, 0xff, 0x4e, 0x75, 0x38, 0xd7, 0x61,
+        0x2d, 0xc1, 0x36, 0x75, 0x5d, 0x17, 0xf8, 0xf7,
+        0x2a, 0x8f, 0x06, 0x93, 0xe0, 0x65, 0x60, 0x90,
+        0xfd, 0x34, 0x8a, 0x66, 0x5c, 0x11, 0xfe, 0x17,
+        0xac, 0x58, 0xfb, 0x06, 0xc3, 0xd0, 0x82, 0x18,
+        0xc4, 0x40, 0x14, 0xf3, 0x78, 0xbc, 0xb4, 0xc8,
+        0xd3, 0x77, 0x14, 0xfe, 0x26, 0x84, 0x38, 0xd2,
+        0x65, 0x96, 0x53, 0x63, 0xdf, 0xda, 0xdd, 0x40,
+        0xa2, 0xf0, 0x08, 0xf8, 0xb0, 0x75, 0x2a, 0xdd,
+        0xf2, 0x3a, 0x7e, 0xf2, 0x7b, 0x40, 0xe6, 0x5c,
+        0xf6, 0xb2, 0xc6, 0x70, 0xbb, 0xf1, 0xa2, 0xc1,
+        0x31, 0xe1, 0x3f, 0x0c, 0x6e, 0x5d, 0xf5, 0x7e,
+        0x8e, 0xb9, 0xbb, 0x83, 0xca, 0xfb, 0x14, 0x71,
+        0xdd, 0x06, 0xa0, 0xd3, 0xf6, 0xf5, 0x81, 0x1d,
+        0xf0, 0xb8, 0x11, 0x97, 0xc9, 0x0f, 0xaf, 0x68,
+        0x88, 0x75, 0x3f, 0xc8, 0xce, 0x3b, 0xda, 0xa4,
+        0xc9, 0xb5, 0x62, 0x49, 0x48, 0x85, 0x3e, 0x82,
+        0xed, 0x34, 0x87, 0xfb, 0x65, 0x58, 0x9b, 0x98,
+        0x3b, 0xd1, 0xdd, 0x51, 0x77, 0x0e, 0x48, 0xa2,
+        0x0d, 0x78, 0x21, 0x79, 0x8c, 0x30, 0x7f, 0x81,
+        0x08, 0x31, 0x5e, 0x29, 0xc2, 0x23, 0x00, 0x75,
+        0xe5, 0xc7, 0xef, 0x45, 0xb8, 0x01, 0x9a, 0x6f,
+        0x52, 0xe4, 0xca, 0x56, 0xe9, 0x3c, 0x08, 0xeb,
+        0xbe, 0xf8, 0x0a, 0x82, 0x58, 0x50, 0xff, 0x50,
+        0x0e, 0xf2, 0x21, 0xcc, 0xf5, 0xb4, 0xd0, 0x3b,
+        0x87, 0xa7, 0x25, 0xfd, 0xde, 0x9c, 0x7e, 0x23,
+        0xc0, 0x40, 0x38, 0xaf, 0x78, 0x1f, 0xe7, 0xb1,
+        0xb2, 0x11, 0x70, 0x6b, 0xd3, 0x76, 0xc3, 0x22,
+        0x83, 0x34, 0xaa, 0x73, 0x11, 0x7c, 0x05, 0xf1,
+        0x38, 0x24, 0x04, 0xee, 0x7a, 0xee, 0xad, 0xbe,
+        0x3c, 0xd8, 0xdb, 0x9e, 0x64, 0x28, 0x27, 0xc5,
+        0x1a, 0x75, 0x89, 0x5e, 0x96, 0x48, 0x15, 0x8f,
+        0x7f, 0x88, 0x2d, 0xc7, 0xe0, 0x3f, 0x21, 0x94,
+        0xa0, 0x3c, 0x55, 0xe4, 0x39, 0xaa, 0xe7, 0x44,
+        0xd1, 0xa5, 0xec, 0xb3, 0x6e, 0xc5, 0xa8, 0x62,
+        0x7a, 0xcd, 0x8f, 0x03, 0xd5, 0x1d, 0x12, 0xa5,
+        0x07, 0x19, 0x16, 0x30, 0x48, 0x23, 0x44, 0x16,
+        0xf6, 0x35, 0xbf, 0x45, 0xe5, 0x36, 0xa6, 0x26,
+        0xde, 0x9b, 0x40, 0xb8, 0x49, 0x02, 0x34, 0x36,
+        0x5e, 0x00, 0x0a, 0x80, 0x39, 0x3a, 0x82, 0x42,
+        0xc9, 0xe4, 0xd3, 0x52, 0xef, 0xf7, 0x31, 0x68,
+        0x1d, 0xf3, 0xf0, 0x42, 0x5a, 0x42, 0x91, 0xc8,
+        0xf4, 0xc9, 0x82, 0x30, 0x19, 0x53, 0x2a, 0x7f,
+        0xc1, 0x47, 0x5a, 0x75, 0xa5, 0xa5, 0xf5, 0x9a,
+        0xde, 0xa3, 0x75, 0x65, 0xdc, 0x06, 0xaa, 0xed,
+        0x3f, 0x91, 0x63, 0x69, 0xd9, 0x14, 0x88, 0x75,
+        0x7f, 0xa5, 0x27, 0x7f, 0xed, 0x51, 0x4f, 0x78,
+        0x93, 0x41, 0x73, 0x11, 0xc7, 0xcd, 0xd4, 0xec,
+        0xd5, 0xab, 0x47, 0xe7, 0x2c, 0x10, 0x5c, 0x73,
+        0x0b, 0x74, 0x48, 0xbe, 0x1e, 0xdb, 0x81, 0xcc,
+        0xb5, 0xd8, 0x09, 0x92, 0x4c, 0x44, 0x4a, 0xa1,
+        0x91, 0xb2, 0xf1, 0x2f, 0x31, 0x5c, 0x6b, 0x36,
+        0xea, 0x58, 0xe2, 0x1e, 0xe8, 0xa2, 0x9b, 0x2e,
+        0x24, 0x98, 0x3a, 0x8b, 0x3d, 0x02, 0x43, 0x97,
+        0xe7, 0x6d, 0x4a, 0x04, 0x16, 0x02, 0xe4, 0xca,
+        0xee, 0xda, 0xa6, 0xdb, 0x99, 0x20, 0x84, 0x1a,
+        0x15, 0x0a, 0x53, 0x7c, 0x9e, 0x92, 0xe3, 0x2a,
+        0x9c, 0x8e, 0x64, 0xa0, 0x2c, 0x15, 0x3d, 0x1c,
+        0x0b, 0xb9, 0xfa, 0x63, 0x16, 0xa5, 0x2e, 0x37,
+        0xf4, 0x5d, 0x20, 0xb5, 0x95, 0x79, 0x7c, 0x58,
+        0x21, 0xa8, 0x1f, 0x00, 0x7f, 0xd2, 0xc5, 0xf8,
+        0xe1, 0x67, 0x9f, 0x0b, 0x48, 0xe9, 0x0a, 0x78,
+        0x14, 0xd7, 0x73, 0x4f, 0x1c, 0x47, 0x7d, 0xf8,
+        0xbd, 0x3c, 0x3b, 0xff, 0xe4, 0x2a, 0x21, 0xb3,
+        0xaf, 0x44, 0x1f, 0xa2, 0x9d, 0x21, 0x32, 0x6a,
+        0x1a, 0x7d, 0xa0, 0xc2, 0x94, 0xd2, 0x75, 0x90,
+        0xa5, 0xf0, 0x8e, 0xff, 0x3a, 0x97, 0xa0, 0xa1,
+        0xf3, 0x29, 0x58, 0xef, 0x07, 0x6a, 0x17, 0x45,
+        0x55, 0x8e, 0x91, 0x8e, 0x05, 0x03, 0x64, 0xb8,
+        0x13, 0x8d, 0x02, 0xdf, 0x7b, 0xe5, 0x23, 0x50,
+        0x27, 0x80, 0x33, 0xda, 0xb0, 0x30, 0x3e, 0x05,
+        0x65, 0x47, 0x9a, 0xd2, 0x54, 0x6a, 0x0a, 0xf7,
+        0xee, 0x68, 0x05, 0xfb, 0xfa, 0x96, 0xed, 0xbf,
+        0x5b, 0x46, 0xf3, 0x4c, 0xe9, 0x3a, 0x6c, 0x98,
+        0xe2, 0x91, 0xcd, 0x94, 0x5b, 0x46, 0xd1, 0x94,
+        0xc7, 0xaf, 0x4f, 0x10, 0x70, 0xed, 0xbf, 0x3c,
+        0xa3, 0x62, 0x6f, 0xdb, 0x0d, 0x37, 0x9e, 0xc7,
+        0xb4, 0xa5, 0x27, 0x23, 0x5a, 0xf0, 0x8d, 0x0e,
+        0xda, 0x62, 0x37, 0x70, 0x1f, 0x8c, 0x41, 0xab,
+        0x6c, 0xff, 0x04, 0xab, 0x43, 0x6a, 0xcb, 0x5f,
+        0xea, 0x5f, 0x09, 0x71, 0xfc, 0xa0, 0x83, 0x10,
+        0xea, 0xc9, 0x63, 0x58, 0x7b, 0x99, 0xee, 0x75,
+        0x1a, 0x95, 0x7d, 0x0a, 0xa9, 0xcb, 0x36, 0x9b,
+        0x89, 0x8b, 0x2a, 0x5d, 0xfe, 0x95, 0xe3, 0x54,
+        0xea, 0xb6, 0x5e, 0x9b, 0x3c, 0x80, 0x9a, 0x9e,
+        0xca, 0xeb, 0xa4, 0x8c, 0xe1, 0xa2, 0xe1, 0x3a,
+        0x4e, 0x3a, 0xa7, 0xcb, 0x72, 0x09, 0xa3, 0x92,
+        0xab, 0xd2, 0x6c, 0xfa, 0x29, 0x40, 0x12, 0x34,
+        0xa4, 0x85, 0x89, 0xf2, 0x5d, 0xdf, 0x2f, 0xcc,
+        0x9b, 0x7a, 0x1b, 0xb1, 0xc2, 0x80, 0x1a, 0x06,
+        0x9a, 0xc9, 0x95, 0x17, 0xc4, 0x87, 0xd6, 0x66,
+        0xb1, 0x59, 0xb3, 0xd0, 0xb7, 0x75, 0x3f, 0x19,
+        0x3b, 0xcd, 0x36, 0xb8, 0x59, 0x3d, 0xf6, 0xc0,
+        0xc3, 0xbf, 0xc9, 0x55, 0x44, 0xcc, 0x91, 0x44,
+        0x73, 0xff, 0xeb, 0x84, 0x58, 0x57, 0xf7, 0xfa,
+        0x56, 0xfb, 0x76, 0x99, 0xfd, 0x81, 0x15, 0x37,
+        0xa8, 0x05, 0x59, 0xd0, 0x79, 0xf4, 0x46, 0xc2,
+        0xe3, 0x2d, 0xeb, 0x8a, 0xf3, 0x61, 0x4b, 0x29,
+        0x41, 0xd6, 0x03, 0xbb, 0xf6, 0x00, 0xf2, 0xfc,
+        0xa0, 0xcd, 0x5f, 0xe9, 0xdb, 0x7e, 0xf6, 0x27,
+        0xfb, 0x75, 0xa0, 0xe6, 0x0d, 0x56, 0x99, 0x37,
+        0xd8, 0x0e, 0xa4, 0x25, 0xfa, 0x3d, 0x3c, 0x82
+};
+
+static const uint8_t GCM_SIV_TAG14[] = {
+        0x7b, 0xe1, 0x7f, 0x48, 0x5e, 0x71, 0xe5, 0x48,
+        0x0f, 0xdb, 0x6e, 0xa8, 0x0e, 0xce, 0x7b, 0x7a
+};
+
+/*
+ * Expected values above computed with an independent Python implementation
+ * for message bytes (7 * i + 1) mod 256 and AAD bytes (5 * i + 3) mod 256.
+ * Vectors below are from RFC 8452 (appendix C.1 and C.2).
+ */
+static const uint8_t RFC_KEY128[] = {
+        0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+static const uint8_t RFC_KEY256[] = {
+        0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+static const uint8_t RFC_NONCE[] = {
+        0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00
+};
+
+static const uint8_t RFC_PT[] = {
+        0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00
+};
+
+static const uint8_t RFC_TAG1[] = {
+        0xdc, 0x20, 0xe2, 0xd8, 0x3f, 0x25, 0x70, 0x5b,
+        0xb4, 0x9e, 0x43, 0x9e, 0xca, 0x56, 0xde, 0x25
+};
+
+static const uint8_t RFC_CT2[] = {
+        0xb5, 0xd8, 0x39, 0x33, 0x0a, 0xc7, 0xb7, 0x86
+};
+
+static const uint8_t RFC_TAG2[] = {
+        0x57, 0x87, 0x82, 0xff, 0xf6, 0x01, 0x3b, 0x81,
+        0x5b, 0x28, 0x7c, 0x22, 0x49, 0x3a, 0x36, 0x4c
+};
+
+static const uint8_t RFC_CT3[] = {
+        0x73, 0x23, 0xea, 0x61, 0xd0, 0x59, 0x32, 0x26,
+        0x00, 0x47, 0xd9, 0x42
+};
+
+static const uint8_t RFC_TAG3[] = {
+        0xa4, 0x97, 0x8d, 0xb3, 0x57, 0x39, 0x1a, 0x0b,
+        0xc4, 0xfd, 0xec, 0x8b, 0x0d, 0x10, 0x66, 0x39
+};
+
+static const uint8_t RFC_TAG4[] = {
+        0x07, 0xf5, 0xf4, 0x16, 0x9b, 0xbf, 0x55, 0xa8,
+        0x40, 0x0c, 0xd4, 0x7e, 0xa6, 0xfd, 0x40, 0x0f
+};
+
+static const uint8_t RFC_CT5[] = {
+        0xc2, 0xef, 0x32, 0x8e, 0x5c, 0x71, 0xc8, 0x3b
+};
+
+static const uint8_t RFC_TAG5[] = {
+        0x84, 0x31, 0x22, 0x13, 0x0f, 0x73, 0x64, 0xb7,
+        0x61, 0xe0, 0xb9, 0x74, 0x27, 0xe3, 0xdf, 0x28
+};
+
+/*
+ * RFC 8452 appendix C.3 counter wrap tests: all zero 256-bit key and
+ * nonce, the tag (initial counter) makes the 32-bit counter wrap
+ */
+static const uint8_t RFC_WRAP_PT1[] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x4d, 0xb9, 0x23, 0xdc, 0x79, 0x3e, 0xe6, 0x49,
+        0x7c, 0x76, 0xdc, 0xc0, 0x3a, 0x98, 0xe1, 0x08
+};
+
+static const uint8_t RFC_WRAP_CT1[] = {
+        0xf3, 0xf8, 0x0f, 0x2c, 0xf0, 0xcb, 0x2d, 0xd9,
+        0xc5, 0x98, 0x4f, 0xcd, 0xa9, 0x08, 0x45, 0x6c,
+        0xc5, 0x37, 0x70, 0x3b, 0x5b, 0xa7, 0x03, 0x24,
+        0xa6, 0x79, 0x3a, 0x7b, 0xf2, 0x18, 0xd3, 0xea
+};
+
+static const uint8_t RFC_WRAP_PT2[] = {
+        0xeb, 0x36, 0x40, 0x27, 0x7c, 0x7f, 0xfd, 0x13,
+        0x03, 0xc7, 0xa5, 0x42, 0xd0, 0x2d, 0x3e, 0x4c,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+static const uint8_t RFC_WRAP_CT2[] = {
+        0x18, 0xce, 0x4f, 0x0b, 0x8c, 0xb4, 0xd0, 0xca,
+        0xc6, 0x5f, 0xea, 0x8f, 0x79, 0x25, 0x7b, 0x20,
+        0x88, 0x8e, 0x53, 0xe7, 0x22, 0x99, 0xe5, 0x6d
+};
+
+static const uint8_t RFC_WRAP_TAG[] = {
+        0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+static const struct gcm_siv_vector gcm_siv_vectors[] = {
+        { GCM_SIV_KEY128, 16, GCM_SIV_NONCE, gcm_siv_msg, 0,
+          NULL, 0, NULL, GCM_SIV_TAG1 },
+        { GCM_SIV_KEY128, 16, GCM_SIV_NONCE, gcm_siv_msg, 8,
+          NULL, 0, GCM_SIV_CT2, GCM_SIV_TAG2 },
+        { GCM_SIV_KEY128, 16, GCM_SIV_NONCE, gcm_siv_msg, 16,
+          gcm_siv_aad, 12, GCM_SIV_CT3, GCM_SIV_TAG3 },
+        { GCM_SIV_KEY128, 16, GCM_SIV_NONCE, gcm_siv_msg, 17,
+          gcm_siv_aad, 20, GCM_SIV_CT4, GCM_SIV_TAG4 },
+        { GCM_SIV_KEY128, 16, GCM_SIV_NONCE, gcm_siv_msg, 64,
+          NULL, 0, GCM_SIV_CT5, GCM_SIV_TAG5 },
+        { GCM_SIV_KEY128, 16, GCM_SIV_NONCE, gcm_siv_msg, 100,
+          gcm_siv_aad, 13, GCM_SIV_CT6, GCM_SIV_TAG6 },
+        { GCM_SIV_KEY128, 16, GCM_SIV_NONCE, gcm_siv_msg, 257,
+          gcm_siv_aad, 100, GCM_SIV_CT7, GCM_SIV_TAG7 },
+        { GCM_SIV_KEY128, 16, GCM_SIV_NONCE, gcm_siv_msg, 1000,
+          gcm_siv_aad, 33, GCM_SIV_CT8, GCM_SIV_TAG8 },
+        { GCM_SIV_KEY256, 32, GCM_SIV_NONCE, gcm_siv_msg, 0,
+          NULL, 0, NULL, GCM_SIV_TAG9 },
+        { GCM_SIV_KEY256, 32, GCM_SIV_NONCE, gcm_siv_msg, 12,
+          gcm_siv_aad, 1, GCM_SIV_CT10, GCM_SIV_TAG10 },
+        { GCM_SIV_KEY256, 32, GCM_SIV_NONCE, gcm_siv_msg, 16,
+          gcm_siv_aad, 16, GCM_SIV_CT11, GCM_SIV_TAG11 },
+        { GCM_SIV_KEY256, 32, GCM_SIV_NONCE, gcm_siv_msg, 63,
+          gcm_siv_aad, 20, GCM_SIV_CT12, GCM_SIV_TAG12 },
+        { GCM_SIV_KEY256, 32, GCM_SIV_NONCE, gcm_siv_msg, 257,
+          NULL, 0, GCM_SIV_CT13, GCM_SIV_TAG13 },
+        { GCM_SIV_KEY256, 32, GCM_SIV_NONCE, gcm_siv_msg, 1000,
+          gcm_siv_aad, 100, GCM_SIV_CT14, GCM_SIV_TAG14 },
+        { RFC_KEY128, 16, RFC_NONCE, RFC_PT, 0, NULL, 0,
+          NULL, RFC_TAG1 },
+        { RFC_KEY128, 16, RFC_NONCE, RFC_PT, 8, NULL, 0,
+          RFC_CT2, RFC_TAG2 },
+        { RFC_KEY128, 16, RFC_NONCE, RFC_PT, 12, NULL, 0,
+          RFC_CT3, RFC_TAG3 },
+        { RFC_KEY256, 32, RFC_NONCE, RFC_PT, 0, NULL, 0,
+          NULL, RFC_TAG4 },
+        { RFC_KEY256, 32, RFC_NONCE, RFC_PT, 8, NULL, 0,
+          RFC_CT5, RFC_TAG5 },
+};
+
+/* state shared by the job callbacks of gcm_siv_run_jobs() */
+struct gcm_siv_many_ctx {
+        const struct gcm_key_data *keys;
+        uint8_t *bufs;
+        uint8_t *tags;
+        int encrypt;
+};
+
+static void
+gcm_siv_fill_job(struct JOB_AES_HMAC *job, const int n, void *arg)
+{
+        const struct gcm_siv_many_ctx *ctx = arg;
+        const unsigned v = n % DIM(gcm_siv_vectors);
+        const struct gcm_siv_vector *vec = &gcm_siv_vectors[v];
+
+        job->cipher_direction = ctx->encrypt ? ENCRYPT : DECRYPT;
+        job->chain_order = ctx->encrypt ? CIPHER_HASH : HASH_CIPHER;
+        job->cipher_mode = AES_GCM_SIV;
+        job->hash_alg = AES_GCM_SIV_TAG;
+        job->aes_key_len_in_bytes = vec->key_len;
+        job->aes_enc_key_expanded = &ctx->keys[v];
+        job->aes_dec_key_expanded = &ctx->keys[v];
+        job->iv = vec->nonce;
+        job->iv_len_in_bytes = 12;
+        job->dst = &ctx->bufs[n * GCM_SIV_TEST_BUF_SIZE];
+        job->src = ctx->encrypt ? vec->msg : job->dst;
+        job->cipher_start_src_offset_in_bytes = 0;
+        job->msg_len_to_cipher_in_bytes = vec->msg_len;
+        job->hash_start_src_offset_in_bytes = 0;
+        job->msg_len_to_hash_in_bytes = vec->msg_len;
+        job->u.GCM_SIV.aad = vec->aad;
+        job->u.GCM_SIV.aad_len_in_bytes = vec->aad_len;
+        job->u.GCM_SIV.tag = ctx->encrypt ? NULL : vec->tag;
+        job->auth_tag_output = &ctx->tags[n * GCM_SIV_TEST_TAG_SIZE];
+        job->auth_tag_output_len_in_bytes = GCM_SIV_TEST_TAG_LEN;
+}
+
+static int
+gcm_siv_check_job(const struct JOB_AES_HMAC *job, const int n, void *arg)
+{
+        const struct gcm_siv_many_ctx *ctx = arg;
+        const struct gcm_siv_vector *vec =
+                &gcm_siv_vectors[n % DIM(gcm_siv_vectors)];
+        const char *dir = ctx->encrypt ? "encrypt" : "decrypt";
+
+        if (vec->msg_len != 0 &&
+            !job_output_ok(n, job->dst, ctx->encrypt ? vec->ct : vec->msg,
+                           vec->msg_len)) {
+                printf("key size %d mismatched (%s)\n",
+                       (int) vec->key_len * 8, dir);
+                return 0;
+        }
+        /* nothing written past the output */
+        if (job->dst[vec->msg_len] != 0xff) {
+                printf("key size %d, job %d overwrite\n",
+                       (int) vec->key_len * 8, n);
+                return 0;
+        }
+        /* on decrypt, the computed tag has to match the received one */
+        if (!job_output_ok(n, job->auth_tag_output, vec->tag,
+                           GCM_SIV_TEST_TAG_LEN)) {
+                printf("key size %d tag mismatched (%s)\n",
+                       (int) vec->key_len * 8, dir);
+                return 0;
+        }
+        if (job->auth_tag_output[GCM_SIV_TEST_TAG_LEN] != 0xff) {
+                printf("key size %d, job %d tag overwrite\n",
+                       (int) vec->key_len * 8, n);
+                return 0;
+        }
+        return 1;
+}
+
+/* submits num_jobs jobs using test vectors in turn and checks the output */
+static int
+gcm_siv_run_jobs(struct MB_MGR *mb_mgr, const struct gcm_key_data *keys,
+                 uint8_t *bufs, uint8_t *tags, const int num_jobs,
+                 const int encrypt)
+{
+        struct gcm_siv_many_ctx ctx;
+
+        memset(tags, -1, num_jobs * GCM_SIV_TEST_TAG_SIZE);
+
+        ctx.keys = keys;
+        ctx.bufs = bufs;
+        ctx.tags = tags;
+        ctx.encrypt = encrypt;
+        return submit_many_jobs(mb_mgr, num_jobs, gcm_siv_fill_job,
+                                gcm_siv_check_job, &ctx);
+}
+
+/*
+ * Encrypts num_jobs messages out of place, so that lanes process messages
+ * of different lengths and key sizes, and decrypts them in place.
+ */
+static int
+test_gcm_siv_many(struct MB_MGR *mb_mgr, const int num_jobs)
+{
+        const unsigned num_vecs = DIM(gcm_siv_vectors);
+        struct gcm_key_data *keys = malloc(num_vecs * sizeof(*keys));
+        uint8_t *bufs = malloc(num_jobs * GCM_SIV_TEST_BUF_SIZE);
+        uint8_t *tags = malloc(num_jobs * GCM_SIV_TEST_TAG_SIZE);
+        unsigned i;
+        int ret;
+
+        assert(keys != NULL && bufs != NULL && tags != NULL);
+        memset(bufs, -1, num_jobs * GCM_SIV_TEST_BUF_SIZE);
+
+        for (i = 0; i < num_vecs; i++) {
+                if (gcm_siv_vectors[i].key_len == 16)
+                        IMB_AES128_GCM_PRE(mb_mgr, gcm_siv_vectors[i].key,
+                                           &keys[i]);
+                else
+                        IMB_AES256_GCM_PRE(mb_mgr, gcm_siv_vectors[i].key,
+                                           &keys[i]);
+        }
+
+        ret = gcm_siv_run_jobs(mb_mgr, keys, bufs, tags, num_jobs, 1);
+        if (ret == 0)
+                ret = gcm_siv_run_jobs(mb_mgr, keys, bufs, tags, num_jobs, 0);
+
+        free(keys);
+        free(bufs);
+        free(tags);
+        return ret;
+}
+
+/* sets up AES-GCM-SIV job for 12 byte nonce */
+static void
+gcm_siv_job(struct JOB_AES_HMAC *job, const JOB_CIPHER_DIRECTION dir,
+            const struct gcm_key_data *key, const uint64_t key_len,
+            const uint8_t *nonce, const uint8_t *src, uint8_t *dst,
+            const uint64_t len, const uint8_t *aad, const uint64_t aad_len,
+            const uint8_t *tag_in, uint8_t *tag_out)
+{
+        memset(job, 0, sizeof(*job));
+        job->cipher_direction = dir;
+        job->chain_order = (dir == ENCRYPT) ? CIPHER_HASH : HASH_CIPHER;
+        job->cipher_mode = AES_GCM_SIV;
+        job->hash_alg = AES_GCM_SIV_TAG;
+        job->aes_key_len_in_bytes = key_len;
+        job->aes_enc_key_expanded = key;
+        job->aes_dec_key_expanded = key;
+        job->iv = nonce;
+        job->iv_len_in_bytes = 12;
+        job->src = src;
+        job->dst = dst;
+        job->msg_len_to_cipher_in_bytes = len;
+        job->msg_len_to_hash_in_bytes = len;
+        job->u.GCM_SIV.aad = aad;
+        job->u.GCM_SIV.aad_len_in_bytes = aad_len;
+        job->u.GCM_SIV.tag = tag_in;
+        job->auth_tag_output = tag_out;
+        job->auth_tag_output_len_in_bytes = GCM_SIV_TEST_TAG_LEN;
+}
+
+/* 32-bit little endian counter wraps around, the rest is kept */
+static int
+test_gcm_siv_counter_wrap(struct MB_MGR *mb_mgr)
+{
+        static const uint8_t zero[32];
+        const struct {
+                const uint8_t *pt;
+                const uint8_t *ct;
+                uint64_t len;
+        } vecs[] = {
+                { RFC_WRAP_PT1, RFC_WRAP_CT1, sizeof(RFC_WRAP_PT1) },
+                { RFC_WRAP_PT2, RFC_WRAP_CT2, sizeof(RFC_WRAP_PT2) },
+        };
+        struct gcm_key_data key;
+        uint8_t out[sizeof(RFC_WRAP_PT1)];
+        uint8_t tag[GCM_SIV_TEST_TAG_LEN];
+        struct JOB_AES_HMAC tmpl;
+        const struct JOB_AES_HMAC *job;
+        unsigned i;
+
+        IMB_AES256_GCM_PRE(mb_mgr, zero, &key);
+        for (i = 0; i < DIM(vecs); i++) {
+                gcm_siv_job(&tmpl, ENCRYPT, &key, 32, zero, vecs[i].pt, out,
+                            vecs[i].len, NULL, 0, NULL, tag);
+                job = submit_one_job(mb_mgr, &tmpl);
+                if (job->status != STS_COMPLETED ||
+                    !job_output_ok((int) i, out, vecs[i].ct, vecs[i].len) ||
+                    !job_output_ok((int) i, tag, RFC_WRAP_TAG, sizeof(tag))) {
+                        printf("AES-GCM-SIV counter wrap %u failed\n", i + 1);
+                        return 1;
+                }
+
+                gcm_siv_job(&tmpl, DECRYPT, &key, 32, zero, vecs[i].ct, out,
+                            vecs[i].len, NULL, 0, RFC_WRAP_TAG, tag);
+                job = submit_one_job(mb_mgr, &tmpl);
+                if (job->status != STS_COMPLETED ||
+                    !job_output_ok((int) i, out, vecs[i].pt, vecs[i].len) ||
+                    !job_output_ok((int) i, tag, RFC_WRAP_TAG, sizeof(tag)))
+                        return 1;
+        }
+        return 0;
+}
+
+/*
+ * Decryption of a modified cipher text, AAD or received tag gives
+ * a computed tag that doesn't match the received one.
+ */
+static int
+test_gcm_siv_forgery(struct MB_MGR *mb_mgr)
+{
+        const struct gcm_siv_vector *vec = &gcm_siv_vectors[3];
+        uint8_t ct[GCM_SIV_TEST_MAX_MSG_LEN];
+        uint8_t aad[GCM_SIV_TEST_MAX_AAD_LEN];
+        uint8_t rx_tag[GCM_SIV_TEST_TAG_LEN];
+        uint8_t out[GCM_SIV_TEST_MAX_MSG_LEN];
+        uint8_t tag[GCM_SIV_TEST_TAG_LEN];
+        struct gcm_key_data key;
+        struct JOB_AES_HMAC tmpl;
+        const struct JOB_AES_HMAC *job;
+        unsigned i;
+
+        IMB_AES128_GCM_PRE(mb_mgr, vec->key, &key);
+        for (i = 0; i < 3; i++) {
+                memcpy(ct, vec->ct, vec->msg_len);
+                memcpy(aad, vec->aad, vec->aad_len);
+                memcpy(rx_tag, vec->tag, sizeof(rx_tag));
+                if (i == 0)
+                        ct[vec->msg_len - 1] ^= 0x80;
+                else if (i == 1)
+                        aad[0] ^= 1;
+                else
+                        rx_tag[0] ^= 1;
+
+                gcm_siv_job(&tmpl, DECRYPT, &key, vec->key_len, vec->nonce,
+                            ct, out, vec->msg_len, aad, vec->aad_len,
+                            rx_tag, tag);
+                job = submit_one_job(mb_mgr, &tmpl);
+                if (job->status != STS_COMPLETED ||
+                    !memcmp(tag, rx_tag, sizeof(tag))) {
+                        printf("AES-GCM-SIV forgery %u not detected\n", i);
+                        return 1;
+                }
+        }
+        return 0;
+}
+
+/*
+ * Nonce misuse resistance: with the same key and nonce, messages that
+ * differ in the last byte only have different tags and so completely
+ * different cipher texts (the tag is the initial counter).
+ */
+static int
+test_gcm_siv_nonce_reuse(struct MB_MGR *mb_mgr)
+{
+        const struct gcm_siv_vector *vec = &gcm_siv_vectors[7];
+        uint8_t msg[GCM_SIV_TEST_MAX_MSG_LEN];
+        uint8_t out[GCM_SIV_TEST_MAX_MSG_LEN];
+        uint8_t tag[GCM_SIV_TEST_TAG_LEN];
+        struct gcm_key_data key;
+        struct JOB_AES_HMAC tmpl;
+        const struct JOB_AES_HMAC *job;
+
+        memcpy(msg, vec->msg, vec->msg_len);
+        msg[vec->msg_len - 1] ^= 1;
+
+        IMB_AES128_GCM_PRE(mb_mgr, vec->key, &key);
+        gcm_siv_job(&tmpl, ENCRYPT, &key, vec->key_len, vec->nonce, msg, out,
+                    vec->msg_len, vec->aad, vec->aad_len, NULL, tag);
+        job = submit_one_job(mb_mgr, &tmpl);
+        if (job->status != STS_COMPLETED ||
+            !memcmp(tag, vec->tag, sizeof(tag)) ||
+            !memcmp(out, vec->ct, 16)) {
+                printf("AES-GCM-SIV nonce reuse leaks the first block\n");
+                return 1;
+        }
+        return 0;
+}
+
+/* invalid key size, nonce size, missing received tag or AAD */
+static int
+test_gcm_siv_invalid(struct MB_MGR *mb_mgr)
+{
+        const struct gcm_siv_vector *vec = &gcm_siv_vectors[3];
+        struct JOB_AES_HMAC tmpl[6];
+        uint8_t out[GCM_SIV_TEST_MAX_MSG_LEN];
+        uint8_t tag[GCM_SIV_TEST_TAG_LEN];
+        struct gcm_key_data key;
+        unsigned i;
+
+        IMB_AES128_GCM_PRE(mb_mgr, vec->key, &key);
+        for (i = 0; i < DIM(tmpl); i++)
+                gcm_siv_job(&tmpl[i], ENCRYPT, &key, vec->key_len,
+                            vec->nonce, vec->msg, out, vec->msg_len,
+                            vec->aad, vec->aad_len, NULL, tag);
+        tmpl[0].aes_key_len_in_bytes = 24;
+        tmpl[1].iv_len_in_bytes = 16;
+        /* decryption needs the received tag */
+        tmpl[2].cipher_direction = DECRYPT;
+        tmpl[2].chain_order = HASH_CIPHER;
+        tmpl[3].u.GCM_SIV.aad = NULL;
+        /* tag is the initial counter block, it can't be truncated */
+        tmpl[4].auth_tag_output_len_in_bytes = 12;
+        tmpl[5].hash_alg = NULL_HASH;
+
+        for (i = 0; i < DIM(tmpl); i++) {
+                const struct JOB_AES_HMAC *job = submit_one_job(mb_mgr,
+                                                                &tmpl[i]);
+
+                if (job->status != STS_INVALID_ARGS) {
+                        printf("AES-GCM-SIV invalid job %u: status:%d\n",
+                               i, job->status);
+                        return 1;
+                }
+        }
+        return 0;
+}
+
+int
+gcm_siv_test(const enum arch_type arch, struct MB_MGR *mb_mgr)
+{
+        const int num_jobs_tab[] = {
+                1, 2, 3, 4, 5, 7, 8, 9, 16, 17, 27, 54, 100
+        };
+        unsigned i;
+        int errors = 0;
+
+        (void) arch; /* unused */
+
+        for (i = 0; i < sizeof(gcm_siv_msg); i++)
+                gcm_siv_msg[i] = (uint8_t) (i * 7 + 1);
+        for (i = 0; i < sizeof(gcm_siv_aad); i++)
+                gcm_siv_aad[i] = (uint8_t) (i * 5 + 3);
+
+        printf("AES-GCM-SIV test vectors:\n");
+        for (i = 0; i < DIM(num_jobs_tab); i++)
+                errors += test_gcm_siv_many(mb_mgr, num_jobs_tab[i]);
+        errors += test_gcm_siv_counter_wrap(mb_mgr);
+        errors += test_gcm_siv_forgery(mb_mgr);
+        errors += test_gcm_siv_nonce_reuse(mb_mgr);
+        errors += test_gcm_siv_invalid(mb_mgr);
+
+	if (0 == errors)
+		printf("...Pass\n");
+	else
+		printf("...Fail\n");
+
+	return errors;
+}
@@ -31,9 +31,11 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <string.h>		/* for memcmp() */
+#include <stddef.h>
 
 #include <intel-ipsec-mb.h>
 #include "gcm_ctr_vectors_test.h"
+#include "utils.h"
 
 /*
  * 60-Byte Packet Encryption Using GCM-AES-128
@@ -1321,6 +1323,95 @@ static int test_gcm_std_vectors(void)
 	return is_error;
 }
 
+/*
+ * Checks multi-key GCM key pre-processing against the single key one
+ * for 1 to 19 keys
+ */
+static int
+test_gcm_pre_mb(const enum key_size klen)
+{
+        /* encryption round keys and hash keys */
+        const size_t rk_len = (klen == BITS_128) ? (11 * 16) :
+                ((klen == BITS_192) ? (13 * 16) : (15 * 16));
+        const size_t hk_offset = offsetof(struct gcm_key_data, shifted_hkey_8);
+        const size_t hk_len = sizeof(struct gcm_key_data) - hk_offset;
+        uint8_t key_bytes[19][BITS_256];
+        const void *keys[19];
+        struct gcm_key_data *key_data[19];
+        struct gcm_key_data ref;
+        unsigned num_keys, i, n;
+        int errors = 0;
+
+        for (i = 0; i < DIM(keys); i++) {
+                for (n = 0; n < sizeof(key_bytes[i]); n++)
+                        key_bytes[i][n] = (uint8_t) (i * 37 + n * 11 + 1);
+                keys[i] = key_bytes[i];
+        }
+
+        memset(key_data, 0, sizeof(key_data));
+        for (i = 0; i < DIM(key_data); i++) {
+                key_data[i] = malloc(sizeof(struct gcm_key_data));
+                if (key_data[i] == NULL) {
+                        fprintf(stderr, "Can't allocate key data memory\n");
+                        errors++;
+                        goto test_gcm_pre_mb_exit;
+                }
+        }
+
+        for (num_keys = 1; num_keys <= DIM(keys); num_keys++) {
+                for (i = 0; i < num_keys; i++)
+                        memset(key_data[i], 0, sizeof(struct gcm_key_data));
+                switch (klen) {
+                case BITS_128:
+                        IMB_AES128_GCM_PRE_MB(p_gcm_mgr, keys, key_data,
+                                              num_keys);
+                        break;
+                case BITS_192:
+                        IMB_AES192_GCM_PRE_MB(p_gcm_mgr, keys, key_data,
+                                              num_keys);
+                        break;
+                case BITS_256:
+                default:
+                        IMB_AES256_GCM_PRE_MB(p_gcm_mgr, keys, key_data,
+                                              num_keys);
+                        break;
+                }
+
+                for (i = 0; i < num_keys; i++) {
+                        const uint8_t *kd = (const uint8_t *) key_data[i];
+
+                        memset(&ref, 0, sizeof(ref));
+                        switch (klen) {
+                        case BITS_128:
+                                IMB_AES128_GCM_PRE(p_gcm_mgr, keys[i], &ref);
+                                break;
+                        case BITS_192:
+                                IMB_AES192_GCM_PRE(p_gcm_mgr, keys[i], &ref);
+                                break;
+                        case BITS_256:
+                        default:
+                                IMB_AES256_GCM_PRE(p_gcm_mgr, keys[i], &ref);
+                                break;
+                        }
+                        if (check_data(kd, ref.expanded_keys, rk_len,
+                                       "expanded keys") ||
+                            check_data(&kd[hk_offset],
+                                       ((const uint8_t *) &ref) + hk_offset,
+                                       hk_len, "hash keys")) {
+                                printf("multi-key GCM pre: key %u of %u\n",
+                                       i, num_keys);
+                                errors++;
+                        }
+                }
+        }
+
+ test_gcm_pre_mb_exit:
+        for (i = 0; i < DIM(key_data); i++)
+                if (key_data[i] != NULL)
+                        free(key_data[i]);
+        return errors;
+}
+
 int gcm_test(MB_MGR *p_mgr)
 {
 	int errors = 0;
@@ -1329,6 +1420,11 @@ int gcm_test(MB_MGR *p_mgr)
 
 	errors = test_gcm_std_vectors();
 
+        printf("AES-GCM multi-key pre-processing:\n");
+        errors += test_gcm_pre_mb(BITS_128);
+        errors += test_gcm_pre_mb(BITS_192);
+        errors += test_gcm_pre_mb(BITS_256);
+
 	if (0 == errors)
 		printf("...Pass\n");
 	else
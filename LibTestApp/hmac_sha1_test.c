@@ -344,6 +344,41 @@ hmac_sha1_job_ok(const struct hmac_sha1_rfc2202_vector *vec,
         return 1;
 }
 
+/*
+ * Computes HMAC-SHA1 ipad and opad hashes of the key,
+ * one key at a time
+ */
+static void
+hmac_sha1_pads(struct MB_MGR *mb_mgr, const void *key_ptr,
+               const size_t key_size, void *ipad_hash, void *opad_hash)
+{
+        uint8_t key[block_size];
+        uint8_t buf[block_size];
+        int i, key_len = 0;
+
+        /* prepare the key */
+        memset(key, 0, sizeof(key));
+        if (key_size <= block_size) {
+                memcpy(key, key_ptr, key_size);
+                key_len = (int) key_size;
+        } else {
+                IMB_SHA1(mb_mgr, key_ptr, key_size, key);
+                key_len = digest_size;
+        }
+
+        /* compute ipad hash */
+        memset(buf, 0x36, sizeof(buf));
+        for (i = 0; i < key_len; i++)
+                buf[i] ^= key[i];
+        IMB_SHA1_ONE_BLOCK(mb_mgr, buf, ipad_hash);
+
+        /* compute opad hash */
+        memset(buf, 0x5c, sizeof(buf));
+        for (i = 0; i < key_len; i++)
+                buf[i] ^= key[i];
+        IMB_SHA1_ONE_BLOCK(mb_mgr, buf, opad_hash);
+}
+
 static int
 test_hmac_sha1(struct MB_MGR *mb_mgr,
                const struct hmac_sha1_rfc2202_vector *vec,
@@ -353,11 +388,8 @@ test_hmac_sha1(struct MB_MGR *mb_mgr,
         uint8_t padding[16];
         uint8_t **auths = malloc(num_jobs * sizeof(void *));
         int i = 0, jobs_rx = 0, ret = -1;
-        uint8_t key[block_size];
-        uint8_t buf[block_size];
         DECLARE_ALIGNED(uint8_t ipad_hash[digest_size], 16);
         DECLARE_ALIGNED(uint8_t opad_hash[digest_size], 16);
-        int key_len = 0;
 
         if (auths == NULL) {
 		fprintf(stderr, "Can't allocate buffer memory\n");
@@ -379,27 +411,7 @@ test_hmac_sha1(struct MB_MGR *mb_mgr,
                 memset(auths[i], -1, alloc_len);
         }
 
-        /* prepare the key */
-        memset(key, 0, sizeof(key));
-        if (vec->key_len <= block_size) {
-                memcpy(key, vec->key, vec->key_len);
-                key_len = (int) vec->key_len;
-        } else {
-                IMB_SHA1(mb_mgr, vec->key, vec->key_len, key);
-                key_len = digest_size;
-        }
-
-        /* compute ipad hash */
-        memset(buf, 0x36, sizeof(buf));
-        for (i = 0; i < key_len; i++)
-                buf[i] ^= key[i];
-        IMB_SHA1_ONE_BLOCK(mb_mgr, buf, ipad_hash);
-
-        /* compute opad hash */
-        memset(buf, 0x5c, sizeof(buf));
-        for (i = 0; i < key_len; i++)
-                buf[i] ^= key[i];
-        IMB_SHA1_ONE_BLOCK(mb_mgr, buf, opad_hash);
+        hmac_sha1_pads(mb_mgr, vec->key, vec->key_len, ipad_hash, opad_hash);
 
         /* empty the manager */
         while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
@@ -509,6 +521,62 @@ test_hmac_sha1_std_vectors(struct MB_MGR *mb_mgr, const int num_jobs)
 	return errors;
 }
 
+/*
+ * Checks multi-key ipad/opad computation against
+ * the one key at a time computation for 1 to 19 keys
+ * (keys of the standard test vectors, including longer than block size)
+ */
+static int
+test_hmac_sha1_ipad_opad_mb(struct MB_MGR *mb_mgr)
+{
+        const unsigned vectors_cnt = DIM(hmac_sha1_vectors);
+        const void *keys[19];
+        uint64_t key_lens[19];
+        uint8_t ipad_hashes[19][digest_size];
+        uint8_t opad_hashes[19][digest_size];
+        void *ipad_ptrs[19];
+        void *opad_ptrs[19];
+        DECLARE_ALIGNED(uint8_t ipad_hash[digest_size], 16);
+        DECLARE_ALIGNED(uint8_t opad_hash[digest_size], 16);
+        unsigned num_keys, i;
+        int errors = 0;
+
+        printf("HMAC-SHA1 multi-key ipad/opad:\n");
+        for (i = 0; i < DIM(keys); i++) {
+                keys[i] = hmac_sha1_vectors[i % vectors_cnt].key;
+                key_lens[i] = hmac_sha1_vectors[i % vectors_cnt].key_len;
+                ipad_ptrs[i] = ipad_hashes[i];
+                opad_ptrs[i] = opad_hashes[i];
+        }
+
+        for (num_keys = 1; num_keys <= DIM(keys); num_keys++) {
+                printf(".");
+                memset(ipad_hashes, 0, sizeof(ipad_hashes));
+                memset(opad_hashes, 0, sizeof(opad_hashes));
+                if (IMB_HMAC_IPAD_OPAD_MB(mb_mgr, SHA1, keys, key_lens,
+                                          ipad_ptrs, opad_ptrs,
+                                          num_keys) != 0) {
+                        printf("multi-key ipad/opad error\n");
+                        errors++;
+                        continue;
+                }
+                for (i = 0; i < num_keys; i++) {
+                        hmac_sha1_pads(mb_mgr, keys[i], key_lens[i],
+                                       ipad_hash, opad_hash);
+                        if (memcmp(ipad_hash, ipad_hashes[i],
+                                   digest_size) != 0 ||
+                            memcmp(opad_hash, opad_hashes[i],
+                                   digest_size) != 0) {
+                                printf("ipad/opad mismatch, key %u of %u\n",
+                                       i, num_keys);
+                                errors++;
+                        }
+                }
+        }
+        printf("\n");
+        return errors;
+}
+
 int
 hmac_sha1_test(const enum arch_type arch,
                struct MB_MGR *mb_mgr)
@@ -527,6 +595,7 @@ hmac_sha1_test(const enum arch_type arch,
         errors += test_hmac_sha1_std_vectors(mb_mgr, 15);
         errors += test_hmac_sha1_std_vectors(mb_mgr, 16);
         errors += test_hmac_sha1_std_vectors(mb_mgr, 17);
+        errors += test_hmac_sha1_ipad_opad_mb(mb_mgr);
 
 	if (0 == errors)
 		printf("...Pass\n");
@@ -97,6 +97,19 @@ static const uint8_t hmac_sha_512_1[] = {
         0xbe, 0x9d, 0x91, 0x4e, 0xeb, 0x61, 0xf1, 0x70,
         0x2e, 0x69, 0x6c, 0x20, 0x3a, 0x12, 0x68, 0x54
 };
+/* HMAC-SHA-512/256 and HMAC-SHA-512/224 (not part of RFC 4231) */
+static const uint8_t hmac_sha_512_256_1[] = {
+        0x9f, 0x91, 0x26, 0xc3, 0xd9, 0xc3, 0xc3, 0x30,
+        0xd7, 0x60, 0x42, 0x5c, 0xa8, 0xa2, 0x17, 0xe3,
+        0x1f, 0xea, 0xe3, 0x1b, 0xfe, 0x70, 0x19, 0x6f,
+        0xf8, 0x16, 0x42, 0xb8, 0x68, 0x40, 0x2e, 0xab
+};
+static const uint8_t hmac_sha_512_224_1[] = {
+        0xb2, 0x44, 0xba, 0x01, 0x30, 0x7c, 0x0e, 0x7a,
+        0x8c, 0xca, 0xad, 0x13, 0xb1, 0x06, 0x7a, 0x4c,
+        0xf6, 0xb9, 0x61, 0xfe, 0x0c, 0x6a, 0x20, 0xbd,
+        0xa3, 0xd9, 0x20, 0x39
+};
 
 /*
  * 4.3.  Test Case 2
@@ -158,6 +171,19 @@ static const uint8_t hmac_sha_512_2[] = {
         0xca, 0xea, 0xb1, 0xa3, 0x4d, 0x4a, 0x6b, 0x4b,
         0x63, 0x6e, 0x07, 0x0a, 0x38, 0xbc, 0xe7, 0x37
 };
+/* HMAC-SHA-512/256 and HMAC-SHA-512/224 (not part of RFC 4231) */
+static const uint8_t hmac_sha_512_256_2[] = {
+        0x6d, 0xf7, 0xb2, 0x46, 0x30, 0xd5, 0xcc, 0xb2,
+        0xee, 0x33, 0x54, 0x07, 0x08, 0x1a, 0x87, 0x18,
+        0x8c, 0x22, 0x14, 0x89, 0x76, 0x8f, 0xa2, 0x02,
+        0x05, 0x13, 0xb2, 0xd5, 0x93, 0x35, 0x94, 0x56
+};
+static const uint8_t hmac_sha_512_224_2[] = {
+        0x4a, 0x53, 0x0b, 0x31, 0xa7, 0x9e, 0xbc, 0xce,
+        0x36, 0x91, 0x65, 0x46, 0x31, 0x7c, 0x45, 0xf2,
+        0x47, 0xd8, 0x32, 0x41, 0xdf, 0xb8, 0x18, 0xfd,
+        0x37, 0x25, 0x4b, 0xde
+};
 
 /*
  * 4.4.  Test Case 3
@@ -228,6 +254,19 @@ static const uint8_t hmac_sha_512_3[] = {
         0xb9, 0x46, 0xa3, 0x37, 0xbe, 0xe8, 0x94, 0x26,
         0x74, 0x27, 0x88, 0x59, 0xe1, 0x32, 0x92, 0xfb
 };
+/* HMAC-SHA-512/256 and HMAC-SHA-512/224 (not part of RFC 4231) */
+static const uint8_t hmac_sha_512_256_3[] = {
+        0x22, 0x90, 0x06, 0x39, 0x1d, 0x66, 0xc8, 0xec,
+        0xdd, 0xf4, 0x3b, 0xa5, 0xcf, 0x8f, 0x83, 0x53,
+        0x0e, 0xf2, 0x21, 0xa4, 0xe9, 0x40, 0x18, 0x40,
+        0xd1, 0xbe, 0xad, 0x51, 0x37, 0xc8, 0xa2, 0xea
+};
+static const uint8_t hmac_sha_512_224_3[] = {
+        0xdb, 0x34, 0xea, 0x52, 0x5c, 0x2c, 0x21, 0x6e,
+        0xe5, 0xa6, 0xcc, 0xb6, 0x60, 0x8b, 0xea, 0x87,
+        0x0b, 0xbe, 0xf1, 0x2f, 0xd9, 0xb9, 0x6a, 0x51,
+        0x09, 0xe2, 0xb6, 0xfc
+};
 
 /*
  * 4.5.  Test Case 4
@@ -299,6 +338,19 @@ static const uint8_t hmac_sha_512_4[] = {
         0xa5, 0xf1, 0x97, 0x41, 0x12, 0x0c, 0x4f, 0x2d,
         0xe2, 0xad, 0xeb, 0xeb, 0x10, 0xa2, 0x98, 0xdd
 };
+/* HMAC-SHA-512/256 and HMAC-SHA-512/224 (not part of RFC 4231) */
+static const uint8_t hmac_sha_512_256_4[] = {
+        0x36, 0xd6, 0x0c, 0x8a, 0xa1, 0xd0, 0xbe, 0x85,
+        0x6e, 0x10, 0x80, 0x4c, 0xf8, 0x36, 0xe8, 0x21,
+        0xe8, 0x73, 0x3c, 0xba, 0xfe, 0xae, 0x87, 0x63,
+        0x05, 0x89, 0xfd, 0x0b, 0x9b, 0x0a, 0x2f, 0x4c
+};
+static const uint8_t hmac_sha_512_224_4[] = {
+        0xc2, 0x39, 0x18, 0x63, 0xcd, 0xa4, 0x65, 0xc6,
+        0x82, 0x8a, 0xf0, 0x6a, 0xc5, 0xd4, 0xb7, 0x2d,
+        0x0b, 0x79, 0x21, 0x09, 0x95, 0x2d, 0xa5, 0x30,
+        0xe1, 0x1a, 0x0d, 0x26
+};
 
 /*
  *
@@ -433,6 +485,19 @@ static const uint8_t hmac_sha_512_6[] = {
         0x95, 0xe6, 0x4f, 0x73, 0xf6, 0x3f, 0x0a, 0xec,
         0x8b, 0x91, 0x5a, 0x98, 0x5d, 0x78, 0x65, 0x98
 };
+/* HMAC-SHA-512/256 and HMAC-SHA-512/224 (not part of RFC 4231) */
+static const uint8_t hmac_sha_512_256_6[] = {
+        0x87, 0x12, 0x3c, 0x45, 0xf7, 0xc5, 0x37, 0xa4,
+        0x04, 0xf8, 0xf4, 0x7c, 0xdb, 0xed, 0xda, 0x1f,
+        0xc9, 0xbe, 0xc6, 0x0e, 0xeb, 0x97, 0x19, 0x82,
+        0xce, 0x7e, 0xf1, 0x0e, 0x77, 0x4e, 0x65, 0x39
+};
+static const uint8_t hmac_sha_512_224_6[] = {
+        0x29, 0xbe, 0xf8, 0xce, 0x88, 0xb5, 0x4d, 0x42,
+        0x26, 0xc3, 0xc7, 0x71, 0x8e, 0xa9, 0xe3, 0x2a,
+        0xce, 0x24, 0x29, 0x02, 0x6f, 0x08, 0x9e, 0x38,
+        0xce, 0xa9, 0xae, 0xda
+};
 
 /*
  * 4.8.  Test Case 7
@@ -542,6 +607,19 @@ static const uint8_t hmac_sha_512_7[] = {
         0x13, 0x46, 0x76, 0xfb, 0x6d, 0xe0, 0x44, 0x60,
         0x65, 0xc9, 0x74, 0x40, 0xfa, 0x8c, 0x6a, 0x58
 };
+/* HMAC-SHA-512/256 and HMAC-SHA-512/224 (not part of RFC 4231) */
+static const uint8_t hmac_sha_512_256_7[] = {
+        0x6e, 0xa8, 0x3f, 0x8e, 0x73, 0x15, 0x07, 0x2c,
+        0x0b, 0xda, 0xa3, 0x3b, 0x93, 0xa2, 0x6f, 0xc1,
+        0x65, 0x99, 0x74, 0x63, 0x7a, 0x9d, 0xb8, 0xa8,
+        0x87, 0xd0, 0x6c, 0x05, 0xa7, 0xf3, 0x5a, 0x66
+};
+static const uint8_t hmac_sha_512_224_7[] = {
+        0x82, 0xa9, 0x61, 0x9b, 0x47, 0xaf, 0x0c, 0xea,
+        0x73, 0xa8, 0xb9, 0x74, 0x13, 0x55, 0xce, 0x90,
+        0x2d, 0x80, 0x7a, 0xd8, 0x7e, 0xe9, 0x07, 0x85,
+        0x22, 0xa2, 0x46, 0xe1
+};
 
 /*
  * Test Case 8
@@ -685,7 +763,11 @@ static const uint8_t hmac_sha_512_11[] = {
                         hmac_sha_224_##num, sizeof(hmac_sha_224_##num), \
                         hmac_sha_256_##num, sizeof(hmac_sha_256_##num), \
                         hmac_sha_384_##num, sizeof(hmac_sha_384_##num), \
-                        hmac_sha_512_##num, sizeof(hmac_sha_512_##num) }
+                        hmac_sha_512_##num, sizeof(hmac_sha_512_##num), \
+                        hmac_sha_512_256_##num,                         \
+                        sizeof(hmac_sha_512_256_##num),                 \
+                        hmac_sha_512_224_##num,                         \
+                        sizeof(hmac_sha_512_224_##num) }
 
 #define HMAC_SHA224_TEST_VEC(num)                                       \
         { num,                                                          \
@@ -694,6 +776,8 @@ static const uint8_t hmac_sha_512_11[] = {
                         hmac_sha_224_##num, sizeof(hmac_sha_224_##num), \
                         NULL, 0,                                        \
                         NULL, 0,                                        \
+                        NULL, 0,                                        \
+                        NULL, 0,                                        \
                         NULL, 0 }
 
 #define HMAC_SHA256_TEST_VEC(num)                                       \
@@ -703,6 +787,8 @@ static const uint8_t hmac_sha_512_11[] = {
                         NULL, 0,                                        \
                         hmac_sha_256_##num, sizeof(hmac_sha_256_##num), \
                         NULL, 0,                                        \
+                        NULL, 0,                                        \
+                        NULL, 0,                                        \
                         NULL, 0 }
 
 #define HMAC_SHA384_TEST_VEC(num)                                       \
@@ -712,6 +798,8 @@ static const uint8_t hmac_sha_512_11[] = {
                         NULL, 0,                                        \
                         NULL, 0,                                        \
                         hmac_sha_384_##num, sizeof(hmac_sha_384_##num), \
+                        NULL, 0,                                        \
+                        NULL, 0,                                        \
                         NULL, 0 }
 
 #define HMAC_SHA512_TEST_VEC(num)                                       \
@@ -721,7 +809,9 @@ static const uint8_t hmac_sha_512_11[] = {
                         NULL, 0,                                        \
                         NULL, 0,                                        \
                         NULL, 0,                                        \
-                        hmac_sha_512_##num, sizeof(hmac_sha_512_##num) }
+                        hmac_sha_512_##num, sizeof(hmac_sha_512_##num), \
+                        NULL, 0,                                        \
+                        NULL, 0 }
 
 static const struct hmac_rfc4231_vector {
         int test_case_num;
@@ -737,6 +827,10 @@ static const struct hmac_rfc4231_vector {
         size_t hmac_sha384_len;
         const uint8_t *hmac_sha512;
         size_t hmac_sha512_len;
+        const uint8_t *hmac_sha512_256;
+        size_t hmac_sha512_256_len;
+        const uint8_t *hmac_sha512_224;
+        size_t hmac_sha512_224_len;
 } hmac_sha256_sha512_vectors[] = {
         HMAC_SHA256_SHA512_TEST_VEC(1),
         HMAC_SHA256_SHA512_TEST_VEC(2),
@@ -779,6 +873,14 @@ hmac_shax_job_ok(const struct hmac_rfc4231_vector *vec,
                 p_digest = vec->hmac_sha512;
                 digest_len = vec->hmac_sha512_len;
                 break;
+        case 512256:
+                p_digest = vec->hmac_sha512_256;
+                digest_len = vec->hmac_sha512_256_len;
+                break;
+        case 512224:
+                p_digest = vec->hmac_sha512_224;
+                digest_len = vec->hmac_sha512_224_len;
+                break;
         default:
                 printf("line:%d wrong SHA type 'SHA-%d' ", __LINE__, sha_type);
                 return 0;
@@ -815,94 +917,56 @@ hmac_shax_job_ok(const struct hmac_rfc4231_vector *vec,
         return 1;
 }
 
+/*
+ * Computes HMAC-SHA-2 ipad and opad hashes of the key,
+ * one key at a time
+ */
 static int
-test_hmac_shax(struct MB_MGR *mb_mgr,
-               const struct hmac_rfc4231_vector *vec,
-               const int num_jobs,
-               const int sha_type)
+hmac_shax_pads(struct MB_MGR *mb_mgr, const int sha_type,
+               const void *key_ptr, const size_t key_size,
+               void *ipad_hash, void *opad_hash)
 {
-        struct JOB_AES_HMAC *job;
-        uint8_t padding[16];
-        uint8_t **auths = malloc(num_jobs * sizeof(void *));
-        int i = 0, jobs_rx = 0, ret = -1;
+        const size_t block_size = (sha_type == 224 || sha_type == 256) ?
+                SHA_256_BLOCK_SIZE : SHA_512_BLOCK_SIZE;
         uint8_t key[SHA_512_BLOCK_SIZE];
         uint8_t buf[SHA_512_BLOCK_SIZE];
-        DECLARE_ALIGNED(uint8_t ipad_hash[SHA512_DIGEST_SIZE_IN_BYTES], 16);
-        DECLARE_ALIGNED(uint8_t opad_hash[SHA512_DIGEST_SIZE_IN_BYTES], 16);
-        int key_len = 0;
-        size_t digest_len = 0;
-        size_t block_size = 0;
-
-        if (auths == NULL) {
-		fprintf(stderr, "Can't allocate buffer memory\n");
-		goto end2;
-        }
-
-        switch (sha_type) {
-        case 224:
-                digest_len = vec->hmac_sha224_len;
-                block_size = SHA_256_BLOCK_SIZE;
-                break;
-        case 256:
-                digest_len = vec->hmac_sha256_len;
-                block_size = SHA_256_BLOCK_SIZE;
-                break;
-        case 384:
-                digest_len = vec->hmac_sha384_len;
-                block_size = SHA_384_BLOCK_SIZE;
-                break;
-        case 512:
-                digest_len = vec->hmac_sha512_len;
-                block_size = SHA_512_BLOCK_SIZE;
-                break;
-        default:
-                fprintf(stderr, "Wrong SHA type selection 'SHA-%d'!\n",
-                        sha_type);
-                goto end2;
-        }
-
-        memset(padding, -1, sizeof(padding));
-        memset(auths, 0, num_jobs * sizeof(void *));
-
-        for (i = 0; i < num_jobs; i++) {
-                const size_t alloc_len =
-                        digest_len + (sizeof(padding) * 2);
-
-                auths[i] = malloc(alloc_len);
-                if (auths[i] == NULL) {
-                        fprintf(stderr, "Can't allocate buffer memory\n");
-                        goto end;
-                }
-                memset(auths[i], -1, alloc_len);
-        }
+        int i, key_len = 0;
 
         /* prepare the key */
         memset(key, 0, sizeof(key));
-        if (vec->key_len <= block_size) {
-                memcpy(key, vec->key, vec->key_len);
-                key_len = (int) vec->key_len;
+        if (key_size <= block_size) {
+                memcpy(key, key_ptr, key_size);
+                key_len = (int) key_size;
         } else {
                 switch (sha_type) {
                 case 224:
-                        IMB_SHA224(mb_mgr, vec->key, vec->key_len, key);
+                        IMB_SHA224(mb_mgr, key_ptr, key_size, key);
                         key_len = SHA224_DIGEST_SIZE_IN_BYTES;
                         break;
                 case 256:
-                        IMB_SHA256(mb_mgr, vec->key, vec->key_len, key);
+                        IMB_SHA256(mb_mgr, key_ptr, key_size, key);
                         key_len = SHA256_DIGEST_SIZE_IN_BYTES;
                         break;
                 case 384:
-                        IMB_SHA384(mb_mgr, vec->key, vec->key_len, key);
+                        IMB_SHA384(mb_mgr, key_ptr, key_size, key);
                         key_len = SHA384_DIGEST_SIZE_IN_BYTES;
                         break;
                 case 512:
-                        IMB_SHA512(mb_mgr, vec->key, vec->key_len, key);
+                        IMB_SHA512(mb_mgr, key_ptr, key_size, key);
                         key_len = SHA512_DIGEST_SIZE_IN_BYTES;
                         break;
+                case 512256:
+                        IMB_SHA512_256(mb_mgr, key_ptr, key_size, key);
+                        key_len = SHA512_256_DIGEST_SIZE_IN_BYTES;
+                        break;
+                case 512224:
+                        IMB_SHA512_224(mb_mgr, key_ptr, key_size, key);
+                        key_len = SHA512_224_DIGEST_SIZE_IN_BYTES;
+                        break;
                 default:
                         fprintf(stderr, "Wrong SHA type selection 'SHA-%d'!\n",
                                 sha_type);
-                        goto end;
+                        return -1;
                 }
         }
 
@@ -921,6 +985,12 @@ test_hmac_shax(struct MB_MGR *mb_mgr,
         case 384:
                 IMB_SHA384_ONE_BLOCK(mb_mgr, buf, ipad_hash);
                 break;
+        case 512256:
+                IMB_SHA512_256_ONE_BLOCK(mb_mgr, buf, ipad_hash);
+                break;
+        case 512224:
+                IMB_SHA512_224_ONE_BLOCK(mb_mgr, buf, ipad_hash);
+                break;
         case 512:
         default:
                 IMB_SHA512_ONE_BLOCK(mb_mgr, buf, ipad_hash);
@@ -942,12 +1012,85 @@ test_hmac_shax(struct MB_MGR *mb_mgr,
         case 384:
                 IMB_SHA384_ONE_BLOCK(mb_mgr, buf, opad_hash);
                 break;
+        case 512256:
+                IMB_SHA512_256_ONE_BLOCK(mb_mgr, buf, opad_hash);
+                break;
+        case 512224:
+                IMB_SHA512_224_ONE_BLOCK(mb_mgr, buf, opad_hash);
+                break;
         case 512:
         default:
                 IMB_SHA512_ONE_BLOCK(mb_mgr, buf, opad_hash);
                 break;
         }
 
+
+        return 0;
+}
+
+static int
+test_hmac_shax(struct MB_MGR *mb_mgr,
+               const struct hmac_rfc4231_vector *vec,
+               const int num_jobs,
+               const int sha_type)
+{
+        struct JOB_AES_HMAC *job;
+        uint8_t padding[16];
+        uint8_t **auths = malloc(num_jobs * sizeof(void *));
+        int i = 0, jobs_rx = 0, ret = -1;
+        DECLARE_ALIGNED(uint8_t ipad_hash[SHA512_DIGEST_SIZE_IN_BYTES], 16);
+        DECLARE_ALIGNED(uint8_t opad_hash[SHA512_DIGEST_SIZE_IN_BYTES], 16);
+        size_t digest_len = 0;
+
+        if (auths == NULL) {
+		fprintf(stderr, "Can't allocate buffer memory\n");
+		goto end2;
+        }
+
+        switch (sha_type) {
+        case 224:
+                digest_len = vec->hmac_sha224_len;
+                break;
+        case 256:
+                digest_len = vec->hmac_sha256_len;
+                break;
+        case 384:
+                digest_len = vec->hmac_sha384_len;
+                break;
+        case 512:
+                digest_len = vec->hmac_sha512_len;
+                break;
+        case 512256:
+                digest_len = vec->hmac_sha512_256_len;
+                break;
+        case 512224:
+                digest_len = vec->hmac_sha512_224_len;
+                break;
+        default:
+                fprintf(stderr, "Wrong SHA type selection 'SHA-%d'!\n",
+                        sha_type);
+                goto end2;
+        }
+
+        memset(padding, -1, sizeof(padding));
+        memset(auths, 0, num_jobs * sizeof(void *));
+
+        for (i = 0; i < num_jobs; i++) {
+                const size_t alloc_len =
+                        digest_len + (sizeof(padding) * 2);
+
+                auths[i] = malloc(alloc_len);
+                if (auths[i] == NULL) {
+                        fprintf(stderr, "Can't allocate buffer memory\n");
+                        goto end;
+                }
+                memset(auths[i], -1, alloc_len);
+        }
+
+        if (hmac_shax_pads(mb_mgr, sha_type, vec->key, vec->key_len,
+                           ipad_hash, opad_hash) != 0)
+                goto end;
+
         /* empty the manager */
         while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
                 ;
@@ -983,6 +1126,12 @@ test_hmac_shax(struct MB_MGR *mb_mgr,
                 case 384:
                         job->hash_alg = SHA_384;
                         break;
+                case 512256:
+                        job->hash_alg = SHA_512_256;
+                        break;
+                case 512224:
+                        job->hash_alg = SHA_512_224;
+                        break;
                 case 512:
                 default:
                         job->hash_alg = SHA_512;
@@ -1038,8 +1187,8 @@ test_hmac_shax(struct MB_MGR *mb_mgr,
 }
 
 static int
-test_hmac_shax_std_vectors(struct MB_MGR *mb_mgr, const int sha_type,
-                           const int num_jobs)
+test_hmac_shax_std_vectors(struct MB_MGR *mb_mgr,
+                           const int sha_type, const int num_jobs)
 {
 	const int vectors_cnt =
                 sizeof(hmac_sha256_sha512_vectors) /
@@ -1047,8 +1196,12 @@ test_hmac_shax_std_vectors(struct MB_MGR *mb_mgr, const int sha_type,
 	int vect;
 	int errors = 0;
 
-	printf("HMAC-SHA%d standard test vectors (N jobs = %d):\n",
-               sha_type, num_jobs);
+        if (sha_type > 512)
+                printf("HMAC-SHA512/%d standard test vectors "
+                       "(N jobs = %d):\n", sha_type - 512000, num_jobs);
+        else
+                printf("HMAC-SHA%d standard test vectors (N jobs = %d):\n",
+                       sha_type, num_jobs);
 	for (vect = 1; vect <= vectors_cnt; vect++) {
                 const int idx = vect - 1;
                 const int flag = (sha_type == 224 &&
@@ -1058,7 +1211,13 @@ test_hmac_shax_std_vectors(struct MB_MGR *mb_mgr, const int sha_type,
                         (sha_type == 384 &&
                          hmac_sha256_sha512_vectors[idx].hmac_sha384 == NULL) ||
                         (sha_type == 512 &&
-                         hmac_sha256_sha512_vectors[idx].hmac_sha512 == NULL);
+                         hmac_sha256_sha512_vectors[idx].hmac_sha512 == NULL) ||
+                        (sha_type == 512256 &&
+                         hmac_sha256_sha512_vectors[idx].hmac_sha512_256 ==
+                         NULL) ||
+                        (sha_type == 512224 &&
+                         hmac_sha256_sha512_vectors[idx].hmac_sha512_224 ==
+                         NULL);
 #ifdef DEBUG
 		printf("[%d/%d] RFC4231 Test Case %d key_len:%d data_len:%d\n",
                        vect, vectors_cnt,
@@ -1087,12 +1246,102 @@ test_hmac_shax_std_vectors(struct MB_MGR *mb_mgr, const int sha_type,
 	return errors;
 }
 
+/*
+ * Checks multi-key ipad/opad computation against
+ * the one key at a time computation for 1 to 19 keys
+ * (keys of the standard test vectors, including longer than block size)
+ */
+static int
+test_hmac_shax_ipad_opad_mb(struct MB_MGR *mb_mgr,
+                            const int sha_type)
+{
+        const unsigned vectors_cnt = DIM(hmac_sha256_sha512_vectors);
+        const void *keys[19];
+        uint64_t key_lens[19];
+        uint8_t ipad_hashes[19][SHA512_DIGEST_SIZE_IN_BYTES];
+        uint8_t opad_hashes[19][SHA512_DIGEST_SIZE_IN_BYTES];
+        void *ipad_ptrs[19];
+        void *opad_ptrs[19];
+        DECLARE_ALIGNED(uint8_t ipad_hash[SHA512_DIGEST_SIZE_IN_BYTES], 16);
+        DECLARE_ALIGNED(uint8_t opad_hash[SHA512_DIGEST_SIZE_IN_BYTES], 16);
+        /* ipad/opad hashes are full size digests */
+        const size_t digest_len = (sha_type == 224 || sha_type == 256) ?
+                SHA256_DIGEST_SIZE_IN_BYTES : SHA512_DIGEST_SIZE_IN_BYTES;
+        JOB_HASH_ALG hash_alg;
+        unsigned num_keys, i;
+        int errors = 0;
+
+        switch (sha_type) {
+        case 224:
+                hash_alg = SHA_224;
+                break;
+        case 256:
+                hash_alg = SHA_256;
+                break;
+        case 384:
+                hash_alg = SHA_384;
+                break;
+        case 512256:
+                hash_alg = SHA_512_256;
+                break;
+        case 512224:
+                hash_alg = SHA_512_224;
+                break;
+        case 512:
+        default:
+                hash_alg = SHA_512;
+                break;
+        }
+
+        if (sha_type > 512)
+                printf("HMAC-SHA512/%d multi-key ipad/opad:\n",
+                       sha_type - 512000);
+        else
+                printf("HMAC-SHA%d multi-key ipad/opad:\n", sha_type);
+        for (i = 0; i < DIM(keys); i++) {
+                keys[i] = hmac_sha256_sha512_vectors[i % vectors_cnt].key;
+                key_lens[i] =
+                        hmac_sha256_sha512_vectors[i % vectors_cnt].key_len;
+                ipad_ptrs[i] = ipad_hashes[i];
+                opad_ptrs[i] = opad_hashes[i];
+        }
+
+        for (num_keys = 1; num_keys <= DIM(keys); num_keys++) {
+                printf(".");
+                memset(ipad_hashes, 0, sizeof(ipad_hashes));
+                memset(opad_hashes, 0, sizeof(opad_hashes));
+                if (IMB_HMAC_IPAD_OPAD_MB(mb_mgr, hash_alg, keys, key_lens,
+                                          ipad_ptrs, opad_ptrs,
+                                          num_keys) != 0) {
+                        printf("multi-key ipad/opad error\n");
+                        errors++;
+                        continue;
+                }
+                for (i = 0; i < num_keys; i++) {
+                        if (hmac_shax_pads(mb_mgr, sha_type, keys[i],
+                                           key_lens[i], ipad_hash,
+                                           opad_hash) != 0)
+                                return ++errors;
+                        if (memcmp(ipad_hash, ipad_hashes[i],
+                                   digest_len) != 0 ||
+                            memcmp(opad_hash, opad_hashes[i],
+                                   digest_len) != 0) {
+                                printf("ipad/opad mismatch, key %u of %u\n",
+                                       i, num_keys);
+                                errors++;
+                        }
+                }
+        }
+        printf("\n");
+        return errors;
+}
+
 int
 hmac_sha256_sha512_test(const enum arch_type arch,
                         struct MB_MGR *mb_mgr)
 {
         const int sha_types_tab[] = {
-                224, 256, 384, 512
+                224, 256, 384, 512, 512256, 512224
         };
         const int num_jobs_tab[] = {
                 1, 3, 4, 5, 7, 8, 9, 15, 16, 17
@@ -1102,11 +1351,14 @@ hmac_sha256_sha512_test(const enum arch_type arch,
 
         (void) arch; /* unused */
 
-        for (i = 0; i < DIM(sha_types_tab); i++)
+        for (i = 0; i < DIM(sha_types_tab); i++) {
                 for (j = 0; j < DIM(num_jobs_tab); j++)
                         errors += test_hmac_shax_std_vectors(mb_mgr,
                                                              sha_types_tab[i],
                                                              num_jobs_tab[j]);
+                errors += test_hmac_shax_ipad_opad_mb(mb_mgr,
+                                                      sha_types_tab[i]);
+        }
 	if (0 == errors)
 		printf("...Pass\n");
 	else
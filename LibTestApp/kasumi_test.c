@@ -0,0 +1,663 @@
+/*****************************************************************************
+ Copyright (c) 2019, Intel Corporation
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+     * Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+     * Neither the name of Intel Corporation nor the names of its contributors
+       may be used to endorse or promote products derived from this software
+       without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include <intel-ipsec-mb.h>
+
+#include "gcm_ctr_vectors_test.h"
+#include "utils.h"
+
+int kasumi_test(const enum arch_type arch, struct MB_MGR *mb_mgr);
+
+struct kasumi_f8_vector {
+        const uint8_t *K;       /* confidentiality key */
+        const uint8_t *IV;      /* COUNT || BEARER || DIRECTION || 0 */
+        const uint8_t *P;       /* plain text */
+        const uint8_t *C;       /* cipher text */
+        uint64_t len;           /* message length in bits */
+        uint64_t offset;        /* message offset in bits */
+};
+
+struct kasumi_f9_vector {
+        const uint8_t *K;       /* integrity key */
+        const uint8_t *IV;      /* COUNT || FRESH */
+        uint64_t direction;
+        const uint8_t *M;       /* message */
+        const uint8_t *MAC;     /* expected MAC */
+        uint64_t len;           /* message length in bits */
+};
+
+/*
+ * UEA1 test set 1 (3GPP TS 35.203)
+ * COUNT = 0x72a4f20f, BEARER = 0xc, DIRECTION = 1, 798 bits
+ * Last 2 bits of the cipher text are the unmodified plain text bits.
+ */
+static const uint8_t KASUMI_F8_K1[] = {
+        0x2b, 0xd6, 0x45, 0x9f, 0x82, 0xc5, 0xb3, 0x00,
+        0x95, 0x2c, 0x49, 0x10, 0x48, 0x81, 0xff, 0x48
+};
+static const uint8_t KASUMI_F8_IV1[] = {
+        0x72, 0xa4, 0xf2, 0x0f, 0x64, 0x00, 0x00, 0x00
+};
+static const uint8_t KASUMI_F8_P1[] = {
+        0x7e, 0xc6, 0x12, 0x72, 0x74, 0x3b, 0xf1, 0x61,
+        0x47, 0x26, 0x44, 0x6a, 0x6c, 0x38, 0xce, 0xd1,
+        0x66, 0xf6, 0xca, 0x76, 0xeb, 0x54, 0x30, 0x04,
+        0x42, 0x86, 0x34, 0x6c, 0xef, 0x13, 0x0f, 0x92,
+        0x92, 0x2b, 0x03, 0x45, 0x0d, 0x3a, 0x99, 0x75,
+        0xe5, 0xbd, 0x2e, 0xa0, 0xeb, 0x55, 0xad, 0x8e,
+        0x1b, 0x19, 0x9e, 0x3e, 0xc4, 0x31, 0x60, 0x20,
+        0xe9, 0xa1, 0xb2, 0x85, 0xe7, 0x62, 0x79, 0x53,
+        0x59, 0xb7, 0xbd, 0xfd, 0x39, 0xbe, 0xf4, 0xb2,
+        0x48, 0x45, 0x83, 0xd5, 0xaf, 0xe0, 0x82, 0xae,
+        0xe6, 0x38, 0xbf, 0x5f, 0xd5, 0xa6, 0x06, 0x19,
+        0x39, 0x01, 0xa0, 0x8f, 0x4a, 0xb4, 0x1a, 0xab,
+        0x9b, 0x13, 0x48, 0x80
+};
+static const uint8_t KASUMI_F8_C1[] = {
+        0xd1, 0xe2, 0xde, 0x70, 0xee, 0xf8, 0x6c, 0x69,
+        0x64, 0xfb, 0x54, 0x2b, 0xc2, 0xd4, 0x60, 0xaa,
+        0xbf, 0xaa, 0x10, 0xa4, 0xa0, 0x93, 0x26, 0x2b,
+        0x7d, 0x19, 0x9e, 0x70, 0x6f, 0xc2, 0xd4, 0x89,
+        0x15, 0x53, 0x29, 0x69, 0x10, 0xf3, 0xa9, 0x73,
+        0x01, 0x26, 0x82, 0xe4, 0x1c, 0x4e, 0x2b, 0x02,
+        0xbe, 0x20, 0x17, 0xb7, 0x25, 0x3b, 0xbf, 0x93,
+        0x09, 0xde, 0x58, 0x19, 0xcb, 0x42, 0xe8, 0x19,
+        0x56, 0xf4, 0xc9, 0x9b, 0xc9, 0x76, 0x5c, 0xaf,
+        0x53, 0xb1, 0xd0, 0xbb, 0x82, 0x79, 0x82, 0x6a,
+        0xdb, 0xbc, 0x55, 0x22, 0xe9, 0x15, 0xc1, 0x20,
+        0xa6, 0x18, 0xa5, 0xa7, 0xf5, 0xe8, 0x97, 0x08,
+        0x93, 0x39, 0x65, 0x0c
+};
+
+/*
+ * UEA1 test set 1 message starting at bit 3 (prefixed with 101b),
+ * the last byte is padded with 1011010b
+ */
+static const uint8_t KASUMI_F8_P1_OFS3[] = {
+        0xaf, 0xd8, 0xc2, 0x4e, 0x4e, 0x87, 0x7e, 0x2c,
+        0x28, 0xe4, 0xc8, 0x8d, 0x4d, 0x87, 0x19, 0xda,
+        0x2c, 0xde, 0xd9, 0x4e, 0xdd, 0x6a, 0x86, 0x00,
+        0x88, 0x50, 0xc6, 0x8d, 0x9d, 0xe2, 0x61, 0xf2,
+        0x52, 0x45, 0x60, 0x68, 0xa1, 0xa7, 0x53, 0x2e,
+        0xbc, 0xb7, 0xa5, 0xd4, 0x1d, 0x6a, 0xb5, 0xb1,
+        0xc3, 0x63, 0x33, 0xc7, 0xd8, 0x86, 0x2c, 0x04,
+        0x1d, 0x34, 0x36, 0x50, 0xbc, 0xec, 0x4f, 0x2a,
+        0x6b, 0x36, 0xf7, 0xbf, 0xa7, 0x37, 0xde, 0x96,
+        0x49, 0x08, 0xb0, 0x7a, 0xb5, 0xfc, 0x10, 0x55,
+        0xdc, 0xc7, 0x17, 0xeb, 0xfa, 0xb4, 0xc0, 0xc3,
+        0x27, 0x20, 0x34, 0x11, 0xe9, 0x56, 0x83, 0x55,
+        0x73, 0x62, 0x69, 0x10, 0x5a
+};
+static const uint8_t KASUMI_F8_C1_OFS3[] = {
+        0xba, 0x3c, 0x5b, 0xce, 0x1d, 0xdf, 0x0d, 0x8d,
+        0x2c, 0x9f, 0x6a, 0x85, 0x78, 0x5a, 0x8c, 0x15,
+        0x57, 0xf5, 0x42, 0x14, 0x94, 0x12, 0x64, 0xc5,
+        0x6f, 0xa3, 0x33, 0xce, 0x0d, 0xf8, 0x5a, 0x91,
+        0x22, 0xaa, 0x65, 0x2d, 0x22, 0x1e, 0x75, 0x2e,
+        0x60, 0x24, 0xd0, 0x5c, 0x83, 0x89, 0xc5, 0x60,
+        0x57, 0xc4, 0x02, 0xf6, 0xe4, 0xa7, 0x77, 0xf2,
+        0x61, 0x3b, 0xcb, 0x03, 0x39, 0x68, 0x5d, 0x03,
+        0x2a, 0xde, 0x99, 0x33, 0x79, 0x2e, 0xcb, 0x95,
+        0xea, 0x76, 0x3a, 0x17, 0x70, 0x4f, 0x30, 0x4d,
+        0x5b, 0x77, 0x8a, 0xa4, 0x5d, 0x22, 0xb8, 0x24,
+        0x14, 0xc3, 0x14, 0xb4, 0xfe, 0xbd, 0x12, 0xe1,
+        0x12, 0x67, 0x2c, 0xa1, 0xda
+};
+
+/*
+ * 1283 bit message (crosses the 64 byte keystream chunk boundary twice)
+ * COUNT = 0x0badcafe, BEARER = 0x1a, DIRECTION = 0
+ */
+static const uint8_t KASUMI_F8_K2[] = {
+        0x0d, 0x32, 0x57, 0x7c, 0xa1, 0xc6, 0xeb, 0x10,
+        0x35, 0x5a, 0x7f, 0xa4, 0xc9, 0xee, 0x13, 0x38
+};
+static const uint8_t KASUMI_F8_IV2[] = {
+        0x0b, 0xad, 0xca, 0xfe, 0xd0, 0x00, 0x00, 0x00
+};
+static const uint8_t KASUMI_F8_P2[] = {
+        0x07, 0x24, 0x41, 0x5e, 0x7b, 0x98, 0xb5, 0xd2,
+        0xef, 0x0c, 0x29, 0x46, 0x63, 0x80, 0x9d, 0xba,
+        0xd7, 0xf4, 0x11, 0x2e, 0x4b, 0x68, 0x85, 0xa2,
+        0xbf, 0xdc, 0xf9, 0x16, 0x33, 0x50, 0x6d, 0x8a,
+        0xa7, 0xc4, 0xe1, 0xfe, 0x1b, 0x38, 0x55, 0x72,
+        0x8f, 0xac, 0xc9, 0xe6, 0x03, 0x20, 0x3d, 0x5a,
+        0x77, 0x94, 0xb1, 0xce, 0xeb, 0x08, 0x25, 0x42,
+        0x5f, 0x7c, 0x99, 0xb6, 0xd3, 0xf0, 0x0d, 0x2a,
+        0x47, 0x64, 0x81, 0x9e, 0xbb, 0xd8, 0xf5, 0x12,
+        0x2f, 0x4c, 0x69, 0x86, 0xa3, 0xc0, 0xdd, 0xfa,
+        0x17, 0x34, 0x51, 0x6e, 0x8b, 0xa8, 0xc5, 0xe2,
+        0xff, 0x1c, 0x39, 0x56, 0x73, 0x90, 0xad, 0xca,
+        0xe7, 0x04, 0x21, 0x3e, 0x5b, 0x78, 0x95, 0xb2,
+        0xcf, 0xec, 0x09, 0x26, 0x43, 0x60, 0x7d, 0x9a,
+        0xb7, 0xd4, 0xf1, 0x0e, 0x2b, 0x48, 0x65, 0x82,
+        0x9f, 0xbc, 0xd9, 0xf6, 0x13, 0x30, 0x4d, 0x6a,
+        0x87, 0xa4, 0xc1, 0xde, 0xfb, 0x18, 0x35, 0x52,
+        0x6f, 0x8c, 0xa9, 0xc6, 0xe3, 0x00, 0x1d, 0x3a,
+        0x57, 0x74, 0x91, 0xae, 0xcb, 0xe8, 0x05, 0x22,
+        0x3f, 0x5c, 0x79, 0x96, 0xb3, 0xd0, 0xed, 0x0a,
+        0x27
+};
+static const uint8_t KASUMI_F8_C2[] = {
+        0x9a, 0xd1, 0x99, 0xa9, 0xe4, 0xa2, 0x98, 0xb1,
+        0x7d, 0xc1, 0x30, 0x80, 0x62, 0x67, 0x13, 0xc1,
+        0xef, 0xfb, 0xb5, 0x57, 0x6b, 0xef, 0x87, 0xca,
+        0x0e, 0xd1, 0xb6, 0xd2, 0xd8, 0xd2, 0xf9, 0x4f,
+        0xa0, 0xf0, 0xb0, 0xdf, 0x4f, 0xe7, 0x60, 0x92,
+        0x54, 0x2a, 0x25, 0x54, 0x8d, 0x4a, 0x3e, 0x78,
+        0x4d, 0x00, 0x8a, 0x6e, 0x31, 0x42, 0xd8, 0x0a,
+        0x19, 0xce, 0xb9, 0xeb, 0xa9, 0xbd, 0x76, 0xfc,
+        0x15, 0xa7, 0x09, 0xca, 0xbf, 0xdf, 0xe3, 0x86,
+        0xef, 0xfc, 0x74, 0xb3, 0x3a, 0xc3, 0x0f, 0x6a,
+        0xdb, 0xd9, 0xb1, 0x03, 0x14, 0xde, 0x88, 0xdd,
+        0xd6, 0x20, 0xed, 0xa2, 0xcf, 0xea, 0x23, 0x0f,
+        0xd3, 0x30, 0x17, 0x3a, 0x54, 0x1e, 0x76, 0xe0,
+        0x7c, 0x52, 0x1b, 0x51, 0x21, 0xca, 0xdd, 0xdb,
+        0x04, 0x27, 0xf9, 0x6c, 0x8a, 0xba, 0x95, 0xc8,
+        0x81, 0x34, 0x98, 0x92, 0x16, 0xf8, 0x6a, 0xc0,
+        0xa9, 0xba, 0x85, 0x9c, 0x94, 0xa4, 0x0c, 0xeb,
+        0x1b, 0x1a, 0x6d, 0x4e, 0xbf, 0x7d, 0x57, 0x4a,
+        0x57, 0x11, 0x63, 0xb2, 0x10, 0x91, 0x5d, 0x0e,
+        0x04, 0xb8, 0x62, 0x06, 0x0d, 0x29, 0x94, 0x94,
+        0x87
+};
+
+static const struct kasumi_f8_vector kasumi_f8_vectors[] = {
+        { KASUMI_F8_K1, KASUMI_F8_IV1, KASUMI_F8_P1, KASUMI_F8_C1, 798, 0 },
+        { KASUMI_F8_K2, KASUMI_F8_IV2, KASUMI_F8_P2, KASUMI_F8_C2, 1283, 0 },
+        { KASUMI_F8_K1, KASUMI_F8_IV1, KASUMI_F8_P1_OFS3, KASUMI_F8_C1_OFS3,
+          798, 3 },
+};
+
+/* number of bytes holding the message (including its offset) */
+#define KASUMI_F8_SIZE(_vec) (((_vec)->offset + (_vec)->len + 7) / 8)
+
+/*
+ * 189 bit message
+ * COUNT = 0x38a6f056, FRESH = 0x05d2ec49, DIRECTION = 0
+ */
+static const uint8_t KASUMI_F9_K1[] = {
+        0x2b, 0xd6, 0x45, 0x9f, 0x82, 0xc5, 0xb3, 0x00,
+        0x95, 0x2c, 0x49, 0x10, 0x48, 0x81, 0xff, 0x48
+};
+static const uint8_t KASUMI_F9_IV1[] = {
+        0x38, 0xa6, 0xf0, 0x56, 0x05, 0xd2, 0xec, 0x49
+};
+static const uint8_t KASUMI_F9_M1[] = {
+        0x6b, 0x22, 0x77, 0x37, 0x29, 0x6f, 0x39, 0x3c,
+        0x80, 0x79, 0x35, 0x3e, 0xdc, 0x87, 0xe2, 0xe8,
+        0x05, 0xd2, 0xec, 0x49, 0xa4, 0xf2, 0xd8, 0xe0
+};
+static const uint8_t KASUMI_F9_MAC1[] = {
+        0xc4, 0x03, 0xa3, 0x09
+};
+
+/*
+ * 127 bit message (the final 1 bit goes into a separate block)
+ * COUNT = 0x9f0d3a5c, FRESH = 0x14e2b687, DIRECTION = 1
+ */
+static const uint8_t KASUMI_F9_K2[] = {
+        0x05, 0x2e, 0x57, 0x80, 0xa9, 0xd2, 0xfb, 0x24,
+        0x4d, 0x76, 0x9f, 0xc8, 0xf1, 0x1a, 0x43, 0x6c
+};
+static const uint8_t KASUMI_F9_IV2[] = {
+        0x9f, 0x0d, 0x3a, 0x5c, 0x14, 0xe2, 0xb6, 0x87
+};
+static const uint8_t KASUMI_F9_M2[] = {
+        0x09, 0x1a, 0x2b, 0x3c, 0x4d, 0x5e, 0x6f, 0x80,
+        0x91, 0xa2, 0xb3, 0xc4, 0xd5, 0xe6, 0xf7, 0x08
+};
+static const uint8_t KASUMI_F9_MAC2[] = {
+        0x76, 0x5b, 0x74, 0x03
+};
+
+/*
+ * 1000 bit message
+ * COUNT = 0x01234567, FRESH = 0x89abcdef, DIRECTION = 1
+ */
+static const uint8_t KASUMI_F9_K3[] = {
+        0x01, 0x36, 0x6b, 0xa0, 0xd5, 0x0a, 0x3f, 0x74,
+        0xa9, 0xde, 0x13, 0x48, 0x7d, 0xb2, 0xe7, 0x1c
+};
+static const uint8_t KASUMI_F9_IV3[] = {
+        0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef
+};
+static const uint8_t KASUMI_F9_M3[] = {
+        0x0b, 0x22, 0x39, 0x50, 0x67, 0x7e, 0x95, 0xac,
+        0xc3, 0xda, 0xf1, 0x08, 0x1f, 0x36, 0x4d, 0x64,
+        0x7b, 0x92, 0xa9, 0xc0, 0xd7, 0xee, 0x05, 0x1c,
+        0x33, 0x4a, 0x61, 0x78, 0x8f, 0xa6, 0xbd, 0xd4,
+        0xeb, 0x02, 0x19, 0x30, 0x47, 0x5e, 0x75, 0x8c,
+        0xa3, 0xba, 0xd1, 0xe8, 0xff, 0x16, 0x2d, 0x44,
+        0x5b, 0x72, 0x89, 0xa0, 0xb7, 0xce, 0xe5, 0xfc,
+        0x13, 0x2a, 0x41, 0x58, 0x6f, 0x86, 0x9d, 0xb4,
+        0xcb, 0xe2, 0xf9, 0x10, 0x27, 0x3e, 0x55, 0x6c,
+        0x83, 0x9a, 0xb1, 0xc8, 0xdf, 0xf6, 0x0d, 0x24,
+        0x3b, 0x52, 0x69, 0x80, 0x97, 0xae, 0xc5, 0xdc,
+        0xf3, 0x0a, 0x21, 0x38, 0x4f, 0x66, 0x7d, 0x94,
+        0xab, 0xc2, 0xd9, 0xf0, 0x07, 0x1e, 0x35, 0x4c,
+        0x63, 0x7a, 0x91, 0xa8, 0xbf, 0xd6, 0xed, 0x04,
+        0x1b, 0x32, 0x49, 0x60, 0x77, 0x8e, 0xa5, 0xbc,
+        0xd3, 0xea, 0x01, 0x18, 0x2f
+};
+static const uint8_t KASUMI_F9_MAC3[] = {
+        0x24, 0x63, 0x8c, 0x2a
+};
+
+static const struct kasumi_f9_vector kasumi_f9_vectors[] = {
+        { KASUMI_F9_K1, KASUMI_F9_IV1, 0, KASUMI_F9_M1, KASUMI_F9_MAC1, 189 },
+        { KASUMI_F9_K2, KASUMI_F9_IV2, 1, KASUMI_F9_M2, KASUMI_F9_MAC2, 127 },
+        { KASUMI_F9_K3, KASUMI_F9_IV3, 1, KASUMI_F9_M3, KASUMI_F9_MAC3, 1000 },
+};
+
+/* state shared by the job callbacks of test_kasumi_f8_many() */
+struct kasumi_f8_ctx {
+        JOB_CIPHER_DIRECTION dir;
+        uint8_t **srcs;
+        uint8_t **dsts;
+};
+
+static void
+kasumi_f8_fill_job(struct JOB_AES_HMAC *job, const int n, void *arg)
+{
+        const struct kasumi_f8_ctx *ctx = arg;
+        const struct kasumi_f8_vector *vec =
+                &kasumi_f8_vectors[n % DIM(kasumi_f8_vectors)];
+
+        job->cipher_direction = ctx->dir;
+        job->chain_order = (ctx->dir == ENCRYPT) ? CIPHER_HASH : HASH_CIPHER;
+        job->cipher_mode = KASUMI_UEA1_BITLEN;
+        job->hash_alg = NULL_HASH;
+        job->aes_enc_key_expanded = vec->K;
+        job->aes_dec_key_expanded = vec->K;
+        job->aes_key_len_in_bytes = 16;
+        job->iv = vec->IV;
+        job->iv_len_in_bytes = 8;
+        job->src = ctx->srcs[n];
+        job->dst = ctx->dsts[n];
+        job->cipher_start_src_offset_in_bits = vec->offset;
+        job->msg_len_to_cipher_in_bits = vec->len;
+}
+
+static int
+kasumi_f8_check_job(const struct JOB_AES_HMAC *job, const int n, void *arg)
+{
+        const struct kasumi_f8_ctx *ctx = arg;
+        const struct kasumi_f8_vector *vec =
+                &kasumi_f8_vectors[n % DIM(kasumi_f8_vectors)];
+
+        return job_output_ok(n, job->dst,
+                             (ctx->dir == ENCRYPT) ? vec->C : vec->P,
+                             KASUMI_F8_SIZE(vec));
+}
+
+/*
+ * Submits num_jobs jobs using test vectors in turn,
+ * so that lanes process messages of different lengths.
+ */
+static int
+test_kasumi_f8_many(struct MB_MGR *mb_mgr, const JOB_CIPHER_DIRECTION dir,
+                    const int in_place, const int num_jobs)
+{
+        struct kasumi_f8_ctx ctx;
+        int i, ret;
+
+        ctx.dir = dir;
+        ctx.srcs = malloc(num_jobs * sizeof(void *));
+        ctx.dsts = malloc(num_jobs * sizeof(void *));
+        assert(ctx.srcs != NULL && ctx.dsts != NULL);
+
+        for (i = 0; i < num_jobs; i++) {
+                const struct kasumi_f8_vector *vec =
+                        &kasumi_f8_vectors[i % DIM(kasumi_f8_vectors)];
+                const size_t size = KASUMI_F8_SIZE(vec);
+
+                ctx.srcs[i] = malloc(size);
+                assert(ctx.srcs[i] != NULL);
+                memcpy(ctx.srcs[i], (dir == ENCRYPT) ? vec->P : vec->C, size);
+                if (in_place) {
+                        ctx.dsts[i] = ctx.srcs[i];
+                } else {
+                        /* bits around the message are not to be modified */
+                        ctx.dsts[i] = malloc(size);
+                        assert(ctx.dsts[i] != NULL);
+                        memcpy(ctx.dsts[i], ctx.srcs[i], size);
+                }
+        }
+
+        ret = submit_many_jobs(mb_mgr, num_jobs, kasumi_f8_fill_job,
+                               kasumi_f8_check_job, &ctx);
+
+        for (i = 0; i < num_jobs; i++) {
+                if (!in_place)
+                        free(ctx.dsts[i]);
+                free(ctx.srcs[i]);
+        }
+        free(ctx.srcs);
+        free(ctx.dsts);
+        return ret;
+}
+
+static void
+kasumi_f9_fill_job(struct JOB_AES_HMAC *job, const int n, void *arg)
+{
+        uint8_t *tags = arg;
+        const struct kasumi_f9_vector *vec =
+                &kasumi_f9_vectors[n % DIM(kasumi_f9_vectors)];
+
+        job->cipher_direction = ENCRYPT;
+        job->chain_order = HASH_CIPHER;
+        job->cipher_mode = NULL_CIPHER;
+        job->hash_alg = KASUMI_UIA1_BITLEN;
+        job->u.KASUMI_UIA1._key = vec->K;
+        job->u.KASUMI_UIA1._iv = vec->IV;
+        job->u.KASUMI_UIA1._direction = vec->direction;
+        job->src = vec->M;
+        job->hash_start_src_offset_in_bytes = 0;
+        job->msg_len_to_hash_in_bits = vec->len;
+        job->auth_tag_output = &tags[n * 4];
+        job->auth_tag_output_len_in_bytes = 4;
+}
+
+static int
+kasumi_f9_check_job(const struct JOB_AES_HMAC *job, const int n, void *arg)
+{
+        const struct kasumi_f9_vector *vec =
+                &kasumi_f9_vectors[n % DIM(kasumi_f9_vectors)];
+
+        (void) arg;
+        return job_output_ok(n, job->auth_tag_output, vec->MAC, 4);
+}
+
+static int
+test_kasumi_f9_many(struct MB_MGR *mb_mgr, const int num_jobs)
+{
+        uint8_t *tags = malloc(num_jobs * 4);
+        int ret;
+
+        assert(tags != NULL);
+        memset(tags, -1, num_jobs * 4);
+
+        ret = submit_many_jobs(mb_mgr, num_jobs, kasumi_f9_fill_job,
+                               kasumi_f9_check_job, tags);
+
+        free(tags);
+        return ret;
+}
+
+/* sets up in-place UEA1 job with key and IV of test set vec */
+static void
+kasumi_f8_job(struct JOB_AES_HMAC *job, const struct kasumi_f8_vector *vec,
+              const JOB_CIPHER_DIRECTION dir, uint8_t *buf,
+              const uint64_t len)
+{
+        memset(job, 0, sizeof(*job));
+        job->cipher_direction = dir;
+        job->chain_order = (dir == ENCRYPT) ? CIPHER_HASH : HASH_CIPHER;
+        job->cipher_mode = KASUMI_UEA1_BITLEN;
+        job->hash_alg = NULL_HASH;
+        job->aes_enc_key_expanded = vec->K;
+        job->aes_dec_key_expanded = vec->K;
+        job->aes_key_len_in_bytes = KASUMI_KEY_LEN_IN_BYTES;
+        job->iv = vec->IV;
+        job->iv_len_in_bytes = KASUMI_IV_LEN_IN_BYTES;
+        job->src = buf;
+        job->dst = buf;
+        job->msg_len_to_cipher_in_bits = len;
+}
+
+/* sets up UIA1 job with key, IV and direction of test set vec */
+static void
+kasumi_f9_job(struct JOB_AES_HMAC *job, const struct kasumi_f9_vector *vec,
+              const uint64_t len_in_bits, uint8_t *tag)
+{
+        memset(job, 0, sizeof(*job));
+        job->cipher_direction = ENCRYPT;
+        job->chain_order = HASH_CIPHER;
+        job->cipher_mode = NULL_CIPHER;
+        job->hash_alg = KASUMI_UIA1_BITLEN;
+        job->u.KASUMI_UIA1._key = vec->K;
+        job->u.KASUMI_UIA1._iv = vec->IV;
+        job->u.KASUMI_UIA1._direction = vec->direction;
+        job->src = vec->M;
+        job->msg_len_to_hash_in_bits = len_in_bits;
+        job->auth_tag_output = tag;
+        job->auth_tag_output_len_in_bytes = KASUMI_DIGEST_LEN;
+}
+
+/*
+ * f8 keystream is made of 64 bit KASUMI blocks: prefixes of test set 2
+ * around the block boundaries encrypt to the same prefix of its cipher
+ * text, the rest of the last byte stays plain text.
+ */
+static int
+test_kasumi_f8_lengths(struct MB_MGR *mb_mgr)
+{
+        static const uint64_t lens[] = {
+                1, 8, 63, 64, 65, 127, 128, 129, 640, 1217, 1282
+        };
+        const struct kasumi_f8_vector *vec = &kasumi_f8_vectors[1];
+        uint8_t buf[sizeof(KASUMI_F8_P2)];
+        uint8_t expected[sizeof(KASUMI_F8_P2)];
+        struct JOB_AES_HMAC tmpl;
+        unsigned i;
+
+        for (i = 0; i < DIM(lens); i++) {
+                const uint64_t bytes = lens[i] / 8;
+                const struct JOB_AES_HMAC *job;
+
+                memcpy(buf, vec->P, sizeof(buf));
+                memcpy(expected, vec->P, sizeof(expected));
+                memcpy(expected, vec->C, bytes);
+                if (lens[i] % 8) {
+                        const uint8_t mask = 0xff00 >> (lens[i] % 8);
+
+                        expected[bytes] = (vec->C[bytes] & mask) |
+                                (vec->P[bytes] & ~mask);
+                }
+
+                kasumi_f8_job(&tmpl, vec, ENCRYPT, buf, lens[i]);
+                job = submit_one_job(mb_mgr, &tmpl);
+                if (job->status != STS_COMPLETED ||
+                    !job_output_ok((int) i, buf, expected, sizeof(buf))) {
+                        printf("UEA1 length %u failed\n", (unsigned) lens[i]);
+                        return 1;
+                }
+        }
+        return 0;
+}
+
+/*
+ * KASUMI_MAX_BITLEN long message goes through encryption and decryption
+ * back to the plain text, one more bit is rejected.
+ */
+static int
+test_kasumi_f8_max_len(struct MB_MGR *mb_mgr)
+{
+        const struct kasumi_f8_vector *vec = &kasumi_f8_vectors[1];
+        const size_t size = KASUMI_MAX_BITLEN / 8 + 1;
+        uint8_t *buf = malloc(size);
+        uint8_t *plain = malloc(size);
+        struct JOB_AES_HMAC tmpl;
+        const struct JOB_AES_HMAC *job;
+        size_t i;
+        int ret = 1;
+
+        assert(buf != NULL && plain != NULL);
+        for (i = 0; i < size; i++)
+                plain[i] = (uint8_t) (i * 11 + 5);
+        memcpy(buf, plain, size);
+
+        kasumi_f8_job(&tmpl, vec, ENCRYPT, buf, KASUMI_MAX_BITLEN);
+        job = submit_one_job(mb_mgr, &tmpl);
+        if (job->status != STS_COMPLETED ||
+            !memcmp(buf, plain, KASUMI_MAX_BITLEN / 8)) {
+                printf("UEA1 max length: encryption failed\n");
+                goto end;
+        }
+
+        kasumi_f8_job(&tmpl, vec, DECRYPT, buf, KASUMI_MAX_BITLEN);
+        job = submit_one_job(mb_mgr, &tmpl);
+        if (job->status != STS_COMPLETED ||
+            !job_output_ok(0, buf, plain, size))
+                goto end;
+
+        kasumi_f8_job(&tmpl, vec, ENCRYPT, buf, KASUMI_MAX_BITLEN + 1);
+        job = submit_one_job(mb_mgr, &tmpl);
+        if (job->status != STS_INVALID_ARGS) {
+                printf("UEA1 max length + 1: status:%d\n", job->status);
+                goto end;
+        }
+        ret = 0;
+
+ end:
+        free(buf);
+        free(plain);
+        return ret;
+}
+
+/*
+ * DIRECTION is an input of f9: MAC of the opposite direction differs,
+ * bits past the message length (test sets 1 and 2 end mid-byte) are
+ * ignored.
+ */
+static int
+test_kasumi_f9_direction(struct MB_MGR *mb_mgr)
+{
+        struct JOB_AES_HMAC tmpl;
+        unsigned i;
+
+        for (i = 0; i < DIM(kasumi_f9_vectors); i++) {
+                const struct kasumi_f9_vector *vec = &kasumi_f9_vectors[i];
+                uint8_t msg[sizeof(KASUMI_F9_M3)];
+                uint8_t tag[KASUMI_DIGEST_LEN];
+                const struct JOB_AES_HMAC *job;
+
+                kasumi_f9_job(&tmpl, vec, vec->len, tag);
+                tmpl.u.KASUMI_UIA1._direction = !vec->direction;
+                job = submit_one_job(mb_mgr, &tmpl);
+                if (job->status != STS_COMPLETED ||
+                    !memcmp(tag, vec->MAC, sizeof(tag))) {
+                        printf("UIA1 set %u: direction ignored\n", i + 1);
+                        return 1;
+                }
+
+                if ((vec->len % 8) == 0)
+                        continue;
+
+                memcpy(msg, vec->M, (vec->len + 7) / 8);
+                msg[vec->len / 8] |= 0xff >> (vec->len % 8);
+                kasumi_f9_job(&tmpl, vec, vec->len, tag);
+                tmpl.src = msg;
+                job = submit_one_job(mb_mgr, &tmpl);
+                if (job->status != STS_COMPLETED ||
+                    !job_output_ok((int) i, tag, vec->MAC, sizeof(tag))) {
+                        printf("UIA1 set %u: trailing bits not ignored\n",
+                               i + 1);
+                        return 1;
+                }
+        }
+        return 0;
+}
+
+/* jobs outside of UEA1/UIA1 key, IV, direction, length and tag limits */
+static int
+test_kasumi_invalid(struct MB_MGR *mb_mgr)
+{
+        const struct kasumi_f8_vector *f8 = &kasumi_f8_vectors[0];
+        const struct kasumi_f9_vector *f9 = &kasumi_f9_vectors[0];
+        struct JOB_AES_HMAC tmpl[7];
+        uint8_t buf[sizeof(KASUMI_F8_P1)];
+        uint8_t tag[8];
+        unsigned i;
+
+        memcpy(buf, f8->P, sizeof(buf));
+        kasumi_f8_job(&tmpl[0], f8, ENCRYPT, buf, f8->len);
+        tmpl[0].aes_key_len_in_bytes = 32;
+        /* UEA1 IV is 8 bytes, unlike UEA2/EEA3 */
+        kasumi_f8_job(&tmpl[1], f8, ENCRYPT, buf, f8->len);
+        tmpl[1].iv_len_in_bytes = 16;
+        kasumi_f8_job(&tmpl[2], f8, ENCRYPT, buf, 0);
+        kasumi_f9_job(&tmpl[3], f9, f9->len, tag);
+        tmpl[3].u.KASUMI_UIA1._direction = 2;
+        kasumi_f9_job(&tmpl[4], f9, 0, tag);
+        kasumi_f9_job(&tmpl[5], f9, KASUMI_MAX_BITLEN + 1, tag);
+        kasumi_f9_job(&tmpl[6], f9, f9->len, tag);
+        tmpl[6].auth_tag_output_len_in_bytes = 8;
+
+        for (i = 0; i < DIM(tmpl); i++) {
+                const struct JOB_AES_HMAC *job = submit_one_job(mb_mgr,
+                                                                &tmpl[i]);
+
+                if (job->status != STS_INVALID_ARGS) {
+                        printf("KASUMI invalid job %u: status:%d\n",
+                               i, job->status);
+                        return 1;
+                }
+        }
+        return 0;
+}
+
+int
+kasumi_test(const enum arch_type arch, struct MB_MGR *mb_mgr)
+{
+        const int num_jobs_tab[] = {
+                1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 33
+        };
+        unsigned i;
+        int errors = 0;
+
+        (void) arch; /* unused */
+
+        printf("KASUMI test vectors:\n");
+        for (i = 0; i < DIM(num_jobs_tab); i++) {
+                const int n = num_jobs_tab[i];
+
+                errors += test_kasumi_f8_many(mb_mgr, ENCRYPT, 1, n);
+                errors += test_kasumi_f8_many(mb_mgr, ENCRYPT, 0, n);
+                errors += test_kasumi_f8_many(mb_mgr, DECRYPT, 1, n);
+                errors += test_kasumi_f8_many(mb_mgr, DECRYPT, 0, n);
+                errors += test_kasumi_f9_many(mb_mgr, n);
+        }
+        errors += test_kasumi_f8_lengths(mb_mgr);
+        errors += test_kasumi_f8_max_len(mb_mgr);
+        errors += test_kasumi_f9_direction(mb_mgr);
+        errors += test_kasumi_invalid(mb_mgr);
+
+	if (0 == errors)
+		printf("...Pass\n");
+	else
+		printf("...Fail\n");
+
+	return errors;
+}
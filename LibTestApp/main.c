@@ -46,6 +46,15 @@ extern int aes_test(const enum arch_type arch, struct MB_MGR *mb_mgr);
 extern int sha_test(const enum arch_type arch, struct MB_MGR *mb_mgr);
 extern int chained_test(const enum arch_type arch, struct MB_MGR *mb_mgr);
 extern int api_test(const enum arch_type arch, struct MB_MGR *mb_mgr);
+extern int docsis_test(const enum arch_type arch, struct MB_MGR *mb_mgr);
+extern int zuc_test(const enum arch_type arch, struct MB_MGR *mb_mgr);
+extern int snow3g_test(const enum arch_type arch, struct MB_MGR *mb_mgr);
+extern int kasumi_test(const enum arch_type arch, struct MB_MGR *mb_mgr);
+extern int sha3_test(const enum arch_type arch, struct MB_MGR *mb_mgr);
+extern int blake2_test(const enum arch_type arch, struct MB_MGR *mb_mgr);
+extern int sm3_test(const enum arch_type arch, struct MB_MGR *mb_mgr);
+extern int sm4_test(const enum arch_type arch, struct MB_MGR *mb_mgr);
+extern int gcm_siv_test(const enum arch_type arch, struct MB_MGR *mb_mgr);
 
 #include "do_test.h"
 
@@ -288,6 +297,15 @@ main(int argc, char **argv)
                 errors += sha_test(atype, p_mgr);
                 errors += chained_test(atype, p_mgr);
                 errors += api_test(atype, p_mgr);
+                errors += docsis_test(atype, p_mgr);
+                errors += zuc_test(atype, p_mgr);
+                errors += snow3g_test(atype, p_mgr);
+                errors += kasumi_test(atype, p_mgr);
+                errors += sha3_test(atype, p_mgr);
+                errors += blake2_test(atype, p_mgr);
+                errors += sm3_test(atype, p_mgr);
+                errors += sm4_test(atype, p_mgr);
+                errors += gcm_siv_test(atype, p_mgr);
                 free_mb_mgr(p_mgr);
         }
 
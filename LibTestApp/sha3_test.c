@@ -0,0 +1,765 @@
+/*****************************************************************************
+ Copyright (c) 2019, Intel Corporation
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+     * Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+     * Neither the name of Intel Corporation nor the names of its contributors
+       may be used to endorse or promote products derived from this software
+       without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include <intel-ipsec-mb.h>
+
+#include "gcm_ctr_vectors_test.h"
+#include "utils.h"
+
+int sha3_test(const enum arch_type arch, struct MB_MGR *mb_mgr);
+
+#define SHA3_TEST_MAX_MSG_LEN 1000
+#define SHA3_TEST_MAX_KEY_LEN 200
+#define SHA3_TEST_MAX_TAG_LEN 400
+
+struct sha3_vector {
+        JOB_HASH_ALG hash_alg;
+        uint64_t msg_len;       /* message is sha3_msg[0 ... msg_len - 1] */
+        uint64_t key_len;       /* HMAC key is sha3_key[0 ... key_len - 1] */
+        const uint8_t *tag;     /* expected digest, SHAKE output or HMAC */
+        uint64_t tag_len;
+};
+
+/*
+ * Expected values computed with an independent implementation
+ * (Python hashlib and hmac modules) for message bytes (7 * i + 1) mod 256
+ * and key bytes (3 * i + 0x11) mod 256.
+ */
+static const uint8_t SHA3_TAG1[] = {
+        0xa7, 0xff, 0xc6, 0xf8, 0xbf, 0x1e, 0xd7, 0x66,
+        0x51, 0xc1, 0x47, 0x56, 0xa0, 0x61, 0xd6, 0x62,
+        0xf5, 0x80, 0xff, 0x4d, 0xe4, 0x3b, 0x49, 0xfa,
+        0x82, 0xd8, 0x0a, 0x4b, 0x80, 0xf8, 0x43, 0x4a
+};
+
+static const uint8_t SHA3_TAG2[] = {
+        0x87, 0x00, 0x6f, 0xc4, 0x1b, 0x38, 0x73, 0x5b,
+        0x9f, 0x02, 0xc8, 0x04, 0x36, 0x7b, 0x5d, 0xb7,
+        0x52, 0x8b, 0x5a, 0x28, 0x00, 0x4f, 0xe2, 0x12,
+        0xcb, 0xc9, 0x2f, 0xa8, 0x17, 0xb2, 0xd2, 0xb1
+};
+
+static const uint8_t SHA3_TAG3[] = {
+        0x64, 0xcc, 0xd3, 0x00, 0xc1, 0xcf, 0x3d, 0x38,
+        0x46, 0x04, 0x6b, 0xd5, 0x88, 0xa1, 0x61, 0x3e,
+        0x5b, 0xa6, 0x19, 0xc0, 0x9d, 0x45, 0xd4, 0xb7,
+        0xcc, 0x9a, 0xfa, 0x09, 0x3a, 0xf2, 0x9e, 0x19
+};
+
+static const uint8_t SHA3_TAG4[] = {
+        0xf1, 0x06, 0xd1, 0x02, 0x4a, 0x85, 0x5c, 0x6a,
+        0x20, 0xd3, 0x00, 0xbb, 0x53, 0xec, 0x54, 0x72,
+        0xa1, 0xba, 0xe1, 0x26, 0xfa, 0x63, 0x0f, 0xee,
+        0x78, 0x21, 0x9b, 0x51, 0xad, 0xd7, 0xd7, 0x68
+};
+
+static const uint8_t SHA3_TAG5[] = {
+        0xfa, 0x4d, 0x0b, 0x01, 0x41, 0xec, 0x2c, 0x69,
+        0xa5, 0xdc, 0x31, 0x4e, 0xd6, 0x11, 0xa0, 0x81,
+        0x9b, 0x92, 0x0e, 0x95, 0xd1, 0x3d, 0x58, 0x6d,
+        0xf8, 0x9f, 0x37, 0x08, 0x09, 0xe9, 0x46, 0x5a
+};
+
+static const uint8_t SHA3_TAG6[] = {
+        0xf5, 0x2b, 0xb9, 0xa0, 0x61, 0xde, 0x50, 0x33,
+        0x07, 0x2a, 0xdd, 0xec, 0xb5, 0xd5, 0x08, 0x7c,
+        0x40, 0x25, 0xb2, 0x2d, 0x80, 0xf6, 0x48, 0x29,
+        0x99, 0x8a, 0xc8, 0x25, 0x4f, 0x59, 0xfa, 0x81
+};
+
+static const uint8_t SHA3_TAG7[] = {
+        0x0c, 0x63, 0xa7, 0x5b, 0x84, 0x5e, 0x4f, 0x7d,
+        0x01, 0x10, 0x7d, 0x85, 0x2e, 0x4c, 0x24, 0x85,
+        0xc5, 0x1a, 0x50, 0xaa, 0xaa, 0x94, 0xfc, 0x61,
+        0x99, 0x5e, 0x71, 0xbb, 0xee, 0x98, 0x3a, 0x2a,
+        0xc3, 0x71, 0x38, 0x31, 0x26, 0x4a, 0xdb, 0x47,
+        0xfb, 0x6b, 0xd1, 0xe0, 0x58, 0xd5, 0xf0, 0x04
+};
+
+static const uint8_t SHA3_TAG8[] = {
+        0x83, 0x69, 0xe3, 0xde, 0x16, 0xe4, 0xea, 0xf5,
+        0x0c, 0x26, 0xd5, 0x37, 0x76, 0xbe, 0xa0, 0x3d,
+        0x2b, 0x8e, 0x76, 0x42, 0xd3, 0x0f, 0xf4, 0x83,
+        0x7a, 0xa0, 0x4f, 0xba, 0x76, 0xf3, 0x3b, 0xf7,
+        0xee, 0x9e, 0xcd, 0xef, 0xc4, 0xa6, 0xa3, 0xfe,
+        0xf9, 0x23, 0x9a, 0xf7, 0x61, 0x8a, 0x76, 0x80
+};
+
+static const uint8_t SHA3_TAG9[] = {
+        0xe2, 0xe0, 0xf6, 0x7a, 0xc9, 0x6a, 0x8f, 0x64,
+        0xad, 0x89, 0x12, 0x89, 0x48, 0x38, 0x9b, 0x2a,
+        0x99, 0x5e, 0xca, 0xe2, 0x24, 0x70, 0xaf, 0x04,
+        0x1e, 0x34, 0xed, 0xe4, 0xd9, 0x15, 0xdb, 0xb5,
+        0x49, 0x4d, 0xfa, 0x15, 0x7f, 0x9b, 0xb1, 0x2c,
+        0x2a, 0xb1, 0x3a, 0xc2, 0x3b, 0x1c, 0xf1, 0x4b
+};
+
+static const uint8_t SHA3_TAG10[] = {
+        0x90, 0x14, 0x1a, 0x6f, 0x9d, 0xd9, 0x22, 0x4d,
+        0x8b, 0xb6, 0xcd, 0x24, 0x1d, 0x14, 0x98, 0x26,
+        0xb0, 0x2c, 0x5f, 0x72, 0x45, 0xdc, 0x32, 0x74,
+        0xa2, 0xbb, 0x89, 0xd2, 0x4b, 0x5f, 0x54, 0xf8,
+        0x12, 0x9d, 0x87, 0xd8, 0xbc, 0xc0, 0x84, 0x18,
+        0xd1, 0x10, 0x1d, 0x17, 0xac, 0x32, 0xab, 0x11
+};
+
+static const uint8_t SHA3_TAG11[] = {
+        0xa6, 0x9f, 0x73, 0xcc, 0xa2, 0x3a, 0x9a, 0xc5,
+        0xc8, 0xb5, 0x67, 0xdc, 0x18, 0x5a, 0x75, 0x6e,
+        0x97, 0xc9, 0x82, 0x16, 0x4f, 0xe2, 0x58, 0x59,
+        0xe0, 0xd1, 0xdc, 0xc1, 0x47, 0x5c, 0x80, 0xa6,
+        0x15, 0xb2, 0x12, 0x3a, 0xf1, 0xf5, 0xf9, 0x4c,
+        0x11, 0xe3, 0xe9, 0x40, 0x2c, 0x3a, 0xc5, 0x58,
+        0xf5, 0x00, 0x19, 0x9d, 0x95, 0xb6, 0xd3, 0xe3,
+        0x01, 0x75, 0x85, 0x86, 0x28, 0x1d, 0xcd, 0x26
+};
+
+static const uint8_t SHA3_TAG12[] = {
+        0x57, 0x4f, 0x81, 0x9c, 0x84, 0x8e, 0x9d, 0x6f,
+        0x49, 0x2f, 0x03, 0x84, 0x70, 0x55, 0x18, 0x03,
+        0x17, 0x74, 0x0c, 0xe2, 0xf8, 0x47, 0x33, 0x74,
+        0xe9, 0xc5, 0x92, 0x55, 0xd9, 0xe2, 0xf5, 0xfc,
+        0x45, 0x6e, 0xef, 0x18, 0xed, 0x16, 0x9f, 0x36,
+        0xb7, 0x4e, 0x82, 0xa0, 0x3e, 0x41, 0x64, 0x69,
+        0x4c, 0x10, 0x23, 0x89, 0xc0, 0x78, 0x14, 0x83,
+        0x83, 0x8c, 0x88, 0x40, 0x89, 0x0c, 0x42, 0x9e
+};
+
+static const uint8_t SHA3_TAG13[] = {
+        0x96, 0x83, 0x6c, 0x50, 0xa2, 0xd8, 0x24, 0xff,
+        0x0e, 0xb2, 0x28, 0xe5, 0x06, 0x0e, 0x0b, 0x88,
+        0xef, 0xd3, 0x0e, 0x10, 0xb3, 0x66, 0x34, 0x7e,
+        0x95, 0xac, 0xe6, 0x90, 0x9b, 0xda, 0x65, 0xb2,
+        0x3f, 0xa8, 0xd2, 0x68, 0xec, 0xf8, 0x8a, 0xd5,
+        0xe5, 0x3c, 0xc3, 0x49, 0x22, 0x80, 0x38, 0x92,
+        0x00, 0x01, 0x55, 0x56, 0xd8, 0xc2, 0xee, 0x3e,
+        0x3f, 0xba, 0xa5, 0xbc, 0xe3, 0xdb, 0x67, 0x8b
+};
+
+static const uint8_t SHA3_TAG14[] = {
+        0x84, 0xdb, 0xb8, 0x70, 0xe1, 0x4f, 0x74, 0x8f,
+        0x3f, 0xf8, 0x75, 0xdf, 0x76, 0xa1, 0xe9, 0xee,
+        0x18, 0xd7, 0xc8, 0xc4, 0x97, 0x37, 0xcd, 0x47,
+        0x3e, 0x80, 0x67, 0x28, 0x96, 0x39, 0x57, 0x93,
+        0x6f, 0x9b, 0xbe, 0x87, 0x25, 0x16, 0xa5, 0x8b,
+        0xe7, 0xde, 0x71, 0x96, 0x95, 0xd0, 0x94, 0xa4,
+        0x25, 0x7a, 0x56, 0x11, 0xdb, 0x43, 0xf1, 0xf2,
+        0x34, 0x3d, 0x32, 0x71, 0x97, 0xed, 0xdc, 0x1e
+};
+
+static const uint8_t SHA3_TAG15[] = {
+        0x7f, 0x9c, 0x2b, 0xa4, 0xe8, 0x8f, 0x82, 0x7d,
+        0x61, 0x60, 0x45, 0x50, 0x76, 0x05, 0x85, 0x3e,
+        0xd7, 0x3b, 0x80, 0x93, 0xf6, 0xef, 0xbc, 0x88,
+        0xeb, 0x1a, 0x6e, 0xac, 0xfa, 0x66, 0xef, 0x26
+};
+
+static const uint8_t SHA3_TAG16[] = {
+        0xf5, 0x56, 0xa4, 0xf5, 0xec, 0x6d, 0x8c, 0x97,
+        0x1f, 0x1d, 0x0c, 0xa3, 0xc0, 0xdc, 0x1a, 0x33
+};
+
+static const uint8_t SHA3_TAG17[] = {
+        0x0a, 0x03, 0x78, 0x14, 0x4c, 0xaa, 0x79, 0x6f,
+        0x9b, 0xc4, 0xaf, 0x37, 0xb5, 0x32, 0x9e, 0xef,
+        0xbf, 0x84, 0x6d, 0xd0, 0xf0, 0x89, 0xd8, 0x7c,
+        0xe1, 0xf0, 0x66, 0x5e, 0x03, 0x3f, 0x7d, 0x26,
+        0x7b, 0xd5, 0xb7, 0x07, 0x22, 0x85, 0x55, 0x6e,
+        0x20, 0x85, 0x15, 0x56, 0x8a, 0x31, 0xc8, 0x41,
+        0xa4, 0xb8, 0x0a, 0x26, 0xed, 0xa9, 0xf1, 0x5b,
+        0xa4, 0xc8, 0x40, 0x6f, 0x6a, 0xb5, 0x98, 0xdc,
+        0x85, 0x7e, 0xaa, 0xea, 0x58, 0x51, 0x65, 0xb8,
+        0x73, 0x52, 0xa2, 0xdc, 0x90, 0xf8, 0x2d, 0x7c,
+        0x6d, 0xb6, 0xe5, 0x31, 0x44, 0x7d, 0x11, 0x5f,
+        0x0d, 0xdd, 0xd3, 0xf9, 0x83, 0xde, 0x83, 0x97,
+        0x0d, 0xb9, 0x92, 0xb2, 0xe8, 0x2f, 0xa7, 0xbc,
+        0x65, 0x66, 0x96, 0x55, 0x60, 0x2f, 0x58, 0x91,
+        0xdc, 0xcf, 0x9a, 0x73, 0xc7, 0xd7, 0xfa, 0x8e,
+        0x00, 0x9d, 0x01, 0x99, 0x1f, 0xe7, 0x79, 0xb2,
+        0x64, 0xa5, 0xb4, 0x78, 0xdf, 0xac, 0x48, 0x65,
+        0x5b, 0xf6, 0xd6, 0xe6, 0x77, 0xdf, 0xc7, 0x2f,
+        0x33, 0xab, 0xbb, 0x58, 0x93, 0x11, 0xa6, 0x58,
+        0x44, 0xa0, 0x0d, 0xca, 0x00, 0x2c, 0x8d, 0x79,
+        0x16, 0x2b, 0xd3, 0xfc, 0x96, 0x17, 0x04, 0x37,
+        0x3d, 0xe4, 0xc8, 0x76, 0xab, 0x0b, 0x35, 0x75,
+        0x19, 0xe1, 0x52, 0x04, 0x6a, 0xfd, 0x0f, 0xe7,
+        0x70, 0x88, 0x97, 0x60, 0x3a, 0xb5, 0xfa, 0x6d,
+        0xf9, 0xb7, 0x35, 0xfa, 0x9d, 0x8b, 0xe3, 0x6d
+};
+
+static const uint8_t SHA3_TAG18[] = {
+        0x94, 0xb2, 0x64, 0x5c, 0x17, 0x1e, 0xef, 0x80,
+        0x38, 0x3c, 0x65, 0x1f, 0x59, 0xf8, 0x65, 0x4f,
+        0x9d, 0x3c, 0xe2, 0x55, 0x0d, 0x17, 0x3d, 0xa2,
+        0xac, 0x15, 0xaa, 0x22, 0x53, 0x32, 0x2c, 0xea,
+        0x75, 0xa7, 0x68, 0x52, 0x9d, 0x31, 0x50, 0x7a,
+        0xba, 0x7c, 0xc9, 0x1c, 0x0e, 0x9a, 0x3c, 0x10,
+        0x10, 0x8b, 0xc6, 0x67, 0x4d, 0x0b, 0x7e, 0x16,
+        0xf5, 0xbf, 0x74, 0x62, 0xde, 0x0b, 0x1b, 0x4f,
+        0xb4, 0xd7, 0xd2, 0x91, 0x57, 0xe0, 0x2b, 0x38,
+        0xc2, 0x0f, 0x81, 0x38, 0xa3, 0x60, 0x3c, 0x42,
+        0x47, 0x3e, 0x7c, 0x83, 0x8c, 0x96, 0xd5, 0xa6,
+        0x92, 0xa7, 0xb5, 0x47, 0x6d, 0x0e, 0x7a, 0x21,
+        0xcf, 0xe3, 0x6a, 0xcb, 0xbc, 0xe8, 0x1d, 0xe7,
+        0x28, 0x91, 0x3c, 0x56, 0xb4, 0x26, 0xa7, 0x5d,
+        0x68, 0xf3, 0x9a, 0xce, 0x88, 0xbc, 0xf7, 0xd0,
+        0x19, 0xdc, 0x99, 0xb5, 0x7e, 0xe7, 0xf3, 0xa2,
+        0xf0, 0xe1, 0x22, 0x0b, 0x80, 0x0e, 0x03, 0x08,
+        0x93, 0xee, 0x98, 0x88, 0xae, 0x31, 0x8f, 0xda,
+        0x7f, 0x16, 0x69, 0xb5, 0x40, 0xa1, 0xeb, 0xf2,
+        0xdc, 0x64, 0xf5, 0xe2, 0xd0, 0xc6, 0xa0, 0xa9,
+        0x41, 0xdb, 0xee, 0x78, 0x03, 0x4b, 0xff, 0xbc,
+        0x92, 0x5d, 0xb5, 0xc8, 0xfa, 0x9a, 0xd0, 0x5a,
+        0x87, 0x41, 0x70, 0xd4, 0x5b, 0x5c, 0xf5, 0x57,
+        0x84, 0x9d, 0x7a, 0x74, 0x40, 0x9e, 0x64, 0xe6,
+        0xdf, 0x3f, 0xf4, 0x50, 0x08, 0x9e, 0x4e, 0xb1,
+        0xa2, 0xdf, 0x1d, 0x5c, 0xb1, 0x76, 0x71, 0xd3,
+        0xcb, 0x5c, 0x34, 0x38, 0xa1, 0x73, 0x8d, 0x05,
+        0xf3, 0xe3, 0x87, 0x88, 0xd7, 0xef, 0x60, 0x2d,
+        0x73, 0xd1, 0x4c, 0x2c, 0xac, 0x9c, 0xe7, 0x24,
+        0x0a, 0xd6, 0xe1, 0x3f, 0x54, 0x1a, 0xa5, 0x3e,
+        0x16, 0x18, 0xbc, 0xba, 0x06, 0x58, 0x91, 0x96,
+        0x90, 0xb0, 0x60, 0x26, 0x09, 0xd3, 0x62, 0x16,
+        0x71, 0x88, 0xc8, 0x5b, 0xd9, 0x76, 0xce, 0xc0,
+        0x95, 0x02, 0xcb, 0x9b, 0xf5, 0x03, 0x6d, 0x6c,
+        0xb5, 0xfe, 0x09, 0x5a, 0x3e, 0xf0, 0xa9, 0x33,
+        0x0b, 0x8f, 0xf9, 0xe1, 0x1f, 0x30, 0x45, 0x6d,
+        0x93, 0xd4, 0x44, 0x7a, 0xbb, 0x86, 0x61, 0xba,
+        0xa9, 0x38, 0xa4, 0xc4, 0x15, 0xe8, 0xfd, 0x47,
+        0x4e, 0x78, 0xa5, 0x2f, 0xa7, 0x26, 0x1a, 0x42,
+        0x77, 0x07, 0xf6, 0x5d, 0x92, 0xd8, 0x6b, 0x80,
+        0xe0, 0xb5, 0x68, 0xbb, 0x2e, 0xbc, 0xef, 0x4b,
+        0xfe, 0xab, 0x4a, 0x06, 0x5d, 0x73, 0x56, 0x8e,
+        0xf9, 0x2d, 0x48, 0x2e, 0x54, 0xad, 0xe8, 0xfc,
+        0xba, 0xcd, 0xef, 0xde, 0x43, 0x77, 0x7a, 0x80,
+        0x72, 0x21, 0x5a, 0x1e, 0x13, 0x4b, 0x00, 0x30,
+        0xec, 0xd2, 0xac, 0xcf, 0x50, 0xb0, 0xb7, 0x5a,
+        0xcb, 0x3f, 0x33, 0xa1, 0xce, 0xf0, 0x82, 0x52,
+        0x9f, 0xa2, 0x00, 0x13, 0x2d, 0x8b, 0x3f, 0x0b,
+        0xdf, 0xb9, 0xa4, 0xe4, 0xe5, 0x4c, 0xb0, 0x9b,
+        0x48, 0xc6, 0xf6, 0x51, 0x22, 0x4f, 0x4d, 0x72
+};
+
+static const uint8_t SHA3_TAG19[] = {
+        0x46, 0xb9, 0xdd, 0x2b, 0x0b, 0xa8, 0x8d, 0x13,
+        0x23, 0x3b, 0x3f, 0xeb, 0x74, 0x3e, 0xeb, 0x24,
+        0x3f, 0xcd, 0x52, 0xea, 0x62, 0xb8, 0x1b, 0x82,
+        0xb5, 0x0c, 0x27, 0x64, 0x6e, 0xd5, 0x76, 0x2f,
+        0xd7, 0x5d, 0xc4, 0xdd, 0xd8, 0xc0, 0xf2, 0x00,
+        0xcb, 0x05, 0x01, 0x9d, 0x67, 0xb5, 0x92, 0xf6,
+        0xfc, 0x82, 0x1c, 0x49, 0x47, 0x9a, 0xb4, 0x86,
+        0x40, 0x29, 0x2e, 0xac, 0xb3, 0xb7, 0xc4, 0xbe
+};
+
+static const uint8_t SHA3_TAG20[] = {
+        0x98, 0x2c, 0x21, 0xd1, 0xd3, 0x28, 0xea, 0x0c,
+        0x18, 0x23, 0x57, 0x95, 0x8a, 0x9f, 0x77, 0x6c,
+        0xa6, 0xa1, 0x81, 0x1b, 0xf0, 0xf2, 0xc6, 0x4b,
+        0x14, 0x26, 0x2e, 0xde, 0xf5, 0xd2, 0x01, 0xc6
+};
+
+static const uint8_t SHA3_TAG21[] = {
+        0xac, 0xa6, 0x5e, 0x9d, 0x4a, 0x27, 0x36, 0x10,
+        0x44, 0xd5, 0x70, 0xd2, 0x07, 0x12, 0xab, 0x5d,
+        0x6f, 0x8a, 0x43, 0xbf, 0xc0, 0xf9, 0xd4, 0xef,
+        0x0b, 0x6f, 0x52, 0xff, 0x7e, 0x60, 0x75, 0x27,
+        0x11, 0x97, 0x65, 0x7d, 0x0b, 0x92, 0x53, 0xbe,
+        0x17, 0x31, 0x92, 0x1f, 0xda, 0x2c, 0x48, 0x0e,
+        0xa1, 0xb0, 0x3b, 0x26, 0x4f, 0xc9, 0xcf, 0x89,
+        0x4b, 0xe1, 0xda, 0x65, 0x89, 0x0a, 0xdc, 0x98,
+        0x09, 0xce, 0x7f, 0x99, 0x7b, 0x22, 0x8d, 0x89,
+        0x2f, 0x1b, 0x30, 0xaa, 0x1d, 0x20, 0x33, 0x8e,
+        0x6a, 0x50, 0xcb, 0x8d, 0x8c, 0x38, 0x03, 0x55,
+        0x73, 0x1e, 0x7c, 0x0a, 0xc3, 0x01, 0xe8, 0x1c,
+        0x77, 0x51, 0xf5, 0xcb, 0x5a, 0xf2, 0x8d, 0x16,
+        0xa6, 0xad, 0x8d, 0xf8, 0x67, 0x3c, 0x2c, 0x2a,
+        0x11, 0x41, 0x79, 0xb0, 0x9a, 0x04, 0xba, 0xcf,
+        0x4d, 0xc6, 0xb4, 0x74, 0xde, 0x33, 0xb9, 0x89,
+        0x9a, 0xaa, 0x58, 0x8d, 0x35, 0x54, 0x9c, 0x5e,
+        0xef, 0x37, 0x92, 0x42, 0x21, 0x66, 0x69, 0xe3,
+        0x24, 0x3a, 0x59, 0x2f, 0xf1, 0xa6, 0x84, 0x08,
+        0x87, 0x6b, 0x22, 0xcb, 0x8a, 0x7a, 0x73, 0xe0,
+        0x01, 0xc6, 0xc9, 0xed, 0x2b, 0xb9, 0x15, 0xdd,
+        0x70, 0x42, 0x90, 0x6f, 0x08, 0xf2, 0xfb, 0xa6,
+        0x84, 0xbb, 0x79, 0x81, 0x9a, 0xaf, 0x9f, 0x15,
+        0x24, 0xee, 0x0a, 0x5c, 0xe3, 0x6f, 0x6c, 0x4d,
+        0x5d, 0xbf, 0xef, 0x3e, 0xe8, 0x47, 0x2c, 0x7d,
+        0x0b, 0xf9, 0xcf, 0x61, 0x5b, 0xa3, 0x5b, 0xfc,
+        0x07, 0x15, 0x26, 0xae, 0x82, 0x49, 0x55, 0x39,
+        0x55, 0xc4, 0x8e, 0x73, 0xf3, 0xb8, 0x2b, 0x33,
+        0x3b, 0x2a, 0x3a, 0x5b, 0xe8, 0xb0, 0xca, 0xab,
+        0x7b, 0x8b, 0x00, 0xfe, 0x9d, 0x9d, 0x7a, 0x71,
+        0x87, 0x96, 0x9b, 0x23, 0x9d, 0x3a, 0x3a, 0x94,
+        0xc8, 0x08, 0x14, 0xfd, 0x2c, 0x74, 0xf9, 0x75,
+        0x4d, 0x7d, 0x69, 0x8a, 0x66, 0x17, 0x0e, 0x14,
+        0x2a, 0xe3, 0x4f, 0x9e, 0x2c, 0x70, 0x47, 0x78,
+        0x66, 0x3b, 0xc5, 0xea, 0x67, 0x73, 0x40, 0xb2,
+        0xe9, 0x65, 0x4f, 0xc7, 0xcf, 0x0a, 0x4f, 0x0f,
+        0x22, 0x0a, 0xa5, 0x1d, 0x13, 0x96, 0xcb, 0xab,
+        0xc3, 0xe1, 0xe9, 0x73
+};
+
+static const uint8_t SHA3_TAG22[] = {
+        0x74, 0x7a, 0xdc, 0x5f, 0xb2, 0x5b, 0x17, 0xdd,
+        0xff, 0x72, 0x30, 0x9e, 0x90, 0xdd, 0x35, 0xb8,
+        0xab, 0x3a, 0x6e, 0xcf, 0x52, 0x0f, 0x01, 0x59,
+        0xf0, 0xea, 0x97, 0x3a, 0xe1, 0x30, 0xb1, 0xf5
+};
+
+static const uint8_t SHA3_TAG23[] = {
+        0xc7, 0xa3, 0x8c, 0xc2, 0xd5, 0x51, 0xa5, 0xe6,
+        0xda, 0x17, 0x4f, 0x01, 0x96, 0x4d, 0x72, 0xc8
+};
+
+static const uint8_t SHA3_TAG24[] = {
+        0xfb, 0x3b, 0x97, 0x8f, 0x99, 0xee, 0x87, 0x2b,
+        0x8c, 0xf0, 0xf9, 0x58, 0x1d, 0x27, 0x08, 0x44,
+        0x45, 0xac, 0x24, 0xdc, 0x6f, 0xaf, 0xb4, 0xab,
+        0xc9, 0xd7, 0x00, 0x19, 0x28, 0xe0, 0x89, 0x7f,
+        0x7b, 0xd1, 0x74, 0x8b, 0xa7, 0x01, 0x7a, 0x61,
+        0xba, 0xb6, 0x48, 0xf1, 0x9b, 0xa0, 0xa1, 0x9d
+};
+
+static const uint8_t SHA3_TAG25[] = {
+        0x33, 0xc2, 0x0f, 0x8a, 0xf0, 0xdd, 0x25, 0xaf,
+        0x41, 0x37, 0x17, 0xd9, 0xb9, 0xde, 0x0c, 0x59,
+        0xcc, 0x1b, 0xa6, 0xcc, 0xfb, 0x1b, 0x1d, 0xe3
+};
+
+static const uint8_t SHA3_TAG26[] = {
+        0x72, 0xa2, 0x8a, 0x1d, 0x95, 0x0f, 0xf8, 0x09,
+        0xc4, 0xc0, 0x74, 0x11, 0x5b, 0x43, 0x6d, 0x24,
+        0x07, 0x55, 0x5f, 0xae, 0xd7, 0x60, 0x4e, 0x1e,
+        0x4d, 0x9d, 0x49, 0xac, 0x9d, 0x89, 0x08, 0xba,
+        0x53, 0x61, 0x33, 0xe3, 0xeb, 0xf6, 0xfe, 0x24,
+        0xdf, 0xf7, 0x3d, 0xda, 0x76, 0xd4, 0xae, 0x98,
+        0xe2, 0x9d, 0xe5, 0x51, 0x19, 0xb0, 0xba, 0x9e,
+        0xf7, 0x40, 0x35, 0xbf, 0x6f, 0x8e, 0x76, 0x49
+};
+
+static const uint8_t SHA3_TAG27[] = {
+        0x09, 0x2e, 0x17, 0x31, 0x90, 0xad, 0x9a, 0x30,
+        0x48, 0xfe, 0xd4, 0x2c, 0x24, 0xa3, 0xe0, 0xb4,
+        0x6d, 0xe9, 0xa3, 0x5d, 0x7e, 0xa5, 0xce, 0x6b,
+        0xc5, 0x94, 0x1e, 0xfc, 0x8e, 0x47, 0x21, 0xa6
+};
+
+static const struct sha3_vector sha3_vectors[] = {
+        { PLAIN_SHA3_256, 0, 0, SHA3_TAG1, 32 },
+        { PLAIN_SHA3_256, 3, 0, SHA3_TAG2, 32 },
+        { PLAIN_SHA3_256, 135, 0, SHA3_TAG3, 32 },
+        { PLAIN_SHA3_256, 136, 0, SHA3_TAG4, 32 },
+        { PLAIN_SHA3_256, 137, 0, SHA3_TAG5, 32 },
+        { PLAIN_SHA3_256, 1000, 0, SHA3_TAG6, 32 },
+        { PLAIN_SHA3_384, 0, 0, SHA3_TAG7, 48 },
+        { PLAIN_SHA3_384, 103, 0, SHA3_TAG8, 48 },
+        { PLAIN_SHA3_384, 104, 0, SHA3_TAG9, 48 },
+        { PLAIN_SHA3_384, 500, 0, SHA3_TAG10, 48 },
+        { PLAIN_SHA3_512, 0, 0, SHA3_TAG11, 64 },
+        { PLAIN_SHA3_512, 72, 0, SHA3_TAG12, 64 },
+        { PLAIN_SHA3_512, 73, 0, SHA3_TAG13, 64 },
+        { PLAIN_SHA3_512, 500, 0, SHA3_TAG14, 64 },
+        { PLAIN_SHAKE128, 0, 0, SHA3_TAG15, 32 },
+        { PLAIN_SHAKE128, 167, 0, SHA3_TAG16, 16 },
+        { PLAIN_SHAKE128, 168, 0, SHA3_TAG17, 200 },
+        { PLAIN_SHAKE128, 1000, 0, SHA3_TAG18, 400 },
+        { PLAIN_SHAKE256, 0, 0, SHA3_TAG19, 64 },
+        { PLAIN_SHAKE256, 136, 0, SHA3_TAG20, 32 },
+        { PLAIN_SHAKE256, 137, 0, SHA3_TAG21, 300 },
+        { SHA3_256, 100, 32, SHA3_TAG22, 32 },
+        { SHA3_256, 136, 200, SHA3_TAG23, 16 },
+        { SHA3_384, 0, 48, SHA3_TAG24, 48 },
+        { SHA3_384, 104, 20, SHA3_TAG25, 24 },
+        { SHA3_512, 72, 64, SHA3_TAG26, 64 },
+        { SHA3_512, 300, 100, SHA3_TAG27, 32 },
+};
+
+/* FIPS 202 examples: SHA3 of "abc" and SHAKE of the empty message */
+static const uint8_t SHA3_256_ABC[] = {
+        0x3a, 0x98, 0x5d, 0xa7, 0x4f, 0xe2, 0x25, 0xb2,
+        0x04, 0x5c, 0x17, 0x2d, 0x6b, 0xd3, 0x90, 0xbd,
+        0x85, 0x5f, 0x08, 0x6e, 0x3e, 0x9d, 0x52, 0x5b,
+        0x46, 0xbf, 0xe2, 0x45, 0x11, 0x43, 0x15, 0x32
+};
+
+static const uint8_t SHA3_384_ABC[] = {
+        0xec, 0x01, 0x49, 0x82, 0x88, 0x51, 0x6f, 0xc9,
+        0x26, 0x45, 0x9f, 0x58, 0xe2, 0xc6, 0xad, 0x8d,
+        0xf9, 0xb4, 0x73, 0xcb, 0x0f, 0xc0, 0x8c, 0x25,
+        0x96, 0xda, 0x7c, 0xf0, 0xe4, 0x9b, 0xe4, 0xb2,
+        0x98, 0xd8, 0x8c, 0xea, 0x92, 0x7a, 0xc7, 0xf5,
+        0x39, 0xf1, 0xed, 0xf2, 0x28, 0x37, 0x6d, 0x25
+};
+
+static const uint8_t SHA3_512_ABC[] = {
+        0xb7, 0x51, 0x85, 0x0b, 0x1a, 0x57, 0x16, 0x8a,
+        0x56, 0x93, 0xcd, 0x92, 0x4b, 0x6b, 0x09, 0x6e,
+        0x08, 0xf6, 0x21, 0x82, 0x74, 0x44, 0xf7, 0x0d,
+        0x88, 0x4f, 0x5d, 0x02, 0x40, 0xd2, 0x71, 0x2e,
+        0x10, 0xe1, 0x16, 0xe9, 0x19, 0x2a, 0xf3, 0xc9,
+        0x1a, 0x7e, 0xc5, 0x76, 0x47, 0xe3, 0x93, 0x40,
+        0x57, 0x34, 0x0b, 0x4c, 0xf4, 0x08, 0xd5, 0xa5,
+        0x65, 0x92, 0xf8, 0x27, 0x4e, 0xec, 0x53, 0xf0
+};
+
+static const uint8_t SHAKE128_EMPTY[] = {
+        0x7f, 0x9c, 0x2b, 0xa4, 0xe8, 0x8f, 0x82, 0x7d,
+        0x61, 0x60, 0x45, 0x50, 0x76, 0x05, 0x85, 0x3e,
+        0xd7, 0x3b, 0x80, 0x93, 0xf6, 0xef, 0xbc, 0x88,
+        0xeb, 0x1a, 0x6e, 0xac, 0xfa, 0x66, 0xef, 0x26
+};
+
+static const uint8_t SHAKE256_EMPTY[] = {
+        0x46, 0xb9, 0xdd, 0x2b, 0x0b, 0xa8, 0x8d, 0x13,
+        0x23, 0x3b, 0x3f, 0xeb, 0x74, 0x3e, 0xeb, 0x24,
+        0x3f, 0xcd, 0x52, 0xea, 0x62, 0xb8, 0x1b, 0x82,
+        0xb5, 0x0c, 0x27, 0x64, 0x6e, 0xd5, 0x76, 0x2f,
+        0xd7, 0x5d, 0xc4, 0xdd, 0xd8, 0xc0, 0xf2, 0x00,
+        0xcb, 0x05, 0x01, 0x9d, 0x67, 0xb5, 0x92, 0xf6,
+        0xfc, 0x82, 0x1c, 0x49, 0x47, 0x9a, 0xb4, 0x86,
+        0x40, 0x29, 0x2e, 0xac, 0xb3, 0xb7, 0xc4, 0xbe
+};
+
+static const struct {
+        JOB_HASH_ALG hash_alg;
+        const char *msg;
+        const uint8_t *tag;
+        uint64_t tag_len;
+} sha3_fips202_vectors[] = {
+        { PLAIN_SHA3_256, "abc", SHA3_256_ABC, sizeof(SHA3_256_ABC) },
+        { PLAIN_SHA3_384, "abc", SHA3_384_ABC, sizeof(SHA3_384_ABC) },
+        { PLAIN_SHA3_512, "abc", SHA3_512_ABC, sizeof(SHA3_512_ABC) },
+        { PLAIN_SHAKE128, "", SHAKE128_EMPTY, sizeof(SHAKE128_EMPTY) },
+        { PLAIN_SHAKE256, "", SHAKE256_EMPTY, sizeof(SHAKE256_EMPTY) },
+};
+
+static uint8_t sha3_msg[SHA3_TEST_MAX_MSG_LEN];
+static uint8_t sha3_key[SHA3_TEST_MAX_KEY_LEN];
+
+/* HMAC key set up for a vector */
+struct sha3_hmac_keys {
+        DECLARE_ALIGNED(uint8_t ipad[SHA3_STATE_SIZE], 16);
+        DECLARE_ALIGNED(uint8_t opad[SHA3_STATE_SIZE], 16);
+};
+
+static void
+sha3_hmac_key_setup(const struct sha3_vector *vec, struct sha3_hmac_keys *k)
+{
+        uint8_t buf[SHA3_MAX_BLOCK_SIZE];
+        uint8_t key[SHA3_512_DIGEST_SIZE_IN_BYTES];
+        const uint8_t *pkey = sha3_key;
+        uint64_t key_len = vec->key_len;
+        uint64_t block_size, i;
+        void (*hash)(const void *, const uint64_t, void *);
+        void (*one_block)(const void *, void *);
+
+        switch (vec->hash_alg) {
+        case SHA3_256:
+                block_size = SHA3_256_BLOCK_SIZE;
+                hash = sha3_256;
+                one_block = sha3_256_one_block;
+                break;
+        case SHA3_384:
+                block_size = SHA3_384_BLOCK_SIZE;
+                hash = sha3_384;
+                one_block = sha3_384_one_block;
+                break;
+        default:
+                block_size = SHA3_512_BLOCK_SIZE;
+                hash = sha3_512;
+                one_block = sha3_512_one_block;
+                break;
+        }
+
+        /* keys longer than the block size are hashed first */
+        if (key_len > block_size) {
+                hash(sha3_key, key_len, key);
+                pkey = key;
+                key_len = (SHA3_STATE_SIZE - block_size) / 2;
+        }
+
+        memset(buf, 0x36, block_size);
+        for (i = 0; i < key_len; i++)
+                buf[i] ^= pkey[i];
+        one_block(buf, k->ipad);
+
+        memset(buf, 0x5c, block_size);
+        for (i = 0; i < key_len; i++)
+                buf[i] ^= pkey[i];
+        one_block(buf, k->opad);
+}
+
+/* state shared by the job callbacks of test_sha3_many() */
+struct sha3_many_ctx {
+        const struct sha3_hmac_keys *keys;
+        uint8_t *tags;
+};
+
+static void
+sha3_fill_job(struct JOB_AES_HMAC *job, const int n, void *arg)
+{
+        const struct sha3_many_ctx *ctx = arg;
+        const unsigned v = n % DIM(sha3_vectors);
+        const struct sha3_vector *vec = &sha3_vectors[v];
+
+        job->cipher_direction = ENCRYPT;
+        job->chain_order = HASH_CIPHER;
+        job->cipher_mode = NULL_CIPHER;
+        job->hash_alg = vec->hash_alg;
+        job->u.HMAC._hashed_auth_key_xor_ipad = ctx->keys[v].ipad;
+        job->u.HMAC._hashed_auth_key_xor_opad = ctx->keys[v].opad;
+        job->src = sha3_msg;
+        job->hash_start_src_offset_in_bytes = 0;
+        job->msg_len_to_hash_in_bytes = vec->msg_len;
+        job->auth_tag_output = &ctx->tags[n * (SHA3_TEST_MAX_TAG_LEN + 1)];
+        job->auth_tag_output_len_in_bytes = vec->tag_len;
+}
+
+static int
+sha3_check_job(const struct JOB_AES_HMAC *job, const int n, void *arg)
+{
+        const struct sha3_vector *vec = &sha3_vectors[n % DIM(sha3_vectors)];
+        const uint8_t *tag = job->auth_tag_output;
+
+        (void) arg;
+        if (!job_output_ok(n, tag, vec->tag, vec->tag_len)) {
+                printf("hash_alg %d mismatched\n", (int) vec->hash_alg);
+                return 0;
+        }
+        /* nothing written past the tag */
+        if (tag[vec->tag_len] != 0xff) {
+                printf("hash_alg %d, job %d overwrite\n",
+                       (int) vec->hash_alg, n);
+                return 0;
+        }
+        return 1;
+}
+
+/*
+ * Submits num_jobs jobs using test vectors in turn, so that lanes
+ * process messages of different lengths and algorithms of the same
+ * sponge rate share the managers.
+ */
+static int
+test_sha3_many(struct MB_MGR *mb_mgr, const int num_jobs)
+{
+        const unsigned num_vecs = DIM(sha3_vectors);
+        struct sha3_hmac_keys *keys = malloc(num_vecs * sizeof(*keys));
+        uint8_t *tags = malloc(num_jobs * (SHA3_TEST_MAX_TAG_LEN + 1));
+        struct sha3_many_ctx ctx;
+        unsigned i;
+        int ret;
+
+        assert(keys != NULL && tags != NULL);
+        memset(tags, -1, num_jobs * (SHA3_TEST_MAX_TAG_LEN + 1));
+
+        for (i = 0; i < num_vecs; i++)
+                if (sha3_vectors[i].key_len != 0)
+                        sha3_hmac_key_setup(&sha3_vectors[i], &keys[i]);
+
+        ctx.keys = keys;
+        ctx.tags = tags;
+        ret = submit_many_jobs(mb_mgr, num_jobs, sha3_fill_job,
+                               sha3_check_job, &ctx);
+
+        free(keys);
+        free(tags);
+        return ret;
+}
+
+/* sets up a plain SHA3/SHAKE job hashing len bytes of msg */
+static void
+sha3_plain_job(struct JOB_AES_HMAC *job, const JOB_HASH_ALG hash_alg,
+               const uint8_t *msg, const uint64_t len, uint8_t *tag,
+               const uint64_t tag_len)
+{
+        memset(job, 0, sizeof(*job));
+        job->cipher_direction = ENCRYPT;
+        job->chain_order = HASH_CIPHER;
+        job->cipher_mode = NULL_CIPHER;
+        job->hash_alg = hash_alg;
+        job->src = msg;
+        job->msg_len_to_hash_in_bytes = len;
+        job->auth_tag_output = tag;
+        job->auth_tag_output_len_in_bytes = tag_len;
+}
+
+static int
+test_sha3_fips202(struct MB_MGR *mb_mgr)
+{
+        struct JOB_AES_HMAC tmpl;
+        unsigned i;
+
+        for (i = 0; i < DIM(sha3_fips202_vectors); i++) {
+                const uint8_t *msg =
+                        (const uint8_t *) sha3_fips202_vectors[i].msg;
+                uint8_t tag[SHA3_512_DIGEST_SIZE_IN_BYTES];
+                const struct JOB_AES_HMAC *job;
+
+                sha3_plain_job(&tmpl, sha3_fips202_vectors[i].hash_alg, msg,
+                               strlen(sha3_fips202_vectors[i].msg), tag,
+                               sha3_fips202_vectors[i].tag_len);
+                job = submit_one_job(mb_mgr, &tmpl);
+                if (job->status != STS_COMPLETED ||
+                    !job_output_ok((int) i, tag, sha3_fips202_vectors[i].tag,
+                                   sha3_fips202_vectors[i].tag_len)) {
+                        printf("FIPS 202 example %u failed\n", i + 1);
+                        return 1;
+                }
+        }
+        return 0;
+}
+
+/*
+ * SHAKE is an XOF: shorter outputs are prefixes of the longer ones.
+ * Output lengths are picked around the rate, where squeezing needs
+ * another Keccak-f permutation.
+ */
+static int
+test_sha3_shake_squeeze(struct MB_MGR *mb_mgr)
+{
+        static const struct {
+                JOB_HASH_ALG hash_alg;
+                uint64_t rate;
+        } shake[] = {
+                { PLAIN_SHAKE128, SHAKE128_BLOCK_SIZE },
+                { PLAIN_SHAKE256, SHAKE256_BLOCK_SIZE },
+        };
+        struct JOB_AES_HMAC tmpl;
+        unsigned i, j;
+
+        for (i = 0; i < DIM(shake); i++) {
+                const uint64_t rate = shake[i].rate;
+                const uint64_t lens[] = {
+                        1, rate - 1, rate, rate + 1, 2 * rate + 1
+                };
+                uint8_t ref[SHA3_TEST_MAX_TAG_LEN];
+                uint8_t tag[SHA3_TEST_MAX_TAG_LEN + 1];
+                const struct JOB_AES_HMAC *job;
+
+                sha3_plain_job(&tmpl, shake[i].hash_alg, sha3_msg, 200, ref,
+                               sizeof(ref));
+                job = submit_one_job(mb_mgr, &tmpl);
+                if (job->status != STS_COMPLETED)
+                        return 1;
+
+                for (j = 0; j < DIM(lens); j++) {
+                        memset(tag, 0xff, sizeof(tag));
+                        sha3_plain_job(&tmpl, shake[i].hash_alg, sha3_msg,
+                                       200, tag, lens[j]);
+                        job = submit_one_job(mb_mgr, &tmpl);
+                        if (job->status != STS_COMPLETED ||
+                            !job_output_ok((int) j, tag, ref, lens[j]) ||
+                            tag[lens[j]] != 0xff) {
+                                printf("hash_alg %d, %u byte output failed\n",
+                                       (int) shake[i].hash_alg,
+                                       (unsigned) lens[j]);
+                                return 1;
+                        }
+                }
+        }
+        return 0;
+}
+
+/*
+ * Plain SHA3 digests can't be truncated, HMAC-SHA3 tags are either full
+ * or half of the digest, SHAKE needs some output.
+ */
+static int
+test_sha3_invalid(struct MB_MGR *mb_mgr)
+{
+        const struct sha3_vector *hmac = &sha3_vectors[21];
+        struct sha3_hmac_keys keys;
+        struct JOB_AES_HMAC tmpl[6];
+        uint8_t tag[SHA3_512_DIGEST_SIZE_IN_BYTES];
+        unsigned i;
+
+        sha3_plain_job(&tmpl[0], PLAIN_SHA3_256, sha3_msg, 3, tag, 16);
+        sha3_plain_job(&tmpl[1], PLAIN_SHA3_512, sha3_msg, 3, tag, 48);
+        sha3_plain_job(&tmpl[2], PLAIN_SHAKE128, sha3_msg, 3, tag, 0);
+
+        assert(hmac->hash_alg == SHA3_256);
+        sha3_hmac_key_setup(hmac, &keys);
+        for (i = 3; i < DIM(tmpl); i++) {
+                sha3_plain_job(&tmpl[i], SHA3_256, sha3_msg, hmac->msg_len,
+                               tag, 32);
+                tmpl[i].u.HMAC._hashed_auth_key_xor_ipad = keys.ipad;
+                tmpl[i].u.HMAC._hashed_auth_key_xor_opad = keys.opad;
+        }
+        tmpl[3].auth_tag_output_len_in_bytes = 20;
+        tmpl[4].auth_tag_output_len_in_bytes = 64;
+        tmpl[5].u.HMAC._hashed_auth_key_xor_opad = NULL;
+
+        for (i = 0; i < DIM(tmpl); i++) {
+                const struct JOB_AES_HMAC *job = submit_one_job(mb_mgr,
+                                                                &tmpl[i]);
+
+                if (job->status != STS_INVALID_ARGS) {
+                        printf("SHA3 invalid job %u: status:%d\n",
+                               i, job->status);
+                        return 1;
+                }
+        }
+        return 0;
+}
+
+int
+sha3_test(const enum arch_type arch, struct MB_MGR *mb_mgr)
+{
+        const int num_jobs_tab[] = {
+                1, 2, 3, 4, 5, 7, 8, 9, 16, 17, 27, 54, 100
+        };
+        unsigned i;
+        int errors = 0;
+
+        (void) arch; /* unused */
+
+        for (i = 0; i < sizeof(sha3_msg); i++)
+                sha3_msg[i] = (uint8_t) (i * 7 + 1);
+        for (i = 0; i < sizeof(sha3_key); i++)
+                sha3_key[i] = (uint8_t) (i * 3 + 0x11);
+
+        printf("SHA3 test vectors:\n");
+        for (i = 0; i < DIM(num_jobs_tab); i++)
+                errors += test_sha3_many(mb_mgr, num_jobs_tab[i]);
+        errors += test_sha3_fips202(mb_mgr);
+        errors += test_sha3_shake_squeeze(mb_mgr);
+        errors += test_sha3_invalid(mb_mgr);
+
+	if (0 == errors)
+		printf("...Pass\n");
+	else
+		printf("...Fail\n");
+
+	return errors;
+}
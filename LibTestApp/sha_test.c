@@ -150,6 +150,28 @@ static const uint8_t digest5[] = {
 };
 #define digest_len5 sizeof(digest5)
 
+static const char test_case6[] = "SHA-512/256 MSG1";
+#define data6 ((const uint8_t *)message1)
+#define data_len6 message1_len
+static const uint8_t digest6[] = {
+        CONVERT_UINT64_TO_8xUINT8(0x53048e2681941ef9),
+        CONVERT_UINT64_TO_8xUINT8(0x9b2e29b76b4c7dab),
+        CONVERT_UINT64_TO_8xUINT8(0xe4c2d0c634fc6d46),
+        CONVERT_UINT64_TO_8xUINT8(0xe0e2f13107e7af23)
+};
+#define digest_len6 sizeof(digest6)
+
+static const char test_case7[] = "SHA-512/224 MSG1";
+#define data7 ((const uint8_t *)message1)
+#define data_len7 message1_len
+static const uint8_t digest7[] = {
+        CONVERT_UINT64_TO_8xUINT8(0x4634270f707b6a54),
+        CONVERT_UINT64_TO_8xUINT8(0xdaae7530460842e2),
+        CONVERT_UINT64_TO_8xUINT8(0x0e37ed265ceee9a4),
+        CONVERT_UINT32_TO_4xUINT8(0x3e8924aa)
+};
+#define digest_len7 sizeof(digest7)
+
 static const char test_case10[] = "SHA-1 MSG2";
 #define data10 ((const uint8_t *)message2)
 #define data_len10 message2_len
@@ -219,6 +241,28 @@ static const uint8_t digest14[] = {
 };
 #define digest_len14 sizeof(digest14)
 
+static const char test_case15[] = "SHA-512/256 MSG2";
+#define data15 ((const uint8_t *)message2)
+#define data_len15 message2_len
+static const uint8_t digest15[] = {
+        CONVERT_UINT64_TO_8xUINT8(0xc672b8d1ef56ed28),
+        CONVERT_UINT64_TO_8xUINT8(0xab87c3622c511406),
+        CONVERT_UINT64_TO_8xUINT8(0x9bdd3ad7b8f97374),
+        CONVERT_UINT64_TO_8xUINT8(0x98d0c01ecef0967a)
+};
+#define digest_len15 sizeof(digest15)
+
+static const char test_case16[] = "SHA-512/224 MSG2";
+#define data16 ((const uint8_t *)message2)
+#define data_len16 message2_len
+static const uint8_t digest16[] = {
+        CONVERT_UINT64_TO_8xUINT8(0x6ed0dd02806fa89e),
+        CONVERT_UINT64_TO_8xUINT8(0x25de060c19d3ac86),
+        CONVERT_UINT64_TO_8xUINT8(0xcabb87d6a0ddd05c),
+        CONVERT_UINT32_TO_4xUINT8(0x333b84f4)
+};
+#define digest_len16 sizeof(digest16)
+
 static const char test_case20[] = "SHA-1 MSG3";
 #define data20 ((const uint8_t *)message3)
 #define data_len20 message3_len
@@ -288,6 +332,28 @@ static const uint8_t digest24[] = {
 };
 #define digest_len24 sizeof(digest24)
 
+static const char test_case25[] = "SHA-512/256 MSG3";
+#define data25 ((const uint8_t *)message3)
+#define data_len25 message3_len
+static const uint8_t digest25[] = {
+        CONVERT_UINT64_TO_8xUINT8(0xbde8e1f9f19bb9fd),
+        CONVERT_UINT64_TO_8xUINT8(0x3406c90ec6bc47bd),
+        CONVERT_UINT64_TO_8xUINT8(0x36d8ada9f11880db),
+        CONVERT_UINT64_TO_8xUINT8(0xc8a22a7078b6a461)
+};
+#define digest_len25 sizeof(digest25)
+
+static const char test_case26[] = "SHA-512/224 MSG3";
+#define data26 ((const uint8_t *)message3)
+#define data_len26 message3_len
+static const uint8_t digest26[] = {
+        CONVERT_UINT64_TO_8xUINT8(0xe5302d6d54bb2422),
+        CONVERT_UINT64_TO_8xUINT8(0x75d1e7622d68df6e),
+        CONVERT_UINT64_TO_8xUINT8(0xb02dedd13f564c13),
+        CONVERT_UINT32_TO_4xUINT8(0xdbda2174)
+};
+#define digest_len26 sizeof(digest26)
+
 static const char test_case30[] = "SHA-1 MSG4";
 #define data30 ((const uint8_t *)message4)
 #define data_len30 message4_len
@@ -357,6 +423,28 @@ static const uint8_t digest34[] = {
 };
 #define digest_len34 sizeof(digest34)
 
+static const char test_case35[] = "SHA-512/256 MSG4";
+#define data35 ((const uint8_t *)message4)
+#define data_len35 message4_len
+static const uint8_t digest35[] = {
+        CONVERT_UINT64_TO_8xUINT8(0x3928e184fb8690f8),
+        CONVERT_UINT64_TO_8xUINT8(0x40da3988121d31be),
+        CONVERT_UINT64_TO_8xUINT8(0x65cb9d3ef83ee614),
+        CONVERT_UINT64_TO_8xUINT8(0x6feac861e19b563a)
+};
+#define digest_len35 sizeof(digest35)
+
+static const char test_case36[] = "SHA-512/224 MSG4";
+#define data36 ((const uint8_t *)message4)
+#define data_len36 message4_len
+static const uint8_t digest36[] = {
+        CONVERT_UINT64_TO_8xUINT8(0x23fec5bb94d60b23),
+        CONVERT_UINT64_TO_8xUINT8(0x308192640b0c4533),
+        CONVERT_UINT64_TO_8xUINT8(0x35d664734fe40e72),
+        CONVERT_UINT32_TO_4xUINT8(0x68674af9)
+};
+#define digest_len36 sizeof(digest36)
+
 #define SHA_TEST_VEC(num, size)                                         \
         { test_case##num, size,                                         \
                         (const uint8_t *) data##num, data_len##num,     \
@@ -364,7 +452,7 @@ static const uint8_t digest34[] = {
 
 static const struct sha_vector {
         const char *test_case;
-        int sha_type;           /* 1, 224, 256, 384 or 512 */
+        int sha_type;   /* 1, 224, 256, 384, 512, 512256 or 512224 */
         const uint8_t *data;
         size_t data_len;
         const uint8_t *digest;
@@ -375,21 +463,29 @@ static const struct sha_vector {
         SHA_TEST_VEC(3, 256),
         SHA_TEST_VEC(4, 384),
         SHA_TEST_VEC(5, 512),
+        SHA_TEST_VEC(6, 512256),
+        SHA_TEST_VEC(7, 512224),
         SHA_TEST_VEC(10, 1),
         SHA_TEST_VEC(11, 224),
         SHA_TEST_VEC(12, 256),
         SHA_TEST_VEC(13, 384),
         SHA_TEST_VEC(14, 512),
+        SHA_TEST_VEC(15, 512256),
+        SHA_TEST_VEC(16, 512224),
         SHA_TEST_VEC(20, 1),
         SHA_TEST_VEC(21, 224),
         SHA_TEST_VEC(22, 256),
         SHA_TEST_VEC(23, 384),
         SHA_TEST_VEC(24, 512),
+        SHA_TEST_VEC(25, 512256),
+        SHA_TEST_VEC(26, 512224),
         SHA_TEST_VEC(30, 1),
         SHA_TEST_VEC(31, 224),
         SHA_TEST_VEC(32, 256),
         SHA_TEST_VEC(33, 384),
-        SHA_TEST_VEC(34, 512)
+        SHA_TEST_VEC(34, 512),
+        SHA_TEST_VEC(35, 512256),
+        SHA_TEST_VEC(36, 512224)
 };
 
 static int
@@ -490,6 +586,12 @@ test_sha(struct MB_MGR *mb_mgr,
                 case 384:
                         job->hash_alg = PLAIN_SHA_384;
                         break;
+                case 512256:
+                        job->hash_alg = PLAIN_SHA_512_256;
+                        break;
+                case 512224:
+                        job->hash_alg = PLAIN_SHA_512_224;
+                        break;
                 case 512:
                 default:
                         job->hash_alg = PLAIN_SHA_512;
@@ -0,0 +1,390 @@
+/*****************************************************************************
+ Copyright (c) 2019, Intel Corporation
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+     * Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+     * Neither the name of Intel Corporation nor the names of its contributors
+       may be used to endorse or promote products derived from this software
+       without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include <intel-ipsec-mb.h>
+
+#include "gcm_ctr_vectors_test.h"
+#include "utils.h"
+
+int sm3_test(const enum arch_type arch, struct MB_MGR *mb_mgr);
+
+#define SM3_TEST_MAX_MSG_LEN 1000
+#define SM3_TEST_MAX_KEY_LEN 100
+
+struct sm3_vector {
+        JOB_HASH_ALG hash_alg;
+        uint64_t msg_len;       /* message is sm3_msg[0 ... msg_len - 1] */
+        uint64_t key_len;       /* HMAC key is sm3_key[0 ... key_len - 1] */
+        const uint8_t *tag;     /* expected digest or HMAC */
+        uint64_t tag_len;
+};
+
+/*
+ * Expected values computed with an independent implementation
+ * (Python hashlib and hmac modules) for message bytes (7 * i + 1) mod 256
+ * and key bytes (3 * i + 0x11) mod 256.
+ */
+static const uint8_t SM3_TAG1[] = {
+        0x1a, 0xb2, 0x1d, 0x83, 0x55, 0xcf, 0xa1, 0x7f,
+        0x8e, 0x61, 0x19, 0x48, 0x31, 0xe8, 0x1a, 0x8f,
+        0x22, 0xbe, 0xc8, 0xc7, 0x28, 0xfe, 0xfb, 0x74,
+        0x7e, 0xd0, 0x35, 0xeb, 0x50, 0x82, 0xaa, 0x2b
+};
+
+static const uint8_t SM3_TAG2[] = {
+        0x99, 0x42, 0xe6, 0x31, 0x2d, 0xea, 0xb4, 0x01,
+        0x45, 0xc5, 0x88, 0xf6, 0xaf, 0x44, 0xd5, 0x9d,
+        0xad, 0x79, 0xe6, 0xfe, 0xa6, 0x0a, 0x92, 0x4e,
+        0xfe, 0xfe, 0x21, 0xa2, 0x07, 0x9d, 0x3e, 0xde
+};
+
+static const uint8_t SM3_TAG3[] = {
+        0x1b, 0x05, 0x4d, 0x22, 0x73, 0xb7, 0x28, 0x98,
+        0xf7, 0x2f, 0x0c, 0x5f, 0xda, 0xb0, 0xd1, 0x35,
+        0x34, 0x6f, 0x0a, 0x5c, 0xad, 0x54, 0x9e, 0x6b,
+        0xe5, 0x76, 0xe1, 0xa9, 0xba, 0x4f, 0x6d, 0xb0
+};
+
+static const uint8_t SM3_TAG4[] = {
+        0x33, 0x14, 0xc3, 0x10, 0x3d, 0x64, 0xdc, 0xbd,
+        0xad, 0x4a, 0x28, 0xa4, 0xbd, 0xd8, 0x27, 0xb5,
+        0xb5, 0x62, 0xd8, 0x9b, 0xc4, 0x16, 0x83, 0xb3,
+        0x30, 0x49, 0x0e, 0x22, 0x69, 0x79, 0xd9, 0x57
+};
+
+static const uint8_t SM3_TAG5[] = {
+        0x63, 0xbe, 0xc1, 0x6a, 0x53, 0x55, 0x62, 0x35,
+        0xbb, 0xb5, 0x15, 0x16, 0x8e, 0x37, 0x0c, 0xb8,
+        0x4b, 0xe8, 0xfc, 0xef, 0xcd, 0x9e, 0x11, 0x79,
+        0xfc, 0x18, 0xa3, 0x67, 0x31, 0x70, 0xdc, 0x25
+};
+
+static const uint8_t SM3_TAG6[] = {
+        0x77, 0x07, 0x91, 0x7e, 0x48, 0xfe, 0x51, 0x0e,
+        0x5f, 0xfc, 0x5f, 0x7c, 0x71, 0xc4, 0xd7, 0x6f,
+        0xec, 0xfa, 0xdc, 0xa1, 0x4e, 0xe2, 0xfe, 0x99,
+        0x05, 0x4d, 0x56, 0x19, 0x83, 0x67, 0x86, 0xca
+};
+
+static const uint8_t SM3_TAG7[] = {
+        0xb1, 0x4d, 0xb1, 0xf5, 0x39, 0xab, 0xd7, 0xf4,
+        0x3d, 0x9f, 0x10, 0x3a, 0xb4, 0xa1, 0x38, 0x40,
+        0xdd, 0xea, 0xe0, 0x2b, 0xc2, 0xdb, 0xce, 0x14,
+        0x3b, 0x73, 0x4c, 0x87, 0x4f, 0x02, 0x04, 0x86
+};
+
+static const uint8_t SM3_TAG8[] = {
+        0x03, 0x02, 0x1e, 0x93, 0xae, 0x61, 0x1c, 0xea,
+        0x12, 0x43, 0x02, 0xc3, 0x4a, 0x9d, 0x5d, 0xac,
+        0xbc, 0x41, 0xa9, 0x86, 0x55, 0x76, 0x90, 0x86,
+        0xca, 0xd0, 0xed, 0xe1, 0xc4, 0x24, 0xf4, 0x37
+};
+
+static const uint8_t SM3_TAG9[] = {
+        0x71, 0x13, 0xbc, 0xcd, 0x2c, 0x83, 0xbc, 0xd8,
+        0x11, 0x04, 0xc2, 0xe7, 0x26, 0x22, 0x28, 0xc1
+};
+
+static const uint8_t SM3_TAG10[] = {
+        0x2d, 0x3e, 0x72, 0xb9, 0xda, 0x9b, 0x3e, 0x16,
+        0x14, 0x39, 0x7f, 0xa8, 0xe8, 0x56, 0x9e, 0x06,
+        0xe6, 0x5f, 0x6d, 0xef, 0xfe, 0xeb, 0xdf, 0xde,
+        0x5b, 0x0f, 0x1d, 0xa9, 0xc0, 0xaa, 0xe0, 0x23
+};
+
+static const uint8_t SM3_TAG11[] = {
+        0x8c, 0xcf, 0x57, 0x8c, 0x6e, 0xfa, 0x1f, 0x8c,
+        0xac, 0x07, 0x44, 0x53, 0x6c, 0xec, 0x76, 0x1b,
+        0xa6, 0x14, 0x61, 0x44, 0xc6, 0x48, 0x84, 0x3b,
+        0x3e, 0x92, 0x0d, 0xcd, 0xb2, 0x77, 0xb4, 0xa5
+};
+
+static const uint8_t SM3_TAG12[] = {
+        0x0d, 0x48, 0x3b, 0xfc, 0xf9, 0x25, 0xe0, 0x44,
+        0x65, 0x9c, 0x88, 0x4f, 0xa7, 0xa5, 0xbd, 0xec
+};
+
+static const struct sm3_vector sm3_vectors[] = {
+        { PLAIN_SM3, 0, 0, SM3_TAG1, 32 },
+        { PLAIN_SM3, 3, 0, SM3_TAG2, 32 },
+        { PLAIN_SM3, 55, 0, SM3_TAG3, 32 },
+        { PLAIN_SM3, 56, 0, SM3_TAG4, 32 },
+        { PLAIN_SM3, 64, 0, SM3_TAG5, 32 },
+        { PLAIN_SM3, 65, 0, SM3_TAG6, 32 },
+        { PLAIN_SM3, 1000, 0, SM3_TAG7, 32 },
+        { SM3, 0, 16, SM3_TAG8, 32 },
+        { SM3, 64, 64, SM3_TAG9, 16 },
+        { SM3, 100, 32, SM3_TAG10, 32 },
+        { SM3, 119, 20, SM3_TAG11, 32 },
+        { SM3, 1000, 100, SM3_TAG12, 16 },
+};
+
+/* GB/T 32905-2016 examples 1 and 2 */
+static const uint8_t SM3_STD_TAG1[] = {
+        0x66, 0xc7, 0xf0, 0xf4, 0x62, 0xee, 0xed, 0xd9,
+        0xd1, 0xf2, 0xd4, 0x6b, 0xdc, 0x10, 0xe4, 0xe2,
+        0x41, 0x67, 0xc4, 0x87, 0x5c, 0xf2, 0xf7, 0xa2,
+        0x29, 0x7d, 0xa0, 0x2b, 0x8f, 0x4b, 0xa8, 0xe0
+};
+
+static const uint8_t SM3_STD_TAG2[] = {
+        0xde, 0xbe, 0x9f, 0xf9, 0x22, 0x75, 0xb8, 0xa1,
+        0x38, 0x60, 0x48, 0x89, 0xc1, 0x8e, 0x5a, 0x4d,
+        0x6f, 0xdb, 0x70, 0xe5, 0x38, 0x7e, 0x57, 0x65,
+        0x29, 0x3d, 0xcb, 0xa3, 0x9c, 0x0c, 0x57, 0x32
+};
+
+static uint8_t sm3_msg[SM3_TEST_MAX_MSG_LEN];
+static uint8_t sm3_key[SM3_TEST_MAX_KEY_LEN];
+
+/* HMAC key set up for a vector */
+struct sm3_hmac_keys {
+        DECLARE_ALIGNED(uint8_t ipad[SM3_DIGEST_SIZE_IN_BYTES], 16);
+        DECLARE_ALIGNED(uint8_t opad[SM3_DIGEST_SIZE_IN_BYTES], 16);
+};
+
+static void
+sm3_hmac_key_setup(const struct sm3_vector *vec, struct sm3_hmac_keys *k)
+{
+        uint8_t buf[SM3_BLOCK_SIZE];
+        uint8_t key[SM3_DIGEST_SIZE_IN_BYTES];
+        const uint8_t *pkey = sm3_key;
+        uint64_t key_len = vec->key_len;
+        uint64_t i;
+
+        /* keys longer than the block size are hashed first */
+        if (key_len > SM3_BLOCK_SIZE) {
+                sm3(sm3_key, key_len, key);
+                pkey = key;
+                key_len = SM3_DIGEST_SIZE_IN_BYTES;
+        }
+
+        memset(buf, 0x36, sizeof(buf));
+        for (i = 0; i < key_len; i++)
+                buf[i] ^= pkey[i];
+        sm3_one_block(buf, k->ipad);
+
+        memset(buf, 0x5c, sizeof(buf));
+        for (i = 0; i < key_len; i++)
+                buf[i] ^= pkey[i];
+        sm3_one_block(buf, k->opad);
+}
+
+/* state shared by the job callbacks of test_sm3_many() */
+struct sm3_many_ctx {
+        const struct sm3_hmac_keys *keys;
+        uint8_t *tags;
+};
+
+static void
+sm3_fill_job(struct JOB_AES_HMAC *job, const int n, void *arg)
+{
+        const struct sm3_many_ctx *ctx = arg;
+        const unsigned v = n % DIM(sm3_vectors);
+        const struct sm3_vector *vec = &sm3_vectors[v];
+
+        job->cipher_direction = ENCRYPT;
+        job->chain_order = HASH_CIPHER;
+        job->cipher_mode = NULL_CIPHER;
+        job->hash_alg = vec->hash_alg;
+        job->u.HMAC._hashed_auth_key_xor_ipad = ctx->keys[v].ipad;
+        job->u.HMAC._hashed_auth_key_xor_opad = ctx->keys[v].opad;
+        job->src = sm3_msg;
+        job->hash_start_src_offset_in_bytes = 0;
+        job->msg_len_to_hash_in_bytes = vec->msg_len;
+        job->auth_tag_output = &ctx->tags[n * (SM3_DIGEST_SIZE_IN_BYTES + 1)];
+        job->auth_tag_output_len_in_bytes = vec->tag_len;
+}
+
+static int
+sm3_check_job(const struct JOB_AES_HMAC *job, const int n, void *arg)
+{
+        const struct sm3_vector *vec = &sm3_vectors[n % DIM(sm3_vectors)];
+        const uint8_t *tag = job->auth_tag_output;
+
+        (void) arg;
+        if (!job_output_ok(n, tag, vec->tag, vec->tag_len)) {
+                printf("hash_alg %d mismatched\n", (int) vec->hash_alg);
+                return 0;
+        }
+        /* nothing written past the tag */
+        if (tag[vec->tag_len] != 0xff) {
+                printf("hash_alg %d, job %d overwrite\n",
+                       (int) vec->hash_alg, n);
+                return 0;
+        }
+        return 1;
+}
+
+/*
+ * Submits num_jobs jobs using test vectors in turn, so that lanes
+ * process messages of different lengths and SM3 and HMAC-SM3 jobs
+ * share the manager.
+ */
+static int
+test_sm3_many(struct MB_MGR *mb_mgr, const int num_jobs)
+{
+        const unsigned num_vecs = DIM(sm3_vectors);
+        struct sm3_hmac_keys *keys = malloc(num_vecs * sizeof(*keys));
+        uint8_t *tags = malloc(num_jobs * (SM3_DIGEST_SIZE_IN_BYTES + 1));
+        struct sm3_many_ctx ctx;
+        unsigned i;
+        int ret;
+
+        assert(keys != NULL && tags != NULL);
+        memset(tags, -1, num_jobs * (SM3_DIGEST_SIZE_IN_BYTES + 1));
+
+        for (i = 0; i < num_vecs; i++)
+                if (sm3_vectors[i].hash_alg == SM3)
+                        sm3_hmac_key_setup(&sm3_vectors[i], &keys[i]);
+
+        ctx.keys = keys;
+        ctx.tags = tags;
+        ret = submit_many_jobs(mb_mgr, num_jobs, sm3_fill_job,
+                               sm3_check_job, &ctx);
+
+        free(keys);
+        free(tags);
+        return ret;
+}
+
+/* sets up a plain SM3 job hashing len bytes of msg */
+static void
+sm3_plain_job(struct JOB_AES_HMAC *job, const uint8_t *msg,
+              const uint64_t len, uint8_t *tag)
+{
+        memset(job, 0, sizeof(*job));
+        job->cipher_direction = ENCRYPT;
+        job->chain_order = HASH_CIPHER;
+        job->cipher_mode = NULL_CIPHER;
+        job->hash_alg = PLAIN_SM3;
+        job->src = msg;
+        job->msg_len_to_hash_in_bytes = len;
+        job->auth_tag_output = tag;
+        job->auth_tag_output_len_in_bytes = SM3_DIGEST_SIZE_IN_BYTES;
+}
+
+/* "abc" and the 64 byte message, that needs a padding only block */
+static int
+test_sm3_std(struct MB_MGR *mb_mgr)
+{
+        uint8_t msg[64];
+        uint8_t tag[SM3_DIGEST_SIZE_IN_BYTES];
+        struct JOB_AES_HMAC tmpl;
+        const struct JOB_AES_HMAC *job;
+        unsigned i;
+
+        sm3_plain_job(&tmpl, (const uint8_t *) "abc", 3, tag);
+        job = submit_one_job(mb_mgr, &tmpl);
+        if (job->status != STS_COMPLETED ||
+            !job_output_ok(1, tag, SM3_STD_TAG1, sizeof(tag)))
+                return 1;
+
+        for (i = 0; i < sizeof(msg); i += 4)
+                memcpy(&msg[i], "abcd", 4);
+        sm3_plain_job(&tmpl, msg, sizeof(msg), tag);
+        job = submit_one_job(mb_mgr, &tmpl);
+        if (job->status != STS_COMPLETED ||
+            !job_output_ok(2, tag, SM3_STD_TAG2, sizeof(tag)))
+                return 1;
+        return 0;
+}
+
+/* plain SM3 can't be truncated, HMAC-SM3 tag is half or full digest */
+static int
+test_sm3_invalid(struct MB_MGR *mb_mgr)
+{
+        const struct sm3_vector *hmac = &sm3_vectors[9];
+        struct sm3_hmac_keys keys;
+        struct JOB_AES_HMAC tmpl[5];
+        uint8_t tag[2 * SM3_DIGEST_SIZE_IN_BYTES];
+        unsigned i;
+
+        sm3_plain_job(&tmpl[0], sm3_msg, 3, tag);
+        tmpl[0].auth_tag_output_len_in_bytes = 16;
+
+        assert(hmac->hash_alg == SM3);
+        sm3_hmac_key_setup(hmac, &keys);
+        for (i = 1; i < DIM(tmpl); i++) {
+                sm3_plain_job(&tmpl[i], sm3_msg, hmac->msg_len, tag);
+                tmpl[i].hash_alg = SM3;
+                tmpl[i].u.HMAC._hashed_auth_key_xor_ipad = keys.ipad;
+                tmpl[i].u.HMAC._hashed_auth_key_xor_opad = keys.opad;
+        }
+        tmpl[1].auth_tag_output_len_in_bytes = 20;
+        tmpl[2].auth_tag_output_len_in_bytes = 64;
+        tmpl[3].u.HMAC._hashed_auth_key_xor_ipad = NULL;
+        tmpl[4].src = NULL;
+
+        for (i = 0; i < DIM(tmpl); i++) {
+                const struct JOB_AES_HMAC *job = submit_one_job(mb_mgr,
+                                                                &tmpl[i]);
+
+                if (job->status != STS_INVALID_ARGS) {
+                        printf("SM3 invalid job %u: status:%d\n",
+                               i, job->status);
+                        return 1;
+                }
+        }
+        return 0;
+}
+
+int
+sm3_test(const enum arch_type arch, struct MB_MGR *mb_mgr)
+{
+        const int num_jobs_tab[] = {
+                1, 2, 3, 4, 5, 7, 8, 9, 16, 17, 27, 54, 100
+        };
+        unsigned i;
+        int errors = 0;
+
+        (void) arch; /* unused */
+
+        for (i = 0; i < sizeof(sm3_msg); i++)
+                sm3_msg[i] = (uint8_t) (i * 7 + 1);
+        for (i = 0; i < sizeof(sm3_key); i++)
+                sm3_key[i] = (uint8_t) (i * 3 + 0x11);
+
+        printf("SM3 test vectors:\n");
+        for (i = 0; i < DIM(num_jobs_tab); i++)
+                errors += test_sm3_many(mb_mgr, num_jobs_tab[i]);
+        errors += test_sm3_std(mb_mgr);
+        errors += test_sm3_invalid(mb_mgr);
+
+	if (0 == errors)
+		printf("...Pass\n");
+	else
+		printf("...Fail\n");
+
+	return errors;
+}
@@ -0,0 +1,1137 @@
+/*****************************************************************************
+ Copyright (c) 2019, Intel Corporation
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+     * Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+     * Neither the name of Intel Corporation nor the names of its contributors
+       may be used to endorse or promote products derived from this software
+       without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include <intel-ipsec-mb.h>
+
+#include "gcm_ctr_vectors_test.h"
+#include "utils.h"
+
+int sm4_test(const enum arch_type arch, struct MB_MGR *mb_mgr);
+
+#define SM4_TEST_MAX_MSG_LEN 1024
+#define SM4_TEST_MAX_AAD_LEN 100
+/* output buffers have one extra byte to check for overwrites */
+#define SM4_TEST_BUF_SIZE    (SM4_TEST_MAX_MSG_LEN + 1)
+#define SM4_TEST_TAG_SIZE    (SM4_BLOCK_SIZE + 1)
+
+struct sm4_vector {
+        JOB_CIPHER_MODE cipher_mode;
+        const uint8_t *key;
+        const uint8_t *iv;
+        uint64_t iv_len;
+        const uint8_t *msg;
+        uint64_t msg_len;
+        const uint8_t *aad;     /* SM4_GCM only */
+        uint64_t aad_len;
+        const uint8_t *ct;      /* expected ciphertext */
+        const uint8_t *tag;     /* expected tag, SM4_GCM only */
+        uint64_t tag_len;
+};
+
+static uint8_t sm4_msg[SM4_TEST_MAX_MSG_LEN];
+static uint8_t sm4_aad[SM4_TEST_MAX_AAD_LEN];
+
+static const uint8_t SM4_KEY[] = {
+        0x21, 0x26, 0x2b, 0x30, 0x35, 0x3a, 0x3f, 0x44,
+        0x49, 0x4e, 0x53, 0x58, 0x5d, 0x62, 0x67, 0x6c
+};
+
+static const uint8_t SM4_IV[] = {
+        0x80, 0x89, 0x92, 0x9b, 0xa4, 0xad, 0xb6, 0xbf,
+        0xc8, 0xd1, 0xda, 0xe3, 0xec, 0xf5, 0xfe, 0x07
+};
+
+/*
+ * Expected values computed with an independent implementation
+ * (OpenSSL for CBC and CTR, Python for CTR with 12 byte IV and GCM)
+ * for message bytes (7 * i + 1) mod 256 and AAD bytes (5 * i + 3) mod 256.
+ */
+static const uint8_t SM4_CT1[] = {
+        0xcb, 0x67, 0x2f, 0x12, 0x5f, 0xb9, 0x3e, 0x30,
+        0x58, 0x3a, 0x18, 0x7d, 0x02, 0x42, 0x26, 0xad
+};
+
+static const uint8_t SM4_CT2[] = {
+        0xcb, 0x67, 0x2f, 0x12, 0x5f, 0xb9, 0x3e, 0x30,
+        0x58, 0x3a, 0x18, 0x7d, 0x02, 0x42, 0x26, 0xad,
+        0xfb, 0x46, 0x94, 0x0f, 0xad, 0xcf, 0xa4, 0x19,
+        0x74, 0x86, 0xb8, 0xb5, 0x5d, 0xdf, 0x37, 0xba,
+        0x3c, 0x57, 0x06, 0xda, 0xd6, 0xe6, 0xe1, 0x7d,
+        0x41, 0xe2, 0x4c, 0xde, 0xe8, 0x7f, 0xfe, 0x98,
+        0xc0, 0xe9, 0x24, 0x16, 0xa8, 0x31, 0x57, 0x02,
+        0x92, 0x0c, 0x9d, 0xd1, 0x9e, 0x6a, 0x26, 0x3b
+};
+
+static const uint8_t SM4_CT3[] = {
+        0xcb, 0x67, 0x2f, 0x12, 0x5f, 0xb9, 0x3e, 0x30,
+        0x58, 0x3a, 0x18, 0x7d, 0x02, 0x42, 0x26, 0xad,
+        0xfb, 0x46, 0x94, 0x0f, 0xad, 0xcf, 0xa4, 0x19,
+        0x74, 0x86, 0xb8, 0xb5, 0x5d, 0xdf, 0x37, 0xba,
+        0x3c, 0x57, 0x06, 0xda, 0xd6, 0xe6, 0xe1, 0x7d,
+        0x41, 0xe2, 0x4c, 0xde, 0xe8, 0x7f, 0xfe, 0x98,
+        0xc0, 0xe9, 0x24, 0x16, 0xa8, 0x31, 0x57, 0x02,
+        0x92, 0x0c, 0x9d, 0xd1, 0x9e, 0x6a, 0x26, 0x3b,
+        0x72, 0x5e, 0xeb, 0xf5, 0x3b, 0x81, 0x7b, 0xbf,
+        0xb8, 0x70, 0xec, 0xee, 0xe1, 0x24, 0xdf, 0xb5,
+        0x1b, 0xfc, 0x3e, 0x03, 0x99, 0x7b, 0x59, 0x37,
+        0x14, 0x61, 0x0b, 0xf8, 0xb6, 0xaf, 0xee, 0x44,
+        0x50, 0x64, 0xad, 0x69, 0xdc, 0x6c, 0x7a, 0x5b,
+        0x7f, 0x98, 0x55, 0x49, 0x8c, 0xc7, 0x79, 0x9a
+};
+
+static const uint8_t SM4_CT4[] = {
+        0xcb, 0x67, 0x2f, 0x12, 0x5f, 0xb9, 0x3e, 0x30,
+        0x58, 0x3a, 0x18, 0x7d, 0x02, 0x42, 0x26, 0xad,
+        0xfb, 0x46, 0x94, 0x0f, 0xad, 0xcf, 0xa4, 0x19,
+        0x74, 0x86, 0xb8, 0xb5, 0x5d, 0xdf, 0x37, 0xba,
+        0x3c, 0x57, 0x06, 0xda, 0xd6, 0xe6, 0xe1, 0x7d,
+        0x41, 0xe2, 0x4c, 0xde, 0xe8, 0x7f, 0xfe, 0x98,
+        0xc0, 0xe9, 0x24, 0x16, 0xa8, 0x31, 0x57, 0x02,
+        0x92, 0x0c, 0x9d, 0xd1, 0x9e, 0x6a, 0x26, 0x3b,
+        0x72, 0x5e, 0xeb, 0xf5, 0x3b, 0x81, 0x7b, 0xbf,
+        0xb8, 0x70, 0xec, 0xee, 0xe1, 0x24, 0xdf, 0xb5,
+        0x1b, 0xfc, 0x3e, 0x03, 0x99, 0x7b, 0x59, 0x37,
+        0x14, 0x61, 0x0b, 0xf8, 0xb6, 0xaf, 0xee, 0x44,
+        0x50, 0x64, 0xad, 0x69, 0xdc, 0x6c, 0x7a, 0x5b,
+        0x7f, 0x98, 0x55, 0x49, 0x8c, 0xc7, 0x79, 0x9a,
+        0xe0, 0x8c, 0xac, 0x42, 0xa9, 0x08, 0x0d, 0xae,
+        0x64, 0xe4, 0xd7, 0x91, 0x9b, 0xc7, 0x93, 0x6d,
+        0x8d, 0x89, 0xd6, 0xcc, 0x4a, 0x41, 0x05, 0x26,
+        0x4b, 0xff, 0x99, 0x5c, 0xcc, 0x4c, 0xbe, 0xec,
+        0x5d, 0xaa, 0x2d, 0xb3, 0xaf, 0xde, 0x65, 0x34,
+        0x5b, 0x35, 0xb8, 0xdb, 0xd9, 0xc7, 0x76, 0x36,
+        0x1f, 0x1f, 0x9b, 0x29, 0x0d, 0xca, 0xfb, 0x84,
+        0x51, 0x41, 0x0f, 0x36, 0x24, 0x16, 0x76, 0x05,
+        0x45, 0x11, 0x37, 0x74, 0x63, 0xda, 0x12, 0x04,
+        0xe5, 0x3c, 0x33, 0x82, 0xef, 0x5e, 0xa9, 0x2b,
+        0x59, 0xee, 0x3e, 0x25, 0xca, 0x32, 0xd4, 0x6c,
+        0x7f, 0x0b, 0x15, 0xf8, 0x57, 0x62, 0x9e, 0x6f,
+        0x1f, 0xc3, 0x0e, 0x71, 0x81, 0xf1, 0x91, 0x27,
+        0xb3, 0xbb, 0x59, 0xb7, 0x86, 0xc3, 0xec, 0x5c,
+        0x1a, 0x05, 0xb4, 0x2c, 0xfe, 0xc7, 0x00, 0x7f,
+        0x8e, 0x3c, 0x62, 0x58, 0xc4, 0x1a, 0x4d, 0x64,
+        0x74, 0x8f, 0x74, 0x60, 0xaf, 0x6d, 0x31, 0x45,
+        0x6b, 0x66, 0x82, 0x2e, 0xcc, 0x24, 0xc4, 0xc5,
+        0x30, 0xa8, 0x17, 0x42, 0xb8, 0x07, 0xd9, 0xf6,
+        0x4e, 0x51, 0x0b, 0x4d, 0xee, 0x34, 0x45, 0x4f,
+        0xa4, 0x34, 0xf1, 0x5e, 0xf8, 0xe2, 0x44, 0x76,
+        0x41, 0xfc, 0x15, 0x43, 0xc8, 0xb4, 0x3c, 0xe2,
+        0x0e, 0x38, 0x58, 0x2d, 0x96, 0xb2, 0x54, 0x6a,
+        0x2b, 0x9a, 0xff, 0x09, 0xac, 0x1a, 0xbc, 0xf5,
+        0xfe, 0x00, 0x67, 0xed, 0x19, 0x0b, 0xf3, 0x89,
+        0xe8, 0xe0, 0x15, 0x0e, 0x9f, 0x95, 0x8a, 0xf8,
+        0xa0, 0x09, 0x9f, 0x76, 0x23, 0x94, 0x06, 0xad,
+        0x41, 0xcf, 0xaa, 0x49, 0x1c, 0xae, 0xd6, 0xeb,
+        0xf9, 0xd7, 0x46, 0x79, 0xed, 0x94, 0x45, 0x60,
+        0x80, 0xee, 0xfd, 0x5d, 0xe7, 0x92, 0xa8, 0x95,
+        0xb7, 0x3b, 0x0a, 0xfe, 0x99, 0x87, 0x78, 0xea,
+        0xe4, 0xd1, 0x52, 0x0a, 0x4a, 0xde, 0x50, 0x42,
+        0xee, 0x26, 0xcf, 0xcf, 0xe2, 0x19, 0xe8, 0x9b,
+        0xb7, 0x13, 0x97, 0x40, 0x74, 0x37, 0xd8, 0x3c,
+        0x75, 0xd4, 0xe9, 0x5a, 0xd0, 0xbe, 0x9b, 0x86,
+        0x99, 0x79, 0xb1, 0xd0, 0x52, 0xf5, 0xdc, 0x5f,
+        0x3e, 0xf6, 0x77, 0x8f, 0x10, 0xe6, 0x7e, 0x23,
+        0xed, 0x30, 0xe9, 0xe3, 0x41, 0xc9, 0xaf, 0x4a,
+        0x35, 0x57, 0xca, 0xf7, 0x90, 0x70, 0xeb, 0x6c,
+        0x51, 0xb5, 0xaf, 0x0f, 0x52, 0xa1, 0x64, 0xd8,
+        0x3b, 0x09, 0x74, 0xc0, 0x8f, 0x35, 0xd1, 0xe3,
+        0x3b, 0xe3, 0x0f, 0x52, 0x80, 0xb0, 0x35, 0xe1,
+        0x47, 0x24, 0xbb, 0x9f, 0xc8, 0xc7, 0xac, 0xc8,
+        0x3e, 0x44, 0x29, 0x56, 0xba, 0xb5, 0xef, 0xf4,
+        0x7a, 0x3b, 0xdb, 0x21, 0xd7, 0x68, 0xdd, 0xe4,
+        0x16, 0x0d, 0x08, 0xb0, 0x11, 0x3a, 0x7a, 0xf5,
+        0xda, 0xa6, 0xf4, 0x46, 0x55, 0xbf, 0xf1, 0x48,
+        0x34, 0x42, 0x45, 0x8c, 0x17, 0x05, 0xa8, 0x29,
+        0x93, 0x12, 0x4c, 0xae, 0xa0, 0x10, 0x27, 0xaf,
+        0x2e, 0x78, 0xf9, 0xbb, 0x27, 0x03, 0x00, 0x46,
+        0x5c, 0xb5, 0x54, 0xc2, 0xac, 0x6c, 0x84, 0xd1,
+        0x8c, 0x40, 0xda, 0x3a, 0x55, 0x20, 0x85, 0x64,
+        0x52, 0x7b, 0x8e, 0x28, 0xd8, 0x3e, 0xf0, 0xa0,
+        0x18, 0x60, 0xea, 0x94, 0xf3, 0x77, 0xeb, 0x21,
+        0xb4, 0xc7, 0x31, 0x4b, 0x70, 0x40, 0x4c, 0x6e,
+        0xd6, 0xeb, 0x2d, 0x57, 0x7e, 0x9d, 0x9c, 0x85,
+        0xf0, 0xb3, 0x54, 0xb4, 0xc2, 0x30, 0x45, 0x72,
+        0x4e, 0xc5, 0xa1, 0xb3, 0xd9, 0x8d, 0x4f, 0x73,
+        0xf4, 0xdd, 0xbe, 0xd8, 0x41, 0x28, 0x34, 0x72,
+        0x8b, 0x4a, 0x9d, 0x83, 0x68, 0x62, 0xd0, 0xe2,
+        0xc5, 0xe1, 0xd7, 0x2c, 0xc9, 0x7a, 0xba, 0x6a,
+        0x33, 0xfe, 0x3a, 0x43, 0xfa, 0x33, 0x1b, 0xdc,
+        0x16, 0x53, 0xe1, 0xdd, 0x4a, 0xf5, 0x15, 0x56,
+        0xe3, 0x77, 0x6f, 0x7d, 0x7e, 0x0e, 0x7a, 0xe5,
+        0x21, 0x8e, 0x55, 0xbd, 0x2d, 0x69, 0x01, 0x67,
+        0x7f, 0x34, 0x53, 0x4d, 0xef, 0x8b, 0x61, 0xe1,
+        0x43, 0x08, 0xda, 0x79, 0x5e, 0xfa, 0xfb, 0xf1,
+        0x7b, 0x26, 0xcc, 0x19, 0xe8, 0xe7, 0xa1, 0xe9,
+        0xe6, 0x6c, 0x60, 0x07, 0xc3, 0xa4, 0x86, 0xb6,
+        0x38, 0x32, 0x40, 0x3d, 0x65, 0x44, 0xe0, 0x01,
+        0x82, 0xa9, 0x3a, 0x35, 0x59, 0x08, 0xd6, 0xb1,
+        0x25, 0x3b, 0xc8, 0x92, 0xf4, 0x26, 0x4b, 0x7c,
+        0xb0, 0xe6, 0xa4, 0xe7, 0x4e, 0xd1, 0xe4, 0x87,
+        0xee, 0x38, 0x13, 0x92, 0x8d, 0x6a, 0x5c, 0x3d,
+        0x6a, 0x32, 0xfe, 0x73, 0x21, 0xff, 0xd0, 0x32,
+        0x3a, 0x65, 0x37, 0xa8, 0xca, 0x5a, 0x23, 0xa9,
+        0x94, 0x91, 0xaa, 0x8c, 0x39, 0x43, 0x41, 0x36,
+        0x6e, 0xdb, 0xb4, 0x30, 0xf9, 0x5a, 0x78, 0x15,
+        0xfc, 0x95, 0xa4, 0x22, 0x9c, 0x93, 0x07, 0x7f,
+        0x4d, 0x9d, 0xdb, 0xa0, 0x64, 0xb5, 0x0d, 0x8d,
+        0x9a, 0x67, 0x02, 0x6a, 0x12, 0x32, 0x01, 0x7b,
+        0xac, 0x3a, 0x0f, 0xf2, 0x92, 0x75, 0x58, 0x89,
+        0xd3, 0x2c, 0x8b, 0x16, 0x69, 0xbf, 0x56, 0x8c,
+        0x9d, 0xd1, 0x7a, 0x23, 0x88, 0xf6, 0xef, 0xbf,
+        0xdd, 0xc4, 0xc0, 0x05, 0xfa, 0x2e, 0xf5, 0x1e,
+        0x54, 0x2f, 0x0b, 0x6a, 0x7d, 0xec, 0xd1, 0xf1,
+        0xc0, 0x11, 0x56, 0x5d, 0x51, 0x3d, 0xdc, 0xbc,
+        0x4d, 0x88, 0x24, 0xd3, 0x3c, 0x06, 0x7e, 0xd8,
+        0x24, 0xc2, 0x8c, 0xcc, 0x66, 0x0a, 0xf4, 0xc7,
+        0x1b, 0xd6, 0x3c, 0x10, 0x0b, 0x0d, 0xd8, 0xcd,
+        0xf7, 0xe7, 0x46, 0x2b, 0x12, 0x97, 0x03, 0xba,
+        0x5c, 0x90, 0x72, 0x6c, 0xa3, 0x78, 0xfa, 0x99,
+        0x99, 0xdc, 0x94, 0x96, 0x25, 0x36, 0x2f, 0xed,
+        0x10, 0xbe, 0x5e, 0x5e, 0x67, 0x21, 0xdb, 0x9a,
+        0x16, 0x14, 0xbb, 0x12, 0x87, 0xeb, 0x91, 0xdb,
+        0x90, 0xc7, 0x12, 0x61, 0x61, 0xc2, 0x95, 0x8e,
+        0x95, 0x4e, 0x75, 0x70, 0x17, 0xe2, 0xee, 0xed,
+        0xc6, 0xae, 0x1f, 0xd3, 0xdc, 0xf7, 0x59, 0xdd,
+        0x6c, 0x6f, 0xbc, 0x79, 0xdb, 0xc0, 0x80, 0x2b,
+        0x15, 0x06, 0xfe, 0x12, 0xf5, 0xea, 0xd7, 0xd8,
+        0x31, 0xa2, 0xf0, 0xf9, 0xdb, 0x6c, 0xc0, 0xdf,
+        0x62, 0x61, 0x93, 0xf3, 0x10, 0xb8, 0x1a, 0xd4,
+        0xfc, 0x82, 0x89, 0x26, 0x74, 0x8b, 0x88, 0x11,
+        0x9f, 0xb3, 0xd8, 0xa6, 0xd4, 0x9b, 0x05, 0xa1,
+        0x2e, 0x18, 0xe3, 0x37, 0x72, 0xfb, 0x4d, 0xe7,
+        0x43, 0x32, 0x1e, 0xaf, 0xd0, 0x7a, 0x43, 0x06,
+        0xa8, 0x6a, 0x39, 0x9d, 0x31, 0x32, 0xfe, 0x11,
+        0xfd, 0xb4, 0xac, 0x26, 0x92, 0x32, 0xf0, 0x70,
+        0xff, 0x72, 0x65, 0x17, 0x8d, 0x1d, 0xb6, 0x54,
+        0x7d, 0x6a, 0xe5, 0x00, 0x2f, 0xbb, 0x94, 0x1b,
+        0x24, 0xf9, 0x08, 0x75, 0x53, 0x3e, 0x7a, 0x8f,
+        0xa3, 0x97, 0x82, 0xee, 0xb2, 0x67, 0x6b, 0x5d,
+        0x83, 0xdd, 0x00, 0xce, 0xec, 0x91, 0xfc, 0xf5,
+        0x46, 0x0e, 0xfe, 0xbd, 0xe5, 0x1a, 0x0c, 0x43
+};
+
+static const uint8_t SM4_CT5[] = {
+        0x8e
+};
+
+static const uint8_t SM4_CT6[] = {
+        0x8e, 0x83, 0x86, 0xbb, 0x8e, 0x4b, 0x66, 0x03,
+        0xdf, 0x7b, 0x3b, 0xb0, 0xa4, 0xd7, 0xa3
+};
+
+static const uint8_t SM4_CT7[] = {
+        0x8e, 0x83, 0x86, 0xbb, 0x8e, 0x4b, 0x66, 0x03,
+        0xdf, 0x7b, 0x3b, 0xb0, 0xa4, 0xd7, 0xa3, 0x95
+};
+
+static const uint8_t SM4_CT8[] = {
+        0x8e, 0x83, 0x86, 0xbb, 0x8e, 0x4b, 0x66, 0x03,
+        0xdf, 0x7b, 0x3b, 0xb0, 0xa4, 0xd7, 0xa3, 0x95,
+        0xbc
+};
+
+static const uint8_t SM4_CT9[] = {
+        0x4b, 0x92, 0x18, 0x27, 0x7c, 0xf8, 0xa9, 0x1f,
+        0xb8, 0xeb, 0xea, 0x35, 0x70, 0x4c, 0xba, 0x67,
+        0xb4, 0xa7, 0x4a, 0x6b, 0xf5, 0x95, 0xe5, 0x47,
+        0x44, 0xb7, 0x95, 0x6f, 0x68, 0x6b, 0xdd, 0x19,
+        0x10, 0x1c, 0x6d, 0x28, 0x0a, 0x54, 0x0c, 0x78,
+        0xbb, 0x85, 0x3c, 0x33, 0x4b, 0x84, 0x6a, 0x32,
+        0xae, 0xe6, 0x50, 0xbe, 0x1b, 0x8b, 0x85, 0x3c,
+        0xbc, 0x76, 0xbb, 0xcb, 0x3d, 0x85, 0x17, 0x48,
+        0xb4, 0x2c, 0x3e, 0xc6, 0x35, 0x92, 0x2e, 0xe7,
+        0xe5, 0xfe, 0x60, 0xd7, 0xd5, 0x29, 0x59, 0xd7,
+        0x46, 0x09, 0xa2, 0x4b, 0xf9, 0x31, 0xd0, 0x22,
+        0x03, 0x45, 0xd6, 0xcd, 0x08, 0xc0, 0x75, 0xfc,
+        0x7a, 0xa2, 0x59, 0x9e
+};
+
+static const uint8_t SM4_CT10[] = {
+        0x4b, 0x92, 0x18, 0x27, 0x7c, 0xf8, 0xa9, 0x1f,
+        0xb8, 0xeb, 0xea, 0x35, 0x70, 0x4c, 0xba, 0x67,
+        0xb4, 0xa7, 0x4a, 0x6b, 0xf5, 0x95, 0xe5, 0x47,
+        0x44, 0xb7, 0x95, 0x6f, 0x68, 0x6b, 0xdd, 0x19,
+        0x10, 0x1c, 0x6d, 0x28, 0x0a, 0x54, 0x0c, 0x78,
+        0xbb, 0x85, 0x3c, 0x33, 0x4b, 0x84, 0x6a, 0x32,
+        0xae, 0xe6, 0x50, 0xbe, 0x1b, 0x8b, 0x85, 0x3c,
+        0xbc, 0x76, 0xbb, 0xcb, 0x3d, 0x85, 0x17, 0x48,
+        0xb4, 0x2c, 0x3e, 0xc6, 0x35, 0x92, 0x2e, 0xe7,
+        0xe5, 0xfe, 0x60, 0xd7, 0xd5, 0x29, 0x59, 0xd7,
+        0x46, 0x09, 0xa2, 0x4b, 0xf9, 0x31, 0xd0, 0x22,
+        0x03, 0x45, 0xd6, 0xcd, 0x08, 0xc0, 0x75, 0xfc,
+        0x7a, 0xa2, 0x59, 0x9e, 0x26, 0x82, 0x5a, 0xba,
+        0xa9, 0x97, 0x62, 0x53, 0xf2, 0xa7, 0x00, 0xc1,
+        0xc9, 0x6b, 0xff, 0x6e, 0x99, 0xf7, 0xbf, 0xd6,
+        0x7c, 0xc3, 0xac, 0x81, 0xee, 0x45, 0x86, 0xd2,
+        0xe1, 0x58, 0xa6, 0x82, 0x9e, 0xbe, 0x9c, 0x8d,
+        0x48, 0xa2, 0x24, 0xd0, 0x59, 0x35, 0xe9, 0x97,
+        0xc2, 0x9b, 0x7a, 0x07, 0x9a, 0x15, 0xcd, 0xab,
+        0x5a, 0x64, 0xbe, 0x41, 0xcc, 0x92, 0xc0, 0x52,
+        0x12, 0xa6, 0xd9, 0x63, 0x8b, 0x0a, 0x06, 0x2c,
+        0x4b, 0x8a, 0x01, 0x46, 0xd0, 0x4a, 0x7b, 0xda,
+        0xc7, 0xc2, 0x11, 0xfe, 0x3f, 0x47, 0x66, 0x98,
+        0x3b, 0x45, 0x4e, 0xfd, 0x46, 0x25, 0xcd, 0xf4,
+        0x72, 0x39, 0x43, 0x89, 0xc9, 0x8c, 0x99, 0xd4,
+        0xa1, 0xe8, 0x80, 0xa8, 0xb7, 0xc9, 0x30, 0xf2,
+        0x4e, 0xd1, 0x44, 0xa9, 0x55, 0xa0, 0xb2, 0xd1,
+        0xc4, 0x28, 0x11, 0x29, 0x06, 0x8c, 0x55, 0x3d,
+        0xb6, 0x97, 0x6b, 0xd2, 0x6d, 0x59, 0x99, 0xe2,
+        0x23, 0x96, 0x6e, 0xc3, 0x17, 0xa7, 0x42, 0x5b,
+        0x26, 0x8c, 0xb5, 0xe5, 0xc9, 0x8a, 0x38, 0xe3,
+        0xcc, 0xc5, 0x7b, 0xa8, 0x1c, 0x9c, 0xa5, 0x30,
+        0x5d
+};
+
+static const uint8_t SM4_CT11[] = {
+        0x8e, 0x83, 0x86, 0xbb, 0x8e, 0x4b, 0x66, 0x03,
+        0xdf, 0x7b, 0x3b, 0xb0, 0xa4, 0xd7, 0xa3, 0x95,
+        0xbc, 0x1f, 0x16, 0x6d, 0x49, 0x05, 0x69, 0xec,
+        0x43, 0x9c, 0x1d, 0x20, 0xdb, 0xa4, 0x9b, 0x46,
+        0xed, 0x8b, 0x35, 0x45, 0xbe, 0xd8, 0xa3, 0xc3,
+        0x55, 0x4e, 0xcd, 0x6a, 0x50, 0x50, 0xba, 0xd8,
+        0xed, 0x21, 0x78, 0x93, 0x23, 0xb3, 0xd2, 0x46,
+        0x2a, 0x9c, 0xc2, 0x2d, 0x3a, 0x9b, 0x40, 0x96,
+        0x72, 0x2d, 0x92, 0x23, 0xab, 0xf8, 0x5c, 0x19,
+        0xc6, 0xff, 0x2e, 0xc0, 0xad, 0xd0, 0xc6, 0x75,
+        0x31, 0xa2, 0x42, 0x38, 0x56, 0xe0, 0x5b, 0x50,
+        0x50, 0xdd, 0xbd, 0xb9, 0x03, 0x19, 0x27, 0x21,
+        0x0e, 0x90, 0xfa, 0xb9, 0x84, 0xfa, 0x76, 0x18,
+        0x47, 0xa2, 0x04, 0x56, 0x7f, 0x0e, 0xe6, 0xf3,
+        0x8e, 0xde, 0x0f, 0x00, 0x24, 0xc6, 0x68, 0x16,
+        0xa8, 0x4b, 0x42, 0x80, 0xdc, 0x1c, 0x6f, 0x9a,
+        0x4a, 0xd8, 0x40, 0x05, 0x0b, 0x0b, 0x49, 0x8d,
+        0x55, 0x18, 0x81, 0x0d, 0x98, 0x69, 0x68, 0x93,
+        0x8d, 0x7e, 0x72, 0x13, 0x35, 0x9b, 0x74, 0x80,
+        0x30, 0x0c, 0x07, 0xfa, 0x1d, 0x09, 0x03, 0xbb,
+        0x30, 0x57, 0x91, 0x32, 0x17, 0x36, 0x1b, 0x3f,
+        0x92, 0x0e, 0x51, 0x30, 0x89, 0x31, 0x64, 0x17,
+        0xa9, 0x40, 0x66, 0x14, 0xe2, 0xc8, 0x6f, 0xfc,
+        0x85, 0x46, 0xc3, 0xd6, 0x09, 0x11, 0x14, 0xde,
+        0xca, 0xf6, 0xe4, 0x1a, 0xdf, 0x02, 0xb3, 0x74,
+        0xb0, 0x28, 0x61, 0x62, 0xdf, 0x98, 0xf1, 0x62,
+        0x6a, 0xa0, 0x67, 0xe7, 0xb2, 0x22, 0xa5, 0xbf,
+        0x94, 0xe2, 0x17, 0xb3, 0x78, 0x54, 0x66, 0x25,
+        0xd4, 0xf6, 0x05, 0xae, 0x72, 0xd3, 0x63, 0xa3,
+        0x02, 0xc4, 0x6c, 0x55, 0x56, 0x36, 0xe3, 0x14,
+        0x03, 0x64, 0x95, 0x8b, 0x71, 0xf1, 0xfe, 0xef,
+        0x87, 0x31, 0x33, 0xad, 0x1b, 0x84, 0x7f, 0x44,
+        0xcf, 0xe3, 0xe7, 0xc3, 0xfa, 0x19, 0xe9, 0x50,
+        0xcb, 0x43, 0x25, 0x2d, 0xe5, 0xfc, 0x5d, 0x94,
+        0xbc, 0x41, 0x53, 0x77, 0x5b, 0xc0, 0x19, 0xa1,
+        0x0e, 0x68, 0x18, 0x7c, 0x63, 0x50, 0xea, 0x21,
+        0xfd, 0xd5, 0x29, 0xc0, 0x73, 0xe8, 0x54, 0x9a,
+        0xf8, 0x58, 0xfe, 0xd9, 0x85, 0x1a, 0x8b, 0x72,
+        0x44, 0x3f, 0x40, 0x7a, 0x5b, 0x8c, 0x3a, 0x16,
+        0x27, 0xb6, 0x33, 0xd5, 0x88, 0x74, 0x61, 0x2f,
+        0x6a, 0xe5, 0xe9, 0x5e, 0xac, 0x48, 0x2a, 0x6f,
+        0x28, 0x69, 0xa6, 0x51, 0xba, 0x28, 0x1d, 0x51,
+        0xa3, 0x58, 0x85, 0x0f, 0xe3, 0xdf, 0x97, 0x1b,
+        0x64, 0x1d, 0x64, 0xa9, 0x26, 0xc5, 0x79, 0xba,
+        0x0c, 0xa9, 0xd1, 0x2a, 0x86, 0x41, 0x2d, 0x68,
+        0x9f, 0x4e, 0x5b, 0x0e, 0x2f, 0x86, 0x7c, 0x33,
+        0x16, 0x0d, 0x89, 0x11, 0x2d, 0xe9, 0x26, 0xce,
+        0x43, 0x8a, 0x49, 0x1d, 0xda, 0x18, 0xbd, 0x56,
+        0x19, 0x0e, 0x90, 0xf1, 0xc9, 0x36, 0xe7, 0x46,
+        0x1b, 0x88, 0x21, 0x76, 0x94, 0xe3, 0xdb, 0xb6,
+        0x4e, 0x0b, 0xc2, 0x8b, 0xc4, 0x54, 0xa2, 0x71,
+        0xf3, 0x77, 0x3a, 0xbf, 0xe3, 0xc1, 0x36, 0x29,
+        0xd3, 0x16, 0xe6, 0xbe, 0xf9, 0xad, 0x00, 0x4d,
+        0xf4, 0x96, 0x1c, 0x8f, 0x1d, 0x55, 0x64, 0x93,
+        0x04, 0xd4, 0xe0, 0xb5, 0x93, 0x85, 0x72, 0xe1,
+        0x45, 0x17, 0x99, 0x7d, 0x9b, 0x98, 0xe1, 0x35,
+        0x17, 0xcd, 0x1b, 0xc9, 0x3b, 0x0a, 0xf8, 0x1b,
+        0xd8, 0x5f, 0xbb, 0x3b, 0xab, 0x24, 0xeb, 0x7f,
+        0x1e, 0x23, 0xdd, 0x32, 0xce, 0x8b, 0x09, 0x5c,
+        0xd7, 0x5a, 0x72, 0x94, 0xfe, 0x79, 0x8e, 0x1f,
+        0xdb, 0x99, 0x43, 0x8b, 0x51, 0x5c, 0xca, 0x56,
+        0x68, 0x32, 0x53, 0x66, 0x6f, 0x9d, 0xa8, 0xf8,
+        0x0b, 0x23, 0xc2, 0x6f, 0xe8, 0x63, 0xd5, 0xd1,
+        0x03, 0x78, 0xf3, 0x99, 0x90, 0xed, 0xff, 0xba,
+        0x2e, 0xff, 0x18, 0x81, 0xb6, 0xca, 0x31, 0x08,
+        0x50, 0xd6, 0xa9, 0x97, 0x68, 0x42, 0xbd, 0x77,
+        0xca, 0x9b, 0x0f, 0x72, 0xa4, 0xb3, 0x43, 0xba,
+        0xb1, 0x6c, 0xf0, 0x86, 0x2f, 0x7e, 0xb7, 0x3b,
+        0x56, 0xe5, 0xbf, 0x2d, 0xf3, 0xa4, 0x83, 0xe5,
+        0x6b, 0xc5, 0xbf, 0x47, 0xae, 0xe6, 0xbc, 0x3a,
+        0x8b, 0x3a, 0x30, 0xbf, 0x33, 0x06, 0x96, 0x63,
+        0x95, 0xbe, 0x4e, 0xf1, 0xfd, 0x2c, 0x90, 0xf9,
+        0x0b, 0xca, 0xbc, 0x70, 0x01, 0x9f, 0xc6, 0x75,
+        0xad, 0xbc, 0x8f, 0xd4, 0x00, 0x94, 0xa0, 0x6f,
+        0xfd, 0x1d, 0x97, 0x00, 0xc9, 0xb6, 0x8e, 0x85,
+        0xeb, 0x14, 0x85, 0xe1, 0x3a, 0xb9, 0xf6, 0xe6,
+        0xe8, 0xf4, 0xb2, 0x91, 0x11, 0xa6, 0x06, 0x3a,
+        0x8a, 0x43, 0x82, 0x98, 0x4a, 0x88, 0xe6, 0xaf,
+        0x7c, 0x25, 0x29, 0xfe, 0xf2, 0x42, 0x90, 0xa1,
+        0xd0, 0x2b, 0x60, 0x40, 0x06, 0x4f, 0x98, 0xa7,
+        0xde, 0x1a, 0x74, 0x84, 0x07, 0x5b, 0x9b, 0x4b,
+        0xac, 0x10, 0xc1, 0x77, 0xd5, 0xb0, 0x27, 0x9e,
+        0xd0, 0x94, 0x87, 0x25, 0x7a, 0xa0, 0x8a, 0xb0,
+        0xc5, 0x80, 0x72, 0xf5, 0xce, 0x4f, 0xad, 0x46,
+        0xd0, 0x8b, 0xaf, 0xd7, 0x11, 0x1a, 0xde, 0xcc,
+        0xe5, 0xa8, 0x87, 0x45, 0x82, 0x8e, 0xdf, 0x15,
+        0xe2, 0x58, 0xc9, 0xa6, 0x3a, 0x18, 0xcc, 0x91,
+        0x1d, 0x7e, 0x7e, 0x3c, 0x89, 0x72, 0x62, 0xbf,
+        0x81, 0xf9, 0xba, 0x41, 0xc9, 0xc7, 0xb4, 0x9c,
+        0x0f, 0xc4, 0x70, 0x78, 0xec, 0x5d, 0xd7, 0xa5,
+        0xbf, 0x00, 0x6b, 0x85, 0x31, 0x1b, 0x90, 0xd0,
+        0x71, 0x69, 0x44, 0x31, 0x00, 0x26, 0x19, 0x5a,
+        0x7a, 0xb2, 0x56, 0x0b, 0x68, 0x7d, 0xab, 0x37,
+        0x3d, 0xd1, 0x35, 0x45, 0x99, 0xe1, 0xc2, 0x27,
+        0x6a, 0xdc, 0x3d, 0xf8, 0x1a, 0x8c, 0x54, 0xa3,
+        0xb9, 0x03, 0x05, 0x15, 0x94, 0xe2, 0xf7, 0x57,
+        0xc3, 0xae, 0x41, 0xec, 0x6e, 0xee, 0xce, 0x27,
+        0x1f, 0x48, 0xff, 0x6d, 0x5c, 0x11, 0xcc, 0xba,
+        0xe9, 0xdb, 0x04, 0xe4, 0x2c, 0x92, 0xf4, 0xd6,
+        0x7b, 0xb1, 0x4f, 0x3b, 0x4a, 0x6b, 0x7c, 0x10,
+        0xf0, 0x36, 0x70, 0x5c, 0xe4, 0x64, 0x10, 0xe2,
+        0xce, 0x37, 0x76, 0xd9, 0xaa, 0x2c, 0xa0, 0x90,
+        0x7e, 0xb0, 0xba, 0xdd, 0xa1, 0xef, 0x3f, 0x62,
+        0xc3, 0xba, 0xc4, 0x48, 0x65, 0xfa, 0xd1, 0xc7,
+        0xa7, 0x08, 0x81, 0x78, 0xc4, 0x0e, 0xc2, 0x5d,
+        0x3e, 0x0d, 0xcc, 0x88, 0x91, 0x5a, 0x05, 0x3b,
+        0x26, 0x64, 0xb6, 0xdf, 0x6c, 0x20, 0x8b, 0xef,
+        0x93, 0x82, 0x72, 0x4d, 0x9a, 0x2e, 0xd5, 0x62,
+        0xc2, 0x2c, 0x04, 0x8a, 0x69, 0xfc, 0x35, 0x5a,
+        0xa1, 0xb9, 0xb3, 0xb1, 0x1a, 0x17, 0x8a, 0xd8,
+        0x65, 0x46, 0x62, 0x1e, 0x31, 0x84, 0x65, 0x18,
+        0x04, 0x2a, 0xb2, 0x9f, 0xc5, 0x34, 0x9a, 0x7a,
+        0xd1, 0x3a, 0x7c, 0xbf, 0x92, 0x92, 0xed, 0x03,
+        0xd7, 0xd9, 0xcd, 0x2e, 0xdc, 0x13, 0x63, 0xc6,
+        0x97, 0x51, 0xd5, 0x0a, 0xa3, 0xe5, 0xdc, 0xe3,
+        0xcd, 0x56, 0x74, 0x63, 0xe0, 0xf1, 0x01, 0xfd,
+        0xe4, 0x05, 0x52, 0x9f, 0x31, 0x2a, 0x1f, 0x4d,
+        0x0d, 0xb1, 0xb5, 0x6b, 0x1f, 0xcc, 0x8d, 0x98,
+        0xa3, 0x3a, 0xf3, 0xb6, 0xbd, 0x5f, 0x4a, 0x1a,
+        0x8a, 0x3c, 0xcd, 0xa7, 0x84, 0x2c, 0x84, 0x5b,
+        0xe1, 0x38, 0x08, 0xd9, 0x44, 0xb2, 0x48, 0x8c,
+        0x91, 0xfa, 0x3b, 0xa8, 0x93, 0xcd, 0xd0, 0xe4,
+        0x6c, 0xa7, 0x20, 0x4a, 0x9d, 0xdb, 0xe3, 0x57,
+        0x83, 0x25, 0x5f, 0xe1, 0x66, 0x94, 0x83, 0xfe,
+        0xcc, 0x5b, 0xe4, 0x02, 0xfe, 0x87, 0xa1, 0xf1
+};
+
+static const uint8_t SM4_TAG12[] = {
+        0x4a, 0x9a, 0x17, 0x31, 0x61, 0xdc, 0x82, 0x2d,
+        0x81, 0xab, 0xad, 0x7b, 0x25, 0x10, 0xd9, 0x0d
+};
+
+static const uint8_t SM4_CT13[] = {
+        0xc4, 0xd7, 0x3a, 0xfb, 0x65, 0x25, 0x55, 0xd7,
+        0xd4, 0x47, 0x65, 0x9f, 0xf8, 0xfb, 0x6d, 0xa9
+};
+
+static const uint8_t SM4_TAG13[] = {
+        0xe9, 0x66, 0x5e, 0x5f, 0x84, 0xba, 0x67, 0x57,
+        0xbd, 0xef, 0x31, 0x49, 0xb6, 0x49, 0xa6, 0x56
+};
+
+static const uint8_t SM4_CT14[] = {
+        0xc4, 0xd7, 0x3a, 0xfb, 0x65, 0x25, 0x55, 0xd7,
+        0xd4, 0x47, 0x65, 0x9f, 0xf8, 0xfb, 0x6d, 0xa9,
+        0x80, 0x8c, 0xfd, 0x58, 0x7a, 0xc4, 0x9c, 0xc8,
+        0x0b, 0x15, 0xac, 0xa3, 0xbb, 0x74, 0xfa, 0xa2,
+        0x1e, 0x56, 0xe0, 0x2e, 0x8b, 0xfb, 0xf5, 0xac,
+        0x2c, 0xc6, 0x0b, 0x7b, 0xad, 0x15, 0xe7, 0xb8,
+        0x24, 0xbc, 0xae, 0x76, 0x85, 0x02, 0xbe, 0x97,
+        0x95, 0x6e, 0xf0, 0x47
+};
+
+static const uint8_t SM4_TAG14[] = {
+        0x32, 0x16, 0x78, 0xdc, 0xd7, 0xbd, 0xaa, 0xd3,
+        0xca, 0xef, 0xa1, 0x62
+};
+
+static const uint8_t SM4_CT15[] = {
+        0xc4, 0xd7, 0x3a, 0xfb, 0x65, 0x25, 0x55, 0xd7,
+        0xd4, 0x47, 0x65, 0x9f, 0xf8, 0xfb, 0x6d, 0xa9,
+        0x80, 0x8c, 0xfd, 0x58, 0x7a, 0xc4, 0x9c, 0xc8,
+        0x0b, 0x15, 0xac, 0xa3, 0xbb, 0x74, 0xfa, 0xa2,
+        0x1e, 0x56, 0xe0, 0x2e, 0x8b, 0xfb, 0xf5, 0xac,
+        0x2c, 0xc6, 0x0b, 0x7b, 0xad, 0x15, 0xe7, 0xb8,
+        0x24, 0xbc, 0xae, 0x76, 0x85, 0x02, 0xbe, 0x97,
+        0x95, 0x6e, 0xf0, 0x47, 0x65, 0x99, 0xc9, 0x47
+};
+
+static const uint8_t SM4_TAG15[] = {
+        0x4f, 0xb7, 0x5f, 0x9e, 0x4d, 0x6e, 0xac, 0x48,
+        0xf3, 0x6b, 0x60, 0x34, 0x4f, 0xab, 0x7e, 0x51
+};
+
+static const uint8_t SM4_CT16[] = {
+        0xc4, 0xd7, 0x3a, 0xfb, 0x65, 0x25, 0x55, 0xd7,
+        0xd4, 0x47, 0x65, 0x9f, 0xf8, 0xfb, 0x6d, 0xa9,
+        0x80, 0x8c, 0xfd, 0x58, 0x7a, 0xc4, 0x9c, 0xc8,
+        0x0b, 0x15, 0xac, 0xa3, 0xbb, 0x74, 0xfa, 0xa2,
+        0x1e, 0x56, 0xe0, 0x2e, 0x8b, 0xfb, 0xf5, 0xac,
+        0x2c, 0xc6, 0x0b, 0x7b, 0xad, 0x15, 0xe7, 0xb8,
+        0x24, 0xbc, 0xae, 0x76, 0x85, 0x02, 0xbe, 0x97,
+        0x95, 0x6e, 0xf0, 0x47, 0x65, 0x99, 0xc9, 0x47,
+        0xb6, 0xf9, 0x52, 0xdb, 0x69, 0x81, 0x60, 0xb2,
+        0x93, 0x35, 0xa6, 0xbd, 0x98, 0x50, 0xc5, 0x4c,
+        0xea, 0x32, 0xc9, 0x6e, 0xd6, 0x12, 0xca, 0x0a,
+        0x19, 0x07, 0xf2, 0xc3, 0x82, 0xd7, 0x90, 0x51,
+        0x79, 0xdb, 0x4f, 0xfe, 0x09, 0x07, 0x4f, 0x46,
+        0xec, 0x73, 0x1c, 0x31, 0x7e, 0xd5, 0xf6, 0xa2,
+        0x71, 0xc8, 0x36, 0x32, 0x2e, 0x2e, 0x0c, 0x7d,
+        0xb8, 0x32, 0xb4, 0x40, 0xe9, 0x85, 0x79, 0x07,
+        0xb2, 0xeb, 0x0a, 0x97, 0x0a, 0xa5, 0x7d, 0x3b,
+        0xca, 0x94, 0x4e, 0xb1, 0x5c, 0x02, 0x70, 0xe2,
+        0x82, 0x36, 0x49, 0x13, 0xfb, 0x9a, 0x96, 0x9c,
+        0xfb, 0x1a, 0x91, 0xd6, 0x20, 0xba, 0xeb, 0x4a,
+        0x77, 0x72, 0xa1, 0x6e, 0xaf, 0x37, 0x16, 0x08,
+        0xab, 0xf5, 0xfe, 0x4d, 0xd6, 0xb5, 0x3d, 0x04,
+        0xe2, 0xa9, 0xd3, 0x39, 0x79, 0x1c, 0x09, 0xa4,
+        0xd1, 0x78, 0x10, 0x38, 0x07, 0x79, 0xa0, 0x62,
+        0xbe, 0x21, 0xb4, 0x39, 0xc5, 0x10, 0x02, 0x41,
+        0x54, 0x58, 0x61, 0x59, 0x96, 0x1c, 0xe5, 0x8d,
+        0x26, 0x07, 0xfb, 0x22, 0x9d, 0xc9, 0x09, 0x52,
+        0x93, 0x06, 0xfe, 0x53, 0x67, 0xd7, 0xd2, 0xcb,
+        0x96, 0x3c, 0x05, 0x75, 0x59, 0x7a, 0xc8, 0x73,
+        0x5c, 0x75, 0xcb, 0x18, 0x8c, 0x0c, 0xd5, 0x40,
+        0xcd, 0x38, 0xae, 0x89, 0x77, 0xe9, 0xa8, 0x6f,
+        0xea, 0x8b, 0x90, 0xef, 0x15, 0x02, 0xa6, 0x33,
+        0x72
+};
+
+static const uint8_t SM4_TAG16[] = {
+        0x85, 0xc2, 0x2b, 0x76, 0x71, 0x1c, 0xa6, 0x7a
+};
+
+static const uint8_t SM4_CT17[] = {
+        0xc4, 0xd7, 0x3a, 0xfb, 0x65, 0x25, 0x55, 0xd7,
+        0xd4, 0x47, 0x65, 0x9f, 0xf8, 0xfb, 0x6d, 0xa9,
+        0x80, 0x8c, 0xfd, 0x58, 0x7a, 0xc4, 0x9c, 0xc8,
+        0x0b, 0x15, 0xac, 0xa3, 0xbb, 0x74, 0xfa, 0xa2,
+        0x1e, 0x56, 0xe0, 0x2e, 0x8b, 0xfb, 0xf5, 0xac,
+        0x2c, 0xc6, 0x0b, 0x7b, 0xad, 0x15, 0xe7, 0xb8,
+        0x24, 0xbc, 0xae, 0x76, 0x85, 0x02, 0xbe, 0x97,
+        0x95, 0x6e, 0xf0, 0x47, 0x65, 0x99, 0xc9, 0x47,
+        0xb6, 0xf9, 0x52, 0xdb, 0x69, 0x81, 0x60, 0xb2,
+        0x93, 0x35, 0xa6, 0xbd, 0x98, 0x50, 0xc5, 0x4c,
+        0xea, 0x32, 0xc9, 0x6e, 0xd6, 0x12, 0xca, 0x0a,
+        0x19, 0x07, 0xf2, 0xc3, 0x82, 0xd7, 0x90, 0x51,
+        0x79, 0xdb, 0x4f, 0xfe, 0x09, 0x07, 0x4f, 0x46,
+        0xec, 0x73, 0x1c, 0x31, 0x7e, 0xd5, 0xf6, 0xa2,
+        0x71, 0xc8, 0x36, 0x32, 0x2e, 0x2e, 0x0c, 0x7d,
+        0xb8, 0x32, 0xb4, 0x40, 0xe9, 0x85, 0x79, 0x07,
+        0xb2, 0xeb, 0x0a, 0x97, 0x0a, 0xa5, 0x7d, 0x3b,
+        0xca, 0x94, 0x4e, 0xb1, 0x5c, 0x02, 0x70, 0xe2,
+        0x82, 0x36, 0x49, 0x13, 0xfb, 0x9a, 0x96, 0x9c,
+        0xfb, 0x1a, 0x91, 0xd6, 0x20, 0xba, 0xeb, 0x4a,
+        0x77, 0x72, 0xa1, 0x6e, 0xaf, 0x37, 0x16, 0x08,
+        0xab, 0xf5, 0xfe, 0x4d, 0xd6, 0xb5, 0x3d, 0x04,
+        0xe2, 0xa9, 0xd3, 0x39, 0x79, 0x1c, 0x09, 0xa4,
+        0xd1, 0x78, 0x10, 0x38, 0x07, 0x79, 0xa0, 0x62,
+        0xbe, 0x21, 0xb4, 0x39, 0xc5, 0x10, 0x02, 0x41,
+        0x54, 0x58, 0x61, 0x59, 0x96, 0x1c, 0xe5, 0x8d,
+        0x26, 0x07, 0xfb, 0x22, 0x9d, 0xc9, 0x09, 0x52,
+        0x93, 0x06, 0xfe, 0x53, 0x67, 0xd7, 0xd2, 0xcb,
+        0x96, 0x3c, 0x05, 0x75, 0x59, 0x7a, 0xc8, 0x73,
+        0x5c, 0x75, 0xcb, 0x18, 0x8c, 0x0c, 0xd5, 0x40,
+        0xcd, 0x38, 0xae, 0x89, 0x77, 0xe9, 0xa8, 0x6f,
+        0xea, 0x8b, 0x90, 0xef, 0x15, 0x02, 0xa6, 0x33,
+        0x72, 0xbe, 0x25, 0xca, 0xee, 0x85, 0x51, 0x96,
+        0xf6, 0x8b, 0xc0, 0xa3, 0x23, 0x7b, 0xd7, 0xf0,
+        0x8d, 0xd4, 0x3b, 0x24, 0x81, 0xdf, 0x5a, 0x17,
+        0x68, 0x57, 0xbd, 0x6a, 0x93, 0x64, 0x41, 0x18,
+        0xd5, 0x58, 0x41, 0x34, 0xfe, 0x82, 0x56, 0x2e,
+        0x97, 0x75, 0xc9, 0x12, 0x0c, 0xd7, 0xc2, 0x7a,
+        0x34, 0xdd, 0x22, 0xee, 0x89, 0x5e, 0x1b, 0x5b,
+        0x3a, 0xef, 0x76, 0x5d, 0xf8, 0xb2, 0xc6, 0x28,
+        0x05, 0x93, 0xea, 0xb1, 0x4d, 0x1e, 0x1a, 0xcc,
+        0xbe, 0xf7, 0x9b, 0xce, 0x47, 0x32, 0x68, 0x8f,
+        0x6f, 0x60, 0x1c, 0x6d, 0x5b, 0x0d, 0x57, 0x60,
+        0x21, 0x26, 0x55, 0x04, 0x99, 0xd5, 0xf3, 0x60,
+        0xec, 0xa9, 0x47, 0x5c, 0x67, 0x63, 0x32, 0xf9,
+        0xd4, 0x30, 0x98, 0x9c, 0xb3, 0x93, 0x77, 0x75,
+        0x1f, 0x03, 0x09, 0x62, 0x93, 0xf9, 0xb8, 0xfd,
+        0x4a, 0x9b, 0xa1, 0x74, 0x6d, 0xf5, 0x69, 0x19,
+        0x07, 0x0a, 0xd5, 0xa9, 0x50, 0xb1, 0xbe, 0xe7,
+        0xe9, 0x46, 0xeb, 0x9d, 0x5d, 0xd8, 0xdc, 0x78,
+        0x5f, 0xdd, 0x1a, 0x26, 0x5e, 0x45, 0x83, 0x80,
+        0x4e, 0x34, 0x87, 0xdf, 0xc1, 0xf5, 0x59, 0x85,
+        0xb3, 0xda, 0x02, 0xa8, 0xa8, 0x7a, 0xaf, 0x87,
+        0xc5, 0xae, 0x4d, 0x10, 0x11, 0x17, 0x52, 0x98,
+        0x65, 0x5f, 0x60, 0x23, 0xa5, 0xb6, 0xa4, 0x1c,
+        0x03, 0x15, 0xde, 0xa2, 0xaa, 0x77, 0x8b, 0x4c,
+        0x5b, 0x4d, 0x25, 0x1e, 0xdb, 0xb4, 0x5c, 0x25,
+        0x04, 0xa4, 0xa7, 0x27, 0x92, 0x2f, 0xf7, 0x6f,
+        0xa7, 0xe7, 0xb3, 0x97, 0x45, 0x04, 0x9c, 0x88,
+        0xd3, 0x13, 0xe0, 0x11, 0x30, 0x06, 0x2c, 0xda,
+        0x65, 0x72, 0x17, 0x30, 0x9d, 0xaf, 0x13, 0xa5,
+        0xff, 0xed, 0xa7, 0xb8, 0x69, 0xd1, 0x00, 0xc7,
+        0x25, 0xc6, 0x5b, 0xee, 0x2c, 0xd9, 0x6d, 0x7b,
+        0x19, 0xf3, 0xe6, 0xe5, 0x0f, 0x1e, 0xb0, 0xa4,
+        0xcc, 0x9c, 0x87, 0x8f, 0xe7, 0x78, 0x15, 0xb4,
+        0x5a, 0xfc, 0x21, 0x08, 0x2f, 0xd0, 0x58, 0xab,
+        0x6c, 0xa3, 0xd0, 0x24, 0xf6, 0x5c, 0x82, 0x76,
+        0x21, 0x0b, 0x89, 0x2c, 0xc0, 0x02, 0x00, 0x74,
+        0xe9, 0xb4, 0x7a, 0xa6, 0x8d, 0x77, 0xf6, 0x66,
+        0xca, 0xbc, 0x45, 0xb8, 0xf6, 0x12, 0x03, 0x86,
+        0x81, 0x1c, 0xaa, 0xb7, 0x1b, 0x5f, 0xbb, 0x78,
+        0xbe, 0xfe, 0x8e, 0x97, 0x30, 0x51, 0x23, 0xd5,
+        0x5b, 0x19, 0xb1, 0x75, 0xb4, 0x76, 0xff, 0x56,
+        0x1c, 0xf7, 0xd3, 0xd1, 0x6a, 0xac, 0x55, 0x52,
+        0xdc, 0x83, 0x7f, 0x0d, 0x48, 0x39, 0x5a, 0x83,
+        0xf9, 0xfe, 0x38, 0xfe, 0x36, 0xdd, 0x58, 0xf8,
+        0x95, 0x08, 0x50, 0x75, 0x77, 0xd7, 0x09, 0xf4,
+        0x8e, 0x1c, 0x8f, 0x27, 0xb2, 0xba, 0x26, 0x1b,
+        0x81, 0xb7, 0x17, 0xe0, 0x4c, 0x9f, 0x4c, 0xfe,
+        0x55, 0xf3, 0x2d, 0xc0, 0x48, 0x7c, 0xe7, 0xd5,
+        0xbb, 0x63, 0xd8, 0x98, 0x59, 0x95, 0x3c, 0xb3,
+        0xe8, 0x5e, 0xe3, 0x61, 0x8d, 0x81, 0x8b, 0x91,
+        0x46, 0x25, 0x07, 0x26, 0x05, 0xd9, 0x65, 0xf5,
+        0xb5, 0xf8, 0x2d, 0x5f, 0xd4, 0xd8, 0x8a, 0x44,
+        0x98, 0xac, 0xc2, 0x9e, 0x43, 0xfb, 0x15, 0x28,
+        0x6e, 0xb7, 0x44, 0x39, 0x0e, 0xf0, 0x62, 0xd3,
+        0x05, 0xa0, 0x39, 0x3d, 0xbd, 0x3b, 0x6f, 0x5b,
+        0x01, 0xca, 0xb5, 0xc1, 0x41, 0xd0, 0x7b, 0xa7,
+        0x37, 0xc4, 0x17, 0x14, 0x9a, 0x34, 0x3e, 0x59,
+        0x08, 0x8b, 0x4c, 0x75, 0x36, 0x1f, 0x7b, 0x1a,
+        0xea, 0x99, 0x3d, 0x2e, 0x78, 0x1f, 0xf7, 0x3f,
+        0x4e, 0x94, 0x27, 0xd1, 0x34, 0xf4, 0x3b, 0x5d,
+        0xd1, 0xa0, 0xa7, 0xfd, 0x5d, 0xe5, 0x2b, 0xeb,
+        0x5c, 0x3f, 0xb8, 0x84, 0xfd, 0x87, 0xa5, 0xe6,
+        0x4c, 0x58, 0x8c, 0x72, 0xc1, 0xe1, 0x24, 0x6b,
+        0xb3, 0x50, 0x82, 0xcb, 0xde, 0x4b, 0x25, 0x15,
+        0x8e, 0x42, 0x82, 0x8e, 0xad, 0x09, 0xda, 0xec,
+        0x55, 0x90, 0xf1, 0x38, 0x4b, 0xec, 0x9e, 0xa2,
+        0x63, 0x51, 0xca, 0xa8, 0xe9, 0xf5, 0x0a, 0x03,
+        0x17, 0xdc, 0xb5, 0x1e, 0x3e, 0x3f, 0x40, 0xa3,
+        0x0f, 0xe3, 0xbc, 0x63, 0x8d, 0xb1, 0x06, 0xfb,
+        0x63, 0x49, 0x02, 0xc1, 0xfb, 0x4b, 0x31, 0x91,
+        0xd7, 0xe6, 0xb0, 0x34, 0x5e, 0xca, 0x2a, 0xd6,
+        0xf6, 0x03, 0x99, 0xe1, 0x45, 0xda, 0xc3, 0x64,
+        0x29, 0x2f, 0x35, 0xda, 0x8e, 0x2e, 0xab, 0xb2,
+        0x2b, 0xac, 0x41, 0x10, 0x7c, 0x48, 0xbf, 0xdb,
+        0xd5, 0x28, 0xa8, 0x38, 0x4d, 0xc1, 0x5d, 0xa1,
+        0xdc, 0x35, 0xae, 0x26, 0xb7, 0x45, 0x4d, 0x00,
+        0xa8, 0x08, 0xa5, 0xb4, 0x3a, 0xcb, 0x4f, 0x52,
+        0x36, 0x05, 0x4a, 0x46, 0x1e, 0x4e, 0x58, 0x87,
+        0x91, 0xa2, 0x7c, 0x32, 0xc0, 0x8a, 0x1b, 0x91,
+        0x98, 0x67, 0xf8, 0x8b, 0xad, 0x15, 0x4f, 0x97,
+        0xac, 0x03, 0x76, 0x9e, 0x7d, 0x02, 0xd6, 0xc2,
+        0xea, 0x9e, 0xc4, 0x94, 0xfb, 0x10, 0xa4, 0x17,
+        0xd5, 0x1a, 0x7e, 0xec, 0x3f, 0x10, 0x8d, 0x27,
+        0x53, 0x6f, 0x68, 0x8a, 0xf2, 0x98, 0x56, 0x89,
+        0xb6, 0xdb, 0x3c, 0x0a, 0x6c, 0x9b, 0xb8, 0x4b,
+        0x68, 0x9d, 0xba, 0x45, 0x7d, 0x45, 0x01, 0x5f,
+        0x51, 0xe3, 0x61, 0x39, 0x01, 0xb6, 0xf2, 0xfa,
+        0x4f, 0x58, 0x89, 0x69, 0x2a, 0x2b, 0x63, 0x0e,
+        0xaa, 0x92, 0x5a, 0x93, 0x2b, 0xd5, 0x18, 0x98,
+        0xf1, 0x71, 0xfc, 0x5f, 0x91, 0x90, 0xc0, 0xf8,
+        0xde, 0xd6, 0xa6, 0x26, 0x54, 0x9f, 0xdf, 0x1d,
+        0xd1, 0x2c, 0xe4, 0x65, 0x89, 0x6a, 0xae, 0x47,
+        0x9b, 0xa0, 0x56, 0x08, 0x76, 0x49, 0xb0, 0x7a
+};
+
+static const uint8_t SM4_TAG17[] = {
+        0x0a, 0x80, 0x9e, 0x18, 0x92, 0xef, 0x62, 0x5b,
+        0x24, 0xb4, 0x18, 0xd8, 0x0e, 0xcd, 0x4e, 0x3d
+};
+
+/* GB/T 32907-2016 example 1, as a single block CBC with zero IV */
+static const uint8_t SM4_STD_KEY[] = {
+        0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef,
+        0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10
+};
+
+static const uint8_t SM4_STD_IV[] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+static const uint8_t SM4_STD_CT[] = {
+        0x68, 0x1e, 0xdf, 0x34, 0xd2, 0x06, 0x96, 0x5e,
+        0x86, 0xb3, 0xe9, 0x4f, 0x53, 0x6e, 0x42, 0x46
+};
+
+/*
+ * GB/T 32907-2016 example 2: example 1 plain text encrypted 1000000 times
+ * with the same key
+ */
+static const uint8_t SM4_STD_CT_1M[] = {
+        0x59, 0x52, 0x98, 0xc7, 0xc6, 0xfd, 0x27, 0x1f,
+        0x04, 0x02, 0xf8, 0x04, 0xc3, 0x3d, 0x3f, 0x66
+};
+
+/* RFC 8998 SM4-GCM example */
+static const uint8_t SM4_RFC_IV[] = {
+        0x00, 0x00, 0x12, 0x34, 0x56, 0x78, 0x00, 0x00,
+        0x00, 0x00, 0xab, 0xcd
+};
+
+static const uint8_t SM4_RFC_AAD[] = {
+        0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+        0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+        0xab, 0xad, 0xda, 0xd2
+};
+
+static const uint8_t SM4_RFC_PT[] = {
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+        0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb,
+        0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc,
+        0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd,
+        0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee, 0xee,
+        0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa
+};
+
+static const uint8_t SM4_RFC_CT[] = {
+        0x17, 0xf3, 0x99, 0xf0, 0x8c, 0x67, 0xd5, 0xee,
+        0x19, 0xd0, 0xdc, 0x99, 0x69, 0xc4, 0xbb, 0x7d,
+        0x5f, 0xd4, 0x6f, 0xd3, 0x75, 0x64, 0x89, 0x06,
+        0x91, 0x57, 0xb2, 0x82, 0xbb, 0x20, 0x07, 0x35,
+        0xd8, 0x27, 0x10, 0xca, 0x5c, 0x22, 0xf0, 0xcc,
+        0xfa, 0x7c, 0xbf, 0x93, 0xd4, 0x96, 0xac, 0x15,
+        0xa5, 0x68, 0x34, 0xcb, 0xcf, 0x98, 0xc3, 0x97,
+        0xb4, 0x02, 0x4a, 0x26, 0x91, 0x23, 0x3b, 0x8d
+};
+
+static const uint8_t SM4_RFC_TAG[] = {
+        0x83, 0xde, 0x35, 0x41, 0xe4, 0xc2, 0xb5, 0x81,
+        0x77, 0xe0, 0x65, 0xa9, 0xbf, 0x7b, 0x62, 0xec
+};
+
+static const struct sm4_vector sm4_vectors[] = {
+        { SM4_CBC, SM4_KEY, SM4_IV, 16, sm4_msg, 16, NULL, 0,
+          SM4_CT1, NULL, 0 },
+        { SM4_CBC, SM4_KEY, SM4_IV, 16, sm4_msg, 64, NULL, 0,
+          SM4_CT2, NULL, 0 },
+        { SM4_CBC, SM4_KEY, SM4_IV, 16, sm4_msg, 112, NULL, 0,
+          SM4_CT3, NULL, 0 },
+        { SM4_CBC, SM4_KEY, SM4_IV, 16, sm4_msg, 1024, NULL, 0,
+          SM4_CT4, NULL, 0 },
+        { SM4_CNTR, SM4_KEY, SM4_IV, 16, sm4_msg, 1, NULL, 0,
+          SM4_CT5, NULL, 0 },
+        { SM4_CNTR, SM4_KEY, SM4_IV, 16, sm4_msg, 15, NULL, 0,
+          SM4_CT6, NULL, 0 },
+        { SM4_CNTR, SM4_KEY, SM4_IV, 16, sm4_msg, 16, NULL, 0,
+          SM4_CT7, NULL, 0 },
+        { SM4_CNTR, SM4_KEY, SM4_IV, 16, sm4_msg, 17, NULL, 0,
+          SM4_CT8, NULL, 0 },
+        { SM4_CNTR, SM4_KEY, SM4_IV, 12, sm4_msg, 100, NULL, 0,
+          SM4_CT9, NULL, 0 },
+        { SM4_CNTR, SM4_KEY, SM4_IV, 12, sm4_msg, 257, NULL, 0,
+          SM4_CT10, NULL, 0 },
+        { SM4_CNTR, SM4_KEY, SM4_IV, 16, sm4_msg, 1000, NULL, 0,
+          SM4_CT11, NULL, 0 },
+        { SM4_GCM, SM4_KEY, SM4_IV, 12, sm4_msg, 0, NULL, 0,
+          NULL, SM4_TAG12, 16 },
+        { SM4_GCM, SM4_KEY, SM4_IV, 12, sm4_msg, 16, sm4_aad, 20,
+          SM4_CT13, SM4_TAG13, 16 },
+        { SM4_GCM, SM4_KEY, SM4_IV, 12, sm4_msg, 60, sm4_aad, 20,
+          SM4_CT14, SM4_TAG14, 12 },
+        { SM4_GCM, SM4_KEY, SM4_IV, 12, sm4_msg, 64, NULL, 0,
+          SM4_CT15, SM4_TAG15, 16 },
+        { SM4_GCM, SM4_KEY, SM4_IV, 12, sm4_msg, 257, sm4_aad, 13,
+          SM4_CT16, SM4_TAG16, 8 },
+        { SM4_GCM, SM4_KEY, SM4_IV, 12, sm4_msg, 1000, sm4_aad, 100,
+          SM4_CT17, SM4_TAG17, 16 },
+        { SM4_CBC, SM4_STD_KEY, SM4_STD_IV, 16, SM4_STD_KEY, 16, NULL, 0,
+          SM4_STD_CT, NULL, 0 },
+        { SM4_GCM, SM4_STD_KEY, SM4_RFC_IV, 12, SM4_RFC_PT, 64, SM4_RFC_AAD,
+          20, SM4_RFC_CT, SM4_RFC_TAG, 16 },
+};
+
+/* expanded keys for a vector */
+struct sm4_keys {
+        DECLARE_ALIGNED(uint32_t enc[SM4_KEY_SCHED_SIZE / 4], 16);
+        DECLARE_ALIGNED(uint32_t dec[SM4_KEY_SCHED_SIZE / 4], 16);
+        DECLARE_ALIGNED(struct sm4_gcm_key_data gcm, 16);
+};
+
+/* state shared by the job callbacks of sm4_run_jobs() */
+struct sm4_many_ctx {
+        const struct sm4_keys *keys;
+        uint8_t *bufs;
+        uint8_t *tags;
+        int encrypt;
+};
+
+static void
+sm4_fill_job(struct JOB_AES_HMAC *job, const int n, void *arg)
+{
+        const struct sm4_many_ctx *ctx = arg;
+        const unsigned v = n % DIM(sm4_vectors);
+        const struct sm4_vector *vec = &sm4_vectors[v];
+
+        job->cipher_direction = ctx->encrypt ? ENCRYPT : DECRYPT;
+        job->chain_order = ctx->encrypt ? CIPHER_HASH : HASH_CIPHER;
+        job->cipher_mode = vec->cipher_mode;
+        job->aes_key_len_in_bytes = SM4_KEY_SIZE;
+        if (vec->cipher_mode == SM4_GCM) {
+                job->aes_enc_key_expanded = &ctx->keys[v].gcm;
+                job->aes_dec_key_expanded = &ctx->keys[v].gcm;
+                job->hash_alg = SM4_GMAC;
+                job->u.SM4_GCM.aad = vec->aad;
+                job->u.SM4_GCM.aad_len_in_bytes = vec->aad_len;
+                job->auth_tag_output = &ctx->tags[n * SM4_TEST_TAG_SIZE];
+                job->auth_tag_output_len_in_bytes = vec->tag_len;
+        } else {
+                job->aes_enc_key_expanded = ctx->keys[v].enc;
+                job->aes_dec_key_expanded = ctx->keys[v].dec;
+                job->hash_alg = NULL_HASH;
+        }
+        job->iv = vec->iv;
+        job->iv_len_in_bytes = vec->iv_len;
+        job->dst = &ctx->bufs[n * SM4_TEST_BUF_SIZE];
+        job->src = ctx->encrypt ? vec->msg : job->dst;
+        job->cipher_start_src_offset_in_bytes = 0;
+        job->msg_len_to_cipher_in_bytes = vec->msg_len;
+        job->hash_start_src_offset_in_bytes = 0;
+        job->msg_len_to_hash_in_bytes = vec->msg_len;
+}
+
+static int
+sm4_check_job(const struct JOB_AES_HMAC *job, const int n, void *arg)
+{
+        const struct sm4_many_ctx *ctx = arg;
+        const struct sm4_vector *vec = &sm4_vectors[n % DIM(sm4_vectors)];
+        const char *dir = ctx->encrypt ? "encrypt" : "decrypt";
+
+        if (!job_output_ok(n, job->dst, ctx->encrypt ? vec->ct : vec->msg,
+                           vec->msg_len)) {
+                printf("cipher_mode %d mismatched (%s)\n",
+                       (int) vec->cipher_mode, dir);
+                return 0;
+        }
+        /* nothing written past the output */
+        if (job->dst[vec->msg_len] != 0xff) {
+                printf("cipher_mode %d, job %d overwrite\n",
+                       (int) vec->cipher_mode, n);
+                return 0;
+        }
+        if (vec->tag == NULL)
+                return 1;
+        if (!job_output_ok(n, job->auth_tag_output, vec->tag, vec->tag_len)) {
+                printf("cipher_mode %d tag mismatched (%s)\n",
+                       (int) vec->cipher_mode, dir);
+                return 0;
+        }
+        if (job->auth_tag_output[vec->tag_len] != 0xff) {
+                printf("cipher_mode %d, job %d tag overwrite\n",
+                       (int) vec->cipher_mode, n);
+                return 0;
+        }
+        return 1;
+}
+
+/* submits num_jobs jobs using test vectors in turn and checks the output */
+static int
+sm4_run_jobs(struct MB_MGR *mb_mgr, const struct sm4_keys *keys,
+             uint8_t *bufs, uint8_t *tags, const int num_jobs,
+             const int encrypt)
+{
+        struct sm4_many_ctx ctx;
+
+        memset(tags, -1, num_jobs * SM4_TEST_TAG_SIZE);
+
+        ctx.keys = keys;
+        ctx.bufs = bufs;
+        ctx.tags = tags;
+        ctx.encrypt = encrypt;
+        return submit_many_jobs(mb_mgr, num_jobs, sm4_fill_job,
+                                sm4_check_job, &ctx);
+}
+
+/*
+ * Encrypts num_jobs messages out of place, so that CBC encrypt lanes
+ * process messages of different lengths, and decrypts them in place.
+ */
+static int
+test_sm4_many(struct MB_MGR *mb_mgr, const int num_jobs)
+{
+        const unsigned num_vecs = DIM(sm4_vectors);
+        struct sm4_keys *keys = malloc(num_vecs * sizeof(*keys));
+        uint8_t *bufs = malloc(num_jobs * SM4_TEST_BUF_SIZE);
+        uint8_t *tags = malloc(num_jobs * SM4_TEST_TAG_SIZE);
+        unsigned i;
+        int ret;
+
+        assert(keys != NULL && bufs != NULL && tags != NULL);
+        memset(bufs, -1, num_jobs * SM4_TEST_BUF_SIZE);
+
+        for (i = 0; i < num_vecs; i++) {
+                sm4_keyexp(sm4_vectors[i].key, keys[i].enc, keys[i].dec);
+                sm4_gcm_pre(sm4_vectors[i].key, &keys[i].gcm);
+        }
+
+        ret = sm4_run_jobs(mb_mgr, keys, bufs, tags, num_jobs, 1);
+        if (ret == 0)
+                ret = sm4_run_jobs(mb_mgr, keys, bufs, tags, num_jobs, 0);
+
+        free(keys);
+        free(bufs);
+        free(tags);
+        return ret;
+}
+
+/* sets up SM4_CBC or SM4_CNTR job, keys are already expanded */
+static void
+sm4_job(struct JOB_AES_HMAC *job, const JOB_CIPHER_MODE cipher_mode,
+        const JOB_CIPHER_DIRECTION dir, const struct sm4_keys *keys,
+        const uint8_t *iv, const uint8_t *src, uint8_t *dst,
+        const uint64_t len)
+{
+        memset(job, 0, sizeof(*job));
+        job->cipher_direction = dir;
+        job->chain_order = (dir == ENCRYPT) ? CIPHER_HASH : HASH_CIPHER;
+        job->cipher_mode = cipher_mode;
+        job->hash_alg = NULL_HASH;
+        job->aes_enc_key_expanded = keys->enc;
+        job->aes_dec_key_expanded = keys->dec;
+        job->aes_key_len_in_bytes = SM4_KEY_SIZE;
+        job->iv = iv;
+        job->iv_len_in_bytes = SM4_BLOCK_SIZE;
+        job->src = src;
+        job->dst = dst;
+        job->msg_len_to_cipher_in_bytes = len;
+}
+
+/*
+ * GB/T 32907-2016 example 2 as a single CBC job: with the plain text
+ * as IV, CBC encryption of zero blocks encrypts the previous block again.
+ * Decryption round key schedule is the reversed encryption one.
+ */
+static int
+test_sm4_std_1m(struct MB_MGR *mb_mgr)
+{
+        const uint64_t num_blocks = 1000000;
+        const uint64_t len = num_blocks * SM4_BLOCK_SIZE;
+        uint8_t *buf = malloc(len);
+        struct sm4_keys keys;
+        struct JOB_AES_HMAC tmpl;
+        const struct JOB_AES_HMAC *job;
+        unsigned i;
+        int ret = 1;
+
+        assert(buf != NULL);
+        sm4_keyexp(SM4_STD_KEY, keys.enc, keys.dec);
+        for (i = 0; i < DIM(keys.enc); i++)
+                if (keys.dec[i] != keys.enc[DIM(keys.enc) - 1 - i]) {
+                        printf("SM4 decryption round key %u mismatched\n", i);
+                        goto end;
+                }
+
+        memset(buf, 0, len);
+        sm4_job(&tmpl, SM4_CBC, ENCRYPT, &keys, SM4_STD_KEY, buf, buf, len);
+        job = submit_one_job(mb_mgr, &tmpl);
+        if (job->status != STS_COMPLETED ||
+            !job_output_ok(0, buf + len - SM4_BLOCK_SIZE, SM4_STD_CT_1M,
+                           SM4_BLOCK_SIZE))
+                goto end;
+        ret = 0;
+
+ end:
+        free(buf);
+        return ret;
+}
+
+/*
+ * 16 byte SM4-CTR IV is a 128-bit big endian counter: the increment
+ * carries over 32 and 64 bit boundaries. Keystream blocks are computed
+ * one by one with single block CBC and zero IV.
+ */
+static int
+test_sm4_ctr_carry(struct MB_MGR *mb_mgr)
+{
+        static const uint8_t zero_iv[SM4_BLOCK_SIZE];
+        const unsigned num_blocks = 4;
+        uint8_t iv[SM4_BLOCK_SIZE], cb[SM4_BLOCK_SIZE];
+        uint8_t out[4 * SM4_BLOCK_SIZE], ks[4 * SM4_BLOCK_SIZE];
+        struct sm4_keys keys;
+        struct JOB_AES_HMAC tmpl;
+        const struct JOB_AES_HMAC *job;
+        unsigned i, j;
+
+        sm4_keyexp(SM4_KEY, keys.enc, keys.dec);
+        memcpy(iv, SM4_IV, 7);
+        memset(&iv[7], 0xff, sizeof(iv) - 7);
+        iv[SM4_BLOCK_SIZE - 1] = 0xfe;
+
+        memcpy(cb, iv, sizeof(cb));
+        for (i = 0; i < num_blocks; i++) {
+                sm4_job(&tmpl, SM4_CBC, ENCRYPT, &keys, zero_iv, cb,
+                        &ks[i * SM4_BLOCK_SIZE], SM4_BLOCK_SIZE);
+                job = submit_one_job(mb_mgr, &tmpl);
+                if (job->status != STS_COMPLETED)
+                        return 1;
+                for (j = SM4_BLOCK_SIZE; j > 0; j--)
+                        if (++cb[j - 1] != 0)
+                                break;
+        }
+        for (i = 0; i < sizeof(ks); i++)
+                ks[i] ^= sm4_msg[i];
+
+        sm4_job(&tmpl, SM4_CNTR, ENCRYPT, &keys, iv, sm4_msg, out,
+                sizeof(out));
+        job = submit_one_job(mb_mgr, &tmpl);
+        if (job->status != STS_COMPLETED ||
+            !job_output_ok(0, out, ks, sizeof(out))) {
+                printf("SM4-CTR counter carry failed\n");
+                return 1;
+        }
+        return 0;
+}
+
+/*
+ * SM4-GCM tag authenticates the AAD and a truncated tag is a prefix
+ * of the full one (RFC 8998 example).
+ */
+static int
+test_sm4_gcm_tag(struct MB_MGR *mb_mgr)
+{
+        uint8_t aad[sizeof(SM4_RFC_AAD)];
+        uint8_t out[sizeof(SM4_RFC_PT)];
+        uint8_t tag[SM4_BLOCK_SIZE];
+        struct sm4_keys keys;
+        struct JOB_AES_HMAC tmpl;
+        const struct JOB_AES_HMAC *job;
+        const uint64_t tag_lens[] = { 4, 8, 12 };
+        unsigned i;
+
+        sm4_gcm_pre(SM4_STD_KEY, &keys.gcm);
+        memcpy(aad, SM4_RFC_AAD, sizeof(aad));
+
+        for (i = 0; i <= DIM(tag_lens); i++) {
+                memset(&tmpl, 0, sizeof(tmpl));
+                tmpl.cipher_direction = ENCRYPT;
+                tmpl.chain_order = CIPHER_HASH;
+                tmpl.cipher_mode = SM4_GCM;
+                tmpl.hash_alg = SM4_GMAC;
+                tmpl.aes_enc_key_expanded = &keys.gcm;
+                tmpl.aes_dec_key_expanded = &keys.gcm;
+                tmpl.aes_key_len_in_bytes = SM4_KEY_SIZE;
+                tmpl.iv = SM4_RFC_IV;
+                tmpl.iv_len_in_bytes = sizeof(SM4_RFC_IV);
+                tmpl.src = SM4_RFC_PT;
+                tmpl.dst = out;
+                tmpl.msg_len_to_cipher_in_bytes = sizeof(SM4_RFC_PT);
+                tmpl.msg_len_to_hash_in_bytes = sizeof(SM4_RFC_PT);
+                tmpl.u.SM4_GCM.aad = aad;
+                tmpl.u.SM4_GCM.aad_len_in_bytes = sizeof(aad);
+                tmpl.auth_tag_output = tag;
+                tmpl.auth_tag_output_len_in_bytes = sizeof(tag);
+
+                /* last round: flip the last AAD byte */
+                if (i < DIM(tag_lens))
+                        tmpl.auth_tag_output_len_in_bytes = tag_lens[i];
+                else
+                        aad[sizeof(aad) - 1] ^= 1;
+
+                memset(tag, 0, sizeof(tag));
+                job = submit_one_job(mb_mgr, &tmpl);
+                if (job->status != STS_COMPLETED ||
+                    !job_output_ok((int) i, out, SM4_RFC_CT, sizeof(out)))
+                        return 1;
+                if (i < DIM(tag_lens) &&
+                    !job_output_ok((int) i, tag, SM4_RFC_TAG, tag_lens[i]))
+                        return 1;
+                if (i == DIM(tag_lens) &&
+                    !memcmp(tag, SM4_RFC_TAG, sizeof(tag))) {
+                        printf("SM4-GCM: AAD not authenticated\n");
+                        return 1;
+                }
+        }
+        return 0;
+}
+
+/* SM4 jobs with invalid length, IV length, key length or hash */
+static int
+test_sm4_invalid(struct MB_MGR *mb_mgr)
+{
+        struct sm4_keys keys;
+        struct JOB_AES_HMAC tmpl[6];
+        uint8_t out[2 * SM4_BLOCK_SIZE];
+        unsigned i;
+
+        sm4_keyexp(SM4_KEY, keys.enc, keys.dec);
+        /* CBC needs whole blocks */
+        sm4_job(&tmpl[0], SM4_CBC, ENCRYPT, &keys, SM4_IV, sm4_msg, out, 17);
+        sm4_job(&tmpl[1], SM4_CBC, DECRYPT, &keys, SM4_IV, sm4_msg, out, 0);
+        sm4_job(&tmpl[2], SM4_CBC, ENCRYPT, &keys, SM4_IV, sm4_msg, out, 16);
+        tmpl[2].iv_len_in_bytes = 12;
+        sm4_job(&tmpl[3], SM4_CNTR, ENCRYPT, &keys, SM4_IV, sm4_msg, out, 16);
+        tmpl[3].aes_key_len_in_bytes = 32;
+        /* SM4-GCM takes 12 byte IV and needs SM4_GMAC */
+        sm4_job(&tmpl[4], SM4_GCM, ENCRYPT, &keys, SM4_IV, sm4_msg, out, 16);
+        tmpl[4].hash_alg = SM4_GMAC;
+        sm4_job(&tmpl[5], SM4_GCM, ENCRYPT, &keys, SM4_IV, sm4_msg, out, 16);
+        tmpl[5].iv_len_in_bytes = 12;
+
+        for (i = 0; i < DIM(tmpl); i++) {
+                const struct JOB_AES_HMAC *job = submit_one_job(mb_mgr,
+                                                                &tmpl[i]);
+
+                if (job->status != STS_INVALID_ARGS) {
+                        printf("SM4 invalid job %u: status:%d\n",
+                               i, job->status);
+                        return 1;
+                }
+        }
+        return 0;
+}
+
+int
+sm4_test(const enum arch_type arch, struct MB_MGR *mb_mgr)
+{
+        const int num_jobs_tab[] = {
+                1, 2, 3, 4, 5, 7, 8, 9, 16, 17, 27, 54, 100
+        };
+        unsigned i;
+        int errors = 0;
+
+        (void) arch; /* unused */
+
+        for (i = 0; i < sizeof(sm4_msg); i++)
+                sm4_msg[i] = (uint8_t) (i * 7 + 1);
+        for (i = 0; i < sizeof(sm4_aad); i++)
+                sm4_aad[i] = (uint8_t) (i * 5 + 3);
+
+        printf("SM4 test vectors:\n");
+        for (i = 0; i < DIM(num_jobs_tab); i++)
+                errors += test_sm4_many(mb_mgr, num_jobs_tab[i]);
+        errors += test_sm4_std_1m(mb_mgr);
+        errors += test_sm4_ctr_carry(mb_mgr);
+        errors += test_sm4_gcm_tag(mb_mgr);
+        errors += test_sm4_invalid(mb_mgr);
+
+	if (0 == errors)
+		printf("...Pass\n");
+	else
+		printf("...Fail\n");
+
+	return errors;
+}
@@ -0,0 +1,555 @@
+/*****************************************************************************
+ Copyright (c) 2019, Intel Corporation
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+     * Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+     * Neither the name of Intel Corporation nor the names of its contributors
+       may be used to endorse or promote products derived from this software
+       without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include <intel-ipsec-mb.h>
+
+#include "gcm_ctr_vectors_test.h"
+#include "utils.h"
+
+int snow3g_test(const enum arch_type arch, struct MB_MGR *mb_mgr);
+
+struct snow3g_uea2_vector {
+        const uint8_t *K;       /* confidentiality key */
+        const uint8_t *IV;      /* initialization vector */
+        const uint8_t *P;       /* plain text */
+        const uint8_t *C;       /* cipher text */
+        uint64_t len;           /* message length in bits */
+        uint64_t offset;        /* message offset in bits */
+};
+
+struct snow3g_uia2_vector {
+        const uint8_t *K;       /* integrity key */
+        const uint8_t *IV;      /* initialization vector */
+        const uint8_t *M;       /* message */
+        const uint8_t *MAC;     /* expected MAC */
+        uint64_t len;           /* message length in bits */
+};
+
+/*
+ * UEA2 test set 1 (ETSI/SAGE specification of UEA2 & UIA2,
+ * Document 3: Implementors' Test Data)
+ * COUNT = 0x398a59b4, BEARER = 0x15, DIRECTION = 1, 253 bits
+ * Last 3 bits of the cipher text are the unmodified plain text bits.
+ */
+static const uint8_t SNOW3G_UEA2_K1[] = {
+        0xd3, 0xc5, 0xd5, 0x92, 0x32, 0x7f, 0xb1, 0x1c,
+        0x40, 0x35, 0xc6, 0x68, 0x0a, 0xf8, 0xc6, 0xd1
+};
+static const uint8_t SNOW3G_UEA2_IV1[] = {
+        0x39, 0x8a, 0x59, 0xb4, 0xac, 0x00, 0x00, 0x00,
+        0x39, 0x8a, 0x59, 0xb4, 0xac, 0x00, 0x00, 0x00
+};
+static const uint8_t SNOW3G_UEA2_P1[] = {
+        0x98, 0x1b, 0xa6, 0x82, 0x4c, 0x1b, 0xfb, 0x1a,
+        0xb4, 0x85, 0x47, 0x20, 0x29, 0xb7, 0x1d, 0x80,
+        0x8c, 0xe3, 0x3e, 0x2c, 0xc3, 0xc0, 0xb5, 0xfc,
+        0x1f, 0x3d, 0xe8, 0xa6, 0xdc, 0x66, 0xb1, 0xf0
+};
+static const uint8_t SNOW3G_UEA2_C1[] = {
+        0x5d, 0x5b, 0xfe, 0x75, 0xeb, 0x04, 0xf6, 0x8c,
+        0xe0, 0xa1, 0x23, 0x77, 0xea, 0x00, 0xb3, 0x7d,
+        0x47, 0xc6, 0xa0, 0xba, 0x06, 0x30, 0x91, 0x55,
+        0x08, 0x6a, 0x85, 0x9c, 0x43, 0x41, 0xb3, 0x78
+};
+
+/* UEA2 test set 1 message starting at bit 3 (prefixed with 101b) */
+static const uint8_t SNOW3G_UEA2_P1_OFS3[] = {
+        0xb3, 0x03, 0x74, 0xd0, 0x49, 0x83, 0x7f, 0x63,
+        0x56, 0x90, 0xa8, 0xe4, 0x05, 0x36, 0xe3, 0xb0,
+        0x11, 0x9c, 0x67, 0xc5, 0x98, 0x78, 0x16, 0xbf,
+        0x83, 0xe7, 0xbd, 0x14, 0xdb, 0x8c, 0xd6, 0x3e
+};
+static const uint8_t SNOW3G_UEA2_C1_OFS3[] = {
+        0xab, 0xab, 0x7f, 0xce, 0xbd, 0x60, 0x9e, 0xd1,
+        0x9c, 0x14, 0x24, 0x6e, 0xfd, 0x40, 0x16, 0x6f,
+        0xa8, 0xf8, 0xd4, 0x17, 0x40, 0xc6, 0x12, 0x2a,
+        0xa1, 0x0d, 0x50, 0xb3, 0x88, 0x68, 0x36, 0x6f
+};
+
+/*
+ * 1043 bit message (crosses the 64 byte keystream chunk boundary twice)
+ * COUNT = 0x87654321, BEARER = 0xb, DIRECTION = 0
+ */
+static const uint8_t SNOW3G_UEA2_K2[] = {
+        0x07, 0x1e, 0x35, 0x4c, 0x63, 0x7a, 0x91, 0xa8,
+        0xbf, 0xd6, 0xed, 0x04, 0x1b, 0x32, 0x49, 0x60
+};
+static const uint8_t SNOW3G_UEA2_IV2[] = {
+        0x87, 0x65, 0x43, 0x21, 0x58, 0x00, 0x00, 0x00,
+        0x87, 0x65, 0x43, 0x21, 0x58, 0x00, 0x00, 0x00
+};
+static const uint8_t SNOW3G_UEA2_P2[] = {
+        0x02, 0x0d, 0x18, 0x23, 0x2e, 0x39, 0x44, 0x4f,
+        0x5a, 0x65, 0x70, 0x7b, 0x86, 0x91, 0x9c, 0xa7,
+        0xb2, 0xbd, 0xc8, 0xd3, 0xde, 0xe9, 0xf4, 0xff,
+        0x0a, 0x15, 0x20, 0x2b, 0x36, 0x41, 0x4c, 0x57,
+        0x62, 0x6d, 0x78, 0x83, 0x8e, 0x99, 0xa4, 0xaf,
+        0xba, 0xc5, 0xd0, 0xdb, 0xe6, 0xf1, 0xfc, 0x07,
+        0x12, 0x1d, 0x28, 0x33, 0x3e, 0x49, 0x54, 0x5f,
+        0x6a, 0x75, 0x80, 0x8b, 0x96, 0xa1, 0xac, 0xb7,
+        0xc2, 0xcd, 0xd8, 0xe3, 0xee, 0xf9, 0x04, 0x0f,
+        0x1a, 0x25, 0x30, 0x3b, 0x46, 0x51, 0x5c, 0x67,
+        0x72, 0x7d, 0x88, 0x93, 0x9e, 0xa9, 0xb4, 0xbf,
+        0xca, 0xd5, 0xe0, 0xeb, 0xf6, 0x01, 0x0c, 0x17,
+        0x22, 0x2d, 0x38, 0x43, 0x4e, 0x59, 0x64, 0x6f,
+        0x7a, 0x85, 0x90, 0x9b, 0xa6, 0xb1, 0xbc, 0xc7,
+        0xd2, 0xdd, 0xe8, 0xf3, 0xfe, 0x09, 0x14, 0x1f,
+        0x2a, 0x35, 0x40, 0x4b, 0x56, 0x61, 0x6c, 0x77,
+        0x82, 0x8d, 0x98
+};
+static const uint8_t SNOW3G_UEA2_C2[] = {
+        0x2b, 0x5e, 0x67, 0xc1, 0xd3, 0x41, 0x1e, 0x2f,
+        0x19, 0xf3, 0xae, 0x99, 0x1d, 0xc4, 0x67, 0x17,
+        0x59, 0xc7, 0xcf, 0x52, 0x49, 0xc9, 0xf0, 0xe3,
+        0xb3, 0xb9, 0xf8, 0x22, 0x39, 0x5a, 0x03, 0x60,
+        0x04, 0x42, 0x3f, 0x12, 0x5c, 0xe4, 0xb0, 0xad,
+        0xdd, 0xf9, 0x17, 0x09, 0x0b, 0x1a, 0xe5, 0x2f,
+        0xb0, 0x48, 0x54, 0x1e, 0xdb, 0xfc, 0xf1, 0x75,
+        0x17, 0xe9, 0x8d, 0xc8, 0xd6, 0x4c, 0xc8, 0xbb,
+        0xb5, 0x90, 0x47, 0xa8, 0x4a, 0x66, 0xbe, 0x06,
+        0xc6, 0xd6, 0x24, 0xdc, 0x51, 0xcd, 0x10, 0xe9,
+        0x22, 0x8a, 0x02, 0x15, 0xeb, 0x3d, 0x2c, 0x65,
+        0xdf, 0xfd, 0xb9, 0x18, 0xfe, 0x20, 0x0e, 0x16,
+        0x76, 0xf6, 0xee, 0xd5, 0x24, 0x04, 0x92, 0x8f,
+        0x0c, 0x75, 0x5b, 0x9a, 0xc8, 0xbb, 0x28, 0x5a,
+        0x00, 0x7d, 0xce, 0x14, 0x50, 0x42, 0x4c, 0xd6,
+        0xc2, 0x91, 0x56, 0x8f, 0x9c, 0xb3, 0x18, 0xe6,
+        0x09, 0x37, 0x78
+};
+
+static const struct snow3g_uea2_vector snow3g_uea2_vectors[] = {
+        { SNOW3G_UEA2_K1, SNOW3G_UEA2_IV1, SNOW3G_UEA2_P1, SNOW3G_UEA2_C1,
+          253, 0 },
+        { SNOW3G_UEA2_K2, SNOW3G_UEA2_IV2, SNOW3G_UEA2_P2, SNOW3G_UEA2_C2,
+          1043, 0 },
+        { SNOW3G_UEA2_K1, SNOW3G_UEA2_IV1, SNOW3G_UEA2_P1_OFS3,
+          SNOW3G_UEA2_C1_OFS3, 253, 3 },
+};
+
+/* number of bytes holding the message (including its offset) */
+#define SNOW3G_UEA2_SIZE(_vec) (((_vec)->offset + (_vec)->len + 7) / 8)
+
+/*
+ * UIA2 test set 1 (ETSI/SAGE specification of UEA2 & UIA2,
+ * Document 3: Implementors' Test Data)
+ * COUNT = 0x14793e41, FRESH = 0x0397e8fd, DIRECTION = 1, 384 bits
+ */
+static const uint8_t SNOW3G_UIA2_K1[] = {
+        0xc7, 0x36, 0xc6, 0xaa, 0xb2, 0x2b, 0xff, 0xf9,
+        0x1e, 0x26, 0x98, 0xd2, 0xe2, 0x2a, 0xd5, 0x7e
+};
+static const uint8_t SNOW3G_UIA2_IV1[] = {
+        0x14, 0x79, 0x3e, 0x41, 0x03, 0x97, 0xe8, 0xfd,
+        0x94, 0x79, 0x3e, 0x41, 0x03, 0x97, 0x68, 0xfd
+};
+static const uint8_t SNOW3G_UIA2_M1[] = {
+        0xd0, 0xa7, 0xd4, 0x63, 0xdf, 0x9f, 0xb2, 0xb2,
+        0x78, 0x83, 0x3f, 0xa0, 0x2e, 0x23, 0x5a, 0xa1,
+        0x72, 0xbd, 0x97, 0x0c, 0x14, 0x73, 0xe1, 0x29,
+        0x07, 0xfb, 0x64, 0x8b, 0x65, 0x99, 0xaa, 0xa0,
+        0xb2, 0x4a, 0x03, 0x86, 0x65, 0x42, 0x2b, 0x20,
+        0xa4, 0x99, 0x27, 0x6a, 0x50, 0x42, 0x70, 0x09
+};
+static const uint8_t SNOW3G_UIA2_MAC1[] = {
+        0x38, 0xb5, 0x54, 0xc0
+};
+
+/*
+ * 189 bit message
+ * COUNT = 0x38a6f056, FRESH = 0x05d2ec49, DIRECTION = 1
+ */
+static const uint8_t SNOW3G_UIA2_K2[] = {
+        0x09, 0x28, 0x47, 0x66, 0x85, 0xa4, 0xc3, 0xe2,
+        0x01, 0x20, 0x3f, 0x5e, 0x7d, 0x9c, 0xbb, 0xda
+};
+static const uint8_t SNOW3G_UIA2_IV2[] = {
+        0x38, 0xa6, 0xf0, 0x56, 0x05, 0xd2, 0xec, 0x49,
+        0xb8, 0xa6, 0xf0, 0x56, 0x05, 0xd2, 0x6c, 0x49
+};
+static const uint8_t SNOW3G_UIA2_M2[] = {
+        0x03, 0x16, 0x29, 0x3c, 0x4f, 0x62, 0x75, 0x88,
+        0x9b, 0xae, 0xc1, 0xd4, 0xe7, 0xfa, 0x0d, 0x20,
+        0x33, 0x46, 0x59, 0x6c, 0x7f, 0x92, 0xa5, 0xb8
+};
+static const uint8_t SNOW3G_UIA2_MAC2[] = {
+        0x11, 0xc9, 0x91, 0x54
+};
+
+static const struct snow3g_uia2_vector snow3g_uia2_vectors[] = {
+        { SNOW3G_UIA2_K1, SNOW3G_UIA2_IV1, SNOW3G_UIA2_M1, SNOW3G_UIA2_MAC1,
+          384 },
+        { SNOW3G_UIA2_K2, SNOW3G_UIA2_IV2, SNOW3G_UIA2_M2, SNOW3G_UIA2_MAC2,
+          189 },
+};
+
+/* state shared by the job callbacks of test_snow3g_uea2_many() */
+struct snow3g_uea2_ctx {
+        JOB_CIPHER_DIRECTION dir;
+        uint8_t **srcs;
+        uint8_t **dsts;
+};
+
+static void
+snow3g_uea2_fill_job(struct JOB_AES_HMAC *job, const int n, void *arg)
+{
+        const struct snow3g_uea2_ctx *ctx = arg;
+        const struct snow3g_uea2_vector *vec =
+                &snow3g_uea2_vectors[n % DIM(snow3g_uea2_vectors)];
+
+        job->cipher_direction = ctx->dir;
+        job->chain_order = (ctx->dir == ENCRYPT) ? CIPHER_HASH : HASH_CIPHER;
+        job->cipher_mode = SNOW3G_UEA2_BITLEN;
+        job->hash_alg = NULL_HASH;
+        job->aes_enc_key_expanded = vec->K;
+        job->aes_dec_key_expanded = vec->K;
+        job->aes_key_len_in_bytes = 16;
+        job->iv = vec->IV;
+        job->iv_len_in_bytes = 16;
+        job->src = ctx->srcs[n];
+        job->dst = ctx->dsts[n];
+        job->cipher_start_src_offset_in_bits = vec->offset;
+        job->msg_len_to_cipher_in_bits = vec->len;
+}
+
+static int
+snow3g_uea2_check_job(const struct JOB_AES_HMAC *job, const int n, void *arg)
+{
+        const struct snow3g_uea2_ctx *ctx = arg;
+        const struct snow3g_uea2_vector *vec =
+                &snow3g_uea2_vectors[n % DIM(snow3g_uea2_vectors)];
+
+        return job_output_ok(n, job->dst,
+                             (ctx->dir == ENCRYPT) ? vec->C : vec->P,
+                             SNOW3G_UEA2_SIZE(vec));
+}
+
+/*
+ * Submits num_jobs jobs using test vectors in turn,
+ * so that lanes process messages of different lengths.
+ */
+static int
+test_snow3g_uea2_many(struct MB_MGR *mb_mgr, const JOB_CIPHER_DIRECTION dir,
+                      const int in_place, const int num_jobs)
+{
+        struct snow3g_uea2_ctx ctx;
+        int i, ret;
+
+        ctx.dir = dir;
+        ctx.srcs = malloc(num_jobs * sizeof(void *));
+        ctx.dsts = malloc(num_jobs * sizeof(void *));
+        assert(ctx.srcs != NULL && ctx.dsts != NULL);
+
+        for (i = 0; i < num_jobs; i++) {
+                const struct snow3g_uea2_vector *vec =
+                        &snow3g_uea2_vectors[i % DIM(snow3g_uea2_vectors)];
+                const size_t size = SNOW3G_UEA2_SIZE(vec);
+
+                ctx.srcs[i] = malloc(size);
+                assert(ctx.srcs[i] != NULL);
+                memcpy(ctx.srcs[i], (dir == ENCRYPT) ? vec->P : vec->C, size);
+                if (in_place) {
+                        ctx.dsts[i] = ctx.srcs[i];
+                } else {
+                        /* bits around the message are not to be modified */
+                        ctx.dsts[i] = malloc(size);
+                        assert(ctx.dsts[i] != NULL);
+                        memcpy(ctx.dsts[i], ctx.srcs[i], size);
+                }
+        }
+
+        ret = submit_many_jobs(mb_mgr, num_jobs, snow3g_uea2_fill_job,
+                               snow3g_uea2_check_job, &ctx);
+
+        for (i = 0; i < num_jobs; i++) {
+                if (!in_place)
+                        free(ctx.dsts[i]);
+                free(ctx.srcs[i]);
+        }
+        free(ctx.srcs);
+        free(ctx.dsts);
+        return ret;
+}
+
+static void
+snow3g_uia2_fill_job(struct JOB_AES_HMAC *job, const int n, void *arg)
+{
+        uint8_t *tags = arg;
+        const struct snow3g_uia2_vector *vec =
+                &snow3g_uia2_vectors[n % DIM(snow3g_uia2_vectors)];
+
+        job->cipher_direction = ENCRYPT;
+        job->chain_order = HASH_CIPHER;
+        job->cipher_mode = NULL_CIPHER;
+        job->hash_alg = SNOW3G_UIA2_BITLEN;
+        job->u.SNOW3G_UIA2._key = vec->K;
+        job->u.SNOW3G_UIA2._iv = vec->IV;
+        job->src = vec->M;
+        job->hash_start_src_offset_in_bytes = 0;
+        job->msg_len_to_hash_in_bits = vec->len;
+        job->auth_tag_output = &tags[n * 4];
+        job->auth_tag_output_len_in_bytes = 4;
+}
+
+static int
+snow3g_uia2_check_job(const struct JOB_AES_HMAC *job, const int n, void *arg)
+{
+        const struct snow3g_uia2_vector *vec =
+                &snow3g_uia2_vectors[n % DIM(snow3g_uia2_vectors)];
+
+        (void) arg;
+        return job_output_ok(n, job->auth_tag_output, vec->MAC, 4);
+}
+
+static int
+test_snow3g_uia2_many(struct MB_MGR *mb_mgr, const int num_jobs)
+{
+        uint8_t *tags = malloc(num_jobs * 4);
+        int ret;
+
+        assert(tags != NULL);
+        memset(tags, -1, num_jobs * 4);
+
+        ret = submit_many_jobs(mb_mgr, num_jobs, snow3g_uia2_fill_job,
+                               snow3g_uia2_check_job, tags);
+
+        free(tags);
+        return ret;
+}
+
+/* sets up in-place UEA2 job with key and IV of test set vec */
+static void
+snow3g_uea2_job(struct JOB_AES_HMAC *job,
+                const struct snow3g_uea2_vector *vec, uint8_t *buf,
+                const uint64_t offset, const uint64_t len)
+{
+        memset(job, 0, sizeof(*job));
+        job->cipher_direction = ENCRYPT;
+        job->chain_order = CIPHER_HASH;
+        job->cipher_mode = SNOW3G_UEA2_BITLEN;
+        job->hash_alg = NULL_HASH;
+        job->aes_enc_key_expanded = vec->K;
+        job->aes_dec_key_expanded = vec->K;
+        job->aes_key_len_in_bytes = SNOW3G_KEY_LEN_IN_BYTES;
+        job->iv = vec->IV;
+        job->iv_len_in_bytes = SNOW3G_IV_LEN_IN_BYTES;
+        job->src = buf;
+        /* the first ciphered bit is written at the bit offset of dst[0] */
+        job->dst = buf + offset / 8;
+        job->cipher_start_src_offset_in_bits = offset;
+        job->msg_len_to_cipher_in_bits = len;
+}
+
+/* sets up UIA2 job with key and IV of test set vec */
+static void
+snow3g_uia2_job(struct JOB_AES_HMAC *job,
+                const struct snow3g_uia2_vector *vec, const uint8_t *msg,
+                const uint64_t len_in_bits, uint8_t *tag)
+{
+        memset(job, 0, sizeof(*job));
+        job->cipher_direction = ENCRYPT;
+        job->chain_order = HASH_CIPHER;
+        job->cipher_mode = NULL_CIPHER;
+        job->hash_alg = SNOW3G_UIA2_BITLEN;
+        job->u.SNOW3G_UIA2._key = vec->K;
+        job->u.SNOW3G_UIA2._iv = vec->IV;
+        job->src = msg;
+        job->msg_len_to_hash_in_bits = len_in_bits;
+        job->auth_tag_output = tag;
+        job->auth_tag_output_len_in_bytes = SNOW3G_DIGEST_LEN;
+}
+
+/* copies num_bits of src into dst starting at bit dst_ofs (MSB first) */
+static void
+snow3g_copy_bits(uint8_t *dst, const uint64_t dst_ofs, const uint8_t *src,
+                 const uint64_t num_bits)
+{
+        uint64_t i;
+
+        for (i = 0; i < num_bits; i++) {
+                const uint64_t d = dst_ofs + i;
+                const uint8_t bit = (src[i / 8] >> (7 - (i % 8))) & 1;
+
+                dst[d / 8] &= ~(0x80 >> (d % 8));
+                dst[d / 8] |= bit << (7 - (d % 8));
+        }
+}
+
+/*
+ * UEA2 works on bits: any prefix of test set 2 placed at any bit offset
+ * encrypts to the same prefix of its cipher text at that offset and
+ * the bits around the message are left untouched.
+ */
+static int
+test_snow3g_uea2_bits(struct MB_MGR *mb_mgr)
+{
+        static const uint64_t offsets[] = { 0, 1, 5, 7, 8, 9, 13, 64, 71 };
+        static const uint64_t lens[] = {
+                1, 7, 8, 9, 31, 32, 33, 511, 512, 513, 1042, 1043
+        };
+        const struct snow3g_uea2_vector *vec = &snow3g_uea2_vectors[1];
+        uint8_t buf[sizeof(SNOW3G_UEA2_P2) + 16];
+        uint8_t expected[sizeof(buf)];
+        struct JOB_AES_HMAC tmpl;
+        unsigned i, j;
+
+        for (i = 0; i < DIM(offsets); i++)
+                for (j = 0; j < DIM(lens); j++) {
+                        const struct JOB_AES_HMAC *job;
+
+                        memset(buf, 0x5a, sizeof(buf));
+                        memset(expected, 0x5a, sizeof(expected));
+                        snow3g_copy_bits(buf, offsets[i], vec->P, lens[j]);
+                        snow3g_copy_bits(expected, offsets[i], vec->C,
+                                         lens[j]);
+
+                        snow3g_uea2_job(&tmpl, vec, buf, offsets[i], lens[j]);
+                        job = submit_one_job(mb_mgr, &tmpl);
+                        if (job->status != STS_COMPLETED ||
+                            !job_output_ok((int) j, buf, expected,
+                                           sizeof(buf))) {
+                                printf("UEA2 offset %u, length %u failed\n",
+                                       (unsigned) offsets[i],
+                                       (unsigned) lens[j]);
+                                return 1;
+                        }
+                }
+        return 0;
+}
+
+/*
+ * UIA2 takes the message length in bits: bits past the length are not
+ * part of the message (test set 2 ends mid-byte) while the last bit
+ * of the message is.
+ */
+static int
+test_snow3g_uia2_bitlen(struct MB_MGR *mb_mgr)
+{
+        const struct snow3g_uia2_vector *vec = &snow3g_uia2_vectors[1];
+        const uint64_t last = vec->len - 1;
+        uint8_t msg[sizeof(SNOW3G_UIA2_M2)];
+        uint8_t tag[SNOW3G_DIGEST_LEN];
+        struct JOB_AES_HMAC tmpl;
+        const struct JOB_AES_HMAC *job;
+
+        memcpy(msg, vec->M, sizeof(msg));
+        msg[vec->len / 8] |= 0xff >> (vec->len % 8);
+        snow3g_uia2_job(&tmpl, vec, msg, vec->len, tag);
+        job = submit_one_job(mb_mgr, &tmpl);
+        if (job->status != STS_COMPLETED ||
+            !job_output_ok(0, tag, vec->MAC, sizeof(tag))) {
+                printf("UIA2: trailing bits not ignored\n");
+                return 1;
+        }
+
+        memcpy(msg, vec->M, sizeof(msg));
+        msg[last / 8] ^= 0x80 >> (last % 8);
+        snow3g_uia2_job(&tmpl, vec, msg, vec->len, tag);
+        job = submit_one_job(mb_mgr, &tmpl);
+        if (job->status != STS_COMPLETED ||
+            !memcmp(tag, vec->MAC, sizeof(tag))) {
+                printf("UIA2: last bit not authenticated\n");
+                return 1;
+        }
+        return 0;
+}
+
+/* jobs outside of UEA2/UIA2 key, IV, length and tag limits */
+static int
+test_snow3g_invalid(struct MB_MGR *mb_mgr)
+{
+        const struct snow3g_uea2_vector *uea2 = &snow3g_uea2_vectors[0];
+        const struct snow3g_uia2_vector *uia2 = &snow3g_uia2_vectors[0];
+        struct JOB_AES_HMAC tmpl[7];
+        uint8_t buf[sizeof(SNOW3G_UEA2_P1)];
+        uint8_t tag[8];
+        unsigned i;
+
+        memcpy(buf, uea2->P, sizeof(buf));
+        snow3g_uea2_job(&tmpl[0], uea2, buf, 0, uea2->len);
+        tmpl[0].aes_key_len_in_bytes = 32;
+        snow3g_uea2_job(&tmpl[1], uea2, buf, 0, uea2->len);
+        tmpl[1].iv_len_in_bytes = 8;
+        snow3g_uea2_job(&tmpl[2], uea2, buf, 0, 0);
+        snow3g_uea2_job(&tmpl[3], uea2, buf, 0, uea2->len);
+        tmpl[3].aes_enc_key_expanded = NULL;
+        snow3g_uia2_job(&tmpl[4], uia2, uia2->M, 0, tag);
+        snow3g_uia2_job(&tmpl[5], uia2, uia2->M, uia2->len, tag);
+        tmpl[5].auth_tag_output_len_in_bytes = 8;
+        snow3g_uia2_job(&tmpl[6], uia2, uia2->M, uia2->len, tag);
+        tmpl[6].u.SNOW3G_UIA2._key = NULL;
+
+        for (i = 0; i < DIM(tmpl); i++) {
+                const struct JOB_AES_HMAC *job = submit_one_job(mb_mgr,
+                                                                &tmpl[i]);
+
+                if (job->status != STS_INVALID_ARGS) {
+                        printf("SNOW3G invalid job %u: status:%d\n",
+                               i, job->status);
+                        return 1;
+                }
+        }
+        return 0;
+}
+
+int
+snow3g_test(const enum arch_type arch, struct MB_MGR *mb_mgr)
+{
+        const int num_jobs_tab[] = {
+                1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 33
+        };
+        unsigned i;
+        int errors = 0;
+
+        (void) arch; /* unused */
+
+        printf("SNOW3G test vectors:\n");
+        for (i = 0; i < DIM(num_jobs_tab); i++) {
+                const int n = num_jobs_tab[i];
+
+                errors += test_snow3g_uea2_many(mb_mgr, ENCRYPT, 1, n);
+                errors += test_snow3g_uea2_many(mb_mgr, ENCRYPT, 0, n);
+                errors += test_snow3g_uea2_many(mb_mgr, DECRYPT, 1, n);
+                errors += test_snow3g_uea2_many(mb_mgr, DECRYPT, 0, n);
+                errors += test_snow3g_uia2_many(mb_mgr, n);
+        }
+        errors += test_snow3g_uea2_bits(mb_mgr);
+        errors += test_snow3g_uia2_bitlen(mb_mgr);
+        errors += test_snow3g_invalid(mb_mgr);
+
+	if (0 == errors)
+		printf("...Pass\n");
+	else
+		printf("...Fail\n");
+
+	return errors;
+}
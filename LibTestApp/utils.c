@@ -29,6 +29,9 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <assert.h>
+
+#include <intel-ipsec-mb.h>
 
 #include "utils.h"
 
@@ -68,3 +71,106 @@ hexdump(FILE *fp,
                 fprintf(fp, "%s\n", line);
         }
 }
+
+/* compares output of job number n against the expected one */
+int
+job_output_ok(const int n, const void *out, const void *expected,
+              const size_t len)
+{
+        if (memcmp(out, expected, len)) {
+                printf("job %d mismatched\n", n);
+                hexdump(stderr, "Received", out, len);
+                hexdump(stderr, "Expected", expected, len);
+                return 0;
+        }
+        return 1;
+}
+
+/* checks status of a completed job, then its output with check_job() */
+static int
+completed_job_ok(const struct JOB_AES_HMAC *job, check_job_t check_job,
+                 void *arg)
+{
+        const int n = (const int)((uint64_t)job->user_data2);
+
+        if (job->status != STS_COMPLETED) {
+                printf("%d error status:%d, job %d\n",
+                       __LINE__, job->status, n);
+                return 0;
+        }
+        return check_job(job, n, arg);
+}
+
+/*
+ * Submits num_jobs jobs set up by fill_job() and checks every completed
+ * job with check_job(). Job number is carried in user_data2.
+ * Returns 0 on success and -1 on failure.
+ */
+int
+submit_many_jobs(struct MB_MGR *mb_mgr, const int num_jobs,
+                 fill_job_t fill_job, check_job_t check_job, void *arg)
+{
+        struct JOB_AES_HMAC *job;
+        int i, jobs_rx = 0, ret = -1;
+
+        /* flush the scheduler */
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                ;
+
+        for (i = 0; i < num_jobs; i++) {
+                job = IMB_GET_NEXT_JOB(mb_mgr);
+                fill_job(job, i, arg);
+                job->user_data2 = (void *)((uint64_t)i);
+
+                job = IMB_SUBMIT_JOB(mb_mgr);
+                while (job != NULL) {
+                        jobs_rx++;
+                        if (!completed_job_ok(job, check_job, arg))
+                                goto end;
+                        job = IMB_GET_COMPLETED_JOB(mb_mgr);
+                }
+        }
+
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL) {
+                jobs_rx++;
+                if (!completed_job_ok(job, check_job, arg))
+                        goto end;
+        }
+
+        if (jobs_rx != num_jobs) {
+                printf("Expected %d jobs, received %d\n", num_jobs, jobs_rx);
+                goto end;
+        }
+        ret = 0;
+
+ end:
+        while ((job = IMB_FLUSH_JOB(mb_mgr)) != NULL)
+                ;
+
+        return ret;
+}
+
+/*
+ * Submits a copy of job template tmpl on its own and returns it once
+ * completed (or rejected, e.g. with STS_INVALID_ARGS status).
+ * Returned job is valid until the next IMB_GET_NEXT_JOB() call.
+ */
+struct JOB_AES_HMAC *
+submit_one_job(struct MB_MGR *mb_mgr, const struct JOB_AES_HMAC *tmpl)
+{
+        struct JOB_AES_HMAC *job, *ret;
+
+        while (IMB_FLUSH_JOB(mb_mgr) != NULL)
+                ;
+
+        job = IMB_GET_NEXT_JOB(mb_mgr);
+        *job = *tmpl;
+        ret = IMB_SUBMIT_JOB(mb_mgr);
+        if (ret == NULL)
+                ret = IMB_GET_COMPLETED_JOB(mb_mgr);
+        if (ret == NULL)
+                ret = IMB_FLUSH_JOB(mb_mgr);
+
+        assert(ret == job);
+        return ret;
+}
@@ -32,4 +32,22 @@
 
 void hexdump(FILE *fp, const char *msg, const void *p, size_t len);
 
+struct MB_MGR;
+struct JOB_AES_HMAC;
+
+/*
+ * Callbacks of submit_many_jobs(): fill_job sets up job number n and
+ * check_job returns 1 if completed job number n produced the expected output
+ */
+typedef void (*fill_job_t)(struct JOB_AES_HMAC *job, const int n, void *arg);
+typedef int (*check_job_t)(const struct JOB_AES_HMAC *job, const int n,
+                           void *arg);
+
+int job_output_ok(const int n, const void *out, const void *expected,
+                  const size_t len);
+int submit_many_jobs(struct MB_MGR *mb_mgr, const int num_jobs,
+                     fill_job_t fill_job, check_job_t check_job, void *arg);
+struct JOB_AES_HMAC *submit_one_job(struct MB_MGR *mb_mgr,
+                                    const struct JOB_AES_HMAC *tmpl);
+
 #endif /* TESTAPP_UTILS_H */
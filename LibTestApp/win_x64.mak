@@ -55,7 +55,7 @@ CFLAGS = /nologo /D_CRT_SECURE_NO_WARNINGS $(DCFLAGS) /Y- /W3 /WX- /Gm- /fp:prec
 LNK = link
 LFLAGS = /out:$(APP).exe $(DLFLAGS)
 
-OBJS = main.obj gcm_test.obj ctr_test.obj customop_test.obj des_test.obj ccm_test.obj cmac_test.obj hmac_sha1_test.obj hmac_sha256_sha512_test.obj utils.obj hmac_md5_test.obj aes_test.obj sha_test.obj chained_test.obj api_test.obj
+OBJS = main.obj gcm_test.obj ctr_test.obj customop_test.obj des_test.obj ccm_test.obj cmac_test.obj hmac_sha1_test.obj hmac_sha256_sha512_test.obj utils.obj hmac_md5_test.obj aes_test.obj sha_test.obj chained_test.obj api_test.obj docsis_test.obj zuc_test.obj snow3g_test.obj kasumi_test.obj sha3_test.obj blake2_test.obj sm3_test.obj sm4_test.obj gcm_siv_test.obj
 
 all: $(APP).exe
 
@@ -107,5 +107,32 @@ chained_test.obj: chained_test.c utils.h
 api_test.obj: api_test.c gcm_ctr_vectors_test.h
 	$(CC) /c $(CFLAGS) api_test.c
 
+docsis_test.obj: docsis_test.c gcm_ctr_vectors_test.h utils.h
+	$(CC) /c $(CFLAGS) docsis_test.c
+
+zuc_test.obj: zuc_test.c gcm_ctr_vectors_test.h utils.h
+	$(CC) /c $(CFLAGS) zuc_test.c
+
+snow3g_test.obj: snow3g_test.c gcm_ctr_vectors_test.h utils.h
+	$(CC) /c $(CFLAGS) snow3g_test.c
+
+kasumi_test.obj: kasumi_test.c gcm_ctr_vectors_test.h utils.h
+	$(CC) /c $(CFLAGS) kasumi_test.c
+
+sha3_test.obj: sha3_test.c gcm_ctr_vectors_test.h utils.h
+	$(CC) /c $(CFLAGS) sha3_test.c
+
+blake2_test.obj: blake2_test.c gcm_ctr_vectors_test.h utils.h
+	$(CC) /c $(CFLAGS) blake2_test.c
+
+sm3_test.obj: sm3_test.c gcm_ctr_vectors_test.h utils.h
+	$(CC) /c $(CFLAGS) sm3_test.c
+
+sm4_test.obj: sm4_test.c gcm_ctr_vectors_test.h utils.h
+	$(CC) /c $(CFLAGS) sm4_test.c
+
+gcm_siv_test.obj: gcm_siv_test.c gcm_ctr_vectors_test.h utils.h
+	$(CC) /c $(CFLAGS) gcm_siv_test.c
+
 clean:
 	del /q $(OBJS) $(APP).*
@@ -0,0 +1,536 @@
+/*****************************************************************************
+ Copyright (c) 2019, Intel Corporation
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+     * Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+     * Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+     * Neither the name of Intel Corporation nor the names of its contributors
+       may be used to endorse or promote products derived from this software
+       without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include <intel-ipsec-mb.h>
+
+#include "gcm_ctr_vectors_test.h"
+#include "utils.h"
+
+int zuc_test(const enum arch_type arch, struct MB_MGR *mb_mgr);
+
+struct zuc_eea3_vector {
+        const uint8_t *K;       /* confidentiality key */
+        const uint8_t *IV;      /* initialization vector */
+        const uint8_t *P;       /* plain text */
+        const uint8_t *C;       /* cipher text */
+        uint64_t len;           /* message length in bytes */
+};
+
+struct zuc_eia3_vector {
+        const uint8_t *K;       /* integrity key */
+        const uint8_t *IV;      /* initialization vector */
+        const uint8_t *M;       /* message */
+        const uint8_t *MAC;     /* expected MAC */
+        uint64_t len;           /* message length in bits */
+};
+
+/*
+ * 128-EEA3 test set 1 (ETSI/SAGE specification of 128-EEA3 & 128-EIA3,
+ * Document 3: Implementor's Test Data), first 192 bits
+ * COUNT = 0x66035492, BEARER = 0xf, DIRECTION = 0
+ */
+static const uint8_t ZUC_EEA3_K1[] = {
+        0x17, 0x3d, 0x14, 0xba, 0x50, 0x03, 0x73, 0x1d,
+        0x7a, 0x60, 0x04, 0x94, 0x70, 0xf0, 0x0a, 0x29
+};
+static const uint8_t ZUC_EEA3_IV1[] = {
+        0x66, 0x03, 0x54, 0x92, 0x78, 0x00, 0x00, 0x00,
+        0x66, 0x03, 0x54, 0x92, 0x78, 0x00, 0x00, 0x00
+};
+static const uint8_t ZUC_EEA3_P1[] = {
+        0x6c, 0xf6, 0x53, 0x40, 0x73, 0x55, 0x52, 0xab,
+        0x0c, 0x97, 0x52, 0xfa, 0x6f, 0x90, 0x25, 0xfe,
+        0x0b, 0xd6, 0x75, 0xd9, 0x00, 0x58, 0x75, 0xb2
+};
+static const uint8_t ZUC_EEA3_C1[] = {
+        0xa6, 0xc8, 0x5f, 0xc6, 0x6a, 0xfb, 0x85, 0x33,
+        0xaa, 0xfc, 0x25, 0x18, 0xdf, 0xe7, 0x84, 0x94,
+        0x0e, 0xe1, 0xe4, 0xb0, 0x30, 0x23, 0x8c, 0xc8
+};
+
+/*
+ * 131 byte message (crosses the 64 byte keystream chunk boundary twice)
+ * COUNT = 0x12345678, BEARER = 5, DIRECTION = 1
+ */
+static const uint8_t ZUC_EEA3_K2[] = {
+        0x03, 0x14, 0x25, 0x36, 0x47, 0x58, 0x69, 0x7a,
+        0x8b, 0x9c, 0xad, 0xbe, 0xcf, 0xe0, 0xf1, 0x02
+};
+static const uint8_t ZUC_EEA3_IV2[] = {
+        0x12, 0x34, 0x56, 0x78, 0x2c, 0x00, 0x00, 0x00,
+        0x12, 0x34, 0x56, 0x78, 0x2c, 0x00, 0x00, 0x00
+};
+static const uint8_t ZUC_EEA3_P2[] = {
+        0x01, 0x08, 0x0f, 0x16, 0x1d, 0x24, 0x2b, 0x32,
+        0x39, 0x40, 0x47, 0x4e, 0x55, 0x5c, 0x63, 0x6a,
+        0x71, 0x78, 0x7f, 0x86, 0x8d, 0x94, 0x9b, 0xa2,
+        0xa9, 0xb0, 0xb7, 0xbe, 0xc5, 0xcc, 0xd3, 0xda,
+        0xe1, 0xe8, 0xef, 0xf6, 0xfd, 0x04, 0x0b, 0x12,
+        0x19, 0x20, 0x27, 0x2e, 0x35, 0x3c, 0x43, 0x4a,
+        0x51, 0x58, 0x5f, 0x66, 0x6d, 0x74, 0x7b, 0x82,
+        0x89, 0x90, 0x97, 0x9e, 0xa5, 0xac, 0xb3, 0xba,
+        0xc1, 0xc8, 0xcf, 0xd6, 0xdd, 0xe4, 0xeb, 0xf2,
+        0xf9, 0x00, 0x07, 0x0e, 0x15, 0x1c, 0x23, 0x2a,
+        0x31, 0x38, 0x3f, 0x46, 0x4d, 0x54, 0x5b, 0x62,
+        0x69, 0x70, 0x77, 0x7e, 0x85, 0x8c, 0x93, 0x9a,
+        0xa1, 0xa8, 0xaf, 0xb6, 0xbd, 0xc4, 0xcb, 0xd2,
+        0xd9, 0xe0, 0xe7, 0xee, 0xf5, 0xfc, 0x03, 0x0a,
+        0x11, 0x18, 0x1f, 0x26, 0x2d, 0x34, 0x3b, 0x42,
+        0x49, 0x50, 0x57, 0x5e, 0x65, 0x6c, 0x73, 0x7a,
+        0x81, 0x88, 0x8f
+};
+static const uint8_t ZUC_EEA3_C2[] = {
+        0x60, 0x57, 0xb0, 0xc7, 0x40, 0x73, 0x07, 0xf0,
+        0xe3, 0xb4, 0x08, 0xd2, 0x27, 0xa5, 0x06, 0xc1,
+        0x06, 0xc8, 0x9c, 0xc7, 0x38, 0xe7, 0xed, 0x6f,
+        0x8f, 0xb3, 0x0e, 0x45, 0x6a, 0xde, 0x3b, 0x25,
+        0x9c, 0x96, 0x98, 0x23, 0xf5, 0xad, 0x0c, 0x80,
+        0x4c, 0x50, 0xf5, 0xbb, 0x22, 0x9f, 0x5a, 0xf2,
+        0x05, 0x7a, 0xbf, 0xa7, 0xb5, 0x30, 0xb2, 0xf3,
+        0x33, 0xdf, 0xa9, 0x5a, 0x7e, 0x08, 0x69, 0xd7,
+        0x77, 0x1a, 0x62, 0x4a, 0xc4, 0xdf, 0x7d, 0x39,
+        0x06, 0x3c, 0xed, 0x0f, 0x99, 0xbd, 0x16, 0x65,
+        0x87, 0x65, 0xbe, 0xad, 0xc9, 0xa0, 0xfe, 0xe5,
+        0x35, 0x5d, 0x8e, 0x95, 0xfb, 0x8e, 0xea, 0xf1,
+        0xd0, 0x3e, 0xa4, 0xb2, 0xfc, 0xd1, 0xbe, 0x14,
+        0xed, 0x77, 0x02, 0x5f, 0xdc, 0x29, 0xf6, 0x73,
+        0x20, 0x81, 0xa1, 0xb2, 0xe9, 0x93, 0xbc, 0x40,
+        0x21, 0xb6, 0x73, 0xc2, 0xf5, 0xed, 0x4a, 0xa9,
+        0x5c, 0x5e, 0xa5
+};
+
+static const struct zuc_eea3_vector zuc_eea3_vectors[] = {
+        { ZUC_EEA3_K1, ZUC_EEA3_IV1, ZUC_EEA3_P1, ZUC_EEA3_C1,
+          sizeof(ZUC_EEA3_P1) },
+        { ZUC_EEA3_K2, ZUC_EEA3_IV2, ZUC_EEA3_P2, ZUC_EEA3_C2,
+          sizeof(ZUC_EEA3_P2) },
+};
+
+/*
+ * 128-EIA3 test set 1 (Document 3: Implementor's Test Data)
+ * COUNT = 0, BEARER = 0, DIRECTION = 0, 1 bit message
+ */
+static const uint8_t ZUC_EIA3_K1[] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+static const uint8_t ZUC_EIA3_IV1[] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+static const uint8_t ZUC_EIA3_M1[] = {
+        0x00, 0x00, 0x00, 0x00
+};
+static const uint8_t ZUC_EIA3_MAC1[] = {
+        0xc8, 0xa9, 0x59, 0x5e
+};
+
+/*
+ * 128-EIA3 test set 2 (Document 3: Implementor's Test Data)
+ * COUNT = 0x561eb2dd, BEARER = 0x14, DIRECTION = 0, 90 bit message
+ */
+static const uint8_t ZUC_EIA3_K2[] = {
+        0x47, 0x05, 0x41, 0x25, 0x56, 0x1e, 0xb2, 0xdd,
+        0xa9, 0x40, 0x59, 0xda, 0x05, 0x09, 0x78, 0x50
+};
+static const uint8_t ZUC_EIA3_IV2[] = {
+        0x56, 0x1e, 0xb2, 0xdd, 0xa0, 0x00, 0x00, 0x00,
+        0x56, 0x1e, 0xb2, 0xdd, 0xa0, 0x00, 0x00, 0x00
+};
+static const uint8_t ZUC_EIA3_M2[] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00
+};
+static const uint8_t ZUC_EIA3_MAC2[] = {
+        0x67, 0x19, 0xa0, 0x88
+};
+
+/*
+ * 577 bit message
+ * COUNT = 0x0a0b0c0d, BEARER = 0x1c, DIRECTION = 1
+ */
+static const uint8_t ZUC_EIA3_K3[] = {
+        0x0b, 0x28, 0x45, 0x62, 0x7f, 0x9c, 0xb9, 0xd6,
+        0xf3, 0x10, 0x2d, 0x4a, 0x67, 0x84, 0xa1, 0xbe
+};
+static const uint8_t ZUC_EIA3_IV3[] = {
+        0x0a, 0x0b, 0x0c, 0x0d, 0xe0, 0x00, 0x00, 0x00,
+        0x8a, 0x0b, 0x0c, 0x0d, 0xe0, 0x00, 0x80, 0x00
+};
+static const uint8_t ZUC_EIA3_M3[] = {
+        0x05, 0x12, 0x1f, 0x2c, 0x39, 0x46, 0x53, 0x60,
+        0x6d, 0x7a, 0x87, 0x94, 0xa1, 0xae, 0xbb, 0xc8,
+        0xd5, 0xe2, 0xef, 0xfc, 0x09, 0x16, 0x23, 0x30,
+        0x3d, 0x4a, 0x57, 0x64, 0x71, 0x7e, 0x8b, 0x98,
+        0xa5, 0xb2, 0xbf, 0xcc, 0xd9, 0xe6, 0xf3, 0x00,
+        0x0d, 0x1a, 0x27, 0x34, 0x41, 0x4e, 0x5b, 0x68,
+        0x75, 0x82, 0x8f, 0x9c, 0xa9, 0xb6, 0xc3, 0xd0,
+        0xdd, 0xea, 0xf7, 0x04, 0x11, 0x1e, 0x2b, 0x38,
+        0x45, 0x52, 0x5f, 0x6c, 0x79, 0x86, 0x93, 0xa0,
+        0xad
+};
+static const uint8_t ZUC_EIA3_MAC3[] = {
+        0x7d, 0xfc, 0xdb, 0x7d
+};
+
+static const struct zuc_eia3_vector zuc_eia3_vectors[] = {
+        { ZUC_EIA3_K1, ZUC_EIA3_IV1, ZUC_EIA3_M1, ZUC_EIA3_MAC1, 1 },
+        { ZUC_EIA3_K2, ZUC_EIA3_IV2, ZUC_EIA3_M2, ZUC_EIA3_MAC2, 90 },
+        { ZUC_EIA3_K3, ZUC_EIA3_IV3, ZUC_EIA3_M3, ZUC_EIA3_MAC3, 577 },
+};
+
+/* state shared by the job callbacks of test_zuc_eea3_many() */
+struct zuc_eea3_ctx {
+        JOB_CIPHER_DIRECTION dir;
+        uint8_t **srcs;
+        uint8_t **dsts;
+};
+
+static void
+zuc_eea3_fill_job(struct JOB_AES_HMAC *job, const int n, void *arg)
+{
+        const struct zuc_eea3_ctx *ctx = arg;
+        const struct zuc_eea3_vector *vec =
+                &zuc_eea3_vectors[n % DIM(zuc_eea3_vectors)];
+
+        job->cipher_direction = ctx->dir;
+        job->chain_order = (ctx->dir == ENCRYPT) ? CIPHER_HASH : HASH_CIPHER;
+        job->cipher_mode = ZUC_EEA3;
+        job->hash_alg = NULL_HASH;
+        job->aes_enc_key_expanded = vec->K;
+        job->aes_dec_key_expanded = vec->K;
+        job->aes_key_len_in_bytes = 16;
+        job->iv = vec->IV;
+        job->iv_len_in_bytes = 16;
+        job->src = ctx->srcs[n];
+        job->dst = ctx->dsts[n];
+        job->cipher_start_src_offset_in_bytes = 0;
+        job->msg_len_to_cipher_in_bytes = vec->len;
+}
+
+static int
+zuc_eea3_check_job(const struct JOB_AES_HMAC *job, const int n, void *arg)
+{
+        const struct zuc_eea3_ctx *ctx = arg;
+        const struct zuc_eea3_vector *vec =
+                &zuc_eea3_vectors[n % DIM(zuc_eea3_vectors)];
+
+        return job_output_ok(n, job->dst,
+                             (ctx->dir == ENCRYPT) ? vec->C : vec->P,
+                             vec->len);
+}
+
+/*
+ * Submits num_jobs jobs using test vectors in turn,
+ * so that lanes process messages of different lengths.
+ */
+static int
+test_zuc_eea3_many(struct MB_MGR *mb_mgr, const JOB_CIPHER_DIRECTION dir,
+                   const int in_place, const int num_jobs)
+{
+        struct zuc_eea3_ctx ctx;
+        int i, ret;
+
+        ctx.dir = dir;
+        ctx.srcs = malloc(num_jobs * sizeof(void *));
+        ctx.dsts = malloc(num_jobs * sizeof(void *));
+        assert(ctx.srcs != NULL && ctx.dsts != NULL);
+
+        for (i = 0; i < num_jobs; i++) {
+                const struct zuc_eea3_vector *vec =
+                        &zuc_eea3_vectors[i % DIM(zuc_eea3_vectors)];
+
+                ctx.srcs[i] = malloc(vec->len);
+                assert(ctx.srcs[i] != NULL);
+                memcpy(ctx.srcs[i], (dir == ENCRYPT) ? vec->P : vec->C,
+                       vec->len);
+                if (in_place) {
+                        ctx.dsts[i] = ctx.srcs[i];
+                } else {
+                        ctx.dsts[i] = malloc(vec->len);
+                        assert(ctx.dsts[i] != NULL);
+                        memset(ctx.dsts[i], -1, vec->len);
+                }
+        }
+
+        ret = submit_many_jobs(mb_mgr, num_jobs, zuc_eea3_fill_job,
+                               zuc_eea3_check_job, &ctx);
+
+        for (i = 0; i < num_jobs; i++) {
+                if (!in_place)
+                        free(ctx.dsts[i]);
+                free(ctx.srcs[i]);
+        }
+        free(ctx.srcs);
+        free(ctx.dsts);
+        return ret;
+}
+
+static void
+zuc_eia3_fill_job(struct JOB_AES_HMAC *job, const int n, void *arg)
+{
+        uint8_t *tags = arg;
+        const struct zuc_eia3_vector *vec =
+                &zuc_eia3_vectors[n % DIM(zuc_eia3_vectors)];
+
+        job->cipher_direction = ENCRYPT;
+        job->chain_order = HASH_CIPHER;
+        job->cipher_mode = NULL_CIPHER;
+        job->hash_alg = ZUC_EIA3_BITLEN;
+        job->u.ZUC_EIA3._key = vec->K;
+        job->u.ZUC_EIA3._iv = vec->IV;
+        job->src = vec->M;
+        job->hash_start_src_offset_in_bytes = 0;
+        job->msg_len_to_hash_in_bits = vec->len;
+        job->auth_tag_output = &tags[n * 4];
+        job->auth_tag_output_len_in_bytes = 4;
+}
+
+static int
+zuc_eia3_check_job(const struct JOB_AES_HMAC *job, const int n, void *arg)
+{
+        const struct zuc_eia3_vector *vec =
+                &zuc_eia3_vectors[n % DIM(zuc_eia3_vectors)];
+
+        (void) arg;
+        return job_output_ok(n, job->auth_tag_output, vec->MAC, 4);
+}
+
+static int
+test_zuc_eia3_many(struct MB_MGR *mb_mgr, const int num_jobs)
+{
+        uint8_t *tags = malloc(num_jobs * 4);
+        int ret;
+
+        assert(tags != NULL);
+        memset(tags, -1, num_jobs * 4);
+
+        ret = submit_many_jobs(mb_mgr, num_jobs, zuc_eia3_fill_job,
+                               zuc_eia3_check_job, tags);
+
+        free(tags);
+        return ret;
+}
+
+/* sets up 128-EEA3 job with key and IV of test set vec */
+static void
+zuc_eea3_job(struct JOB_AES_HMAC *job, const struct zuc_eea3_vector *vec,
+             const uint8_t *src, uint8_t *dst, const uint64_t len)
+{
+        memset(job, 0, sizeof(*job));
+        job->cipher_direction = ENCRYPT;
+        job->chain_order = CIPHER_HASH;
+        job->cipher_mode = ZUC_EEA3;
+        job->hash_alg = NULL_HASH;
+        job->aes_enc_key_expanded = vec->K;
+        job->aes_dec_key_expanded = vec->K;
+        job->aes_key_len_in_bytes = ZUC_KEY_LEN_IN_BYTES;
+        job->iv = vec->IV;
+        job->iv_len_in_bytes = ZUC_IV_LEN_IN_BYTES;
+        job->src = src;
+        job->dst = dst;
+        job->msg_len_to_cipher_in_bytes = len;
+}
+
+/* sets up 128-EIA3 job with key and IV of test set vec */
+static void
+zuc_eia3_job(struct JOB_AES_HMAC *job, const struct zuc_eia3_vector *vec,
+             const uint8_t *msg, const uint64_t len_in_bits, uint8_t *tag)
+{
+        memset(job, 0, sizeof(*job));
+        job->cipher_direction = ENCRYPT;
+        job->chain_order = HASH_CIPHER;
+        job->cipher_mode = NULL_CIPHER;
+        job->hash_alg = ZUC_EIA3_BITLEN;
+        job->u.ZUC_EIA3._key = vec->K;
+        job->u.ZUC_EIA3._iv = vec->IV;
+        job->src = msg;
+        job->msg_len_to_hash_in_bits = len_in_bits;
+        job->auth_tag_output = tag;
+        job->auth_tag_output_len_in_bytes = ZUC_DIGEST_LEN;
+}
+
+/*
+ * 128-EEA3 is a stream cipher: cipher text of any prefix of test set 2
+ * is the same prefix of its cipher text and no byte past the message
+ * is written. Lengths are picked around the 4 byte keystream word and
+ * the 64 byte keystream chunk.
+ */
+static int
+test_zuc_eea3_lengths(struct MB_MGR *mb_mgr)
+{
+        static const uint64_t lens[] = {
+                1, 2, 3, 4, 5, 31, 63, 64, 65, 127, 128, 129, 130
+        };
+        const struct zuc_eea3_vector *vec = &zuc_eea3_vectors[1];
+        struct JOB_AES_HMAC tmpl;
+        uint8_t dst[sizeof(ZUC_EEA3_P2) + 1];
+        unsigned i, j;
+
+        for (i = 0; i < DIM(lens); i++) {
+                const struct JOB_AES_HMAC *job;
+
+                memset(dst, 0xa5, sizeof(dst));
+                zuc_eea3_job(&tmpl, vec, vec->P, dst, lens[i]);
+                job = submit_one_job(mb_mgr, &tmpl);
+                if (job->status != STS_COMPLETED) {
+                        printf("EEA3 length %u: error status:%d\n",
+                               (unsigned) lens[i], job->status);
+                        return 1;
+                }
+                if (!job_output_ok((int) lens[i], dst, vec->C, lens[i]))
+                        return 1;
+                for (j = (unsigned) lens[i]; j < sizeof(dst); j++)
+                        if (dst[j] != 0xa5) {
+                                printf("EEA3 length %u: byte %u overwritten\n",
+                                       (unsigned) lens[i], j);
+                                return 1;
+                        }
+        }
+        return 0;
+}
+
+/*
+ * 128-EIA3 takes the message length in bits: bits past the length
+ * are not part of the message (test sets 2 and 3 end mid-byte)
+ * while the last bit of the message is.
+ */
+static int
+test_zuc_eia3_bitlen(struct MB_MGR *mb_mgr)
+{
+        struct JOB_AES_HMAC tmpl;
+        unsigned i;
+
+        for (i = 1; i < DIM(zuc_eia3_vectors); i++) {
+                const struct zuc_eia3_vector *vec = &zuc_eia3_vectors[i];
+                const uint64_t last = vec->len - 1;
+                uint8_t msg[sizeof(ZUC_EIA3_M3)];
+                uint8_t tag[ZUC_DIGEST_LEN];
+                const struct JOB_AES_HMAC *job;
+
+                /* set all the bits following the message */
+                memcpy(msg, vec->M, (vec->len + 7) / 8);
+                msg[vec->len / 8] |= 0xff >> (vec->len % 8);
+                zuc_eia3_job(&tmpl, vec, msg, vec->len, tag);
+                job = submit_one_job(mb_mgr, &tmpl);
+                if (job->status != STS_COMPLETED ||
+                    !job_output_ok((int) i, tag, vec->MAC, sizeof(tag))) {
+                        printf("EIA3 set %u: trailing bits not ignored\n",
+                               i + 1);
+                        return 1;
+                }
+
+                /* flip the last bit of the message */
+                memcpy(msg, vec->M, (vec->len + 7) / 8);
+                msg[last / 8] ^= 0x80 >> (last % 8);
+                zuc_eia3_job(&tmpl, vec, msg, vec->len, tag);
+                job = submit_one_job(mb_mgr, &tmpl);
+                if (job->status != STS_COMPLETED ||
+                    !memcmp(tag, vec->MAC, sizeof(tag))) {
+                        printf("EIA3 set %u: last bit not authenticated\n",
+                               i + 1);
+                        return 1;
+                }
+        }
+        return 0;
+}
+
+/* jobs outside of 128-EEA3/EIA3 key, IV, length and tag limits */
+static int
+test_zuc_invalid(struct MB_MGR *mb_mgr)
+{
+        const struct zuc_eea3_vector *eea3 = &zuc_eea3_vectors[0];
+        const struct zuc_eia3_vector *eia3 = &zuc_eia3_vectors[0];
+        struct JOB_AES_HMAC tmpl[8];
+        uint8_t dst[sizeof(ZUC_EEA3_P1)];
+        uint8_t tag[8];
+        unsigned i;
+
+        zuc_eea3_job(&tmpl[0], eea3, eea3->P, dst, eea3->len);
+        tmpl[0].aes_key_len_in_bytes = 32;
+        zuc_eea3_job(&tmpl[1], eea3, eea3->P, dst, eea3->len);
+        tmpl[1].iv_len_in_bytes = 8;
+        zuc_eea3_job(&tmpl[2], eea3, eea3->P, dst, 0);
+        zuc_eea3_job(&tmpl[3], eea3, eea3->P, dst, ZUC_MAX_BYTELEN + 1);
+        zuc_eia3_job(&tmpl[4], eia3, eia3->M, 0, tag);
+        zuc_eia3_job(&tmpl[5], eia3, eia3->M, ZUC_MAX_BITLEN + 1, tag);
+        zuc_eia3_job(&tmpl[6], eia3, eia3->M, eia3->len, tag);
+        tmpl[6].auth_tag_output_len_in_bytes = 8;
+        zuc_eia3_job(&tmpl[7], eia3, eia3->M, eia3->len, tag);
+        tmpl[7].u.ZUC_EIA3._iv = NULL;
+
+        for (i = 0; i < DIM(tmpl); i++) {
+                const struct JOB_AES_HMAC *job = submit_one_job(mb_mgr,
+                                                                &tmpl[i]);
+
+                if (job->status != STS_INVALID_ARGS) {
+                        printf("ZUC invalid job %u: status:%d\n",
+                               i, job->status);
+                        return 1;
+                }
+        }
+        return 0;
+}
+
+int
+zuc_test(const enum arch_type arch, struct MB_MGR *mb_mgr)
+{
+        const int num_jobs_tab[] = {
+                1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 33
+        };
+        unsigned i;
+        int errors = 0;
+
+        (void) arch; /* unused */
+
+        printf("ZUC test vectors:\n");
+        for (i = 0; i < DIM(num_jobs_tab); i++) {
+                const int n = num_jobs_tab[i];
+
+                errors += test_zuc_eea3_many(mb_mgr, ENCRYPT, 1, n);
+                errors += test_zuc_eea3_many(mb_mgr, ENCRYPT, 0, n);
+                errors += test_zuc_eea3_many(mb_mgr, DECRYPT, 1, n);
+                errors += test_zuc_eea3_many(mb_mgr, DECRYPT, 0, n);
+                errors += test_zuc_eia3_many(mb_mgr, n);
+        }
+        errors += test_zuc_eea3_lengths(mb_mgr);
+        errors += test_zuc_eia3_bitlen(mb_mgr);
+        errors += test_zuc_invalid(mb_mgr);
+
+	if (0 == errors)
+		printf("...Pass\n");
+	else
+		printf("...Fail\n");
+
+	return errors;
+}
@@ -0,0 +1,67 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* AES-GCM-SIV common code */
+
+#include <string.h>
+
+#include "intel-ipsec-mb.h"
+#include "aes_gcm_siv.h"
+
+void
+aes_gcm_siv_ooo_init(MB_MGR_AES_GCM_SIV_OOO *state)
+{
+        memset(state, 0, sizeof(*state));
+}
+
+void
+aes_gcm_siv_polyval_mul(uint64_t x[2], const uint64_t h[2])
+{
+        uint64_t r0 = 0, r1 = 0;
+        unsigned i;
+
+        /*
+         * Adds h for each bit of x, from the least significant one,
+         * and multiplies the sum by x^-1 after each bit.
+         * Multiplication by x^-1 is a right shift, after adding
+         * the polynomial when bit 0 is set.
+         */
+        for (i = 0; i < 128; i++) {
+                const uint64_t bit = (x[i / 64] >> (i % 64)) & 1;
+                const uint64_t mask = (uint64_t) 0 - bit;
+                uint64_t lsb;
+
+                r0 ^= h[0] & mask;
+                r1 ^= h[1] & mask;
+
+                lsb = (uint64_t) 0 - (r0 & 1);
+                r0 = (r0 >> 1) | (r1 << 63);
+                r1 = (r1 >> 1) ^ (UINT64_C(0xe100000000000000) & lsb);
+        }
+        x[0] = r0;
+        x[1] = r1;
+}
@@ -0,0 +1,51 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* Multi-key HMAC ipad/opad precompute for AVX2 architecture */
+
+#define HMAC_IPAD_OPAD_MB hmac_ipad_opad_mb_avx2
+
+#define SHA1_MB sha1_mb_avx2
+#define SHA1_MB_LANES 8
+#define SHA256_MB sha256_mb_avx2
+#define SHA256_MB_LANES 8
+#define SHA512_MB sha512_mb_avx2
+#define SHA512_MB_LANES 4
+
+#define SHA1_HASH sha1_avx2
+#define SHA224_HASH sha224_avx2
+#define SHA256_HASH sha256_avx2
+#define SHA384_HASH sha384_avx2
+#define SHA512_HASH sha512_avx2
+#define SHA512_256_HASH sha512_256_avx2
+#define SHA512_224_HASH sha512_224_avx2
+
+#define SAVE_XMMS save_xmms_avx
+#define RESTORE_XMMS restore_xmms_avx
+#define HMAC_IPAD_OPAD_MB_ZEROUPPER
+
+#include "hmac_ipad_opad_mb.h"
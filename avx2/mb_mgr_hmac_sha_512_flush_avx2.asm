@@ -185,13 +185,17 @@ proc_outer:
 
 	; move digest into data location
 	%assign I 0
-	%rep (SHA_X_DIGEST_SIZE / (8*16))
+	%rep ((SHA_X_DIGEST_SIZE + 127) / (8*16))
 	vmovq	xmm0, [state + _args_digest_sha512 + SHA512_DIGEST_WORD_SIZE*idx + 2*I*SHA512_DIGEST_ROW_SIZE]
 	vpinsrq	xmm0, [state + _args_digest_sha512 + SHA512_DIGEST_WORD_SIZE*idx + (2*I + 1)*SHA512_DIGEST_ROW_SIZE], 1
 	vpshufb	xmm0, [rel byteswap]
 	vmovdqa	[lane_data + _outer_block_sha512 + I*2*SHA512_DIGEST_WORD_SIZE], xmm0
 	%assign I (I+1)
 	%endrep
+%if (SHA_X_DIGEST_SIZE == 224)
+	;; SHA512/224 digest ends in the middle of the 4th word
+	mov	dword [lane_data + _outer_block_sha512 + 7*4], 0x80
+%endif
 
 	; move the opad key into digest
 	mov	tmp, [job + _auth_key_xor_opad]
@@ -231,6 +235,44 @@ end_loop:
 
 	mov	p, [job_rax + _auth_tag_output]
 
+%if (SHA_X_DIGEST_SIZE <= 256)
+        cmp     qword [job_rax + _auth_tag_output_len_in_bytes], SHA_X_DIGEST_SIZE / 16
+        jne     copy_full_digest
+
+	;; copy 16 bytes for SHA512/256 / 14 bytes for SHA512/224
+	mov	QWORD(tmp2), [state + _args_digest_sha512 + SHA512_DIGEST_WORD_SIZE*idx + 0*SHA512_DIGEST_ROW_SIZE]
+	mov	QWORD(tmp4), [state + _args_digest_sha512 + SHA512_DIGEST_WORD_SIZE*idx + 1*SHA512_DIGEST_ROW_SIZE]
+	bswap	QWORD(tmp2)
+	bswap	QWORD(tmp4)
+	mov	[p + 0*8], QWORD(tmp2)
+%if (SHA_X_DIGEST_SIZE == 224)
+	mov	[p + 1*8], DWORD(tmp4)
+	shr	QWORD(tmp4), 32
+	mov	[p + 1*8 + 4], WORD(tmp4)
+%else
+	mov	[p + 1*8], QWORD(tmp4)
+%endif
+        jmp     return
+
+copy_full_digest:
+	;; copy 32 bytes for SHA512/256 / 28 bytes for SHA512/224
+	mov	QWORD(tmp2), [state + _args_digest_sha512 + SHA512_DIGEST_WORD_SIZE*idx + 0*SHA512_DIGEST_ROW_SIZE]
+	mov	QWORD(tmp4), [state + _args_digest_sha512 + SHA512_DIGEST_WORD_SIZE*idx + 1*SHA512_DIGEST_ROW_SIZE]
+	mov	QWORD(tmp6), [state + _args_digest_sha512 + SHA512_DIGEST_WORD_SIZE*idx + 2*SHA512_DIGEST_ROW_SIZE]
+	mov	QWORD(tmp5), [state + _args_digest_sha512 + SHA512_DIGEST_WORD_SIZE*idx + 3*SHA512_DIGEST_ROW_SIZE]
+	bswap	QWORD(tmp2)
+	bswap	QWORD(tmp4)
+	bswap	QWORD(tmp6)
+	bswap	QWORD(tmp5)
+	mov	[p + 0*8], QWORD(tmp2)
+	mov	[p + 1*8], QWORD(tmp4)
+	mov	[p + 2*8], QWORD(tmp6)
+%if (SHA_X_DIGEST_SIZE == 224)
+	mov	[p + 3*8], DWORD(tmp5)
+%else
+	mov	[p + 3*8], QWORD(tmp5)
+%endif
+%else ; SHA512 or SHA384
 %if (SHA_X_DIGEST_SIZE != 384)
         cmp     qword [job_rax + _auth_tag_output_len_in_bytes], 32
         jne     copy_full_digest
@@ -293,6 +335,7 @@ copy_full_digest:
 	mov	[p + 6*8], QWORD(tmp6)
 	mov	[p + 7*8], QWORD(tmp5)
 %endif
+%endif
 
 return:
         vzeroupper
@@ -0,0 +1,118 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * Ethernet FCS (CRC32) computation for AVX512 architecture
+ * with VPCLMULQDQ extension
+ *
+ * Folds 4 x 512 bits at a time and then continues
+ * with the common 128-bit PCLMULQDQ code.
+ */
+
+#include <immintrin.h>
+
+#include "ethernet_fcs.h"
+#include "crc32_refl.h"
+
+/**
+ * @brief Folds 512-bit CRC state into the next 512-bit block
+ *
+ * @param x current 512-bit CRC state
+ * @param k folding constants (the same in each 128-bit lane)
+ * @param data next 512-bit data block
+ *
+ * @return new 512-bit CRC state
+ */
+__forceinline
+__m512i
+crc32_refl_fold_512(const __m512i x, const __m512i k, const __m512i data)
+{
+        return _mm512_ternarylogic_epi64(_mm512_clmulepi64_epi128(x, k, 0x00),
+                                         _mm512_clmulepi64_epi128(x, k, 0x11),
+                                         data, 0x96);
+}
+
+uint32_t
+ethernet_fcs_avx512(const uint32_t fcs, const void *msg, const uint64_t len)
+{
+        const uint8_t *p = (const uint8_t *) msg;
+        uint64_t n = len;
+        uint64_t blocks_len;
+        uint32_t crc = ~fcs;
+        __m512i z0, z1, z2, z3, k;
+        __m128i x;
+
+        if (n < 256)
+                return ~crc32_refl_pclmul(crc, p, n);
+
+        z0 = _mm512_inserti32x4(_mm512_setzero_si512(),
+                                _mm_cvtsi32_si128((int) crc), 0);
+        z0 = _mm512_xor_si512(z0, _mm512_loadu_si512(&p[0]));
+        z1 = _mm512_loadu_si512(&p[64]);
+        z2 = _mm512_loadu_si512(&p[128]);
+        z3 = _mm512_loadu_si512(&p[192]);
+
+        /* fold by 4 x 512 bits (2048 bits) */
+        k = _mm512_broadcast_i32x4(_mm_set_epi64x(0x1322d1430, 0x11542778a));
+
+        for (p += 256, n -= 256; n >= 256; p += 256, n -= 256) {
+                z0 = crc32_refl_fold_512(z0, k, _mm512_loadu_si512(&p[0]));
+                z1 = crc32_refl_fold_512(z1, k, _mm512_loadu_si512(&p[64]));
+                z2 = crc32_refl_fold_512(z2, k, _mm512_loadu_si512(&p[128]));
+                z3 = crc32_refl_fold_512(z3, k, _mm512_loadu_si512(&p[192]));
+        }
+
+        /* fold 4 x 512 bits into 512 bits and the remaining 64-byte blocks */
+        k = _mm512_broadcast_i32x4(CRC32_REFL_K_512());
+        z0 = crc32_refl_fold_512(z0, k, z1);
+        z0 = crc32_refl_fold_512(z0, k, z2);
+        z0 = crc32_refl_fold_512(z0, k, z3);
+
+        for (; n >= 64; p += 64, n -= 64)
+                z0 = crc32_refl_fold_512(z0, k, _mm512_loadu_si512(p));
+
+        /*
+         * Fold 4 x 128 bits into 128 bits
+         * - lanes 0, 1 and 2 are folded by 384, 256 and 128 bits
+         * - lane 3 is not folded (zero constants)
+         */
+        k = _mm512_set_epi64(0, 0,
+                             0x0ccaa009e, 0x1751997d0,
+                             0x15a546366, 0x0f1da05aa,
+                             0x174359406, 0x03db1ecdc);
+        z1 = _mm512_xor_si512(_mm512_clmulepi64_epi128(z0, k, 0x00),
+                              _mm512_clmulepi64_epi128(z0, k, 0x11));
+        x = _mm_xor_si128(_mm512_extracti32x4_epi32(z1, 0),
+                          _mm512_extracti32x4_epi32(z1, 1));
+        x = _mm_xor_si128(x, _mm512_extracti32x4_epi32(z1, 2));
+        x = _mm_xor_si128(x, _mm512_extracti32x4_epi32(z0, 3));
+
+        blocks_len = n & (~UINT64_C(15));
+        crc = crc32_refl_fold_reduce(x, p, blocks_len);
+
+        return ~crc32_refl_nibble(crc, p + blocks_len, n - blocks_len);
+}
@@ -1,5 +1,5 @@
 ;;
-;; Copyright (c) 2018, Intel Corporation
+;; Copyright (c) 2017-2018, Intel Corporation
 ;;
 ;; Redistribution and use in source and binary forms, with or without
 ;; modification, are permitted provided that the following conditions are met:
@@ -25,6 +25,5 @@
 ;; OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ;;
 
-%include "include/aesni_emu.inc"
-%define AES_CNTR_256 aes_cntr_256_sse_no_aesni
-%include "sse/aes256_cntr_by4_sse.asm"
+%define SHA512_256
+%include "avx512/mb_mgr_hmac_sha_512_flush_avx512.asm"
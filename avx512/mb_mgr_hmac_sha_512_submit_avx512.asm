@@ -108,14 +108,22 @@ endstruc
 ; arg 1 : rcx : state
 ; arg 2 : rdx : job
 align 64
-%ifndef SHA384
-MKGLOBAL(submit_job_hmac_sha_512_avx512,function,internal)
-%define SHA_X_DIGEST_SIZE 512
-submit_job_hmac_sha_512_avx512:
-%else
+%ifdef SHA384
 MKGLOBAL(submit_job_hmac_sha_384_avx512,function,internal)
 %define SHA_X_DIGEST_SIZE 384
 submit_job_hmac_sha_384_avx512:
+%elifdef SHA512_256
+MKGLOBAL(submit_job_hmac_sha_512_256_avx512,function,internal)
+%define SHA_X_DIGEST_SIZE 256
+submit_job_hmac_sha_512_256_avx512:
+%elifdef SHA512_224
+MKGLOBAL(submit_job_hmac_sha_512_224_avx512,function,internal)
+%define SHA_X_DIGEST_SIZE 224
+submit_job_hmac_sha_512_224_avx512:
+%else
+MKGLOBAL(submit_job_hmac_sha_512_avx512,function,internal)
+%define SHA_X_DIGEST_SIZE 512
+submit_job_hmac_sha_512_avx512:
 %endif
 
 	mov	rax, rsp
@@ -245,13 +253,17 @@ proc_outer:
 	mov	[state + _args_data_ptr_sha512 + PTR_SZ*idx], tmp
 
 %assign I 0
-%rep (SHA_X_DIGEST_SIZE / (8 * 16))
+%rep ((SHA_X_DIGEST_SIZE + 127) / (8 * 16))
 	vmovq	xmm0, [state + _args_digest_sha512 + SHA512_DIGEST_WORD_SIZE*idx + (2*I + 0)*SHA512_DIGEST_ROW_SIZE]
 	vpinsrq	xmm0, [state + _args_digest_sha512 + SHA512_DIGEST_WORD_SIZE*idx + (2*I + 1)*SHA512_DIGEST_ROW_SIZE], 1
 	vpshufb	xmm0, [rel byteswap]
 	vmovdqa	[lane_data + _outer_block_sha512 + I * 2 * SHA512_DIGEST_WORD_SIZE], xmm0
 %assign I (I+1)
 %endrep
+%if (SHA_X_DIGEST_SIZE == 224)
+	;; SHA512/224 digest ends in the middle of the 4th word
+	mov	dword [lane_data + _outer_block_sha512 + 7*4], 0x80
+%endif
 
 	mov	tmp, [job + _auth_key_xor_opad]
 %assign I 0
@@ -301,6 +313,44 @@ end_loop:
 
         vzeroupper
 
+%if (SHA_X_DIGEST_SIZE <= 256)
+        cmp     qword [job_rax + _auth_tag_output_len_in_bytes], SHA_X_DIGEST_SIZE / 16
+        jne     copy_full_digest
+
+	;; copy 16 bytes for SHA512/256 / 14 bytes for SHA512/224
+	mov	QWORD(tmp), [state + _args_digest_sha512 + SHA512_DIGEST_WORD_SIZE*idx + 0*SHA512_DIGEST_ROW_SIZE]
+	mov	QWORD(tmp2), [state + _args_digest_sha512 + SHA512_DIGEST_WORD_SIZE*idx + 1*SHA512_DIGEST_ROW_SIZE]
+	bswap	QWORD(tmp)
+	bswap	QWORD(tmp2)
+	mov	[p + 0*8], QWORD(tmp)
+%if (SHA_X_DIGEST_SIZE == 224)
+	mov	[p + 1*8], DWORD(tmp2)
+	shr	QWORD(tmp2), 32
+	mov	[p + 1*8 + 4], WORD(tmp2)
+%else
+	mov	[p + 1*8], QWORD(tmp2)
+%endif
+        jmp     return
+
+copy_full_digest:
+	;; copy 32 bytes for SHA512/256 / 28 bytes for SHA512/224
+	mov	QWORD(tmp), [state + _args_digest_sha512 + SHA512_DIGEST_WORD_SIZE*idx + 0*SHA512_DIGEST_ROW_SIZE]
+	mov	QWORD(tmp2), [state + _args_digest_sha512 + SHA512_DIGEST_WORD_SIZE*idx + 1*SHA512_DIGEST_ROW_SIZE]
+	mov	QWORD(tmp3), [state + _args_digest_sha512 + SHA512_DIGEST_WORD_SIZE*idx + 2*SHA512_DIGEST_ROW_SIZE]
+	mov	QWORD(tmp4), [state + _args_digest_sha512 + SHA512_DIGEST_WORD_SIZE*idx + 3*SHA512_DIGEST_ROW_SIZE]
+	bswap	QWORD(tmp)
+	bswap	QWORD(tmp2)
+	bswap	QWORD(tmp3)
+	bswap	QWORD(tmp4)
+	mov	[p + 0*8], QWORD(tmp)
+	mov	[p + 1*8], QWORD(tmp2)
+	mov	[p + 2*8], QWORD(tmp3)
+%if (SHA_X_DIGEST_SIZE == 224)
+	mov	[p + 3*8], DWORD(tmp4)
+%else
+	mov	[p + 3*8], QWORD(tmp4)
+%endif
+%else ; SHA512 or SHA384
 %if (SHA_X_DIGEST_SIZE != 384)
         cmp     qword [job_rax + _auth_tag_output_len_in_bytes], 32
         jne     copy_full_digest
@@ -363,6 +413,7 @@ copy_full_digest:
 	mov	[p + 6*8], QWORD(tmp3)
 	mov	[p + 7*8], QWORD(tmp4)
 %endif
+%endif
 
 return:
 	mov	rbx, [rsp + _gpr_save + 8*0]
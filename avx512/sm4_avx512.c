@@ -0,0 +1,41 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * SM4-CBC, SM4-CTR and SM4-GCM for AVX512 architecture.
+ * 8 lanes - AES out of order manager layout is shared with AVX2.
+ */
+
+#define SIMD_LANES 8
+#define SUBMIT_JOB_SM4_CBC_ENC submit_job_sm4_cbc_enc_avx512
+#define FLUSH_JOB_SM4_CBC_ENC  flush_job_sm4_cbc_enc_avx512
+#define SUBMIT_JOB_SM4_CBC_DEC submit_job_sm4_cbc_dec_avx512
+#define SUBMIT_JOB_SM4_CNTR    submit_job_sm4_cntr_avx512
+#define SUBMIT_JOB_SM4_GCM_ENC submit_job_sm4_gcm_enc_avx512
+#define SUBMIT_JOB_SM4_GCM_DEC submit_job_sm4_gcm_dec_avx512
+
+#include "sm4_mb.h"
@@ -0,0 +1,356 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* BLAKE2b and BLAKE2s common code and out of order manager lane handling */
+
+#include <string.h>
+
+#include "intel-ipsec-mb.h"
+#include "blake2.h"
+
+IMB_DLL_LOCAL const uint64_t blake2b_iv[8] = {
+        0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL,
+        0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+        0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL,
+        0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+IMB_DLL_LOCAL const uint32_t blake2s_iv[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+IMB_DLL_LOCAL const uint8_t blake2_sigma[BLAKE2S_ROUNDS][16] = {
+        {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+        { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+        { 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+        {  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+        {  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+        {  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+        { 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 },
+        { 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 },
+        {  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 },
+        { 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 }
+};
+
+IMB_DLL_LOCAL const uint8_t blake2_zero_block[BLAKE2B_BLOCK_SIZE] = { 0 };
+
+/* lane phases, in processing order */
+#define BLAKE2_PHASE_KEY  0
+#define BLAKE2_PHASE_MSG  1
+#define BLAKE2_PHASE_LAST 2
+#define BLAKE2_PHASE_DONE 3
+
+static void
+blake2_lanes_init(BLAKE2_OOO_LANES *ol, const unsigned num_lanes)
+{
+        unsigned i;
+
+        for (i = num_lanes; i > 0; i--)
+                ol->unused_lanes = (ol->unused_lanes << 4) | (i - 1);
+}
+
+void
+blake2b_ooo_init(MB_MGR_BLAKE2B_OOO *state, const unsigned num_lanes)
+{
+        memset(state, 0, sizeof(*state));
+        blake2_lanes_init(&state->lanes, num_lanes);
+}
+
+void
+blake2s_ooo_init(MB_MGR_BLAKE2S_OOO *state, const unsigned num_lanes)
+{
+        memset(state, 0, sizeof(*state));
+        blake2_lanes_init(&state->lanes, num_lanes);
+}
+
+static int
+blake2_is_keyed(const JOB_AES_HMAC *job)
+{
+        return job->hash_alg == BLAKE2B_KEYED || job->hash_alg == BLAKE2S_KEYED;
+}
+
+static uint64_t
+blake2_key_len(const JOB_AES_HMAC *job)
+{
+        return blake2_is_keyed(job) ? job->u.BLAKE2._key_len_in_bytes : 0;
+}
+
+/* number of message blocks before the last block */
+static uint64_t
+blake2_msg_blocks(const uint64_t len, const uint32_t block_size)
+{
+        return (len == 0) ? 0 : (len - 1) / block_size;
+}
+
+/* first word of the parameter block: digest length, key length, fanout 1
+ * and depth 1 (sequential mode) */
+static uint32_t
+blake2_param_word(const JOB_AES_HMAC *job)
+{
+        return 0x01010000 | (uint32_t) (blake2_key_len(job) << 8) |
+                (uint32_t) job->auth_tag_output_len_in_bytes;
+}
+
+/* prepares the key block and the zero padded last block of the lane */
+static void
+blake2_ooo_load_lane(BLAKE2_OOO_LANES *ol, const unsigned lane,
+                     JOB_AES_HMAC *job, const uint32_t block_size)
+{
+        BLAKE2_LANE_DATA *ld = &ol->ldata[lane];
+        const uint8_t *msg = job->src + job->hash_start_src_offset_in_bytes;
+        const uint64_t len = job->msg_len_to_hash_in_bytes;
+        const uint64_t tail = len - blake2_msg_blocks(len, block_size) *
+                block_size;
+        const uint64_t key_len = blake2_key_len(job);
+
+        ld->job_in_lane = job;
+        ld->t = 0;
+        ld->phase = (key_len != 0) ? BLAKE2_PHASE_KEY : BLAKE2_PHASE_MSG;
+
+        if (key_len != 0)
+                memcpy(ld->extra_block[0], job->u.BLAKE2._key, key_len);
+        memset(&ld->extra_block[0][key_len], 0, block_size - key_len);
+        memcpy(ld->extra_block[1], &msg[len - tail], tail);
+        memset(&ld->extra_block[1][tail], 0, block_size - tail);
+
+        /* lane_next() sets up the first blocks */
+        ol->in[lane] = msg;
+        ol->lens[lane] = 0;
+}
+
+/**
+ * @brief Advances a lane that has no more blocks to compress
+ *
+ * @return 1 if the job in the lane is complete, 0 otherwise
+ */
+static int
+blake2_ooo_lane_next(BLAKE2_OOO_LANES *ol, const unsigned lane,
+                     const uint32_t block_size)
+{
+        BLAKE2_LANE_DATA *ld = &ol->ldata[lane];
+        const JOB_AES_HMAC *job = ld->job_in_lane;
+        const uint64_t len = job->msg_len_to_hash_in_bytes;
+        const uint64_t blocks = blake2_msg_blocks(len, block_size);
+
+        switch (ld->phase) {
+        case BLAKE2_PHASE_KEY:
+                /* key block is the last one for empty messages */
+                ol->in[lane] = ld->extra_block[0];
+                ol->lens[lane] = 1;
+                ld->inc = block_size;
+                ld->f = (len == 0) ? UINT64_MAX : 0;
+                ld->phase = (len == 0) ? BLAKE2_PHASE_DONE : BLAKE2_PHASE_MSG;
+                return 0;
+        case BLAKE2_PHASE_MSG:
+                ld->phase = BLAKE2_PHASE_LAST;
+                if (blocks != 0) {
+                        ol->in[lane] = job->src +
+                                job->hash_start_src_offset_in_bytes;
+                        ol->lens[lane] = blocks;
+                        ld->inc = block_size;
+                        ld->f = 0;
+                        return 0;
+                }
+                /* fall through */
+        case BLAKE2_PHASE_LAST:
+                /* counter includes only the message bytes of the block */
+                ol->in[lane] = ld->extra_block[1];
+                ol->lens[lane] = 1;
+                ld->inc = len - blocks * block_size;
+                ld->f = UINT64_MAX;
+                ld->phase = BLAKE2_PHASE_DONE;
+                return 0;
+        default:
+                return 1;
+        }
+}
+
+static JOB_AES_HMAC *
+blake2_release_lane(BLAKE2_OOO_LANES *ol, const unsigned lane)
+{
+        JOB_AES_HMAC *job = ol->ldata[lane].job_in_lane;
+
+        ol->ldata[lane].job_in_lane = NULL;
+        ol->unused_lanes = (ol->unused_lanes << 4) | lane;
+        ol->num_lanes_inuse--;
+        job->status |= STS_COMPLETED_HMAC;
+        return job;
+}
+
+/* processes lanes in use until one job is complete, returns its lane */
+static unsigned
+blake2_ooo_process(void *state, BLAKE2_OOO_LANES *ol,
+                   const unsigned num_lanes, const uint32_t block_size,
+                   blake2_compress_lanes_t compress)
+{
+        for (;;) {
+                uint64_t min_len = UINT64_MAX;
+                unsigned lane;
+
+                for (lane = 0; lane < num_lanes; lane++) {
+                        if (ol->ldata[lane].job_in_lane == NULL)
+                                continue;
+                        if (ol->lens[lane] == 0 &&
+                            blake2_ooo_lane_next(ol, lane, block_size))
+                                return lane;
+                        if (ol->lens[lane] < min_len)
+                                min_len = ol->lens[lane];
+                }
+
+                compress(state, min_len);
+        }
+}
+
+/* takes an unused lane, returns its index */
+static unsigned
+blake2_ooo_get_lane(BLAKE2_OOO_LANES *ol)
+{
+        const unsigned lane = (unsigned) (ol->unused_lanes & 15);
+
+        ol->unused_lanes >>= 4;
+        ol->num_lanes_inuse++;
+        return lane;
+}
+
+/* ========================================================================== */
+/* BLAKE2b */
+
+static void
+blake2b_ooo_load_lane(MB_MGR_BLAKE2B_OOO *state, const unsigned lane,
+                      JOB_AES_HMAC *job)
+{
+        unsigned i;
+
+        for (i = 0; i < 8; i++)
+                state->h[i][lane] = blake2b_iv[i];
+        state->h[0][lane] ^= blake2_param_word(job);
+
+        blake2_ooo_load_lane(&state->lanes, lane, job, BLAKE2B_BLOCK_SIZE);
+}
+
+static JOB_AES_HMAC *
+blake2b_ooo_complete(MB_MGR_BLAKE2B_OOO *state, const unsigned lane)
+{
+        JOB_AES_HMAC *job = state->lanes.ldata[lane].job_in_lane;
+        uint64_t i;
+
+        for (i = 0; i < job->auth_tag_output_len_in_bytes; i++)
+                job->auth_tag_output[i] =
+                        (uint8_t) (state->h[i / 8][lane] >> (8 * (i % 8)));
+
+        return blake2_release_lane(&state->lanes, lane);
+}
+
+JOB_AES_HMAC *
+blake2b_ooo_submit(MB_MGR_BLAKE2B_OOO *state, JOB_AES_HMAC *job,
+                   const unsigned num_lanes, blake2_compress_lanes_t compress)
+{
+        blake2b_ooo_load_lane(state, blake2_ooo_get_lane(&state->lanes), job);
+
+        if (state->lanes.num_lanes_inuse < num_lanes)
+                return NULL;
+
+        return blake2b_ooo_complete(state,
+                                    blake2_ooo_process(state, &state->lanes,
+                                                       num_lanes,
+                                                       BLAKE2B_BLOCK_SIZE,
+                                                       compress));
+}
+
+JOB_AES_HMAC *
+blake2b_ooo_flush(MB_MGR_BLAKE2B_OOO *state, const unsigned num_lanes,
+                  blake2_compress_lanes_t compress)
+{
+        if (state->lanes.num_lanes_inuse == 0)
+                return NULL;
+
+        return blake2b_ooo_complete(state,
+                                    blake2_ooo_process(state, &state->lanes,
+                                                       num_lanes,
+                                                       BLAKE2B_BLOCK_SIZE,
+                                                       compress));
+}
+
+/* ========================================================================== */
+/* BLAKE2s */
+
+static void
+blake2s_ooo_load_lane(MB_MGR_BLAKE2S_OOO *state, const unsigned lane,
+                      JOB_AES_HMAC *job)
+{
+        unsigned i;
+
+        for (i = 0; i < 8; i++)
+                state->h[i][lane] = blake2s_iv[i];
+        state->h[0][lane] ^= blake2_param_word(job);
+
+        blake2_ooo_load_lane(&state->lanes, lane, job, BLAKE2S_BLOCK_SIZE);
+}
+
+static JOB_AES_HMAC *
+blake2s_ooo_complete(MB_MGR_BLAKE2S_OOO *state, const unsigned lane)
+{
+        JOB_AES_HMAC *job = state->lanes.ldata[lane].job_in_lane;
+        uint64_t i;
+
+        for (i = 0; i < job->auth_tag_output_len_in_bytes; i++)
+                job->auth_tag_output[i] =
+                        (uint8_t) (state->h[i / 4][lane] >> (8 * (i % 4)));
+
+        return blake2_release_lane(&state->lanes, lane);
+}
+
+JOB_AES_HMAC *
+blake2s_ooo_submit(MB_MGR_BLAKE2S_OOO *state, JOB_AES_HMAC *job,
+                   const unsigned num_lanes, blake2_compress_lanes_t compress)
+{
+        blake2s_ooo_load_lane(state, blake2_ooo_get_lane(&state->lanes), job);
+
+        if (state->lanes.num_lanes_inuse < num_lanes)
+                return NULL;
+
+        return blake2s_ooo_complete(state,
+                                    blake2_ooo_process(state, &state->lanes,
+                                                       num_lanes,
+                                                       BLAKE2S_BLOCK_SIZE,
+                                                       compress));
+}
+
+JOB_AES_HMAC *
+blake2s_ooo_flush(MB_MGR_BLAKE2S_OOO *state, const unsigned num_lanes,
+                  blake2_compress_lanes_t compress)
+{
+        if (state->lanes.num_lanes_inuse == 0)
+                return NULL;
+
+        return blake2s_ooo_complete(state,
+                                    blake2_ooo_process(state, &state->lanes,
+                                                       num_lanes,
+                                                       BLAKE2S_BLOCK_SIZE,
+                                                       compress));
+}
@@ -80,4 +80,24 @@
 #define SHA384_H7 0x47b5481dbefa4fa4
 #define SHA384_PAD_SIZE 16
 
+/* define SHA512/256 constants (FIPS 180-4 section 5.3.6.2) */
+#define SHA512_256_H0 0x22312194fc2bf72c
+#define SHA512_256_H1 0x9f555fa3c84c64c2
+#define SHA512_256_H2 0x2393b86b6f53b151
+#define SHA512_256_H3 0x963877195940eabd
+#define SHA512_256_H4 0x96283ee2a88effe3
+#define SHA512_256_H5 0xbe5e1e2553863992
+#define SHA512_256_H6 0x2b0199fc2c85b8aa
+#define SHA512_256_H7 0x0eb72ddc81c52ca2
+
+/* define SHA512/224 constants (FIPS 180-4 section 5.3.6.1) */
+#define SHA512_224_H0 0x8c3d37c819544da2
+#define SHA512_224_H1 0x73e1996689dcd4d6
+#define SHA512_224_H2 0x1dfab7ae32ff9c82
+#define SHA512_224_H3 0x679dd514582f9fcf
+#define SHA512_224_H4 0x0f6d2b697bd44da8
+#define SHA512_224_H5 0x77e36f7304c48942
+#define SHA512_224_H6 0x3f9d85a86a1d36c8
+#define SHA512_224_H7 0x1112e6ad91d692a1
+
 #endif /* IMB_CONSTANTS_H_ */
@@ -27,6 +27,7 @@
 
 #include <stdlib.h>
 #include <stdint.h>
+#include <emmintrin.h>
 
 #include "intel-ipsec-mb.h"
 #include "des.h"
@@ -141,3 +142,161 @@ int des_key_schedule(uint64_t *ks, const void *key)
 
         return 0;
 }
+
+/* number of keys scheduled together by des_key_schedule_mb() */
+#define DES_KEY_MB_LANES 16
+
+/**
+ * @brief Bit slices 16 DES keys
+ *
+ * @param slices bit \a k of slices[m] is bit \a m (FIPS46-3 numbering
+ *               from 0) of key \a k
+ * @param keys array of 16 pointers to 8 byte DES keys
+ */
+static void
+des_key_mb_slice(uint16_t slices[64], const void *const *keys)
+{
+        DECLARE_ALIGNED(uint8_t kb[8][DES_KEY_MB_LANES], 16);
+        int k, b, i;
+
+        for (k = 0; k < DES_KEY_MB_LANES; k++)
+                for (b = 0; b < 8; b++)
+                        kb[b][k] = ((const uint8_t *) keys[k])[b];
+
+        for (b = 0; b < 8; b++) {
+                __m128i v = _mm_load_si128((const __m128i *) kb[b]);
+
+                /* FIPS46-3 bit numbers start from MSB of the byte */
+                for (i = 0; i < 8; i++) {
+                        slices[(b * 8) + i] = (uint16_t) _mm_movemask_epi8(v);
+                        v = _mm_add_epi8(v, v);
+                }
+        }
+}
+
+/**
+ * @brief Expands bit slice into bytes
+ *
+ * @param slice bit slice of 16 keys
+ *
+ * @return byte \a k is 0xff if bit \a k of \a slice is set, 0 otherwise
+ */
+__forceinline
+__m128i des_key_mb_unslice(const uint16_t slice)
+{
+        const uint64_t bcast = UINT64_C(0x0101010101010101);
+        const __m128i bit_sel = _mm_set1_epi64x(INT64_C(0x8040201008040201));
+        const __m128i x = _mm_set_epi64x((int64_t) ((slice >> 8) * bcast),
+                                         (int64_t) ((slice & 0xff) * bcast));
+
+        return _mm_cmpeq_epi8(_mm_and_si128(x, bit_sel), bit_sel);
+}
+
+/**
+ * @brief Schedules 16 DES keys
+ *
+ * The whole key schedule is a fixed permutation of key bits. Once the keys
+ * are bit sliced, PC1, rotations and PC2 are done by picking slices (for
+ * all keys at once) and key schedules are put back together from slices.
+ *
+ * @param ks array of pointers to key schedules
+ * @param keys array of 16 pointers to keys
+ * @param num_keys number of key schedules to store (up to 16)
+ */
+static void
+des_key_schedule_x16(uint64_t *const *ks, const void *const *keys,
+                     const unsigned num_keys)
+{
+        uint16_t slices[64];
+        uint16_t c[28], d[28];
+        unsigned rot = 0;
+        int n, i, g;
+
+        des_key_mb_slice(slices, keys);
+
+        /* PC1 */
+        for (i = 0; i < 28; i++) {
+                c[i] = slices[pc1c_table_fips46_3[i] - 1];
+                d[i] = slices[pc1d_table_fips46_3[i] - 1];
+        }
+
+        /* KS rounds */
+        for (n = 0; n < 16; n++) {
+                __m128i v[8], t[8];
+
+                rot += shift_tab_fips46_3[n];
+
+                /*
+                 * Rotated C & D + PC2, with 6 bits per byte:
+                 * byte k of v[g] is byte g of the round key of key k
+                 */
+                for (g = 0; g < 8; g++) {
+                        v[g] = _mm_setzero_si128();
+
+                        for (i = 0; i < 6; i++) {
+                                const unsigned p =
+                                        pc2_table_fips46_3[(g * 6) + i] - 1;
+                                const uint16_t slice = (p < 28) ?
+                                        c[(p + rot) % 28] :
+                                        d[(p - 28 + rot) % 28];
+                                const __m128i m = des_key_mb_unslice(slice);
+
+                                v[g] = _mm_or_si128(v[g],
+                                                    _mm_and_si128(m,
+                                                    _mm_set1_epi8(1 << i)));
+                        }
+                }
+
+                /* transpose 8 x 16 bytes into 16 round keys */
+                for (g = 0; g < 8; g += 2) {
+                        t[g] = _mm_unpacklo_epi8(v[g], v[g + 1]);
+                        t[g + 1] = _mm_unpackhi_epi8(v[g], v[g + 1]);
+                }
+                for (g = 0; g < 8; g += 4) {
+                        v[g] = _mm_unpacklo_epi16(t[g], t[g + 2]);
+                        v[g + 1] = _mm_unpackhi_epi16(t[g], t[g + 2]);
+                        v[g + 2] = _mm_unpacklo_epi16(t[g + 1], t[g + 3]);
+                        v[g + 3] = _mm_unpackhi_epi16(t[g + 1], t[g + 3]);
+                }
+                for (g = 0; g < 4; g++) {
+                        t[2 * g] = _mm_unpacklo_epi32(v[g], v[g + 4]);
+                        t[(2 * g) + 1] = _mm_unpackhi_epi32(v[g], v[g + 4]);
+                }
+
+                /* t[i] holds round keys of keys 2 x i and 2 x i + 1 */
+                for (i = 0; i < (int) num_keys; i++) {
+                        const __m128i rk = (i & 1) ?
+                                _mm_unpackhi_epi64(t[i / 2], t[i / 2]) :
+                                t[i / 2];
+
+                        _mm_storel_epi64((__m128i *) &ks[i][n], rk);
+                }
+        }
+}
+
+int des_key_schedule_mb(uint64_t *const *ks, const void *const *keys,
+                        const uint32_t num_keys)
+{
+        const void *lane_keys[DES_KEY_MB_LANES];
+        uint32_t i, n;
+
+        if (num_keys != 0 && (keys == NULL || ks == NULL))
+                return -1;
+
+        for (i = 0; i < num_keys; i++)
+                if (keys[i] == NULL || ks[i] == NULL)
+                        return -1;
+
+        for (n = 0; n < num_keys; n += DES_KEY_MB_LANES) {
+                const uint32_t lanes = ((num_keys - n) < DES_KEY_MB_LANES) ?
+                        (num_keys - n) : DES_KEY_MB_LANES;
+
+                /* unused lanes work on the first key again */
+                for (i = 0; i < DES_KEY_MB_LANES; i++)
+                        lane_keys[i] = keys[n + ((i < lanes) ? i : 0)];
+
+                des_key_schedule_x16(&ks[n], lane_keys, lanes);
+        }
+
+        return 0;
+}
@@ -0,0 +1,368 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * Constant time bitsliced AES encryption of 8 blocks with SSSE3
+ * (see "Faster and Timing-Attack Resistant AES-GCM", Kasper & Schwabe).
+ *
+ * Eight blocks are kept as eight 128-bit bit planes:
+ * bit k of byte j of plane i is bit i of byte j of block k.
+ * ShiftRows and the row rotations of MixColumns are then byte shuffles
+ * applied to each plane and SubBytes is a boolean circuit (Boyar & Peralta)
+ * evaluated on the planes. There are no table look-ups and no data
+ * dependent branches.
+ */
+
+#ifndef AES_BITSLICE_H
+#define AES_BITSLICE_H
+
+#include <stdint.h>
+#include <immintrin.h>
+
+#include "intel-ipsec-mb.h"
+
+/* number of blocks processed in parallel */
+#define AES_BS_BLOCKS 8
+
+/* rounds for the largest (256-bit) key */
+#define AES_BS_MAX_ROUNDS 14
+
+/* swaps bits of a selected by m << n with bits of b selected by m */
+__forceinline void
+aes_bs_swapmove(__m128i *a, __m128i *b, const int n, const __m128i m)
+{
+        const __m128i t = _mm_and_si128(_mm_xor_si128(_mm_srli_epi64(*a, n),
+                                                      *b), m);
+
+        *b = _mm_xor_si128(*b, t);
+        *a = _mm_xor_si128(*a, _mm_slli_epi64(t, n));
+}
+
+/*
+ * Transposes 8 x 8 bit matrices made of byte j of x[0] to x[7].
+ * Converts 8 blocks into bit planes and back.
+ */
+__forceinline void
+aes_bs_transpose(__m128i x[8])
+{
+        const __m128i m1 = _mm_set1_epi8(0x55);
+        const __m128i m2 = _mm_set1_epi8(0x33);
+        const __m128i m4 = _mm_set1_epi8(0x0f);
+
+        aes_bs_swapmove(&x[0], &x[1], 1, m1);
+        aes_bs_swapmove(&x[2], &x[3], 1, m1);
+        aes_bs_swapmove(&x[4], &x[5], 1, m1);
+        aes_bs_swapmove(&x[6], &x[7], 1, m1);
+
+        aes_bs_swapmove(&x[0], &x[2], 2, m2);
+        aes_bs_swapmove(&x[1], &x[3], 2, m2);
+        aes_bs_swapmove(&x[4], &x[6], 2, m2);
+        aes_bs_swapmove(&x[5], &x[7], 2, m2);
+
+        aes_bs_swapmove(&x[0], &x[4], 4, m4);
+        aes_bs_swapmove(&x[1], &x[5], 4, m4);
+        aes_bs_swapmove(&x[2], &x[6], 4, m4);
+        aes_bs_swapmove(&x[3], &x[7], 4, m4);
+}
+
+/*
+ * Expands round keys into bit planes (each key byte is the same
+ * for all 8 blocks)
+ */
+__forceinline void
+aes_bs_key_expand(__m128i (*bs_keys)[8], const void *keys,
+                  const unsigned nrounds)
+{
+        const __m128i *k = (const __m128i *) keys;
+        unsigned r, i;
+
+        for (r = 0; r <= nrounds; r++) {
+                const __m128i key = _mm_loadu_si128(&k[r]);
+
+                for (i = 0; i < 8; i++) {
+                        const __m128i bit = _mm_set1_epi8((char) (1 << i));
+
+                        bs_keys[r][i] =
+                                _mm_cmpeq_epi8(_mm_and_si128(key, bit), bit);
+                }
+        }
+}
+
+/* SubBytes on bit planes (bit plane 0 holds the least significant bits) */
+__forceinline void
+aes_bs_sbox(__m128i q[8])
+{
+        const __m128i ones = _mm_set1_epi32(-1);
+        __m128i x0, x1, x2, x3, x4, x5, x6, x7;
+        __m128i y1, y2, y3, y4, y5, y6, y7, y8, y9, y10;
+        __m128i y11, y12, y13, y14, y15, y16, y17, y18, y19, y20, y21;
+        __m128i z0, z1, z2, z3, z4, z5, z6, z7, z8, z9;
+        __m128i z10, z11, z12, z13, z14, z15, z16, z17;
+        __m128i t0, t1, t2, t3, t4, t5, t6, t7, t8, t9;
+        __m128i t10, t11, t12, t13, t14, t15, t16, t17, t18, t19;
+        __m128i t20, t21, t22, t23, t24, t25, t26, t27, t28, t29;
+        __m128i t30, t31, t32, t33, t34, t35, t36, t37, t38, t39;
+        __m128i t40, t41, t42, t43, t44, t45, t46, t47, t48, t49;
+        __m128i t50, t51, t52, t53, t54, t55, t56, t57, t58, t59;
+        __m128i t60, t61, t62, t63, t64, t65, t66, t67;
+        __m128i s0, s1, s2, s3, s4, s5, s6, s7;
+
+#define XOR(a, b) _mm_xor_si128(a, b)
+#define AND(a, b) _mm_and_si128(a, b)
+#define XNOR(a, b) _mm_xor_si128(_mm_xor_si128(a, b), ones)
+
+        x0 = q[7];
+        x1 = q[6];
+        x2 = q[5];
+        x3 = q[4];
+        x4 = q[3];
+        x5 = q[2];
+        x6 = q[1];
+        x7 = q[0];
+
+        /* top linear transformation */
+        y14 = XOR(x3, x5);
+        y13 = XOR(x0, x6);
+        y9 = XOR(x0, x3);
+        y8 = XOR(x0, x5);
+        t0 = XOR(x1, x2);
+        y1 = XOR(t0, x7);
+        y4 = XOR(y1, x3);
+        y12 = XOR(y13, y14);
+        y2 = XOR(y1, x0);
+        y5 = XOR(y1, x6);
+        y3 = XOR(y5, y8);
+        t1 = XOR(x4, y12);
+        y15 = XOR(t1, x5);
+        y20 = XOR(t1, x1);
+        y6 = XOR(y15, x7);
+        y10 = XOR(y15, t0);
+        y11 = XOR(y20, y9);
+        y7 = XOR(x7, y11);
+        y17 = XOR(y10, y11);
+        y19 = XOR(y10, y8);
+        y16 = XOR(t0, y11);
+        y21 = XOR(y13, y16);
+        y18 = XOR(x0, y16);
+
+        /* non-linear section */
+        t2 = AND(y12, y15);
+        t3 = AND(y3, y6);
+        t4 = XOR(t3, t2);
+        t5 = AND(y4, x7);
+        t6 = XOR(t5, t2);
+        t7 = AND(y13, y16);
+        t8 = AND(y5, y1);
+        t9 = XOR(t8, t7);
+        t10 = AND(y2, y7);
+        t11 = XOR(t10, t7);
+        t12 = AND(y9, y11);
+        t13 = AND(y14, y17);
+        t14 = XOR(t13, t12);
+        t15 = AND(y8, y10);
+        t16 = XOR(t15, t12);
+        t17 = XOR(t4, t14);
+        t18 = XOR(t6, t16);
+        t19 = XOR(t9, t14);
+        t20 = XOR(t11, t16);
+        t21 = XOR(t17, y20);
+        t22 = XOR(t18, y19);
+        t23 = XOR(t19, y21);
+        t24 = XOR(t20, y18);
+
+        t25 = XOR(t21, t22);
+        t26 = AND(t21, t23);
+        t27 = XOR(t24, t26);
+        t28 = AND(t25, t27);
+        t29 = XOR(t28, t22);
+        t30 = XOR(t23, t24);
+        t31 = XOR(t22, t26);
+        t32 = AND(t31, t30);
+        t33 = XOR(t32, t24);
+        t34 = XOR(t23, t33);
+        t35 = XOR(t27, t33);
+        t36 = AND(t24, t35);
+        t37 = XOR(t36, t34);
+        t38 = XOR(t27, t36);
+        t39 = AND(t29, t38);
+        t40 = XOR(t25, t39);
+
+        t41 = XOR(t40, t37);
+        t42 = XOR(t29, t33);
+        t43 = XOR(t29, t40);
+        t44 = XOR(t33, t37);
+        t45 = XOR(t42, t41);
+        z0 = AND(t44, y15);
+        z1 = AND(t37, y6);
+        z2 = AND(t33, x7);
+        z3 = AND(t43, y16);
+        z4 = AND(t40, y1);
+        z5 = AND(t29, y7);
+        z6 = AND(t42, y11);
+        z7 = AND(t45, y17);
+        z8 = AND(t41, y10);
+        z9 = AND(t44, y12);
+        z10 = AND(t37, y3);
+        z11 = AND(t33, y4);
+        z12 = AND(t43, y13);
+        z13 = AND(t40, y5);
+        z14 = AND(t29, y2);
+        z15 = AND(t42, y9);
+        z16 = AND(t45, y14);
+        z17 = AND(t41, y8);
+
+        /* bottom linear transformation */
+        t46 = XOR(z15, z16);
+        t47 = XOR(z10, z11);
+        t48 = XOR(z5, z13);
+        t49 = XOR(z9, z10);
+        t50 = XOR(z2, z12);
+        t51 = XOR(z2, z5);
+        t52 = XOR(z7, z8);
+        t53 = XOR(z0, z3);
+        t54 = XOR(z6, z7);
+        t55 = XOR(z16, z17);
+        t56 = XOR(z12, t48);
+        t57 = XOR(t50, t53);
+        t58 = XOR(z4, t46);
+        t59 = XOR(z3, t54);
+        t60 = XOR(t46, t57);
+        t61 = XOR(z14, t57);
+        t62 = XOR(t52, t58);
+        t63 = XOR(t49, t58);
+        t64 = XOR(z4, t59);
+        t65 = XOR(t61, t62);
+        t66 = XOR(z1, t63);
+        s0 = XOR(t59, t63);
+        s6 = XNOR(t56, t62);
+        s7 = XNOR(t48, t60);
+        t67 = XOR(t64, t65);
+        s3 = XOR(t53, t66);
+        s4 = XOR(t51, t66);
+        s5 = XOR(t47, t65);
+        s1 = XNOR(t64, s3);
+        s2 = XNOR(t55, t67);
+
+        q[7] = s0;
+        q[6] = s1;
+        q[5] = s2;
+        q[4] = s3;
+        q[3] = s4;
+        q[2] = s5;
+        q[1] = s6;
+        q[0] = s7;
+
+#undef XOR
+#undef AND
+#undef XNOR
+}
+
+__forceinline void
+aes_bs_shift_rows(__m128i q[8])
+{
+        const __m128i sr = _mm_set_epi8(11, 6, 1, 12, 7, 2, 13, 8,
+                                        3, 14, 9, 4, 15, 10, 5, 0);
+        int i;
+
+        for (i = 0; i < 8; i++)
+                q[i] = _mm_shuffle_epi8(q[i], sr);
+}
+
+/*
+ * MixColumns on bit planes:
+ * b(r) = 2 * (a(r) ^ a(r + 1)) ^ (a(r) ^ a(r + 1)) ^
+ *        (a(r + 2) ^ a(r + 3)) ^ a(r)
+ */
+__forceinline void
+aes_bs_mix_columns(__m128i q[8])
+{
+        /* byte (4 x c + r) <= byte (4 x c + ((r + 1) mod 4)) */
+        const __m128i rot1 = _mm_set_epi8(12, 15, 14, 13, 8, 11, 10, 9,
+                                          4, 7, 6, 5, 0, 3, 2, 1);
+        /* byte (4 x c + r) <= byte (4 x c + ((r + 2) mod 4)) */
+        const __m128i rot2 = _mm_set_epi8(13, 12, 15, 14, 9, 8, 11, 10,
+                                          5, 4, 7, 6, 1, 0, 3, 2);
+        __m128i t[8];
+        int i;
+
+        for (i = 0; i < 8; i++)
+                t[i] = _mm_xor_si128(q[i], _mm_shuffle_epi8(q[i], rot1));
+
+        /* q ^= t ^ rot2(t) */
+        for (i = 0; i < 8; i++)
+                q[i] = _mm_xor_si128(q[i],
+                                     _mm_xor_si128(t[i],
+                                                   _mm_shuffle_epi8(t[i],
+                                                                    rot2)));
+
+        /* q ^= 2 * t (reduced by x^8 + x^4 + x^3 + x + 1) */
+        q[0] = _mm_xor_si128(q[0], t[7]);
+        q[1] = _mm_xor_si128(q[1], _mm_xor_si128(t[0], t[7]));
+        q[2] = _mm_xor_si128(q[2], t[1]);
+        q[3] = _mm_xor_si128(q[3], _mm_xor_si128(t[2], t[7]));
+        q[4] = _mm_xor_si128(q[4], _mm_xor_si128(t[3], t[7]));
+        q[5] = _mm_xor_si128(q[5], t[4]);
+        q[6] = _mm_xor_si128(q[6], t[5]);
+        q[7] = _mm_xor_si128(q[7], t[6]);
+}
+
+__forceinline void
+aes_bs_add_round_key(__m128i q[8], const __m128i bs_key[8])
+{
+        int i;
+
+        for (i = 0; i < 8; i++)
+                q[i] = _mm_xor_si128(q[i], bs_key[i]);
+}
+
+/*
+ * Encrypts 8 blocks in place.
+ * Round keys come from aes_bs_key_expand().
+ */
+__forceinline void
+aes_bs_encrypt_x8(__m128i blocks[8], const __m128i (*bs_keys)[8],
+                  const unsigned nrounds)
+{
+        unsigned r;
+
+        aes_bs_transpose(blocks);
+        aes_bs_add_round_key(blocks, bs_keys[0]);
+
+        for (r = 1; r < nrounds; r++) {
+                aes_bs_sbox(blocks);
+                aes_bs_shift_rows(blocks);
+                aes_bs_mix_columns(blocks);
+                aes_bs_add_round_key(blocks, bs_keys[r]);
+        }
+
+        aes_bs_sbox(blocks);
+        aes_bs_shift_rows(blocks);
+        aes_bs_add_round_key(blocks, bs_keys[nrounds]);
+        aes_bs_transpose(blocks);
+}
+
+#endif /* AES_BITSLICE_H */
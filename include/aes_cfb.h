@@ -0,0 +1,81 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* AES-CFB-128 cipher mode for messages of any length */
+
+#ifndef AES_CFB_H
+#define AES_CFB_H
+
+#include <stdint.h>
+#include "intel-ipsec-mb.h"
+
+/**
+ * @brief Initializes AES-CFB encryption out of order manager
+ *
+ * @param state pointer to out of order manager
+ * @param num_lanes number of lanes of the architecture
+ */
+IMB_DLL_LOCAL void
+aes_cfb_enc_ooo_init(MB_MGR_AES_OOO *state, const unsigned num_lanes);
+
+/*
+ * Multi-buffer AES-CFB encryption out of order manager functions
+ * (one manager for each key size, as for CBC).
+ * CFB decryption processes blocks of one job in parallel.
+ */
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_aes_cfb_enc_sse(MB_MGR_AES_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_aes_cfb_enc_sse(MB_MGR_AES_OOO *state);
+IMB_DLL_LOCAL JOB_AES_HMAC *submit_job_aes_cfb_dec_sse(JOB_AES_HMAC *job);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_aes_cfb_enc_sse_no_aesni(MB_MGR_AES_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_aes_cfb_enc_sse_no_aesni(MB_MGR_AES_OOO *state);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_aes_cfb_dec_sse_no_aesni(JOB_AES_HMAC *job);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_aes_cfb_enc_avx(MB_MGR_AES_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_aes_cfb_enc_avx(MB_MGR_AES_OOO *state);
+IMB_DLL_LOCAL JOB_AES_HMAC *submit_job_aes_cfb_dec_avx(JOB_AES_HMAC *job);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_aes_cfb_enc_avx2(MB_MGR_AES_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_aes_cfb_enc_avx2(MB_MGR_AES_OOO *state);
+IMB_DLL_LOCAL JOB_AES_HMAC *submit_job_aes_cfb_dec_avx2(JOB_AES_HMAC *job);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_aes_cfb_enc_avx512(MB_MGR_AES_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_aes_cfb_enc_avx512(MB_MGR_AES_OOO *state);
+IMB_DLL_LOCAL JOB_AES_HMAC *submit_job_aes_cfb_dec_avx512(JOB_AES_HMAC *job);
+
+#endif /* AES_CFB_H */
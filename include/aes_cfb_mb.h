@@ -0,0 +1,375 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * Multi-buffer AES-CFB-128 code, with #define's to build an SSE, AVX, AVX2
+ * or AVX512 version (see sse/aes_cfb_sse.c, avx/aes_cfb_avx.c, etc.)
+ *
+ * The following have to be defined before inclusion:
+ * - AES_CFB_LANES - number of encryption lanes (jobs processed together)
+ * - AES_CFB_DEC_BLOCKS - number of blocks decrypted in parallel
+ * - SUBMIT_JOB_AES_CFB_ENC, FLUSH_JOB_AES_CFB_ENC, SUBMIT_JOB_AES_CFB_DEC -
+ *   names of API functions
+ * - AES_CFB_NO_AESNI (optional) - AES-NI emulation
+ *
+ * CFB encryption is serial for a single message (each block is encrypted
+ * from the previous cipher text block), so it takes blocks from different
+ * jobs as CBC encryption does (out of order manager). CFB decryption
+ * needs only cipher text blocks, which are all known, so blocks of one
+ * job are processed in parallel.
+ *
+ * Both directions use the AES encryption key schedule and the last block
+ * can be partial (any message length).
+ */
+
+#include <string.h>
+#include <immintrin.h>
+
+#include "intel-ipsec-mb.h"
+#include "aes_cfb.h"
+#ifdef AES_CFB_NO_AESNI
+#include "aesni_emu.h"
+#endif
+
+/* AES rounds for the largest (256-bit) key */
+#define AES_CFB_MAX_ROUNDS 14
+
+#ifdef AES_CFB_NO_AESNI
+__forceinline __m128i
+aes_cfb_emulate(void (*fn)(union xmm_reg *, const union xmm_reg *),
+                const __m128i x, const __m128i k)
+{
+        union xmm_reg a, b;
+
+        _mm_storeu_si128((__m128i *) a.byte, x);
+        _mm_storeu_si128((__m128i *) b.byte, k);
+        fn(&a, &b);
+        return _mm_loadu_si128((const __m128i *) a.byte);
+}
+
+#define AES_CFB_AESENC(_x, _k)     aes_cfb_emulate(emulate_AESENC, _x, _k)
+#define AES_CFB_AESENCLAST(_x, _k) aes_cfb_emulate(emulate_AESENCLAST, _x, _k)
+#else
+#define AES_CFB_AESENC(_x, _k)     _mm_aesenc_si128(_x, _k)
+#define AES_CFB_AESENCLAST(_x, _k) _mm_aesenclast_si128(_x, _k)
+#endif
+
+/* number of AES rounds for the key length */
+__forceinline unsigned
+aes_cfb_rounds(const uint64_t key_len)
+{
+        return (unsigned) (key_len / 4) + 6;
+}
+
+/**
+ * @brief Encrypts blocks with the same key
+ *
+ * @param blk blocks to encrypt in place
+ * @param rk round keys
+ * @param nr number of rounds
+ * @param n number of blocks
+ */
+__forceinline void
+aes_cfb_enc_blocks(__m128i *blk, const __m128i *rk, const unsigned nr,
+                   const unsigned n)
+{
+        unsigned i, r;
+
+        for (i = 0; i < n; i++)
+                blk[i] = _mm_xor_si128(blk[i], rk[0]);
+        for (r = 1; r < nr; r++)
+                for (i = 0; i < n; i++)
+                        blk[i] = AES_CFB_AESENC(blk[i], rk[r]);
+        for (i = 0; i < n; i++)
+                blk[i] = AES_CFB_AESENCLAST(blk[i], rk[nr]);
+}
+
+/**
+ * @brief Encrypts blocks of different lanes together
+ *
+ * @param blk blocks to encrypt in place
+ * @param rk round keys for each block
+ * @param nr number of rounds (the same key size in all lanes)
+ * @param n number of blocks
+ */
+__forceinline void
+aes_cfb_enc_lane_blocks(__m128i *blk, const __m128i *const *rk,
+                        const unsigned nr, const unsigned n)
+{
+        unsigned i, r;
+
+        for (i = 0; i < n; i++)
+                blk[i] = _mm_xor_si128(blk[i], _mm_loadu_si128(&rk[i][0]));
+        for (r = 1; r < nr; r++)
+                for (i = 0; i < n; i++)
+                        blk[i] = AES_CFB_AESENC(blk[i],
+                                                _mm_loadu_si128(&rk[i][r]));
+        for (i = 0; i < n; i++)
+                blk[i] = AES_CFB_AESENCLAST(blk[i],
+                                            _mm_loadu_si128(&rk[i][nr]));
+}
+
+/* ========================================================================== */
+/* Encryption out of order manager */
+
+/* encrypts num_blocks full blocks in all lanes in use */
+static void
+aes_cfb_enc_lanes(MB_MGR_AES_OOO *state, const uint64_t num_blocks,
+                  const unsigned nr)
+{
+        const __m128i *rk[AES_CFB_LANES];
+        unsigned lanes[AES_CFB_LANES];
+        __m128i c[AES_CFB_LANES];
+        unsigned i, n = 0, lane;
+        uint64_t b, offset;
+
+        for (lane = 0; lane < AES_CFB_LANES; lane++) {
+                if (state->job_in_lane[lane] == NULL)
+                        continue;
+                lanes[n] = lane;
+                rk[n] = (const __m128i *) state->args.keys[lane];
+                c[n] = _mm_load_si128((const __m128i *)
+                                      &state->args.IV[lane]);
+                n++;
+        }
+
+        for (b = 0; b < num_blocks; b++) {
+                aes_cfb_enc_lane_blocks(c, rk, nr, n);
+
+                offset = b * AES_BLOCK_SIZE;
+                for (i = 0; i < n; i++) {
+                        const __m128i *in = (const __m128i *)
+                                (state->args.in[lanes[i]] + offset);
+                        __m128i *out = (__m128i *)
+                                (state->args.out[lanes[i]] + offset);
+
+                        c[i] = _mm_xor_si128(c[i], _mm_loadu_si128(in));
+                        _mm_storeu_si128(out, c[i]);
+                }
+        }
+
+        offset = num_blocks * AES_BLOCK_SIZE;
+        for (i = 0; i < n; i++) {
+                lane = lanes[i];
+                _mm_store_si128((__m128i *) &state->args.IV[lane], c[i]);
+                state->args.in[lane] += offset;
+                state->args.out[lane] += offset;
+                state->lens[lane] -= (uint16_t) offset;
+        }
+}
+
+/* encrypts the last partial block of len bytes in a lane */
+static void
+aes_cfb_enc_partial(MB_MGR_AES_OOO *state, const unsigned lane,
+                    const unsigned nr, const uint64_t len)
+{
+        const __m128i *rk = (const __m128i *) state->args.keys[lane];
+        uint8_t ks[AES_BLOCK_SIZE];
+        __m128i c = _mm_load_si128((const __m128i *) &state->args.IV[lane]);
+        uint64_t i;
+
+        aes_cfb_enc_lane_blocks(&c, &rk, nr, 1);
+        _mm_storeu_si128((__m128i *) ks, c);
+        for (i = 0; i < len; i++)
+                state->args.out[lane][i] = state->args.in[lane][i] ^ ks[i];
+        state->args.out[lane] += len;
+}
+
+/* bytes of full blocks to process in one go, lengths are 16-bit */
+__forceinline uint16_t
+aes_cfb_chunk(const uint64_t len)
+{
+        const uint64_t full = len & ~((uint64_t) AES_BLOCK_SIZE - 1);
+
+        return (uint16_t) ((full < 0xfff0) ? full : 0xfff0);
+}
+
+/* processes lanes in use until one job is complete */
+static JOB_AES_HMAC *
+aes_cfb_enc_process(MB_MGR_AES_OOO *state)
+{
+        for (;;) {
+                uint16_t min_len = UINT16_MAX;
+                unsigned nr = 0, lane;
+
+                for (lane = 0; lane < AES_CFB_LANES; lane++) {
+                        JOB_AES_HMAC *job = state->job_in_lane[lane];
+
+                        if (job == NULL)
+                                continue;
+                        nr = aes_cfb_rounds(job->aes_key_len_in_bytes);
+                        if (state->lens[lane] == 0) {
+                                const uint64_t left =
+                                        job->msg_len_to_cipher_in_bytes -
+                                        (uint64_t) (state->args.out[lane] -
+                                                    job->dst);
+
+                                if (left < AES_BLOCK_SIZE) {
+                                        if (left != 0)
+                                                aes_cfb_enc_partial(state,
+                                                                    lane, nr,
+                                                                    left);
+                                        state->job_in_lane[lane] = NULL;
+                                        state->unused_lanes =
+                                                (state->unused_lanes << 4) |
+                                                lane;
+                                        job->status |= STS_COMPLETED_AES;
+                                        return job;
+                                }
+                                state->lens[lane] = aes_cfb_chunk(left);
+                        }
+                        if (state->lens[lane] < min_len)
+                                min_len = state->lens[lane];
+                }
+
+                aes_cfb_enc_lanes(state, min_len / AES_BLOCK_SIZE, nr);
+        }
+}
+
+JOB_AES_HMAC *
+SUBMIT_JOB_AES_CFB_ENC(MB_MGR_AES_OOO *state, JOB_AES_HMAC *job)
+{
+        const unsigned lane = (unsigned) (state->unused_lanes & 15);
+
+        state->unused_lanes >>= 4;
+        state->job_in_lane[lane] = job;
+        state->args.in[lane] = job->src + job->cipher_start_src_offset_in_bytes;
+        state->args.out[lane] = job->dst;
+        state->args.keys[lane] = (const uint32_t *) job->aes_enc_key_expanded;
+        memcpy(&state->args.IV[lane], job->iv, AES_BLOCK_SIZE);
+        state->lens[lane] = aes_cfb_chunk(job->msg_len_to_cipher_in_bytes);
+
+        /* the last nibble is the flag */
+        if (state->unused_lanes != 0xF)
+                return NULL;
+
+        return aes_cfb_enc_process(state);
+}
+
+JOB_AES_HMAC *
+FLUSH_JOB_AES_CFB_ENC(MB_MGR_AES_OOO *state)
+{
+        unsigned lane;
+
+        for (lane = 0; lane < AES_CFB_LANES; lane++)
+                if (state->job_in_lane[lane] != NULL)
+                        return aes_cfb_enc_process(state);
+
+        return NULL;
+}
+
+/* ========================================================================== */
+/* Decryption */
+
+/*
+ * Decrypts n blocks (the last one can be partial, len bytes in total):
+ * the key stream is made from the previous cipher text block prev and
+ * the first n - 1 cipher text blocks. Returns the last cipher text block.
+ */
+__forceinline __m128i
+aes_cfb_dec_blocks(const __m128i *rk, const unsigned nr, const __m128i prev,
+                   const uint8_t *in, uint8_t *out, const unsigned n,
+                   const uint64_t len)
+{
+        __m128i ct[AES_CFB_DEC_BLOCKS], ks[AES_CFB_DEC_BLOCKS];
+        unsigned i;
+
+        /* all cipher text is loaded first for in-place operation */
+        if (len == (uint64_t) n * AES_BLOCK_SIZE) {
+                for (i = 0; i < n; i++)
+                        ct[i] = _mm_loadu_si128((const __m128i *)
+                                                (in + i * AES_BLOCK_SIZE));
+        } else {
+                DECLARE_ALIGNED(uint8_t buf[AES_CFB_DEC_BLOCKS *
+                                            AES_BLOCK_SIZE], 16);
+
+                memset(buf, 0, sizeof(buf));
+                memcpy(buf, in, len);
+                for (i = 0; i < n; i++)
+                        ct[i] = _mm_load_si128((const __m128i *)
+                                               (buf + i * AES_BLOCK_SIZE));
+        }
+
+        ks[0] = prev;
+        for (i = 1; i < n; i++)
+                ks[i] = ct[i - 1];
+
+        aes_cfb_enc_blocks(ks, rk, nr, n);
+
+        if (len == (uint64_t) n * AES_BLOCK_SIZE) {
+                for (i = 0; i < n; i++)
+                        _mm_storeu_si128((__m128i *) (out +
+                                                      i * AES_BLOCK_SIZE),
+                                         _mm_xor_si128(ks[i], ct[i]));
+        } else {
+                DECLARE_ALIGNED(uint8_t buf[AES_CFB_DEC_BLOCKS *
+                                            AES_BLOCK_SIZE], 16);
+
+                for (i = 0; i < n; i++)
+                        _mm_store_si128((__m128i *) (buf +
+                                                     i * AES_BLOCK_SIZE),
+                                        _mm_xor_si128(ks[i], ct[i]));
+                memcpy(out, buf, len);
+        }
+
+        return ct[n - 1];
+}
+
+JOB_AES_HMAC *
+SUBMIT_JOB_AES_CFB_DEC(JOB_AES_HMAC *job)
+{
+        const unsigned nr = aes_cfb_rounds(job->aes_key_len_in_bytes);
+        const __m128i *keys = (const __m128i *) job->aes_enc_key_expanded;
+        const uint8_t *in = job->src + job->cipher_start_src_offset_in_bytes;
+        uint8_t *out = job->dst;
+        uint64_t len = job->msg_len_to_cipher_in_bytes;
+        __m128i rk[AES_CFB_MAX_ROUNDS + 1];
+        __m128i prev = _mm_loadu_si128((const __m128i *) job->iv);
+        unsigned i;
+
+        for (i = 0; i <= nr; i++)
+                rk[i] = _mm_loadu_si128(&keys[i]);
+
+        while (len >= AES_CFB_DEC_BLOCKS * AES_BLOCK_SIZE) {
+                prev = aes_cfb_dec_blocks(rk, nr, prev, in, out,
+                                          AES_CFB_DEC_BLOCKS,
+                                          AES_CFB_DEC_BLOCKS *
+                                          AES_BLOCK_SIZE);
+                in += AES_CFB_DEC_BLOCKS * AES_BLOCK_SIZE;
+                out += AES_CFB_DEC_BLOCKS * AES_BLOCK_SIZE;
+                len -= AES_CFB_DEC_BLOCKS * AES_BLOCK_SIZE;
+        }
+
+        if (len != 0)
+                (void) aes_cfb_dec_blocks(rk, nr, prev, in, out,
+                                          (unsigned) ((len + AES_BLOCK_SIZE -
+                                                       1) / AES_BLOCK_SIZE),
+                                          len);
+
+        job->status |= STS_COMPLETED_AES;
+        return job;
+}
@@ -0,0 +1,205 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * Multi-key AES-GCM key pre-processing, with #define's to build an SSE,
+ * AVX, AVX2 or AVX512 version (see sse/aes_gcm_pre_mb_sse.c, etc.)
+ *
+ * The following have to be defined before inclusion:
+ * - GCM_PRE_MB_LANES - number of keys processed together
+ * - GCM_PRE_128_MB, GCM_PRE_192_MB, GCM_PRE_256_MB - names of API functions
+ * - AES_KEYEXP_128_MB, AES_KEYEXP_192_MB, AES_KEYEXP_256_MB - multi-key
+ *   AES key expansion functions
+ * - GCM_PRE_MB_NO_AESNI (optional) - AES-NI emulation
+ *
+ * Computing the hash key is a chain of dependent AES rounds and computing
+ * its powers is a chain of dependent GHASH multiplications. Here the chains
+ * of several independent keys are interleaved to keep the execution units
+ * busy. The key data is the same as aes_gcm_pre_128_sse() etc. produce,
+ * so it can be used with any GCM implementation of the library.
+ */
+
+#include <stddef.h>
+#include <immintrin.h>
+
+#include "intel-ipsec-mb.h"
+#include "gcm.h"
+#include "ghash_clmul.h"
+#ifdef GCM_PRE_MB_NO_AESNI
+#include "aesni_emu.h"
+#endif
+
+#ifdef GCM_PRE_MB_NO_AESNI
+__forceinline __m128i
+gcm_pre_mb_emulate(void (*fn)(union xmm_reg *, const union xmm_reg *),
+                   const __m128i x, const __m128i k)
+{
+        union xmm_reg a, b;
+
+        _mm_storeu_si128((__m128i *) a.byte, x);
+        _mm_storeu_si128((__m128i *) b.byte, k);
+        fn(&a, &b);
+        return _mm_loadu_si128((const __m128i *) a.byte);
+}
+
+#define GCM_PRE_MB_AESENC(_x, _k)     gcm_pre_mb_emulate(emulate_AESENC, _x, _k)
+#define GCM_PRE_MB_AESENCLAST(_x, _k)                           \
+        gcm_pre_mb_emulate(emulate_AESENCLAST, _x, _k)
+#else
+#define GCM_PRE_MB_AESENC(_x, _k)     _mm_aesenc_si128(_x, _k)
+#define GCM_PRE_MB_AESENCLAST(_x, _k) _mm_aesenclast_si128(_x, _k)
+#endif
+
+/* multi-key AES key expansion API */
+typedef void (*gcm_pre_mb_keyexp_t)(const void *const *, void *const *,
+                                    void *const *, const uint32_t);
+
+/* computes HashKey<<1 mod poly from the byte reflected HashKey */
+__forceinline __m128i
+gcm_pre_mb_shl1(const __m128i h)
+{
+        /* bits shifted out of the 64-bit halves */
+        const __m128i c = _mm_srli_epi64(h, 63);
+        const __m128i r = _mm_or_si128(_mm_slli_epi64(h, 1),
+                                       _mm_slli_si128(c, 8));
+        /* all ones if bit 127 was set */
+        const __m128i m = _mm_sub_epi64(_mm_setzero_si128(),
+                                        _mm_shuffle_epi32(c, 0xee));
+        const __m128i poly = _mm_set_epi64x((int64_t) 0xC200000000000000ULL, 1);
+
+        return _mm_xor_si128(r, _mm_and_si128(m, poly));
+}
+
+/* stores HashKey^i<<1 mod poly and XOR of its halves (for Karatsuba) */
+__forceinline void
+gcm_pre_mb_store(struct gcm_key_data *key_data, const unsigned i,
+                 const __m128i hk)
+{
+        uint8_t *p = (uint8_t *) key_data;
+        const __m128i k = _mm_xor_si128(hk, _mm_shuffle_epi32(hk, 0x4e));
+
+        /* shifted_hkey_8 to _1 are stored in reverse order */
+        _mm_storeu_si128((__m128i *)
+                         &p[offsetof(struct gcm_key_data, shifted_hkey_1) -
+                            (i - 1) * GCM_ENC_KEY_LEN], hk);
+        _mm_storeu_si128((__m128i *)
+                         &p[offsetof(struct gcm_key_data, shifted_hkey_1_k) +
+                            (i - 1) * GCM_ENC_KEY_LEN], k);
+}
+
+/*
+ * Computes the hash key powers of GCM_PRE_MB_LANES keys with expanded
+ * keys in place; only the first num_keys are stored
+ */
+__forceinline void
+gcm_pre_mb_lanes(struct gcm_key_data *const *key_data,
+                 const unsigned num_keys, const unsigned nr)
+{
+        __m128i h[GCM_PRE_MB_LANES], hk[GCM_PRE_MB_LANES];
+        unsigned i, l;
+
+        /* HashKey = E(K, 0^128) */
+        for (l = 0; l < GCM_PRE_MB_LANES; l++)
+                h[l] = _mm_loadu_si128((const __m128i *)
+                                       key_data[l]->expanded_keys);
+        for (i = 1; i < nr; i++)
+                for (l = 0; l < GCM_PRE_MB_LANES; l++) {
+                        const __m128i *rk = (const __m128i *)
+                                key_data[l]->expanded_keys;
+
+                        h[l] = GCM_PRE_MB_AESENC(h[l],
+                                                 _mm_loadu_si128(&rk[i]));
+                }
+        for (l = 0; l < GCM_PRE_MB_LANES; l++) {
+                const __m128i *rk = (const __m128i *)
+                        key_data[l]->expanded_keys;
+
+                h[l] = GCM_PRE_MB_AESENCLAST(h[l], _mm_loadu_si128(&rk[nr]));
+                h[l] = ghash_bswap(h[l]);
+                hk[l] = gcm_pre_mb_shl1(h[l]);
+        }
+
+        for (l = 0; l < num_keys; l++)
+                gcm_pre_mb_store(key_data[l], 1, hk[l]);
+
+        /* HashKey^i<<1 mod poly = HashKey^(i-1)<<1 mod poly * HashKey */
+        for (i = 2; i <= 8; i++) {
+                for (l = 0; l < GCM_PRE_MB_LANES; l++)
+                        hk[l] = ghash_clmul_mul(hk[l], h[l]);
+                for (l = 0; l < num_keys; l++)
+                        gcm_pre_mb_store(key_data[l], i, hk[l]);
+        }
+}
+
+__forceinline void
+gcm_pre_mb(const void *const *keys, struct gcm_key_data *const *key_data,
+           const uint32_t num_keys, const unsigned nr,
+           const gcm_pre_mb_keyexp_t keyexp)
+{
+        struct gcm_key_data *kd[GCM_PRE_MB_LANES];
+        void *enc[GCM_PRE_MB_LANES];
+        uint32_t n;
+        unsigned l;
+
+        if (keys == NULL || key_data == NULL)
+                return;
+
+        for (n = 0; n < num_keys; n += GCM_PRE_MB_LANES) {
+                const unsigned lanes = ((num_keys - n) < GCM_PRE_MB_LANES) ?
+                        (num_keys - n) : GCM_PRE_MB_LANES;
+
+                /* unused lanes work on the first key again */
+                for (l = 0; l < GCM_PRE_MB_LANES; l++) {
+                        kd[l] = key_data[n + ((l < lanes) ? l : 0)];
+                        enc[l] = kd[l]->expanded_keys;
+                }
+
+                keyexp(&keys[n], enc, NULL, lanes);
+                gcm_pre_mb_lanes(kd, lanes, nr);
+        }
+}
+
+void
+GCM_PRE_128_MB(const void *const *keys, struct gcm_key_data *const *key_data,
+               const uint32_t num_keys)
+{
+        gcm_pre_mb(keys, key_data, num_keys, 10, AES_KEYEXP_128_MB);
+}
+
+void
+GCM_PRE_192_MB(const void *const *keys, struct gcm_key_data *const *key_data,
+               const uint32_t num_keys)
+{
+        gcm_pre_mb(keys, key_data, num_keys, 12, AES_KEYEXP_192_MB);
+}
+
+void
+GCM_PRE_256_MB(const void *const *keys, struct gcm_key_data *const *key_data,
+               const uint32_t num_keys)
+{
+        gcm_pre_mb(keys, key_data, num_keys, 14, AES_KEYEXP_256_MB);
+}
@@ -0,0 +1,91 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* AES-GCM-SIV nonce misuse resistant AEAD (RFC 8452) */
+
+#ifndef AES_GCM_SIV_H
+#define AES_GCM_SIV_H
+
+#include <stdint.h>
+#include "intel-ipsec-mb.h"
+
+#define AES_GCM_SIV_TAG_LEN   16
+#define AES_GCM_SIV_NONCE_LEN 12
+
+/**
+ * @brief Initializes AES-GCM-SIV out of order manager
+ *
+ * @param state pointer to out of order manager
+ */
+IMB_DLL_LOCAL void
+aes_gcm_siv_ooo_init(MB_MGR_AES_GCM_SIV_OOO *state);
+
+/**
+ * @brief POLYVAL multiplication without PCLMULQDQ
+ *
+ * Computes x * h * x^-128 in GF(2^128) with polynomial
+ * x^128 + x^127 + x^126 + x^121 + 1.
+ * Blocks are 128-bit little endian numbers stored as 2 64-bit words.
+ *
+ * @param x first factor and result
+ * @param h second factor
+ */
+IMB_DLL_LOCAL void
+aes_gcm_siv_polyval_mul(uint64_t x[2], const uint64_t h[2]);
+
+/*
+ * Multi-buffer AES-GCM-SIV out of order manager functions.
+ * The same manager encrypts and decrypts.
+ */
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_aes_gcm_siv_sse(MB_MGR_AES_GCM_SIV_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_aes_gcm_siv_sse(MB_MGR_AES_GCM_SIV_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_aes_gcm_siv_sse_no_aesni(MB_MGR_AES_GCM_SIV_OOO *state,
+                                    JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_aes_gcm_siv_sse_no_aesni(MB_MGR_AES_GCM_SIV_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_aes_gcm_siv_avx(MB_MGR_AES_GCM_SIV_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_aes_gcm_siv_avx(MB_MGR_AES_GCM_SIV_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_aes_gcm_siv_avx2(MB_MGR_AES_GCM_SIV_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_aes_gcm_siv_avx2(MB_MGR_AES_GCM_SIV_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_aes_gcm_siv_avx512(MB_MGR_AES_GCM_SIV_OOO *state,
+                              JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_aes_gcm_siv_avx512(MB_MGR_AES_GCM_SIV_OOO *state);
+
+#endif /* AES_GCM_SIV_H */
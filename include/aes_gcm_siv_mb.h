@@ -0,0 +1,521 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * Multi-buffer AES-GCM-SIV (RFC 8452) code, with #define's to build
+ * an SSE, AVX, AVX2 or AVX512 version (see sse/aes_gcm_siv_sse.c,
+ * avx/aes_gcm_siv_avx.c, etc.)
+ *
+ * The following have to be defined before inclusion:
+ * - AES_GCM_SIV_LANES - number of lanes (jobs processed together)
+ * - SUBMIT_JOB_AES_GCM_SIV, FLUSH_JOB_AES_GCM_SIV - names of API functions
+ * - AES_GCM_SIV_NO_AESNI (optional) - AES-NI emulation and POLYVAL
+ *   without PCLMULQDQ
+ *
+ * Each job needs two passes over the message (POLYVAL and CTR) and
+ * per-nonce key derivation and expansion, which are serial for a single
+ * message. The lanes are processed together: AES blocks of all lanes
+ * (key derivation, tags and keystream) are interleaved to hide the
+ * AES round latency.
+ *
+ * The key generating key is taken from gcm_key_data (expanded_keys),
+ * as prepared by aes_gcm_pre_128() or aes_gcm_pre_256().
+ */
+
+#include <string.h>
+#include <immintrin.h>
+
+#include "intel-ipsec-mb.h"
+#include "aes_gcm_siv.h"
+#ifdef AES_GCM_SIV_NO_AESNI
+#include "aesni_emu.h"
+#else
+#include "ghash_clmul.h"
+#endif
+
+/* AES rounds for the largest (256-bit) key */
+#define GCM_SIV_MAX_ROUNDS 14
+/* key derivation blocks for the largest key */
+#define GCM_SIV_KDF_BLOCKS 6
+/* keystream blocks generated for one lane at a time */
+#define GCM_SIV_CTR_BLOCKS 4
+
+#ifdef AES_GCM_SIV_NO_AESNI
+__forceinline __m128i
+gcm_siv_emulate(void (*fn)(union xmm_reg *, const union xmm_reg *),
+                const __m128i x, const __m128i k)
+{
+        union xmm_reg a, b;
+
+        _mm_storeu_si128((__m128i *) a.byte, x);
+        _mm_storeu_si128((__m128i *) b.byte, k);
+        fn(&a, &b);
+        return _mm_loadu_si128((const __m128i *) a.byte);
+}
+
+__forceinline __m128i
+gcm_siv_keygenassist(const __m128i x, const uint32_t rcon)
+{
+        union xmm_reg a, b;
+
+        _mm_storeu_si128((__m128i *) b.byte, x);
+        emulate_AESKEYGENASSIST(&a, &b, rcon);
+        return _mm_loadu_si128((const __m128i *) a.byte);
+}
+
+#define GCM_SIV_AESENC(_x, _k)     gcm_siv_emulate(emulate_AESENC, _x, _k)
+#define GCM_SIV_AESENCLAST(_x, _k) gcm_siv_emulate(emulate_AESENCLAST, _x, _k)
+#define GCM_SIV_KEYGENASSIST(_x, _rcon) gcm_siv_keygenassist(_x, _rcon)
+#else
+#define GCM_SIV_AESENC(_x, _k)     _mm_aesenc_si128(_x, _k)
+#define GCM_SIV_AESENCLAST(_x, _k) _mm_aesenclast_si128(_x, _k)
+#define GCM_SIV_KEYGENASSIST(_x, _rcon) _mm_aeskeygenassist_si128(_x, _rcon)
+#endif
+
+/* job data of a lane */
+struct gcm_siv_lane {
+        JOB_AES_HMAC *job;
+        __m128i rk[GCM_SIV_MAX_ROUNDS + 1]; /* message encryption key */
+        unsigned nr;                        /* number of AES rounds */
+#ifdef AES_GCM_SIV_NO_AESNI
+        __m128i h;                          /* POLYVAL key */
+#else
+        /* GHASH key powers for POLYVAL, see polyval_clmul_hkey() */
+        DECLARE_ALIGNED(uint8_t hkey[4][GCM_BLOCK_LEN], 16);
+#endif
+        __m128i ctr;                        /* counter block */
+        const uint8_t *in;
+        uint8_t *out;
+        uint64_t len;                       /* bytes left to encrypt */
+};
+
+/**
+ * @brief Encrypts blocks of different lanes together
+ *
+ * @param blk blocks to encrypt in place
+ * @param rk round keys for each block
+ * @param nr number of rounds for each block
+ * @param n number of blocks
+ */
+__forceinline void
+gcm_siv_aes_enc_blocks(__m128i *blk, const __m128i *const *rk,
+                       const unsigned *nr, const unsigned n)
+{
+        unsigned i, r;
+
+        for (i = 0; i < n; i++)
+                blk[i] = _mm_xor_si128(blk[i], _mm_loadu_si128(&rk[i][0]));
+
+        for (r = 1; r < GCM_SIV_MAX_ROUNDS; r++)
+                for (i = 0; i < n; i++)
+                        if (r < nr[i])
+                                blk[i] = GCM_SIV_AESENC(blk[i],
+                                                        _mm_loadu_si128(
+                                                                &rk[i][r]));
+
+        for (i = 0; i < n; i++)
+                blk[i] = GCM_SIV_AESENCLAST(blk[i],
+                                            _mm_loadu_si128(&rk[i][nr[i]]));
+}
+
+/* next 128 bits of the key schedule from the previous ones and t */
+__forceinline __m128i
+gcm_siv_key_assist(__m128i k, const __m128i t)
+{
+        k = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+        k = _mm_xor_si128(k, _mm_slli_si128(k, 8));
+        return _mm_xor_si128(k, t);
+}
+
+#define GCM_SIV_EXP_128(_i, _rcon)                                      \
+        rk[_i] = gcm_siv_key_assist(rk[(_i) - 1],                       \
+                                    _mm_shuffle_epi32(                  \
+                                            GCM_SIV_KEYGENASSIST(       \
+                                                    rk[(_i) - 1],       \
+                                                    _rcon), 0xff))
+
+#define GCM_SIV_EXP_256(_i, _rcon)                                      \
+        do {                                                            \
+                rk[_i] = gcm_siv_key_assist(rk[(_i) - 2],               \
+                                            _mm_shuffle_epi32(          \
+                                                    GCM_SIV_KEYGENASSIST( \
+                                                            rk[(_i) - 1], \
+                                                            _rcon),     \
+                                                    0xff));             \
+                if ((_i) < GCM_SIV_MAX_ROUNDS)                          \
+                        rk[(_i) + 1] =                                  \
+                                gcm_siv_key_assist(rk[(_i) - 1],        \
+                                                   _mm_shuffle_epi32(   \
+                                                   GCM_SIV_KEYGENASSIST( \
+                                                           rk[_i], 0),  \
+                                                   0xaa));              \
+        } while (0)
+
+/* expands 128-bit key k0 */
+__forceinline void
+gcm_siv_expand_128(__m128i *rk, const __m128i k0)
+{
+        rk[0] = k0;
+        GCM_SIV_EXP_128(1, 0x01);
+        GCM_SIV_EXP_128(2, 0x02);
+        GCM_SIV_EXP_128(3, 0x04);
+        GCM_SIV_EXP_128(4, 0x08);
+        GCM_SIV_EXP_128(5, 0x10);
+        GCM_SIV_EXP_128(6, 0x20);
+        GCM_SIV_EXP_128(7, 0x40);
+        GCM_SIV_EXP_128(8, 0x80);
+        GCM_SIV_EXP_128(9, 0x1b);
+        GCM_SIV_EXP_128(10, 0x36);
+}
+
+/* expands 256-bit key k0 || k1 */
+__forceinline void
+gcm_siv_expand_256(__m128i *rk, const __m128i k0, const __m128i k1)
+{
+        rk[0] = k0;
+        rk[1] = k1;
+        GCM_SIV_EXP_256(2, 0x01);
+        GCM_SIV_EXP_256(4, 0x02);
+        GCM_SIV_EXP_256(6, 0x04);
+        GCM_SIV_EXP_256(8, 0x08);
+        GCM_SIV_EXP_256(10, 0x10);
+        GCM_SIV_EXP_256(12, 0x20);
+        GCM_SIV_EXP_256(14, 0x40);
+}
+
+/* loads 12-byte nonce into the low bytes of a block */
+__forceinline __m128i
+gcm_siv_load_nonce(const uint8_t *iv)
+{
+        uint8_t buf[GCM_BLOCK_LEN];
+
+        memcpy(buf, iv, AES_GCM_SIV_NONCE_LEN);
+        memset(&buf[AES_GCM_SIV_NONCE_LEN], 0,
+               GCM_BLOCK_LEN - AES_GCM_SIV_NONCE_LEN);
+        return _mm_loadu_si128((const __m128i *) buf);
+}
+
+__forceinline __m128i
+gcm_siv_polyval(const struct gcm_siv_lane *l, __m128i x,
+                const uint8_t *data, const uint64_t len)
+{
+#ifdef AES_GCM_SIV_NO_AESNI
+        uint64_t s[2], h[2];
+        uint64_t i;
+
+        _mm_storeu_si128((__m128i *) s, x);
+        _mm_storeu_si128((__m128i *) h, l->h);
+
+        for (i = 0; i < len; i += GCM_BLOCK_LEN) {
+                uint64_t d[2] = {0, 0};
+                const uint64_t n = (len - i) < GCM_BLOCK_LEN ?
+                        (len - i) : GCM_BLOCK_LEN;
+
+                memcpy(d, &data[i], n);
+                s[0] ^= d[0];
+                s[1] ^= d[1];
+                aes_gcm_siv_polyval_mul(s, h);
+        }
+        return _mm_loadu_si128((const __m128i *) s);
+#else
+        return polyval_clmul_update(l->hkey, x, data, len);
+#endif
+}
+
+/**
+ * @brief Computes the block encrypted into the tag
+ *
+ * POLYVAL over AAD, message and their lengths, XOR'ed with the nonce
+ * and with the most significant bit cleared.
+ *
+ * @param l lane
+ * @param msg plaintext
+ *
+ * @return block to be encrypted
+ */
+__forceinline __m128i
+gcm_siv_tag_block(const struct gcm_siv_lane *l, const uint8_t *msg)
+{
+        const JOB_AES_HMAC *job = l->job;
+        const uint64_t aad_len = job->u.GCM_SIV.aad_len_in_bytes;
+        const uint64_t len = job->msg_len_to_cipher_in_bytes;
+        uint64_t lens[2];
+        __m128i x = _mm_setzero_si128();
+
+        x = gcm_siv_polyval(l, x, (const uint8_t *) job->u.GCM_SIV.aad,
+                            aad_len);
+        x = gcm_siv_polyval(l, x, msg, len);
+        lens[0] = aad_len * 8;
+        lens[1] = len * 8;
+        x = gcm_siv_polyval(l, x, (const uint8_t *) lens, sizeof(lens));
+
+        x = _mm_xor_si128(x, gcm_siv_load_nonce(job->iv));
+        return _mm_and_si128(x, _mm_set_epi32(0x7fffffff, -1, -1, -1));
+}
+
+/* encrypts tag blocks of the lanes from the mask, tags are written out */
+__forceinline void
+gcm_siv_tags(struct gcm_siv_lane *lanes, const unsigned num_lanes,
+             __m128i *blk, const uint32_t mask)
+{
+        const __m128i *rk[AES_GCM_SIV_LANES];
+        unsigned nr[AES_GCM_SIV_LANES];
+        __m128i t[AES_GCM_SIV_LANES];
+        unsigned i, n = 0;
+
+        for (i = 0; i < num_lanes; i++) {
+                if ((mask & (1 << i)) == 0)
+                        continue;
+                t[n] = blk[i];
+                rk[n] = lanes[i].rk;
+                nr[n] = lanes[i].nr;
+                n++;
+        }
+
+        gcm_siv_aes_enc_blocks(t, rk, nr, n);
+
+        for (i = 0, n = 0; i < num_lanes; i++) {
+                if ((mask & (1 << i)) == 0)
+                        continue;
+                _mm_storeu_si128((__m128i *) lanes[i].job->auth_tag_output,
+                                 t[n]);
+                blk[i] = t[n++];
+        }
+}
+
+/* derives message authentication and encryption keys of all lanes */
+__forceinline void
+gcm_siv_derive_keys(struct gcm_siv_lane *lanes, const unsigned num_lanes)
+{
+        __m128i blk[AES_GCM_SIV_LANES * GCM_SIV_KDF_BLOCKS];
+        const __m128i *rk[AES_GCM_SIV_LANES * GCM_SIV_KDF_BLOCKS];
+        unsigned nr[AES_GCM_SIV_LANES * GCM_SIV_KDF_BLOCKS];
+        unsigned i, j, n = 0;
+
+        for (i = 0; i < num_lanes; i++) {
+                const JOB_AES_HMAC *job = lanes[i].job;
+                const struct gcm_key_data *key = (const struct gcm_key_data *)
+                        (job->cipher_direction == ENCRYPT ?
+                         job->aes_enc_key_expanded :
+                         job->aes_dec_key_expanded);
+                /* nonce in bytes 4 to 15, block index in bytes 0 to 3 */
+                const __m128i nonce =
+                        _mm_slli_si128(gcm_siv_load_nonce(job->iv), 4);
+                const unsigned num_blocks =
+                        job->aes_key_len_in_bytes == 16 ? 4 : 6;
+
+                lanes[i].nr = job->aes_key_len_in_bytes == 16 ? 10 : 14;
+                for (j = 0; j < num_blocks; j++) {
+                        blk[n] = _mm_xor_si128(nonce,
+                                               _mm_cvtsi32_si128((int) j));
+                        rk[n] = (const __m128i *) key->expanded_keys;
+                        nr[n] = lanes[i].nr;
+                        n++;
+                }
+        }
+
+        gcm_siv_aes_enc_blocks(blk, rk, nr, n);
+
+        /* first 8 bytes of each block are used */
+        for (i = 0, n = 0; i < num_lanes; i++) {
+                struct gcm_siv_lane *l = &lanes[i];
+                const __m128i h = _mm_unpacklo_epi64(blk[n], blk[n + 1]);
+                const __m128i k0 = _mm_unpacklo_epi64(blk[n + 2],
+                                                      blk[n + 3]);
+
+                if (l->nr == 10) {
+                        gcm_siv_expand_128(l->rk, k0);
+                        n += 4;
+                } else {
+                        gcm_siv_expand_256(l->rk, k0,
+                                           _mm_unpacklo_epi64(blk[n + 4],
+                                                              blk[n + 5]));
+                        n += 6;
+                }
+#ifdef AES_GCM_SIV_NO_AESNI
+                l->h = h;
+#else
+                polyval_clmul_hkey(h, l->hkey);
+#endif
+        }
+}
+
+/* XOR's len bytes (up to a block) of in with keystream block ks */
+__forceinline void
+gcm_siv_xor_block(const uint8_t *in, uint8_t *out, const __m128i ks,
+                  const uint64_t len)
+{
+        if (len == GCM_BLOCK_LEN) {
+                const __m128i d = _mm_loadu_si128((const __m128i *) in);
+
+                _mm_storeu_si128((__m128i *) out, _mm_xor_si128(d, ks));
+        } else {
+                uint8_t buf[GCM_BLOCK_LEN];
+                uint64_t i;
+
+                _mm_storeu_si128((__m128i *) buf, ks);
+                for (i = 0; i < len; i++)
+                        out[i] = in[i] ^ buf[i];
+        }
+}
+
+/* CTR encryption/decryption of all lanes, blocks of lanes interleaved */
+__forceinline void
+gcm_siv_ctr(struct gcm_siv_lane *lanes, const unsigned num_lanes)
+{
+        __m128i blk[AES_GCM_SIV_LANES * GCM_SIV_CTR_BLOCKS];
+        const __m128i *rk[AES_GCM_SIV_LANES * GCM_SIV_CTR_BLOCKS];
+        unsigned nr[AES_GCM_SIV_LANES * GCM_SIV_CTR_BLOCKS];
+        /* the counter is the first 32 bits, little endian */
+        const __m128i one = _mm_cvtsi32_si128(1);
+        unsigned i, j, n;
+
+        do {
+                n = 0;
+                for (i = 0; i < num_lanes; i++) {
+                        struct gcm_siv_lane *l = &lanes[i];
+
+                        for (j = 0; j < GCM_SIV_CTR_BLOCKS &&
+                                     (j * GCM_BLOCK_LEN) < l->len; j++) {
+                                blk[n] = l->ctr;
+                                rk[n] = l->rk;
+                                nr[n] = l->nr;
+                                l->ctr = _mm_add_epi32(l->ctr, one);
+                                n++;
+                        }
+                }
+
+                gcm_siv_aes_enc_blocks(blk, rk, nr, n);
+
+                /* blocks are in the same order as generated above */
+                for (i = 0, n = 0; i < num_lanes; i++) {
+                        struct gcm_siv_lane *l = &lanes[i];
+
+                        for (j = 0; j < GCM_SIV_CTR_BLOCKS && l->len != 0;
+                             j++) {
+                                const uint64_t len =
+                                        l->len < GCM_BLOCK_LEN ?
+                                        l->len : GCM_BLOCK_LEN;
+
+                                gcm_siv_xor_block(l->in, l->out, blk[n++],
+                                                  len);
+                                l->in += len;
+                                l->out += len;
+                                l->len -= len;
+                        }
+                }
+        } while (n != 0);
+}
+
+/* processes all jobs in the lanes, returns one of them */
+static JOB_AES_HMAC *
+gcm_siv_process(MB_MGR_AES_GCM_SIV_OOO *state)
+{
+        struct gcm_siv_lane lanes[AES_GCM_SIV_LANES];
+        __m128i blk[AES_GCM_SIV_LANES];
+        const __m128i msb = _mm_set_epi32((int) 0x80000000, 0, 0, 0);
+        uint32_t enc_mask = 0, dec_mask = 0;
+        unsigned i, n = 0;
+
+        for (i = 0; i < AES_GCM_SIV_LANES; i++) {
+                JOB_AES_HMAC *job = state->job_in_lane[i];
+                struct gcm_siv_lane *l = &lanes[n];
+
+                if (job == NULL)
+                        continue;
+                state->job_in_lane[i] = NULL;
+
+                l->job = job;
+                l->in = job->src + job->cipher_start_src_offset_in_bytes;
+                l->out = job->dst;
+                l->len = job->msg_len_to_cipher_in_bytes;
+                if (job->cipher_direction == ENCRYPT)
+                        enc_mask |= 1 << n;
+                else
+                        dec_mask |= 1 << n;
+                n++;
+        }
+        state->num_lanes_inuse = 0;
+
+        gcm_siv_derive_keys(lanes, n);
+
+        /* tags of encrypted messages are the initial counter blocks */
+        for (i = 0; i < n; i++)
+                if (enc_mask & (1 << i))
+                        blk[i] = gcm_siv_tag_block(&lanes[i], lanes[i].in);
+                else
+                        blk[i] = _mm_loadu_si128((const __m128i *)
+                                                 lanes[i].job->u.GCM_SIV.tag);
+        if (enc_mask != 0)
+                gcm_siv_tags(lanes, n, blk, enc_mask);
+
+        for (i = 0; i < n; i++)
+                lanes[i].ctr = _mm_or_si128(blk[i], msb);
+
+        gcm_siv_ctr(lanes, n);
+
+        /* tags of decrypted messages, to be compared by the application */
+        if (dec_mask != 0) {
+                for (i = 0; i < n; i++)
+                        if (dec_mask & (1 << i))
+                                blk[i] = gcm_siv_tag_block(&lanes[i],
+                                                           lanes[i].job->dst);
+                gcm_siv_tags(lanes, n, blk, dec_mask);
+        }
+
+        for (i = 0; i < n; i++)
+                lanes[i].job->status = STS_COMPLETED;
+
+        return lanes[0].job;
+}
+
+JOB_AES_HMAC *
+SUBMIT_JOB_AES_GCM_SIV(MB_MGR_AES_GCM_SIV_OOO *state, JOB_AES_HMAC *job)
+{
+        unsigned lane = 0;
+
+        while (state->job_in_lane[lane] != NULL)
+                lane++;
+
+        state->job_in_lane[lane] = job;
+        state->num_lanes_inuse++;
+
+        /* wait for the other lanes */
+        if (state->num_lanes_inuse < AES_GCM_SIV_LANES)
+                return NULL;
+
+        return gcm_siv_process(state);
+}
+
+JOB_AES_HMAC *
+FLUSH_JOB_AES_GCM_SIV(MB_MGR_AES_GCM_SIV_OOO *state)
+{
+        if (state->num_lanes_inuse == 0)
+                return NULL;
+
+        return gcm_siv_process(state);
+}
@@ -0,0 +1,365 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * Multi-key AES key expansion, with #define's to build an SSE, AVX, AVX2
+ * or AVX512 version (see sse/aes_keyexp_mb_sse.c, avx/aes_keyexp_mb_avx.c,
+ * etc.)
+ *
+ * The following have to be defined before inclusion:
+ * - AES_KEYEXP_MB_LANES - number of keys expanded together
+ * - AES_KEYEXP_128_MB, AES_KEYEXP_192_MB, AES_KEYEXP_256_MB - names of API
+ *   functions
+ * - AES_KEYEXP_MB_NO_AESNI (optional) - AES-NI emulation
+ *
+ * Each round key depends on the previous one, so a single key schedule is
+ * a serial chain of dependent instructions. Here the chains of several
+ * independent keys are interleaved to keep the execution units busy.
+ * SubWord is computed with AESENCLAST on a block made of the same word in
+ * all columns (ShiftRows doesn't change it), which is fully pipelined,
+ * unlike AESKEYGENASSIST.
+ */
+
+#include <immintrin.h>
+
+#include "intel-ipsec-mb.h"
+#ifdef AES_KEYEXP_MB_NO_AESNI
+#include "aesni_emu.h"
+#endif
+
+#ifdef AES_KEYEXP_MB_NO_AESNI
+__forceinline __m128i
+aes_keyexp_mb_aesenclast(const __m128i x, const __m128i k)
+{
+        union xmm_reg a, b;
+
+        _mm_storeu_si128((__m128i *) a.byte, x);
+        _mm_storeu_si128((__m128i *) b.byte, k);
+        emulate_AESENCLAST(&a, &b);
+        return _mm_loadu_si128((const __m128i *) a.byte);
+}
+
+__forceinline __m128i
+aes_keyexp_mb_aesimc(const __m128i x)
+{
+        union xmm_reg a, b;
+
+        _mm_storeu_si128((__m128i *) b.byte, x);
+        emulate_AESIMC(&a, &b);
+        return _mm_loadu_si128((const __m128i *) a.byte);
+}
+
+#define AES_KEYEXP_MB_AESENCLAST(_x, _k) aes_keyexp_mb_aesenclast(_x, _k)
+#define AES_KEYEXP_MB_AESIMC(_x)         aes_keyexp_mb_aesimc(_x)
+#else
+#define AES_KEYEXP_MB_AESENCLAST(_x, _k) _mm_aesenclast_si128(_x, _k)
+#define AES_KEYEXP_MB_AESIMC(_x)         _mm_aesimc_si128(_x)
+#endif
+
+/* round key 'r' of the schedule 'p' */
+#define AES_KEYEXP_MB_RK(_p, _r) (((__m128i *) (_p)) + (_r))
+
+/* decryption schedule of key 'i' (NULL if not requested) */
+#define AES_KEYEXP_MB_DEC(_dec, _i) (((_dec) != NULL) ? (_dec)[(_i)] : NULL)
+
+static const uint32_t aes_keyexp_mb_rcon[10] = {
+        0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36
+};
+
+/**
+ * @brief Computes RotWord(w) of the key block word, in all columns
+ *
+ * @param k key block
+ * @param w index of the 32-bit word in \a k
+ */
+__forceinline __m128i
+aes_keyexp_mb_rot_word(const __m128i k, const unsigned w)
+{
+        /* bytes 4w+1, 4w+2, 4w+3 and 4w in each column */
+        const __m128i idx = _mm_set1_epi32((int) (w * 0x04040404 +
+                                                  0x00030201));
+
+        return _mm_shuffle_epi8(k, idx);
+}
+
+/* [a, b, c, d] -> [a, a^b, a^b^c, a^b^c^d] (32-bit words) */
+__forceinline __m128i
+aes_keyexp_mb_xor_prefix(__m128i x)
+{
+        x = _mm_xor_si128(x, _mm_slli_si128(x, 4));
+        return _mm_xor_si128(x, _mm_slli_si128(x, 8));
+}
+
+/**
+ * @brief Stores a round key in the encryption and decryption schedules
+ *
+ * Decryption schedule is for the Equivalent Inverse Cipher (round keys in
+ * reverse order, InvMixColumns applied to the middle ones).
+ *
+ * @param enc encryption key schedule
+ * @param dec decryption key schedule (can be NULL)
+ * @param nr number of rounds
+ * @param r round key index
+ * @param rk round key
+ */
+__forceinline void
+aes_keyexp_mb_store(void *enc, void *dec, const unsigned nr,
+                    const unsigned r, const __m128i rk)
+{
+        _mm_storeu_si128(AES_KEYEXP_MB_RK(enc, r), rk);
+        if (dec == NULL)
+                return;
+        if (r == 0 || r == nr)
+                _mm_storeu_si128(AES_KEYEXP_MB_RK(dec, nr - r), rk);
+        else
+                _mm_storeu_si128(AES_KEYEXP_MB_RK(dec, nr - r),
+                                 AES_KEYEXP_MB_AESIMC(rk));
+}
+
+/**
+ * @brief Expands 128-bit keys
+ *
+ * @param keys pointers to the keys
+ * @param enc pointers to the encryption key schedules
+ * @param dec pointers to the decryption key schedules (can be NULL)
+ * @param n number of keys (up to AES_KEYEXP_MB_LANES)
+ */
+__forceinline void
+aes_keyexp_mb_128(const void *const *keys, void *const *enc, void *const *dec,
+                  const unsigned n)
+{
+        __m128i k[AES_KEYEXP_MB_LANES];
+        unsigned i, r;
+
+        for (i = 0; i < n; i++) {
+                k[i] = _mm_loadu_si128((const __m128i *) keys[i]);
+                aes_keyexp_mb_store(enc[i], AES_KEYEXP_MB_DEC(dec, i), 10, 0,
+                                    k[i]);
+        }
+
+        for (r = 1; r <= 10; r++) {
+                const __m128i rcon =
+                        _mm_set1_epi32((int) aes_keyexp_mb_rcon[r - 1]);
+
+                for (i = 0; i < n; i++) {
+                        const __m128i t =
+                                AES_KEYEXP_MB_AESENCLAST(
+                                        aes_keyexp_mb_rot_word(k[i], 3), rcon);
+
+                        k[i] = _mm_xor_si128(aes_keyexp_mb_xor_prefix(k[i]),
+                                             t);
+                        aes_keyexp_mb_store(enc[i], AES_KEYEXP_MB_DEC(dec, i),
+                                            10, r, k[i]);
+                }
+        }
+}
+
+/**
+ * @brief Expands 192-bit keys
+ *
+ * Each step computes six words of the schedule, they are put together
+ * into round keys with the two words left from the previous step.
+ *
+ * @param keys pointers to the keys
+ * @param enc pointers to the encryption key schedules
+ * @param dec pointers to the decryption key schedules (can be NULL)
+ * @param n number of keys (up to AES_KEYEXP_MB_LANES)
+ */
+__forceinline void
+aes_keyexp_mb_192(const void *const *keys, void *const *enc, void *const *dec,
+                  const unsigned n)
+{
+        __m128i k0[AES_KEYEXP_MB_LANES], k1[AES_KEYEXP_MB_LANES];
+        unsigned i, r;
+
+        for (i = 0; i < n; i++) {
+                k0[i] = _mm_loadu_si128((const __m128i *) keys[i]);
+                k1[i] = _mm_loadl_epi64((const __m128i *)
+                                        ((const uint8_t *) keys[i] + 16));
+                aes_keyexp_mb_store(enc[i], AES_KEYEXP_MB_DEC(dec, i), 12, 0,
+                                    k0[i]);
+        }
+
+        for (r = 0; r < 8; r++) {
+                const __m128i rcon =
+                        _mm_set1_epi32((int) aes_keyexp_mb_rcon[r]);
+
+                for (i = 0; i < n; i++) {
+                        void *d = AES_KEYEXP_MB_DEC(dec, i);
+                        /* two words left from the previous step */
+                        const __m128i prev = k1[i];
+                        const __m128i t =
+                                AES_KEYEXP_MB_AESENCLAST(
+                                        aes_keyexp_mb_rot_word(k1[i], 1),
+                                        rcon);
+
+                        k0[i] = _mm_xor_si128(aes_keyexp_mb_xor_prefix(k0[i]),
+                                              t);
+                        /* only 2 lower words of k1 are valid */
+                        k1[i] = _mm_xor_si128(k1[i],
+                                              _mm_slli_si128(k1[i], 4));
+                        k1[i] = _mm_xor_si128(k1[i],
+                                              _mm_shuffle_epi32(k0[i], 0xff));
+
+                        if (r & 1) {
+                                aes_keyexp_mb_store(enc[i], d, 12,
+                                                    (3 * r + 3) / 2, k0[i]);
+                                continue;
+                        }
+                        aes_keyexp_mb_store(enc[i], d, 12, 1 + (3 * r / 2),
+                                            _mm_unpacklo_epi64(prev, k0[i]));
+                        aes_keyexp_mb_store(enc[i], d, 12, 2 + (3 * r / 2),
+                                            _mm_alignr_epi8(k1[i], k0[i], 8));
+                }
+        }
+}
+
+/**
+ * @brief Expands 256-bit keys
+ *
+ * @param keys pointers to the keys
+ * @param enc pointers to the encryption key schedules
+ * @param dec pointers to the decryption key schedules (can be NULL)
+ * @param n number of keys (up to AES_KEYEXP_MB_LANES)
+ */
+__forceinline void
+aes_keyexp_mb_256(const void *const *keys, void *const *enc, void *const *dec,
+                  const unsigned n)
+{
+        __m128i k0[AES_KEYEXP_MB_LANES], k1[AES_KEYEXP_MB_LANES];
+        const __m128i zero = _mm_setzero_si128();
+        unsigned i, r;
+
+        for (i = 0; i < n; i++) {
+                k0[i] = _mm_loadu_si128((const __m128i *) keys[i]);
+                k1[i] = _mm_loadu_si128((const __m128i *) keys[i] + 1);
+                aes_keyexp_mb_store(enc[i], AES_KEYEXP_MB_DEC(dec, i), 14, 0,
+                                    k0[i]);
+                aes_keyexp_mb_store(enc[i], AES_KEYEXP_MB_DEC(dec, i), 14, 1,
+                                    k1[i]);
+        }
+
+        for (r = 0; r < 7; r++) {
+                const __m128i rcon =
+                        _mm_set1_epi32((int) aes_keyexp_mb_rcon[r]);
+
+                for (i = 0; i < n; i++) {
+                        const __m128i t =
+                                AES_KEYEXP_MB_AESENCLAST(
+                                        aes_keyexp_mb_rot_word(k1[i], 3),
+                                        rcon);
+
+                        k0[i] = _mm_xor_si128(aes_keyexp_mb_xor_prefix(k0[i]),
+                                              t);
+                        aes_keyexp_mb_store(enc[i], AES_KEYEXP_MB_DEC(dec, i),
+                                            14, 2 + 2 * r, k0[i]);
+                }
+                /* last step completes round key 14 */
+                if (r == 6)
+                        break;
+                for (i = 0; i < n; i++) {
+                        /* SubWord only (no RotWord and RCON) */
+                        const __m128i t =
+                                AES_KEYEXP_MB_AESENCLAST(
+                                        _mm_shuffle_epi32(k0[i], 0xff), zero);
+
+                        k1[i] = _mm_xor_si128(aes_keyexp_mb_xor_prefix(k1[i]),
+                                              t);
+                        aes_keyexp_mb_store(enc[i], AES_KEYEXP_MB_DEC(dec, i),
+                                            14, 3 + 2 * r, k1[i]);
+                }
+        }
+}
+
+/**
+ * @brief Expands up to AES_KEYEXP_MB_LANES keys of the same size
+ *
+ * @param keys pointers to the keys
+ * @param enc pointers to the encryption key schedules
+ * @param dec pointers to the decryption key schedules (can be NULL)
+ * @param n number of keys
+ * @param key_len key length in bytes
+ */
+__forceinline void
+aes_keyexp_mb_n(const void *const *keys, void *const *enc, void *const *dec,
+                const unsigned n, const unsigned key_len)
+{
+        if (key_len == 16)
+                aes_keyexp_mb_128(keys, enc, dec, n);
+        else if (key_len == 24)
+                aes_keyexp_mb_192(keys, enc, dec, n);
+        else
+                aes_keyexp_mb_256(keys, enc, dec, n);
+}
+
+/**
+ * @brief Expands keys of the same size
+ *
+ * @param keys pointers to the keys
+ * @param enc pointers to the encryption key schedules
+ * @param dec pointers to the decryption key schedules (can be NULL)
+ * @param num number of keys
+ * @param key_len key length in bytes
+ */
+__forceinline void
+aes_keyexp_mb(const void *const *keys, void *const *enc, void *const *dec,
+              const uint32_t num, const unsigned key_len)
+{
+        uint32_t i;
+
+        for (i = 0; (i + AES_KEYEXP_MB_LANES) <= num;
+             i += AES_KEYEXP_MB_LANES)
+                aes_keyexp_mb_n(&keys[i], &enc[i],
+                                (dec != NULL) ? &dec[i] : NULL,
+                                AES_KEYEXP_MB_LANES, key_len);
+        /* remaining keys one by one */
+        for (; i < num; i++)
+                aes_keyexp_mb_n(&keys[i], &enc[i],
+                                (dec != NULL) ? &dec[i] : NULL,
+                                1, key_len);
+}
+
+void
+AES_KEYEXP_128_MB(const void *const *keys, void *const *enc_exp_keys,
+                  void *const *dec_exp_keys, const uint32_t num_keys)
+{
+        aes_keyexp_mb(keys, enc_exp_keys, dec_exp_keys, num_keys, 16);
+}
+
+void
+AES_KEYEXP_192_MB(const void *const *keys, void *const *enc_exp_keys,
+                  void *const *dec_exp_keys, const uint32_t num_keys)
+{
+        aes_keyexp_mb(keys, enc_exp_keys, dec_exp_keys, num_keys, 24);
+}
+
+void
+AES_KEYEXP_256_MB(const void *const *keys, void *const *enc_exp_keys,
+                  void *const *dec_exp_keys, const uint32_t num_keys)
+{
+        aes_keyexp_mb(keys, enc_exp_keys, dec_exp_keys, num_keys, 32);
+}
@@ -0,0 +1,123 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* BLAKE2b and BLAKE2s (RFC 7693), plain and keyed */
+
+#ifndef BLAKE2_H
+#define BLAKE2_H
+
+#include <stdint.h>
+#include "intel-ipsec-mb.h"
+
+#define BLAKE2B_ROUNDS 12
+#define BLAKE2S_ROUNDS 10
+
+/* initialization vectors */
+extern IMB_DLL_LOCAL const uint64_t blake2b_iv[8];
+extern IMB_DLL_LOCAL const uint32_t blake2s_iv[8];
+/* message word permutations (BLAKE2b rounds 10 and 11 reuse 0 and 1) */
+extern IMB_DLL_LOCAL const uint8_t blake2_sigma[BLAKE2S_ROUNDS][16];
+
+/* source of input blocks for idle lanes */
+extern IMB_DLL_LOCAL const uint8_t blake2_zero_block[BLAKE2B_BLOCK_SIZE];
+
+/**
+ * @brief Compresses blocks in all lanes of BLAKE2 out of order manager
+ *
+ * Lanes in use compress num_blocks blocks from their input pointers,
+ * with the counter increment and last block flag from the lane data.
+ *
+ * @param state pointer to BLAKE2b or BLAKE2s out of order manager
+ * @param num_blocks number of blocks to compress
+ */
+typedef void (*blake2_compress_lanes_t)(void *state,
+                                        const uint64_t num_blocks);
+
+IMB_DLL_LOCAL void
+blake2b_ooo_init(MB_MGR_BLAKE2B_OOO *state, const unsigned num_lanes);
+IMB_DLL_LOCAL void
+blake2s_ooo_init(MB_MGR_BLAKE2S_OOO *state, const unsigned num_lanes);
+
+/*
+ * Submit and flush of BLAKE2 out of order managers.
+ * Lanes are filled on submit. Once all of them are busy (or on flush)
+ * all lanes compress blocks until one of them runs out of blocks.
+ * Then the lane gets its next blocks: the key block, the message blocks
+ * and the last block, until its job is complete.
+ * Each call returns at most one completed job.
+ */
+IMB_DLL_LOCAL JOB_AES_HMAC *
+blake2b_ooo_submit(MB_MGR_BLAKE2B_OOO *state, JOB_AES_HMAC *job,
+                   const unsigned num_lanes, blake2_compress_lanes_t compress);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+blake2b_ooo_flush(MB_MGR_BLAKE2B_OOO *state, const unsigned num_lanes,
+                  blake2_compress_lanes_t compress);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+blake2s_ooo_submit(MB_MGR_BLAKE2S_OOO *state, JOB_AES_HMAC *job,
+                   const unsigned num_lanes, blake2_compress_lanes_t compress);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+blake2s_ooo_flush(MB_MGR_BLAKE2S_OOO *state, const unsigned num_lanes,
+                  blake2_compress_lanes_t compress);
+
+/* Multi-buffer BLAKE2 out of order manager functions */
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_blake2b_sse(MB_MGR_BLAKE2B_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_blake2b_sse(MB_MGR_BLAKE2B_OOO *state);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_blake2s_sse(MB_MGR_BLAKE2S_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_blake2s_sse(MB_MGR_BLAKE2S_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_blake2b_avx(MB_MGR_BLAKE2B_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_blake2b_avx(MB_MGR_BLAKE2B_OOO *state);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_blake2s_avx(MB_MGR_BLAKE2S_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_blake2s_avx(MB_MGR_BLAKE2S_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_blake2b_avx2(MB_MGR_BLAKE2B_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_blake2b_avx2(MB_MGR_BLAKE2B_OOO *state);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_blake2s_avx2(MB_MGR_BLAKE2S_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_blake2s_avx2(MB_MGR_BLAKE2S_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_blake2b_avx512(MB_MGR_BLAKE2B_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_blake2b_avx512(MB_MGR_BLAKE2B_OOO *state);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_blake2s_avx512(MB_MGR_BLAKE2S_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_blake2s_avx512(MB_MGR_BLAKE2S_OOO *state);
+
+#endif /* BLAKE2_H */
@@ -0,0 +1,270 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * Multi-buffer BLAKE2b and BLAKE2s code, with #define's to build
+ * an SSE, AVX, AVX2 or AVX512 version (see sse/blake2_sse.c,
+ * avx/blake2_avx.c, etc.)
+ *
+ * The following have to be defined before inclusion:
+ * - SIMD64_LANES - number of 64-bit lanes in a vector (see simd_lanes64.h)
+ * - SIMD_LANES - number of 32-bit lanes in a vector (see simd_lanes.h)
+ * - SUBMIT_JOB_BLAKE2B, FLUSH_JOB_BLAKE2B, SUBMIT_JOB_BLAKE2S,
+ *   FLUSH_JOB_BLAKE2S - names of API functions
+ *
+ * Scheduling is common code (see blake2.c), the compression function
+ * runs on all lanes at once with one lane per job.
+ */
+
+#include "intel-ipsec-mb.h"
+#include "simd_lanes.h"
+#include "simd_lanes64.h"
+#include "blake2.h"
+
+/* mixing function G on 64-bit words a, b, c and d of the working vector */
+__forceinline
+void
+blake2b_g(simd64_t *v, const unsigned a, const unsigned b, const unsigned c,
+          const unsigned d, const simd64_t x, const simd64_t y)
+{
+        v[a] = SIMD64_ADD(SIMD64_ADD(v[a], v[b]), x);
+        v[d] = SIMD64_ROR(SIMD64_XOR(v[d], v[a]), 32);
+        v[c] = SIMD64_ADD(v[c], v[d]);
+        v[b] = SIMD64_ROR(SIMD64_XOR(v[b], v[c]), 24);
+        v[a] = SIMD64_ADD(SIMD64_ADD(v[a], v[b]), y);
+        v[d] = SIMD64_ROR(SIMD64_XOR(v[d], v[a]), 16);
+        v[c] = SIMD64_ADD(v[c], v[d]);
+        v[b] = SIMD64_ROR(SIMD64_XOR(v[b], v[c]), 63);
+}
+
+/* mixing function G on 32-bit words a, b, c and d of the working vector */
+__forceinline
+void
+blake2s_g(simd_t *v, const unsigned a, const unsigned b, const unsigned c,
+          const unsigned d, const simd_t x, const simd_t y)
+{
+        v[a] = SIMD_ADD(SIMD_ADD(v[a], v[b]), x);
+        v[d] = SIMD_ROL(SIMD_XOR(v[d], v[a]), 32 - 16);
+        v[c] = SIMD_ADD(v[c], v[d]);
+        v[b] = SIMD_ROL(SIMD_XOR(v[b], v[c]), 32 - 12);
+        v[a] = SIMD_ADD(SIMD_ADD(v[a], v[b]), y);
+        v[d] = SIMD_ROL(SIMD_XOR(v[d], v[a]), 32 - 8);
+        v[c] = SIMD_ADD(v[c], v[d]);
+        v[b] = SIMD_ROL(SIMD_XOR(v[b], v[c]), 32 - 7);
+}
+
+/* applies G to columns and diagonals of the working vector */
+#define BLAKE2_ROUND(_g, _v, _m, _s)                                    \
+        do {                                                            \
+                _g(_v, 0, 4,  8, 12, _m[_s[0]],  _m[_s[1]]);            \
+                _g(_v, 1, 5,  9, 13, _m[_s[2]],  _m[_s[3]]);            \
+                _g(_v, 2, 6, 10, 14, _m[_s[4]],  _m[_s[5]]);            \
+                _g(_v, 3, 7, 11, 15, _m[_s[6]],  _m[_s[7]]);            \
+                _g(_v, 0, 5, 10, 15, _m[_s[8]],  _m[_s[9]]);            \
+                _g(_v, 1, 6, 11, 12, _m[_s[10]], _m[_s[11]]);           \
+                _g(_v, 2, 7,  8, 13, _m[_s[12]], _m[_s[13]]);           \
+                _g(_v, 3, 4,  9, 14, _m[_s[14]], _m[_s[15]]);           \
+        } while (0)
+
+/*
+ * Sets up input pointers, strides and counters of all lanes.
+ * Idle lanes compress zero blocks, their state is irrelevant.
+ */
+__forceinline
+void
+blake2_lanes_setup(const BLAKE2_OOO_LANES *ol, const unsigned num_lanes,
+                   const uint32_t block_size, const uint8_t **p,
+                   uint64_t *stride, uint64_t *t, uint64_t *inc, uint64_t *f)
+{
+        unsigned lane;
+
+        for (lane = 0; lane < num_lanes; lane++) {
+                const BLAKE2_LANE_DATA *ld = &ol->ldata[lane];
+
+                if (ld->job_in_lane != NULL) {
+                        p[lane] = ol->in[lane];
+                        stride[lane] = block_size;
+                        t[lane] = ld->t;
+                        inc[lane] = ld->inc;
+                        f[lane] = ld->f;
+                } else {
+                        p[lane] = blake2_zero_block;
+                        stride[lane] = 0;
+                        t[lane] = 0;
+                        inc[lane] = 0;
+                        f[lane] = 0;
+                }
+        }
+}
+
+/* updates input pointers and counters of lanes in use */
+__forceinline
+void
+blake2_lanes_update(BLAKE2_OOO_LANES *ol, const unsigned num_lanes,
+                    const uint64_t num_blocks, const uint8_t * const *p,
+                    const uint64_t *t)
+{
+        unsigned lane;
+
+        for (lane = 0; lane < num_lanes; lane++) {
+                if (ol->ldata[lane].job_in_lane == NULL)
+                        continue;
+                ol->in[lane] = p[lane];
+                ol->lens[lane] -= num_blocks;
+                ol->ldata[lane].t = t[lane];
+        }
+}
+
+static void
+blake2b_compress_lanes(void *ooo, const uint64_t num_blocks)
+{
+        MB_MGR_BLAKE2B_OOO *state = (MB_MGR_BLAKE2B_OOO *) ooo;
+        DECLARE_ALIGNED(uint64_t t[SIMD64_LANES], 64);
+        DECLARE_ALIGNED(uint64_t f[SIMD64_LANES], 64);
+        const uint8_t *p[SIMD64_LANES];
+        uint64_t stride[SIMD64_LANES], inc[SIMD64_LANES];
+        simd64_t h[8], v[16], m[16];
+        uint64_t n;
+        unsigned i, r, lane;
+
+        blake2_lanes_setup(&state->lanes, SIMD64_LANES, BLAKE2B_BLOCK_SIZE,
+                           p, stride, t, inc, f);
+
+        for (i = 0; i < 8; i++)
+                h[i] = SIMD64_LOAD(state->h[i]);
+
+        for (n = 0; n < num_blocks; n++) {
+                for (lane = 0; lane < SIMD64_LANES; lane++)
+                        t[lane] += inc[lane];
+                for (i = 0; i < 16; i++)
+                        m[i] = simd64_load_lanes(p, i * 8);
+
+                /* high word of the counter is always zero */
+                for (i = 0; i < 8; i++) {
+                        v[i] = h[i];
+                        v[i + 8] = SIMD64_SET1(blake2b_iv[i]);
+                }
+                v[12] = SIMD64_XOR(v[12], SIMD64_LOAD(t));
+                v[14] = SIMD64_XOR(v[14], SIMD64_LOAD(f));
+
+                for (r = 0; r < BLAKE2B_ROUNDS; r++)
+                        BLAKE2_ROUND(blake2b_g, v, m,
+                                     blake2_sigma[r % BLAKE2S_ROUNDS]);
+
+                for (i = 0; i < 8; i++)
+                        h[i] = SIMD64_XOR(h[i], SIMD64_XOR(v[i], v[i + 8]));
+
+                for (lane = 0; lane < SIMD64_LANES; lane++)
+                        p[lane] += stride[lane];
+        }
+
+        for (i = 0; i < 8; i++)
+                SIMD64_STORE(state->h[i], h[i]);
+
+        blake2_lanes_update(&state->lanes, SIMD64_LANES, num_blocks, p, t);
+}
+
+static void
+blake2s_compress_lanes(void *ooo, const uint64_t num_blocks)
+{
+        MB_MGR_BLAKE2S_OOO *state = (MB_MGR_BLAKE2S_OOO *) ooo;
+        DECLARE_ALIGNED(uint32_t t_lo[SIMD_LANES], 64);
+        DECLARE_ALIGNED(uint32_t t_hi[SIMD_LANES], 64);
+        DECLARE_ALIGNED(uint32_t f32[SIMD_LANES], 64);
+        const uint8_t *p[SIMD_LANES];
+        uint64_t stride[SIMD_LANES], t[SIMD_LANES], inc[SIMD_LANES];
+        uint64_t f[SIMD_LANES];
+        simd_t h[8], v[16], m[16];
+        uint64_t n;
+        unsigned i, r, lane;
+
+        blake2_lanes_setup(&state->lanes, SIMD_LANES, BLAKE2S_BLOCK_SIZE,
+                           p, stride, t, inc, f);
+
+        for (lane = 0; lane < SIMD_LANES; lane++)
+                f32[lane] = (uint32_t) f[lane];
+        for (i = 0; i < 8; i++)
+                h[i] = SIMD_LOAD(state->h[i]);
+
+        for (n = 0; n < num_blocks; n++) {
+                for (lane = 0; lane < SIMD_LANES; lane++) {
+                        t[lane] += inc[lane];
+                        t_lo[lane] = (uint32_t) t[lane];
+                        t_hi[lane] = (uint32_t) (t[lane] >> 32);
+                }
+                for (i = 0; i < 16; i++)
+                        m[i] = simd_load_lanes(p, i * 4);
+
+                for (i = 0; i < 8; i++) {
+                        v[i] = h[i];
+                        v[i + 8] = SIMD_SET1(blake2s_iv[i]);
+                }
+                v[12] = SIMD_XOR(v[12], SIMD_LOAD(t_lo));
+                v[13] = SIMD_XOR(v[13], SIMD_LOAD(t_hi));
+                v[14] = SIMD_XOR(v[14], SIMD_LOAD(f32));
+
+                for (r = 0; r < BLAKE2S_ROUNDS; r++)
+                        BLAKE2_ROUND(blake2s_g, v, m, blake2_sigma[r]);
+
+                for (i = 0; i < 8; i++)
+                        h[i] = SIMD_XOR(h[i], SIMD_XOR(v[i], v[i + 8]));
+
+                for (lane = 0; lane < SIMD_LANES; lane++)
+                        p[lane] += stride[lane];
+        }
+
+        for (i = 0; i < 8; i++)
+                SIMD_STORE(state->h[i], h[i]);
+
+        blake2_lanes_update(&state->lanes, SIMD_LANES, num_blocks, p, t);
+}
+
+JOB_AES_HMAC *
+SUBMIT_JOB_BLAKE2B(MB_MGR_BLAKE2B_OOO *state, JOB_AES_HMAC *job)
+{
+        return blake2b_ooo_submit(state, job, SIMD64_LANES,
+                                  blake2b_compress_lanes);
+}
+
+JOB_AES_HMAC *
+FLUSH_JOB_BLAKE2B(MB_MGR_BLAKE2B_OOO *state)
+{
+        return blake2b_ooo_flush(state, SIMD64_LANES, blake2b_compress_lanes);
+}
+
+JOB_AES_HMAC *
+SUBMIT_JOB_BLAKE2S(MB_MGR_BLAKE2S_OOO *state, JOB_AES_HMAC *job)
+{
+        return blake2s_ooo_submit(state, job, SIMD_LANES,
+                                  blake2s_compress_lanes);
+}
+
+JOB_AES_HMAC *
+FLUSH_JOB_BLAKE2S(MB_MGR_BLAKE2S_OOO *state)
+{
+        return blake2s_ooo_flush(state, SIMD_LANES, blake2s_compress_lanes);
+}
@@ -0,0 +1,206 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * Reflected CRC32 (Ethernet FCS) computation building blocks
+ *
+ * CRC is folded with carry-less multiply (PCLMULQDQ) 4 x 128 bits at a time,
+ * then 128 bits at a time and finally reduced to 32 bits with
+ * Barrett reduction. Remaining bytes are processed with a nibble look-up
+ * table. Constants come from "Fast CRC Computation for Generic Polynomials
+ * Using PCLMULQDQ Instruction" Intel white paper (bit-reflected domain).
+ *
+ * This file is included by architecture specific modules and it is
+ * compiled with architecture specific compiler options.
+ */
+
+#ifndef CRC32_REFL_H
+#define CRC32_REFL_H
+
+#include <stdint.h>
+#include <wmmintrin.h>
+#include <smmintrin.h>
+
+#include "intel-ipsec-mb.h"
+
+/*
+ * Folding constants (bit-reflected): low 64 bits hold x^(N+32) mod P(x)
+ * and high 64 bits hold x^(N-32) mod P(x), for folding distance N bits.
+ */
+#define CRC32_REFL_K_512() _mm_set_epi64x(0x1c6e41596, 0x154442bd4)
+#define CRC32_REFL_K_128() _mm_set_epi64x(0x0ccaa009e, 0x1751997d0)
+/* x^64 mod P(x) (bit-reflected) for 64 to 32 bit fold */
+#define CRC32_REFL_K_64()  _mm_set_epi64x(0, 0x163cd6124)
+/* Barrett reduction constants: low 64 bits P(x)' and high 64 bits mu' */
+#define CRC32_REFL_POLY()  _mm_set_epi64x(0x1f7011641, 0x1db710641)
+
+/**
+ * @brief Updates reflected CRC32 value with a nibble at a time
+ *
+ * @param crc current CRC32 value (not complemented)
+ * @param p pointer to data
+ * @param len number of bytes to process
+ *
+ * @return updated CRC32 value
+ */
+__forceinline
+uint32_t
+crc32_refl_nibble(uint32_t crc, const uint8_t *p, uint64_t len)
+{
+        static const uint32_t nibble_table[16] = {
+                0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac,
+                0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+                0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c,
+                0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c
+        };
+
+        while (len--) {
+                crc ^= *p++;
+                crc = (crc >> 4) ^ nibble_table[crc & 15];
+                crc = (crc >> 4) ^ nibble_table[crc & 15];
+        }
+        return crc;
+}
+
+/**
+ * @brief Folds 128-bit CRC state into the next 128-bit block
+ *
+ * @param x current 128-bit CRC state
+ * @param k folding constants
+ * @param data next 128-bit data block
+ *
+ * @return new 128-bit CRC state
+ */
+__forceinline
+__m128i
+crc32_refl_fold_128(const __m128i x, const __m128i k, const __m128i data)
+{
+        return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00),
+                                           _mm_clmulepi64_si128(x, k, 0x11)),
+                             data);
+}
+
+/**
+ * @brief Folds 128-bit CRC state over 16-byte blocks and reduces it
+ *        to 32-bit CRC value
+ *
+ * @param x 128-bit CRC state
+ * @param p pointer to data blocks
+ * @param len number of bytes (multiple of 16) to fold in
+ *
+ * @return 32-bit CRC value (not complemented)
+ */
+__forceinline
+uint32_t
+crc32_refl_fold_reduce(__m128i x, const uint8_t *p, uint64_t len)
+{
+        const __m128i k = CRC32_REFL_K_128();
+        const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+        const __m128i poly = CRC32_REFL_POLY();
+        __m128i t;
+
+        for (; len >= 16; len -= 16, p += 16)
+                x = crc32_refl_fold_128(x, k,
+                                        _mm_loadu_si128((const __m128i *) p));
+
+        /* fold 128 bits to 64 bits */
+        t = _mm_clmulepi64_si128(x, k, 0x10);
+        x = _mm_xor_si128(_mm_srli_si128(x, 8), t);
+
+        /* fold 64 bits to 32 bits */
+        t = _mm_srli_si128(x, 4);
+        x = _mm_and_si128(x, mask32);
+        x = _mm_clmulepi64_si128(x, CRC32_REFL_K_64(), 0x00);
+        x = _mm_xor_si128(x, t);
+
+        /* Barrett reduction to 32 bits */
+        t = _mm_and_si128(x, mask32);
+        t = _mm_clmulepi64_si128(t, poly, 0x10);
+        t = _mm_and_si128(t, mask32);
+        t = _mm_clmulepi64_si128(t, poly, 0x00);
+        x = _mm_xor_si128(x, t);
+
+        return (uint32_t) _mm_extract_epi32(x, 1);
+}
+
+/**
+ * @brief Computes reflected CRC32 with PCLMULQDQ
+ *
+ * @param crc initial CRC32 value (not complemented)
+ * @param msg pointer to data
+ * @param len data length in bytes
+ *
+ * @return CRC32 value (not complemented)
+ */
+__forceinline
+uint32_t
+crc32_refl_pclmul(uint32_t crc, const void *msg, uint64_t len)
+{
+        const uint8_t *p = (const uint8_t *) msg;
+        uint64_t blocks_len;
+        __m128i x0;
+
+        if (len < 16)
+                return crc32_refl_nibble(crc, p, len);
+
+        x0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) p),
+                           _mm_cvtsi32_si128((int) crc));
+
+        if (len >= 64) {
+                const __m128i k = CRC32_REFL_K_512();
+                __m128i x1 = _mm_loadu_si128((const __m128i *) &p[16]);
+                __m128i x2 = _mm_loadu_si128((const __m128i *) &p[32]);
+                __m128i x3 = _mm_loadu_si128((const __m128i *) &p[48]);
+                const __m128i k_128 = CRC32_REFL_K_128();
+
+                for (p += 64, len -= 64; len >= 64; p += 64, len -= 64) {
+                        x0 = crc32_refl_fold_128(x0, k, _mm_loadu_si128
+                                                 ((const __m128i *) &p[0]));
+                        x1 = crc32_refl_fold_128(x1, k, _mm_loadu_si128
+                                                 ((const __m128i *) &p[16]));
+                        x2 = crc32_refl_fold_128(x2, k, _mm_loadu_si128
+                                                 ((const __m128i *) &p[32]));
+                        x3 = crc32_refl_fold_128(x3, k, _mm_loadu_si128
+                                                 ((const __m128i *) &p[48]));
+                }
+
+                /* fold 4 x 128 bits into 128 bits */
+                x0 = crc32_refl_fold_128(x0, k_128, x1);
+                x0 = crc32_refl_fold_128(x0, k_128, x2);
+                x0 = crc32_refl_fold_128(x0, k_128, x3);
+        } else {
+                p += 16;
+                len -= 16;
+        }
+
+        blocks_len = len & (~UINT64_C(15));
+        crc = crc32_refl_fold_reduce(x0, p, blocks_len);
+
+        return crc32_refl_nibble(crc, p + blocks_len, len - blocks_len);
+}
+
+#endif /* CRC32_REFL_H */
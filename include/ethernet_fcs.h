@@ -0,0 +1,59 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* Ethernet FCS (CRC32) architecture specific implementations */
+
+#ifndef ETHERNET_FCS_H
+#define ETHERNET_FCS_H
+
+#include <stdint.h>
+#include "intel-ipsec-mb.h"
+
+/**
+ * @brief Computes Ethernet FCS (CRC32, IEEE 802.3)
+ *
+ * Allows to compute FCS over a message split into segments.
+ * For the first segment \a fcs has to be 0 and for the following ones
+ * FCS returned for the previous segment has to be passed.
+ *
+ * @param fcs FCS value of the preceding segment(s) or 0
+ * @param msg pointer to the message segment
+ * @param len message segment length in bytes
+ *
+ * @return FCS value (to be stored in little endian byte order)
+ */
+IMB_DLL_LOCAL uint32_t
+ethernet_fcs_sse_no_aesni(const uint32_t fcs, const void *msg,
+                          const uint64_t len);
+IMB_DLL_LOCAL uint32_t
+ethernet_fcs_sse(const uint32_t fcs, const void *msg, const uint64_t len);
+IMB_DLL_LOCAL uint32_t
+ethernet_fcs_avx(const uint32_t fcs, const void *msg, const uint64_t len);
+IMB_DLL_LOCAL uint32_t
+ethernet_fcs_avx512(const uint32_t fcs, const void *msg, const uint64_t len);
+
+#endif /* ETHERNET_FCS_H */
@@ -451,6 +451,18 @@ IMB_DLL_EXPORT void
 aes_gcm_pre_192_sse_no_aesni(const void *key, struct gcm_key_data *key_data);
 IMB_DLL_EXPORT void
 aes_gcm_pre_256_sse_no_aesni(const void *key, struct gcm_key_data *key_data);
+IMB_DLL_EXPORT void
+aes_gcm_pre_128_mb_sse_no_aesni(const void *const *keys,
+                                struct gcm_key_data *const *key_data,
+                                const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_192_mb_sse_no_aesni(const void *const *keys,
+                                struct gcm_key_data *const *key_data,
+                                const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_256_mb_sse_no_aesni(const void *const *keys,
+                                struct gcm_key_data *const *key_data,
+                                const uint32_t num_keys);
 
 #endif /* _GCM_H_ */
 #endif /* NO_GCM */
@@ -0,0 +1,237 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * PCLMULQDQ based GHASH (see "Intel Carry-Less Multiplication Instruction
+ * and its Usage for Computing the GCM Mode", algorithms 1, 4 and 5).
+ *
+ * Blocks and hash keys are kept byte reflected, so the 256-bit product
+ * has to be shifted left by one bit before the reduction.
+ * Products with 4 powers of the hash key are added up before reducing.
+ *
+ * POLYVAL (RFC 8452) is GHASH on byte reversed blocks with the hash key
+ * multiplied by x, so it is computed by the same code on blocks loaded
+ * as they are (see polyval_clmul_update()).
+ */
+
+#ifndef GHASH_CLMUL_H
+#define GHASH_CLMUL_H
+
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+#include "intel-ipsec-mb.h"
+
+/* reverses byte order of a block */
+__forceinline __m128i
+ghash_bswap(const __m128i x)
+{
+        return _mm_shuffle_epi8(x, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8,
+                                                9, 10, 11, 12, 13, 14, 15));
+}
+
+/* adds the 256-bit carry-less product of a and b to lo, mid and hi */
+__forceinline void
+ghash_clmul_acc(const __m128i a, const __m128i b,
+                __m128i *lo, __m128i *mid, __m128i *hi)
+{
+        *lo = _mm_xor_si128(*lo, _mm_clmulepi64_si128(a, b, 0x00));
+        *hi = _mm_xor_si128(*hi, _mm_clmulepi64_si128(a, b, 0x11));
+        *mid = _mm_xor_si128(*mid,
+                             _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10),
+                                           _mm_clmulepi64_si128(a, b, 0x01)));
+}
+
+/* reduces the product from ghash_clmul_acc() */
+__forceinline __m128i
+ghash_reduce(__m128i lo, const __m128i mid, __m128i hi)
+{
+        __m128i t1, t2, t3;
+
+        lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+        hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+        /* shift hi:lo left by one bit */
+        t1 = _mm_srli_epi32(lo, 31);
+        t2 = _mm_srli_epi32(hi, 31);
+        lo = _mm_slli_epi32(lo, 1);
+        hi = _mm_slli_epi32(hi, 1);
+        hi = _mm_or_si128(hi, _mm_srli_si128(t1, 12));
+        hi = _mm_or_si128(hi, _mm_slli_si128(t2, 4));
+        lo = _mm_or_si128(lo, _mm_slli_si128(t1, 4));
+
+        /* first phase of the reduction */
+        t1 = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(lo, 31),
+                                         _mm_slli_epi32(lo, 30)),
+                           _mm_slli_epi32(lo, 25));
+        t3 = _mm_srli_si128(t1, 4);
+        lo = _mm_xor_si128(lo, _mm_slli_si128(t1, 12));
+
+        /* second phase of the reduction */
+        t2 = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(lo, 1),
+                                         _mm_srli_epi32(lo, 2)),
+                           _mm_xor_si128(_mm_srli_epi32(lo, 7), t3));
+        lo = _mm_xor_si128(lo, t2);
+
+        return _mm_xor_si128(hi, lo);
+}
+
+/* multiplies a and b, both byte reflected */
+__forceinline __m128i
+ghash_clmul_mul(const __m128i a, const __m128i b)
+{
+        __m128i lo = _mm_setzero_si128();
+        __m128i mid = _mm_setzero_si128();
+        __m128i hi = _mm_setzero_si128();
+
+        ghash_clmul_acc(a, b, &lo, &mid, &hi);
+        return ghash_reduce(lo, mid, hi);
+}
+
+/* loads a block, byte reversing it for GHASH */
+__forceinline __m128i
+ghash_load_block(const void *p, const int reflect)
+{
+        const __m128i d = _mm_loadu_si128((const __m128i *) p);
+
+        return reflect ? ghash_bswap(d) : d;
+}
+
+/* GHASH (reflect set) or POLYVAL update, see ghash_clmul_update() */
+__forceinline __m128i
+ghash_clmul_update_common(const uint8_t hkey[4][GCM_BLOCK_LEN], __m128i x,
+                          const uint8_t *data, uint64_t len,
+                          const int reflect)
+{
+        const __m128i h4 = _mm_load_si128((const __m128i *) hkey[0]);
+        const __m128i h3 = _mm_load_si128((const __m128i *) hkey[1]);
+        const __m128i h2 = _mm_load_si128((const __m128i *) hkey[2]);
+        const __m128i h1 = _mm_load_si128((const __m128i *) hkey[3]);
+        __m128i lo, mid, hi, d;
+
+        for (; len >= 4 * GCM_BLOCK_LEN;
+             len -= 4 * GCM_BLOCK_LEN, data += 4 * GCM_BLOCK_LEN) {
+                lo = _mm_setzero_si128();
+                mid = _mm_setzero_si128();
+                hi = _mm_setzero_si128();
+                d = ghash_load_block(data, reflect);
+                ghash_clmul_acc(_mm_xor_si128(x, d), h4, &lo, &mid, &hi);
+                d = ghash_load_block(&data[16], reflect);
+                ghash_clmul_acc(d, h3, &lo, &mid, &hi);
+                d = ghash_load_block(&data[32], reflect);
+                ghash_clmul_acc(d, h2, &lo, &mid, &hi);
+                d = ghash_load_block(&data[48], reflect);
+                ghash_clmul_acc(d, h1, &lo, &mid, &hi);
+                x = ghash_reduce(lo, mid, hi);
+        }
+
+        while (len != 0) {
+                if (len >= GCM_BLOCK_LEN) {
+                        d = ghash_load_block(data, reflect);
+                        len -= GCM_BLOCK_LEN;
+                        data += GCM_BLOCK_LEN;
+                } else {
+                        uint8_t last[GCM_BLOCK_LEN];
+
+                        memset(last, 0, sizeof(last));
+                        memcpy(last, data, len);
+                        d = ghash_load_block(last, reflect);
+                        len = 0;
+                }
+                x = ghash_clmul_mul(_mm_xor_si128(x, d), h1);
+        }
+        return x;
+}
+
+/**
+ * @brief GHASH update
+ *
+ * Last partial block of data is padded with zeros.
+ *
+ * @param hkey HashKey^4, HashKey^3, HashKey^2 and HashKey, byte reflected
+ * @param x hash value, byte reflected
+ * @param data input data
+ * @param len length of data in bytes
+ *
+ * @return updated hash value, byte reflected
+ */
+__forceinline __m128i
+ghash_clmul_update(const uint8_t hkey[4][GCM_BLOCK_LEN], __m128i x,
+                   const uint8_t *data, uint64_t len)
+{
+        return ghash_clmul_update_common(hkey, x, data, len, 1);
+}
+
+/**
+ * @brief POLYVAL update
+ *
+ * Last partial block of data is padded with zeros.
+ *
+ * @param hkey powers 4 to 1 of the GHASH key, byte reflected
+ *             (see polyval_clmul_hkey())
+ * @param x POLYVAL value
+ * @param data input data
+ * @param len length of data in bytes
+ *
+ * @return updated POLYVAL value
+ */
+__forceinline __m128i
+polyval_clmul_update(const uint8_t hkey[4][GCM_BLOCK_LEN], __m128i x,
+                     const uint8_t *data, uint64_t len)
+{
+        return ghash_clmul_update_common(hkey, x, data, len, 0);
+}
+
+/**
+ * @brief Computes GHASH key powers for POLYVAL
+ *
+ * @param h POLYVAL key (RFC 8452 H), as loaded from memory
+ * @param hkey powers 4 to 1 of the GHASH key (mulX_GHASH(ByteReverse(H))),
+ *             byte reflected
+ */
+__forceinline void
+polyval_clmul_hkey(const __m128i h, uint8_t hkey[4][GCM_BLOCK_LEN])
+{
+        /* multiplication by x is a right shift in the reflected domain */
+        const uint64_t lo = (uint64_t) _mm_cvtsi128_si64(h);
+        const uint64_t hi = (uint64_t) _mm_cvtsi128_si64(_mm_srli_si128(h,
+                                                                        8));
+        const uint64_t r = (lo & 1) ? UINT64_C(0xe100000000000000) : 0;
+        const __m128i h1 = _mm_set_epi64x((long long) ((hi >> 1) ^ r),
+                                          (long long) ((lo >> 1) |
+                                                       (hi << 63)));
+        const __m128i h2 = ghash_clmul_mul(h1, h1);
+        const __m128i h3 = ghash_clmul_mul(h2, h1);
+
+        _mm_store_si128((__m128i *) hkey[3], h1);
+        _mm_store_si128((__m128i *) hkey[2], h2);
+        _mm_store_si128((__m128i *) hkey[1], h3);
+        _mm_store_si128((__m128i *) hkey[0], ghash_clmul_mul(h3, h1));
+}
+
+#endif /* GHASH_CLMUL_H */
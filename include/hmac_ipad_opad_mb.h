@@ -0,0 +1,325 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * Multi-key HMAC ipad/opad precompute, with #define's to build an SSE, AVX,
+ * AVX2 or AVX512 version (see sse/hmac_ipad_opad_mb_sse.c, etc.)
+ *
+ * The following have to be defined before inclusion:
+ * - HMAC_IPAD_OPAD_MB - name of API function
+ * - SHA1_MB, SHA1_MB_LANES - multi-buffer SHA1 kernel and its lanes
+ * - SHA256_MB, SHA256_MB_LANES - multi-buffer SHA224/256 kernel and its lanes
+ * - SHA512_MB, SHA512_MB_LANES - multi-buffer SHA384/512 kernel and its lanes
+ *   (the kernels are called through the C ABI compliant entry points from
+ *   include/sha_mb_entry.asm, e.g. sha1_mb_sse() for sha1_mult_sse())
+ * - SHA1_HASH, SHA224_HASH, SHA256_HASH, SHA384_HASH, SHA512_HASH,
+ *   SHA512_256_HASH, SHA512_224_HASH - single buffer hash functions
+ *   (for keys longer than the block size)
+ * - SAVE_XMMS, RESTORE_XMMS - XMM save/restore functions (Windows only)
+ * - HMAC_IPAD_OPAD_MB_ZEROUPPER (optional) - clear upper halves of YMM/ZMM
+ *   registers after the kernels
+ *
+ * The key XOR ipad and key XOR opad blocks of all keys are independent
+ * one block hashes, so they are spread across lanes of the multi-buffer
+ * SHA kernels (ipad and opad of one key go to adjacent lanes).
+ * The outputs are the digest words in CPU byte order, the same as
+ * sha1_one_block_sse() etc. produce for the _hashed_auth_key_xor_ipad
+ * and _hashed_auth_key_xor_opad fields of the job.
+ */
+
+#include <string.h>
+#ifdef HMAC_IPAD_OPAD_MB_ZEROUPPER
+#include <immintrin.h>
+#endif
+
+#include "intel-ipsec-mb.h"
+#include "constants.h"
+#ifndef LINUX
+#include "save_xmms.h"
+#endif
+
+extern void SHA1_MB(SHA1_ARGS *args, uint64_t num_blocks);
+extern void SHA256_MB(SHA256_ARGS *args, uint64_t num_blocks);
+extern void SHA512_MB(SHA512_ARGS *args, uint64_t num_blocks);
+
+#define HMAC_IPAD_OPAD_MB_MAX_LANES 16
+
+/* hash algorithm parameters */
+struct hmac_ipad_opad_alg {
+        unsigned block_size;
+        unsigned lanes;
+        /* digest (state) word size in bytes and number of words */
+        unsigned word_size;
+        unsigned num_words;
+        /* row of a digest word in the kernel arguments, in words */
+        unsigned row_size;
+        const void *init_digest;
+        /* hash function and its digest size, to shorten long keys */
+        void (*hash)(const void *, const uint64_t, void *);
+        unsigned digest_size;
+};
+
+static const uint32_t hmac_ipad_opad_sha1_h[NUM_SHA_DIGEST_WORDS] = {
+        H0, H1, H2, H3, H4
+};
+
+static const uint32_t hmac_ipad_opad_sha224_h[NUM_SHA_256_DIGEST_WORDS] = {
+        SHA224_H0, SHA224_H1, SHA224_H2, SHA224_H3,
+        SHA224_H4, SHA224_H5, SHA224_H6, SHA224_H7
+};
+
+static const uint32_t hmac_ipad_opad_sha256_h[NUM_SHA_256_DIGEST_WORDS] = {
+        SHA256_H0, SHA256_H1, SHA256_H2, SHA256_H3,
+        SHA256_H4, SHA256_H5, SHA256_H6, SHA256_H7
+};
+
+static const uint64_t hmac_ipad_opad_sha384_h[NUM_SHA_512_DIGEST_WORDS] = {
+        SHA384_H0, SHA384_H1, SHA384_H2, SHA384_H3,
+        SHA384_H4, SHA384_H5, SHA384_H6, SHA384_H7
+};
+
+static const uint64_t hmac_ipad_opad_sha512_h[NUM_SHA_512_DIGEST_WORDS] = {
+        SHA512_H0, SHA512_H1, SHA512_H2, SHA512_H3,
+        SHA512_H4, SHA512_H5, SHA512_H6, SHA512_H7
+};
+
+static const uint64_t
+hmac_ipad_opad_sha512_256_h[NUM_SHA_512_DIGEST_WORDS] = {
+        SHA512_256_H0, SHA512_256_H1, SHA512_256_H2, SHA512_256_H3,
+        SHA512_256_H4, SHA512_256_H5, SHA512_256_H6, SHA512_256_H7
+};
+
+static const uint64_t
+hmac_ipad_opad_sha512_224_h[NUM_SHA_512_DIGEST_WORDS] = {
+        SHA512_224_H0, SHA512_224_H1, SHA512_224_H2, SHA512_224_H3,
+        SHA512_224_H4, SHA512_224_H5, SHA512_224_H6, SHA512_224_H7
+};
+
+/**
+ * @brief Sets hash algorithm parameters
+ *
+ * @param alg parameters to set
+ * @param hash_alg HMAC hash algorithm
+ *
+ * @return 0 on success, -1 if \a hash_alg is not supported
+ */
+static int
+hmac_ipad_opad_alg_set(struct hmac_ipad_opad_alg *alg,
+                       const JOB_HASH_ALG hash_alg)
+{
+        switch (hash_alg) {
+        case SHA1:
+                alg->block_size = SHA1_BLOCK_SIZE;
+                alg->lanes = SHA1_MB_LANES;
+                alg->word_size = 4;
+                alg->num_words = NUM_SHA_DIGEST_WORDS;
+                alg->row_size = AVX512_NUM_SHA1_LANES;
+                alg->init_digest = hmac_ipad_opad_sha1_h;
+                alg->hash = SHA1_HASH;
+                alg->digest_size = SHA1_DIGEST_SIZE_IN_BYTES;
+                break;
+        case SHA_224:
+        case SHA_256:
+                alg->block_size = SHA_256_BLOCK_SIZE;
+                alg->lanes = SHA256_MB_LANES;
+                alg->word_size = 4;
+                alg->num_words = NUM_SHA_256_DIGEST_WORDS;
+                alg->row_size = AVX512_NUM_SHA256_LANES;
+                if (hash_alg == SHA_224) {
+                        alg->init_digest = hmac_ipad_opad_sha224_h;
+                        alg->hash = SHA224_HASH;
+                        alg->digest_size = SHA224_DIGEST_SIZE_IN_BYTES;
+                } else {
+                        alg->init_digest = hmac_ipad_opad_sha256_h;
+                        alg->hash = SHA256_HASH;
+                        alg->digest_size = SHA256_DIGEST_SIZE_IN_BYTES;
+                }
+                break;
+        case SHA_384:
+        case SHA_512:
+        case SHA_512_256:
+        case SHA_512_224:
+                alg->block_size = SHA_512_BLOCK_SIZE;
+                alg->lanes = SHA512_MB_LANES;
+                alg->word_size = 8;
+                alg->num_words = NUM_SHA_512_DIGEST_WORDS;
+                alg->row_size = AVX512_NUM_SHA512_LANES;
+                if (hash_alg == SHA_384) {
+                        alg->init_digest = hmac_ipad_opad_sha384_h;
+                        alg->hash = SHA384_HASH;
+                        alg->digest_size = SHA384_DIGEST_SIZE_IN_BYTES;
+                } else if (hash_alg == SHA_512) {
+                        alg->init_digest = hmac_ipad_opad_sha512_h;
+                        alg->hash = SHA512_HASH;
+                        alg->digest_size = SHA512_DIGEST_SIZE_IN_BYTES;
+                } else if (hash_alg == SHA_512_256) {
+                        alg->init_digest = hmac_ipad_opad_sha512_256_h;
+                        alg->hash = SHA512_256_HASH;
+                        alg->digest_size = SHA512_256_DIGEST_SIZE_IN_BYTES;
+                } else {
+                        alg->init_digest = hmac_ipad_opad_sha512_224_h;
+                        alg->hash = SHA512_224_HASH;
+                        alg->digest_size = SHA512_224_DIGEST_SIZE_IN_BYTES;
+                }
+                break;
+        default:
+                return -1;
+        }
+
+        return 0;
+}
+
+/**
+ * @brief Prepares key XOR ipad and key XOR opad blocks
+ *
+ * @param alg hash algorithm parameters
+ * @param key HMAC key
+ * @param key_len key length in bytes
+ * @param ipad_block buffer for the key XOR ipad block
+ * @param opad_block buffer for the key XOR opad block
+ */
+static void
+hmac_ipad_opad_blocks(const struct hmac_ipad_opad_alg *alg,
+                      const void *key, const uint64_t key_len,
+                      uint8_t *ipad_block, uint8_t *opad_block)
+{
+        DECLARE_ALIGNED(uint8_t key_digest[SHA512_DIGEST_SIZE_IN_BYTES], 16);
+        const uint8_t *k = (const uint8_t *) key;
+        uint64_t len = key_len;
+        unsigned i;
+
+        if (key_len > alg->block_size) {
+                alg->hash(key, key_len, key_digest);
+                k = key_digest;
+                len = alg->digest_size;
+        }
+
+        memset(ipad_block, 0x36, alg->block_size);
+        memset(opad_block, 0x5c, alg->block_size);
+        for (i = 0; i < len; i++) {
+                ipad_block[i] ^= k[i];
+                opad_block[i] ^= k[i];
+        }
+}
+
+int
+HMAC_IPAD_OPAD_MB(const JOB_HASH_ALG hash_alg,
+                  const void *const *keys, const uint64_t *key_lens,
+                  void *const *ipad_hashes, void *const *opad_hashes,
+                  const uint32_t num_keys)
+{
+        DECLARE_ALIGNED(uint8_t blocks[HMAC_IPAD_OPAD_MB_MAX_LANES]
+                        [SHA_512_BLOCK_SIZE], 16);
+        union {
+                SHA1_ARGS sha1;
+                SHA256_ARGS sha256;
+                SHA512_ARGS sha512;
+        } args;
+        struct hmac_ipad_opad_alg alg;
+        uint8_t *digest;
+        uint8_t **data_ptr;
+        uint32_t key;
+        unsigned lane, w;
+#ifndef LINUX
+        DECLARE_ALIGNED(uint128_t xmm_save[10], 16);
+#endif
+
+        if (hmac_ipad_opad_alg_set(&alg, hash_alg) != 0)
+                return -1;
+        if (num_keys == 0)
+                return 0;
+        if (keys == NULL || key_lens == NULL ||
+            ipad_hashes == NULL || opad_hashes == NULL)
+                return -1;
+
+        if (alg.word_size == 8) {
+                digest = (uint8_t *) args.sha512.digest;
+                data_ptr = args.sha512.data_ptr;
+        } else if (alg.num_words == NUM_SHA_256_DIGEST_WORDS) {
+                digest = (uint8_t *) args.sha256.digest;
+                data_ptr = args.sha256.data_ptr;
+        } else {
+                digest = (uint8_t *) args.sha1.digest;
+                data_ptr = args.sha1.data_ptr;
+        }
+
+#ifndef LINUX
+        SAVE_XMMS(xmm_save);
+#endif
+        /* lanes is even, so ipad and opad of a key are in one batch */
+        for (key = 0; key < num_keys; key += alg.lanes / 2) {
+                const unsigned n = ((num_keys - key) < (alg.lanes / 2)) ?
+                        (num_keys - key) : (alg.lanes / 2);
+
+                for (lane = 0; lane < alg.lanes; lane++) {
+                        /* unused lanes hash the first block again */
+                        data_ptr[lane] = (lane < (2 * n)) ?
+                                blocks[lane] : blocks[0];
+                        for (w = 0; w < alg.num_words; w++)
+                                memcpy(&digest[(w * alg.row_size + lane) *
+                                               alg.word_size],
+                                       (const uint8_t *) alg.init_digest +
+                                       (w * alg.word_size), alg.word_size);
+                }
+                for (lane = 0; lane < n; lane++)
+                        hmac_ipad_opad_blocks(&alg, keys[key + lane],
+                                              key_lens[key + lane],
+                                              blocks[2 * lane],
+                                              blocks[2 * lane + 1]);
+
+                if (alg.word_size == 8)
+                        SHA512_MB(&args.sha512, 1);
+                else if (alg.num_words == NUM_SHA_256_DIGEST_WORDS)
+                        SHA256_MB(&args.sha256, 1);
+                else
+                        SHA1_MB(&args.sha1, 1);
+
+                for (lane = 0; lane < (2 * n); lane++) {
+                        uint8_t *out = (uint8_t *) ((lane & 1) ?
+                                opad_hashes[key + lane / 2] :
+                                ipad_hashes[key + lane / 2]);
+
+                        for (w = 0; w < alg.num_words; w++)
+                                memcpy(&out[w * alg.word_size],
+                                       &digest[(w * alg.row_size + lane) *
+                                               alg.word_size],
+                                       alg.word_size);
+                }
+        }
+#ifdef HMAC_IPAD_OPAD_MB_ZEROUPPER
+        _mm256_zeroupper();
+#endif
+#ifndef LINUX
+        RESTORE_XMMS(xmm_save);
+#endif
+
+        /* clear key material */
+        memset(blocks, 0, sizeof(blocks));
+        memset(&args, 0, sizeof(args));
+
+        return 0;
+}
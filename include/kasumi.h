@@ -0,0 +1,116 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* KASUMI (3GPP UEA1 and UIA1) */
+
+#ifndef KASUMI_H
+#define KASUMI_H
+
+#include <stdint.h>
+#include "intel-ipsec-mb.h"
+
+/* number of 16-bit round subkeys (8 per round) */
+#define KASUMI_NUM_SUBKEYS (8 * 8)
+
+/* S-box look-up tables */
+extern IMB_DLL_LOCAL const uint32_t kasumi_s7_tab[128];
+extern IMB_DLL_LOCAL const uint32_t kasumi_s9_tab[512];
+
+/**
+ * @brief Loads key and IV into a lane of the KASUMI out of order manager
+ *
+ * Round subkeys of the lane are set up and register A is computed
+ * by encrypting the IV with the modified key.
+ *
+ * @param ooo pointer to KASUMI out of order manager (MB_MGR_KASUMI_OOO)
+ * @param lane lane index
+ * @param key pointer to 16 byte key
+ * @param iv pointer to 8 byte IV
+ */
+IMB_DLL_LOCAL void
+kasumi_ooo_load_lane(void *ooo, const unsigned lane,
+                     const uint8_t *key, const uint8_t *iv);
+
+/**
+ * @brief UEA1 encryption/decryption of a bit string not starting
+ *        on a byte boundary
+ *
+ * Bits of \a out outside of the ciphered range are left unchanged.
+ *
+ * @param key pointer to 16 byte confidentiality key
+ * @param iv pointer to 8 byte IV
+ * @param in pointer to the byte holding the first input bit
+ * @param out pointer to the byte holding the first output bit
+ * @param len_bits number of bits to process
+ * @param offset_bits bit position of the first bit (0 is the MSB of
+ *                    the first byte)
+ */
+IMB_DLL_LOCAL void
+kasumi_f8_1_buffer_bit(const uint8_t *key, const uint8_t *iv,
+                       const uint8_t *in, uint8_t *out,
+                       const uint64_t len_bits, const uint64_t offset_bits);
+
+/**
+ * @brief Computes UIA1 MAC
+ *
+ * @param key pointer to 16 byte integrity key
+ * @param iv pointer to 8 byte COUNT || FRESH
+ * @param direction direction bit (0 or 1)
+ * @param msg pointer to the message
+ * @param len_bits message length in bits
+ * @param mac pointer to 4 byte MAC output
+ */
+IMB_DLL_LOCAL void
+kasumi_f9_1_buffer(const uint8_t *key, const uint8_t *iv,
+                   const uint64_t direction, const void *msg,
+                   const uint64_t len_bits, uint8_t *mac);
+
+/*
+ * Multi-buffer UEA1 out of order manager functions.
+ * The same manager is used to encrypt and decrypt.
+ */
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_kasumi_uea1_sse(MB_MGR_KASUMI_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_kasumi_uea1_sse(MB_MGR_KASUMI_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_kasumi_uea1_avx(MB_MGR_KASUMI_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_kasumi_uea1_avx(MB_MGR_KASUMI_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_kasumi_uea1_avx2(MB_MGR_KASUMI_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_kasumi_uea1_avx2(MB_MGR_KASUMI_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_kasumi_uea1_avx512(MB_MGR_KASUMI_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_kasumi_uea1_avx512(MB_MGR_KASUMI_OOO *state);
+
+#endif /* KASUMI_H */
@@ -0,0 +1,178 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * Multi-buffer KASUMI (UEA1) code, with #define's to build
+ * an SSE, AVX, AVX2 or AVX512 version (see sse/kasumi_sse.c,
+ * avx/kasumi_avx.c, etc.)
+ *
+ * The following have to be defined before inclusion:
+ * - SIMD_LANES - number of 32-bit lanes in a vector (see simd_lanes.h)
+ * - SUBMIT_JOB_KASUMI_UEA1, FLUSH_JOB_KASUMI_UEA1 - names of API functions
+ */
+
+#include "intel-ipsec-mb.h"
+#include "simd_lanes.h"
+#include "stream_ooo.h"
+#include "kasumi.h"
+
+/* rotate 16-bit values left */
+#define KASUMI_ROL16(_v, _n)                                            \
+        SIMD_AND(SIMD_OR(SIMD_SLL((_v), (_n)),                          \
+                         SIMD_SRL((_v), 16 - (_n))),                    \
+                 SIMD_SET1(0xffff))
+
+__forceinline
+simd_t
+kasumi_fi(const simd_t x, const simd_t ki)
+{
+        const simd_t l0 = SIMD_SRL(x, 7);
+        const simd_t r0 = SIMD_AND(x, SIMD_SET1(0x7f));
+        const simd_t r1 = SIMD_XOR(SIMD_GATHER(kasumi_s9_tab, l0), r0);
+        const simd_t l1 = SIMD_XOR(SIMD_GATHER(kasumi_s7_tab, r0),
+                                   SIMD_AND(r1, SIMD_SET1(0x7f)));
+        const simd_t l2 = SIMD_XOR(l1, SIMD_SRL(ki, 9));
+        const simd_t r2 = SIMD_XOR(r1, SIMD_AND(ki, SIMD_SET1(0x1ff)));
+        const simd_t r3 = SIMD_XOR(SIMD_GATHER(kasumi_s9_tab, r2), l2);
+        const simd_t l3 = SIMD_XOR(SIMD_GATHER(kasumi_s7_tab, l2),
+                                   SIMD_AND(r3, SIMD_SET1(0x7f)));
+
+        return SIMD_OR(SIMD_SLL(l3, 9), r3);
+}
+
+/* rk points to the 8 subkeys of the round */
+__forceinline
+simd_t
+kasumi_fo(const simd_t x, uint32_t rk[][AVX512_NUM_KASUMI_LANES])
+{
+        simd_t l = SIMD_SRL(x, 16);
+        simd_t r = SIMD_AND(x, SIMD_SET1(0xffff));
+        unsigned j;
+
+        for (j = 0; j < 3; j++) {
+                const simd_t t =
+                        SIMD_XOR(kasumi_fi(SIMD_XOR(l, SIMD_LOAD(rk[2 + j])),
+                                           SIMD_LOAD(rk[5 + j])), r);
+
+                l = r;
+                r = t;
+        }
+
+        return SIMD_OR(SIMD_SLL(l, 16), r);
+}
+
+__forceinline
+simd_t
+kasumi_fl(const simd_t x, uint32_t rk[][AVX512_NUM_KASUMI_LANES])
+{
+        simd_t l = SIMD_SRL(x, 16);
+        simd_t r = SIMD_AND(x, SIMD_SET1(0xffff));
+
+        r = SIMD_XOR(r, KASUMI_ROL16(SIMD_AND(l, SIMD_LOAD(rk[0])), 1));
+        l = SIMD_XOR(l, KASUMI_ROL16(SIMD_OR(r, SIMD_LOAD(rk[1])), 1));
+
+        return SIMD_OR(SIMD_SLL(l, 16), r);
+}
+
+/**
+ * @brief Encrypts one block for all lanes
+ *
+ * @param sk round subkeys, lane index is the column
+ * @param l pointer to the left (most significant) 32 bits of the block
+ * @param r pointer to the right 32 bits of the block
+ */
+__forceinline
+void
+kasumi_block(uint32_t sk[][AVX512_NUM_KASUMI_LANES], simd_t *l, simd_t *r)
+{
+        unsigned i;
+
+        /* two rounds at a time, so that halves don't need swapping */
+        for (i = 0; i < 8; i += 2) {
+                *r = SIMD_XOR(*r, kasumi_fo(kasumi_fl(*l, &sk[i * 8]),
+                                            &sk[i * 8]));
+                *l = SIMD_XOR(*l, kasumi_fl(kasumi_fo(*r, &sk[i * 8 + 8]),
+                                            &sk[i * 8 + 8]));
+        }
+}
+
+/* generates keystream blocks, 2 words each */
+static void
+kasumi_keystream(void *ooo, uint32_t ks[][STREAM_OOO_MAX_LANES])
+{
+        MB_MGR_KASUMI_OOO *state = (MB_MGR_KASUMI_OOO *) ooo;
+        const simd_t a_hi = SIMD_LOAD(state->a[0]);
+        const simd_t a_lo = SIMD_LOAD(state->a[1]);
+        simd_t hi = SIMD_LOAD(state->ksb[0]);
+        simd_t lo = SIMD_LOAD(state->ksb[1]);
+        simd_t blkcnt = SIMD_LOAD(state->blkcnt);
+        unsigned i;
+
+        for (i = 0; i < STREAM_OOO_KS_WORDS; i += 2) {
+                /* KSB(n) = KASUMI(A ^ BLKCNT ^ KSB(n - 1)) */
+                hi = SIMD_XOR(hi, a_hi);
+                lo = SIMD_XOR(SIMD_XOR(lo, a_lo), blkcnt);
+                kasumi_block(state->sk, &hi, &lo);
+                SIMD_STORE(ks[i], hi);
+                SIMD_STORE(ks[i + 1], lo);
+                blkcnt = SIMD_ADD(blkcnt, SIMD_SET1(1));
+        }
+
+        SIMD_STORE(state->ksb[0], hi);
+        SIMD_STORE(state->ksb[1], lo);
+        SIMD_STORE(state->blkcnt, blkcnt);
+}
+
+JOB_AES_HMAC *
+SUBMIT_JOB_KASUMI_UEA1(MB_MGR_KASUMI_OOO *state, JOB_AES_HMAC *job)
+{
+        const uint64_t offset = job->cipher_start_src_offset_in_bits;
+        const uint64_t len = job->msg_len_to_cipher_in_bits;
+        const uint8_t *in = job->src + (offset / 8);
+
+        if (offset & 7) {
+                /* ciphering doesn't start on byte boundary */
+                kasumi_f8_1_buffer_bit(job->aes_enc_key_expanded, job->iv,
+                                       in, job->dst, len, offset & 7);
+                job->status |= STS_COMPLETED_AES;
+                return job;
+        }
+
+        /* lanes are fully set up by load, no initialization rounds */
+        return stream_ooo_submit(state, &state->lanes, job, SIMD_LANES,
+                                 in, (len + 7) / 8,
+                                 (uint8_t) (0xff00 >> (((len - 1) & 7) + 1)),
+                                 kasumi_ooo_load_lane, NULL,
+                                 kasumi_keystream);
+}
+
+JOB_AES_HMAC *
+FLUSH_JOB_KASUMI_UEA1(MB_MGR_KASUMI_OOO *state)
+{
+        return stream_ooo_flush(state, &state->lanes, SIMD_LANES, NULL,
+                                kasumi_keystream);
+}
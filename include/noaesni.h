@@ -57,6 +57,21 @@ aes_keyexp_192_enc_sse_no_aesni(const void *key, void *enc_exp_keys);
 IMB_DLL_EXPORT void
 aes_keyexp_256_enc_sse_no_aesni(const void *key, void *enc_exp_keys);
 IMB_DLL_EXPORT void
+aes_keyexp_128_mb_sse_no_aesni(const void *const *keys,
+                               void *const *enc_exp_keys,
+                               void *const *dec_exp_keys,
+                               const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_keyexp_192_mb_sse_no_aesni(const void *const *keys,
+                               void *const *enc_exp_keys,
+                               void *const *dec_exp_keys,
+                               const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_keyexp_256_mb_sse_no_aesni(const void *const *keys,
+                               void *const *enc_exp_keys,
+                               void *const *dec_exp_keys,
+                               const uint32_t num_keys);
+IMB_DLL_EXPORT void
 aes_cmac_subkey_gen_sse_no_aesni(const void *key_exp, void *key1, void *key2);
 IMB_DLL_EXPORT void
 aes_cfb_128_one_sse_no_aesni(void *out, const void *in, const void *iv,
@@ -0,0 +1,111 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* SHA3 and SHAKE (FIPS 202), HMAC-SHA3 */
+
+#ifndef SHA3_H
+#define SHA3_H
+
+#include <stdint.h>
+#include "intel-ipsec-mb.h"
+
+#define SHA3_ROUNDS 24
+
+/* round constants */
+extern IMB_DLL_LOCAL const uint64_t keccak_rc[SHA3_ROUNDS];
+/* rho rotation offsets, state word x + 5 * y */
+extern IMB_DLL_LOCAL const uint8_t keccak_rho[25];
+/* pi destination word of state word x + 5 * y */
+extern IMB_DLL_LOCAL const uint8_t keccak_pi[25];
+
+/* source of zero input blocks for squeezing and idle lanes */
+extern IMB_DLL_LOCAL const uint8_t sha3_zero_block[SHA3_MAX_BLOCK_SIZE];
+
+/**
+ * @brief Initializes SHA3 out of order manager
+ *
+ * @param state pointer to SHA3 out of order manager
+ * @param block_size sponge rate in bytes
+ * @param num_lanes number of lanes of the architecture
+ */
+IMB_DLL_LOCAL void
+sha3_ooo_init(MB_MGR_SHA3_OOO *state, const uint32_t block_size,
+              const unsigned num_lanes);
+
+/**
+ * @brief Loads a job into a lane of SHA3 out of order manager
+ *
+ * Lane state is set up for absorbing full blocks of the message
+ * and the padded last block is prepared.
+ *
+ * @param state pointer to SHA3 out of order manager
+ * @param lane lane index
+ * @param job job to be loaded
+ */
+IMB_DLL_LOCAL void
+sha3_ooo_load_lane(MB_MGR_SHA3_OOO *state, const unsigned lane,
+                   JOB_AES_HMAC *job);
+
+/**
+ * @brief Advances a lane that has no more blocks to absorb
+ *
+ * Queues the padded last block, starts the HMAC outer hash or
+ * squeezes output, whichever is next for the lane.
+ *
+ * @param state pointer to SHA3 out of order manager
+ * @param lane lane index
+ *
+ * @return 1 if the job in the lane is complete, 0 otherwise
+ */
+IMB_DLL_LOCAL int
+sha3_ooo_lane_next(MB_MGR_SHA3_OOO *state, const unsigned lane);
+
+/*
+ * Multi-buffer SHA3 out of order manager functions.
+ * The same manager processes all algorithms with its sponge rate.
+ */
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_sha3_sse(MB_MGR_SHA3_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_sha3_sse(MB_MGR_SHA3_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_sha3_avx(MB_MGR_SHA3_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_sha3_avx(MB_MGR_SHA3_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_sha3_avx2(MB_MGR_SHA3_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_sha3_avx2(MB_MGR_SHA3_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_sha3_avx512(MB_MGR_SHA3_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_sha3_avx512(MB_MGR_SHA3_OOO *state);
+
+#endif /* SHA3_H */
@@ -0,0 +1,185 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * Multi-buffer SHA3, SHAKE and HMAC-SHA3 code, with #define's to build
+ * an SSE, AVX, AVX2 or AVX512 version (see sse/sha3_sse.c, avx/sha3_avx.c,
+ * etc.)
+ *
+ * The following have to be defined before inclusion:
+ * - SIMD64_LANES - number of 64-bit lanes in a vector (see simd_lanes64.h)
+ * - SUBMIT_JOB_SHA3, FLUSH_JOB_SHA3 - names of API functions
+ *
+ * Lanes are filled on submit. Once all of them are busy (or on flush)
+ * all lanes absorb blocks until one of them runs out of blocks.
+ * Then the lane gets its padded last block, the HMAC outer block or
+ * a zero block for squeezing more output (see sha3_ooo_lane_next()),
+ * until its job is complete. Each call returns at most one completed job.
+ */
+
+#include "intel-ipsec-mb.h"
+#include "simd_lanes64.h"
+#include "sha3.h"
+
+/* Keccak-f[1600] permutation of all lanes */
+__forceinline
+void
+keccak_f1600_lanes(simd64_t *a)
+{
+        simd64_t b[25], c[5], d;
+        unsigned r, x, y;
+
+        for (r = 0; r < SHA3_ROUNDS; r++) {
+                /* theta */
+                for (x = 0; x < 5; x++)
+                        c[x] = SIMD64_XOR(SIMD64_XOR(a[x], a[x + 5]),
+                                          SIMD64_XOR(SIMD64_XOR(a[x + 10],
+                                                                a[x + 15]),
+                                                     a[x + 20]));
+                for (x = 0; x < 5; x++) {
+                        d = SIMD64_XOR(c[(x + 4) % 5],
+                                       SIMD64_ROL(c[(x + 1) % 5], 1));
+                        for (y = 0; y < 25; y += 5)
+                                a[y + x] = SIMD64_XOR(a[y + x], d);
+                }
+                /* rho and pi */
+                for (x = 0; x < 25; x++)
+                        b[keccak_pi[x]] = SIMD64_ROL(a[x], keccak_rho[x]);
+                /* chi */
+                for (y = 0; y < 25; y += 5)
+                        for (x = 0; x < 5; x++)
+                                a[y + x] = SIMD64_XOR_ANDNOT(b[y + x],
+                                                     b[y + (x + 1) % 5],
+                                                     b[y + (x + 2) % 5]);
+                /* iota */
+                a[0] = SIMD64_XOR(a[0], SIMD64_SET1(keccak_rc[r]));
+        }
+}
+
+/*
+ * Absorbs num_blocks blocks into all lanes.
+ * Idle lanes absorb zero blocks, their state is irrelevant.
+ */
+static void
+sha3_absorb(MB_MGR_SHA3_OOO *state, const uint64_t num_blocks)
+{
+        const unsigned block_words = state->block_size / 8;
+        const uint8_t *p[SIMD64_LANES];
+        uint64_t stride[SIMD64_LANES];
+        simd64_t a[25];
+        uint64_t n;
+        unsigned i, lane;
+
+        for (lane = 0; lane < SIMD64_LANES; lane++) {
+                if (state->ldata[lane].job_in_lane != NULL) {
+                        p[lane] = state->in[lane];
+                        stride[lane] = state->block_size;
+                } else {
+                        p[lane] = sha3_zero_block;
+                        stride[lane] = 0;
+                }
+        }
+
+        for (i = 0; i < 25; i++)
+                a[i] = SIMD64_LOAD(state->state[i]);
+
+        for (n = 0; n < num_blocks; n++) {
+                for (i = 0; i < block_words; i++)
+                        a[i] = SIMD64_XOR(a[i], simd64_load_lanes(p, i * 8));
+                keccak_f1600_lanes(a);
+                for (lane = 0; lane < SIMD64_LANES; lane++)
+                        p[lane] += stride[lane];
+        }
+
+        for (i = 0; i < 25; i++)
+                SIMD64_STORE(state->state[i], a[i]);
+
+        for (lane = 0; lane < SIMD64_LANES; lane++) {
+                if (state->ldata[lane].job_in_lane == NULL)
+                        continue;
+                state->in[lane] = p[lane];
+                state->lens[lane] -= num_blocks;
+        }
+}
+
+static JOB_AES_HMAC *
+sha3_release_lane(MB_MGR_SHA3_OOO *state, const unsigned lane)
+{
+        JOB_AES_HMAC *job = state->ldata[lane].job_in_lane;
+
+        state->ldata[lane].job_in_lane = NULL;
+        state->unused_lanes = (state->unused_lanes << 4) | lane;
+        state->num_lanes_inuse--;
+        job->status |= STS_COMPLETED_HMAC;
+        return job;
+}
+
+/* processes lanes in use until one job is complete */
+static JOB_AES_HMAC *
+sha3_process(MB_MGR_SHA3_OOO *state)
+{
+        for (;;) {
+                uint64_t min_len = UINT64_MAX;
+                unsigned lane;
+
+                for (lane = 0; lane < SIMD64_LANES; lane++) {
+                        if (state->ldata[lane].job_in_lane == NULL)
+                                continue;
+                        if (state->lens[lane] == 0 &&
+                            sha3_ooo_lane_next(state, lane))
+                                return sha3_release_lane(state, lane);
+                        if (state->lens[lane] < min_len)
+                                min_len = state->lens[lane];
+                }
+
+                sha3_absorb(state, min_len);
+        }
+}
+
+JOB_AES_HMAC *
+SUBMIT_JOB_SHA3(MB_MGR_SHA3_OOO *state, JOB_AES_HMAC *job)
+{
+        const unsigned lane = (unsigned) (state->unused_lanes & 15);
+
+        state->unused_lanes >>= 4;
+        state->num_lanes_inuse++;
+        sha3_ooo_load_lane(state, lane, job);
+
+        if (state->num_lanes_inuse < SIMD64_LANES)
+                return NULL;
+
+        return sha3_process(state);
+}
+
+JOB_AES_HMAC *
+FLUSH_JOB_SHA3(MB_MGR_SHA3_OOO *state)
+{
+        if (state->num_lanes_inuse == 0)
+                return NULL;
+
+        return sha3_process(state);
+}
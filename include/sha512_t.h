@@ -0,0 +1,99 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* HMAC-SHA512/256 and HMAC-SHA512/224 (FIPS 180-4 truncated SHA512) */
+
+#ifndef SHA512_T_H
+#define SHA512_T_H
+
+#include <stdint.h>
+#include "intel-ipsec-mb.h"
+
+/**
+ * @brief Initializes HMAC-SHA512/t out of order manager
+ *
+ * Lanes are set up as in the SHA512 manager of the architecture,
+ * the outer block padding is set for the inner digest size.
+ *
+ * @param state pointer to out of order manager
+ * @param sha512_state pointer to initialized HMAC-SHA512 manager
+ * @param digest_size SHA512/t digest size in bytes (32 or 28)
+ */
+IMB_DLL_LOCAL void
+hmac_sha512_t_ooo_init(MB_MGR_HMAC_SHA_512_OOO *state,
+                       const MB_MGR_HMAC_SHA_512_OOO *sha512_state,
+                       const unsigned digest_size);
+
+/*
+ * Multi-buffer HMAC-SHA512/t out of order manager functions
+ * (SHA512 lane kernels with truncated outer hash input and tag)
+ */
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_hmac_sha_512_256_sse(MB_MGR_HMAC_SHA_512_OOO *state,
+                                JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_hmac_sha_512_256_sse(MB_MGR_HMAC_SHA_512_OOO *state);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_hmac_sha_512_224_sse(MB_MGR_HMAC_SHA_512_OOO *state,
+                                JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_hmac_sha_512_224_sse(MB_MGR_HMAC_SHA_512_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_hmac_sha_512_256_avx(MB_MGR_HMAC_SHA_512_OOO *state,
+                                JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_hmac_sha_512_256_avx(MB_MGR_HMAC_SHA_512_OOO *state);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_hmac_sha_512_224_avx(MB_MGR_HMAC_SHA_512_OOO *state,
+                                JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_hmac_sha_512_224_avx(MB_MGR_HMAC_SHA_512_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_hmac_sha_512_256_avx2(MB_MGR_HMAC_SHA_512_OOO *state,
+                                 JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_hmac_sha_512_256_avx2(MB_MGR_HMAC_SHA_512_OOO *state);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_hmac_sha_512_224_avx2(MB_MGR_HMAC_SHA_512_OOO *state,
+                                 JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_hmac_sha_512_224_avx2(MB_MGR_HMAC_SHA_512_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_hmac_sha_512_256_avx512(MB_MGR_HMAC_SHA_512_OOO *state,
+                                   JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_hmac_sha_512_256_avx512(MB_MGR_HMAC_SHA_512_OOO *state);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_hmac_sha_512_224_avx512(MB_MGR_HMAC_SHA_512_OOO *state,
+                                   JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_hmac_sha_512_224_avx512(MB_MGR_HMAC_SHA_512_OOO *state);
+
+#endif /* SHA512_T_H */
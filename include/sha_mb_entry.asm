@@ -0,0 +1,87 @@
+;;
+;; Copyright (c) 2019, Intel Corporation
+;;
+;; Redistribution and use in source and binary forms, with or without
+;; modification, are permitted provided that the following conditions are met:
+;;
+;;     * Redistributions of source code must retain the above copyright notice,
+;;       this list of conditions and the following disclaimer.
+;;     * Redistributions in binary form must reproduce the above copyright
+;;       notice, this list of conditions and the following disclaimer in the
+;;       documentation and/or other materials provided with the distribution.
+;;     * Neither the name of Intel Corporation nor the names of its contributors
+;;       may be used to endorse or promote products derived from this software
+;;       without specific prior written permission.
+;;
+;; THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+;; AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+;; IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+;; DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+;; FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+;; DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+;; SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+;; CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+;; OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+;; OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+;;
+
+;; Entry points for calling the multi-buffer SHA kernels from C.
+;;
+;; The kernels follow the calling convention of the submit/flush managers
+;; that use them, not the C ABI: depending on the architecture they
+;; clobber rbx, rbp, r12-r15 and, on Windows, rsi and rdi. The entry point
+;; saves and restores all callee-saved GPRs around the kernel.
+;; XMM registers are not saved, the C caller takes care of them.
+;;
+;; void entry(SHAx_ARGS *args, uint64_t num_blocks)
+
+%ifndef _SHA_MB_ENTRY_ASM_
+%define _SHA_MB_ENTRY_ASM_
+
+%include "include/os.asm"
+
+%ifdef LINUX
+%define SHA_MB_ENTRY_FRAME      8
+%else
+;; shadow space for the callee
+%define SHA_MB_ENTRY_FRAME      (8 + 32)
+%endif
+
+;; SHA_MB_ENTRY name, kernel
+;; - name : entry point to define
+;; - kernel : multi-buffer SHA kernel to call
+%macro SHA_MB_ENTRY 2
+extern %2
+
+MKGLOBAL(%1,function,internal)
+%1:
+        push    rbx
+        push    rbp
+        push    r12
+        push    r13
+        push    r14
+        push    r15
+%ifndef LINUX
+        push    rsi
+        push    rdi
+%endif
+        ;; realign the stack to 16 bytes for the kernel
+        sub     rsp, SHA_MB_ENTRY_FRAME
+
+        call    %2
+
+        add     rsp, SHA_MB_ENTRY_FRAME
+%ifndef LINUX
+        pop     rdi
+        pop     rsi
+%endif
+        pop     r15
+        pop     r14
+        pop     r13
+        pop     r12
+        pop     rbp
+        pop     rbx
+        ret
+%endmacro
+
+%endif ; _SHA_MB_ENTRY_ASM_
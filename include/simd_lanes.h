@@ -0,0 +1,169 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * 32-bit lane vector operations for multi-buffer C code
+ *
+ * SIMD_LANES has to be defined before inclusion:
+ * - 4 selects SSE (or AVX when compiled with AVX enabled)
+ * - 8 selects AVX2
+ * - 16 selects AVX512
+ *
+ * Lane data is kept in memory as rows of 32-bit words, one word per lane,
+ * so that SIMD_LOAD/SIMD_STORE move the same word of all lanes at once.
+ * Rows have to be aligned to the vector size.
+ */
+
+#ifndef SIMD_LANES_H
+#define SIMD_LANES_H
+
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+#include "intel-ipsec-mb.h"
+
+#ifndef SIMD_LANES
+#error "SIMD_LANES not defined"
+#endif
+
+#if SIMD_LANES == 16
+
+typedef __m512i simd_t;
+
+#define SIMD_LOAD(_p)          _mm512_load_si512((const void *)(_p))
+#define SIMD_STORE(_p, _v)     _mm512_store_si512((void *)(_p), (_v))
+#define SIMD_SET1(_x)          _mm512_set1_epi32((int)(_x))
+#define SIMD_ZERO()            _mm512_setzero_si512()
+#define SIMD_ADD(_a, _b)       _mm512_add_epi32((_a), (_b))
+#define SIMD_XOR(_a, _b)       _mm512_xor_si512((_a), (_b))
+#define SIMD_AND(_a, _b)       _mm512_and_si512((_a), (_b))
+#define SIMD_OR(_a, _b)        _mm512_or_si512((_a), (_b))
+#define SIMD_SRL(_a, _n)       _mm512_srli_epi32((_a), (_n))
+#define SIMD_SLL(_a, _n)       _mm512_slli_epi32((_a), (_n))
+#define SIMD_GATHER(_t, _i)    _mm512_i32gather_epi32((_i), (_t), 4)
+
+/* replaces zero lanes of a with b */
+__forceinline simd_t
+simd_zero_to(const simd_t a, const simd_t b)
+{
+        return _mm512_mask_mov_epi32(a, _mm512_testn_epi32_mask(a, a), b);
+}
+
+#elif SIMD_LANES == 8
+
+typedef __m256i simd_t;
+
+#define SIMD_LOAD(_p)          _mm256_load_si256((const __m256i *)(_p))
+#define SIMD_STORE(_p, _v)     _mm256_store_si256((__m256i *)(_p), (_v))
+#define SIMD_SET1(_x)          _mm256_set1_epi32((int)(_x))
+#define SIMD_ZERO()            _mm256_setzero_si256()
+#define SIMD_ADD(_a, _b)       _mm256_add_epi32((_a), (_b))
+#define SIMD_XOR(_a, _b)       _mm256_xor_si256((_a), (_b))
+#define SIMD_AND(_a, _b)       _mm256_and_si256((_a), (_b))
+#define SIMD_OR(_a, _b)        _mm256_or_si256((_a), (_b))
+#define SIMD_SRL(_a, _n)       _mm256_srli_epi32((_a), (_n))
+#define SIMD_SLL(_a, _n)       _mm256_slli_epi32((_a), (_n))
+#define SIMD_GATHER(_t, _i)    \
+        _mm256_i32gather_epi32((const int *)(_t), (_i), 4)
+
+/* replaces zero lanes of a with b */
+__forceinline simd_t
+simd_zero_to(const simd_t a, const simd_t b)
+{
+        const simd_t z = _mm256_cmpeq_epi32(a, _mm256_setzero_si256());
+
+        return _mm256_or_si256(a, _mm256_and_si256(z, b));
+}
+
+#elif SIMD_LANES == 4
+
+typedef __m128i simd_t;
+
+#define SIMD_LOAD(_p)          _mm_load_si128((const __m128i *)(_p))
+#define SIMD_STORE(_p, _v)     _mm_store_si128((__m128i *)(_p), (_v))
+#define SIMD_SET1(_x)          _mm_set1_epi32((int)(_x))
+#define SIMD_ZERO()            _mm_setzero_si128()
+#define SIMD_ADD(_a, _b)       _mm_add_epi32((_a), (_b))
+#define SIMD_XOR(_a, _b)       _mm_xor_si128((_a), (_b))
+#define SIMD_AND(_a, _b)       _mm_and_si128((_a), (_b))
+#define SIMD_OR(_a, _b)        _mm_or_si128((_a), (_b))
+#define SIMD_SRL(_a, _n)       _mm_srli_epi32((_a), (_n))
+#define SIMD_SLL(_a, _n)       _mm_slli_epi32((_a), (_n))
+#define SIMD_GATHER(_t, _i)    simd_gather((_t), (_i))
+
+/* no gather instruction - look-ups are done one lane at a time */
+__forceinline simd_t
+simd_gather(const uint32_t *tab, const simd_t idx)
+{
+        return _mm_set_epi32((int) tab[_mm_extract_epi32(idx, 3)],
+                             (int) tab[_mm_extract_epi32(idx, 2)],
+                             (int) tab[_mm_extract_epi32(idx, 1)],
+                             (int) tab[_mm_cvtsi128_si32(idx)]);
+}
+
+/* replaces zero lanes of a with b */
+__forceinline simd_t
+simd_zero_to(const simd_t a, const simd_t b)
+{
+        const simd_t z = _mm_cmpeq_epi32(a, _mm_setzero_si128());
+
+        return _mm_or_si128(a, _mm_and_si128(z, b));
+}
+
+#else
+#error "SIMD_LANES value not supported"
+#endif
+
+/* byte n (0 is the least significant one) of each lane */
+#define SIMD_BYTE(_v, _n) \
+        SIMD_AND(SIMD_SRL((_v), 8 * (_n)), SIMD_SET1(0xff))
+
+/* rotate each 32-bit lane left */
+#define SIMD_ROL(_v, _n) \
+        SIMD_OR(SIMD_SLL((_v), (_n)), SIMD_SRL((_v), 32 - (_n)))
+
+/**
+ * @brief Loads a 32-bit word from a different buffer for each lane
+ *
+ * @param p array of SIMD_LANES buffer pointers
+ * @param offset byte offset of the word in the buffers
+ *
+ * @return vector with word from p[i] + offset in lane i
+ */
+__forceinline simd_t
+simd_load_lanes(const uint8_t * const *p, const size_t offset)
+{
+        DECLARE_ALIGNED(uint32_t w[SIMD_LANES], 64);
+        unsigned i;
+
+        for (i = 0; i < SIMD_LANES; i++)
+                memcpy(&w[i], p[i] + offset, sizeof(w[i]));
+        return SIMD_LOAD(w);
+}
+
+#endif /* SIMD_LANES_H */
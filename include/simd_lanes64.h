@@ -0,0 +1,147 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * 64-bit lane vector operations for multi-buffer C code
+ *
+ * SIMD64_LANES has to be defined before inclusion:
+ * - 2 selects SSE (or AVX when compiled with AVX enabled)
+ * - 4 selects AVX2
+ * - 8 selects AVX512
+ *
+ * Lane data is kept in memory as rows of 64-bit words, one word per lane
+ * (see simd_lanes.h). Rows have to be aligned to the vector size.
+ */
+
+#ifndef SIMD_LANES64_H
+#define SIMD_LANES64_H
+
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+#include "intel-ipsec-mb.h"
+
+#ifndef SIMD64_LANES
+#error "SIMD64_LANES not defined"
+#endif
+
+#if SIMD64_LANES == 8
+
+typedef __m512i simd64_t;
+
+#define SIMD64_LOAD(_p)        _mm512_load_si512((const void *)(_p))
+#define SIMD64_STORE(_p, _v)   _mm512_store_si512((void *)(_p), (_v))
+#define SIMD64_SET1(_x)        _mm512_set1_epi64((long long)(_x))
+#define SIMD64_ADD(_a, _b)     _mm512_add_epi64((_a), (_b))
+#define SIMD64_XOR(_a, _b)     _mm512_xor_si512((_a), (_b))
+#define SIMD64_ROL(_a, _n)     \
+        _mm512_rolv_epi64((_a), _mm512_set1_epi64((long long)(_n)))
+/* a ^ (~b & c) */
+#define SIMD64_XOR_ANDNOT(_a, _b, _c) \
+        _mm512_ternarylogic_epi64((_a), (_b), (_c), 0xd2)
+
+#elif SIMD64_LANES == 4
+
+typedef __m256i simd64_t;
+
+#define SIMD64_LOAD(_p)        _mm256_load_si256((const __m256i *)(_p))
+#define SIMD64_STORE(_p, _v)   _mm256_store_si256((__m256i *)(_p), (_v))
+#define SIMD64_SET1(_x)        _mm256_set1_epi64x((long long)(_x))
+#define SIMD64_ADD(_a, _b)     _mm256_add_epi64((_a), (_b))
+#define SIMD64_XOR(_a, _b)     _mm256_xor_si256((_a), (_b))
+#define SIMD64_ROL(_a, _n)                                              \
+        _mm256_or_si256(_mm256_sll_epi64((_a), _mm_cvtsi32_si128(_n)),  \
+                        _mm256_srl_epi64((_a),                          \
+                                         _mm_cvtsi32_si128(64 - (_n))))
+#define SIMD64_XOR_ANDNOT(_a, _b, _c) \
+        _mm256_xor_si256((_a), _mm256_andnot_si256((_b), (_c)))
+
+#elif SIMD64_LANES == 2
+
+typedef __m128i simd64_t;
+
+#define SIMD64_LOAD(_p)        _mm_load_si128((const __m128i *)(_p))
+#define SIMD64_STORE(_p, _v)   _mm_store_si128((__m128i *)(_p), (_v))
+#define SIMD64_SET1(_x)        _mm_set1_epi64x((long long)(_x))
+#define SIMD64_ADD(_a, _b)     _mm_add_epi64((_a), (_b))
+#define SIMD64_XOR(_a, _b)     _mm_xor_si128((_a), (_b))
+#define SIMD64_ROL(_a, _n)                                              \
+        _mm_or_si128(_mm_sll_epi64((_a), _mm_cvtsi32_si128(_n)),        \
+                     _mm_srl_epi64((_a), _mm_cvtsi32_si128(64 - (_n))))
+#define SIMD64_XOR_ANDNOT(_a, _b, _c) \
+        _mm_xor_si128((_a), _mm_andnot_si128((_b), (_c)))
+
+#else
+#error "SIMD64_LANES value not supported"
+#endif
+
+/* rotate each 64-bit lane right */
+#define SIMD64_ROR(_a, _n) SIMD64_ROL((_a), 64 - (_n))
+
+/* unaligned little endian 64-bit load */
+__forceinline uint64_t
+simd64_load_u64(const uint8_t *p)
+{
+        uint64_t x;
+
+        memcpy(&x, p, sizeof(x));
+        return x;
+}
+
+/**
+ * @brief Loads a 64-bit word from a different buffer for each lane
+ *
+ * @param p array of SIMD64_LANES buffer pointers
+ * @param offset byte offset of the word in the buffers
+ *
+ * @return vector with word from p[i] + offset in lane i
+ */
+__forceinline simd64_t
+simd64_load_lanes(const uint8_t * const *p, const size_t offset)
+{
+#if SIMD64_LANES == 8
+        return _mm512_set_epi64((long long) simd64_load_u64(p[7] + offset),
+                                (long long) simd64_load_u64(p[6] + offset),
+                                (long long) simd64_load_u64(p[5] + offset),
+                                (long long) simd64_load_u64(p[4] + offset),
+                                (long long) simd64_load_u64(p[3] + offset),
+                                (long long) simd64_load_u64(p[2] + offset),
+                                (long long) simd64_load_u64(p[1] + offset),
+                                (long long) simd64_load_u64(p[0] + offset));
+#elif SIMD64_LANES == 4
+        return _mm256_set_epi64x((long long) simd64_load_u64(p[3] + offset),
+                                 (long long) simd64_load_u64(p[2] + offset),
+                                 (long long) simd64_load_u64(p[1] + offset),
+                                 (long long) simd64_load_u64(p[0] + offset));
+#else
+        return _mm_set_epi64x((long long) simd64_load_u64(p[1] + offset),
+                              (long long) simd64_load_u64(p[0] + offset));
+#endif
+}
+
+#endif /* SIMD_LANES64_H */
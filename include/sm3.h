@@ -0,0 +1,107 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* SM3 hash (GB/T 32905-2016) and HMAC-SM3 */
+
+#ifndef SM3_H
+#define SM3_H
+
+#include <stdint.h>
+#include "intel-ipsec-mb.h"
+
+#define SM3_ROUNDS 64
+
+/* initial hash value */
+extern IMB_DLL_LOCAL const uint32_t sm3_iv[8];
+/* round constants T_j rotated left by j mod 32 */
+extern IMB_DLL_LOCAL const uint32_t sm3_tj[SM3_ROUNDS];
+
+/* source of input blocks for idle lanes */
+extern IMB_DLL_LOCAL const uint8_t sm3_zero_block[SM3_BLOCK_SIZE];
+
+/**
+ * @brief Initializes SM3 out of order manager
+ *
+ * @param state pointer to out of order manager
+ * @param num_lanes number of lanes of the architecture
+ */
+IMB_DLL_LOCAL void
+sm3_ooo_init(MB_MGR_HMAC_SHA_256_OOO *state, const unsigned num_lanes);
+
+/**
+ * @brief Loads a job into a lane of SM3 out of order manager
+ *
+ * Lane is set up for hashing full blocks of the message
+ * and the padded last block(s) are prepared.
+ *
+ * @param state pointer to out of order manager
+ * @param lane lane index
+ * @param job job to be loaded
+ */
+IMB_DLL_LOCAL void
+sm3_ooo_load_lane(MB_MGR_HMAC_SHA_256_OOO *state, const unsigned lane,
+                  JOB_AES_HMAC *job);
+
+/**
+ * @brief Advances a lane that has no more blocks to hash
+ *
+ * Queues more message blocks, the padded last block(s) or the HMAC
+ * outer block, or writes the digest, whichever is next for the lane.
+ *
+ * @param state pointer to out of order manager
+ * @param lane lane index
+ *
+ * @return 1 if the job in the lane is complete, 0 otherwise
+ */
+IMB_DLL_LOCAL int
+sm3_ooo_lane_next(MB_MGR_HMAC_SHA_256_OOO *state, const unsigned lane);
+
+/*
+ * Multi-buffer SM3 out of order manager functions.
+ * The same manager processes SM3 and HMAC-SM3.
+ */
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_sm3_sse(MB_MGR_HMAC_SHA_256_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_sm3_sse(MB_MGR_HMAC_SHA_256_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_sm3_avx(MB_MGR_HMAC_SHA_256_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_sm3_avx(MB_MGR_HMAC_SHA_256_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_sm3_avx2(MB_MGR_HMAC_SHA_256_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_sm3_avx2(MB_MGR_HMAC_SHA_256_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_sm3_avx512(MB_MGR_HMAC_SHA_256_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_sm3_avx512(MB_MGR_HMAC_SHA_256_OOO *state);
+
+#endif /* SM3_H */
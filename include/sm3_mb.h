@@ -0,0 +1,237 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * Multi-buffer SM3 and HMAC-SM3 code, with #define's to build
+ * an SSE, AVX, AVX2 or AVX512 version (see sse/sm3_sse.c, avx/sm3_avx.c,
+ * etc.)
+ *
+ * The following have to be defined before inclusion:
+ * - SIMD_LANES - number of 32-bit lanes in a vector (see simd_lanes.h)
+ * - SUBMIT_JOB_SM3, FLUSH_JOB_SM3 - names of API functions
+ *
+ * Lanes are filled on submit. Once all of them are busy (or on flush)
+ * all lanes hash blocks until one of them runs out of blocks.
+ * Then the lane gets more message blocks, its padded last block(s) or
+ * the HMAC outer block (see sm3_ooo_lane_next()), until its job is
+ * complete. Each call returns at most one completed job.
+ */
+
+#include "intel-ipsec-mb.h"
+#include "simd_lanes.h"
+#include "sm3.h"
+
+/* changes byte order of 32-bit lanes */
+__forceinline simd_t
+sm3_bswap32(const simd_t x)
+{
+        return SIMD_OR(SIMD_OR(SIMD_SLL(x, 24),
+                               SIMD_SLL(SIMD_BYTE(x, 1), 16)),
+                       SIMD_OR(SIMD_SLL(SIMD_BYTE(x, 2), 8),
+                               SIMD_SRL(x, 24)));
+}
+
+__forceinline simd_t
+sm3_p0(const simd_t x)
+{
+        return SIMD_XOR(x, SIMD_XOR(SIMD_ROL(x, 9), SIMD_ROL(x, 17)));
+}
+
+__forceinline simd_t
+sm3_p1(const simd_t x)
+{
+        return SIMD_XOR(x, SIMD_XOR(SIMD_ROL(x, 15), SIMD_ROL(x, 23)));
+}
+
+/* SM3 compression function of all lanes, v is the digest */
+__forceinline void
+sm3_compress_lanes(simd_t *v, const uint8_t * const *p)
+{
+        simd_t w[68], a, b, c, d, e, f, g, h, a12, ss1, ss2, tt1, tt2;
+        unsigned j;
+
+        for (j = 0; j < 16; j++)
+                w[j] = sm3_bswap32(simd_load_lanes(p, j * 4));
+        for (j = 16; j < 68; j++)
+                w[j] = SIMD_XOR(SIMD_XOR(sm3_p1(SIMD_XOR(SIMD_XOR(w[j - 16],
+                                                                  w[j - 9]),
+                                                         SIMD_ROL(w[j - 3],
+                                                                  15))),
+                                         SIMD_ROL(w[j - 13], 7)),
+                                w[j - 6]);
+
+        a = v[0];
+        b = v[1];
+        c = v[2];
+        d = v[3];
+        e = v[4];
+        f = v[5];
+        g = v[6];
+        h = v[7];
+
+        for (j = 0; j < SM3_ROUNDS; j++) {
+                a12 = SIMD_ROL(a, 12);
+                ss1 = SIMD_ROL(SIMD_ADD(SIMD_ADD(a12, e),
+                                        SIMD_SET1(sm3_tj[j])), 7);
+                ss2 = SIMD_XOR(ss1, a12);
+                tt1 = SIMD_ADD(SIMD_ADD(d, ss2),
+                               SIMD_XOR(w[j], w[j + 4]));
+                tt2 = SIMD_ADD(SIMD_ADD(h, ss1), w[j]);
+                if (j < 16) {
+                        tt1 = SIMD_ADD(tt1, SIMD_XOR(SIMD_XOR(a, b), c));
+                        tt2 = SIMD_ADD(tt2, SIMD_XOR(SIMD_XOR(e, f), g));
+                } else {
+                        /* majority and choice */
+                        tt1 = SIMD_ADD(tt1,
+                                       SIMD_OR(SIMD_AND(a, b),
+                                               SIMD_AND(c, SIMD_OR(a, b))));
+                        tt2 = SIMD_ADD(tt2,
+                                       SIMD_XOR(g,
+                                                SIMD_AND(e, SIMD_XOR(f, g))));
+                }
+                d = c;
+                c = SIMD_ROL(b, 9);
+                b = a;
+                a = tt1;
+                h = g;
+                g = SIMD_ROL(f, 19);
+                f = e;
+                e = sm3_p0(tt2);
+        }
+
+        v[0] = SIMD_XOR(v[0], a);
+        v[1] = SIMD_XOR(v[1], b);
+        v[2] = SIMD_XOR(v[2], c);
+        v[3] = SIMD_XOR(v[3], d);
+        v[4] = SIMD_XOR(v[4], e);
+        v[5] = SIMD_XOR(v[5], f);
+        v[6] = SIMD_XOR(v[6], g);
+        v[7] = SIMD_XOR(v[7], h);
+}
+
+/*
+ * Hashes num_blocks blocks in all lanes.
+ * Idle lanes hash zero blocks, their digest is irrelevant.
+ */
+static void
+sm3_update(MB_MGR_HMAC_SHA_256_OOO *state, const uint64_t num_blocks)
+{
+        const uint8_t *p[SIMD_LANES];
+        uint64_t stride[SIMD_LANES];
+        simd_t v[8];
+        uint64_t n;
+        unsigned i, lane;
+
+        for (lane = 0; lane < SIMD_LANES; lane++) {
+                if (state->ldata[lane].job_in_lane != NULL) {
+                        p[lane] = state->args.data_ptr[lane];
+                        stride[lane] = SM3_BLOCK_SIZE;
+                } else {
+                        p[lane] = sm3_zero_block;
+                        stride[lane] = 0;
+                }
+        }
+
+        for (i = 0; i < 8; i++)
+                v[i] = SIMD_LOAD(&state->args.digest[i *
+                                                     AVX512_NUM_SHA256_LANES]);
+
+        for (n = 0; n < num_blocks; n++) {
+                sm3_compress_lanes(v, p);
+                for (lane = 0; lane < SIMD_LANES; lane++)
+                        p[lane] += stride[lane];
+        }
+
+        for (i = 0; i < 8; i++)
+                SIMD_STORE(&state->args.digest[i * AVX512_NUM_SHA256_LANES],
+                           v[i]);
+
+        for (lane = 0; lane < SIMD_LANES; lane++) {
+                if (state->ldata[lane].job_in_lane == NULL)
+                        continue;
+                state->args.data_ptr[lane] = (uint8_t *) (uintptr_t) p[lane];
+                state->lens[lane] -= (uint16_t) num_blocks;
+        }
+}
+
+static JOB_AES_HMAC *
+sm3_release_lane(MB_MGR_HMAC_SHA_256_OOO *state, const unsigned lane)
+{
+        JOB_AES_HMAC *job = state->ldata[lane].job_in_lane;
+
+        state->ldata[lane].job_in_lane = NULL;
+        state->unused_lanes = (state->unused_lanes << 4) | lane;
+        state->num_lanes_inuse--;
+        job->status |= STS_COMPLETED_HMAC;
+        return job;
+}
+
+/* processes lanes in use until one job is complete */
+static JOB_AES_HMAC *
+sm3_process(MB_MGR_HMAC_SHA_256_OOO *state)
+{
+        for (;;) {
+                uint16_t min_len = UINT16_MAX;
+                unsigned lane;
+
+                for (lane = 0; lane < SIMD_LANES; lane++) {
+                        if (state->ldata[lane].job_in_lane == NULL)
+                                continue;
+                        if (state->lens[lane] == 0 &&
+                            sm3_ooo_lane_next(state, lane))
+                                return sm3_release_lane(state, lane);
+                        if (state->lens[lane] < min_len)
+                                min_len = state->lens[lane];
+                }
+
+                sm3_update(state, min_len);
+        }
+}
+
+JOB_AES_HMAC *
+SUBMIT_JOB_SM3(MB_MGR_HMAC_SHA_256_OOO *state, JOB_AES_HMAC *job)
+{
+        const unsigned lane = (unsigned) (state->unused_lanes & 15);
+
+        state->unused_lanes >>= 4;
+        state->num_lanes_inuse++;
+        sm3_ooo_load_lane(state, lane, job);
+
+        if (state->num_lanes_inuse < SIMD_LANES)
+                return NULL;
+
+        return sm3_process(state);
+}
+
+JOB_AES_HMAC *
+FLUSH_JOB_SM3(MB_MGR_HMAC_SHA_256_OOO *state)
+{
+        if (state->num_lanes_inuse == 0)
+                return NULL;
+
+        return sm3_process(state);
+}
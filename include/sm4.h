@@ -0,0 +1,123 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* SM4 block cipher (GB/T 32907-2016) - CBC, CTR and GCM modes */
+
+#ifndef SM4_H
+#define SM4_H
+
+#include <stdint.h>
+#include "intel-ipsec-mb.h"
+
+#define SM4_ROUNDS 32
+
+extern IMB_DLL_LOCAL const uint8_t sm4_sbox[256];
+
+/* source of input blocks for idle lanes */
+extern IMB_DLL_LOCAL const uint8_t sm4_zero_block[SM4_BLOCK_SIZE];
+
+/**
+ * @brief Encrypts (or decrypts) one block
+ *
+ * @param rk round keys, in reverse order for decryption
+ * @param in input block
+ * @param out output block (may be the same as in)
+ */
+IMB_DLL_LOCAL void
+sm4_crypt_block(const uint32_t *rk, const void *in, void *out);
+
+/**
+ * @brief Multiplication in GF(2^128) with GHASH bit order
+ *
+ * @param x first factor and result
+ * @param h second factor
+ */
+IMB_DLL_LOCAL void
+sm4_ghash_mul(uint8_t *x, const uint8_t *h);
+
+/**
+ * @brief Initializes SM4-CBC encryption out of order manager
+ *
+ * @param state pointer to out of order manager
+ * @param num_lanes number of lanes of the architecture
+ */
+IMB_DLL_LOCAL void
+sm4_cbc_enc_ooo_init(MB_MGR_AES_OOO *state, const unsigned num_lanes);
+
+/*
+ * Multi-buffer SM4-CBC encryption out of order manager functions.
+ * CBC decryption, CTR and GCM process blocks of one job in parallel.
+ */
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_sm4_cbc_enc_sse(MB_MGR_AES_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_sm4_cbc_enc_sse(MB_MGR_AES_OOO *state);
+IMB_DLL_LOCAL JOB_AES_HMAC *submit_job_sm4_cbc_dec_sse(JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *submit_job_sm4_cntr_sse(JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *submit_job_sm4_gcm_enc_sse(JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *submit_job_sm4_gcm_dec_sse(JOB_AES_HMAC *job);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_sm4_cbc_enc_sse_no_aesni(MB_MGR_AES_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_sm4_cbc_enc_sse_no_aesni(MB_MGR_AES_OOO *state);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_sm4_cbc_dec_sse_no_aesni(JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *submit_job_sm4_cntr_sse_no_aesni(JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_sm4_gcm_enc_sse_no_aesni(JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_sm4_gcm_dec_sse_no_aesni(JOB_AES_HMAC *job);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_sm4_cbc_enc_avx(MB_MGR_AES_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_sm4_cbc_enc_avx(MB_MGR_AES_OOO *state);
+IMB_DLL_LOCAL JOB_AES_HMAC *submit_job_sm4_cbc_dec_avx(JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *submit_job_sm4_cntr_avx(JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *submit_job_sm4_gcm_enc_avx(JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *submit_job_sm4_gcm_dec_avx(JOB_AES_HMAC *job);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_sm4_cbc_enc_avx2(MB_MGR_AES_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_sm4_cbc_enc_avx2(MB_MGR_AES_OOO *state);
+IMB_DLL_LOCAL JOB_AES_HMAC *submit_job_sm4_cbc_dec_avx2(JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *submit_job_sm4_cntr_avx2(JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *submit_job_sm4_gcm_enc_avx2(JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *submit_job_sm4_gcm_dec_avx2(JOB_AES_HMAC *job);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_sm4_cbc_enc_avx512(MB_MGR_AES_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_sm4_cbc_enc_avx512(MB_MGR_AES_OOO *state);
+IMB_DLL_LOCAL JOB_AES_HMAC *submit_job_sm4_cbc_dec_avx512(JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *submit_job_sm4_cntr_avx512(JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *submit_job_sm4_gcm_enc_avx512(JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *submit_job_sm4_gcm_dec_avx512(JOB_AES_HMAC *job);
+
+#endif /* SM4_H */
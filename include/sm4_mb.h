@@ -0,0 +1,578 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * Multi-buffer SM4 code, with #define's to build an SSE, AVX, AVX2 or
+ * AVX512 version (see sse/sm4_sse.c, avx/sm4_avx.c, etc.)
+ *
+ * The following have to be defined before inclusion:
+ * - SIMD_LANES - number of 32-bit lanes in a vector, 4 or 8
+ *   (see simd_lanes.h)
+ * - SUBMIT_JOB_SM4_CBC_ENC, FLUSH_JOB_SM4_CBC_ENC, SUBMIT_JOB_SM4_CBC_DEC,
+ *   SUBMIT_JOB_SM4_CNTR, SUBMIT_JOB_SM4_GCM_ENC, SUBMIT_JOB_SM4_GCM_DEC -
+ *   names of API functions
+ * - SM4_NO_AESNI (optional) - S-box look-ups and GHASH without
+ *   AES-NI and PCLMULQDQ instructions
+ *
+ * Each lane encrypts one block. CBC encryption lanes take blocks from
+ * different jobs (out of order manager), other modes process blocks
+ * of one job in parallel.
+ *
+ * The S-box is computed with AESENCLAST: SM4 and AES S-boxes are both
+ * based on inversion in GF(2^8), so the SM4 one is an affine transform
+ * (to the AES field), AES SubBytes and another affine transform (back).
+ * Affine transforms are done with nibble look-ups (PSHUFB) and ShiftRows
+ * of AESENCLAST is undone by inverse ShiftRows shuffle in advance.
+ */
+
+#include "intel-ipsec-mb.h"
+#include "simd_lanes.h"
+#include "sm4.h"
+#ifndef SM4_NO_AESNI
+#include "ghash_clmul.h"
+#endif
+
+#if SIMD_LANES == 8
+
+/* 16-byte table repeated in each 128-bit lane */
+#define SM4_TAB(_hi, _lo)     _mm256_set_epi64x((_hi), (_lo), (_hi), (_lo))
+#define SM4_SHUFFLE(_t, _i)   _mm256_shuffle_epi8((_t), (_i))
+
+#ifndef SM4_NO_AESNI
+/* no VAES assumed - AESENCLAST on each 128-bit lane */
+__forceinline simd_t
+sm4_aesenclast(const simd_t x)
+{
+        const __m128i z = _mm_setzero_si128();
+        const __m128i lo = _mm_aesenclast_si128(_mm256_castsi256_si128(x), z);
+        const __m128i hi = _mm_aesenclast_si128(_mm256_extracti128_si256(x, 1),
+                                                z);
+
+        return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+#endif
+
+#elif SIMD_LANES == 4
+
+#define SM4_TAB(_hi, _lo)     _mm_set_epi64x((_hi), (_lo))
+#define SM4_SHUFFLE(_t, _i)   _mm_shuffle_epi8((_t), (_i))
+
+#ifndef SM4_NO_AESNI
+#define sm4_aesenclast(_x)    _mm_aesenclast_si128((_x), _mm_setzero_si128())
+#endif
+
+#else
+#error "SIMD_LANES value not supported"
+#endif
+
+/* changes byte order of 32-bit lanes */
+#define SM4_BSWAP32(_x)                                                 \
+        SM4_SHUFFLE((_x), SM4_TAB(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL))
+
+#ifdef SM4_NO_AESNI
+
+__forceinline simd_t
+sm4_sbox_lanes(const simd_t x)
+{
+        DECLARE_ALIGNED(uint8_t b[SIMD_LANES * 4], 64);
+        unsigned i;
+
+        SIMD_STORE(b, x);
+        for (i = 0; i < sizeof(b); i++)
+                b[i] = sm4_sbox[b[i]];
+        return SIMD_LOAD(b);
+}
+
+#else
+
+/* affine transform of each byte with look-ups of its nibbles */
+__forceinline simd_t
+sm4_affine(const simd_t x, const simd_t lo_tab, const simd_t hi_tab)
+{
+        const simd_t m = SIMD_SET1(0x0f0f0f0f);
+
+        return SIMD_XOR(SM4_SHUFFLE(lo_tab, SIMD_AND(x, m)),
+                        SM4_SHUFFLE(hi_tab, SIMD_AND(SIMD_SRL(x, 4), m)));
+}
+
+__forceinline simd_t
+sm4_sbox_lanes(const simd_t x)
+{
+        simd_t t;
+
+        /* to AES field, with inverse ShiftRows */
+        t = sm4_affine(x, SM4_TAB(0xC7C1B4B222245157LL, 0x9197E2E474720701LL),
+                       SM4_TAB(0xF052B91BF95BB012LL, 0xE240AB09EB49A200LL));
+        t = SM4_SHUFFLE(t, SM4_TAB(0x0306090C0F020508LL,
+                                   0x0B0E0104070A0D00LL));
+        t = sm4_aesenclast(t);
+        /* back to SM4 field */
+        return sm4_affine(t,
+                          SM4_TAB(0xEDD14478172BBE82LL, 0x5B67F2CEA19D0834LL),
+                          SM4_TAB(0x11CDBE62CC1063BFLL, 0xAE7201DD73AFDC00LL));
+}
+
+#endif /* SM4_NO_AESNI */
+
+/* mixer-substitution T = L(tau(x)) */
+__forceinline simd_t
+sm4_t(const simd_t x)
+{
+        const simd_t b = sm4_sbox_lanes(x);
+
+        return SIMD_XOR(SIMD_XOR(b, SIMD_ROL(b, 2)),
+                        SIMD_XOR(SIMD_XOR(SIMD_ROL(b, 10), SIMD_ROL(b, 18)),
+                                 SIMD_ROL(b, 24)));
+}
+
+/* 32 rounds with the reverse transformation, x[i] is word i of blocks */
+__forceinline void
+sm4_rounds(simd_t *x, const simd_t *rk)
+{
+        simd_t t;
+        unsigned i;
+
+        for (i = 0; i < SM4_ROUNDS; i += 4) {
+                x[0] = SIMD_XOR(x[0], sm4_t(SIMD_XOR(SIMD_XOR(x[1], x[2]),
+                                                     SIMD_XOR(x[3], rk[i]))));
+                x[1] = SIMD_XOR(x[1], sm4_t(SIMD_XOR(SIMD_XOR(x[2], x[3]),
+                                                     SIMD_XOR(x[0],
+                                                              rk[i + 1]))));
+                x[2] = SIMD_XOR(x[2], sm4_t(SIMD_XOR(SIMD_XOR(x[3], x[0]),
+                                                     SIMD_XOR(x[1],
+                                                              rk[i + 2]))));
+                x[3] = SIMD_XOR(x[3], sm4_t(SIMD_XOR(SIMD_XOR(x[0], x[1]),
+                                                     SIMD_XOR(x[2],
+                                                              rk[i + 3]))));
+        }
+
+        t = x[0];
+        x[0] = x[3];
+        x[3] = t;
+        t = x[1];
+        x[1] = x[2];
+        x[2] = t;
+}
+
+/* loads a block of each lane from p[lane] */
+__forceinline void
+sm4_load_blocks(simd_t *x, const uint8_t * const *p)
+{
+        unsigned i;
+
+        for (i = 0; i < 4; i++)
+                x[i] = SM4_BSWAP32(simd_load_lanes(p, i * 4));
+}
+
+/* stores a block of each lane to p[lane] */
+__forceinline void
+sm4_store_blocks(uint8_t * const *p, const simd_t *x)
+{
+        DECLARE_ALIGNED(uint32_t w[4][SIMD_LANES], 64);
+        unsigned i, lane;
+
+        for (i = 0; i < 4; i++)
+                SIMD_STORE(w[i], SM4_BSWAP32(x[i]));
+        for (lane = 0; lane < SIMD_LANES; lane++)
+                for (i = 0; i < 4; i++)
+                        memcpy(p[lane] + i * 4, &w[i][lane], sizeof(w[i][0]));
+}
+
+/* the same round keys for all lanes */
+__forceinline void
+sm4_set1_rk(simd_t *rk, const uint32_t *keys)
+{
+        unsigned i;
+
+        for (i = 0; i < SM4_ROUNDS; i++)
+                rk[i] = SIMD_SET1(keys[i]);
+}
+
+/*
+ * Encrypts (or decrypts) 1 to SIMD_LANES consecutive blocks from in.
+ * All SIMD_LANES blocks of out are written.
+ */
+__forceinline void
+sm4_crypt_blocks(const simd_t *rk, const uint8_t *in,
+                 const unsigned num_blocks,
+                 uint8_t out[SIMD_LANES][SM4_BLOCK_SIZE])
+{
+        const uint8_t *p_in[SIMD_LANES];
+        uint8_t *p_out[SIMD_LANES];
+        simd_t x[4];
+        unsigned lane;
+
+        for (lane = 0; lane < SIMD_LANES; lane++) {
+                p_in[lane] = &in[SM4_BLOCK_SIZE *
+                                 (lane < num_blocks ? lane : 0)];
+                p_out[lane] = out[lane];
+        }
+
+        sm4_load_blocks(x, p_in);
+        sm4_rounds(x, rk);
+        sm4_store_blocks(p_out, x);
+}
+
+/* increments big endian counter in the last n bytes of the block */
+__forceinline void
+sm4_ctr_inc(uint8_t *cb, const unsigned n)
+{
+        unsigned i;
+
+        for (i = 1; i <= n; i++)
+                if (++cb[SM4_BLOCK_SIZE - i] != 0)
+                        break;
+}
+
+/* CTR mode en/decryption, counter is incremented in ctr_bytes of cb */
+static void
+sm4_ctr_crypt(const simd_t *rk, uint8_t *cb, const unsigned ctr_bytes,
+              const uint8_t *in, uint8_t *out, uint64_t len)
+{
+        DECLARE_ALIGNED(uint8_t ctr[SIMD_LANES][SM4_BLOCK_SIZE], 64);
+        DECLARE_ALIGNED(uint8_t ks[SIMD_LANES][SM4_BLOCK_SIZE], 64);
+        unsigned i, n;
+
+        while (len != 0) {
+                n = (len < sizeof(ks)) ? (unsigned) len : sizeof(ks);
+
+                for (i = 0; i < (n + SM4_BLOCK_SIZE - 1) / SM4_BLOCK_SIZE;
+                     i++) {
+                        memcpy(ctr[i], cb, SM4_BLOCK_SIZE);
+                        sm4_ctr_inc(cb, ctr_bytes);
+                }
+                sm4_crypt_blocks(rk, ctr[0], i, ks);
+
+                for (i = 0; i < n; i++)
+                        out[i] = in[i] ^ ks[i / SM4_BLOCK_SIZE]
+                                [i % SM4_BLOCK_SIZE];
+                in += n;
+                out += n;
+                len -= n;
+        }
+}
+
+/* ========================================================================== */
+/* CBC encryption out of order manager */
+
+/*
+ * Encrypts num_blocks blocks in all lanes.
+ * Idle lanes encrypt zero blocks with zero keys into a local buffer.
+ */
+static void
+sm4_cbc_enc_lanes(MB_MGR_AES_OOO *state, const uint64_t num_blocks)
+{
+        DECLARE_ALIGNED(uint32_t w[SM4_ROUNDS][SIMD_LANES], 64);
+        uint8_t discard[SIMD_LANES][SM4_BLOCK_SIZE];
+        const uint8_t *p_in[SIMD_LANES];
+        uint8_t *p_out[SIMD_LANES], *p_iv[SIMD_LANES];
+        uint64_t stride[SIMD_LANES];
+        simd_t rk[SM4_ROUNDS], x[4], c[4];
+        uint64_t n;
+        unsigned i, lane;
+
+        for (lane = 0; lane < SIMD_LANES; lane++) {
+                p_iv[lane] = (uint8_t *) &state->args.IV[lane];
+                if (state->job_in_lane[lane] != NULL) {
+                        p_in[lane] = state->args.in[lane];
+                        p_out[lane] = state->args.out[lane];
+                        stride[lane] = SM4_BLOCK_SIZE;
+                        for (i = 0; i < SM4_ROUNDS; i++)
+                                w[i][lane] = state->args.keys[lane][i];
+                } else {
+                        p_in[lane] = sm4_zero_block;
+                        p_out[lane] = discard[lane];
+                        stride[lane] = 0;
+                        for (i = 0; i < SM4_ROUNDS; i++)
+                                w[i][lane] = 0;
+                }
+        }
+
+        for (i = 0; i < SM4_ROUNDS; i++)
+                rk[i] = SIMD_LOAD(w[i]);
+        sm4_load_blocks(c, (const uint8_t * const *) p_iv);
+
+        for (n = 0; n < num_blocks; n++) {
+                sm4_load_blocks(x, p_in);
+                for (i = 0; i < 4; i++)
+                        x[i] = SIMD_XOR(x[i], c[i]);
+                sm4_rounds(x, rk);
+                sm4_store_blocks(p_out, x);
+                for (i = 0; i < 4; i++)
+                        c[i] = x[i];
+                for (lane = 0; lane < SIMD_LANES; lane++) {
+                        p_in[lane] += stride[lane];
+                        p_out[lane] += stride[lane];
+                }
+        }
+
+        sm4_store_blocks(p_iv, c);
+
+        for (lane = 0; lane < SIMD_LANES; lane++) {
+                if (state->job_in_lane[lane] == NULL)
+                        continue;
+                state->args.in[lane] = p_in[lane];
+                state->args.out[lane] = p_out[lane];
+                state->lens[lane] -= (uint16_t) (num_blocks * SM4_BLOCK_SIZE);
+        }
+}
+
+/* bytes to process in one go, lengths are 16-bit */
+__forceinline uint16_t
+sm4_cbc_chunk(const uint64_t len)
+{
+        return (uint16_t) ((len < 0xfff0) ? len : 0xfff0);
+}
+
+/* processes lanes in use until one job is complete */
+static JOB_AES_HMAC *
+sm4_cbc_enc_process(MB_MGR_AES_OOO *state)
+{
+        for (;;) {
+                uint16_t min_len = UINT16_MAX;
+                unsigned lane;
+
+                for (lane = 0; lane < SIMD_LANES; lane++) {
+                        JOB_AES_HMAC *job = state->job_in_lane[lane];
+
+                        if (job == NULL)
+                                continue;
+                        if (state->lens[lane] == 0) {
+                                const uint64_t done = (uint64_t)
+                                        (state->args.out[lane] - job->dst);
+
+                                if (done == job->msg_len_to_cipher_in_bytes) {
+                                        state->job_in_lane[lane] = NULL;
+                                        state->unused_lanes =
+                                                (state->unused_lanes << 4) |
+                                                lane;
+                                        job->status |= STS_COMPLETED_AES;
+                                        return job;
+                                }
+                                state->lens[lane] = sm4_cbc_chunk
+                                        (job->msg_len_to_cipher_in_bytes -
+                                         done);
+                        }
+                        if (state->lens[lane] < min_len)
+                                min_len = state->lens[lane];
+                }
+
+                sm4_cbc_enc_lanes(state, min_len / SM4_BLOCK_SIZE);
+        }
+}
+
+JOB_AES_HMAC *
+SUBMIT_JOB_SM4_CBC_ENC(MB_MGR_AES_OOO *state, JOB_AES_HMAC *job)
+{
+        const unsigned lane = (unsigned) (state->unused_lanes & 15);
+
+        state->unused_lanes >>= 4;
+        state->job_in_lane[lane] = job;
+        state->args.in[lane] = job->src + job->cipher_start_src_offset_in_bytes;
+        state->args.out[lane] = job->dst;
+        state->args.keys[lane] = (const uint32_t *) job->aes_enc_key_expanded;
+        memcpy(&state->args.IV[lane], job->iv, SM4_BLOCK_SIZE);
+        state->lens[lane] = sm4_cbc_chunk(job->msg_len_to_cipher_in_bytes);
+
+        /* the last nibble is the flag */
+        if (state->unused_lanes != 0xF)
+                return NULL;
+
+        return sm4_cbc_enc_process(state);
+}
+
+JOB_AES_HMAC *
+FLUSH_JOB_SM4_CBC_ENC(MB_MGR_AES_OOO *state)
+{
+        unsigned lane;
+
+        for (lane = 0; lane < SIMD_LANES; lane++)
+                if (state->job_in_lane[lane] != NULL)
+                        return sm4_cbc_enc_process(state);
+
+        return NULL;
+}
+
+/* ========================================================================== */
+/* Single job modes */
+
+JOB_AES_HMAC *
+SUBMIT_JOB_SM4_CBC_DEC(JOB_AES_HMAC *job)
+{
+        DECLARE_ALIGNED(uint8_t ct[SIMD_LANES][SM4_BLOCK_SIZE], 64);
+        DECLARE_ALIGNED(uint8_t pt[SIMD_LANES][SM4_BLOCK_SIZE], 64);
+        const uint8_t *in = job->src + job->cipher_start_src_offset_in_bytes;
+        uint8_t *out = job->dst;
+        uint64_t num_blocks = job->msg_len_to_cipher_in_bytes /
+                SM4_BLOCK_SIZE;
+        uint8_t prev[SM4_BLOCK_SIZE];
+        simd_t rk[SM4_ROUNDS];
+        unsigned i, j, n;
+
+        sm4_set1_rk(rk, (const uint32_t *) job->aes_dec_key_expanded);
+        memcpy(prev, job->iv, sizeof(prev));
+
+        while (num_blocks != 0) {
+                n = (num_blocks < SIMD_LANES) ? (unsigned) num_blocks :
+                        SIMD_LANES;
+
+                /* copy of cipher text is kept for in-place operation */
+                memcpy(ct, in, n * SM4_BLOCK_SIZE);
+                sm4_crypt_blocks(rk, ct[0], n, pt);
+
+                for (i = 0; i < n; i++)
+                        for (j = 0; j < SM4_BLOCK_SIZE; j++)
+                                out[i * SM4_BLOCK_SIZE + j] = pt[i][j] ^
+                                        ((i == 0) ? prev[j] : ct[i - 1][j]);
+                memcpy(prev, ct[n - 1], sizeof(prev));
+
+                in += n * SM4_BLOCK_SIZE;
+                out += n * SM4_BLOCK_SIZE;
+                num_blocks -= n;
+        }
+
+        job->status |= STS_COMPLETED_AES;
+        return job;
+}
+
+JOB_AES_HMAC *
+SUBMIT_JOB_SM4_CNTR(JOB_AES_HMAC *job)
+{
+        uint8_t cb[SM4_BLOCK_SIZE];
+        simd_t rk[SM4_ROUNDS];
+
+        sm4_set1_rk(rk, (const uint32_t *) job->aes_enc_key_expanded);
+
+        /* 12-byte IV is followed by 32-bit block counter starting at 1 */
+        memset(cb, 0, sizeof(cb));
+        memcpy(cb, job->iv, job->iv_len_in_bytes);
+        if (job->iv_len_in_bytes == 12)
+                cb[SM4_BLOCK_SIZE - 1] = 1;
+
+        sm4_ctr_crypt(rk, cb, SM4_BLOCK_SIZE,
+                      job->src + job->cipher_start_src_offset_in_bytes,
+                      job->dst, job->msg_len_to_cipher_in_bytes);
+
+        job->status |= STS_COMPLETED_AES;
+        return job;
+}
+
+/* GHASH update of hash value s (zero padded data) */
+__forceinline void
+sm4_ghash(const struct sm4_gcm_key_data *key, uint8_t *s,
+          const uint8_t *data, uint64_t len)
+{
+#ifdef SM4_NO_AESNI
+        uint8_t h[GCM_BLOCK_LEN];
+        unsigned i;
+
+        for (i = 0; i < GCM_BLOCK_LEN; i++)
+                h[i] = key->hkey[3][GCM_BLOCK_LEN - 1 - i];
+
+        while (len != 0) {
+                const unsigned n = (len < GCM_BLOCK_LEN) ? (unsigned) len :
+                        GCM_BLOCK_LEN;
+
+                for (i = 0; i < n; i++)
+                        s[i] ^= data[i];
+                sm4_ghash_mul(s, h);
+                data += n;
+                len -= n;
+        }
+#else
+        __m128i x = ghash_bswap(_mm_loadu_si128((const __m128i *) s));
+
+        x = ghash_clmul_update(key->hkey, x, data, len);
+        _mm_storeu_si128((__m128i *) s, ghash_bswap(x));
+#endif
+}
+
+__forceinline void
+sm4_store_be64(uint8_t *p, const uint64_t x)
+{
+        unsigned i;
+
+        for (i = 0; i < 8; i++)
+                p[i] = (uint8_t) (x >> (56 - 8 * i));
+}
+
+static JOB_AES_HMAC *
+sm4_gcm(JOB_AES_HMAC *job, const struct sm4_gcm_key_data *key,
+        const int encrypt)
+{
+        const uint8_t *in = job->src + job->cipher_start_src_offset_in_bytes;
+        const uint64_t len = job->msg_len_to_cipher_in_bytes;
+        const uint64_t aad_len = job->u.SM4_GCM.aad_len_in_bytes;
+        uint8_t j0[SM4_BLOCK_SIZE], cb[SM4_BLOCK_SIZE];
+        uint8_t s[GCM_BLOCK_LEN], lens[GCM_BLOCK_LEN];
+        simd_t rk[SM4_ROUNDS];
+        uint64_t i;
+
+        sm4_set1_rk(rk, key->rk);
+
+        memcpy(j0, job->iv, 12);
+        j0[12] = 0;
+        j0[13] = 0;
+        j0[14] = 0;
+        j0[15] = 1;
+
+        memset(s, 0, sizeof(s));
+        sm4_ghash(key, s, (const uint8_t *) job->u.SM4_GCM.aad, aad_len);
+        if (!encrypt)
+                sm4_ghash(key, s, in, len);
+
+        memcpy(cb, j0, sizeof(cb));
+        sm4_ctr_inc(cb, 4);
+        sm4_ctr_crypt(rk, cb, 4, in, job->dst, len);
+
+        if (encrypt)
+                sm4_ghash(key, s, job->dst, len);
+        sm4_store_be64(&lens[0], aad_len * 8);
+        sm4_store_be64(&lens[8], len * 8);
+        sm4_ghash(key, s, lens, sizeof(lens));
+
+        sm4_crypt_block(key->rk, j0, j0);
+        for (i = 0; i < job->auth_tag_output_len_in_bytes; i++)
+                job->auth_tag_output[i] = s[i] ^ j0[i];
+
+        job->status = STS_COMPLETED;
+        return job;
+}
+
+JOB_AES_HMAC *
+SUBMIT_JOB_SM4_GCM_ENC(JOB_AES_HMAC *job)
+{
+        return sm4_gcm(job, (const struct sm4_gcm_key_data *)
+                       job->aes_enc_key_expanded, 1);
+}
+
+JOB_AES_HMAC *
+SUBMIT_JOB_SM4_GCM_DEC(JOB_AES_HMAC *job)
+{
+        return sm4_gcm(job, (const struct sm4_gcm_key_data *)
+                       job->aes_dec_key_expanded, 0);
+}
@@ -0,0 +1,145 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* SNOW 3G (3GPP UEA2 and UIA2) */
+
+#ifndef SNOW3G_H
+#define SNOW3G_H
+
+#include <stdint.h>
+#include "intel-ipsec-mb.h"
+
+/*
+ * S-box look-up tables, index 0 is for the most significant input byte
+ * - S1 is built on the AES S-box
+ * - S2 is built on the SQ S-box
+ */
+extern IMB_DLL_LOCAL const uint32_t snow3g_s1_tab[4][256];
+extern IMB_DLL_LOCAL const uint32_t snow3g_s2_tab[4][256];
+/* LFSR feedback: multiplication and division by alpha */
+extern IMB_DLL_LOCAL const uint32_t snow3g_mul_alpha_tab[256];
+extern IMB_DLL_LOCAL const uint32_t snow3g_div_alpha_tab[256];
+
+/**
+ * @brief Loads key and IV into a lane of the SNOW3G out of order manager
+ *
+ * FSM registers of the lane are cleared.
+ * The lane still has to go through the initialization rounds.
+ *
+ * @param ooo pointer to SNOW3G out of order manager (MB_MGR_SNOW3G_OOO)
+ * @param lane lane index
+ * @param key pointer to 16 byte key
+ * @param iv pointer to 16 byte IV
+ */
+IMB_DLL_LOCAL void
+snow3g_ooo_load_lane(void *ooo, const unsigned lane,
+                     const uint8_t *key, const uint8_t *iv);
+
+/**
+ * @brief UEA2 encryption/decryption of a bit string not starting
+ *        on a byte boundary
+ *
+ * Bits of \a out outside of the ciphered range are left unchanged.
+ *
+ * @param key pointer to 16 byte confidentiality key
+ * @param iv pointer to 16 byte IV
+ * @param in pointer to the byte holding the first input bit
+ * @param out pointer to the byte holding the first output bit
+ * @param len_bits number of bits to process
+ * @param offset_bits bit position of the first bit (0 is the MSB of
+ *                    the first byte)
+ */
+IMB_DLL_LOCAL void
+snow3g_f8_1_buffer_bit(const uint8_t *key, const uint8_t *iv,
+                       const uint8_t *in, uint8_t *out,
+                       const uint64_t len_bits, const uint64_t offset_bits);
+
+/**
+ * @brief Generates the first 5 keystream words used by UIA2
+ *
+ * @param key pointer to 16 byte integrity key
+ * @param iv pointer to 16 byte IV
+ * @param z pointer to 5 word keystream output
+ */
+IMB_DLL_LOCAL void
+snow3g_f9_keystream(const uint8_t *key, const uint8_t *iv, uint32_t z[5]);
+
+/**
+ * @brief Computes UIA2 MAC
+ *
+ * @param key pointer to 16 byte integrity key
+ * @param iv pointer to 16 byte IV
+ * @param msg pointer to the message
+ * @param len_bits message length in bits
+ * @param mac pointer to 4 byte MAC output
+ */
+IMB_DLL_LOCAL void
+snow3g_f9_1_buffer_sse_no_aesni(const uint8_t *key, const uint8_t *iv,
+                                const void *msg, const uint64_t len_bits,
+                                uint8_t *mac);
+IMB_DLL_LOCAL void
+snow3g_f9_1_buffer_sse(const uint8_t *key, const uint8_t *iv,
+                       const void *msg, const uint64_t len_bits,
+                       uint8_t *mac);
+IMB_DLL_LOCAL void
+snow3g_f9_1_buffer_avx(const uint8_t *key, const uint8_t *iv,
+                       const void *msg, const uint64_t len_bits,
+                       uint8_t *mac);
+IMB_DLL_LOCAL void
+snow3g_f9_1_buffer_avx2(const uint8_t *key, const uint8_t *iv,
+                        const void *msg, const uint64_t len_bits,
+                        uint8_t *mac);
+IMB_DLL_LOCAL void
+snow3g_f9_1_buffer_avx512(const uint8_t *key, const uint8_t *iv,
+                          const void *msg, const uint64_t len_bits,
+                          uint8_t *mac);
+
+/*
+ * Multi-buffer UEA2 out of order manager functions.
+ * The same manager is used to encrypt and decrypt.
+ */
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_snow3g_uea2_sse(MB_MGR_SNOW3G_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_snow3g_uea2_sse(MB_MGR_SNOW3G_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_snow3g_uea2_avx(MB_MGR_SNOW3G_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_snow3g_uea2_avx(MB_MGR_SNOW3G_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_snow3g_uea2_avx2(MB_MGR_SNOW3G_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_snow3g_uea2_avx2(MB_MGR_SNOW3G_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_snow3g_uea2_avx512(MB_MGR_SNOW3G_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_snow3g_uea2_avx512(MB_MGR_SNOW3G_OOO *state);
+
+#endif /* SNOW3G_H */
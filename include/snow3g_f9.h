@@ -0,0 +1,74 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * SNOW3G UIA2 (f9) code, with #define's to build a version
+ * for a given GF(2^64) multiplication method
+ *
+ * The following have to be defined before inclusion:
+ * - SNOW3G_MUL64 - GF(2^64) multiplication function
+ * - SNOW3G_F9_1_BUFFER - name of the API function
+ */
+
+#include "snow3g.h"
+
+void
+SNOW3G_F9_1_BUFFER(const uint8_t *key, const uint8_t *iv,
+                   const void *msg, const uint64_t len_bits, uint8_t *mac)
+{
+        const uint8_t *p = (const uint8_t *) msg;
+        uint64_t n = len_bits;
+        uint64_t eval = 0, m, pk, qk;
+        uint32_t z[5], tag;
+        unsigned i;
+
+        snow3g_f9_keystream(key, iv, z);
+        pk = (((uint64_t) z[0]) << 32) | z[1];
+        qk = (((uint64_t) z[2]) << 32) | z[3];
+
+        for (; n >= 64; n -= 64, p += 8) {
+                for (m = 0, i = 0; i < 8; i++)
+                        m = (m << 8) | p[i];
+                eval = SNOW3G_MUL64(eval ^ m, pk);
+        }
+
+        if (n != 0) {
+                /* zero padded last block */
+                for (m = 0, i = 0; i < 8; i++)
+                        m = (m << 8) | ((i < ((n + 7) / 8)) ? p[i] : 0);
+                m &= ~UINT64_C(0) << (64 - n);
+                eval = SNOW3G_MUL64(eval ^ m, pk);
+        }
+
+        eval = SNOW3G_MUL64(eval ^ len_bits, qk);
+
+        tag = ((uint32_t) (eval >> 32)) ^ z[4];
+        mac[0] = (uint8_t) (tag >> 24);
+        mac[1] = (uint8_t) (tag >> 16);
+        mac[2] = (uint8_t) (tag >> 8);
+        mac[3] = (uint8_t) tag;
+}
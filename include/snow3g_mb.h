@@ -0,0 +1,204 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * Multi-buffer SNOW3G (UEA2) and PCLMULQDQ based UIA2 code, with #define's
+ * to build an SSE, AVX, AVX2 or AVX512 version (see sse/snow3g_sse.c,
+ * avx/snow3g_avx.c, etc.)
+ *
+ * The following have to be defined before inclusion:
+ * - SIMD_LANES - number of 32-bit lanes in a vector (see simd_lanes.h)
+ * - SUBMIT_JOB_SNOW3G_UEA2, FLUSH_JOB_SNOW3G_UEA2, SNOW3G_F9_1_BUFFER -
+ *   names of API functions
+ */
+
+#include <wmmintrin.h>
+
+#include "intel-ipsec-mb.h"
+#include "simd_lanes.h"
+#include "stream_ooo.h"
+#include "snow3g.h"
+
+/* LFSR cell k, for the LFSR clocked j times from the loaded state */
+#define SNOW3G_S(_k) s[(j + (_k)) & 15]
+
+__forceinline
+simd_t
+snow3g_sbox(const uint32_t tab[4][256], const simd_t x)
+{
+        const simd_t y0 = SIMD_GATHER(tab[0], SIMD_SRL(x, 24));
+        const simd_t y1 = SIMD_GATHER(tab[1], SIMD_BYTE(x, 2));
+        const simd_t y2 = SIMD_GATHER(tab[2], SIMD_BYTE(x, 1));
+        const simd_t y3 = SIMD_GATHER(tab[3], SIMD_BYTE(x, 0));
+
+        return SIMD_XOR(SIMD_XOR(y0, y1), SIMD_XOR(y2, y3));
+}
+
+/**
+ * @brief Clocks SNOW3G once for all lanes
+ *
+ * @param s LFSR cells, cell k is at index (j + k) mod 16
+ * @param j number of times LFSR was clocked (modulo 16)
+ * @param r pointer to FSM registers R1, R2 and R3
+ * @param init_mode non-zero for initialization mode
+ *
+ * @return keystream word (work mode)
+ */
+__forceinline
+simd_t
+snow3g_clock(simd_t *s, const unsigned j, simd_t *r, const int init_mode)
+{
+        /* FSM */
+        const simd_t f = SIMD_XOR(SIMD_ADD(SNOW3G_S(15), r[0]), r[1]);
+        const simd_t r1 = SIMD_ADD(r[1], SIMD_XOR(r[2], SNOW3G_S(5)));
+        const simd_t z = SIMD_XOR(f, SNOW3G_S(0));
+        simd_t v;
+
+        r[2] = snow3g_sbox(snow3g_s2_tab, r[1]);
+        r[1] = snow3g_sbox(snow3g_s1_tab, r[0]);
+        r[0] = r1;
+
+        /* LFSR */
+        v = SIMD_XOR(SIMD_SLL(SNOW3G_S(0), 8),
+                     SIMD_GATHER(snow3g_mul_alpha_tab,
+                                 SIMD_SRL(SNOW3G_S(0), 24)));
+        v = SIMD_XOR(v, SIMD_XOR(SNOW3G_S(2), SIMD_SRL(SNOW3G_S(11), 8)));
+        v = SIMD_XOR(v, SIMD_GATHER(snow3g_div_alpha_tab,
+                                    SIMD_BYTE(SNOW3G_S(11), 0)));
+        if (init_mode)
+                v = SIMD_XOR(v, f);
+        SNOW3G_S(0) = v;
+
+        return z;
+}
+
+/* runs initialization rounds on lanes from the mask */
+static void
+snow3g_init_lanes(void *ooo, const uint32_t lanes)
+{
+        MB_MGR_SNOW3G_OOO *state = (MB_MGR_SNOW3G_OOO *) ooo;
+        DECLARE_ALIGNED(uint32_t tmp[16 + 3][AVX512_NUM_SNOW3G_LANES], 64);
+        simd_t s[16], r[3];
+        unsigned i, j, lane;
+
+        for (i = 0; i < 16; i++)
+                s[i] = SIMD_LOAD(state->lfsr[i]);
+        for (i = 0; i < 3; i++)
+                r[i] = SIMD_LOAD(state->fsm[i]);
+
+        for (i = 0; i < 2; i++)
+                for (j = 0; j < 16; j++)
+                        (void) snow3g_clock(s, j, r, 1);
+
+        /* first keystream word is discarded */
+        j = 0;
+        (void) snow3g_clock(s, j, r, 0);
+
+        /* cell k is at index k + 1 now */
+        for (i = 0; i < 16; i++)
+                SIMD_STORE(tmp[i], s[(i + 1) & 15]);
+        for (i = 0; i < 3; i++)
+                SIMD_STORE(tmp[16 + i], r[i]);
+
+        for (lane = 0; lane < SIMD_LANES; lane++) {
+                if ((lanes & (1 << lane)) == 0)
+                        continue;
+                for (i = 0; i < 16; i++)
+                        state->lfsr[i][lane] = tmp[i][lane];
+                for (i = 0; i < 3; i++)
+                        state->fsm[i][lane] = tmp[16 + i][lane];
+        }
+}
+
+static void
+snow3g_keystream(void *ooo, uint32_t ks[][STREAM_OOO_MAX_LANES])
+{
+        MB_MGR_SNOW3G_OOO *state = (MB_MGR_SNOW3G_OOO *) ooo;
+        simd_t s[16], r[3];
+        unsigned i, j;
+
+        for (i = 0; i < 16; i++)
+                s[i] = SIMD_LOAD(state->lfsr[i]);
+        for (i = 0; i < 3; i++)
+                r[i] = SIMD_LOAD(state->fsm[i]);
+
+        for (j = 0; j < STREAM_OOO_KS_WORDS; j++)
+                SIMD_STORE(ks[j], snow3g_clock(s, j, r, 0));
+
+        for (i = 0; i < 16; i++)
+                SIMD_STORE(state->lfsr[i], s[i]);
+        for (i = 0; i < 3; i++)
+                SIMD_STORE(state->fsm[i], r[i]);
+}
+
+JOB_AES_HMAC *
+SUBMIT_JOB_SNOW3G_UEA2(MB_MGR_SNOW3G_OOO *state, JOB_AES_HMAC *job)
+{
+        const uint64_t offset = job->cipher_start_src_offset_in_bits;
+        const uint64_t len = job->msg_len_to_cipher_in_bits;
+        const uint8_t *in = job->src + (offset / 8);
+
+        if (offset & 7) {
+                /* ciphering doesn't start on byte boundary */
+                snow3g_f8_1_buffer_bit(job->aes_enc_key_expanded, job->iv,
+                                       in, job->dst, len, offset & 7);
+                job->status |= STS_COMPLETED_AES;
+                return job;
+        }
+
+        return stream_ooo_submit(state, &state->lanes, job, SIMD_LANES,
+                                 in, (len + 7) / 8,
+                                 (uint8_t) (0xff00 >> (((len - 1) & 7) + 1)),
+                                 snow3g_ooo_load_lane, snow3g_init_lanes,
+                                 snow3g_keystream);
+}
+
+JOB_AES_HMAC *
+FLUSH_JOB_SNOW3G_UEA2(MB_MGR_SNOW3G_OOO *state)
+{
+        return stream_ooo_flush(state, &state->lanes, SIMD_LANES,
+                                snow3g_init_lanes, snow3g_keystream);
+}
+
+/* multiplication in GF(2^64) with x^64 + x^4 + x^3 + x + 1 polynomial */
+__forceinline
+uint64_t
+snow3g_mul64(const uint64_t a, const uint64_t b)
+{
+        const __m128i poly = _mm_cvtsi64_si128(0x1b);
+        const __m128i p = _mm_clmulepi64_si128(_mm_cvtsi64_si128(a),
+                                               _mm_cvtsi64_si128(b), 0x00);
+        /* fold high 64 bits twice (the second fold is below 2^10) */
+        const __m128i t = _mm_clmulepi64_si128(p, poly, 0x01);
+        const __m128i u = _mm_clmulepi64_si128(t, poly, 0x01);
+
+        return (uint64_t) _mm_cvtsi128_si64(_mm_xor_si128(_mm_xor_si128(p, t),
+                                                          u));
+}
+
+#define SNOW3G_MUL64 snow3g_mul64
+#include "snow3g_f9.h"
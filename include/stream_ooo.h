@@ -0,0 +1,272 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * Out of order scheduler for word oriented stream ciphers (ZUC, SNOW3G)
+ * and ciphers in keystream generator mode (KASUMI F8)
+ *
+ * Lanes are filled on submit. Once all of them are busy (or on flush)
+ * lanes waiting for initialization are initialized and keystream is
+ * generated for all lanes in chunks of STREAM_OOO_KS_WORDS words until
+ * the shortest job is done. Its lane is released and the job returned.
+ * As 16 LFSR clocks make the cells return to their original rows,
+ * the LFSR row order is the same at the start of each chunk.
+ *
+ * Each call returns at most one completed job. Jobs that completed
+ * at the same time as the returned one keep their lanes until
+ * the next call, which returns them without generating keystream.
+ */
+
+#ifndef STREAM_OOO_H
+#define STREAM_OOO_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "intel-ipsec-mb.h"
+
+#define STREAM_OOO_KS_WORDS 16
+#define STREAM_OOO_KS_BYTES (STREAM_OOO_KS_WORDS * 4)
+#define STREAM_OOO_MAX_LANES 16
+
+/*
+ * Algorithm callbacks get the algorithm specific out of order manager
+ * (MB_MGR_ZUC_OOO, MB_MGR_KASUMI_OOO etc.) as the state argument.
+ */
+
+/* initializes lanes from the mask (state loaded by submit), may be NULL */
+typedef void (*stream_ooo_init_t)(void *state, const uint32_t lanes);
+/* generates STREAM_OOO_KS_WORDS keystream words for all lanes */
+typedef void (*stream_ooo_ks_t)(void *state,
+                                uint32_t ks[][STREAM_OOO_MAX_LANES]);
+/* loads key & IV into a lane */
+typedef void (*stream_ooo_load_t)(void *state, const unsigned lane,
+                                  const uint8_t *key, const uint8_t *iv);
+
+/**
+ * @brief XOR's keystream words of one lane with the input
+ *
+ * Keystream words are serialized most significant byte first.
+ *
+ * @param ks keystream words of all lanes
+ * @param lane lane index
+ * @param in pointer to input
+ * @param out pointer to output
+ * @param len number of bytes to process (up to STREAM_OOO_KS_BYTES)
+ */
+__forceinline
+void
+stream_ooo_xor(uint32_t ks[][STREAM_OOO_MAX_LANES], const unsigned lane,
+               const uint8_t *in, uint8_t *out, const uint64_t len)
+{
+        uint8_t buf[STREAM_OOO_KS_BYTES];
+        uint64_t i;
+
+        for (i = 0; i < ((len + 3) / 4); i++) {
+                const uint32_t z = ks[i][lane];
+
+                buf[i * 4 + 0] = (uint8_t) (z >> 24);
+                buf[i * 4 + 1] = (uint8_t) (z >> 16);
+                buf[i * 4 + 2] = (uint8_t) (z >> 8);
+                buf[i * 4 + 3] = (uint8_t) z;
+        }
+
+        for (i = 0; (i + 8) <= len; i += 8) {
+                uint64_t a, b;
+
+                memcpy(&a, &in[i], sizeof(a));
+                memcpy(&b, &buf[i], sizeof(b));
+                a ^= b;
+                memcpy(&out[i], &a, sizeof(a));
+        }
+
+        for (; i < len; i++)
+                out[i] = in[i] ^ buf[i];
+}
+
+__forceinline
+JOB_AES_HMAC *
+stream_ooo_release_lane(STREAM_OOO_LANES *ooo, const unsigned lane)
+{
+        JOB_AES_HMAC *job = ooo->job_in_lane[lane];
+
+        ooo->job_in_lane[lane] = NULL;
+        ooo->unused_lanes = (ooo->unused_lanes << 4) | lane;
+        ooo->num_lanes_inuse--;
+        job->status |= STS_COMPLETED_AES;
+        return job;
+}
+
+/**
+ * @brief Processes lanes in use until the shortest job is complete
+ *
+ * @param state pointer to algorithm specific out of order manager
+ * @param ooo pointer to lanes of the manager
+ * @param num_lanes number of lanes of the architecture
+ * @param init_fn lane initialization function
+ * @param ks_fn keystream generation function
+ *
+ * @return completed job
+ */
+__forceinline
+JOB_AES_HMAC *
+stream_ooo_process(void *state, STREAM_OOO_LANES *ooo,
+                   const unsigned num_lanes,
+                   stream_ooo_init_t init_fn, stream_ooo_ks_t ks_fn)
+{
+        DECLARE_ALIGNED(uint32_t ks[STREAM_OOO_KS_WORDS]
+                        [STREAM_OOO_MAX_LANES], 64);
+        uint64_t min_len = UINT64_MAX;
+        unsigned lane, min_lane = 0;
+
+        for (lane = 0; lane < num_lanes; lane++) {
+                if (ooo->job_in_lane[lane] == NULL)
+                        continue;
+                if (ooo->lens[lane] < min_len) {
+                        min_len = ooo->lens[lane];
+                        min_lane = lane;
+                }
+        }
+
+        /* job completed together with the previously returned one */
+        if (min_len == 0)
+                return stream_ooo_release_lane(ooo, min_lane);
+
+        if (ooo->init_lanes != 0) {
+                if (init_fn != NULL)
+                        init_fn(state, ooo->init_lanes);
+                ooo->init_lanes = 0;
+        }
+
+        while (min_len != 0) {
+                ks_fn(state, ks);
+
+                for (lane = 0; lane < num_lanes; lane++) {
+                        uint64_t n = ooo->lens[lane];
+                        uint8_t *out = ooo->out[lane];
+                        uint8_t last = 0;
+
+                        if (ooo->job_in_lane[lane] == NULL || n == 0)
+                                continue;
+
+                        if (n > STREAM_OOO_KS_BYTES)
+                                n = STREAM_OOO_KS_BYTES;
+                        else
+                                last = out[n - 1];
+
+                        stream_ooo_xor(ks, lane, ooo->in[lane], out, n);
+
+                        ooo->in[lane] += n;
+                        ooo->out[lane] += n;
+                        ooo->lens[lane] -= n;
+
+                        if (ooo->lens[lane] == 0) {
+                                /* keep bits following the last ciphered bit */
+                                const uint8_t mask =
+                                        ooo->last_byte_mask[lane];
+
+                                out[n - 1] = (out[n - 1] & mask) |
+                                        (last & ~mask);
+                        }
+                }
+
+                if (min_len > STREAM_OOO_KS_BYTES)
+                        min_len -= STREAM_OOO_KS_BYTES;
+                else
+                        min_len = 0;
+        }
+
+        return stream_ooo_release_lane(ooo, min_lane);
+}
+
+/**
+ * @brief Submits a job to the out of order manager
+ *
+ * @param state pointer to algorithm specific out of order manager
+ * @param ooo pointer to lanes of the manager
+ * @param job job to be submitted
+ * @param num_lanes number of lanes of the architecture
+ * @param in pointer to the first byte to process
+ * @param len number of bytes to process
+ * @param last_byte_mask bits of the last byte to be written
+ * @param load_fn key & IV load function
+ * @param init_fn lane initialization function
+ * @param ks_fn keystream generation function
+ *
+ * @return completed job or NULL if all lanes are not busy yet
+ */
+__forceinline
+JOB_AES_HMAC *
+stream_ooo_submit(void *state, STREAM_OOO_LANES *ooo, JOB_AES_HMAC *job,
+                  const unsigned num_lanes, const uint8_t *in,
+                  const uint64_t len, const uint8_t last_byte_mask,
+                  stream_ooo_load_t load_fn, stream_ooo_init_t init_fn,
+                  stream_ooo_ks_t ks_fn)
+{
+        const unsigned lane = (unsigned) (ooo->unused_lanes & 15);
+
+        ooo->unused_lanes >>= 4;
+        ooo->num_lanes_inuse++;
+
+        ooo->job_in_lane[lane] = job;
+        ooo->in[lane] = in;
+        ooo->out[lane] = job->dst;
+        ooo->lens[lane] = len;
+        ooo->last_byte_mask[lane] = last_byte_mask;
+        load_fn(state, lane, (const uint8_t *) job->aes_enc_key_expanded,
+                job->iv);
+        ooo->init_lanes |= (1 << lane);
+
+        if (ooo->num_lanes_inuse < num_lanes)
+                return NULL;
+
+        return stream_ooo_process(state, ooo, num_lanes, init_fn, ks_fn);
+}
+
+/**
+ * @brief Flushes the out of order manager
+ *
+ * @param state pointer to algorithm specific out of order manager
+ * @param ooo pointer to lanes of the manager
+ * @param num_lanes number of lanes of the architecture
+ * @param init_fn lane initialization function
+ * @param ks_fn keystream generation function
+ *
+ * @return completed job or NULL if there are no jobs in the manager
+ */
+__forceinline
+JOB_AES_HMAC *
+stream_ooo_flush(void *state, STREAM_OOO_LANES *ooo, const unsigned num_lanes,
+                 stream_ooo_init_t init_fn, stream_ooo_ks_t ks_fn)
+{
+        if (ooo->num_lanes_inuse == 0)
+                return NULL;
+
+        return stream_ooo_process(state, ooo, num_lanes, init_fn, ks_fn);
+}
+
+#endif /* STREAM_OOO_H */
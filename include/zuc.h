@@ -0,0 +1,93 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* ZUC (3GPP 128-EEA3 and 128-EIA3) */
+
+#ifndef ZUC_H
+#define ZUC_H
+
+#include <stdint.h>
+#include "intel-ipsec-mb.h"
+
+#define ZUC_P 0x7fffffff /* LFSR cells are elements of GF(2^31 - 1) */
+
+/* S-box look-up tables: S0 << 24, S1 << 16, S0 << 8 and S1 */
+extern IMB_DLL_LOCAL const uint32_t zuc_sbox_tab[4][256];
+
+/**
+ * @brief Loads key and IV into a lane of the ZUC out of order manager
+ *
+ * FSM registers of the lane are cleared.
+ * The lane still has to go through the initialization rounds.
+ *
+ * @param ooo pointer to ZUC out of order manager (MB_MGR_ZUC_OOO)
+ * @param lane lane index
+ * @param key pointer to 16 byte key
+ * @param iv pointer to 16 byte IV
+ */
+IMB_DLL_LOCAL void
+zuc_ooo_load_lane(void *ooo, const unsigned lane,
+                  const uint8_t *key, const uint8_t *iv);
+
+/**
+ * @brief Computes 128-EIA3 MAC
+ *
+ * @param key pointer to 16 byte integrity key
+ * @param iv pointer to 16 byte IV
+ * @param msg pointer to the message
+ * @param len_bits message length in bits
+ * @param mac pointer to 4 byte MAC output
+ */
+IMB_DLL_LOCAL void
+zuc_eia3_1_buffer(const uint8_t *key, const uint8_t *iv, const void *msg,
+                  const uint64_t len_bits, uint8_t *mac);
+
+/*
+ * Multi-buffer 128-EEA3 out of order manager functions.
+ * The same manager is used to encrypt and decrypt.
+ */
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_zuc_eea3_sse(MB_MGR_ZUC_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_zuc_eea3_sse(MB_MGR_ZUC_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_zuc_eea3_avx(MB_MGR_ZUC_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_zuc_eea3_avx(MB_MGR_ZUC_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_zuc_eea3_avx2(MB_MGR_ZUC_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_zuc_eea3_avx2(MB_MGR_ZUC_OOO *state);
+
+IMB_DLL_LOCAL JOB_AES_HMAC *
+submit_job_zuc_eea3_avx512(MB_MGR_ZUC_OOO *state, JOB_AES_HMAC *job);
+IMB_DLL_LOCAL JOB_AES_HMAC *
+flush_job_zuc_eea3_avx512(MB_MGR_ZUC_OOO *state);
+
+#endif /* ZUC_H */
@@ -0,0 +1,213 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * Multi-buffer ZUC (128-EEA3) code, with #define's to build
+ * an SSE, AVX, AVX2 or AVX512 version (see sse/zuc_sse.c, avx/zuc_avx.c, etc.)
+ *
+ * The following have to be defined before inclusion:
+ * - SIMD_LANES - number of 32-bit lanes in a vector (see simd_lanes.h)
+ * - SUBMIT_JOB_ZUC_EEA3, FLUSH_JOB_ZUC_EEA3 - names of API functions
+ */
+
+#include "intel-ipsec-mb.h"
+#include "simd_lanes.h"
+#include "stream_ooo.h"
+#include "zuc.h"
+
+/* rotate 31-bit LFSR cells left */
+#define ZUC_ROL31(_v, _n)                                               \
+        SIMD_AND(SIMD_OR(SIMD_SLL((_v), (_n)),                          \
+                         SIMD_SRL((_v), 31 - (_n))),                    \
+                 SIMD_SET1(ZUC_P))
+
+/* LFSR cell k, for the LFSR clocked j times from the loaded state */
+#define ZUC_S(_k) s[(j + (_k)) & 15]
+
+/* addition modulo 2^31 - 1 */
+__forceinline
+simd_t
+zuc_add31(const simd_t a, const simd_t b)
+{
+        const simd_t c = SIMD_ADD(a, b);
+
+        return SIMD_ADD(SIMD_AND(c, SIMD_SET1(ZUC_P)), SIMD_SRL(c, 31));
+}
+
+__forceinline
+simd_t
+zuc_sbox(const simd_t x)
+{
+        const simd_t y0 = SIMD_GATHER(zuc_sbox_tab[0], SIMD_SRL(x, 24));
+        const simd_t y1 = SIMD_GATHER(zuc_sbox_tab[1], SIMD_BYTE(x, 2));
+        const simd_t y2 = SIMD_GATHER(zuc_sbox_tab[2], SIMD_BYTE(x, 1));
+        const simd_t y3 = SIMD_GATHER(zuc_sbox_tab[3], SIMD_BYTE(x, 0));
+
+        return SIMD_OR(SIMD_OR(y0, y1), SIMD_OR(y2, y3));
+}
+
+__forceinline
+simd_t
+zuc_l1(const simd_t x)
+{
+        return SIMD_XOR(SIMD_XOR(x, SIMD_ROL(x, 2)),
+                        SIMD_XOR(SIMD_XOR(SIMD_ROL(x, 10), SIMD_ROL(x, 18)),
+                                 SIMD_ROL(x, 24)));
+}
+
+__forceinline
+simd_t
+zuc_l2(const simd_t x)
+{
+        return SIMD_XOR(SIMD_XOR(x, SIMD_ROL(x, 8)),
+                        SIMD_XOR(SIMD_XOR(SIMD_ROL(x, 14), SIMD_ROL(x, 22)),
+                                 SIMD_ROL(x, 30)));
+}
+
+/**
+ * @brief Clocks ZUC once for all lanes
+ *
+ * @param s LFSR cells, cell k is at index (j + k) mod 16
+ * @param j number of times LFSR was clocked (modulo 16)
+ * @param r1 pointer to FSM register R1
+ * @param r2 pointer to FSM register R2
+ * @param init_mode non-zero for initialization mode
+ *
+ * @return keystream word (work mode)
+ */
+__forceinline
+simd_t
+zuc_clock(simd_t *s, const unsigned j, simd_t *r1, simd_t *r2,
+          const int init_mode)
+{
+        /* bit reorganization */
+        const simd_t x0 = SIMD_OR(SIMD_SLL(SIMD_SRL(ZUC_S(15), 15), 16),
+                                  SIMD_AND(ZUC_S(14), SIMD_SET1(0xffff)));
+        const simd_t x1 = SIMD_OR(SIMD_SLL(ZUC_S(11), 16),
+                                  SIMD_SRL(ZUC_S(9), 15));
+        const simd_t x2 = SIMD_OR(SIMD_SLL(ZUC_S(7), 16),
+                                  SIMD_SRL(ZUC_S(5), 15));
+        const simd_t x3 = SIMD_OR(SIMD_SLL(ZUC_S(2), 16),
+                                  SIMD_SRL(ZUC_S(0), 15));
+        /* nonlinear function F */
+        const simd_t w = SIMD_ADD(SIMD_XOR(x0, *r1), *r2);
+        const simd_t w1 = SIMD_ADD(*r1, x1);
+        const simd_t w2 = SIMD_XOR(*r2, x2);
+        simd_t v;
+
+        *r1 = zuc_sbox(zuc_l1(SIMD_OR(SIMD_SLL(w1, 16), SIMD_SRL(w2, 16))));
+        *r2 = zuc_sbox(zuc_l2(SIMD_OR(SIMD_SLL(w2, 16), SIMD_SRL(w1, 16))));
+
+        /* LFSR */
+        v = zuc_add31(ZUC_S(0), ZUC_ROL31(ZUC_S(0), 8));
+        v = zuc_add31(v, ZUC_ROL31(ZUC_S(4), 20));
+        v = zuc_add31(v, ZUC_ROL31(ZUC_S(10), 21));
+        v = zuc_add31(v, ZUC_ROL31(ZUC_S(13), 17));
+        v = zuc_add31(v, ZUC_ROL31(ZUC_S(15), 15));
+        if (init_mode)
+                v = zuc_add31(v, SIMD_SRL(w, 1));
+        ZUC_S(0) = simd_zero_to(v, SIMD_SET1(ZUC_P));
+
+        return SIMD_XOR(w, x3);
+}
+
+/* runs initialization rounds on lanes from the mask */
+static void
+zuc_init_lanes(void *ooo, const uint32_t lanes)
+{
+        MB_MGR_ZUC_OOO *state = (MB_MGR_ZUC_OOO *) ooo;
+        DECLARE_ALIGNED(uint32_t tmp[16 + 2][AVX512_NUM_ZUC_LANES], 64);
+        simd_t s[16], r1, r2;
+        unsigned i, j, lane;
+
+        for (i = 0; i < 16; i++)
+                s[i] = SIMD_LOAD(state->lfsr[i]);
+        r1 = SIMD_LOAD(state->fsm[0]);
+        r2 = SIMD_LOAD(state->fsm[1]);
+
+        for (i = 0; i < 2; i++)
+                for (j = 0; j < 16; j++)
+                        (void) zuc_clock(s, j, &r1, &r2, 1);
+
+        /* first keystream word is discarded */
+        j = 0;
+        (void) zuc_clock(s, j, &r1, &r2, 0);
+
+        /* cell k is at index k + 1 now */
+        for (i = 0; i < 16; i++)
+                SIMD_STORE(tmp[i], s[(i + 1) & 15]);
+        SIMD_STORE(tmp[16], r1);
+        SIMD_STORE(tmp[17], r2);
+
+        for (lane = 0; lane < SIMD_LANES; lane++) {
+                if ((lanes & (1 << lane)) == 0)
+                        continue;
+                for (i = 0; i < 16; i++)
+                        state->lfsr[i][lane] = tmp[i][lane];
+                state->fsm[0][lane] = tmp[16][lane];
+                state->fsm[1][lane] = tmp[17][lane];
+        }
+}
+
+static void
+zuc_keystream(void *ooo, uint32_t ks[][STREAM_OOO_MAX_LANES])
+{
+        MB_MGR_ZUC_OOO *state = (MB_MGR_ZUC_OOO *) ooo;
+        simd_t s[16], r1, r2;
+        unsigned i, j;
+
+        for (i = 0; i < 16; i++)
+                s[i] = SIMD_LOAD(state->lfsr[i]);
+        r1 = SIMD_LOAD(state->fsm[0]);
+        r2 = SIMD_LOAD(state->fsm[1]);
+
+        for (j = 0; j < STREAM_OOO_KS_WORDS; j++)
+                SIMD_STORE(ks[j], zuc_clock(s, j, &r1, &r2, 0));
+
+        for (i = 0; i < 16; i++)
+                SIMD_STORE(state->lfsr[i], s[i]);
+        SIMD_STORE(state->fsm[0], r1);
+        SIMD_STORE(state->fsm[1], r2);
+}
+
+JOB_AES_HMAC *
+SUBMIT_JOB_ZUC_EEA3(MB_MGR_ZUC_OOO *state, JOB_AES_HMAC *job)
+{
+        return stream_ooo_submit(state, &state->lanes, job, SIMD_LANES,
+                                 job->src +
+                                 job->cipher_start_src_offset_in_bytes,
+                                 job->msg_len_to_cipher_in_bytes, 0xff,
+                                 zuc_ooo_load_lane, zuc_init_lanes,
+                                 zuc_keystream);
+}
+
+JOB_AES_HMAC *
+FLUSH_JOB_ZUC_EEA3(MB_MGR_ZUC_OOO *state)
+{
+        return stream_ooo_flush(state, &state->lanes, SIMD_LANES,
+                                zuc_init_lanes, zuc_keystream);
+}
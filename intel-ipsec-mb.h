@@ -107,6 +107,8 @@ typedef struct {
 #define NUM_SHA_224_DIGEST_WORDS 7
 #define NUM_SHA_512_DIGEST_WORDS 8
 #define NUM_SHA_384_DIGEST_WORDS 6
+#define NUM_SHA_512_256_DIGEST_WORDS 4
+#define NUM_SHA_512_224_DIGEST_WORDS 4 /* last word truncated to 32 bits */
 
 #define SHA_DIGEST_WORD_SIZE      4
 #define SHA224_DIGEST_WORD_SIZE   4
@@ -124,33 +126,121 @@ typedef struct {
         (NUM_SHA_384_DIGEST_WORDS * SHA384_DIGEST_WORD_SIZE)
 #define SHA512_DIGEST_SIZE_IN_BYTES \
         (NUM_SHA_512_DIGEST_WORDS * SHA512_DIGEST_WORD_SIZE)
+#define SHA512_256_DIGEST_SIZE_IN_BYTES 32
+#define SHA512_224_DIGEST_SIZE_IN_BYTES 28
 
 #define SHA1_BLOCK_SIZE 64    /* 512 bits is 64 byte blocks */
 #define SHA_256_BLOCK_SIZE 64 /* 512 bits is 64 byte blocks */
 #define SHA_384_BLOCK_SIZE 128
 #define SHA_512_BLOCK_SIZE 128
 
+#define SHA3_256_DIGEST_SIZE_IN_BYTES 32
+#define SHA3_384_DIGEST_SIZE_IN_BYTES 48
+#define SHA3_512_DIGEST_SIZE_IN_BYTES 64
+
+/* Keccak-f[1600] state size and sponge rates (block sizes) */
+#define SHA3_STATE_SIZE      200
+#define SHA3_256_BLOCK_SIZE  136
+#define SHA3_384_BLOCK_SIZE  104
+#define SHA3_512_BLOCK_SIZE  72
+#define SHAKE128_BLOCK_SIZE  168
+#define SHAKE256_BLOCK_SIZE  136
+#define SHA3_MAX_BLOCK_SIZE  SHAKE128_BLOCK_SIZE
+
+#define BLAKE2B_BLOCK_SIZE       128
+#define BLAKE2B_MAX_DIGEST_SIZE  64
+#define BLAKE2B_MAX_KEY_SIZE     64
+#define BLAKE2S_BLOCK_SIZE       64
+#define BLAKE2S_MAX_DIGEST_SIZE  32
+#define BLAKE2S_MAX_KEY_SIZE     32
+
+#define SM3_DIGEST_SIZE_IN_BYTES 32
+#define SM3_BLOCK_SIZE           64
+#define SM4_BLOCK_SIZE           16
+#define SM4_KEY_SIZE             16
+#define SM4_KEY_SCHED_SIZE       128 /* 32 round keys */
+
+#define ZUC_KEY_LEN_IN_BYTES    16
+#define ZUC_IV_LEN_IN_BYTES     16
+#define ZUC_MIN_BYTELEN         1
+#define ZUC_MAX_BYTELEN         65504
+#define ZUC_MIN_BITLEN          1
+#define ZUC_MAX_BITLEN          (ZUC_MAX_BYTELEN * 8)
+#define ZUC_DIGEST_LEN          4
+
+#define SNOW3G_KEY_LEN_IN_BYTES 16
+#define SNOW3G_IV_LEN_IN_BYTES  16
+#define SNOW3G_MIN_BITLEN       1
+#define SNOW3G_MAX_BITLEN       0xFFFFFFFF
+#define SNOW3G_DIGEST_LEN       4
+
+#define KASUMI_KEY_LEN_IN_BYTES 16
+#define KASUMI_IV_LEN_IN_BYTES  8
+#define KASUMI_MIN_BITLEN       1
+#define KASUMI_MAX_BITLEN       20000
+#define KASUMI_DIGEST_LEN       4
+
 /* Number of lanes AVX512, AVX2, AVX and SSE */
 #define AVX512_NUM_SHA1_LANES   16
 #define AVX512_NUM_SHA256_LANES 16
 #define AVX512_NUM_SHA512_LANES 8
 #define AVX512_NUM_MD5_LANES    32
 #define AVX512_NUM_DES_LANES    16
+#define AVX512_NUM_ZUC_LANES    16
+#define AVX512_NUM_SNOW3G_LANES 16
+#define AVX512_NUM_KASUMI_LANES 16
+#define AVX512_NUM_SHA3_LANES   8
+#define AVX512_NUM_BLAKE2B_LANES 8
+#define AVX512_NUM_BLAKE2S_LANES 16
+#define AVX512_NUM_SM3_LANES    16
+#define AVX512_NUM_SM4_LANES    8
+#define AVX512_NUM_GCM_SIV_LANES 8
+#define AVX512_NUM_AES_CFB_LANES 8
 
 #define AVX2_NUM_SHA1_LANES     8
 #define AVX2_NUM_SHA256_LANES   8
 #define AVX2_NUM_SHA512_LANES   4
 #define AVX2_NUM_MD5_LANES      16
+#define AVX2_NUM_ZUC_LANES      8
+#define AVX2_NUM_SNOW3G_LANES   8
+#define AVX2_NUM_KASUMI_LANES   8
+#define AVX2_NUM_SHA3_LANES     4
+#define AVX2_NUM_BLAKE2B_LANES  4
+#define AVX2_NUM_BLAKE2S_LANES  8
+#define AVX2_NUM_SM3_LANES      8
+#define AVX2_NUM_SM4_LANES      8
+#define AVX2_NUM_GCM_SIV_LANES  8
+#define AVX2_NUM_AES_CFB_LANES  8
 
 #define AVX_NUM_SHA1_LANES      4
 #define AVX_NUM_SHA256_LANES    4
 #define AVX_NUM_SHA512_LANES    2
 #define AVX_NUM_MD5_LANES       8
+#define AVX_NUM_ZUC_LANES       4
+#define AVX_NUM_SNOW3G_LANES    4
+#define AVX_NUM_KASUMI_LANES    4
+#define AVX_NUM_SHA3_LANES      2
+#define AVX_NUM_BLAKE2B_LANES   2
+#define AVX_NUM_BLAKE2S_LANES   4
+#define AVX_NUM_SM3_LANES       4
+#define AVX_NUM_SM4_LANES       4
+#define AVX_NUM_GCM_SIV_LANES   4
+#define AVX_NUM_AES_CFB_LANES   8
 
 #define SSE_NUM_SHA1_LANES   AVX_NUM_SHA1_LANES
 #define SSE_NUM_SHA256_LANES AVX_NUM_SHA256_LANES
 #define SSE_NUM_SHA512_LANES AVX_NUM_SHA512_LANES
 #define SSE_NUM_MD5_LANES    AVX_NUM_MD5_LANES
+#define SSE_NUM_ZUC_LANES    AVX_NUM_ZUC_LANES
+#define SSE_NUM_SNOW3G_LANES AVX_NUM_SNOW3G_LANES
+#define SSE_NUM_KASUMI_LANES AVX_NUM_KASUMI_LANES
+#define SSE_NUM_SHA3_LANES   AVX_NUM_SHA3_LANES
+#define SSE_NUM_BLAKE2B_LANES AVX_NUM_BLAKE2B_LANES
+#define SSE_NUM_BLAKE2S_LANES AVX_NUM_BLAKE2S_LANES
+#define SSE_NUM_SM3_LANES     AVX_NUM_SM3_LANES
+#define SSE_NUM_SM4_LANES     AVX_NUM_SM4_LANES
+#define SSE_NUM_GCM_SIV_LANES AVX_NUM_GCM_SIV_LANES
+#define SSE_NUM_AES_CFB_LANES 4 /* x4 as SSE CBC encryption */
 
 /*
  *  Each row is sized to hold enough lanes for AVX2, AVX1 and SSE use a subset
@@ -188,7 +278,15 @@ typedef enum {
         DES,
         DOCSIS_DES,
         CCM,
-        DES3
+        DES3,
+        ZUC_EEA3,               /* 3GPP 128-EEA3, byte lengths */
+        SNOW3G_UEA2_BITLEN,     /* 3GPP UEA2, bit lengths */
+        KASUMI_UEA1_BITLEN,     /* 3GPP UEA1 (KASUMI f8), bit lengths */
+        SM4_CBC,
+        SM4_CNTR,
+        SM4_GCM,                /* used with SM4_GMAC hash_alg */
+        AES_GCM_SIV,            /* RFC 8452, used with AES_GCM_SIV_TAG */
+        CFB                     /* AES-CFB-128, any message length */
 } JOB_CIPHER_MODE;
 
 typedef enum {
@@ -216,6 +314,30 @@ typedef enum {
         PLAIN_SHA_256,   /* SHA256 */
         PLAIN_SHA_384,   /* SHA384 */
         PLAIN_SHA_512,   /* SHA512 */
+        DOCSIS_CRC32,    /* DOCSIS CRC32 (Ethernet FCS) */
+        ZUC_EIA3_BITLEN,    /* 3GPP 128-EIA3 */
+        SNOW3G_UIA2_BITLEN, /* 3GPP UIA2 */
+        KASUMI_UIA1_BITLEN, /* 3GPP UIA1 (KASUMI f9) */
+        PLAIN_SHA3_256,  /* SHA3-256 */
+        PLAIN_SHA3_384,  /* SHA3-384 */
+        PLAIN_SHA3_512,  /* SHA3-512 */
+        PLAIN_SHAKE128,  /* SHAKE128, any output length */
+        PLAIN_SHAKE256,  /* SHAKE256, any output length */
+        SHA3_256,        /* HMAC-SHA3-256 */
+        SHA3_384,        /* HMAC-SHA3-384 */
+        SHA3_512,        /* HMAC-SHA3-512 */
+        PLAIN_BLAKE2B,   /* BLAKE2b, 1 to 64 byte digest */
+        PLAIN_BLAKE2S,   /* BLAKE2s, 1 to 32 byte digest */
+        BLAKE2B_KEYED,   /* keyed BLAKE2b (MAC) */
+        BLAKE2S_KEYED,   /* keyed BLAKE2s (MAC) */
+        PLAIN_SM3,
+        SM3,             /* HMAC-SM3 */
+        SM4_GMAC,        /* SM4-GCM tag */
+        AES_GCM_SIV_TAG, /* AES-GCM-SIV tag (POLYVAL based) */
+        PLAIN_SHA_512_256, /* SHA512/256 */
+        PLAIN_SHA_512_224, /* SHA512/224 */
+        SHA_512_256,     /* HMAC-SHA512/256 */
+        SHA_512_224,     /* HMAC-SHA512/224 */
 } JOB_HASH_ALG;
 
 typedef enum {
@@ -233,7 +355,8 @@ typedef struct JOB_AES_HMAC {
         /*
          * For AES, aes_enc_key_expanded and aes_dec_key_expanded are
          * expected to point to expanded keys structure.
-         * - AES-CTR and AES-CCM, only aes_enc_key_expanded is used
+         * - AES-CTR, AES-CCM and AES-CFB, only aes_enc_key_expanded
+         *   is used
          * - DOCSIS (AES-CBC + AES-CFB), both pointers are used
          *   aes_enc_key_expanded has to be set always for the partial block
          *
@@ -245,6 +368,15 @@ typedef struct JOB_AES_HMAC {
          * expected to point to an array of 3 pointers for
          * the corresponding 3 key schedules.
          * - same key schedule used for enc and dec operations
+         *
+         * For ZUC-EEA3 and SNOW3G-UEA2, aes_enc_key_expanded is expected
+         * to point to the 16 byte confidentiality key (no expansion needed)
+         * and iv to the 16 byte initialization vector, formatted
+         * as specified for the algorithm (COUNT, BEARER, DIRECTION).
+         *
+         * For KASUMI-UEA1, aes_enc_key_expanded is expected to point to
+         * the 16 byte confidentiality key and iv to the 8 byte
+         * COUNT || BEARER || DIRECTION || 0...0 block.
          */
         const void *aes_enc_key_expanded;  /* 16-byte aligned pointer. */
         const void *aes_dec_key_expanded;
@@ -254,18 +386,34 @@ typedef struct JOB_AES_HMAC {
                              * In-place ciphering allowed. */
         uint8_t *dst; /*Output. May be cipher text or plaintext.
                        * In-place ciphering allowed, i.e. dst = src. */
-        uint64_t cipher_start_src_offset_in_bytes;
-        uint64_t msg_len_to_cipher_in_bytes; /* Max len = 65472 bytes.
-                                              * IPSec case, the maximum cipher
-                                              * length would be:
-                                              * 65535 -
-                                              * 20 (outer IP header) -
-                                              * 24 (ESP header + IV) -
-                                              * 12 (supported ICV length) */
+        union {
+                uint64_t cipher_start_src_offset_in_bytes;
+                /* SNOW3G_UEA2_BITLEN and KASUMI_UEA1_BITLEN: the first
+                 * ciphered bit is written at the same bit position
+                 * of dst[0] */
+                uint64_t cipher_start_src_offset_in_bits;
+        };
+        union {
+                /* Max len = 65472 bytes.
+                 * IPSec case, the maximum cipher length would be:
+                 * 65535 -
+                 * 20 (outer IP header) -
+                 * 24 (ESP header + IV) -
+                 * 12 (supported ICV length) */
+                uint64_t msg_len_to_cipher_in_bytes;
+                uint64_t msg_len_to_cipher_in_bits; /* SNOW3G_UEA2_BITLEN
+                                                     * and KASUMI_UEA1_BITLEN
+                                                     */
+        };
         uint64_t hash_start_src_offset_in_bytes;
-        uint64_t msg_len_to_hash_in_bytes; /* Max len = 65496 bytes.
-                                            * (Max cipher len +
-                                            * 24 bytes ESP header) */
+        union {
+                /* Max len = 65496 bytes.
+                 * (Max cipher len + 24 bytes ESP header) */
+                uint64_t msg_len_to_hash_in_bytes;
+                uint64_t msg_len_to_hash_in_bits; /* ZUC_EIA3_BITLEN,
+                                                   * SNOW3G_UIA2_BITLEN and
+                                                   * KASUMI_UIA1_BITLEN */
+        };
         const uint8_t *iv; /* AES IV. */
         uint64_t iv_len_in_bytes; /* AES IV length in bytes. */
         uint8_t *auth_tag_output; /* HMAC Tag output. This may point to
@@ -277,6 +425,11 @@ typedef struct JOB_AES_HMAC {
 
         /* Start algorithm-specific fields */
         union {
+                /*
+                 * For HMAC-SHA3 (SHA3_256, SHA3_384 and SHA3_512) these
+                 * point to SHA3_STATE_SIZE byte Keccak states, see
+                 * sha3_256_one_block() etc.
+                 */
                 struct _HMAC_specific_fields {
                         /* Hashed result of HMAC key xor'd with ipad (0x36). */
                         const uint8_t *_hashed_auth_key_xor_ipad;
@@ -306,6 +459,41 @@ typedef struct JOB_AES_HMAC {
                         uint64_t aad_len_in_bytes;    /* Length of AAD */
                 } GCM;
 #endif /* !NO_GCM */
+                struct _ZUC_EIA3_specific_fields {
+                        const uint8_t *_key; /* 16 byte integrity key */
+                        const uint8_t *_iv;  /* 16 byte IV */
+                } ZUC_EIA3;
+                struct _SNOW3G_UIA2_specific_fields {
+                        const uint8_t *_key; /* 16 byte integrity key */
+                        const uint8_t *_iv;  /* 16 byte IV */
+                } SNOW3G_UIA2;
+                struct _KASUMI_UIA1_specific_fields {
+                        const uint8_t *_key; /* 16 byte integrity key */
+                        const uint8_t *_iv;  /* 8 byte COUNT || FRESH */
+                        uint64_t _direction; /* 0 or 1 */
+                } KASUMI_UIA1;
+                struct _BLAKE2_specific_fields {
+                        const uint8_t *_key; /* raw key */
+                        uint64_t _key_len_in_bytes; /* 1 to 64 (BLAKE2b)
+                                                     * or 32 (BLAKE2s) */
+                } BLAKE2;
+                struct _SM4_GCM_specific_fields {
+                        /* Additional Authentication Data (AAD) */
+                        const void *aad;
+                        uint64_t aad_len_in_bytes;    /* Length of AAD */
+                } SM4_GCM;
+                struct _AES_GCM_SIV_specific_fields {
+                        /* Additional Authentication Data (AAD) */
+                        const void *aad;
+                        uint64_t aad_len_in_bytes;    /* Length of AAD */
+                        /*
+                         * Received tag (decrypt only), it is the initial
+                         * counter block. The computed tag is written
+                         * to auth_tag_output and has to be compared with
+                         * this one before the plaintext is used.
+                         */
+                        const uint8_t *tag;
+                } GCM_SIV;
         } u;
 
         JOB_STS status;
@@ -443,6 +631,113 @@ typedef struct {
         uint32_t num_lanes_inuse;
 } MB_MGR_DES_OOO;
 
+/* stream cipher out-of-order scheduler lanes (see stream_ooo.h) */
+typedef struct {
+        const uint8_t *in[16];
+        uint8_t *out[16];
+        uint64_t lens[16]; /* bytes left to process */
+        /* bits of the last byte that are to be ciphered */
+        uint8_t last_byte_mask[16];
+        /* each nibble is index (0...15) of unused lanes */
+        uint64_t unused_lanes;
+        JOB_AES_HMAC *job_in_lane[16];
+        uint32_t num_lanes_inuse;
+        uint32_t init_lanes; /* mask of lanes waiting for initialization */
+} STREAM_OOO_LANES;
+
+/* ZUC-EEA3 and SNOW3G-UEA2 */
+typedef struct {
+        /* LFSR cells and FSM registers, lane index is the column */
+        DECLARE_ALIGNED(uint32_t lfsr[16][AVX512_NUM_ZUC_LANES], 64);
+        DECLARE_ALIGNED(uint32_t fsm[3][AVX512_NUM_ZUC_LANES], 64);
+        STREAM_OOO_LANES lanes;
+} MB_MGR_ZUC_OOO;
+
+/* SNOW3G has the same LFSR length, its FSM uses all 3 registers */
+typedef MB_MGR_ZUC_OOO MB_MGR_SNOW3G_OOO;
+
+/* KASUMI-UEA1 */
+typedef struct {
+        /* round subkeys KLi1, KLi2, KOi1-3 and KIi1-3 of round i
+         * are in rows 8 * i to 8 * i + 7, lane index is the column */
+        DECLARE_ALIGNED(uint32_t sk[8 * 8][AVX512_NUM_KASUMI_LANES], 64);
+        /* A register (KASUMI of IV with modified key) */
+        DECLARE_ALIGNED(uint32_t a[2][AVX512_NUM_KASUMI_LANES], 64);
+        /* previous keystream block */
+        DECLARE_ALIGNED(uint32_t ksb[2][AVX512_NUM_KASUMI_LANES], 64);
+        /* block counter */
+        DECLARE_ALIGNED(uint32_t blkcnt[AVX512_NUM_KASUMI_LANES], 64);
+        STREAM_OOO_LANES lanes;
+} MB_MGR_KASUMI_OOO;
+
+/* SHA3, SHAKE and HMAC-SHA3 lane data */
+typedef struct {
+        /* padded last block of the message or of the outer hash */
+        DECLARE_ALIGNED(uint8_t extra_block[SHA3_MAX_BLOCK_SIZE], 8);
+        JOB_AES_HMAC *job_in_lane;
+        uint64_t out_done;     /* number of output bytes squeezed */
+        uint32_t extra_done;   /* last block queued for absorbing */
+        uint32_t outer_done;   /* HMAC outer hash started */
+} SHA3_LANE_DATA;
+
+/*
+ * SHA3 out-of-order scheduler fields.
+ * One manager serves all algorithms with the same sponge rate.
+ */
+typedef struct {
+        /* Keccak-f[1600] state words, lane index is the column */
+        DECLARE_ALIGNED(uint64_t state[25][AVX512_NUM_SHA3_LANES], 64);
+        const uint8_t *in[AVX512_NUM_SHA3_LANES];
+        uint64_t lens[AVX512_NUM_SHA3_LANES]; /* blocks left to absorb */
+        /* each nibble is index (0...7) of unused lanes */
+        uint64_t unused_lanes;
+        uint32_t num_lanes_inuse;
+        uint32_t block_size; /* sponge rate in bytes */
+        SHA3_LANE_DATA ldata[AVX512_NUM_SHA3_LANES];
+} MB_MGR_SHA3_OOO;
+
+/* BLAKE2b and BLAKE2s lane data */
+typedef struct {
+        /* key block and padded last block */
+        DECLARE_ALIGNED(uint8_t extra_block[2][BLAKE2B_BLOCK_SIZE], 8);
+        JOB_AES_HMAC *job_in_lane;
+        uint64_t t;     /* number of bytes compressed */
+        uint64_t inc;   /* counter increment of the current blocks */
+        uint64_t f;     /* last block flag of the current blocks */
+        uint32_t phase; /* key block, message blocks or last block */
+} BLAKE2_LANE_DATA;
+
+/* BLAKE2 out-of-order scheduler lanes */
+typedef struct {
+        const uint8_t *in[AVX512_NUM_BLAKE2S_LANES];
+        uint64_t lens[AVX512_NUM_BLAKE2S_LANES]; /* blocks left */
+        /* each nibble is index (0...15) of unused lanes */
+        uint64_t unused_lanes;
+        uint32_t num_lanes_inuse;
+        BLAKE2_LANE_DATA ldata[AVX512_NUM_BLAKE2S_LANES];
+} BLAKE2_OOO_LANES;
+
+typedef struct {
+        /* chaining value words, lane index is the column */
+        DECLARE_ALIGNED(uint64_t h[8][AVX512_NUM_BLAKE2B_LANES], 64);
+        BLAKE2_OOO_LANES lanes;
+} MB_MGR_BLAKE2B_OOO;
+
+typedef struct {
+        DECLARE_ALIGNED(uint32_t h[8][AVX512_NUM_BLAKE2S_LANES], 64);
+        BLAKE2_OOO_LANES lanes;
+} MB_MGR_BLAKE2S_OOO;
+
+/*
+ * AES-GCM-SIV out-of-order scheduler fields.
+ * Jobs are collected until all lanes are busy (or flush) and then
+ * processed together, interleaving the AES blocks of all lanes.
+ */
+typedef struct {
+        JOB_AES_HMAC *job_in_lane[AVX512_NUM_GCM_SIV_LANES];
+        uint32_t num_lanes_inuse;
+} MB_MGR_AES_GCM_SIV_OOO;
+
 
 /* HMAC-SHA1 and HMAC-SHA256/224 */
 typedef struct {
@@ -615,6 +910,15 @@ __attribute__((aligned(64)));
 ;
 #endif
 
+/**
+ * @brief SM4-GCM key data, see sm4_gcm_pre()
+ */
+struct sm4_gcm_key_data {
+        uint32_t rk[SM4_KEY_SCHED_SIZE / 4]; /* encryption round keys */
+        /* HashKey^4, HashKey^3, HashKey^2 and HashKey, byte reflected */
+        DECLARE_ALIGNED(uint8_t hkey[4][GCM_BLOCK_LEN], 16);
+};
+
 /* ========================================================================== */
 /* API data type definitions */
 struct MB_MGR;
@@ -629,6 +933,9 @@ typedef void (*keyexp_t)(const void *, void *, void *);
 typedef void (*cmac_subkey_gen_t)(const void *, void *, void *);
 typedef void (*hash_one_block_t)(const void *, void *);
 typedef void (*hash_fn_t)(const void *, const uint64_t, void *);
+typedef int (*hmac_ipad_opad_mb_t)(const JOB_HASH_ALG, const void *const *,
+                                   const uint64_t *, void *const *,
+                                   void *const *, const uint32_t);
 typedef void (*xcbc_keyexp_t)(const void *, void *, void *, void *);
 typedef int (*des_keysched_t)(uint64_t *, const void *);
 typedef void (*aes128_cfb_t)(void *, const void *, const void *, const void *,
@@ -649,6 +956,9 @@ typedef void (*aes_gcm_enc_dec_finalize_t)(const struct gcm_key_data *,
                                            uint8_t *, uint64_t);
 typedef void (*aes_gcm_precomp_t)(struct gcm_key_data *);
 typedef void (*aes_gcm_pre_t)(const void *, struct gcm_key_data *);
+typedef void (*aes_gcm_pre_mb_t)(const void *const *,
+                                 struct gcm_key_data *const *,
+                                 const uint32_t);
 
 /* ========================================================================== */
 /* Multi-buffer manager flags passed to alloc_mb_mgr() */
@@ -755,6 +1065,14 @@ typedef struct MB_MGR {
         aes_gcm_pre_t           gcm128_pre;
         aes_gcm_pre_t           gcm192_pre;
         aes_gcm_pre_t           gcm256_pre;
+        hash_one_block_t        sha512_224_one_block;
+        hash_one_block_t        sha512_256_one_block;
+        hash_fn_t               sha512_224;
+        hash_fn_t               sha512_256;
+        hmac_ipad_opad_mb_t     hmac_ipad_opad_mb;
+        aes_gcm_pre_mb_t        gcm128_pre_mb;
+        aes_gcm_pre_mb_t        gcm192_pre_mb;
+        aes_gcm_pre_mb_t        gcm256_pre_mb;
 
         /* in-order scheduler fields */
         int              earliest_job; /* byte offset, -1 if none */
@@ -789,6 +1107,36 @@ typedef struct MB_MGR {
         DECLARE_ALIGNED(MB_MGR_GCM_OOO gcm128_dec_ooo, 64);
         DECLARE_ALIGNED(MB_MGR_GCM_OOO gcm192_dec_ooo, 64);
         DECLARE_ALIGNED(MB_MGR_GCM_OOO gcm256_dec_ooo, 64);
+
+        DECLARE_ALIGNED(MB_MGR_ZUC_OOO zuc_eea3_ooo, 64);
+        DECLARE_ALIGNED(MB_MGR_SNOW3G_OOO snow3g_uea2_ooo, 64);
+        DECLARE_ALIGNED(MB_MGR_KASUMI_OOO kasumi_uea1_ooo, 64);
+
+        /* SHA3-256 shares the rate with SHAKE256 and HMAC-SHA3-256 etc. */
+        DECLARE_ALIGNED(MB_MGR_SHA3_OOO sha3_256_ooo, 64);
+        DECLARE_ALIGNED(MB_MGR_SHA3_OOO sha3_384_ooo, 64);
+        DECLARE_ALIGNED(MB_MGR_SHA3_OOO sha3_512_ooo, 64);
+        DECLARE_ALIGNED(MB_MGR_SHA3_OOO shake128_ooo, 64);
+
+        /* plain and keyed BLAKE2 */
+        DECLARE_ALIGNED(MB_MGR_BLAKE2B_OOO blake2b_ooo, 64);
+        DECLARE_ALIGNED(MB_MGR_BLAKE2S_OOO blake2s_ooo, 64);
+
+        /* SM4-CBC encryption and HMAC-SM3 (plain SM3 too) */
+        DECLARE_ALIGNED(MB_MGR_AES_OOO sm4_cbc_enc_ooo, 64);
+        DECLARE_ALIGNED(MB_MGR_HMAC_SHA_256_OOO hmac_sm3_ooo, 64);
+
+        /* AES-GCM-SIV encryption and decryption */
+        DECLARE_ALIGNED(MB_MGR_AES_GCM_SIV_OOO aes_gcm_siv_ooo, 64);
+
+        /* AES-CFB encryption */
+        DECLARE_ALIGNED(MB_MGR_AES_OOO aes_cfb_128_ooo, 64);
+        DECLARE_ALIGNED(MB_MGR_AES_OOO aes_cfb_192_ooo, 64);
+        DECLARE_ALIGNED(MB_MGR_AES_OOO aes_cfb_256_ooo, 64);
+
+        /* HMAC-SHA512/256 and HMAC-SHA512/224 (SHA512 lanes) */
+        DECLARE_ALIGNED(MB_MGR_HMAC_SHA_512_OOO hmac_sha_512_256_ooo, 64);
+        DECLARE_ALIGNED(MB_MGR_HMAC_SHA_512_OOO hmac_sha_512_224_ooo, 64);
 } MB_MGR;
 
 /* ========================================================================== */
@@ -921,9 +1269,24 @@ IMB_DLL_EXPORT JOB_AES_HMAC *get_next_job_sse(MB_MGR *state);
         ((_mgr)->sha512_one_block((_data), (_digest)))
 #define IMB_SHA512(_mgr, _data, _length, _digest)       \
         ((_mgr)->sha512((_data), (_length), (_digest)))
+#define IMB_SHA512_224_ONE_BLOCK(_mgr, _data, _digest)  \
+        ((_mgr)->sha512_224_one_block((_data), (_digest)))
+#define IMB_SHA512_224(_mgr, _data, _length, _digest)   \
+        ((_mgr)->sha512_224((_data), (_length), (_digest)))
+#define IMB_SHA512_256_ONE_BLOCK(_mgr, _data, _digest)  \
+        ((_mgr)->sha512_256_one_block((_data), (_digest)))
+#define IMB_SHA512_256(_mgr, _data, _length, _digest)   \
+        ((_mgr)->sha512_256((_data), (_length), (_digest)))
 #define IMB_MD5_ONE_BLOCK(_mgr, _data, _digest)         \
         ((_mgr)->md5_one_block((_data), (_digest)))
 
+/* Multi-key HMAC ipad/opad precompute API */
+#define IMB_HMAC_IPAD_OPAD_MB(_mgr, _hash_alg, _keys, _key_lens,        \
+                              _ipad_hashes, _opad_hashes, _num_keys)    \
+        ((_mgr)->hmac_ipad_opad_mb((_hash_alg), (_keys), (_key_lens),   \
+                                   (_ipad_hashes), (_opad_hashes),      \
+                                   (_num_keys)))
+
 /* AES-CFB API */
 #define IMB_AES128_CFB_ONE(_mgr, _out, _in, _iv, _enc, _len)            \
         ((_mgr)->aes128_cfb_one((_out), (_in), (_iv), (_enc), (_len)))
@@ -1004,6 +1367,13 @@ IMB_DLL_EXPORT JOB_AES_HMAC *get_next_job_sse(MB_MGR *state);
 #define IMB_AES256_GCM_PRE(_mgr, _key_in, _key_exp)     \
         ((_mgr)->gcm256_pre((_key_in), (_key_exp)))
 
+#define IMB_AES128_GCM_PRE_MB(_mgr, _keys, _key_data, _num_keys)        \
+        ((_mgr)->gcm128_pre_mb((_keys), (_key_data), (_num_keys)))
+#define IMB_AES192_GCM_PRE_MB(_mgr, _keys, _key_data, _num_keys)        \
+        ((_mgr)->gcm192_pre_mb((_keys), (_key_data), (_num_keys)))
+#define IMB_AES256_GCM_PRE_MB(_mgr, _keys, _key_data, _num_keys)        \
+        ((_mgr)->gcm256_pre_mb((_keys), (_key_data), (_num_keys)))
+
 /* Auxiliary functions */
 
 /**
@@ -1021,6 +1391,83 @@ IMB_DLL_EXPORT JOB_AES_HMAC *get_next_job_sse(MB_MGR *state);
 IMB_DLL_EXPORT int
 des_key_schedule(uint64_t *ks, const void *key);
 
+/**
+ * @brief DES key schedule set up for multiple keys
+ *
+ * Keys are bit sliced and scheduled 16 at a time.
+ * Each of \a ks buffers needs to accomodate \a DES_KEY_SCHED_SIZE (128)
+ * bytes of data.
+ *
+ * @param ks array of \a num_keys destination buffers for DES key schedules
+ * @param keys array of \a num_keys pointers to 8 byte DES keys
+ * @param num_keys number of keys to schedule
+ *
+ * @return Operation status
+ * @retval 0 success
+ * @retval !0 error
+ */
+IMB_DLL_EXPORT int
+des_key_schedule_mb(uint64_t *const *ks, const void *const *keys,
+                    const uint32_t num_keys);
+
+/**
+ * @brief Keccak state for HMAC-SHA3 IPAD / OPAD usage
+ *
+ * Absorbs one block of data into the zero state and stores the resulting
+ * SHA3_STATE_SIZE (200) byte Keccak-f[1600] state.
+ *
+ * @param data pointer to SHA3_256_BLOCK_SIZE (136) bytes of data
+ * @param state pointer to SHA3_STATE_SIZE bytes of output state
+ */
+IMB_DLL_EXPORT void sha3_256_one_block(const void *data, void *state);
+/* as above, with SHA3_384_BLOCK_SIZE (104) bytes of data */
+IMB_DLL_EXPORT void sha3_384_one_block(const void *data, void *state);
+/* as above, with SHA3_512_BLOCK_SIZE (72) bytes of data */
+IMB_DLL_EXPORT void sha3_512_one_block(const void *data, void *state);
+
+/*
+ * SHA3 API for use in HMAC-SHA3 when key is longer than the block size
+ */
+IMB_DLL_EXPORT void sha3_256(const void *data, const uint64_t length,
+                             void *digest);
+IMB_DLL_EXPORT void sha3_384(const void *data, const uint64_t length,
+                             void *digest);
+IMB_DLL_EXPORT void sha3_512(const void *data, const uint64_t length,
+                             void *digest);
+
+/**
+ * @brief SM4 key schedule set up
+ *
+ * Both buffers need to accommodate SM4_KEY_SCHED_SIZE (128) bytes.
+ * Decryption round keys are the encryption ones in reverse order.
+ *
+ * @param key pointer to a SM4_KEY_SIZE (16) byte key
+ * @param enc_exp_keys encryption round keys (SM4_CBC, SM4_CNTR)
+ * @param dec_exp_keys decryption round keys (SM4_CBC)
+ */
+IMB_DLL_EXPORT void sm4_keyexp(const void *key, void *enc_exp_keys,
+                               void *dec_exp_keys);
+
+/**
+ * @brief SM4-GCM key data set up
+ *
+ * The same key data is used for encryption and decryption
+ * (aes_enc_key_expanded / aes_dec_key_expanded fields of the job).
+ *
+ * @param key pointer to a SM4_KEY_SIZE (16) byte key
+ * @param key_data pointer to key data structure to be set up
+ */
+IMB_DLL_EXPORT void sm4_gcm_pre(const void *key,
+                                struct sm4_gcm_key_data *key_data);
+
+/*
+ * SM3 one block and SM3 API for HMAC-SM3 IPAD / OPAD computation.
+ * One block digest is stored as 8 32-bit words, as for SHA-256.
+ */
+IMB_DLL_EXPORT void sm3_one_block(const void *data, void *digest);
+IMB_DLL_EXPORT void sm3(const void *data, const uint64_t length,
+                        void *digest);
+
 /* SSE */
 IMB_DLL_EXPORT void sha1_sse(const void *data, const uint64_t length,
                              void *digest);
@@ -1037,7 +1484,21 @@ IMB_DLL_EXPORT void sha384_one_block_sse(const void *data, void *digest);
 IMB_DLL_EXPORT void sha512_sse(const void *data, const uint64_t length,
                                void *digest);
 IMB_DLL_EXPORT void sha512_one_block_sse(const void *data, void *digest);
+IMB_DLL_EXPORT void sha512_256_sse(const void *data, const uint64_t length,
+                                   void *digest);
+IMB_DLL_EXPORT void sha512_256_one_block_sse(const void *data,
+                                             void *digest);
+IMB_DLL_EXPORT void sha512_224_sse(const void *data, const uint64_t length,
+                                   void *digest);
+IMB_DLL_EXPORT void sha512_224_one_block_sse(const void *data,
+                                             void *digest);
 IMB_DLL_EXPORT void md5_one_block_sse(const void *data, void *digest);
+IMB_DLL_EXPORT int hmac_ipad_opad_mb_sse(const JOB_HASH_ALG hash_alg,
+                                         const void *const *keys,
+                                         const uint64_t *key_lens,
+                                         void *const *ipad_hashes,
+                                         void *const *opad_hashes,
+                                         const uint32_t num_keys);
 IMB_DLL_EXPORT void aes_keyexp_128_sse(const void *key, void *enc_exp_keys,
                                        void *dec_exp_keys);
 IMB_DLL_EXPORT void aes_keyexp_192_sse(const void *key, void *enc_exp_keys,
@@ -1052,6 +1513,18 @@ IMB_DLL_EXPORT void aes_keyexp_192_enc_sse(const void *key,
                                            void *enc_exp_keys);
 IMB_DLL_EXPORT void aes_keyexp_256_enc_sse(const void *key,
                                            void *enc_exp_keys);
+IMB_DLL_EXPORT void aes_keyexp_128_mb_sse(const void *const *keys,
+                                          void *const *enc_exp_keys,
+                                          void *const *dec_exp_keys,
+                                          const uint32_t num_keys);
+IMB_DLL_EXPORT void aes_keyexp_192_mb_sse(const void *const *keys,
+                                          void *const *enc_exp_keys,
+                                          void *const *dec_exp_keys,
+                                          const uint32_t num_keys);
+IMB_DLL_EXPORT void aes_keyexp_256_mb_sse(const void *const *keys,
+                                          void *const *enc_exp_keys,
+                                          void *const *dec_exp_keys,
+                                          const uint32_t num_keys);
 IMB_DLL_EXPORT void aes_cmac_subkey_gen_sse(const void *key_exp, void *key1,
                                             void *key2);
 IMB_DLL_EXPORT void aes_cfb_128_one_sse(void *out, const void *in,
@@ -1074,7 +1547,21 @@ IMB_DLL_EXPORT void sha384_one_block_avx(const void *data, void *digest);
 IMB_DLL_EXPORT void sha512_avx(const void *data, const uint64_t length,
                                void *digest);
 IMB_DLL_EXPORT void sha512_one_block_avx(const void *data, void *digest);
+IMB_DLL_EXPORT void sha512_256_avx(const void *data, const uint64_t length,
+                                   void *digest);
+IMB_DLL_EXPORT void sha512_256_one_block_avx(const void *data,
+                                             void *digest);
+IMB_DLL_EXPORT void sha512_224_avx(const void *data, const uint64_t length,
+                                   void *digest);
+IMB_DLL_EXPORT void sha512_224_one_block_avx(const void *data,
+                                             void *digest);
 IMB_DLL_EXPORT void md5_one_block_avx(const void *data, void *digest);
+IMB_DLL_EXPORT int hmac_ipad_opad_mb_avx(const JOB_HASH_ALG hash_alg,
+                                         const void *const *keys,
+                                         const uint64_t *key_lens,
+                                         void *const *ipad_hashes,
+                                         void *const *opad_hashes,
+                                         const uint32_t num_keys);
 IMB_DLL_EXPORT void aes_keyexp_128_avx(const void *key, void *enc_exp_keys,
                                        void *dec_exp_keys);
 IMB_DLL_EXPORT void aes_keyexp_192_avx(const void *key, void *enc_exp_keys,
@@ -1089,6 +1576,18 @@ IMB_DLL_EXPORT void aes_keyexp_192_enc_avx(const void *key,
                                            void *enc_exp_keys);
 IMB_DLL_EXPORT void aes_keyexp_256_enc_avx(const void *key,
                                            void *enc_exp_keys);
+IMB_DLL_EXPORT void aes_keyexp_128_mb_avx(const void *const *keys,
+                                          void *const *enc_exp_keys,
+                                          void *const *dec_exp_keys,
+                                          const uint32_t num_keys);
+IMB_DLL_EXPORT void aes_keyexp_192_mb_avx(const void *const *keys,
+                                          void *const *enc_exp_keys,
+                                          void *const *dec_exp_keys,
+                                          const uint32_t num_keys);
+IMB_DLL_EXPORT void aes_keyexp_256_mb_avx(const void *const *keys,
+                                          void *const *enc_exp_keys,
+                                          void *const *dec_exp_keys,
+                                          const uint32_t num_keys);
 IMB_DLL_EXPORT void aes_cmac_subkey_gen_avx(const void *key_exp, void *key1,
                                             void *key2);
 IMB_DLL_EXPORT void aes_cfb_128_one_avx(void *out, const void *in,
@@ -1111,7 +1610,21 @@ IMB_DLL_EXPORT void sha384_one_block_avx2(const void *data, void *digest);
 IMB_DLL_EXPORT void sha512_avx2(const void *data, const uint64_t length,
                                 void *digest);
 IMB_DLL_EXPORT void sha512_one_block_avx2(const void *data, void *digest);
+IMB_DLL_EXPORT void sha512_256_avx2(const void *data, const uint64_t length,
+                                    void *digest);
+IMB_DLL_EXPORT void sha512_256_one_block_avx2(const void *data,
+                                              void *digest);
+IMB_DLL_EXPORT void sha512_224_avx2(const void *data, const uint64_t length,
+                                    void *digest);
+IMB_DLL_EXPORT void sha512_224_one_block_avx2(const void *data,
+                                              void *digest);
 IMB_DLL_EXPORT void md5_one_block_avx2(const void *data, void *digest);
+IMB_DLL_EXPORT int hmac_ipad_opad_mb_avx2(const JOB_HASH_ALG hash_alg,
+                                          const void *const *keys,
+                                          const uint64_t *key_lens,
+                                          void *const *ipad_hashes,
+                                          void *const *opad_hashes,
+                                          const uint32_t num_keys);
 IMB_DLL_EXPORT void aes_keyexp_128_avx2(const void *key, void *enc_exp_keys,
                                         void *dec_exp_keys);
 IMB_DLL_EXPORT void aes_keyexp_192_avx2(const void *key, void *enc_exp_keys,
@@ -1126,6 +1639,18 @@ IMB_DLL_EXPORT void aes_keyexp_192_enc_avx2(const void *key,
                                             void *enc_exp_keys);
 IMB_DLL_EXPORT void aes_keyexp_256_enc_avx2(const void *key,
                                             void *enc_exp_keys);
+IMB_DLL_EXPORT void aes_keyexp_128_mb_avx2(const void *const *keys,
+                                           void *const *enc_exp_keys,
+                                           void *const *dec_exp_keys,
+                                           const uint32_t num_keys);
+IMB_DLL_EXPORT void aes_keyexp_192_mb_avx2(const void *const *keys,
+                                           void *const *enc_exp_keys,
+                                           void *const *dec_exp_keys,
+                                           const uint32_t num_keys);
+IMB_DLL_EXPORT void aes_keyexp_256_mb_avx2(const void *const *keys,
+                                           void *const *enc_exp_keys,
+                                           void *const *dec_exp_keys,
+                                           const uint32_t num_keys);
 IMB_DLL_EXPORT void aes_cmac_subkey_gen_avx2(const void *key_exp, void *key1,
                                              void *key2);
 IMB_DLL_EXPORT void aes_cfb_128_one_avx2(void *out, const void *in,
@@ -1148,7 +1673,21 @@ IMB_DLL_EXPORT void sha384_one_block_avx512(const void *data, void *digest);
 IMB_DLL_EXPORT void sha512_avx512(const void *data, const uint64_t length,
                                   void *digest);
 IMB_DLL_EXPORT void sha512_one_block_avx512(const void *data, void *digest);
+IMB_DLL_EXPORT void sha512_256_avx512(const void *data, const uint64_t length,
+                                      void *digest);
+IMB_DLL_EXPORT void sha512_256_one_block_avx512(const void *data,
+                                                void *digest);
+IMB_DLL_EXPORT void sha512_224_avx512(const void *data, const uint64_t length,
+                                      void *digest);
+IMB_DLL_EXPORT void sha512_224_one_block_avx512(const void *data,
+                                                void *digest);
 IMB_DLL_EXPORT void md5_one_block_avx512(const void *data, void *digest);
+IMB_DLL_EXPORT int hmac_ipad_opad_mb_avx512(const JOB_HASH_ALG hash_alg,
+                                            const void *const *keys,
+                                            const uint64_t *key_lens,
+                                            void *const *ipad_hashes,
+                                            void *const *opad_hashes,
+                                            const uint32_t num_keys);
 IMB_DLL_EXPORT void aes_keyexp_128_avx512(const void *key, void *enc_exp_keys,
                                           void *dec_exp_keys);
 IMB_DLL_EXPORT void aes_keyexp_192_avx512(const void *key, void *enc_exp_keys,
@@ -1163,6 +1702,18 @@ IMB_DLL_EXPORT void aes_keyexp_192_enc_avx512(const void *key,
                                               void *enc_exp_keys);
 IMB_DLL_EXPORT void aes_keyexp_256_enc_avx512(const void *key,
                                               void *enc_exp_keys);
+IMB_DLL_EXPORT void aes_keyexp_128_mb_avx512(const void *const *keys,
+                                             void *const *enc_exp_keys,
+                                             void *const *dec_exp_keys,
+                                             const uint32_t num_keys);
+IMB_DLL_EXPORT void aes_keyexp_192_mb_avx512(const void *const *keys,
+                                             void *const *enc_exp_keys,
+                                             void *const *dec_exp_keys,
+                                             const uint32_t num_keys);
+IMB_DLL_EXPORT void aes_keyexp_256_mb_avx512(const void *const *keys,
+                                             void *const *enc_exp_keys,
+                                             void *const *dec_exp_keys,
+                                             const uint32_t num_keys);
 IMB_DLL_EXPORT void aes_cmac_subkey_gen_avx512(const void *key_exp, void *key1,
                                                void *key2);
 IMB_DLL_EXPORT void aes_cfb_128_one_avx512(void *out, const void *in,
@@ -1633,6 +2184,65 @@ IMB_DLL_EXPORT void aes_gcm_pre_256_avx_gen2(const void *key,
                                              struct gcm_key_data *key_data);
 IMB_DLL_EXPORT void aes_gcm_pre_256_avx_gen4(const void *key,
                                              struct gcm_key_data *key_data);
+
+/**
+ * @brief Pre-processes GCM key data of multiple keys
+ *
+ * Same as aes_gcm_pre_128_sse() etc. for an array of keys, with the work
+ * on several keys interleaved.
+ *
+ * @param keys array of pointers to keys
+ * @param key_data array of pointers to GCM expanded key data
+ * @param num_keys number of keys
+ */
+IMB_DLL_EXPORT void
+aes_gcm_pre_128_mb_sse(const void *const *keys,
+                       struct gcm_key_data *const *key_data,
+                       const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_128_mb_avx_gen2(const void *const *keys,
+                            struct gcm_key_data *const *key_data,
+                            const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_128_mb_avx_gen4(const void *const *keys,
+                            struct gcm_key_data *const *key_data,
+                            const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_128_mb_avx512(const void *const *keys,
+                          struct gcm_key_data *const *key_data,
+                          const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_192_mb_sse(const void *const *keys,
+                       struct gcm_key_data *const *key_data,
+                       const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_192_mb_avx_gen2(const void *const *keys,
+                            struct gcm_key_data *const *key_data,
+                            const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_192_mb_avx_gen4(const void *const *keys,
+                            struct gcm_key_data *const *key_data,
+                            const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_192_mb_avx512(const void *const *keys,
+                          struct gcm_key_data *const *key_data,
+                          const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_256_mb_sse(const void *const *keys,
+                       struct gcm_key_data *const *key_data,
+                       const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_256_mb_avx_gen2(const void *const *keys,
+                            struct gcm_key_data *const *key_data,
+                            const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_256_mb_avx_gen4(const void *const *keys,
+                            struct gcm_key_data *const *key_data,
+                            const uint32_t num_keys);
+IMB_DLL_EXPORT void
+aes_gcm_pre_256_mb_avx512(const void *const *keys,
+                          struct gcm_key_data *const *key_data,
+                          const uint32_t num_keys);
 #endif /* !NO_GCM */
 
 #ifdef __cplusplus
@@ -0,0 +1,351 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* KASUMI (3GPP UEA1 and UIA1) common code and look-up tables */
+
+#include <string.h>
+
+#include "intel-ipsec-mb.h"
+#include "kasumi.h"
+
+/* S7 and S9 S-boxes (3GPP TS 35.202) */
+IMB_DLL_LOCAL const uint32_t kasumi_s7_tab[128] = {
+         54,  50,  62,  56,  22,  34,  94,  96,  38,   6,
+         63,  93,   2,  18, 123,  33,  55, 113,  39, 114,
+         21,  67,  65,  12,  47,  73,  46,  27,  25, 111,
+        124,  81,  53,   9, 121,  79,  52,  60,  58,  48,
+        101, 127,  40, 120, 104,  70,  71,  43,  20, 122,
+         72,  61,  23, 109,  13, 100,  77,   1,  16,   7,
+         82,  10, 105,  98, 117, 116,  76,  11,  89, 106,
+          0, 125, 118,  99,  86,  69,  30,  57, 126,  87,
+        112,  51,  17,   5,  95,  14,  90,  84,  91,   8,
+         35, 103,  32,  97,  28,  66, 102,  31,  26,  45,
+         75,   4,  85,  92,  37,  74,  80,  49,  68,  29,
+        115,  44,  64, 107, 108,  24, 110,  83,  36,  78,
+         42,  19,  15,  41,  88, 119,  59,   3
+};
+
+IMB_DLL_LOCAL const uint32_t kasumi_s9_tab[512] = {
+        167, 239, 161, 379, 391, 334,   9, 338,  38, 226,
+         48, 358, 452, 385,  90, 397, 183, 253, 147, 331,
+        415, 340,  51, 362, 306, 500, 262,  82, 216, 159,
+        356, 177, 175, 241, 489,  37, 206,  17,   0, 333,
+         44, 254, 378,  58, 143, 220,  81, 400,  95,   3,
+        315, 245,  54, 235, 218, 405, 472, 264, 172, 494,
+        371, 290, 399,  76, 165, 197, 395, 121, 257, 480,
+        423, 212, 240,  28, 462, 176, 406, 507, 288, 223,
+        501, 407, 249, 265,  89, 186, 221, 428, 164,  74,
+        440, 196, 458, 421, 350, 163, 232, 158, 134, 354,
+         13, 250, 491, 142, 191,  69, 193, 425, 152, 227,
+        366, 135, 344, 300, 276, 242, 437, 320, 113, 278,
+         11, 243,  87, 317,  36,  93, 496,  27, 487, 446,
+        482,  41,  68, 156, 457, 131, 326, 403, 339,  20,
+         39, 115, 442, 124, 475, 384, 508,  53, 112, 170,
+        479, 151, 126, 169,  73, 268, 279, 321, 168, 364,
+        363, 292,  46, 499, 393, 327, 324,  24, 456, 267,
+        157, 460, 488, 426, 309, 229, 439, 506, 208, 271,
+        349, 401, 434, 236,  16, 209, 359,  52,  56, 120,
+        199, 277, 465, 416, 252, 287, 246,   6,  83, 305,
+        420, 345, 153, 502,  65,  61, 244, 282, 173, 222,
+        418,  67, 386, 368, 261, 101, 476, 291, 195, 430,
+         49,  79, 166, 330, 280, 383, 373, 128, 382, 408,
+        155, 495, 367, 388, 274, 107, 459, 417,  62, 454,
+        132, 225, 203, 316, 234,  14, 301,  91, 503, 286,
+        424, 211, 347, 307, 140, 374,  35, 103, 125, 427,
+         19, 214, 453, 146, 498, 314, 444, 230, 256, 329,
+        198, 285,  50, 116,  78, 410,  10, 205, 510, 171,
+        231,  45, 139, 467,  29,  86, 505,  32,  72,  26,
+        342, 150, 313, 490, 431, 238, 411, 325, 149, 473,
+         40, 119, 174, 355, 185, 233, 389,  71, 448, 273,
+        372,  55, 110, 178, 322,  12, 469, 392, 369, 190,
+          1, 109, 375, 137, 181,  88,  75, 308, 260, 484,
+         98, 272, 370, 275, 412, 111, 336, 318,   4, 504,
+        492, 259, 304,  77, 337, 435,  21, 357, 303, 332,
+        483,  18,  47,  85,  25, 497, 474, 289, 100, 269,
+        296, 478, 270, 106,  31, 104, 433,  84, 414, 486,
+        394,  96,  99, 154, 511, 148, 413, 361, 409, 255,
+        162, 215, 302, 201, 266, 351, 343, 144, 441, 365,
+        108, 298, 251,  34, 182, 509, 138, 210, 335, 133,
+        311, 352, 328, 141, 396, 346, 123, 319, 450, 281,
+        429, 228, 443, 481,  92, 404, 485, 422, 248, 297,
+         23, 213, 130, 466,  22, 217, 283,  70, 294, 360,
+        419, 127, 312, 377,   7, 468, 194,   2, 117, 295,
+        463, 258, 224, 447, 247, 187,  80, 398, 284, 353,
+        105, 390, 299, 471, 470, 184,  57, 200, 348,  63,
+        204, 188,  33, 451,  97,  30, 310, 219,  94, 160,
+        129, 493,  64, 179, 263, 102, 189, 207, 114, 402,
+        438, 477, 387, 122, 192,  42, 381,   5, 145, 118,
+        180, 449, 293, 323, 136, 380,  43,  66,  60, 455,
+        341, 445, 202, 432,   8, 237,  15, 376, 436, 464,
+         59, 461
+};
+
+/* key schedule constants */
+static const uint16_t kasumi_c[8] = {
+        0x0123, 0x4567, 0x89ab, 0xcdef, 0xfedc, 0xba98, 0x7654, 0x3210
+};
+
+/* key modifier of UEA1 register A and of the last UIA1 block */
+#define KASUMI_KM 0x55
+
+static uint32_t
+kasumi_rol16(const uint32_t x, const unsigned n)
+{
+        return ((x << n) | (x >> (16 - n))) & 0xffff;
+}
+
+/* sets up round subkeys KLi1, KLi2, KOi1-3 and KIi1-3 for rounds 1 to 8 */
+static void
+kasumi_key_sched(const uint8_t *key, uint32_t sk[KASUMI_NUM_SUBKEYS])
+{
+        uint32_t k[8], kp[8];
+        unsigned i;
+
+        for (i = 0; i < 8; i++) {
+                k[i] = (((uint32_t) key[2 * i]) << 8) | key[2 * i + 1];
+                kp[i] = k[i] ^ kasumi_c[i];
+        }
+
+        for (i = 0; i < 8; i++) {
+                uint32_t *rk = &sk[i * 8];
+
+                rk[0] = kasumi_rol16(k[i], 1);
+                rk[1] = kp[(i + 2) & 7];
+                rk[2] = kasumi_rol16(k[(i + 1) & 7], 5);
+                rk[3] = kasumi_rol16(k[(i + 5) & 7], 8);
+                rk[4] = kasumi_rol16(k[(i + 6) & 7], 13);
+                rk[5] = kp[(i + 4) & 7];
+                rk[6] = kp[(i + 3) & 7];
+                rk[7] = kp[(i + 7) & 7];
+        }
+
+        /* clear sensitive data */
+        memset(k, 0, sizeof(k));
+        memset(kp, 0, sizeof(kp));
+}
+
+static void
+kasumi_key_sched_modified(const uint8_t *key, uint32_t sk[KASUMI_NUM_SUBKEYS])
+{
+        uint8_t km[16];
+        unsigned i;
+
+        for (i = 0; i < sizeof(km); i++)
+                km[i] = key[i] ^ KASUMI_KM;
+        kasumi_key_sched(km, sk);
+
+        /* clear sensitive data */
+        memset(km, 0, sizeof(km));
+}
+
+static uint32_t
+kasumi_fi(const uint32_t x, const uint32_t ki)
+{
+        const uint32_t l0 = x >> 7;
+        const uint32_t r0 = x & 0x7f;
+        const uint32_t r1 = kasumi_s9_tab[l0] ^ r0;
+        const uint32_t l1 = kasumi_s7_tab[r0] ^ (r1 & 0x7f);
+        const uint32_t l2 = l1 ^ (ki >> 9);
+        const uint32_t r2 = r1 ^ (ki & 0x1ff);
+        const uint32_t r3 = kasumi_s9_tab[r2] ^ l2;
+        const uint32_t l3 = kasumi_s7_tab[l2] ^ (r3 & 0x7f);
+
+        return (l3 << 9) | r3;
+}
+
+static uint32_t
+kasumi_fo(const uint32_t x, const uint32_t *rk)
+{
+        uint32_t l = x >> 16;
+        uint32_t r = x & 0xffff;
+        unsigned j;
+
+        for (j = 0; j < 3; j++) {
+                const uint32_t t = kasumi_fi(l ^ rk[2 + j], rk[5 + j]) ^ r;
+
+                l = r;
+                r = t;
+        }
+
+        return (l << 16) | r;
+}
+
+static uint32_t
+kasumi_fl(const uint32_t x, const uint32_t *rk)
+{
+        uint32_t l = x >> 16;
+        uint32_t r = x & 0xffff;
+
+        r ^= kasumi_rol16(l & rk[0], 1);
+        l ^= kasumi_rol16(r | rk[1], 1);
+
+        return (l << 16) | r;
+}
+
+static uint64_t
+kasumi_block(const uint32_t sk[KASUMI_NUM_SUBKEYS], const uint64_t x)
+{
+        uint32_t l = (uint32_t) (x >> 32);
+        uint32_t r = (uint32_t) x;
+        unsigned i;
+
+        /* two rounds at a time, so that halves don't need swapping */
+        for (i = 0; i < 8; i += 2) {
+                const uint32_t *rk = &sk[i * 8];
+
+                r ^= kasumi_fo(kasumi_fl(l, rk), rk);
+                l ^= kasumi_fl(kasumi_fo(r, rk + 8), rk + 8);
+        }
+
+        return (((uint64_t) l) << 32) | r;
+}
+
+static uint64_t
+kasumi_load_be64(const uint8_t *p)
+{
+        uint64_t x = 0;
+        unsigned i;
+
+        for (i = 0; i < 8; i++)
+                x = (x << 8) | p[i];
+
+        return x;
+}
+
+void
+kasumi_ooo_load_lane(void *ooo, const unsigned lane,
+                     const uint8_t *key, const uint8_t *iv)
+{
+        MB_MGR_KASUMI_OOO *state = (MB_MGR_KASUMI_OOO *) ooo;
+        uint32_t sk[KASUMI_NUM_SUBKEYS];
+        uint64_t a;
+        unsigned i;
+
+        kasumi_key_sched_modified(key, sk);
+        a = kasumi_block(sk, kasumi_load_be64(iv));
+
+        kasumi_key_sched(key, sk);
+        for (i = 0; i < KASUMI_NUM_SUBKEYS; i++)
+                state->sk[i][lane] = sk[i];
+
+        state->a[0][lane] = (uint32_t) (a >> 32);
+        state->a[1][lane] = (uint32_t) a;
+        state->ksb[0][lane] = 0;
+        state->ksb[1][lane] = 0;
+        state->blkcnt[lane] = 0;
+
+        /* clear sensitive data */
+        memset(sk, 0, sizeof(sk));
+}
+
+void
+kasumi_f8_1_buffer_bit(const uint8_t *key, const uint8_t *iv,
+                       const uint8_t *in, uint8_t *out,
+                       const uint64_t len_bits, const uint64_t offset_bits)
+{
+        const uint64_t end_bits = offset_bits + len_bits;
+        const uint64_t num_bytes = (end_bits + 7) / 8;
+        const unsigned shift = (unsigned) (offset_bits & 7);
+        uint32_t sk[KASUMI_NUM_SUBKEYS];
+        uint64_t a, ksb = 0, i;
+        /* keystream bits aligned to the output, 8 bits ahead */
+        uint32_t window = 0;
+
+        kasumi_key_sched_modified(key, sk);
+        a = kasumi_block(sk, kasumi_load_be64(iv));
+        kasumi_key_sched(key, sk);
+
+        for (i = 0; i < num_bytes; i++) {
+                uint8_t mask = 0xff;
+                uint8_t ks;
+
+                if ((i & 7) == 0)
+                        ksb = kasumi_block(sk, a ^ (i / 8) ^ ksb);
+                window = (window << 8) | ((ksb >> (56 - (i & 7) * 8)) & 0xff);
+                ks = (uint8_t) (window >> shift);
+
+                if (i == 0)
+                        mask &= (uint8_t) (0xff >> shift);
+                if (i == (num_bytes - 1) && (end_bits & 7))
+                        mask &= (uint8_t) (0xff00 >> (end_bits & 7));
+
+                out[i] = ((in[i] ^ ks) & mask) | (out[i] & ~mask);
+        }
+
+        /* clear sensitive data */
+        memset(sk, 0, sizeof(sk));
+}
+
+void
+kasumi_f9_1_buffer(const uint8_t *key, const uint8_t *iv,
+                   const uint64_t direction, const void *msg,
+                   const uint64_t len_bits, uint8_t *mac)
+{
+        const uint8_t *p = (const uint8_t *) msg;
+        uint32_t sk[KASUMI_NUM_SUBKEYS];
+        uint64_t a, b, m, n = len_bits;
+        unsigned i;
+
+        kasumi_key_sched(key, sk);
+
+        /* the first block is COUNT || FRESH */
+        a = kasumi_block(sk, kasumi_load_be64(iv));
+        b = a;
+
+        for (; n >= 64; n -= 64, p += 8) {
+                a = kasumi_block(sk, a ^ kasumi_load_be64(p));
+                b ^= a;
+        }
+
+        /* the last message bits followed by DIRECTION, 1 and zero padding */
+        for (m = 0, i = 0; i < 8; i++)
+                m = (m << 8) | ((i < ((n + 7) / 8)) ? p[i] : 0);
+        if (n != 0)
+                m &= ~UINT64_C(0) << (64 - n);
+        m |= (direction & 1) << (63 - n);
+        if (n < 63)
+                m |= UINT64_C(1) << (62 - n);
+        a = kasumi_block(sk, a ^ m);
+        b ^= a;
+
+        if (n == 63) {
+                /* the 1 bit doesn't fit into the last message block */
+                a = kasumi_block(sk, a ^ (UINT64_C(1) << 63));
+                b ^= a;
+        }
+
+        kasumi_key_sched_modified(key, sk);
+        b = kasumi_block(sk, b);
+
+        mac[0] = (uint8_t) (b >> 56);
+        mac[1] = (uint8_t) (b >> 48);
+        mac[2] = (uint8_t) (b >> 40);
+        mac[3] = (uint8_t) (b >> 32);
+
+        /* clear sensitive data */
+        memset(sk, 0, sizeof(sk));
+}
@@ -148,6 +148,98 @@ SUBMIT_JOB_AES256_CNTR(JOB_AES_HMAC *job)
 /* AES-CCM */
 /* ========================================================================= */
 
+/*
+ * AES-CCM CBC-MAC processing stages (MB_MGR_CCM_OOO.init_done values)
+ *
+ * Each lane walks through the stages below. Stages with no data to
+ * authenticate are skipped. Lane initial blocks (64 bytes) hold:
+ * - block 0: B_0 (later converted into AES-CTR counter block)
+ * - block 1: AAD length encoding and first AAD bytes
+ * - block 2: zero padded trailing AAD bytes
+ * - block 3: zero padded trailing message bytes
+ */
+#define CCM_STAGE_B0_AAD_FIRST 0 /* B_0 and 1st AAD block (init_blocks) */
+#define CCM_STAGE_AAD_BLOCKS   1 /* full AAD blocks read from job AAD */
+#define CCM_STAGE_AAD_TAIL     2 /* partial AAD block (init_blocks) */
+#define CCM_STAGE_MSG_BLOCKS   3 /* full message blocks read from job */
+#define CCM_STAGE_MSG_TAIL     4 /* partial message block (init_blocks) */
+#define CCM_STAGE_DONE         5
+
+/* number of AAD bytes that fit into the first AAD block */
+#define CCM_AAD_FIRST_BLOCK_BYTES (AES_BLOCK_SIZE - 2)
+
+/**
+ * @brief Sets up the next AES-CCM CBC-MAC stage with data for a lane
+ *
+ * Lane is moved through the processing stages until one with some
+ * data to authenticate is found or all stages are completed.
+ *
+ * @param state AES-CCM out-of-order manager
+ * @param job job processed in the lane
+ * @param pb lane initial blocks
+ * @param lane lane index
+ */
+__forceinline
+void
+ccm_next_stage(MB_MGR_CCM_OOO *state, const JOB_AES_HMAC *job,
+               uint8_t *pb, const unsigned lane)
+{
+        const uint8_t *aad = (const uint8_t *) job->u.CCM.aad;
+        const uint64_t aadl = job->u.CCM.aad_len_in_bytes;
+        const uint64_t msgl = job->msg_len_to_hash_in_bytes;
+        const uint8_t *msg = (job->cipher_direction == ENCRYPT) ?
+                (job->src + job->hash_start_src_offset_in_bytes) : job->dst;
+        const uint64_t aad_rest = (aadl > CCM_AAD_FIRST_BLOCK_BYTES) ?
+                (aadl - CCM_AAD_FIRST_BLOCK_BYTES) : 0;
+
+        while (state->lens[lane] == 0 &&
+               state->init_done[lane] < CCM_STAGE_DONE) {
+                state->init_done[lane]++;
+
+                switch (state->init_done[lane]) {
+                case CCM_STAGE_AAD_BLOCKS:
+                        /* AAD blocks are read directly from the job */
+                        if (aad_rest & (~15)) {
+                                state->args.in[lane] =
+                                        &aad[CCM_AAD_FIRST_BLOCK_BYTES];
+                                state->lens[lane] =
+                                        (uint16_t) (aad_rest & (~15));
+                        }
+                        break;
+                case CCM_STAGE_AAD_TAIL:
+                        if (aad_rest & 15) {
+                                memset(&pb[2 * AES_BLOCK_SIZE], 0,
+                                       AES_BLOCK_SIZE);
+                                memcpy(&pb[2 * AES_BLOCK_SIZE],
+                                       &aad[aadl - (aad_rest & 15)],
+                                       (size_t) (aad_rest & 15));
+                                state->args.in[lane] = &pb[2 * AES_BLOCK_SIZE];
+                                state->lens[lane] = AES_BLOCK_SIZE;
+                        }
+                        break;
+                case CCM_STAGE_MSG_BLOCKS:
+                        if (msgl & (~15)) {
+                                state->args.in[lane] = msg;
+                                state->lens[lane] = (uint16_t) (msgl & (~15));
+                        }
+                        break;
+                case CCM_STAGE_MSG_TAIL:
+                        if (msgl & 15) {
+                                memset(&pb[3 * AES_BLOCK_SIZE], 0,
+                                       AES_BLOCK_SIZE);
+                                memcpy(&pb[3 * AES_BLOCK_SIZE],
+                                       &msg[msgl & (~15)],
+                                       (size_t) (msgl & 15));
+                                state->args.in[lane] = &pb[3 * AES_BLOCK_SIZE];
+                                state->lens[lane] = AES_BLOCK_SIZE;
+                        }
+                        break;
+                default:
+                        break;
+                }
+        }
+}
+
 __forceinline
 JOB_AES_HMAC *
 submit_flush_job_aes_ccm(MB_MGR_CCM_OOO *state, JOB_AES_HMAC *job,
@@ -199,7 +291,7 @@ submit_flush_job_aes_ccm(MB_MGR_CCM_OOO *state, JOB_AES_HMAC *job,
                 /* copy job data in and set up inital blocks */
                 state->job_in_lane[lane] = job;
                 state->lens[lane] = AES_BLOCK_SIZE;
-                state->init_done[lane] = 0;
+                state->init_done[lane] = CCM_STAGE_B0_AAD_FIRST;
                 state->args.in[lane] = pb;
                 state->args.keys[lane] = job->aes_enc_key_expanded;
                 memset(&state->args.IV[lane], 0, sizeof(state->args.IV[0]));
@@ -213,32 +305,33 @@ submit_flush_job_aes_ccm(MB_MGR_CCM_OOO *state, JOB_AES_HMAC *job,
                 pb[14] = (uint8_t) (job->msg_len_to_hash_in_bytes >> 8);
                 pb[15] = (uint8_t) job->msg_len_to_hash_in_bytes;
 
-                /* Make AAD correction and put together AAD blocks, if any */
+                /* Make AAD correction and put together 1st AAD block */
                 if (job->u.CCM.aad_len_in_bytes != 0) {
                         /*
-                         * - increment length by length of AAD and
-                         *   AAD length size
+                         * - increment length by one AES block
                          * - add AAD present flag
-                         * - copy AAD to the lane initial blocks
+                         * - put AAD length and first AAD bytes into
+                         *   the lane initial blocks
                          * - zero trailing block bytes
+                         * Remaining AAD bytes are authenticated
+                         * in later stages, see ccm_next_stage().
                          */
                         const unsigned aadl =
-                                (unsigned) job->u.CCM.aad_len_in_bytes +
-                                aad_len_size;
+                                (job->u.CCM.aad_len_in_bytes >
+                                 CCM_AAD_FIRST_BLOCK_BYTES) ?
+                                CCM_AAD_FIRST_BLOCK_BYTES :
+                                (unsigned) job->u.CCM.aad_len_in_bytes;
 
-                        state->lens[lane] +=
-                                (aadl + AES_BLOCK_SIZE - 1) &
-                                (~(AES_BLOCK_SIZE - 1));
+                        state->lens[lane] += AES_BLOCK_SIZE;
                         pb[0] |= 0x40;
                         pb[AES_BLOCK_SIZE + 0] =
                                 (uint8_t) (job->u.CCM.aad_len_in_bytes >> 8);
                         pb[AES_BLOCK_SIZE + 1] =
                                 (uint8_t) job->u.CCM.aad_len_in_bytes;
                         memcpy(&pb[AES_BLOCK_SIZE + aad_len_size],
-                               job->u.CCM.aad,
-                               job->u.CCM.aad_len_in_bytes);
-                        memset(&pb[AES_BLOCK_SIZE + aadl], 0,
-                               state->lens[lane] - AES_BLOCK_SIZE - aadl);
+                               job->u.CCM.aad, aadl);
+                        memset(&pb[AES_BLOCK_SIZE + aad_len_size + aadl], 0,
+                               CCM_AAD_FIRST_BLOCK_BYTES - aadl);
                 }
 
                 /* enough jobs to start processing? */
@@ -310,41 +403,13 @@ submit_flush_job_aes_ccm(MB_MGR_CCM_OOO *state, JOB_AES_HMAC *job,
         ret_job = state->job_in_lane[min_idx];
         pb = &state->init_blocks[min_idx * lane_blocks_size];
 
-        if (state->init_done[min_idx] == 0) {
-                /*
-                 * First block and AAD blocks are done.
-                 * Full message blocks are to do.
-                 */
-                if (ret_job->cipher_direction == ENCRYPT)
-                        state->args.in[min_idx] = ret_job->src +
-                                ret_job->hash_start_src_offset_in_bytes;
-                else
-                        state->args.in[min_idx] = ret_job->dst;
-
-                state->init_done[min_idx] = 1;
-
-                if (ret_job->msg_len_to_hash_in_bytes & (~15)) {
-                        /* first block + AAD done - process message blocks */
-                        state->lens[min_idx] =
-                                ret_job->msg_len_to_hash_in_bytes & (~15);
-                        goto ccm_round;
-                }
-        }
-
-        if (state->init_done[min_idx] == 1 &&
-            (ret_job->msg_len_to_hash_in_bytes & 15)) {
-                /*
-                 * First block, AAD, message blocks are done.
-                 * Partial message block is still to do.
-                 */
-                state->init_done[min_idx] = 2;
-                state->lens[min_idx] = AES_BLOCK_SIZE;
-                memset(&pb[AES_BLOCK_SIZE], 0, AES_BLOCK_SIZE);
-                memcpy(&pb[AES_BLOCK_SIZE], state->args.in[min_idx],
-                       (size_t) ret_job->msg_len_to_hash_in_bytes & 15);
-                state->args.in[min_idx] = &pb[AES_BLOCK_SIZE];
+        /*
+         * Move the lane onto the next stage with data, if any
+         * (AAD blocks, AAD tail, message blocks, message tail).
+         */
+        ccm_next_stage(state, ret_job, pb, min_idx);
+        if (state->init_done[min_idx] != CCM_STAGE_DONE)
                 goto ccm_round;
-        }
 
         /*
          * Final XOR with AES-CNTR on B_0
@@ -542,6 +607,158 @@ DOCSIS_FIRST_BLOCK(JOB_AES_HMAC *job)
         return job;
 }
 
+/* Frame decryption step of DOCSIS_DEC_CRC32(), multiple of AES block */
+#define DOCSIS_CRC32_CHUNK 256
+
+/**
+ * @brief Updates DOCSIS CRC32 with a segment of the frame
+ *
+ * Only the part of the segment that falls into the hash range
+ * of the job is included.
+ *
+ * @param job desriptor of performed crypto operation
+ * @param fcs FCS of the preceding segments or 0
+ * @param data segment data
+ * @param start offset of the segment in the frame ( src)
+ * @param end offset of the segment end in the frame
+ * @return Updated FCS
+ */
+__forceinline
+uint32_t
+DOCSIS_CRC32_UPDATE(const JOB_AES_HMAC *job, uint32_t fcs,
+                    const uint8_t *data, uint64_t start, uint64_t end)
+{
+        const uint64_t hash_start = job->hash_start_src_offset_in_bytes;
+        const uint64_t hash_end = hash_start + job->msg_len_to_hash_in_bytes;
+        const uint64_t seg_start = start;
+
+        if (start < hash_start)
+                start = hash_start;
+        if (end > hash_end)
+                end = hash_end;
+        if (start < end)
+                fcs = ETHERNET_FCS(fcs, data + (start - seg_start),
+                                   end - start);
+        return fcs;
+}
+
+/**
+ * @brief Stores DOCSIS CRC32 in the job and marks hash as completed
+ */
+__forceinline
+JOB_AES_HMAC *
+DOCSIS_CRC32_STORE(JOB_AES_HMAC *job, const uint32_t fcs)
+{
+        /* FCS is transmitted least significant byte first */
+        job->auth_tag_output[0] = (uint8_t) fcs;
+        job->auth_tag_output[1] = (uint8_t) (fcs >> 8);
+        job->auth_tag_output[2] = (uint8_t) (fcs >> 16);
+        job->auth_tag_output[3] = (uint8_t) (fcs >> 24);
+
+        job->status |= STS_COMPLETED_HMAC;
+        return job;
+}
+
+/**
+ * @brief Computes DOCSIS CRC32 (Ethernet FCS) over clear frame
+ *        for DOCSIS SEC v3.1 BPI encryption
+ *
+ * CRC is computed over clear text from \a src before the frame gets
+ * ciphered (HASH_CIPHER chain order). In order to get CRC encrypted,
+ * \a auth_tag_output should point to the CRC field placed at the end
+ * of the cipher range.
+ *
+ * @note This is a separate pass over the frame: CBC part of the cipher
+ *       is done later by the multi-buffer manager. Decryption computes
+ *       CRC together with the cipher, see DOCSIS_DEC_CRC32().
+ *
+ * @param job desriptor of performed crypto operation
+ * @return It always returns value passed in \a job
+ */
+__forceinline
+JOB_AES_HMAC *
+DOCSIS_CRC32_HASH(JOB_AES_HMAC *job)
+{
+        const uint8_t *src = job->src + job->hash_start_src_offset_in_bytes;
+        const uint64_t len = job->msg_len_to_hash_in_bytes;
+
+        IMB_ASSERT(job->cipher_direction == ENCRYPT);
+        return DOCSIS_CRC32_STORE(job, ETHERNET_FCS(0, src, len));
+}
+
+/**
+ * @brief DOCSIS SEC v3.1 BPI decryption and CRC32 in a single pass
+ *
+ * Frame is deciphered in chunks of DOCSIS_CRC32_CHUNK bytes and CRC
+ * of each chunk is computed straight after it gets decrypted, while
+ * it is still in L1 cache. Part of hash range in front of or after
+ * the cipher range is read from \a src.
+ *
+ * @param job desriptor of performed crypto operation
+ * @return It always returns value passed in \a job
+ *         (both cipher and hash completed)
+ */
+__forceinline
+JOB_AES_HMAC *
+DOCSIS_DEC_CRC32(JOB_AES_HMAC *job)
+{
+        const uint64_t cipher_start = job->cipher_start_src_offset_in_bytes;
+        const uint64_t cipher_len = job->msg_len_to_cipher_in_bytes;
+        const uint64_t full_len = cipher_len & (~(AES_BLOCK_SIZE - 1));
+        const uint8_t *src = job->src + cipher_start;
+        DECLARE_ALIGNED(uint8_t iv[2][AES_BLOCK_SIZE], 16);
+        uint64_t offset;
+        uint32_t fcs;
+        int cur = 0;
+
+        IMB_ASSERT(job->cipher_direction == DECRYPT);
+
+        /* clear text in front of the cipher range */
+        fcs = DOCSIS_CRC32_UPDATE(job, 0, job->src, 0, cipher_start);
+
+        if (cipher_len < AES_BLOCK_SIZE) {
+                DOCSIS_FIRST_BLOCK(job);
+        } else {
+                /* needs last full cipher block, before it gets overwritten */
+                DOCSIS_LAST_BLOCK(job);
+
+                memcpy(iv[cur], job->iv, AES_BLOCK_SIZE);
+                for (offset = 0; offset < full_len;
+                     offset += DOCSIS_CRC32_CHUNK) {
+                        const uint64_t len =
+                                (full_len - offset < DOCSIS_CRC32_CHUNK) ?
+                                full_len - offset : DOCSIS_CRC32_CHUNK;
+
+                        /* IV of next chunk, \a dst may overlap \a src */
+                        memcpy(iv[cur ^ 1], src + offset + len -
+                               AES_BLOCK_SIZE, AES_BLOCK_SIZE);
+                        AES_CBC_DEC_128(src + offset, iv[cur],
+                                        job->aes_dec_key_expanded,
+                                        job->dst + offset, len);
+                        cur ^= 1;
+                        fcs = DOCSIS_CRC32_UPDATE(job, fcs, job->dst + offset,
+                                                  cipher_start + offset,
+                                                  cipher_start + offset +
+                                                  len);
+                }
+                job->status |= STS_COMPLETED_AES;
+        }
+
+        /* partial block (or first and only block) decrypted with CFB */
+        fcs = DOCSIS_CRC32_UPDATE(job, fcs, job->dst + full_len,
+                                  cipher_start + full_len,
+                                  cipher_start + cipher_len);
+
+        /* clear text after the cipher range */
+        fcs = DOCSIS_CRC32_UPDATE(job, fcs,
+                                  job->src + cipher_start + cipher_len,
+                                  cipher_start + cipher_len,
+                                  job->hash_start_src_offset_in_bytes +
+                                  job->msg_len_to_hash_in_bytes);
+
+        return DOCSIS_CRC32_STORE(job, fcs);
+}
+
 /* ========================================================================= */
 /* DES, 3DES and DOCSIS DES (DES CBC + DES CFB) */
 /* ========================================================================= */
@@ -731,6 +948,31 @@ SUBMIT_JOB_AES_ENC(MB_MGR *state, JOB_AES_HMAC *job)
 #else
                 return DES3_CBC_ENC(job);
 #endif
+        } else if (ZUC_EEA3 == job->cipher_mode) {
+                return SUBMIT_JOB_ZUC_EEA3(&state->zuc_eea3_ooo, job);
+        } else if (SNOW3G_UEA2_BITLEN == job->cipher_mode) {
+                return SUBMIT_JOB_SNOW3G_UEA2(&state->snow3g_uea2_ooo, job);
+        } else if (KASUMI_UEA1_BITLEN == job->cipher_mode) {
+                return SUBMIT_JOB_KASUMI_UEA1(&state->kasumi_uea1_ooo, job);
+        } else if (SM4_CBC == job->cipher_mode) {
+                return SUBMIT_JOB_SM4_CBC_ENC(&state->sm4_cbc_enc_ooo, job);
+        } else if (SM4_CNTR == job->cipher_mode) {
+                return SUBMIT_JOB_SM4_CNTR(job);
+        } else if (SM4_GCM == job->cipher_mode) {
+                return SUBMIT_JOB_SM4_GCM_ENC(job);
+        } else if (AES_GCM_SIV == job->cipher_mode) {
+                return SUBMIT_JOB_AES_GCM_SIV(&state->aes_gcm_siv_ooo, job);
+        } else if (CFB == job->cipher_mode) {
+                if (16 == job->aes_key_len_in_bytes) {
+                        return SUBMIT_JOB_AES_CFB_ENC(&state->aes_cfb_128_ooo,
+                                                      job);
+                } else if (24 == job->aes_key_len_in_bytes) {
+                        return SUBMIT_JOB_AES_CFB_ENC(&state->aes_cfb_192_ooo,
+                                                      job);
+                } else { /* assume 32 */
+                        return SUBMIT_JOB_AES_CFB_ENC(&state->aes_cfb_256_ooo,
+                                                      job);
+                }
         } else { /* assume CCM or NULL_CIPHER */
                 job->status |= STS_COMPLETED_AES;
                 return job;
@@ -770,6 +1012,24 @@ FLUSH_JOB_AES_ENC(MB_MGR *state, JOB_AES_HMAC *job)
         } else if (DOCSIS_DES == job->cipher_mode) {
                 return FLUSH_JOB_DOCSIS_DES_ENC(&state->docsis_des_enc_ooo);
 #endif /* FLUSH_JOB_DOCSIS_DES_ENC */
+        } else if (ZUC_EEA3 == job->cipher_mode) {
+                return FLUSH_JOB_ZUC_EEA3(&state->zuc_eea3_ooo);
+        } else if (SNOW3G_UEA2_BITLEN == job->cipher_mode) {
+                return FLUSH_JOB_SNOW3G_UEA2(&state->snow3g_uea2_ooo);
+        } else if (KASUMI_UEA1_BITLEN == job->cipher_mode) {
+                return FLUSH_JOB_KASUMI_UEA1(&state->kasumi_uea1_ooo);
+        } else if (SM4_CBC == job->cipher_mode) {
+                return FLUSH_JOB_SM4_CBC_ENC(&state->sm4_cbc_enc_ooo);
+        } else if (AES_GCM_SIV == job->cipher_mode) {
+                return FLUSH_JOB_AES_GCM_SIV(&state->aes_gcm_siv_ooo);
+        } else if (CFB == job->cipher_mode) {
+                if (16 == job->aes_key_len_in_bytes) {
+                        return FLUSH_JOB_AES_CFB_ENC(&state->aes_cfb_128_ooo);
+                } else if (24 == job->aes_key_len_in_bytes) {
+                        return FLUSH_JOB_AES_CFB_ENC(&state->aes_cfb_192_ooo);
+                } else { /* assume 32 */
+                        return FLUSH_JOB_AES_CFB_ENC(&state->aes_cfb_256_ooo);
+                }
         } else if (CUSTOM_CIPHER == job->cipher_mode) {
                 return FLUSH_JOB_CUSTOM_CIPHER(job);
         } else { /* assume CNTR, CCM or NULL_CIPHER */
@@ -798,7 +1058,9 @@ SUBMIT_JOB_AES_DEC(MB_MGR *state, JOB_AES_HMAC *job)
                         return SUBMIT_JOB_AES256_CNTR(job);
                 }
         } else if (DOCSIS_SEC_BPI == job->cipher_mode) {
-                if (job->msg_len_to_cipher_in_bytes >= AES_BLOCK_SIZE) {
+                if (DOCSIS_CRC32 == job->hash_alg) {
+                        return DOCSIS_DEC_CRC32(job);
+                } else if (job->msg_len_to_cipher_in_bytes >= AES_BLOCK_SIZE) {
                         DOCSIS_LAST_BLOCK(job);
                         return SUBMIT_JOB_AES128_DEC(job);
                 } else {
@@ -828,6 +1090,24 @@ SUBMIT_JOB_AES_DEC(MB_MGR *state, JOB_AES_HMAC *job)
 #else
                 return DES3_CBC_DEC(job);
 #endif
+        } else if (ZUC_EEA3 == job->cipher_mode) {
+                /* the same manager encrypts and decrypts */
+                return SUBMIT_JOB_ZUC_EEA3(&state->zuc_eea3_ooo, job);
+        } else if (SNOW3G_UEA2_BITLEN == job->cipher_mode) {
+                return SUBMIT_JOB_SNOW3G_UEA2(&state->snow3g_uea2_ooo, job);
+        } else if (KASUMI_UEA1_BITLEN == job->cipher_mode) {
+                return SUBMIT_JOB_KASUMI_UEA1(&state->kasumi_uea1_ooo, job);
+        } else if (SM4_CBC == job->cipher_mode) {
+                return SUBMIT_JOB_SM4_CBC_DEC(job);
+        } else if (SM4_CNTR == job->cipher_mode) {
+                return SUBMIT_JOB_SM4_CNTR(job);
+        } else if (SM4_GCM == job->cipher_mode) {
+                return SUBMIT_JOB_SM4_GCM_DEC(job);
+        } else if (AES_GCM_SIV == job->cipher_mode) {
+                /* the same manager encrypts and decrypts */
+                return SUBMIT_JOB_AES_GCM_SIV(&state->aes_gcm_siv_ooo, job);
+        } else if (CFB == job->cipher_mode) {
+                return SUBMIT_JOB_AES_CFB_DEC(job);
         } else if (CUSTOM_CIPHER == job->cipher_mode) {
                 return SUBMIT_JOB_CUSTOM_CIPHER(job);
         } else {
@@ -857,6 +1137,14 @@ FLUSH_JOB_AES_DEC(MB_MGR *state, JOB_AES_HMAC *job)
         if (DOCSIS_DES == job->cipher_mode)
                 return FLUSH_JOB_DOCSIS_DES_DEC(&state->docsis_des_dec_ooo);
 #endif /* FLUSH_JOB_DOCSIS_DES_DEC */
+        if (ZUC_EEA3 == job->cipher_mode)
+                return FLUSH_JOB_ZUC_EEA3(&state->zuc_eea3_ooo);
+        if (SNOW3G_UEA2_BITLEN == job->cipher_mode)
+                return FLUSH_JOB_SNOW3G_UEA2(&state->snow3g_uea2_ooo);
+        if (KASUMI_UEA1_BITLEN == job->cipher_mode)
+                return FLUSH_JOB_KASUMI_UEA1(&state->kasumi_uea1_ooo);
+        if (AES_GCM_SIV == job->cipher_mode)
+                return FLUSH_JOB_AES_GCM_SIV(&state->aes_gcm_siv_ooo);
         (void) state;
         return NULL;
 }
@@ -897,6 +1185,12 @@ SUBMIT_JOB_HASH(MB_MGR *state, JOB_AES_HMAC *job)
                 return SUBMIT_JOB_HMAC_SHA_384(&state->hmac_sha_384_ooo, job);
         case SHA_512:
                 return SUBMIT_JOB_HMAC_SHA_512(&state->hmac_sha_512_ooo, job);
+        case SHA_512_256:
+                return SUBMIT_JOB_HMAC_SHA_512_256
+                        (&state->hmac_sha_512_256_ooo, job);
+        case SHA_512_224:
+                return SUBMIT_JOB_HMAC_SHA_512_224
+                        (&state->hmac_sha_512_224_ooo, job);
         case AES_XCBC:
                 return SUBMIT_JOB_AES_XCBC(&state->aes_xcbc_ooo, job);
         case MD5:
@@ -937,6 +1231,66 @@ SUBMIT_JOB_HASH(MB_MGR *state, JOB_AES_HMAC *job)
                            job->msg_len_to_hash_in_bytes, job->auth_tag_output);
                 job->status |= STS_COMPLETED_HMAC;
                 return job;
+        case PLAIN_SHA_512_256:
+                SHA512_256(job->src + job->hash_start_src_offset_in_bytes,
+                           job->msg_len_to_hash_in_bytes, job->auth_tag_output);
+                job->status |= STS_COMPLETED_HMAC;
+                return job;
+        case PLAIN_SHA_512_224:
+                SHA512_224(job->src + job->hash_start_src_offset_in_bytes,
+                           job->msg_len_to_hash_in_bytes, job->auth_tag_output);
+                job->status |= STS_COMPLETED_HMAC;
+                return job;
+        case DOCSIS_CRC32:
+                return DOCSIS_CRC32_HASH(job);
+        case ZUC_EIA3_BITLEN:
+                zuc_eia3_1_buffer(job->u.ZUC_EIA3._key, job->u.ZUC_EIA3._iv,
+                                  job->src +
+                                  job->hash_start_src_offset_in_bytes,
+                                  job->msg_len_to_hash_in_bits,
+                                  job->auth_tag_output);
+                job->status |= STS_COMPLETED_HMAC;
+                return job;
+        case SNOW3G_UIA2_BITLEN:
+                SNOW3G_F9_1_BUFFER(job->u.SNOW3G_UIA2._key,
+                                   job->u.SNOW3G_UIA2._iv,
+                                   job->src +
+                                   job->hash_start_src_offset_in_bytes,
+                                   job->msg_len_to_hash_in_bits,
+                                   job->auth_tag_output);
+                job->status |= STS_COMPLETED_HMAC;
+                return job;
+        case KASUMI_UIA1_BITLEN:
+                kasumi_f9_1_buffer(job->u.KASUMI_UIA1._key,
+                                   job->u.KASUMI_UIA1._iv,
+                                   job->u.KASUMI_UIA1._direction,
+                                   job->src +
+                                   job->hash_start_src_offset_in_bytes,
+                                   job->msg_len_to_hash_in_bits,
+                                   job->auth_tag_output);
+                job->status |= STS_COMPLETED_HMAC;
+                return job;
+        case PLAIN_SHA3_256:
+        case PLAIN_SHAKE256:
+        case SHA3_256:
+                return SUBMIT_JOB_SHA3(&state->sha3_256_ooo, job);
+        case PLAIN_SHA3_384:
+        case SHA3_384:
+                return SUBMIT_JOB_SHA3(&state->sha3_384_ooo, job);
+        case PLAIN_SHA3_512:
+        case SHA3_512:
+                return SUBMIT_JOB_SHA3(&state->sha3_512_ooo, job);
+        case PLAIN_SHAKE128:
+                return SUBMIT_JOB_SHA3(&state->shake128_ooo, job);
+        case PLAIN_BLAKE2B:
+        case BLAKE2B_KEYED:
+                return SUBMIT_JOB_BLAKE2B(&state->blake2b_ooo, job);
+        case PLAIN_BLAKE2S:
+        case BLAKE2S_KEYED:
+                return SUBMIT_JOB_BLAKE2S(&state->blake2s_ooo, job);
+        case PLAIN_SM3:
+        case SM3:
+                return SUBMIT_JOB_SM3(&state->hmac_sm3_ooo, job);
         default: /* assume NULL_HASH */
                 job->status |= STS_COMPLETED_HMAC;
                 return job;
@@ -972,6 +1326,10 @@ FLUSH_JOB_HASH(MB_MGR *state, JOB_AES_HMAC *job)
                 return FLUSH_JOB_HMAC_SHA_384(&state->hmac_sha_384_ooo);
         case SHA_512:
                 return FLUSH_JOB_HMAC_SHA_512(&state->hmac_sha_512_ooo);
+        case SHA_512_256:
+                return FLUSH_JOB_HMAC_SHA_512_256(&state->hmac_sha_512_256_ooo);
+        case SHA_512_224:
+                return FLUSH_JOB_HMAC_SHA_512_224(&state->hmac_sha_512_224_ooo);
         case AES_XCBC:
                 return FLUSH_JOB_AES_XCBC(&state->aes_xcbc_ooo);
         case MD5:
@@ -982,6 +1340,27 @@ FLUSH_JOB_HASH(MB_MGR *state, JOB_AES_HMAC *job)
                 return FLUSH_JOB_AES_CCM_AUTH(&state->aes_ccm_ooo);
         case AES_CMAC:
                 return FLUSH_JOB_AES_CMAC_AUTH(&state->aes_cmac_ooo);
+        case PLAIN_SHA3_256:
+        case PLAIN_SHAKE256:
+        case SHA3_256:
+                return FLUSH_JOB_SHA3(&state->sha3_256_ooo);
+        case PLAIN_SHA3_384:
+        case SHA3_384:
+                return FLUSH_JOB_SHA3(&state->sha3_384_ooo);
+        case PLAIN_SHA3_512:
+        case SHA3_512:
+                return FLUSH_JOB_SHA3(&state->sha3_512_ooo);
+        case PLAIN_SHAKE128:
+                return FLUSH_JOB_SHA3(&state->shake128_ooo);
+        case PLAIN_BLAKE2B:
+        case BLAKE2B_KEYED:
+                return FLUSH_JOB_BLAKE2B(&state->blake2b_ooo);
+        case PLAIN_BLAKE2S:
+        case BLAKE2S_KEYED:
+                return FLUSH_JOB_BLAKE2S(&state->blake2s_ooo);
+        case PLAIN_SM3:
+        case SM3:
+                return FLUSH_JOB_SM3(&state->hmac_sm3_ooo);
         default: /* assume NULL_HASH */
                 if (!(job->status & STS_COMPLETED_HMAC)) {
                         job->status |= STS_COMPLETED_HMAC;
@@ -1050,6 +1429,30 @@ is_job_invalid(const JOB_AES_HMAC *job)
                 32, /* PLAIN_SHA_256 */
                 48, /* PLAIN_SHA_384 */
                 64, /* PLAIN_SHA_512 */
+                4,  /* DOCSIS_CRC32 */
+                4,  /* ZUC_EIA3_BITLEN */
+                4,  /* SNOW3G_UIA2_BITLEN */
+                4,  /* KASUMI_UIA1_BITLEN */
+                32, /* PLAIN_SHA3_256 */
+                48, /* PLAIN_SHA3_384 */
+                64, /* PLAIN_SHA3_512 */
+                0,  /* PLAIN_SHAKE128 */
+                0,  /* PLAIN_SHAKE256 */
+                16, /* SHA3_256 */
+                24, /* SHA3_384 */
+                32, /* SHA3_512 */
+                64, /* PLAIN_BLAKE2B */
+                32, /* PLAIN_BLAKE2S */
+                64, /* BLAKE2B_KEYED */
+                32, /* BLAKE2S_KEYED */
+                32, /* PLAIN_SM3 */
+                16, /* SM3 */
+                16, /* SM4_GMAC */
+                16, /* AES_GCM_SIV_TAG */
+                32, /* PLAIN_SHA_512_256 */
+                28, /* PLAIN_SHA_512_224 */
+                16, /* SHA_512_256 */
+                14, /* SHA_512_224 */
         };
 
         switch (job->cipher_mode) {
@@ -1399,155 +1802,701 @@ is_job_invalid(const JOB_AES_HMAC *job)
                         }
                 }
                 break;
-        default:
-                INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
-                return 1;
-        }
-
-        switch (job->hash_alg) {
-        case SHA1:
-        case AES_XCBC:
-        case MD5:
-        case SHA_224:
-        case SHA_256:
-        case SHA_384:
-        case SHA_512:
+        case ZUC_EEA3:
                 if (job->src == NULL) {
-                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                if (job->auth_tag_output_len_in_bytes !=
-                    auth_tag_len_ipsec[job->hash_alg] &&
-                    job->auth_tag_output_len_in_bytes !=
-                    auth_tag_len_fips[job->hash_alg]) {
-                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                if (job->dst == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                if (job->msg_len_to_hash_in_bytes == 0) {
-                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                if (job->iv == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                if (job->auth_tag_output == NULL) {
-                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                /* raw key, the same for encryption and decryption */
+                if (job->aes_enc_key_expanded == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->aes_key_len_in_bytes != ZUC_KEY_LEN_IN_BYTES) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->iv_len_in_bytes != ZUC_IV_LEN_IN_BYTES) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->msg_len_to_cipher_in_bytes < ZUC_MIN_BYTELEN ||
+                    job->msg_len_to_cipher_in_bytes > ZUC_MAX_BYTELEN) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
                 break;
-        case NULL_HASH:
-                break;
-#ifndef NO_GCM
-        case AES_GMAC:
+        case SNOW3G_UEA2_BITLEN:
                 if (job->src == NULL) {
-                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                if (job->auth_tag_output_len_in_bytes < UINT64_C(4) ||
-                    job->auth_tag_output_len_in_bytes > UINT64_C(16)) {
-                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
-                                return 1;
+                if (job->dst == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
                 }
-                if (job->cipher_mode != GCM) {
-                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
-                                return 1;
+                if (job->iv == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
                 }
-                if (job->auth_tag_output == NULL) {
-                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                /* raw key, the same for encryption and decryption */
+                if (job->aes_enc_key_expanded == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                /*
-                 * msg_len_to_hash_in_bytes not checked against zero.
-                 * It is not used for AES-GCM & GMAC - see
-                 * SUBMIT_JOB_AES_GCM_ENC and SUBMIT_JOB_AES_GCM_DEC functions.
-                 */
-                break;
-#endif /* !NO_GCM */
-        case CUSTOM_HASH:
-                if (job->hash_func == NULL) {
-                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                if (job->aes_key_len_in_bytes != SNOW3G_KEY_LEN_IN_BYTES) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->iv_len_in_bytes != SNOW3G_IV_LEN_IN_BYTES) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->msg_len_to_cipher_in_bits < SNOW3G_MIN_BITLEN ||
+                    job->msg_len_to_cipher_in_bits > SNOW3G_MAX_BITLEN) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
                 break;
-        case AES_CCM:
-                if (job->msg_len_to_hash_in_bytes != 0 && job->src == NULL) {
-                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+        case KASUMI_UEA1_BITLEN:
+                if (job->src == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                if (job->u.CCM.aad_len_in_bytes > 46) {
-                        /* 3 x AES_BLOCK - 2 bytes for AAD len */
-                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                if (job->dst == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                if ((job->u.CCM.aad_len_in_bytes > 0) &&
-                    (job->u.CCM.aad == NULL)) {
-                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                if (job->iv == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                /* M can be any even number from 4 to 16 */
-                if (job->auth_tag_output_len_in_bytes < UINT64_C(4) ||
-                    job->auth_tag_output_len_in_bytes > UINT64_C(16) ||
-                    ((job->auth_tag_output_len_in_bytes & 1) != 0)) {
-                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
-                                return 1;
+                /* raw key, the same for encryption and decryption */
+                if (job->aes_enc_key_expanded == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
                 }
-                if (job->cipher_mode != CCM) {
-                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                if (job->aes_key_len_in_bytes != KASUMI_KEY_LEN_IN_BYTES) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                /*
-                 * AES-CCM allows for only one message for
-                 * cipher and uthentication.
-                 * AAD can be used to extend authentication over
-                 * clear text fields.
-                 */
-                if (job->msg_len_to_cipher_in_bytes !=
-                    job->msg_len_to_hash_in_bytes) {
-                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                if (job->iv_len_in_bytes != KASUMI_IV_LEN_IN_BYTES) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                if (job->cipher_start_src_offset_in_bytes !=
-                    job->hash_start_src_offset_in_bytes) {
-                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                if (job->msg_len_to_cipher_in_bits < KASUMI_MIN_BITLEN ||
+                    job->msg_len_to_cipher_in_bits > KASUMI_MAX_BITLEN) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
                 break;
-        case AES_CMAC:
+        case SM4_CBC:
                 if (job->src == NULL) {
-                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
-                        return 1;
-                }
-                if ((job->u.CMAC._key_expanded == NULL) ||
-                    (job->u.CMAC._skey1 == NULL) ||
-                    (job->u.CMAC._skey2 == NULL)) {
-                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                /*
-                 * T is 128 bits but 96 bits is also allowed due to
-                 * IPsec use case (RFC 4494)
-                 */
-                if (job->auth_tag_output_len_in_bytes < UINT64_C(4) ||
-                    job->auth_tag_output_len_in_bytes > UINT64_C(16)) {
-                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                if (job->dst == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                if (job->auth_tag_output == NULL) {
-                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                if (job->iv == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
-                break;
-        case PLAIN_SHA1:
-        case PLAIN_SHA_224:
-        case PLAIN_SHA_256:
-        case PLAIN_SHA_384:
-        case PLAIN_SHA_512:
-                if (job->auth_tag_output_len_in_bytes !=
-                    auth_tag_len_ipsec[job->hash_alg]) {
-                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                if (job->cipher_direction == ENCRYPT &&
+                    job->aes_enc_key_expanded == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
                         return 1;
                 }
+                if (job->cipher_direction == DECRYPT &&
+                    job->aes_dec_key_expanded == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->aes_key_len_in_bytes != SM4_KEY_SIZE) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->msg_len_to_cipher_in_bytes == 0) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->msg_len_to_cipher_in_bytes &
+                    (SM4_BLOCK_SIZE - 1)) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->iv_len_in_bytes != SM4_BLOCK_SIZE) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                break;
+        case SM4_CNTR:
+                if (job->src == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->dst == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->iv == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                /* encryption round keys for both directions */
+                if (job->aes_enc_key_expanded == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->aes_key_len_in_bytes != SM4_KEY_SIZE) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->iv_len_in_bytes != SM4_BLOCK_SIZE &&
+                    job->iv_len_in_bytes != UINT64_C(12)) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->msg_len_to_cipher_in_bytes == 0) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                break;
+        case SM4_GCM:
+                if (job->src == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->dst == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->iv == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                /* Same key structure used for encrypt and decrypt */
+                if (job->cipher_direction == ENCRYPT &&
+                    job->aes_enc_key_expanded == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->cipher_direction == DECRYPT &&
+                    job->aes_dec_key_expanded == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->aes_key_len_in_bytes != SM4_KEY_SIZE) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->iv_len_in_bytes != UINT64_C(12)) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->u.SM4_GCM.aad_len_in_bytes != 0 &&
+                    job->u.SM4_GCM.aad == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->hash_alg != SM4_GMAC) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                break;
+        case AES_GCM_SIV:
+                if (job->src == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->dst == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->iv == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                /* Same key structure used for encrypt and decrypt */
+                if (job->cipher_direction == ENCRYPT &&
+                    job->aes_enc_key_expanded == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->cipher_direction == DECRYPT &&
+                    job->aes_dec_key_expanded == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->aes_key_len_in_bytes != UINT64_C(16) &&
+                    job->aes_key_len_in_bytes != UINT64_C(32)) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->iv_len_in_bytes != UINT64_C(12)) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                /* RFC 8452 limits plaintext and AAD to 2^36 bytes */
+                if (job->msg_len_to_cipher_in_bytes > (UINT64_C(1) << 36) ||
+                    job->u.GCM_SIV.aad_len_in_bytes > (UINT64_C(1) << 36)) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->u.GCM_SIV.aad_len_in_bytes != 0 &&
+                    job->u.GCM_SIV.aad == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->cipher_direction == DECRYPT &&
+                    job->u.GCM_SIV.tag == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->hash_alg != AES_GCM_SIV_TAG) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                break;
+        case CFB:
+                if (job->src == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->dst == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->iv == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                /* both directions use the encryption key schedule */
+                if (job->aes_enc_key_expanded == NULL) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->aes_key_len_in_bytes != UINT64_C(16) &&
+                    job->aes_key_len_in_bytes != UINT64_C(24) &&
+                    job->aes_key_len_in_bytes != UINT64_C(32)) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->iv_len_in_bytes != UINT64_C(16)) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                if (job->msg_len_to_cipher_in_bytes == 0) {
+                        INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                        return 1;
+                }
+                break;
+        default:
+                INVALID_PRN("cipher_mode:%d\n", job->cipher_mode);
+                return 1;
+        }
+
+        switch (job->hash_alg) {
+        case SHA1:
+        case AES_XCBC:
+        case MD5:
+        case SHA_224:
+        case SHA_256:
+        case SHA_384:
+        case SHA_512:
+                if (job->src == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->auth_tag_output_len_in_bytes !=
+                    auth_tag_len_ipsec[job->hash_alg] &&
+                    job->auth_tag_output_len_in_bytes !=
+                    auth_tag_len_fips[job->hash_alg]) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->msg_len_to_hash_in_bytes == 0) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->auth_tag_output == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                break;
+        case SHA_512_256:
+        case SHA_512_224:
                 if (job->src == NULL) {
                         INVALID_PRN("hash_alg:%d\n", job->hash_alg);
                         return 1;
                 }
+                /* full SHA512/t digest or half of it (IPsec) */
+                if (job->auth_tag_output_len_in_bytes !=
+                    auth_tag_len_ipsec[job->hash_alg] &&
+                    job->auth_tag_output_len_in_bytes !=
+                    2 * auth_tag_len_ipsec[job->hash_alg]) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->msg_len_to_hash_in_bytes == 0) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->auth_tag_output == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                break;
+        case NULL_HASH:
+                break;
+#ifndef NO_GCM
+        case AES_GMAC:
+                if (job->src == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->auth_tag_output_len_in_bytes < UINT64_C(4) ||
+                    job->auth_tag_output_len_in_bytes > UINT64_C(16)) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                                return 1;
+                }
+                if (job->cipher_mode != GCM) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                                return 1;
+                }
+                if (job->auth_tag_output == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                /*
+                 * msg_len_to_hash_in_bytes not checked against zero.
+                 * It is not used for AES-GCM & GMAC - see
+                 * SUBMIT_JOB_AES_GCM_ENC and SUBMIT_JOB_AES_GCM_DEC functions.
+                 */
+                break;
+#endif /* !NO_GCM */
+        case CUSTOM_HASH:
+                if (job->hash_func == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                break;
+        case AES_CCM:
+                if (job->msg_len_to_hash_in_bytes != 0 && job->src == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->u.CCM.aad_len_in_bytes >= 0xFF00) {
+                        /*
+                         * AAD length is encoded on 2 bytes only
+                         * (0xFF00 and above need longer encodings)
+                         */
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if ((job->u.CCM.aad_len_in_bytes > 0) &&
+                    (job->u.CCM.aad == NULL)) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                /* M can be any even number from 4 to 16 */
+                if (job->auth_tag_output_len_in_bytes < UINT64_C(4) ||
+                    job->auth_tag_output_len_in_bytes > UINT64_C(16) ||
+                    ((job->auth_tag_output_len_in_bytes & 1) != 0)) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                                return 1;
+                }
+                if (job->cipher_mode != CCM) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                /*
+                 * AES-CCM allows for only one message for
+                 * cipher and uthentication.
+                 * AAD can be used to extend authentication over
+                 * clear text fields.
+                 */
+                if (job->msg_len_to_cipher_in_bytes !=
+                    job->msg_len_to_hash_in_bytes) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->cipher_start_src_offset_in_bytes !=
+                    job->hash_start_src_offset_in_bytes) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                break;
+        case AES_CMAC:
+                if (job->src == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if ((job->u.CMAC._key_expanded == NULL) ||
+                    (job->u.CMAC._skey1 == NULL) ||
+                    (job->u.CMAC._skey2 == NULL)) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                /*
+                 * T is 128 bits but 96 bits is also allowed due to
+                 * IPsec use case (RFC 4494)
+                 */
+                if (job->auth_tag_output_len_in_bytes < UINT64_C(4) ||
+                    job->auth_tag_output_len_in_bytes > UINT64_C(16)) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->auth_tag_output == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                break;
+        case PLAIN_SHA1:
+        case PLAIN_SHA_224:
+        case PLAIN_SHA_256:
+        case PLAIN_SHA_384:
+        case PLAIN_SHA_512:
+        case PLAIN_SHA_512_256:
+        case PLAIN_SHA_512_224:
+        case PLAIN_SHA3_256:
+        case PLAIN_SHA3_384:
+        case PLAIN_SHA3_512:
+        case PLAIN_SM3:
+                if (job->auth_tag_output_len_in_bytes !=
+                    auth_tag_len_ipsec[job->hash_alg]) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->src == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->auth_tag_output == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                break;
+        case PLAIN_SHAKE128:
+        case PLAIN_SHAKE256:
+                if (job->auth_tag_output_len_in_bytes == 0) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->src == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->auth_tag_output == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                break;
+        case SHA3_256:
+        case SHA3_384:
+        case SHA3_512:
+        case SM3:
+                if (job->src == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->u.HMAC._hashed_auth_key_xor_ipad == NULL ||
+                    job->u.HMAC._hashed_auth_key_xor_opad == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                /* truncated (half) or full digest */
+                if (job->auth_tag_output_len_in_bytes !=
+                    auth_tag_len_ipsec[job->hash_alg] &&
+                    job->auth_tag_output_len_in_bytes !=
+                    2 * auth_tag_len_ipsec[job->hash_alg]) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->auth_tag_output == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                break;
+        case PLAIN_BLAKE2B:
+        case PLAIN_BLAKE2S:
+        case BLAKE2B_KEYED:
+        case BLAKE2S_KEYED:
+                /* any digest length up to the maximum one */
+                if (job->auth_tag_output_len_in_bytes == 0 ||
+                    job->auth_tag_output_len_in_bytes >
+                    auth_tag_len_ipsec[job->hash_alg]) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->src == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->auth_tag_output == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->hash_alg == PLAIN_BLAKE2B ||
+                    job->hash_alg == PLAIN_BLAKE2S)
+                        break;
+                /* key length limit is the same as digest length one */
+                if (job->u.BLAKE2._key == NULL ||
+                    job->u.BLAKE2._key_len_in_bytes == 0 ||
+                    job->u.BLAKE2._key_len_in_bytes >
+                    auth_tag_len_ipsec[job->hash_alg]) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                break;
+        case SM4_GMAC:
+                if (job->src == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->auth_tag_output_len_in_bytes < UINT64_C(4) ||
+                    job->auth_tag_output_len_in_bytes > UINT64_C(16)) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->cipher_mode != SM4_GCM) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->auth_tag_output == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                break;
+        case AES_GCM_SIV_TAG:
+                if (job->src == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                /* tag is the counter block, it can't be truncated */
+                if (job->auth_tag_output_len_in_bytes != UINT64_C(16)) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->cipher_mode != AES_GCM_SIV) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->auth_tag_output == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                break;
+        case DOCSIS_CRC32:
+                if (job->cipher_mode != DOCSIS_SEC_BPI) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->src == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->auth_tag_output_len_in_bytes !=
+                    auth_tag_len_ipsec[job->hash_alg]) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->auth_tag_output == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                /* CRC is computed over clear text */
+                if ((job->cipher_direction == ENCRYPT &&
+                     job->chain_order != HASH_CIPHER) ||
+                    (job->cipher_direction == DECRYPT &&
+                     job->chain_order != CIPHER_HASH)) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                break;
+        case ZUC_EIA3_BITLEN:
+                if (job->src == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->u.ZUC_EIA3._key == NULL ||
+                    job->u.ZUC_EIA3._iv == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->msg_len_to_hash_in_bits < ZUC_MIN_BITLEN ||
+                    job->msg_len_to_hash_in_bits > ZUC_MAX_BITLEN) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->auth_tag_output_len_in_bytes !=
+                    auth_tag_len_ipsec[job->hash_alg]) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->auth_tag_output == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                break;
+        case SNOW3G_UIA2_BITLEN:
+                if (job->src == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->u.SNOW3G_UIA2._key == NULL ||
+                    job->u.SNOW3G_UIA2._iv == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->msg_len_to_hash_in_bits < SNOW3G_MIN_BITLEN ||
+                    job->msg_len_to_hash_in_bits > SNOW3G_MAX_BITLEN) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->auth_tag_output_len_in_bytes !=
+                    auth_tag_len_ipsec[job->hash_alg]) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->auth_tag_output == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                break;
+        case KASUMI_UIA1_BITLEN:
+                if (job->src == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->u.KASUMI_UIA1._key == NULL ||
+                    job->u.KASUMI_UIA1._iv == NULL) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->u.KASUMI_UIA1._direction > 1) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->msg_len_to_hash_in_bits < KASUMI_MIN_BITLEN ||
+                    job->msg_len_to_hash_in_bits > KASUMI_MAX_BITLEN) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
+                if (job->auth_tag_output_len_in_bytes !=
+                    auth_tag_len_ipsec[job->hash_alg]) {
+                        INVALID_PRN("hash_alg:%d\n", job->hash_alg);
+                        return 1;
+                }
                 if (job->auth_tag_output == NULL) {
                         INVALID_PRN("hash_alg:%d\n", job->hash_alg);
                         return 1;
@@ -0,0 +1,142 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*
+ * AES-CTR for SSE architecture without AES-NI
+ *
+ * Counter blocks are encrypted 8 at a time with constant time bitsliced
+ * AES (see aes_bitslice.h). The 32-bit big endian block counter in the last
+ * 4 bytes of the counter block wraps around as in the AES-NI code.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "intel-ipsec-mb.h"
+#include "asm.h"
+#include "aes_bitslice.h"
+
+/* reverses byte order of a block */
+__forceinline __m128i
+aes_cntr_bswap(const __m128i x)
+{
+        return _mm_shuffle_epi8(x, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8,
+                                                9, 10, 11, 12, 13, 14, 15));
+}
+
+__forceinline void
+aes_cntr_sse_no_aesni(const void *in, const void *IV, const void *keys,
+                      void *out, uint64_t len_bytes, const uint64_t IV_len,
+                      const unsigned nrounds)
+{
+        DECLARE_ALIGNED(__m128i bs_keys[AES_BS_MAX_ROUNDS + 1][8], 16);
+        DECLARE_ALIGNED(uint8_t iv_block[16], 16);
+        const uint8_t *p_in = (const uint8_t *) in;
+        uint8_t *p_out = (uint8_t *) out;
+        __m128i ctr;
+
+        if (len_bytes == 0)
+                return;
+
+        if (IV_len & 16) {
+                /* Nonce + ESP IV + block counter (BE) */
+                memcpy(iv_block, IV, 16);
+        } else {
+                /* Nonce + ESP IV and block counter 1 (BE) */
+                memcpy(iv_block, IV, 12);
+                iv_block[12] = 0;
+                iv_block[13] = 0;
+                iv_block[14] = 0;
+                iv_block[15] = 1;
+        }
+        /* block counter is the lowest 32-bit word */
+        ctr = aes_cntr_bswap(_mm_load_si128((const __m128i *) iv_block));
+
+        aes_bs_key_expand(bs_keys, keys, nrounds);
+
+        while (len_bytes != 0) {
+                __m128i blocks[AES_BS_BLOCKS];
+                unsigned i;
+
+                for (i = 0; i < AES_BS_BLOCKS; i++)
+                        blocks[i] = aes_cntr_bswap(_mm_add_epi32(ctr,
+                                                   _mm_set_epi32(0, 0, 0,
+                                                                 (int) i)));
+                ctr = _mm_add_epi32(ctr, _mm_set_epi32(0, 0, 0,
+                                                       AES_BS_BLOCKS));
+
+                aes_bs_encrypt_x8(blocks,
+                                  (const __m128i (*)[8]) bs_keys, nrounds);
+
+                for (i = 0; i < AES_BS_BLOCKS && len_bytes != 0; i++) {
+                        if (len_bytes >= 16) {
+                                const __m128i x =
+                                        _mm_loadu_si128((const __m128i *)
+                                                        p_in);
+
+                                _mm_storeu_si128((__m128i *) p_out,
+                                                 _mm_xor_si128(x, blocks[i]));
+                                p_in += 16;
+                                p_out += 16;
+                                len_bytes -= 16;
+                        } else {
+                                /* partial last block */
+                                DECLARE_ALIGNED(uint8_t buf[16], 16);
+
+                                memset(buf, 0, sizeof(buf));
+                                memcpy(buf, p_in, (size_t) len_bytes);
+                                _mm_store_si128((__m128i *) buf,
+                                                _mm_xor_si128(
+                                                _mm_load_si128((__m128i *) buf),
+                                                blocks[i]));
+                                memcpy(p_out, buf, (size_t) len_bytes);
+                                len_bytes = 0;
+                        }
+                }
+        }
+}
+
+IMB_DLL_LOCAL void
+aes_cntr_128_sse_no_aesni(const void *in, const void *IV, const void *keys,
+                          void *out, uint64_t len_bytes, uint64_t IV_len)
+{
+        aes_cntr_sse_no_aesni(in, IV, keys, out, len_bytes, IV_len, 10);
+}
+
+IMB_DLL_LOCAL void
+aes_cntr_192_sse_no_aesni(const void *in, const void *IV, const void *keys,
+                          void *out, uint64_t len_bytes, uint64_t IV_len)
+{
+        aes_cntr_sse_no_aesni(in, IV, keys, out, len_bytes, IV_len, 12);
+}
+
+IMB_DLL_LOCAL void
+aes_cntr_256_sse_no_aesni(const void *in, const void *IV, const void *keys,
+                          void *out, uint64_t len_bytes, uint64_t IV_len)
+{
+        aes_cntr_sse_no_aesni(in, IV, keys, out, len_bytes, IV_len, 14);
+}
@@ -36,6 +36,17 @@
 #include "des.h"
 #include "gcm.h"
 #include "noaesni.h"
+#include "ethernet_fcs.h"
+#include "zuc.h"
+#include "snow3g.h"
+#include "kasumi.h"
+#include "sha3.h"
+#include "blake2.h"
+#include "sm3.h"
+#include "sm4.h"
+#include "aes_gcm_siv.h"
+#include "aes_cfb.h"
+#include "sha512_t.h"
 
 /* ====================================================================== */
 
@@ -111,6 +122,10 @@ JOB_AES_HMAC *flush_job_aes_cmac_auth_sse_no_aesni(MB_MGR_CMAC_OOO *state);
 #define FLUSH_JOB_HMAC_SHA_384        flush_job_hmac_sha_384_sse
 #define SUBMIT_JOB_HMAC_SHA_512       submit_job_hmac_sha_512_sse
 #define FLUSH_JOB_HMAC_SHA_512        flush_job_hmac_sha_512_sse
+#define SUBMIT_JOB_HMAC_SHA_512_256   submit_job_hmac_sha_512_256_sse
+#define FLUSH_JOB_HMAC_SHA_512_256    flush_job_hmac_sha_512_256_sse
+#define SUBMIT_JOB_HMAC_SHA_512_224   submit_job_hmac_sha_512_224_sse
+#define FLUSH_JOB_HMAC_SHA_512_224    flush_job_hmac_sha_512_224_sse
 #define SUBMIT_JOB_HMAC_MD5   submit_job_hmac_md5_sse
 #define FLUSH_JOB_HMAC_MD5    flush_job_hmac_md5_sse
 #define SUBMIT_JOB_AES_XCBC   submit_job_aes_xcbc_sse_no_aesni
@@ -166,6 +181,37 @@ JOB_AES_HMAC *flush_job_aes_cmac_auth_sse_no_aesni(MB_MGR_CMAC_OOO *state);
 /* ====================================================================== */
 
 #define AES_CFB_128_ONE    aes_cfb_128_one_sse_no_aesni
+#define SHA512_256         sha512_256_sse
+#define SHA512_224         sha512_224_sse
+
+#define ETHERNET_FCS       ethernet_fcs_sse_no_aesni
+
+#define SUBMIT_JOB_ZUC_EEA3    submit_job_zuc_eea3_sse
+#define FLUSH_JOB_ZUC_EEA3     flush_job_zuc_eea3_sse
+#define SUBMIT_JOB_SNOW3G_UEA2 submit_job_snow3g_uea2_sse
+#define FLUSH_JOB_SNOW3G_UEA2  flush_job_snow3g_uea2_sse
+#define SNOW3G_F9_1_BUFFER     snow3g_f9_1_buffer_sse_no_aesni
+#define SUBMIT_JOB_KASUMI_UEA1 submit_job_kasumi_uea1_sse
+#define FLUSH_JOB_KASUMI_UEA1  flush_job_kasumi_uea1_sse
+#define SUBMIT_JOB_SHA3        submit_job_sha3_sse
+#define FLUSH_JOB_SHA3         flush_job_sha3_sse
+#define SUBMIT_JOB_BLAKE2B     submit_job_blake2b_sse
+#define FLUSH_JOB_BLAKE2B      flush_job_blake2b_sse
+#define SUBMIT_JOB_BLAKE2S     submit_job_blake2s_sse
+#define FLUSH_JOB_BLAKE2S      flush_job_blake2s_sse
+#define SUBMIT_JOB_SM3         submit_job_sm3_sse
+#define FLUSH_JOB_SM3          flush_job_sm3_sse
+#define SUBMIT_JOB_SM4_CBC_ENC submit_job_sm4_cbc_enc_sse_no_aesni
+#define FLUSH_JOB_SM4_CBC_ENC  flush_job_sm4_cbc_enc_sse_no_aesni
+#define SUBMIT_JOB_SM4_CBC_DEC submit_job_sm4_cbc_dec_sse_no_aesni
+#define SUBMIT_JOB_SM4_CNTR    submit_job_sm4_cntr_sse_no_aesni
+#define SUBMIT_JOB_SM4_GCM_ENC submit_job_sm4_gcm_enc_sse_no_aesni
+#define SUBMIT_JOB_SM4_GCM_DEC submit_job_sm4_gcm_dec_sse_no_aesni
+#define SUBMIT_JOB_AES_GCM_SIV submit_job_aes_gcm_siv_sse_no_aesni
+#define FLUSH_JOB_AES_GCM_SIV  flush_job_aes_gcm_siv_sse_no_aesni
+#define SUBMIT_JOB_AES_CFB_ENC submit_job_aes_cfb_enc_sse_no_aesni
+#define FLUSH_JOB_AES_CFB_ENC  flush_job_aes_cfb_enc_sse_no_aesni
+#define SUBMIT_JOB_AES_CFB_DEC submit_job_aes_cfb_dec_sse_no_aesni
 
 void aes128_cbc_mac_x4_no_aesni(AES_ARGS_x8 *args, uint64_t len);
 
@@ -489,6 +535,14 @@ init_mb_mgr_sse_no_aesni(MB_MGR *state)
                 p[SHA_512_BLOCK_SIZE - 1] = 0x00;
         }
 
+        /* Init HMAC/SHA512/256 and HMAC/SHA512/224 out-of-order fields */
+        hmac_sha512_t_ooo_init(&state->hmac_sha_512_256_ooo,
+                               &state->hmac_sha_512_ooo,
+                               SHA512_256_DIGEST_SIZE_IN_BYTES);
+        hmac_sha512_t_ooo_init(&state->hmac_sha_512_224_ooo,
+                               &state->hmac_sha_512_ooo,
+                               SHA512_224_DIGEST_SIZE_IN_BYTES);
+
         /* Init HMAC/MD5 out-of-order fields */
         state->hmac_md5_ooo.lens[0] = 0;
         state->hmac_md5_ooo.lens[1] = 0;
@@ -561,6 +615,62 @@ init_mb_mgr_sse_no_aesni(MB_MGR *state)
         }
         state->aes_cmac_ooo.unused_lanes = 0xF3210;
 
+        /* Init ZUC-EEA3 and SNOW3G-UEA2 out-of-order fields */
+        for (j = 0; j < SSE_NUM_ZUC_LANES; j++) {
+                state->zuc_eea3_ooo.lanes.lens[j] = 0;
+                state->zuc_eea3_ooo.lanes.job_in_lane[j] = NULL;
+        }
+        state->zuc_eea3_ooo.lanes.unused_lanes = 0x3210;
+        state->zuc_eea3_ooo.lanes.num_lanes_inuse = 0;
+        state->zuc_eea3_ooo.lanes.init_lanes = 0;
+
+        for (j = 0; j < SSE_NUM_SNOW3G_LANES; j++) {
+                state->snow3g_uea2_ooo.lanes.lens[j] = 0;
+                state->snow3g_uea2_ooo.lanes.job_in_lane[j] = NULL;
+        }
+        state->snow3g_uea2_ooo.lanes.unused_lanes = 0x3210;
+        state->snow3g_uea2_ooo.lanes.num_lanes_inuse = 0;
+        state->snow3g_uea2_ooo.lanes.init_lanes = 0;
+
+        /* Init KASUMI-UEA1 out-of-order fields */
+        for (j = 0; j < SSE_NUM_KASUMI_LANES; j++) {
+                state->kasumi_uea1_ooo.lanes.lens[j] = 0;
+                state->kasumi_uea1_ooo.lanes.job_in_lane[j] = NULL;
+        }
+        state->kasumi_uea1_ooo.lanes.unused_lanes = 0x3210;
+        state->kasumi_uea1_ooo.lanes.num_lanes_inuse = 0;
+        state->kasumi_uea1_ooo.lanes.init_lanes = 0;
+
+        /* Init SHA3 out-of-order fields */
+        sha3_ooo_init(&state->sha3_256_ooo, SHA3_256_BLOCK_SIZE,
+                      SSE_NUM_SHA3_LANES);
+        sha3_ooo_init(&state->sha3_384_ooo, SHA3_384_BLOCK_SIZE,
+                      SSE_NUM_SHA3_LANES);
+        sha3_ooo_init(&state->sha3_512_ooo, SHA3_512_BLOCK_SIZE,
+                      SSE_NUM_SHA3_LANES);
+        sha3_ooo_init(&state->shake128_ooo, SHAKE128_BLOCK_SIZE,
+                      SSE_NUM_SHA3_LANES);
+
+        /* Init BLAKE2 out-of-order fields */
+        blake2b_ooo_init(&state->blake2b_ooo, SSE_NUM_BLAKE2B_LANES);
+        blake2s_ooo_init(&state->blake2s_ooo, SSE_NUM_BLAKE2S_LANES);
+
+        /* Init SM3 and SM4 out-of-order fields */
+        sm3_ooo_init(&state->hmac_sm3_ooo, SSE_NUM_SM3_LANES);
+        sm4_cbc_enc_ooo_init(&state->sm4_cbc_enc_ooo,
+                             SSE_NUM_SM4_LANES);
+
+        /* Init AES-GCM-SIV out-of-order fields */
+        aes_gcm_siv_ooo_init(&state->aes_gcm_siv_ooo);
+
+        /* Init AES-CFB encryption out-of-order fields */
+        aes_cfb_enc_ooo_init(&state->aes_cfb_128_ooo,
+                             SSE_NUM_AES_CFB_LANES);
+        aes_cfb_enc_ooo_init(&state->aes_cfb_192_ooo,
+                             SSE_NUM_AES_CFB_LANES);
+        aes_cfb_enc_ooo_init(&state->aes_cfb_256_ooo,
+                             SSE_NUM_AES_CFB_LANES);
+
         /* Init "in order" components */
         state->next_job = 0;
         state->earliest_job = -1;
@@ -588,6 +698,11 @@ init_mb_mgr_sse_no_aesni(MB_MGR *state)
         state->sha384              = sha384_sse;
         state->sha512_one_block    = sha512_one_block_sse;
         state->sha512              = sha512_sse;
+        state->sha512_224_one_block = sha512_224_one_block_sse;
+        state->sha512_224          = sha512_224_sse;
+        state->sha512_256_one_block = sha512_256_one_block_sse;
+        state->sha512_256          = sha512_256_sse;
+        state->hmac_ipad_opad_mb   = hmac_ipad_opad_mb_sse;
         state->md5_one_block       = md5_one_block_sse;
         state->aes128_cfb_one      = aes_cfb_128_one_sse_no_aesni;
 #ifndef NO_GCM
@@ -618,6 +733,9 @@ init_mb_mgr_sse_no_aesni(MB_MGR *state)
         state->gcm128_pre          = aes_gcm_pre_128_sse_no_aesni;
         state->gcm192_pre          = aes_gcm_pre_192_sse_no_aesni;
         state->gcm256_pre          = aes_gcm_pre_256_sse_no_aesni;
+        state->gcm128_pre_mb       = aes_gcm_pre_128_mb_sse_no_aesni;
+        state->gcm192_pre_mb       = aes_gcm_pre_192_mb_sse_no_aesni;
+        state->gcm256_pre_mb       = aes_gcm_pre_256_mb_sse_no_aesni;
 #endif
 }
 
@@ -0,0 +1,335 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* SHA3 and SHAKE (FIPS 202) common code, HMAC-SHA3 key set up API */
+
+#include <string.h>
+
+#include "intel-ipsec-mb.h"
+#include "sha3.h"
+
+IMB_DLL_LOCAL const uint64_t keccak_rc[SHA3_ROUNDS] = {
+        0x0000000000000001ULL, 0x0000000000008082ULL,
+        0x800000000000808aULL, 0x8000000080008000ULL,
+        0x000000000000808bULL, 0x0000000080000001ULL,
+        0x8000000080008081ULL, 0x8000000000008009ULL,
+        0x000000000000008aULL, 0x0000000000000088ULL,
+        0x0000000080008009ULL, 0x000000008000000aULL,
+        0x000000008000808bULL, 0x800000000000008bULL,
+        0x8000000000008089ULL, 0x8000000000008003ULL,
+        0x8000000000008002ULL, 0x8000000000000080ULL,
+        0x000000000000800aULL, 0x800000008000000aULL,
+        0x8000000080008081ULL, 0x8000000000008080ULL,
+        0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+IMB_DLL_LOCAL const uint8_t keccak_rho[25] = {
+         0,  1, 62, 28, 27,
+        36, 44,  6, 55, 20,
+         3, 10, 43, 25, 39,
+        41, 45, 15, 21,  8,
+        18,  2, 61, 56, 14
+};
+
+/* word (x, y) moves to (y, 2 * x + 3 * y) */
+IMB_DLL_LOCAL const uint8_t keccak_pi[25] = {
+         0, 10, 20,  5, 15,
+        16,  1, 11, 21,  6,
+         7, 17,  2, 12, 22,
+        23,  8, 18,  3, 13,
+        14, 24,  9, 19,  4
+};
+
+IMB_DLL_LOCAL const uint8_t sha3_zero_block[SHA3_MAX_BLOCK_SIZE] = { 0 };
+
+/* SHA3 and SHAKE domain separation bits with the first padding bit */
+#define SHA3_PAD  0x06
+#define SHAKE_PAD 0x1f
+
+static uint64_t
+keccak_rol64(const uint64_t x, const unsigned n)
+{
+        return (n == 0) ? x : ((x << n) | (x >> (64 - n)));
+}
+
+static void
+keccak_f1600(uint64_t *a)
+{
+        uint64_t b[25], c[5], d;
+        unsigned r, x, y;
+
+        for (r = 0; r < SHA3_ROUNDS; r++) {
+                /* theta */
+                for (x = 0; x < 5; x++)
+                        c[x] = a[x] ^ a[x + 5] ^ a[x + 10] ^ a[x + 15] ^
+                                a[x + 20];
+                for (x = 0; x < 5; x++) {
+                        d = c[(x + 4) % 5] ^ keccak_rol64(c[(x + 1) % 5], 1);
+                        for (y = 0; y < 25; y += 5)
+                                a[y + x] ^= d;
+                }
+                /* rho and pi */
+                for (x = 0; x < 25; x++)
+                        b[keccak_pi[x]] = keccak_rol64(a[x], keccak_rho[x]);
+                /* chi */
+                for (y = 0; y < 25; y += 5)
+                        for (x = 0; x < 5; x++)
+                                a[y + x] = b[y + x] ^
+                                        (~b[y + (x + 1) % 5] &
+                                         b[y + (x + 2) % 5]);
+                /* iota */
+                a[0] ^= keccak_rc[r];
+        }
+}
+
+static uint64_t
+load_le64(const uint8_t *p)
+{
+        uint64_t x = 0;
+        int i;
+
+        for (i = 7; i >= 0; i--)
+                x = (x << 8) | p[i];
+        return x;
+}
+
+static void
+keccak_absorb_block(uint64_t *a, const uint8_t *block,
+                    const unsigned block_size)
+{
+        unsigned i;
+
+        for (i = 0; i < block_size / 8; i++)
+                a[i] ^= load_le64(&block[i * 8]);
+        keccak_f1600(a);
+}
+
+/* state word bytes are serialized least significant byte first */
+static void
+keccak_store(const uint64_t *a, uint8_t *out, const unsigned len)
+{
+        unsigned i;
+
+        for (i = 0; i < len; i++)
+                out[i] = (uint8_t) (a[i / 8] >> (8 * (i % 8)));
+}
+
+static void
+sha3_one_block(const void *data, void *state, const unsigned block_size)
+{
+        uint64_t a[25];
+
+        memset(a, 0, sizeof(a));
+        keccak_absorb_block(a, (const uint8_t *) data, block_size);
+        keccak_store(a, (uint8_t *) state, SHA3_STATE_SIZE);
+}
+
+static void
+sha3_generic(const void *data, uint64_t length, void *digest,
+             const unsigned block_size, const unsigned digest_size)
+{
+        const uint8_t *p = (const uint8_t *) data;
+        uint8_t block[SHA3_MAX_BLOCK_SIZE];
+        uint64_t a[25];
+
+        memset(a, 0, sizeof(a));
+        for (; length >= block_size; length -= block_size, p += block_size)
+                keccak_absorb_block(a, p, block_size);
+
+        memset(block, 0, sizeof(block));
+        memcpy(block, p, length);
+        block[length] = SHA3_PAD;
+        block[block_size - 1] |= 0x80;
+        keccak_absorb_block(a, block, block_size);
+
+        keccak_store(a, (uint8_t *) digest, digest_size);
+}
+
+void sha3_256_one_block(const void *data, void *state)
+{
+        sha3_one_block(data, state, SHA3_256_BLOCK_SIZE);
+}
+
+void sha3_384_one_block(const void *data, void *state)
+{
+        sha3_one_block(data, state, SHA3_384_BLOCK_SIZE);
+}
+
+void sha3_512_one_block(const void *data, void *state)
+{
+        sha3_one_block(data, state, SHA3_512_BLOCK_SIZE);
+}
+
+void sha3_256(const void *data, const uint64_t length, void *digest)
+{
+        sha3_generic(data, length, digest, SHA3_256_BLOCK_SIZE,
+                     SHA3_256_DIGEST_SIZE_IN_BYTES);
+}
+
+void sha3_384(const void *data, const uint64_t length, void *digest)
+{
+        sha3_generic(data, length, digest, SHA3_384_BLOCK_SIZE,
+                     SHA3_384_DIGEST_SIZE_IN_BYTES);
+}
+
+void sha3_512(const void *data, const uint64_t length, void *digest)
+{
+        sha3_generic(data, length, digest, SHA3_512_BLOCK_SIZE,
+                     SHA3_512_DIGEST_SIZE_IN_BYTES);
+}
+
+/* ========================================================================== */
+/* Out of order manager lane handling */
+
+void
+sha3_ooo_init(MB_MGR_SHA3_OOO *state, const uint32_t block_size,
+              const unsigned num_lanes)
+{
+        unsigned i;
+
+        memset(state, 0, sizeof(*state));
+        state->block_size = block_size;
+        for (i = num_lanes; i > 0; i--)
+                state->unused_lanes = (state->unused_lanes << 4) | (i - 1);
+}
+
+static int
+sha3_is_hmac(const JOB_AES_HMAC *job)
+{
+        return job->hash_alg == SHA3_256 || job->hash_alg == SHA3_384 ||
+                job->hash_alg == SHA3_512;
+}
+
+/* loads Keccak state of the lane from serialized state */
+static void
+sha3_ooo_load_state(MB_MGR_SHA3_OOO *state, const unsigned lane,
+                    const uint8_t *in)
+{
+        unsigned i;
+
+        for (i = 0; i < 25; i++)
+                state->state[i][lane] = load_le64(&in[i * 8]);
+}
+
+/* pads the last (partial) block of len bytes in the lane's extra block */
+static void
+sha3_ooo_pad(SHA3_LANE_DATA *ld, const uint64_t len, const uint8_t pad,
+             const uint32_t block_size)
+{
+        memset(&ld->extra_block[len], 0, block_size - len);
+        ld->extra_block[len] = pad;
+        ld->extra_block[block_size - 1] |= 0x80;
+}
+
+/* copies len bytes of the lane's state (up to the block size) to out */
+static void
+sha3_ooo_squeeze(const MB_MGR_SHA3_OOO *state, const unsigned lane,
+                 uint8_t *out, const uint64_t len)
+{
+        uint64_t i;
+
+        for (i = 0; i < len; i++)
+                out[i] = (uint8_t) (state->state[i / 8][lane] >>
+                                    (8 * (i % 8)));
+}
+
+void
+sha3_ooo_load_lane(MB_MGR_SHA3_OOO *state, const unsigned lane,
+                   JOB_AES_HMAC *job)
+{
+        SHA3_LANE_DATA *ld = &state->ldata[lane];
+        const uint32_t block_size = state->block_size;
+        const uint8_t *msg = job->src + job->hash_start_src_offset_in_bytes;
+        const uint64_t len = job->msg_len_to_hash_in_bytes;
+        const uint64_t tail = len % block_size;
+        unsigned i;
+
+        ld->job_in_lane = job;
+        ld->out_done = 0;
+        ld->extra_done = 0;
+        ld->outer_done = 0;
+
+        state->in[lane] = msg;
+        state->lens[lane] = len / block_size;
+
+        memcpy(ld->extra_block, &msg[len - tail], tail);
+        sha3_ooo_pad(ld, tail, (job->hash_alg == PLAIN_SHAKE128 ||
+                                job->hash_alg == PLAIN_SHAKE256) ?
+                     SHAKE_PAD : SHA3_PAD, block_size);
+
+        if (sha3_is_hmac(job))
+                sha3_ooo_load_state(state, lane,
+                                    job->u.HMAC._hashed_auth_key_xor_ipad);
+        else
+                for (i = 0; i < 25; i++)
+                        state->state[i][lane] = 0;
+}
+
+int
+sha3_ooo_lane_next(MB_MGR_SHA3_OOO *state, const unsigned lane)
+{
+        SHA3_LANE_DATA *ld = &state->ldata[lane];
+        JOB_AES_HMAC *job = ld->job_in_lane;
+        const uint32_t block_size = state->block_size;
+        uint64_t n;
+
+        if (!ld->extra_done) {
+                state->in[lane] = ld->extra_block;
+                state->lens[lane] = 1;
+                ld->extra_done = 1;
+                return 0;
+        }
+
+        if (sha3_is_hmac(job) && !ld->outer_done) {
+                /* inner digest is half of the capacity */
+                const uint64_t digest_size =
+                        (SHA3_STATE_SIZE - block_size) / 2;
+
+                sha3_ooo_squeeze(state, lane, ld->extra_block, digest_size);
+                sha3_ooo_pad(ld, digest_size, SHA3_PAD, block_size);
+                sha3_ooo_load_state(state, lane,
+                                    job->u.HMAC._hashed_auth_key_xor_opad);
+                state->in[lane] = ld->extra_block;
+                state->lens[lane] = 1;
+                ld->outer_done = 1;
+                return 0;
+        }
+
+        n = job->auth_tag_output_len_in_bytes - ld->out_done;
+        if (n > block_size)
+                n = block_size;
+        sha3_ooo_squeeze(state, lane, &job->auth_tag_output[ld->out_done], n);
+        ld->out_done += n;
+
+        if (ld->out_done < job->auth_tag_output_len_in_bytes) {
+                /* more SHAKE output needed - permute with zero input */
+                state->in[lane] = sha3_zero_block;
+                state->lens[lane] = 1;
+                return 0;
+        }
+        return 1;
+}
@@ -31,6 +31,7 @@
 
 #include "intel-ipsec-mb.h"
 #include "constants.h"
+#include "sha512_t.h"
 
 extern void sha1_block_sse(const void *, void *);
 extern void sha1_block_avx(const void *, void *);
@@ -122,7 +123,9 @@ sha_generic_one_block(const void *inp, void *digest,
                         sha384_block_avx(inp, digest);
                 else
                         sha384_block_sse(inp, digest);
-        } else if (sha_type == 512) {
+        } else if (sha_type == 512 || sha_type == 512256 ||
+                   sha_type == 512224) {
+                /* SHA512/t only differs from SHA512 in the initial digest */
                 if (is_avx)
                         sha512_block_avx(inp, digest);
                 else
@@ -202,6 +205,36 @@ void sha512_init_digest(void *p)
         p_digest[7] = SHA512_H7;
 }
 
+__forceinline
+void sha512_256_init_digest(void *p)
+{
+        uint64_t *p_digest = (uint64_t *)p;
+
+        p_digest[0] = SHA512_256_H0;
+        p_digest[1] = SHA512_256_H1;
+        p_digest[2] = SHA512_256_H2;
+        p_digest[3] = SHA512_256_H3;
+        p_digest[4] = SHA512_256_H4;
+        p_digest[5] = SHA512_256_H5;
+        p_digest[6] = SHA512_256_H6;
+        p_digest[7] = SHA512_256_H7;
+}
+
+__forceinline
+void sha512_224_init_digest(void *p)
+{
+        uint64_t *p_digest = (uint64_t *)p;
+
+        p_digest[0] = SHA512_224_H0;
+        p_digest[1] = SHA512_224_H1;
+        p_digest[2] = SHA512_224_H2;
+        p_digest[3] = SHA512_224_H3;
+        p_digest[4] = SHA512_224_H4;
+        p_digest[5] = SHA512_224_H5;
+        p_digest[6] = SHA512_224_H6;
+        p_digest[7] = SHA512_224_H7;
+}
+
 __forceinline
 void
 sha_generic_init(void *digest, const int sha_type)
@@ -216,6 +249,10 @@ sha_generic_init(void *digest, const int sha_type)
                 sha384_init_digest(digest);
         else if (sha_type == 512)
                 sha512_init_digest(digest);
+        else if (sha_type == 512256)
+                sha512_256_init_digest(digest);
+        else if (sha_type == 512224)
+                sha512_224_init_digest(digest);
 }
 
 __forceinline
@@ -231,6 +268,16 @@ void sha_generic_write_digest(void *dst, const void *src, const int sha_type)
                 copy_bswap8_array(dst, src, NUM_SHA_384_DIGEST_WORDS);
         else if (sha_type == 512)
                 copy_bswap8_array(dst, src, NUM_SHA_512_DIGEST_WORDS);
+        else if (sha_type == 512256)
+                copy_bswap8_array(dst, src, NUM_SHA_512_256_DIGEST_WORDS);
+        else if (sha_type == 512224) {
+                /* 3 words and the upper half of the 4th one */
+                const uint32_t last =
+                        bswap4((uint32_t) (((const uint64_t *) src)[3] >> 32));
+
+                copy_bswap8_array(dst, src, NUM_SHA_512_224_DIGEST_WORDS - 1);
+                memcpy(&((uint8_t *) dst)[24], &last, sizeof(last));
+        }
 }
 
 __forceinline
@@ -542,3 +589,133 @@ void sha512_avx512(const void *data, const uint64_t length, void *digest)
         sha_generic(data, length, digest, 1 /* AVX */, 512, SHA_512_BLOCK_SIZE,
                     SHA512_PAD_SIZE);
 }
+
+/* ========================================================================== */
+/* One block SHA512/256 computation for IPAD / OPAD usage only */
+
+void sha512_256_one_block_sse(const void *data, void *digest)
+{
+        sha_generic_1block(data, digest, 0 /* SSE */, 512256 /* SHA512/256 */);
+}
+
+void sha512_256_one_block_avx(const void *data, void *digest)
+{
+        sha_generic_1block(data, digest, 1 /* AVX */, 512256 /* SHA512/256 */);
+}
+
+void sha512_256_one_block_avx2(const void *data, void *digest)
+{
+        sha_generic_1block(data, digest, 1 /* AVX */, 512256 /* SHA512/256 */);
+}
+
+void sha512_256_one_block_avx512(const void *data, void *digest)
+{
+        sha_generic_1block(data, digest, 1 /* AVX */, 512256 /* SHA512/256 */);
+}
+
+/* ========================================================================== */
+/*
+ * SHA512/256 API for use in HMAC-SHA512/256 when key is longer than
+ * the block size and for PLAIN_SHA_512_256 jobs
+ */
+void sha512_256_sse(const void *data, const uint64_t length, void *digest)
+{
+        sha_generic(data, length, digest, 0 /* SSE */, 512256,
+                    SHA_512_BLOCK_SIZE, SHA512_PAD_SIZE);
+}
+
+void sha512_256_avx(const void *data, const uint64_t length, void *digest)
+{
+        sha_generic(data, length, digest, 1 /* AVX */, 512256,
+                    SHA_512_BLOCK_SIZE, SHA512_PAD_SIZE);
+}
+
+void sha512_256_avx2(const void *data, const uint64_t length, void *digest)
+{
+        sha_generic(data, length, digest, 1 /* AVX */, 512256,
+                    SHA_512_BLOCK_SIZE, SHA512_PAD_SIZE);
+}
+
+void sha512_256_avx512(const void *data, const uint64_t length, void *digest)
+{
+        sha_generic(data, length, digest, 1 /* AVX */, 512256,
+                    SHA_512_BLOCK_SIZE, SHA512_PAD_SIZE);
+}
+
+/* ========================================================================== */
+/* One block SHA512/224 computation for IPAD / OPAD usage only */
+
+void sha512_224_one_block_sse(const void *data, void *digest)
+{
+        sha_generic_1block(data, digest, 0 /* SSE */, 512224 /* SHA512/224 */);
+}
+
+void sha512_224_one_block_avx(const void *data, void *digest)
+{
+        sha_generic_1block(data, digest, 1 /* AVX */, 512224 /* SHA512/224 */);
+}
+
+void sha512_224_one_block_avx2(const void *data, void *digest)
+{
+        sha_generic_1block(data, digest, 1 /* AVX */, 512224 /* SHA512/224 */);
+}
+
+void sha512_224_one_block_avx512(const void *data, void *digest)
+{
+        sha_generic_1block(data, digest, 1 /* AVX */, 512224 /* SHA512/224 */);
+}
+
+/* ========================================================================== */
+/*
+ * SHA512/224 API for use in HMAC-SHA512/224 when key is longer than
+ * the block size and for PLAIN_SHA_512_224 jobs
+ */
+void sha512_224_sse(const void *data, const uint64_t length, void *digest)
+{
+        sha_generic(data, length, digest, 0 /* SSE */, 512224,
+                    SHA_512_BLOCK_SIZE, SHA512_PAD_SIZE);
+}
+
+void sha512_224_avx(const void *data, const uint64_t length, void *digest)
+{
+        sha_generic(data, length, digest, 1 /* AVX */, 512224,
+                    SHA_512_BLOCK_SIZE, SHA512_PAD_SIZE);
+}
+
+void sha512_224_avx2(const void *data, const uint64_t length, void *digest)
+{
+        sha_generic(data, length, digest, 1 /* AVX */, 512224,
+                    SHA_512_BLOCK_SIZE, SHA512_PAD_SIZE);
+}
+
+void sha512_224_avx512(const void *data, const uint64_t length, void *digest)
+{
+        sha_generic(data, length, digest, 1 /* AVX */, 512224,
+                    SHA_512_BLOCK_SIZE, SHA512_PAD_SIZE);
+}
+
+/* ========================================================================== */
+/*
+ * HMAC-SHA512/256 and HMAC-SHA512/224 out of order managers reuse the SHA512
+ * lanes, only the outer block padding depends on the inner digest size
+ */
+void hmac_sha512_t_ooo_init(MB_MGR_HMAC_SHA_512_OOO *state,
+                            const MB_MGR_HMAC_SHA_512_OOO *sha512_state,
+                            const unsigned digest_size)
+{
+        /* OKey block (1024 bits) plus the inner digest */
+        const unsigned bit_len = (SHA_512_BLOCK_SIZE + digest_size) * 8;
+        unsigned i;
+
+        memcpy(state, sha512_state, sizeof(*state));
+
+        for (i = 0; i < AVX512_NUM_SHA512_LANES; i++) {
+                uint8_t *p = state->ldata[i].outer_block;
+
+                memset(p + digest_size, 0x00,
+                       SHA_512_BLOCK_SIZE - digest_size);
+                p[digest_size] = 0x80; /* mark the end */
+                p[SHA_512_BLOCK_SIZE - 2] = (uint8_t) (bit_len >> 8);
+                p[SHA_512_BLOCK_SIZE - 1] = (uint8_t) bit_len;
+        }
+}
@@ -0,0 +1,290 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* SM3 hash (GB/T 32905-2016) common code and HMAC-SM3 key set up API */
+
+#include <string.h>
+
+#include "intel-ipsec-mb.h"
+#include "sm3.h"
+
+IMB_DLL_LOCAL const uint32_t sm3_iv[8] = {
+        0x7380166f, 0x4914b2b9, 0x172442d7, 0xda8a0600,
+        0xa96f30bc, 0x163138aa, 0xe38dee4d, 0xb0fb0e4e
+};
+
+IMB_DLL_LOCAL const uint32_t sm3_tj[SM3_ROUNDS] = {
+        0x79cc4519, 0xf3988a32, 0xe7311465, 0xce6228cb,
+        0x9cc45197, 0x3988a32f, 0x7311465e, 0xe6228cbc,
+        0xcc451979, 0x988a32f3, 0x311465e7, 0x6228cbce,
+        0xc451979c, 0x88a32f39, 0x11465e73, 0x228cbce6,
+        0x9d8a7a87, 0x3b14f50f, 0x7629ea1e, 0xec53d43c,
+        0xd8a7a879, 0xb14f50f3, 0x629ea1e7, 0xc53d43ce,
+        0x8a7a879d, 0x14f50f3b, 0x29ea1e76, 0x53d43cec,
+        0xa7a879d8, 0x4f50f3b1, 0x9ea1e762, 0x3d43cec5,
+        0x7a879d8a, 0xf50f3b14, 0xea1e7629, 0xd43cec53,
+        0xa879d8a7, 0x50f3b14f, 0xa1e7629e, 0x43cec53d,
+        0x879d8a7a, 0x0f3b14f5, 0x1e7629ea, 0x3cec53d4,
+        0x79d8a7a8, 0xf3b14f50, 0xe7629ea1, 0xcec53d43,
+        0x9d8a7a87, 0x3b14f50f, 0x7629ea1e, 0xec53d43c,
+        0xd8a7a879, 0xb14f50f3, 0x629ea1e7, 0xc53d43ce,
+        0x8a7a879d, 0x14f50f3b, 0x29ea1e76, 0x53d43cec,
+        0xa7a879d8, 0x4f50f3b1, 0x9ea1e762, 0x3d43cec5
+};
+
+IMB_DLL_LOCAL const uint8_t sm3_zero_block[SM3_BLOCK_SIZE] = { 0 };
+
+static uint32_t
+sm3_rol(const uint32_t x, const unsigned n)
+{
+        return (n == 0) ? x : ((x << n) | (x >> (32 - n)));
+}
+
+static uint32_t
+load_be32(const uint8_t *p)
+{
+        return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) |
+                ((uint32_t) p[2] << 8) | (uint32_t) p[3];
+}
+
+static void
+store_be32(uint8_t *p, const uint32_t x)
+{
+        p[0] = (uint8_t) (x >> 24);
+        p[1] = (uint8_t) (x >> 16);
+        p[2] = (uint8_t) (x >> 8);
+        p[3] = (uint8_t) x;
+}
+
+static void
+store_be64(uint8_t *p, const uint64_t x)
+{
+        store_be32(p, (uint32_t) (x >> 32));
+        store_be32(&p[4], (uint32_t) x);
+}
+
+static void
+sm3_compress(uint32_t *v, const uint8_t *block)
+{
+        uint32_t w[68], a, b, c, d, e, f, g, h, ss1, ss2, tt1, tt2;
+        unsigned j;
+
+        for (j = 0; j < 16; j++)
+                w[j] = load_be32(&block[j * 4]);
+        for (j = 16; j < 68; j++) {
+                const uint32_t x = w[j - 16] ^ w[j - 9] ^
+                        sm3_rol(w[j - 3], 15);
+
+                w[j] = x ^ sm3_rol(x, 15) ^ sm3_rol(x, 23) ^
+                        sm3_rol(w[j - 13], 7) ^ w[j - 6];
+        }
+
+        a = v[0];
+        b = v[1];
+        c = v[2];
+        d = v[3];
+        e = v[4];
+        f = v[5];
+        g = v[6];
+        h = v[7];
+
+        for (j = 0; j < SM3_ROUNDS; j++) {
+                ss1 = sm3_rol(sm3_rol(a, 12) + e + sm3_tj[j], 7);
+                ss2 = ss1 ^ sm3_rol(a, 12);
+                if (j < 16) {
+                        tt1 = (a ^ b ^ c) + d + ss2 + (w[j] ^ w[j + 4]);
+                        tt2 = (e ^ f ^ g) + h + ss1 + w[j];
+                } else {
+                        tt1 = ((a & b) | (a & c) | (b & c)) + d + ss2 +
+                                (w[j] ^ w[j + 4]);
+                        tt2 = (g ^ (e & (f ^ g))) + h + ss1 + w[j];
+                }
+                d = c;
+                c = sm3_rol(b, 9);
+                b = a;
+                a = tt1;
+                h = g;
+                g = sm3_rol(f, 19);
+                f = e;
+                e = tt2 ^ sm3_rol(tt2, 9) ^ sm3_rol(tt2, 17);
+        }
+
+        v[0] ^= a;
+        v[1] ^= b;
+        v[2] ^= c;
+        v[3] ^= d;
+        v[4] ^= e;
+        v[5] ^= f;
+        v[6] ^= g;
+        v[7] ^= h;
+}
+
+void sm3_one_block(const void *data, void *digest)
+{
+        uint32_t v[8];
+
+        memcpy(v, sm3_iv, sizeof(v));
+        sm3_compress(v, (const uint8_t *) data);
+        memcpy(digest, v, sizeof(v));
+}
+
+void sm3(const void *data, const uint64_t length, void *digest)
+{
+        const uint8_t *p = (const uint8_t *) data;
+        uint8_t block[2 * SM3_BLOCK_SIZE];
+        uint64_t len = length;
+        uint32_t v[8];
+        unsigned i, n;
+
+        memcpy(v, sm3_iv, sizeof(v));
+        for (; len >= SM3_BLOCK_SIZE; len -= SM3_BLOCK_SIZE,
+                     p += SM3_BLOCK_SIZE)
+                sm3_compress(v, p);
+
+        n = (len + 9 > SM3_BLOCK_SIZE) ? 2 : 1;
+        memset(block, 0, sizeof(block));
+        memcpy(block, p, len);
+        block[len] = 0x80;
+        store_be64(&block[n * SM3_BLOCK_SIZE - 8], length * 8);
+        for (i = 0; i < n; i++)
+                sm3_compress(v, &block[i * SM3_BLOCK_SIZE]);
+
+        for (i = 0; i < 8; i++)
+                store_be32(&((uint8_t *) digest)[i * 4], v[i]);
+}
+
+/* ========================================================================== */
+/* Out of order manager lane handling */
+
+/* digest word i of lane */
+#define SM3_DIGEST(_state, _i, _lane) \
+        ((_state)->args.digest[(_i) * AVX512_NUM_SHA256_LANES + (_lane)])
+
+void
+sm3_ooo_init(MB_MGR_HMAC_SHA_256_OOO *state, const unsigned num_lanes)
+{
+        unsigned i;
+
+        memset(state, 0, sizeof(*state));
+        for (i = num_lanes; i > 0; i--)
+                state->unused_lanes = (state->unused_lanes << 4) | (i - 1);
+}
+
+/* sets digest of the lane from 8 words */
+static void
+sm3_ooo_set_digest(MB_MGR_HMAC_SHA_256_OOO *state, const unsigned lane,
+                   const void *digest)
+{
+        uint32_t v[8];
+        unsigned i;
+
+        memcpy(v, digest, sizeof(v));
+        for (i = 0; i < 8; i++)
+                SM3_DIGEST(state, i, lane) = v[i];
+}
+
+void
+sm3_ooo_load_lane(MB_MGR_HMAC_SHA_256_OOO *state, const unsigned lane,
+                  JOB_AES_HMAC *job)
+{
+        HMAC_SHA1_LANE_DATA *ld = &state->ldata[lane];
+        const uint8_t *msg = job->src + job->hash_start_src_offset_in_bytes;
+        const uint64_t len = job->msg_len_to_hash_in_bytes;
+        const uint64_t tail = len % SM3_BLOCK_SIZE;
+        const int hmac = (job->hash_alg == SM3);
+
+        ld->job_in_lane = job;
+        ld->outer_done = !hmac;
+        ld->extra_blocks = (tail + 9 > SM3_BLOCK_SIZE) ? 2 : 1;
+        ld->size_offset = ld->extra_blocks * SM3_BLOCK_SIZE - 8;
+
+        memcpy(ld->extra_block, &msg[len - tail], tail);
+        ld->extra_block[tail] = 0x80;
+        memset(&ld->extra_block[tail + 1], 0, ld->size_offset - tail - 1);
+        /* inner hash input is preceded by the key block for HMAC */
+        store_be64(&ld->extra_block[ld->size_offset],
+                   (len + (hmac ? SM3_BLOCK_SIZE : 0)) * 8);
+
+        sm3_ooo_set_digest(state, lane,
+                           hmac ? job->u.HMAC._hashed_auth_key_xor_ipad :
+                           (const void *) sm3_iv);
+        state->args.data_ptr[lane] = (uint8_t *) (uintptr_t) msg;
+        state->lens[lane] = 0;
+}
+
+int
+sm3_ooo_lane_next(MB_MGR_HMAC_SHA_256_OOO *state, const unsigned lane)
+{
+        HMAC_SHA1_LANE_DATA *ld = &state->ldata[lane];
+        JOB_AES_HMAC *job = ld->job_in_lane;
+        unsigned i;
+
+        if (ld->extra_blocks != 0) {
+                const uint8_t *msg_end = job->src +
+                        job->hash_start_src_offset_in_bytes +
+                        (job->msg_len_to_hash_in_bytes &
+                         ~(uint64_t) (SM3_BLOCK_SIZE - 1));
+                const uint64_t left = (uint64_t) (msg_end -
+                                                  state->args.data_ptr[lane]) /
+                        SM3_BLOCK_SIZE;
+
+                /* block counts are 16-bit */
+                if (left != 0) {
+                        state->lens[lane] = (uint16_t) ((left < 0xffff) ?
+                                                        left : 0xffff);
+                        return 0;
+                }
+                state->args.data_ptr[lane] = ld->extra_block;
+                state->lens[lane] = (uint16_t) ld->extra_blocks;
+                ld->extra_blocks = 0;
+                return 0;
+        }
+
+        if (!ld->outer_done) {
+                for (i = 0; i < 8; i++)
+                        store_be32(&ld->outer_block[i * 4],
+                                   SM3_DIGEST(state, i, lane));
+                ld->outer_block[SM3_DIGEST_SIZE_IN_BYTES] = 0x80;
+                memset(&ld->outer_block[SM3_DIGEST_SIZE_IN_BYTES + 1], 0,
+                       SM3_BLOCK_SIZE - SM3_DIGEST_SIZE_IN_BYTES - 9);
+                store_be64(&ld->outer_block[SM3_BLOCK_SIZE - 8],
+                           (SM3_BLOCK_SIZE + SM3_DIGEST_SIZE_IN_BYTES) * 8);
+
+                sm3_ooo_set_digest(state, lane,
+                                   job->u.HMAC._hashed_auth_key_xor_opad);
+                state->args.data_ptr[lane] = ld->outer_block;
+                state->lens[lane] = 1;
+                ld->outer_done = 1;
+                return 0;
+        }
+
+        for (i = 0; i < job->auth_tag_output_len_in_bytes; i++)
+                job->auth_tag_output[i] = (uint8_t)
+                        (SM3_DIGEST(state, i / 4, lane) >>
+                         (24 - 8 * (i % 4)));
+        return 1;
+}
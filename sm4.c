@@ -0,0 +1,223 @@
+/*******************************************************************************
+  Copyright (c) 2019, Intel Corporation
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+      * Redistributions of source code must retain the above copyright notice,
+        this list of conditions and the following disclaimer.
+      * Redistributions in binary form must reproduce the above copyright
+        notice, this list of conditions and the following disclaimer in the
+        documentation and/or other materials provided with the distribution.
+      * Neither the name of Intel Corporation nor the names of its contributors
+        may be used to endorse or promote products derived from this software
+        without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/* SM4 block cipher (GB/T 32907-2016) common code and key set up API */
+
+#include <string.h>
+
+#include "intel-ipsec-mb.h"
+#include "sm4.h"
+
+IMB_DLL_LOCAL const uint8_t sm4_sbox[256] = {
+        0xd6, 0x90, 0xe9, 0xfe, 0xcc, 0xe1, 0x3d, 0xb7,
+        0x16, 0xb6, 0x14, 0xc2, 0x28, 0xfb, 0x2c, 0x05,
+        0x2b, 0x67, 0x9a, 0x76, 0x2a, 0xbe, 0x04, 0xc3,
+        0xaa, 0x44, 0x13, 0x26, 0x49, 0x86, 0x06, 0x99,
+        0x9c, 0x42, 0x50, 0xf4, 0x91, 0xef, 0x98, 0x7a,
+        0x33, 0x54, 0x0b, 0x43, 0xed, 0xcf, 0xac, 0x62,
+        0xe4, 0xb3, 0x1c, 0xa9, 0xc9, 0x08, 0xe8, 0x95,
+        0x80, 0xdf, 0x94, 0xfa, 0x75, 0x8f, 0x3f, 0xa6,
+        0x47, 0x07, 0xa7, 0xfc, 0xf3, 0x73, 0x17, 0xba,
+        0x83, 0x59, 0x3c, 0x19, 0xe6, 0x85, 0x4f, 0xa8,
+        0x68, 0x6b, 0x81, 0xb2, 0x71, 0x64, 0xda, 0x8b,
+        0xf8, 0xeb, 0x0f, 0x4b, 0x70, 0x56, 0x9d, 0x35,
+        0x1e, 0x24, 0x0e, 0x5e, 0x63, 0x58, 0xd1, 0xa2,
+        0x25, 0x22, 0x7c, 0x3b, 0x01, 0x21, 0x78, 0x87,
+        0xd4, 0x00, 0x46, 0x57, 0x9f, 0xd3, 0x27, 0x52,
+        0x4c, 0x36, 0x02, 0xe7, 0xa0, 0xc4, 0xc8, 0x9e,
+        0xea, 0xbf, 0x8a, 0xd2, 0x40, 0xc7, 0x38, 0xb5,
+        0xa3, 0xf7, 0xf2, 0xce, 0xf9, 0x61, 0x15, 0xa1,
+        0xe0, 0xae, 0x5d, 0xa4, 0x9b, 0x34, 0x1a, 0x55,
+        0xad, 0x93, 0x32, 0x30, 0xf5, 0x8c, 0xb1, 0xe3,
+        0x1d, 0xf6, 0xe2, 0x2e, 0x82, 0x66, 0xca, 0x60,
+        0xc0, 0x29, 0x23, 0xab, 0x0d, 0x53, 0x4e, 0x6f,
+        0xd5, 0xdb, 0x37, 0x45, 0xde, 0xfd, 0x8e, 0x2f,
+        0x03, 0xff, 0x6a, 0x72, 0x6d, 0x6c, 0x5b, 0x51,
+        0x8d, 0x1b, 0xaf, 0x92, 0xbb, 0xdd, 0xbc, 0x7f,
+        0x11, 0xd9, 0x5c, 0x41, 0x1f, 0x10, 0x5a, 0xd8,
+        0x0a, 0xc1, 0x31, 0x88, 0xa5, 0xcd, 0x7b, 0xbd,
+        0x2d, 0x74, 0xd0, 0x12, 0xb8, 0xe5, 0xb4, 0xb0,
+        0x89, 0x69, 0x97, 0x4a, 0x0c, 0x96, 0x77, 0x7e,
+        0x65, 0xb9, 0xf1, 0x09, 0xc5, 0x6e, 0xc6, 0x84,
+        0x18, 0xf0, 0x7d, 0xec, 0x3a, 0xdc, 0x4d, 0x20,
+        0x79, 0xee, 0x5f, 0x3e, 0xd7, 0xcb, 0x39, 0x48
+};
+
+IMB_DLL_LOCAL const uint8_t sm4_zero_block[SM4_BLOCK_SIZE] = { 0 };
+
+/* system parameter */
+static const uint32_t sm4_fk[4] = {
+        0xa3b1bac6, 0x56aa3350, 0x677d9197, 0xb27022dc
+};
+
+/* fixed parameters, byte j of CK[i] is (4 * i + j) * 7 mod 256 */
+static const uint32_t sm4_ck[SM4_ROUNDS] = {
+        0x00070e15, 0x1c232a31, 0x383f464d, 0x545b6269,
+        0x70777e85, 0x8c939aa1, 0xa8afb6bd, 0xc4cbd2d9,
+        0xe0e7eef5, 0xfc030a11, 0x181f262d, 0x343b4249,
+        0x50575e65, 0x6c737a81, 0x888f969d, 0xa4abb2b9,
+        0xc0c7ced5, 0xdce3eaf1, 0xf8ff060d, 0x141b2229,
+        0x30373e45, 0x4c535a61, 0x686f767d, 0x848b9299,
+        0xa0a7aeb5, 0xbcc3cad1, 0xd8dfe6ed, 0xf4fb0209,
+        0x10171e25, 0x2c333a41, 0x484f565d, 0x646b7279
+};
+
+static uint32_t
+sm4_rol(const uint32_t x, const unsigned n)
+{
+        return (x << n) | (x >> (32 - n));
+}
+
+static uint32_t
+load_be32(const uint8_t *p)
+{
+        return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) |
+                ((uint32_t) p[2] << 8) | (uint32_t) p[3];
+}
+
+static void
+store_be32(uint8_t *p, const uint32_t x)
+{
+        p[0] = (uint8_t) (x >> 24);
+        p[1] = (uint8_t) (x >> 16);
+        p[2] = (uint8_t) (x >> 8);
+        p[3] = (uint8_t) x;
+}
+
+/* non-linear transformation tau - S-box applied to each byte */
+static uint32_t
+sm4_tau(const uint32_t x)
+{
+        return ((uint32_t) sm4_sbox[x >> 24] << 24) |
+                ((uint32_t) sm4_sbox[(x >> 16) & 0xff] << 16) |
+                ((uint32_t) sm4_sbox[(x >> 8) & 0xff] << 8) |
+                (uint32_t) sm4_sbox[x & 0xff];
+}
+
+void
+sm4_crypt_block(const uint32_t *rk, const void *in, void *out)
+{
+        const uint8_t *p_in = (const uint8_t *) in;
+        uint8_t *p_out = (uint8_t *) out;
+        uint32_t x[4], t;
+        unsigned i;
+
+        for (i = 0; i < 4; i++)
+                x[i] = load_be32(&p_in[i * 4]);
+
+        for (i = 0; i < SM4_ROUNDS; i++) {
+                t = sm4_tau(x[(i + 1) & 3] ^ x[(i + 2) & 3] ^
+                            x[(i + 3) & 3] ^ rk[i]);
+                x[i & 3] ^= t ^ sm4_rol(t, 2) ^ sm4_rol(t, 10) ^
+                        sm4_rol(t, 18) ^ sm4_rol(t, 24);
+        }
+
+        /* reverse transformation R */
+        for (i = 0; i < 4; i++)
+                store_be32(&p_out[i * 4], x[3 - i]);
+}
+
+void
+sm4_keyexp(const void *key, void *enc_exp_keys, void *dec_exp_keys)
+{
+        const uint8_t *p_key = (const uint8_t *) key;
+        uint32_t *enc_rk = (uint32_t *) enc_exp_keys;
+        uint32_t *dec_rk = (uint32_t *) dec_exp_keys;
+        uint32_t k[4], t;
+        unsigned i;
+
+        for (i = 0; i < 4; i++)
+                k[i] = load_be32(&p_key[i * 4]) ^ sm4_fk[i];
+
+        for (i = 0; i < SM4_ROUNDS; i++) {
+                t = sm4_tau(k[(i + 1) & 3] ^ k[(i + 2) & 3] ^
+                            k[(i + 3) & 3] ^ sm4_ck[i]);
+                k[i & 3] ^= t ^ sm4_rol(t, 13) ^ sm4_rol(t, 23);
+                if (enc_rk != NULL)
+                        enc_rk[i] = k[i & 3];
+                if (dec_rk != NULL)
+                        dec_rk[SM4_ROUNDS - 1 - i] = k[i & 3];
+        }
+}
+
+void
+sm4_ghash_mul(uint8_t *x, const uint8_t *h)
+{
+        uint8_t z[GCM_BLOCK_LEN], v[GCM_BLOCK_LEN];
+        unsigned i, j;
+
+        memset(z, 0, sizeof(z));
+        memcpy(v, h, sizeof(v));
+
+        for (i = 0; i < 128; i++) {
+                const uint8_t lsb = v[GCM_BLOCK_LEN - 1] & 1;
+
+                if (x[i / 8] & (0x80 >> (i % 8)))
+                        for (j = 0; j < GCM_BLOCK_LEN; j++)
+                                z[j] ^= v[j];
+
+                /* v = v * x, bit 0 is the most significant bit of byte 0 */
+                for (j = GCM_BLOCK_LEN - 1; j > 0; j--)
+                        v[j] = (uint8_t) ((v[j] >> 1) | (v[j - 1] << 7));
+                v[0] >>= 1;
+                if (lsb)
+                        v[0] ^= 0xe1;
+        }
+        memcpy(x, z, sizeof(z));
+}
+
+void
+sm4_gcm_pre(const void *key, struct sm4_gcm_key_data *key_data)
+{
+        uint8_t h[GCM_BLOCK_LEN], hn[GCM_BLOCK_LEN];
+        unsigned i, j;
+
+        sm4_keyexp(key, key_data->rk, NULL);
+        sm4_crypt_block(key_data->rk, sm4_zero_block, h);
+
+        /* HashKey^(4 - i) goes to entry i */
+        memcpy(hn, h, sizeof(hn));
+        for (i = 4; i > 0; i--) {
+                for (j = 0; j < GCM_BLOCK_LEN; j++)
+                        key_data->hkey[i - 1][j] = hn[GCM_BLOCK_LEN - 1 - j];
+                sm4_ghash_mul(hn, h);
+        }
+}
+
+/* ========================================================================== */
+/* Out of order manager */
+
+void
+sm4_cbc_enc_ooo_init(MB_MGR_AES_OOO *state, const unsigned num_lanes)
+{
+        unsigned i;
+
+        memset(state, 0, sizeof(*state));
+        state->unused_lanes = 0xF;
+        for (i = num_lanes; i > 0; i--)
+                state->unused_lanes = (state->unused_lanes << 4) | (i - 1);
+}
@@ -84,20 +84,17 @@ lib_objs1 = \
         $(OBJ_DIR)\aes128_cbc_dec_by4_sse_no_aesni.obj \
 	$(OBJ_DIR)\aes128_cbc_dec_by8_avx.obj \
 	$(OBJ_DIR)\aes128_cntr_by4_sse.obj \
-        $(OBJ_DIR)\aes128_cntr_by4_sse_no_aesni.obj \
 	$(OBJ_DIR)\aes128_cntr_by8_avx.obj \
 	$(OBJ_DIR)\aes128_ecbenc_x3.obj \
 	$(OBJ_DIR)\aes192_cbc_dec_by4_sse.obj \
         $(OBJ_DIR)\aes192_cbc_dec_by4_sse_no_aesni.obj \
 	$(OBJ_DIR)\aes192_cbc_dec_by8_avx.obj \
 	$(OBJ_DIR)\aes192_cntr_by4_sse.obj \
-        $(OBJ_DIR)\aes192_cntr_by4_sse_no_aesni.obj \
 	$(OBJ_DIR)\aes192_cntr_by8_avx.obj \
 	$(OBJ_DIR)\aes256_cbc_dec_by4_sse.obj \
         $(OBJ_DIR)\aes256_cbc_dec_by4_sse_no_aesni.obj \
 	$(OBJ_DIR)\aes256_cbc_dec_by8_avx.obj \
 	$(OBJ_DIR)\aes256_cntr_by4_sse.obj \
-        $(OBJ_DIR)\aes256_cntr_by4_sse_no_aesni.obj \
 	$(OBJ_DIR)\aes256_cntr_by8_avx.obj \
 	$(OBJ_DIR)\aes_cfb_128_sse.obj \
         $(OBJ_DIR)\aes_cfb_128_sse_no_aesni.obj \
@@ -149,6 +146,10 @@ lib_objs1 = \
 	$(OBJ_DIR)\sha512_x8_avx512.obj \
 	$(OBJ_DIR)\sha_256_mult_avx.obj \
 	$(OBJ_DIR)\sha_256_mult_sse.obj \
+	$(OBJ_DIR)\sha_mb_avx.obj \
+	$(OBJ_DIR)\sha_mb_avx2.obj \
+	$(OBJ_DIR)\sha_mb_avx512.obj \
+	$(OBJ_DIR)\sha_mb_sse.obj \
 	$(OBJ_DIR)\aes_xcbc_expand_key.obj \
 	$(OBJ_DIR)\md5_one_block.obj \
 	$(OBJ_DIR)\sha_one_block.obj \
@@ -232,6 +233,22 @@ lib_objs2 = \
 	$(OBJ_DIR)\mb_mgr_hmac_sha_512_submit_avx2.obj \
 	$(OBJ_DIR)\mb_mgr_hmac_sha_512_submit_avx512.obj \
 	$(OBJ_DIR)\mb_mgr_hmac_sha_512_submit_sse.obj \
+	$(OBJ_DIR)\mb_mgr_hmac_sha_512_224_flush_avx.obj \
+	$(OBJ_DIR)\mb_mgr_hmac_sha_512_224_flush_avx2.obj \
+	$(OBJ_DIR)\mb_mgr_hmac_sha_512_224_flush_avx512.obj \
+	$(OBJ_DIR)\mb_mgr_hmac_sha_512_224_flush_sse.obj \
+	$(OBJ_DIR)\mb_mgr_hmac_sha_512_224_submit_avx.obj \
+	$(OBJ_DIR)\mb_mgr_hmac_sha_512_224_submit_avx2.obj \
+	$(OBJ_DIR)\mb_mgr_hmac_sha_512_224_submit_avx512.obj \
+	$(OBJ_DIR)\mb_mgr_hmac_sha_512_224_submit_sse.obj \
+	$(OBJ_DIR)\mb_mgr_hmac_sha_512_256_flush_avx.obj \
+	$(OBJ_DIR)\mb_mgr_hmac_sha_512_256_flush_avx2.obj \
+	$(OBJ_DIR)\mb_mgr_hmac_sha_512_256_flush_avx512.obj \
+	$(OBJ_DIR)\mb_mgr_hmac_sha_512_256_flush_sse.obj \
+	$(OBJ_DIR)\mb_mgr_hmac_sha_512_256_submit_avx.obj \
+	$(OBJ_DIR)\mb_mgr_hmac_sha_512_256_submit_avx2.obj \
+	$(OBJ_DIR)\mb_mgr_hmac_sha_512_256_submit_avx512.obj \
+	$(OBJ_DIR)\mb_mgr_hmac_sha_512_256_submit_sse.obj \
 	$(OBJ_DIR)\mb_mgr_hmac_submit_avx.obj \
 	$(OBJ_DIR)\mb_mgr_hmac_submit_avx2.obj \
 	$(OBJ_DIR)\mb_mgr_hmac_submit_sse.obj \
@@ -246,7 +263,70 @@ lib_objs2 = \
 	$(OBJ_DIR)\alloc.obj \
 	$(OBJ_DIR)\version.obj \
 	$(OBJ_DIR)\cpu_feature.obj \
-        $(OBJ_DIR)\aesni_emu.obj
+        $(OBJ_DIR)\aesni_emu.obj \
+	$(OBJ_DIR)\ethernet_fcs_sse_no_aesni.obj \
+	$(OBJ_DIR)\ethernet_fcs_sse.obj \
+	$(OBJ_DIR)\ethernet_fcs_avx.obj \
+	$(OBJ_DIR)\ethernet_fcs_avx512.obj \
+	$(OBJ_DIR)\zuc.obj \
+	$(OBJ_DIR)\zuc_sse.obj \
+	$(OBJ_DIR)\zuc_avx.obj \
+	$(OBJ_DIR)\zuc_avx2.obj \
+	$(OBJ_DIR)\zuc_avx512.obj \
+	$(OBJ_DIR)\snow3g.obj \
+	$(OBJ_DIR)\snow3g_sse_no_aesni.obj \
+	$(OBJ_DIR)\snow3g_sse.obj \
+	$(OBJ_DIR)\snow3g_avx.obj \
+	$(OBJ_DIR)\snow3g_avx2.obj \
+	$(OBJ_DIR)\snow3g_avx512.obj \
+	$(OBJ_DIR)\kasumi.obj \
+	$(OBJ_DIR)\kasumi_sse.obj \
+	$(OBJ_DIR)\kasumi_avx.obj \
+	$(OBJ_DIR)\kasumi_avx2.obj \
+	$(OBJ_DIR)\kasumi_avx512.obj \
+	$(OBJ_DIR)\sha3.obj \
+	$(OBJ_DIR)\sha3_sse.obj \
+	$(OBJ_DIR)\sha3_avx.obj \
+	$(OBJ_DIR)\sha3_avx2.obj \
+	$(OBJ_DIR)\sha3_avx512.obj \
+	$(OBJ_DIR)\blake2.obj \
+	$(OBJ_DIR)\blake2_sse.obj \
+	$(OBJ_DIR)\blake2_avx.obj \
+	$(OBJ_DIR)\blake2_avx2.obj \
+	$(OBJ_DIR)\blake2_avx512.obj \
+	$(OBJ_DIR)\sm3.obj \
+	$(OBJ_DIR)\sm3_sse.obj \
+	$(OBJ_DIR)\sm3_avx.obj \
+	$(OBJ_DIR)\sm3_avx2.obj \
+	$(OBJ_DIR)\sm3_avx512.obj \
+	$(OBJ_DIR)\sm4.obj \
+	$(OBJ_DIR)\sm4_sse_no_aesni.obj \
+	$(OBJ_DIR)\sm4_sse.obj \
+	$(OBJ_DIR)\sm4_avx.obj \
+	$(OBJ_DIR)\sm4_avx2.obj \
+	$(OBJ_DIR)\sm4_avx512.obj \
+	$(OBJ_DIR)\aes_gcm_siv.obj \
+	$(OBJ_DIR)\aes_gcm_siv_sse_no_aesni.obj \
+	$(OBJ_DIR)\aes_gcm_siv_sse.obj \
+	$(OBJ_DIR)\aes_gcm_siv_avx.obj \
+	$(OBJ_DIR)\aes_gcm_siv_avx2.obj \
+	$(OBJ_DIR)\aes_gcm_siv_avx512.obj \
+	$(OBJ_DIR)\aes_cfb.obj \
+	$(OBJ_DIR)\aes_cfb_sse_no_aesni.obj \
+	$(OBJ_DIR)\aes_cntr_sse_no_aesni.obj \
+	$(OBJ_DIR)\aes_cfb_sse.obj \
+	$(OBJ_DIR)\aes_cfb_avx.obj \
+	$(OBJ_DIR)\aes_cfb_avx2.obj \
+	$(OBJ_DIR)\aes_cfb_avx512.obj \
+	$(OBJ_DIR)\aes_keyexp_mb_sse_no_aesni.obj \
+	$(OBJ_DIR)\aes_keyexp_mb_sse.obj \
+	$(OBJ_DIR)\aes_keyexp_mb_avx.obj \
+	$(OBJ_DIR)\aes_keyexp_mb_avx2.obj \
+	$(OBJ_DIR)\aes_keyexp_mb_avx512.obj \
+	$(OBJ_DIR)\hmac_ipad_opad_mb_sse.obj \
+	$(OBJ_DIR)\hmac_ipad_opad_mb_avx.obj \
+	$(OBJ_DIR)\hmac_ipad_opad_mb_avx2.obj \
+	$(OBJ_DIR)\hmac_ipad_opad_mb_avx512.obj
 
 gcm_objs = \
 	$(OBJ_DIR)\gcm.obj \
@@ -267,7 +347,12 @@ gcm_objs = \
 	$(OBJ_DIR)\gcm256_vaes_avx512.obj \
         $(OBJ_DIR)\gcm128_sse_no_aesni.obj \
 	$(OBJ_DIR)\gcm192_sse_no_aesni.obj \
-	$(OBJ_DIR)\gcm256_sse_no_aesni.obj
+	$(OBJ_DIR)\gcm256_sse_no_aesni.obj \
+	$(OBJ_DIR)\aes_gcm_pre_mb_sse_no_aesni.obj \
+	$(OBJ_DIR)\aes_gcm_pre_mb_sse.obj \
+	$(OBJ_DIR)\aes_gcm_pre_mb_avx_gen2.obj \
+	$(OBJ_DIR)\aes_gcm_pre_mb_avx_gen4.obj \
+	$(OBJ_DIR)\aes_gcm_pre_mb_avx512.obj
 
 !ifdef NO_GCM
 all_objs = $(lib_objs1) $(lib_objs2)